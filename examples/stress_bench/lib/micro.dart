@@ -1,10 +1,18 @@
 import 'dart:math' as math;
+import 'dart:typed_data';
+import 'dart:ui' as ui;
 
 import 'package:flutter_scene/scene.dart';
 import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
 import 'package:flutter_scene/src/render/bvh.dart';
+import 'package:flutter_scene/src/render/draw_sort.dart';
+import 'package:flutter_scene/src/render/instance_cull_tree.dart';
 import 'package:flutter_scene/src/render/instance_packing.dart';
+import 'package:flutter_scene/src/render/light_clusters.dart';
+import 'package:flutter_scene/src/render/light_culling.dart';
+import 'package:flutter_scene/src/render/occlusion_culler.dart';
 import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:flutter_scene/src/render/retained_draw_order.dart';
 import 'package:vector_math/vector_math.dart';
 
 /// Non-renderable stand-ins so [RenderItem]s can be built in pure Dart,
@@ -53,8 +61,68 @@ List<RenderItem> _makeItems(int count) {
   });
 }
 
+/// The fields `SceneEncoder` orders opaque draws by.
+class _SortRecord {
+  _SortRecord({
+    required this.item,
+    required this.pipeline,
+    required this.material,
+    required this.geometry,
+    required this.lightOffset,
+    required this.depth,
+  });
+
+  final RenderItem item;
+  final int pipeline;
+  final int material;
+  final int geometry;
+  final int lightOffset;
+  final double fade = 1.0;
+  final double depth;
+}
+
+int _compareSortRecords(_SortRecord a, _SortRecord b) {
+  final byPipeline = a.pipeline.compareTo(b.pipeline);
+  if (byPipeline != 0) return byPipeline;
+  final byMaterial = a.material.compareTo(b.material);
+  if (byMaterial != 0) return byMaterial;
+  final byGeometry = a.geometry.compareTo(b.geometry);
+  if (byGeometry != 0) return byGeometry;
+  final byLightOffset = a.lightOffset.compareTo(b.lightOffset);
+  if (byLightOffset != 0) return byLightOffset;
+  final byFade = a.fade.compareTo(b.fade);
+  if (byFade != 0) return byFade;
+  return a.depth.compareTo(b.depth);
+}
+
 /// Times [body] over [reps] repetitions after [warmup] discarded ones and
 /// returns milliseconds per repetition.
+// The per-instance sweep `RenderItem.cullVisibleInstances` runs below the
+// cull tree's threshold: every instance box against every plane.
+void _cullInstancesLinear(
+  Float32List bounds,
+  int count,
+  List<Plane> planes,
+  List<int> visible,
+) {
+  for (var i = 0; i < count; i++) {
+    final o = i * 6;
+    var outside = false;
+    for (final plane in planes) {
+      final n = plane.normal;
+      if (n.x * bounds[o + (n.x < 0 ? 0 : 3)] +
+              n.y * bounds[o + (n.y < 0 ? 1 : 4)] +
+              n.z * bounds[o + (n.z < 0 ? 2 : 5)] +
+              plane.constant <
+          0) {
+        outside = true;
+        break;
+      }
+    }
+    if (!outside) visible.add(i);
+  }
+}
+
 double _time(int reps, void Function() body, {int warmup = 3}) {
   for (var i = 0; i < warmup; i++) {
     body();
@@ -97,6 +165,114 @@ Map<String, double> runMicroBenchmarks() {
   });
   results['bvh_query_10k_visited'] = visited.toDouble();
 
+  // Six views over the field, the shape of a cascade set or a cube capture:
+  // six separate queries against one multi-frustum traversal.
+  final views = [
+    for (var v = 0; v < 6; v++)
+      Frustum.matrix(
+        makeOrthographicMatrix(
+          -100 + v * 25.0,
+          -40 + v * 25.0,
+          -100,
+          100,
+          -30,
+          30,
+        ),
+      ),
+  ];
+  final viewLists = [for (var v = 0; v < views.length; v++) <RenderItem>[]];
+  results['bvh_query_x6_10k'] = _time(200, () {
+    for (var v = 0; v < views.length; v++) {
+      viewLists[v].clear();
+      bvh.query(views[v], viewLists[v].add);
+    }
+  });
+  results['bvh_query_many_6_10k'] = _time(200, () {
+    for (final list in viewLists) {
+      list.clear();
+    }
+    bvh.queryMany(views, viewLists);
+  });
+
+  // A camera at the field's edge behind a row of wall occluders: rasterize
+  // the walls, then test every item against the CPU depth buffer.
+  final walls = <RenderItem>[];
+  for (var w = 0; w < 16; w++) {
+    final box = Aabb3.minMax(
+      Vector3(-100 + w * 12.5, -20, -60),
+      Vector3(-90 + w * 12.5, 20, -59),
+    );
+    walls.add(
+      RenderItem(geometry: _StubGeometry(), material: _StubMaterial())
+        ..visible = true
+        ..occluder = Occluder.box(box)
+        ..worldBounds = box,
+    );
+  }
+  final occlusionItems = [
+    ...walls,
+    for (final item in items) item..visible = true,
+  ];
+  final occlusionView = PerspectiveCamera(
+    position: Vector3(0, 0, -110),
+    target: Vector3.zero(),
+  ).getViewTransform(const ui.Size(1280, 720));
+  final culler = OcclusionCuller();
+  results['occlusion_cull_10k'] = _time(100, () {
+    culler.cull(
+      occlusionItems,
+      (_) {},
+      viewProjection: occlusionView,
+      width: 256,
+      height: 144,
+    );
+  });
+  results['occlusion_cull_10k_culled'] = culler.lastCulledCount.toDouble();
+
+  // 256 ranged point lights over the field, assigned per item (one BVH
+  // query per light, then per-item list assembly) against binned into the
+  // default 16x9x24 froxel grid of one 1280x720 view.
+  final lightRng = math.Random(5);
+  final lights = List.generate(256, (i) {
+    final position = Vector3(
+      lightRng.nextDouble() * 200 - 100,
+      lightRng.nextDouble() * 40 - 20,
+      lightRng.nextDouble() * 200 - 100,
+    );
+    return CullableLight(
+      i,
+      lightInfluenceBounds(position, 8.0),
+      worldPosition: position,
+      range: 8.0,
+    );
+  });
+  results['assign_lights_256_10k'] = _time(50, () {
+    assignLightsToItems(
+      items: items,
+      bvh: bvh,
+      lights: lights,
+      maxPerItem: 16,
+    );
+  });
+  final lightView = PerspectiveCamera(
+    position: Vector3(0, 10, -110),
+    target: Vector3.zero(),
+  ).getViewMatrix();
+  final grid = LightClusterGrid();
+  final tanHalfFovY = math.tan(45 * degrees2Radians / 2);
+  results['light_clusters_256'] = _time(200, () {
+    grid.build(
+      view: lightView,
+      tanHalfFovX: tanHalfFovY * 16 / 9,
+      tanHalfFovY: tanHalfFovY,
+      near: 0.1,
+      far: 1000.0,
+      lights: lights,
+      maxPerCluster: 16,
+    );
+  });
+  results['light_clusters_256_entries'] = grid.indexCount.toDouble();
+
   const instanceCount = 50000;
   final rng = math.Random(11);
   final instances = List.generate(
@@ -111,6 +287,133 @@ Map<String, double> runMicroBenchmarks() {
     () => packInstanceTransforms(nodeTransform, instances),
   );
 
+  // Refreshing an instanced item's packed records after 64 instances moved:
+  // every record against only the edited range.
+  final instanceItem =
+      RenderItem(geometry: _StubGeometry(), material: _StubMaterial())
+        ..instanceTransforms = instances
+        ..instanceColors = List.generate(instanceCount, (_) => Vector4.all(1))
+        ..refreshInstanceData();
+  results['instance_refresh_full_50k'] = _time(
+    30,
+    () => instanceItem.refreshInstanceData(),
+  );
+  results['instance_refresh_range_50k'] = _time(
+    1000,
+    () => instanceItem.refreshInstanceData(start: 20000, end: 20064),
+  );
+
+  // Per-instance culling of 102,400 unit boxes on a 320x320 ground grid,
+  // seen from one corner: the linear sweep against the cluster tree.
+  const fieldSide = 320;
+  const fieldCount = fieldSide * fieldSide;
+  final fieldBounds = Float32List(fieldCount * 6);
+  for (var i = 0; i < fieldCount; i++) {
+    final x = (i % fieldSide) * 3.0, z = (i ~/ fieldSide) * 3.0;
+    fieldBounds.setAll(i * 6, [x - 0.5, 0, z - 0.5, x + 0.5, 1, z + 0.5]);
+  }
+  final fieldFrustum = Frustum.matrix(
+    makePerspectiveMatrix(math.pi / 3, 16 / 9, 0.1, 200)..multiply(
+      makeViewMatrix(
+        Vector3(-10, 20, -10),
+        Vector3(60, 0, 60),
+        Vector3(0, 1, 0),
+      ),
+    ),
+  );
+  final fieldPlanes = [
+    fieldFrustum.plane0,
+    fieldFrustum.plane1,
+    fieldFrustum.plane2,
+    fieldFrustum.plane3,
+    fieldFrustum.plane4,
+    fieldFrustum.plane5,
+  ];
+  final fieldVisible = <int>[];
+  results['instance_cull_linear_100k'] = _time(50, () {
+    _cullInstancesLinear(
+      fieldBounds,
+      fieldCount,
+      fieldPlanes,
+      fieldVisible..clear(),
+    );
+  });
+  final cullTree = InstanceCullTree();
+  results['instance_cull_tree_100k'] = _time(200, () {
+    cullTree.cull(
+      fieldBounds,
+      fieldCount,
+      fieldFrustum,
+      const [],
+      fieldVisible..clear(),
+    );
+  });
+  results['instance_cull_tree_100k_visible'] = fieldVisible.length.toDouble();
+
+  // Opaque draw ordering at 1k, 10k, and 100k records: the closure
+  // comparator sort against the keyed radix sort, and against the radix sort
+  // started from the order retained from the previous repetition (a steady
+  // scene), all restoring the same shuffled input each repetition. 24
+  // pipelines, 400 materials, and 2,000 geometries, with per-item light
+  // slices.
+  for (final count in const [1000, 10000, 100000]) {
+    final sortRng = math.Random(count);
+    // Stand-ins for identity hashes, which spread over 30 bits.
+    final hashes = List.generate(2000, (_) => sortRng.nextInt(1 << 30));
+    final sortScene = RenderScene();
+    final stubGeometry = _StubGeometry();
+    final stubMaterial = _StubMaterial();
+    final source = List.generate(count, (i) {
+      final geometry = sortRng.nextInt(2000);
+      final item = RenderItem(geometry: stubGeometry, material: stubMaterial);
+      sortScene.add(item);
+      return _SortRecord(
+        item: item,
+        pipeline: hashes[geometry % 24],
+        material: hashes[geometry % 400],
+        geometry: hashes[geometry],
+        lightOffset: sortRng.nextInt(count),
+        depth: sortRng.nextDouble() * 200,
+      );
+    });
+    final records = List.of(source);
+    final label = '${count ~/ 1000}k';
+    final reps = count >= 100000 ? 5 : 50;
+    results['draw_sort_comparator_$label'] = _time(reps, () {
+      records
+        ..setAll(0, source)
+        ..sort(_compareSortRecords);
+    });
+    final sorter = DrawKeySorter(6);
+    void radixSort(List<_SortRecord> list) {
+      sorter.reset(count);
+      for (var i = 0; i < count; i++) {
+        final record = list[i];
+        sorter
+          ..setKey(0, i, record.pipeline)
+          ..setKey(1, i, record.material)
+          ..setKey(2, i, record.geometry)
+          ..setKey(3, i, record.lightOffset)
+          ..setKey(4, i, DrawKeySorter.sortableFloatBits(record.fade))
+          ..setKey(5, i, DrawKeySorter.sortableFloatBits(record.depth));
+      }
+      sorter.sort(list, _compareSortRecords);
+    }
+
+    results['draw_sort_radix_$label'] = _time(reps, () {
+      radixSort(records..setAll(0, source));
+    });
+    final retained = RetainedDrawOrder(sortScene);
+    results['draw_sort_retained_$label'] = _time(reps, () {
+      retained.sort(
+        records..setAll(0, source),
+        _compareSortRecords,
+        (record) => record.item,
+        radixSort,
+      );
+    });
+  }
+
   // A deep parent chain. Dirtying the root and reading the leaf walks the
   // dirty flag down and the recompute up the full depth.
   const depth = 1000;
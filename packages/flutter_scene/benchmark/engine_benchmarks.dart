@@ -0,0 +1,832 @@
+/// The engine's CPU hot paths as benchmark cases over synthetic inputs.
+///
+/// Scaled cases run at every size in `sizes` (1k to 1M elements). Cases
+/// over full engine objects (render items, nodes, instance matrices) stop
+/// at [kObjectCaseMaxSize], where a larger run measures the allocator more
+/// than the code under test. The decoders run over the test fixtures, at
+/// the fixture's own size.
+library;
+
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_scene/fscene.dart'
+    show
+        PayloadEncoding,
+        PayloadSpec,
+        SceneDocument,
+        TrsTransform,
+        readFsceneb,
+        writeFsceneb;
+import 'package:flutter_scene/scene.dart';
+import 'package:flutter_scene/src/animation.dart'
+    show AnimationChannel, AnimationProperty, BindKey, PropertyResolver;
+import 'package:flutter_scene/src/animation_compression.dart';
+import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/importer/gltf.dart';
+import 'package:flutter_scene/src/importer/src/gltf/draco/mesh_decoder.dart';
+import 'package:flutter_scene/src/particles/particle_worker_pool.dart';
+import 'package:flutter_scene/src/render/bvh.dart';
+import 'package:flutter_scene/src/render/draw_sort.dart';
+import 'package:flutter_scene/src/render/instance_packing.dart';
+import 'package:flutter_scene/src/render/light_culling.dart';
+import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:flutter_scene/src/splats/splat_codec.dart';
+import 'package:flutter_scene/src/splats/splat_sort_service.dart';
+import 'package:flutter_scene/src/splats/splat_sorter.dart';
+import 'package:flutter_scene/src/splats/splat_stream.dart';
+import 'package:flutter_scene/src/texture/basisu/basis_ktx2.dart';
+import 'package:flutter_scene/src/texture/ktx2/ktx2.dart';
+import 'package:flutter_scene/src/texture/mipmap.dart';
+import 'package:flutter_scene/src/texture/supercompress/zstd.dart';
+import 'package:vector_math/vector_math.dart';
+
+import 'harness.dart';
+
+/// The largest size the object-graph cases run at.
+const int kObjectCaseMaxSize = 100000;
+
+/// Runs every case at each of [sizes].
+void runEngineBenchmarks(BenchmarkRunner runner, List<int> sizes) {
+  for (final size in sizes) {
+    if (size <= kObjectCaseMaxSize) {
+      _bvh(runner, size);
+      _instancePacking(runner, size);
+      _animation(runner, size);
+      _animationCrowd(runner, size);
+      _morphBlend(runner, size);
+      _fsceneb(runner, size);
+    }
+    _drawSort(runner, size);
+    _splatSort(runner, size);
+    _splatCodec(runner, size);
+    _splatLoad(runner, size);
+    _particles(runner, size);
+    _mipChain(runner, size);
+  }
+  _decoders(runner);
+}
+
+/// Non-renderable stand-ins so [RenderItem]s can be built without a GPU.
+class _StubGeometry extends Geometry {
+  @override
+  void bind(
+    gpu.RenderPass pass,
+    TransientWriter transientsBuffer,
+    Matrix4 modelTransform,
+    Matrix4 cameraTransform,
+    Vector3 cameraPosition, {
+    gpu.Shader? shaderOverride,
+    double depthBias = 0.0,
+  }) {
+    throw UnsupportedError('Stub geometry is not renderable');
+  }
+}
+
+class _StubMaterial extends Material {
+  @override
+  void bind(
+    gpu.RenderPass pass,
+    TransientWriter transientsBuffer,
+    Lighting lighting,
+  ) {
+    throw UnsupportedError('Stub material is not renderable');
+  }
+}
+
+// The side of a cube holding [count] unit items at a constant density, so
+// a query over part of it visits a constant fraction at every size.
+double _extent(int count) => 4 * math.pow(count, 1 / 3).toDouble();
+
+Vector3 _randomPoint(math.Random random, double extent) => Vector3(
+  (random.nextDouble() - 0.5) * extent,
+  (random.nextDouble() - 0.5) * extent,
+  (random.nextDouble() - 0.5) * extent,
+);
+
+void _bvh(BenchmarkRunner runner, int size) {
+  final random = math.Random(size);
+  final extent = _extent(size);
+  final geometry = _StubGeometry();
+  final material = _StubMaterial();
+  final items = List.generate(size, (_) {
+    final center = _randomPoint(random, extent);
+    return RenderItem(geometry: geometry, material: material)
+      ..worldBounds = Aabb3.minMax(
+        center - Vector3.all(0.5),
+        center + Vector3.all(0.5),
+      );
+  });
+
+  runner.run('bvh.build', size, () => Bvh.build(items));
+  final bvh = Bvh.build(items);
+
+  // Every item drifts, then the tree refits its bounds.
+  final drift = Vector3(0.01, 0, 0.01);
+  runner.run('bvh.refit', size, () {
+    for (final item in items) {
+      item.worldBounds!
+        ..min.add(drift)
+        ..max.add(drift);
+    }
+    bvh.refit();
+  });
+
+  // An orthographic view over half of the cube.
+  final half = extent / 2;
+  final frustum = Frustum.matrix(
+    makeOrthographicMatrix(-half, 0, -half, half, -extent, extent),
+  );
+  var visited = 0;
+  runner.run('bvh.query', size, () {
+    visited = 0;
+    bvh.query(frustum, (_) => visited++);
+  });
+
+  // 256 ranged point lights, one BVH query each plus per-item list
+  // assembly.
+  final lights = List.generate(256, (i) {
+    final position = _randomPoint(random, extent);
+    return CullableLight(
+      i,
+      lightInfluenceBounds(position, 4),
+      worldPosition: position,
+      range: 4,
+    );
+  });
+  runner.run('lights.assign', size, () {
+    assignLightsToItems(items: items, bvh: bvh, lights: lights, maxPerItem: 16);
+  });
+}
+
+void _instancePacking(BenchmarkRunner runner, int size) {
+  final random = math.Random(size);
+  final instances = List.generate(
+    size,
+    (_) => Matrix4.translation(_randomPoint(random, 100)),
+  );
+  final colors = List.generate(size, (_) => Vector4.all(1));
+  final batches = [
+    InstanceDataBatch(
+      nodeTransform: Matrix4.identity(),
+      instances: instances,
+      colors: colors,
+      nodeWindingFlipped: false,
+    ),
+  ];
+  final scratch = InstancePackingScratch();
+  runner.run(
+    'instances.pack',
+    size,
+    () => packInstanceDataBatches(batches, scratch: scratch),
+  );
+}
+
+// The key columns the scene encoder orders opaque draws by.
+class _DrawRecord {
+  _DrawRecord(this.pipeline, this.material, this.geometry, this.depth);
+
+  final int pipeline;
+  final int material;
+  final int geometry;
+  final double depth;
+}
+
+int _compareDrawRecords(_DrawRecord a, _DrawRecord b) {
+  final byPipeline = a.pipeline.compareTo(b.pipeline);
+  if (byPipeline != 0) return byPipeline;
+  final byMaterial = a.material.compareTo(b.material);
+  if (byMaterial != 0) return byMaterial;
+  final byGeometry = a.geometry.compareTo(b.geometry);
+  if (byGeometry != 0) return byGeometry;
+  return a.depth.compareTo(b.depth);
+}
+
+void _drawSort(BenchmarkRunner runner, int size) {
+  // 24 pipelines, 400 materials, and 2,000 geometries, identified by
+  // spread-out hashes as identity hashes are.
+  final random = math.Random(size);
+  final hashes = List.generate(2000, (_) => random.nextInt(1 << 30));
+  final source = List.generate(size, (_) {
+    final geometry = random.nextInt(2000);
+    return _DrawRecord(
+      hashes[geometry % 24],
+      hashes[geometry % 400],
+      hashes[geometry],
+      random.nextDouble() * 200,
+    );
+  });
+  final records = List.of(source);
+  final sorter = DrawKeySorter(4);
+  runner.run('encoder.sort', size, () {
+    sorter.reset(size);
+    for (var i = 0; i < size; i++) {
+      final record = records[i];
+      sorter
+        ..setKey(0, i, record.pipeline)
+        ..setKey(1, i, record.material)
+        ..setKey(2, i, record.geometry)
+        ..setKey(3, i, DrawKeySorter.sortableFloatBits(record.depth));
+    }
+    sorter.sort(records, _compareDrawRecords);
+  }, setUp: () => records.setAll(0, source));
+}
+
+Float32List _splatCloud(int size) {
+  final random = math.Random(size);
+  final positions = Float32List(size * 3);
+  for (var i = 0; i < positions.length; i++) {
+    positions[i] = (random.nextDouble() - 0.5) * 20;
+  }
+  return positions;
+}
+
+void _splatSort(BenchmarkRunner runner, int size) {
+  final positions = _splatCloud(size);
+  runner.run(
+    'splats.sort',
+    size,
+    () => sortSplatsBackToFront(positions, size, 0.3, -0.2, 0.93),
+  );
+  // The same sort with the working arrays kept between runs, as a
+  // long-lived sorter worker holds them.
+  final partition = SplatSortPartition(positions, count: size);
+  runner.run('splats.sort.reused', size, () {
+    final keys = partition.computeKeys(0.3, -0.2, 0.93);
+    partition.bucket(keys.minKey, keys.maxKey);
+  });
+  // A steady orbit a tenth of a degree per sort; includes the full sorts
+  // the sorter escalates to when a repair runs over budget.
+  final incremental = IncrementalSplatSorter(positions, count: size);
+  var angle = 0.0;
+  runner.run('splats.sort.incremental', size, () {
+    angle += math.pi / 1800;
+    incremental.sort(math.sin(angle), -0.2, math.cos(angle));
+  });
+}
+
+// A seeded splat set over [_splatCloud] with varied sizes and opacities.
+SplatData _splatSet(int size, {int shDegree = 0}) {
+  final random = math.Random(size);
+  final data = SplatData.zeroed(size, shDegree: shDegree);
+  data.positions.setAll(0, _splatCloud(size));
+  for (var i = 0; i < size; i++) {
+    for (var a = 0; a < 3; a++) {
+      data.scales[i * 3 + a] = 0.01 + random.nextDouble() * 0.2;
+      data.colors[i * 3 + a] = random.nextDouble();
+    }
+    data.rotations[i * 4 + 3] = 1;
+    data.opacities[i] = random.nextDouble();
+  }
+  final sh = data.sh;
+  if (sh != null) {
+    for (var k = 0; k < sh.length; k++) {
+      sh[k] = random.nextDouble() - 0.5;
+    }
+  }
+  return data;
+}
+
+// Packing and decoding throughput of each splat packing, with the GPU
+// bytes per splat each produces as a metric. Degree-1 SH, so the SH
+// texture's share shows.
+void _splatCodec(BenchmarkRunner runner, int size) {
+  final packings = [
+    for (final packing in SplatPacking.values)
+      if (runner.includes('splats.pack.${packing.name}') ||
+          runner.includes('splats.decode.compressedPly.${packing.name}'))
+        packing,
+  ];
+  if (packings.isEmpty) return;
+  final data = _splatSet(size, shDegree: 1);
+  final file = encodeCompressedSplatPly(data);
+
+  for (final packing in packings) {
+    final bytesPerSplat = {
+      'bytesPerSplat': packSplats(data, packing: packing).gpuBytes / size,
+    };
+    runner.run(
+      'splats.pack.${packing.name}',
+      size,
+      () => packSplats(data, packing: packing),
+      metrics: bytesPerSplat,
+    );
+    runner.run(
+      'splats.decode.compressedPly.${packing.name}',
+      size,
+      () => decodeSplats(
+        file,
+        SplatFormat.compressedPly,
+        options: SplatDecodeOptions(alphaCullThreshold: 0, packing: packing),
+      ),
+      metrics: {...bytesPerSplat, 'fileBytesPerSplat': file.length / size},
+    );
+  }
+}
+
+// Loading a training PLY whole against streaming it in 64 KiB chunks, as
+// GaussianSplats.fromBytes and fromStream do (minus the isolate hops).
+// splats.load.first is the time to the first drawable run; the heldFileBytes
+// metric is the most file bytes each holds at once. splats.budget.select
+// cuts the set to a quarter for one camera position.
+void _splatLoad(BenchmarkRunner runner, int size) {
+  if (!runner.includes('splats.load') && !runner.includes('splats.budget')) {
+    return;
+  }
+  final data = _splatSet(size).orderedByImportance();
+  final file = encodeSplatPly(data);
+  const options = SplatDecodeOptions(alphaCullThreshold: 0);
+  const chunk = 64 * 1024;
+
+  runner.run(
+    'splats.load.whole',
+    size,
+    () => decodeSplats(file, SplatFormat.ply, options: options),
+    metrics: {'heldFileBytes': file.length},
+  );
+
+  // Feeds chunks until [onRun] declines more runs; returns the largest
+  // run in bytes.
+  int stream(bool Function(SplatRecordLayout layout, Uint8List run) onRun) {
+    final reader = SplatStreamReader(options: options);
+    var largest = 0;
+    for (var offset = 0; offset < file.length; offset += chunk) {
+      final end = math.min(offset + chunk, file.length);
+      for (final run in reader.add(Uint8List.sublistView(file, offset, end))) {
+        largest = math.max(largest, run.length);
+        if (!onRun(reader.layout!, run)) return largest;
+      }
+    }
+    final last = reader.close();
+    if (last != null) onRun(reader.layout!, last);
+    return largest;
+  }
+
+  PackedSplats decodeRun(SplatRecordLayout layout, Uint8List run) =>
+      decodeSplatRecordsForIsolate((
+        layout: layout,
+        records: run,
+        alphaCullThreshold: 0,
+        packing: SplatPacking.full,
+      ));
+
+  runner.run('splats.load.first', size, () {
+    stream((layout, run) {
+      decodeRun(layout, run);
+      return false;
+    });
+  });
+
+  // A run plus the chunk that completed it is the most held at once.
+  final largestRun = stream((layout, run) => true);
+  runner.run(
+    'splats.load.stream',
+    size,
+    () {
+      PackedSplats? into;
+      var at = 0;
+      stream((layout, run) {
+        final batch = decodeRun(layout, run);
+        into ??= allocatePackedSplats(size, shDegree: layout.shDegree);
+        copyPackedSplats(batch, into!, at);
+        at += batch.data.count;
+        return true;
+      });
+    },
+    metrics: {'heldFileBytes': largestRun + chunk},
+  );
+
+  final importance = data.computeImportance();
+  final order = sortSplatsBackToFront(data.positions, size, 0.3, -0.2, 0.93);
+  final filter = SplatBudgetFilter(data.positions, importance, count: size);
+  final budget = (count: size ~/ 4, eyeX: 12.0, eyeY: 2.0, eyeZ: 5.0);
+  runner.run(
+    'splats.budget.select',
+    size,
+    () => filter.select(order, budget),
+  );
+}
+
+/// Times a full [SplatSortService] round-trip (request out, order back) at
+/// each of [sizes] for each pool size in [workerCounts]. The direction
+/// alternates so no run can be served from a previous result.
+Future<void> runSplatSortServiceBenchmarks(
+  BenchmarkRunner runner,
+  List<int> sizes, {
+  List<int> workerCounts = const [1, 2, 4],
+}) async {
+  for (final size in sizes) {
+    final positions = _splatCloud(size);
+    for (final workers in workerCounts) {
+      final name = 'splats.sortService.w$workers';
+      if (!runner.includes(name)) continue;
+      final service = SplatSortService(positions, size, workers: workers);
+      var flip = 1.0;
+      await runner.runAsync(name, size, () async {
+        flip = -flip;
+        await service.sort(0.3 * flip, -0.2, 0.93 * flip);
+      });
+      service.dispose();
+    }
+  }
+}
+
+/// The emitters [runParticleWorkerBenchmarks] splits each size across.
+const int kParticleBenchmarkEmitters = 8;
+
+ParticleSystem _steadyEmitter(int particles, int seed) => ParticleSystem(
+  maxParticles: particles,
+  shape: const SphereEmitterShape(),
+  spawner: Spawner(rate: particles.toDouble()),
+  startSpeed: const ConstantFloat(2),
+  gravity: Vector3(0, -9.8, 0),
+  modules: [LinearDragModule(0.5), const RotationModule()],
+  prewarm: 1,
+  seed: seed,
+);
+
+/// Compares a frame of [kParticleBenchmarkEmitters] steady emitters, each
+/// size/8 particles, simulated and packed on the calling thread against
+/// the same frame on a [ParticleWorkerPool]. The off-thread case times the
+/// round trip; its renderThreadUs metric is the median time the calling
+/// thread itself spends per frame (issuing the steps and copying the frames
+/// out), which is what an off-thread emitter costs the render thread.
+Future<void> runParticleWorkerBenchmarks(
+  BenchmarkRunner runner,
+  List<int> sizes,
+) async {
+  const dt = 1 / 60;
+  for (final size in sizes) {
+    final perEmitter = math.max(1, size ~/ kParticleBenchmarkEmitters);
+    final buffers = [
+      for (var e = 0; e < kParticleBenchmarkEmitters; e++)
+        Float32List(perEmitter * kParticleBillboardFloats),
+    ];
+    if (runner.includes('particles.frame.onThread')) {
+      final systems = [
+        for (var e = 0; e < kParticleBenchmarkEmitters; e++)
+          _steadyEmitter(perEmitter, e),
+      ];
+      runner.run('particles.frame.onThread', size, () {
+        for (var e = 0; e < systems.length; e++) {
+          systems[e].step(dt);
+          packParticleBillboards(systems[e].storage, buffers[e]);
+        }
+      });
+    }
+    if (!runner.includes('particles.frame.offThread')) continue;
+    final pool = ParticleWorkerPool();
+    final handles = [
+      for (var e = 0; e < kParticleBenchmarkEmitters; e++)
+        pool.attach(_steadyEmitter(perEmitter, e)),
+    ];
+    final stopwatch = Stopwatch();
+    Future<void> frame() async {
+      stopwatch.start();
+      final steps = [for (final handle in handles) handle.step(const [dt])];
+      stopwatch.stop();
+      final frames = await Future.wait(steps);
+      stopwatch.start();
+      for (var e = 0; e < frames.length; e++) {
+        final frame = frames[e]!;
+        buffers[e].setRange(
+          0,
+          frame.count * kParticleBillboardFloats,
+          frame.instances,
+        );
+      }
+      stopwatch.stop();
+    }
+
+    // Sample the render-thread share first, so it can ride on the result.
+    await frame();
+    final renderThread = <int>[];
+    for (var i = 0; i < 31; i++) {
+      stopwatch.reset();
+      await frame();
+      renderThread.add(stopwatch.elapsedMicroseconds);
+    }
+    renderThread.sort();
+    await runner.runAsync(
+      'particles.frame.offThread',
+      size,
+      frame,
+      metrics: {'renderThreadUs': renderThread[renderThread.length ~/ 2]},
+    );
+    pool.dispose();
+  }
+}
+
+void _particles(BenchmarkRunner runner, int size) {
+  // A steady emitter at capacity: one particle born per death. The scalar
+  // case runs the same chain module by module, for the fused kernel's
+  // speedup.
+  ParticleSystem emitter({required bool fused}) => ParticleSystem(
+    maxParticles: size,
+    shape: const SphereEmitterShape(),
+    spawner: Spawner(rate: size.toDouble()),
+    startSpeed: const ConstantFloat(2),
+    gravity: Vector3(0, -9.8, 0),
+    modules: [LinearDragModule(0.5), const RotationModule()],
+    prewarm: 1,
+    fusedKernels: fused,
+  );
+  final system = emitter(fused: true);
+  runner.run('particles.update', size, () => system.step(1 / 60));
+  final scalar = emitter(fused: false);
+  runner.run('particles.update.scalar', size, () => scalar.step(1 / 60));
+}
+
+void _animation(BenchmarkRunner runner, int size) {
+  // One translation and one rotation channel per node, about size
+  // channels in total, sharing two resolvers to keep the keyframe data
+  // small. The long clip keys them at 30 fps for 30 seconds, as mocap
+  // does, so keyframe lookup shows; the compressed run samples the same
+  // keys quantized, to price decoding against the float resolvers.
+  for (final (suffix, keys, step, compressed) in [
+    ('', 3, 0.5, false),
+    ('.longClip', 900, 1 / 30, false),
+    ('.compressed', 900, 1 / 30, true),
+  ]) {
+    final nodes = size ~/ 2;
+    final root = Node(name: 'root');
+    for (var i = 0; i < nodes; i++) {
+      root.add(Node(name: 'bone$i'));
+    }
+    final times = [for (var k = 0; k < keys; k++) k * step];
+    final translations = [
+      for (var k = 0; k < keys; k++) Vector3(0, k.isOdd ? 1 : 0, 0),
+    ];
+    final rotations = [
+      for (var k = 0; k < keys; k++)
+        Quaternion.axisAngle(Vector3(0, 1, 0), k.isOdd ? 1 : 0),
+    ];
+    final translation = compressed
+        ? PropertyResolver.makeCompressedTimeline(
+            AnimationProperty.translation,
+            times,
+            CompressedKeyframes.vector3(
+              Float32List.fromList([
+                for (final v in translations) ...v.storage,
+              ]),
+            ),
+          )
+        : PropertyResolver.makeTranslationTimeline(times, translations);
+    final rotation = compressed
+        ? PropertyResolver.makeCompressedTimeline(
+            AnimationProperty.rotation,
+            times,
+            CompressedKeyframes.rotation(
+              Float32List.fromList([for (final q in rotations) ...q.storage]),
+            ),
+          )
+        : PropertyResolver.makeRotationTimeline(times, rotations);
+    final animation = Animation(
+      name: 'bench',
+      channels: [
+        for (var i = 0; i < nodes; i++) ...[
+          AnimationChannel(
+            bindTarget: BindKey(nodeName: 'bone$i'),
+            resolver: translation,
+          ),
+          AnimationChannel(
+            bindTarget: BindKey(nodeName: 'bone$i'),
+            resolver: rotation,
+          ),
+        ],
+      ],
+    );
+    final player = AnimationPlayer();
+    player.createAnimationClip(animation, root)
+      ..loop = true
+      ..play();
+    runner.run('animation.update$suffix', size, () => player.update(1 / 60));
+  }
+}
+
+void _animationCrowd(BenchmarkRunner runner, int size) {
+  // size joints: characters with a 10-joint chain each, playing one 2 s
+  // clip from scattered start times. The unshared case poses each
+  // character and computes its joint matrices, the CPU half of a skin's
+  // joints texture; the lod case skips evaluations by projected size; the
+  // crowd case evaluates each 1/30 s bucket once.
+  const jointCount = 10;
+  final characters = math.max(1, size ~/ jointCount);
+  final template = Node(name: 'character');
+  final skin = Skin();
+  Node parent = template;
+  for (var j = 0; j < jointCount; j++) {
+    final joint = Node(
+      name: 'joint$j',
+      localTransform: Matrix4.translationValues(0, 0.2, 0),
+    );
+    parent.add(joint);
+    parent = joint;
+    skin.joints.add(joint);
+    skin.inverseBindMatrices.add(Matrix4.translationValues(0, -0.2 * j, 0));
+  }
+  template.add(Node(name: 'body')..skin = skin);
+  final times = [for (var k = 0; k <= 60; k++) k / 30];
+  final rotation = PropertyResolver.makeRotationTimeline(times, [
+    for (final t in times) Quaternion.axisAngle(Vector3(0, 0, 1), t),
+  ]);
+  final animation = Animation(
+    name: 'sway',
+    channels: [
+      for (var j = 0; j < jointCount; j++)
+        AnimationChannel(
+          bindTarget: BindKey(
+            nodeName: 'joint$j',
+            property: AnimationProperty.rotation,
+          ),
+          resolver: rotation,
+        ),
+    ],
+  );
+
+  final random = math.Random(size);
+  final crowd = AnimationCrowd();
+  final unshared = <(Node, Skin)>[];
+  for (var i = 0; i < characters; i++) {
+    final time = random.nextDouble() * 2;
+    crowd.add(
+      template.clone(),
+      template: template,
+      animation: animation,
+      time: time,
+    );
+    final character = template.clone();
+    character.createAnimationClip(animation)
+      ..loop = true
+      ..seek(time)
+      ..play();
+    unshared.add((character, character.getChildByName('body')!.skin!));
+  }
+  final matrices = Float32List(jointCount * 16);
+  runner.run('animation.crowd.unshared', size, () {
+    for (final (character, skin) in unshared) {
+      character.scenePrePass(1 / 60);
+      skin.writeJointMatrices(matrices);
+    }
+  });
+  // The same characters under the default level-of-detail policy, spread
+  // across its sizes with a quarter off screen.
+  const sizes = <double>[double.infinity, 0.1, 0.03, 0.01, 0];
+  final lod = [
+    for (var i = 0; i < unshared.length; i++)
+      (
+        unshared[i].$1.animationPlayer!
+          ..lodPolicy = const AnimationLodPolicy(radius: 1),
+        sizes[i % sizes.length],
+      ),
+  ];
+  void updateLod() {
+    for (final (player, screenSize) in lod) {
+      player.update(1 / 60, screenSize: screenSize);
+    }
+  }
+
+  // Skipped clip evaluations per frame, averaged over the longest interval.
+  var skipped = 0;
+  for (var frame = 0; frame < 8; frame++) {
+    updateLod();
+    for (final (player, _) in lod) {
+      skipped += player.skippedEvaluations;
+    }
+  }
+  runner.run(
+    'animation.crowd.lod',
+    size,
+    updateLod,
+    metrics: {'characters': characters, 'skippedPerFrame': skipped / 8},
+  );
+  crowd.update(1 / 60);
+  runner.run(
+    'animation.crowd',
+    size,
+    () => crowd.update(1 / 60),
+    metrics: {'characters': characters, 'poses': crowd.poseCount},
+  );
+}
+
+void _morphBlend(BenchmarkRunner runner, int size) {
+  // A facial rig over size vertices: 32 targets, each moving its own
+  // window of a twentieth of the mesh, all weighted at once. The dense run
+  // blends every vertex of every target; the run-encoded one only the
+  // windows.
+  const targets = 32;
+  final window = math.max(1, size ~/ 20);
+  final positions = Float32List(targets * size * 3);
+  for (var t = 0; t < targets; t++) {
+    final first = (t * size ~/ targets) % math.max(1, size - window);
+    for (var v = first; v < first + window && v < size; v++) {
+      positions[(t * size + v) * 3 + 1] = 0.01;
+    }
+  }
+  final dense = MorphTargetData(
+    vertexCount: size,
+    targetCount: targets,
+    positionDeltas: positions,
+  );
+  final sparse = MorphTargetData.sparse(
+    SparseMorphDeltas.fromDense(
+      vertexCount: size,
+      targetCount: targets,
+      positions: positions,
+    ),
+  );
+  final base = Float32List(size * 3);
+  final weights = Float32List(targets)..fillRange(0, targets, 0.5);
+  final out = Float32List(size * 3);
+  for (final (suffix, data) in [('dense', dense), ('sparse', sparse)]) {
+    runner.run(
+      'morph.blend.$suffix',
+      size,
+      () => data.blendPositions(base, weights, out: out),
+      metrics: {'deltaBytes': data.deltaBytes},
+    );
+  }
+}
+
+void _fsceneb(BenchmarkRunner runner, int size) {
+  // size nodes and a vertex payload of 32 bytes per node.
+  final doc = SceneDocument()..generator = 'benchmark';
+  for (var i = 0; i < size; i++) {
+    doc.createNode(
+      name: 'node$i',
+      transform: TrsTransform(translation: Vector3(i.toDouble(), 0, 0)),
+      root: true,
+    );
+  }
+  doc.addPayload(
+    PayloadSpec(
+      doc.newId(),
+      encoding: PayloadEncoding.vertexBuffer,
+      layout: 'unskinned',
+      bytes: Uint8List(size * 32),
+    ),
+  );
+  runner.run('fsceneb.write', size, () => writeFsceneb(doc));
+  final bytes = writeFsceneb(doc);
+  runner.run('fsceneb.read', size, () => readFsceneb(bytes));
+}
+
+void _mipChain(BenchmarkRunner runner, int size) {
+  // A square image of about size pixels.
+  final side = math.sqrt(size).round();
+  final random = math.Random(size);
+  final pixels = Uint8List(side * side * 4);
+  for (var i = 0; i < pixels.length; i++) {
+    pixels[i] = random.nextInt(256);
+  }
+  runner.run(
+    'mips.generate',
+    side * side,
+    () => generateMipChain(pixels, side, side, TextureContent.color),
+  );
+}
+
+Uint8List _fixture(String path) =>
+    File('test/fixtures/$path').readAsBytesSync();
+
+void _decoders(BenchmarkRunner runner) {
+  const textSize = 300000;
+  final text = _fixture('zstd/text_300k.l3.zst');
+  runner.run('zstd.decompress', textSize, () => zstdDecompress(text, textSize));
+
+  final meshopt = parseGlb(_fixture('meshopt/two_triangles_compressed.glb'));
+  final meshoptDoc = parseGltfJson(meshopt.json);
+  final meshoptVertices = meshoptDoc.accessors.first.count;
+  runner.run(
+    'meshopt.decode',
+    meshoptVertices,
+    () => decodeMeshoptBufferViews(meshoptDoc, meshopt.binaryChunk),
+  );
+
+  // The KHR_draco_mesh_compression payload of the first primitive.
+  final draco = parseGlb(_fixture('draco/synthetic_draco_eb.glb'));
+  final dracoDoc = parseGltfJson(draco.json);
+  final compression = dracoDoc.meshes.first.primitives.first.draco!;
+  final view = dracoDoc.bufferViews[compression.bufferView];
+  final dracoBytes = Uint8List.sublistView(
+    draco.binaryChunk,
+    view.byteOffset,
+    view.byteOffset + view.byteLength,
+  );
+  runner.run(
+    'draco.decode',
+    decodeDracoMesh(dracoBytes).numPoints,
+    () => decodeDracoMesh(dracoBytes),
+  );
+
+  for (final name in ['uastc_srgb_mips_zstd_64', 'etc1s_srgb_mips_64']) {
+    final texture = readKtx2(_fixture('ktx2/$name.ktx2'));
+    final codec = name.split('_').first;
+    runner.run(
+      'basisu.$codec',
+      64 * 64,
+      () => decodeStandardKtx2(texture),
+    );
+  }
+}
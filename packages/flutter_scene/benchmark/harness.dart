@@ -0,0 +1,251 @@
+/// Timing, JSON output, and baseline comparison for the engine's headless
+/// micro-benchmarks (see `hot_paths_benchmark_test.dart`).
+///
+/// Each case runs once to warm up, then repeats until it has spent
+/// [BenchmarkRunner.minDuration] and at least [BenchmarkRunner.minRuns]
+/// runs; the median run is what a baseline comparison reads, so a single
+/// GC pause does not read as a regression.
+library;
+
+import 'dart:convert';
+
+/// The version of the JSON layout [BenchmarkReport.toJson] writes.
+const int kBenchmarkSchemaVersion = 1;
+
+/// The timings of one benchmark case at one size.
+class BenchmarkResult {
+  BenchmarkResult({
+    required this.name,
+    required this.size,
+    required this.runs,
+    required this.medianMicros,
+    required this.minMicros,
+    required this.meanMicros,
+    this.metrics = const {},
+  });
+
+  factory BenchmarkResult.fromJson(Map<String, Object?> json) =>
+      BenchmarkResult(
+        name: json['name']! as String,
+        size: json['size']! as int,
+        runs: json['runs']! as int,
+        medianMicros: (json['medianUs']! as num).toDouble(),
+        minMicros: (json['minUs']! as num).toDouble(),
+        meanMicros: (json['meanUs']! as num).toDouble(),
+        metrics: (json['metrics'] as Map?)?.cast<String, num>() ?? const {},
+      );
+
+  /// The case name, dotted by subsystem (`bvh.build`).
+  final String name;
+
+  /// The number of elements the case ran over.
+  final int size;
+
+  /// The number of timed runs.
+  final int runs;
+
+  final double medianMicros;
+  final double minMicros;
+  final double meanMicros;
+
+  /// Non-timing measurements of the case (`bytesPerSplat`), reported
+  /// alongside the timings but never compared against a baseline.
+  final Map<String, num> metrics;
+
+  /// The key a baseline matches results by.
+  String get key => '$name/$size';
+
+  Map<String, Object> toJson() => {
+    'name': name,
+    'size': size,
+    'runs': runs,
+    'medianUs': _round(medianMicros),
+    'minUs': _round(minMicros),
+    'meanUs': _round(meanMicros),
+    if (metrics.isNotEmpty) 'metrics': metrics,
+  };
+
+  static double _round(double micros) => (micros * 1000).round() / 1000;
+}
+
+/// A set of [BenchmarkResult]s, as written to and read from JSON.
+class BenchmarkReport {
+  BenchmarkReport(this.results, {this.environment = const {}});
+
+  factory BenchmarkReport.fromJson(Map<String, Object?> json) {
+    final schema = json['schema'];
+    if (schema != kBenchmarkSchemaVersion) {
+      throw FormatException('Unsupported benchmark schema $schema');
+    }
+    return BenchmarkReport(
+      [
+        for (final result in json['results']! as List)
+          BenchmarkResult.fromJson(result as Map<String, Object?>),
+      ],
+      environment:
+          (json['environment'] as Map?)?.cast<String, String>() ?? const {},
+    );
+  }
+
+  factory BenchmarkReport.decode(String source) =>
+      BenchmarkReport.fromJson(jsonDecode(source) as Map<String, Object?>);
+
+  final List<BenchmarkResult> results;
+
+  /// Free-form facts about the run (Dart version, build mode).
+  final Map<String, String> environment;
+
+  Map<String, Object> toJson() => {
+    'schema': kBenchmarkSchemaVersion,
+    'environment': environment,
+    'results': [for (final result in results) result.toJson()],
+  };
+
+  String encode() => const JsonEncoder.withIndent('  ').convert(toJson());
+}
+
+/// One case slower than its baseline by more than the allowed threshold.
+class BenchmarkRegression {
+  BenchmarkRegression(this.current, this.baseline);
+
+  final BenchmarkResult current;
+  final BenchmarkResult baseline;
+
+  /// Current median over baseline median; 1.25 is 25% slower.
+  double get ratio => current.medianMicros / baseline.medianMicros;
+
+  @override
+  String toString() =>
+      '${current.key}: ${baseline.medianMicros.toStringAsFixed(1)} us -> '
+      '${current.medianMicros.toStringAsFixed(1)} us '
+      '(+${((ratio - 1) * 100).toStringAsFixed(1)}%)';
+}
+
+/// The cases in [current] whose median exceeds the matching [baseline]
+/// case's by more than [threshold] (0.1 allows 10%). Cases missing from
+/// either report are skipped, as are baselines under [noiseFloorMicros],
+/// where timer resolution dominates.
+List<BenchmarkRegression> compareToBaseline(
+  BenchmarkReport current,
+  BenchmarkReport baseline, {
+  required double threshold,
+  double noiseFloorMicros = 1.0,
+}) {
+  final byKey = {for (final result in baseline.results) result.key: result};
+  return [
+    for (final result in current.results)
+      if (byKey[result.key] case final base?)
+        if (base.medianMicros >= noiseFloorMicros &&
+            result.medianMicros > base.medianMicros * (1 + threshold))
+          BenchmarkRegression(result, base),
+  ];
+}
+
+/// Runs benchmark cases and collects their [results].
+class BenchmarkRunner {
+  BenchmarkRunner({
+    this.minDuration = const Duration(milliseconds: 200),
+    this.minRuns = 3,
+    this.maxRuns = 1000,
+    this.filter,
+    this.log,
+  });
+
+  final Duration minDuration;
+  final int minRuns;
+  final int maxRuns;
+
+  /// When set, only cases whose name matches run.
+  final Pattern? filter;
+
+  /// Receives one line per finished case.
+  final void Function(String line)? log;
+
+  final List<BenchmarkResult> results = [];
+
+  /// Whether a case named [name] passes [filter].
+  bool includes(String name) => filter == null || name.contains(filter!);
+
+  /// Times [body] over [size] elements. [setUp], when given, runs before
+  /// every run outside the timed region (to restore mutated input);
+  /// [metrics] are recorded with the result as given.
+  void run(
+    String name,
+    int size,
+    void Function() body, {
+    void Function()? setUp,
+    Map<String, num> metrics = const {},
+  }) {
+    if (!includes(name)) return;
+    setUp?.call();
+    body();
+    final samples = <int>[];
+    final total = Stopwatch()..start();
+    final stopwatch = Stopwatch();
+    while (samples.length < maxRuns &&
+        (samples.length < minRuns || total.elapsed < minDuration)) {
+      setUp?.call();
+      stopwatch
+        ..reset()
+        ..start();
+      body();
+      stopwatch.stop();
+      samples.add(stopwatch.elapsedMicroseconds);
+    }
+    _record(name, size, samples, metrics);
+  }
+
+  /// [run] for a [body] that completes asynchronously (a round-trip to
+  /// worker isolates); each run is timed until its future completes.
+  Future<void> runAsync(
+    String name,
+    int size,
+    Future<void> Function() body, {
+    Map<String, num> metrics = const {},
+  }) async {
+    if (!includes(name)) return;
+    await body();
+    final samples = <int>[];
+    final total = Stopwatch()..start();
+    final stopwatch = Stopwatch();
+    while (samples.length < maxRuns &&
+        (samples.length < minRuns || total.elapsed < minDuration)) {
+      stopwatch
+        ..reset()
+        ..start();
+      await body();
+      stopwatch.stop();
+      samples.add(stopwatch.elapsedMicroseconds);
+    }
+    _record(name, size, samples, metrics);
+  }
+
+  void _record(
+    String name,
+    int size,
+    List<int> samples,
+    Map<String, num> metrics,
+  ) {
+    samples.sort();
+    final middle = samples.length ~/ 2;
+    final median = samples.length.isOdd
+        ? samples[middle].toDouble()
+        : (samples[middle - 1] + samples[middle]) / 2;
+    final result = BenchmarkResult(
+      name: name,
+      size: size,
+      runs: samples.length,
+      medianMicros: median,
+      minMicros: samples.first.toDouble(),
+      meanMicros: samples.reduce((a, b) => a + b) / samples.length,
+      metrics: metrics,
+    );
+    results.add(result);
+    final extra = metrics.entries.map((e) => ' ${e.key}=${e.value}').join();
+    log?.call(
+      '${result.key.padRight(40)} '
+      '${result.medianMicros.toStringAsFixed(1).padLeft(12)} us '
+      '(${result.runs} runs)$extra',
+    );
+  }
+}
@@ -0,0 +1,78 @@
+// Headless micro-benchmarks of the engine's CPU hot paths (no GPU). Not
+// part of `flutter test`'s default run; run from the package root with
+//
+//   flutter test benchmark --dart-define=BENCHMARK_OUTPUT=results.json
+//
+// Options, all --dart-define:
+//   BENCHMARK_OUTPUT     where to write the JSON results
+//                        (default build/benchmark/results.json)
+//   BENCHMARK_BASELINE   a previous results file; the run fails when a case
+//                        regresses past BENCHMARK_THRESHOLD against it
+//   BENCHMARK_THRESHOLD  the allowed slowdown as a fraction (default 0.1)
+//   BENCHMARK_MAX_SIZE   the largest synthetic size to run (default 1000000)
+//   BENCHMARK_FILTER     only run cases whose name contains this
+//
+// Timings in JIT (debug) mode do not predict AOT; compare runs made the same
+// way on the same machine.
+
+import 'dart:io';
+
+import 'package:flutter_test/flutter_test.dart';
+
+import 'engine_benchmarks.dart';
+import 'harness.dart';
+
+const String _output = String.fromEnvironment(
+  'BENCHMARK_OUTPUT',
+  defaultValue: 'build/benchmark/results.json',
+);
+const String _baseline = String.fromEnvironment('BENCHMARK_BASELINE');
+const String _threshold = String.fromEnvironment(
+  'BENCHMARK_THRESHOLD',
+  defaultValue: '0.1',
+);
+const int _maxSize = int.fromEnvironment(
+  'BENCHMARK_MAX_SIZE',
+  defaultValue: 1000000,
+);
+const String _filter = String.fromEnvironment('BENCHMARK_FILTER');
+
+const List<int> _sizes = [1000, 10000, 100000, 1000000];
+
+void main() {
+  test('engine hot paths', () async {
+    final runner = BenchmarkRunner(
+      filter: _filter.isEmpty ? null : _filter,
+      // ignore: avoid_print
+      log: print,
+    );
+    final sizes = [
+      for (final size in _sizes)
+        if (size <= _maxSize) size,
+    ];
+    runEngineBenchmarks(runner, sizes);
+    await runSplatSortServiceBenchmarks(runner, sizes);
+    await runParticleWorkerBenchmarks(runner, sizes);
+    final report = BenchmarkReport(
+      runner.results,
+      environment: {'dart': Platform.version.split(' ').first},
+    );
+    File(_output)
+      ..createSync(recursive: true)
+      ..writeAsStringSync(report.encode());
+
+    if (_baseline.isEmpty) return;
+    final regressions = compareToBaseline(
+      report,
+      BenchmarkReport.decode(File(_baseline).readAsStringSync()),
+      threshold: double.parse(_threshold),
+    );
+    expect(
+      regressions,
+      isEmpty,
+      reason:
+          'Slower than $_baseline by more than $_threshold:\n'
+          '${regressions.join('\n')}',
+    );
+  }, timeout: Timeout.none);
+}
@@ -25,6 +25,30 @@ void main(List<String> args) {
           'Store images as mipped, supercompressed KTX2 block payloads '
           'instead of raw rgba8.',
     )
+    ..addFlag(
+      'optimize-vertex-order',
+      help:
+          'Reorder triangles and vertices for the GPU vertex cache, '
+          'overdraw, and vertex fetch.',
+    )
+    ..addOption(
+      'lod-levels',
+      defaultsTo: '0',
+      help:
+          'Simplified levels of detail to generate per single-primitive '
+          'mesh, emitted as lod components.',
+    )
+    ..addOption(
+      'lod-reduction',
+      defaultsTo: '0.5',
+      help: 'Fraction of the previous level\'s triangles each LOD keeps.',
+    )
+    ..addOption(
+      'animation-tolerance',
+      help:
+          'Compress animation channels, keeping joint-space error within '
+          'this many scene units. Off by default.',
+    )
     ..addOption(
       'working-directory',
       abbr: 'w',
@@ -39,6 +63,13 @@ void main(List<String> args) {
   final output = results['output'] as String?;
   final workingDirectory = results['working-directory'] as String?;
   final compressTextures = results['compress-textures'] as bool;
+  final optimizeVertexOrder = results['optimize-vertex-order'] as bool;
+  final lodLevels = int.tryParse(results['lod-levels'] as String);
+  final lodReduction = double.tryParse(results['lod-reduction'] as String);
+  final animationToleranceArg = results['animation-tolerance'] as String?;
+  final animationTolerance = animationToleranceArg == null
+      ? null
+      : double.tryParse(animationToleranceArg);
 
   if (input == null || output == null) {
     // ignore: avoid_print
@@ -47,11 +78,34 @@ void main(List<String> args) {
     );
     exit(1);
   }
+  if (lodLevels == null ||
+      lodLevels < 0 ||
+      lodReduction == null ||
+      lodReduction <= 0 ||
+      lodReduction >= 1) {
+    // ignore: avoid_print
+    print('--lod-levels must be >= 0 and --lod-reduction in (0, 1).');
+    exit(1);
+  }
+  if (animationToleranceArg != null &&
+      (animationTolerance == null || animationTolerance <= 0)) {
+    // ignore: avoid_print
+    print('--animation-tolerance must be > 0.');
+    exit(1);
+  }
 
   importGltfToFsceneb(
     input,
     output,
     workingDirectory: workingDirectory,
     compressTextures: compressTextures,
+    lodLevels: lodLevels,
+    lodReduction: lodReduction,
+    optimizeVertexOrder: optimizeVertexOrder,
+    // ignore: avoid_print
+    onLodReport: print,
+    animationTolerance: animationTolerance,
+    // ignore: avoid_print
+    onAnimationReport: print,
   );
 }
@@ -23,7 +23,14 @@
 /// project (see the package README).
 library;
 
-export 'src/animation.dart' show Animation, AnimationClip, AnimationPlayer;
+export 'src/animation.dart'
+    show
+        Animation,
+        AnimationClip,
+        AnimationLodLevel,
+        AnimationLodPolicy,
+        AnimationPlayer;
+export 'src/animation_crowd.dart' show AnimationCrowd, CrowdMember;
 
 export 'src/geometry/billboard_geometry.dart'
     show BillboardFacing, BillboardGeometry;
@@ -45,9 +52,9 @@ export 'src/geometry/mesh_data.dart'
 export 'src/geometry/mesh_geometry.dart'
     show GeometryBuilder, GeometryStorage, MeshGeometry;
 export 'src/geometry/morph_targets.dart'
-    show MorphTargetData, kMaxGpuMorphTargets;
+    show MorphTargetData, SparseMorphDeltas, kMaxGpuMorphTargets;
 export 'src/geometry/morphed_geometry.dart'
-    show MorphedSkinnedGeometry, MorphedUnskinnedGeometry;
+    show MorphFrameStats, MorphedSkinnedGeometry, MorphedUnskinnedGeometry;
 export 'src/geometry/primitives.dart'
     show
         CapsuleGeometry,
@@ -124,9 +131,11 @@ export 'src/ambient_occlusion.dart'
         AmbientOcclusionSettings,
         SpecularAmbientOcclusionMode;
 export 'src/auto_exposure.dart' show AutoExposureSettings;
+export 'src/clustered_lighting.dart' show ClusteredLightingSettings;
 export 'src/depth_of_field.dart' show DepthOfField, DepthOfFieldQuality;
 export 'src/fog.dart' show Fog, FogMode;
 export 'src/god_rays.dart' show GodRaysSettings;
+export 'src/occlusion_culling.dart' show Occluder, OcclusionCullingSettings;
 export 'src/screen_space_reflections.dart'
     show ScreenSpaceReflectionsSettings, SsrDebugView;
 export 'src/asset_helpers.dart'
@@ -168,7 +177,7 @@ export 'src/components/rect_area_light_component.dart'
 export 'src/components/semantics_component.dart' show SemanticsComponent;
 export 'src/components/splat_component.dart' show SplatComponent;
 export 'src/components/spot_light_component.dart' show SpotLightComponent;
-export 'src/render/lod.dart' show LodLevel;
+export 'src/render/lod.dart' show LodLevel, LodView;
 export 'src/components/widget_component.dart' show WidgetComponent, WidgetInput;
 export 'src/components/particle_emitter_component.dart'
     show ParticleEmitterComponent;
@@ -176,6 +185,8 @@ export 'src/components/mesh_particle_emitter_component.dart'
     show MeshParticleEmitterComponent, MeshParticleFacing;
 export 'src/components/trail_component.dart' show TrailComponent;
 export 'src/particles/particle_system.dart' show ParticleSystem;
+export 'src/particles/particle_worker_pool.dart'
+    show OffThreadParticles, ParticleWorkerPool;
 export 'src/particles/particle_storage.dart' show ParticleStorage;
 export 'src/particles/particle_module.dart'
     show
@@ -212,7 +223,8 @@ export 'src/particles/distribution.dart'
 export 'src/particles/spawner.dart' show ParticleBurst, Spawner;
 export 'src/geometry/splat_geometry.dart' show SplatCropMode;
 export 'src/splats/gaussian_splats.dart' show GaussianSplats;
-export 'src/splats/splat_codec.dart' show SplatFormat;
+export 'src/splats/splat_codec.dart'
+    show SplatFormat, SplatPacking, encodeSplatPly;
 export 'src/splats/splat_data.dart' show SplatColorSpace, SplatData;
 export 'src/instanced_mesh.dart' show InstancedMesh;
 export 'src/light.dart'
@@ -227,7 +239,9 @@ export 'src/light.dart'
         SpotLight;
 export 'src/render/custom_render_pass.dart'
     show CustomRenderPass, RenderInput, RenderPassContext, RenderStage;
-export 'src/render/frame_transients.dart' show TransientWriter;
+export 'src/render/frame_tracer.dart' show FrameTracer;
+export 'src/render/frame_transients.dart'
+    show TransientFrameStats, TransientWriter;
 export 'src/render/render_graph_capture.dart'
     show
         CapturedPass,
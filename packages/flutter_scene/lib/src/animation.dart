@@ -16,12 +16,17 @@ import 'dart:math';
 import 'dart:typed_data';
 import 'dart:ui';
 
+import 'package:flutter_scene/src/animation_compression.dart';
 import 'package:flutter_scene/src/node.dart';
 import 'package:flutter_scene/src/math_extensions.dart';
+import 'package:flutter_scene/src/render/lod.dart' show LodView, lodScreenSize;
 import 'package:vector_math/vector_math.dart';
 
 part 'animation/animation.dart';
 part 'animation/animation_clip.dart';
+part 'animation/animation_lod.dart';
 part 'animation/animation_player.dart';
 part 'animation/animation_transform.dart';
+part 'animation/compressed_resolver.dart';
+part 'animation/pose_buffer.dart';
 part 'animation/property_resolver.dart';
@@ -4,6 +4,14 @@ class _ChannelBinding {
   AnimationChannel channel;
   Node node;
 
+  /// The player's pose slot for [node], assigned when it lays out its
+  /// pose buffer.
+  int slot = -1;
+
+  /// The keyframe cursor [TimelineResolver]s seek from, so playback that
+  /// moves forward finds its keyframes in a step or two.
+  final _TimelineKey key = _TimelineKey(0, 1);
+
   _ChannelBinding(this.channel, this.node);
 }
 
@@ -22,6 +30,10 @@ class AnimationClip {
   Animation _animation;
   final List<_ChannelBinding> _bindings = [];
 
+  // Set when the bindings are rebuilt, so the player re-lays out its pose
+  // buffer before blending them.
+  bool _rebound = true;
+
   double _playbackTime = 0;
 
   /// The current playback position in seconds, in `[0, Animation.endTime]`.
@@ -160,6 +172,7 @@ class AnimationClip {
 
   void _bindToTarget(Node target) {
     _bindings.clear();
+    _rebound = true;
     for (final channel in _animation.channels) {
       final nodeName = channel.bindTarget.nodeName;
       // A channel may target the bind root itself or one of its
@@ -220,4 +233,25 @@ class AnimationClip {
       );
     }
   }
+
+  // The pose buffer form of [applyToBindings].
+  void _blendInto(_PoseBuffer pose, double weightMultiplier) {
+    final weight = _weight * weightMultiplier;
+    for (var i = 0; i < _bindings.length; i++) {
+      final binding = _bindings[i];
+      if (binding.slot < 0) continue;
+      final resolver = binding.channel.resolver;
+      if (resolver is TimelineResolver) {
+        resolver._blend(
+          pose,
+          binding.slot,
+          binding.key,
+          _playbackTime,
+          weight,
+        );
+      } else {
+        pose.applyResolver(resolver, binding.slot, _playbackTime, weight);
+      }
+    }
+  }
 }
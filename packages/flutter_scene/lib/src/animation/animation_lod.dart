@@ -0,0 +1,109 @@
+part of '../animation.dart';
+
+/// One step of an [AnimationLodPolicy]: while a character's projected size
+/// is at least [screenSize], its clips are evaluated every [interval]th
+/// frame.
+/// {@category Animation}
+class AnimationLodLevel {
+  /// A level evaluating every [interval]th frame down to a [screenSize]
+  /// fraction of the viewport height.
+  const AnimationLodLevel({required this.screenSize, required this.interval})
+    : assert(interval >= 1);
+
+  /// The smallest projected size (fraction of viewport height, as
+  /// [lodScreenSize] measures it) at which this level is used.
+  final double screenSize;
+
+  /// Frames between evaluations; `1` evaluates every frame.
+  final int interval;
+}
+
+/// How often an [AnimationPlayer] evaluates its clips, by how large the
+/// character it animates appears on screen.
+///
+/// The character is measured as a sphere of [radius] around the player's
+/// node, against the cameras the previous frame rendered from. Between
+/// evaluations the player eases the nodes from the pose before last toward
+/// the last one, so reduced rates stay smooth at the cost of trailing by
+/// one interval. Off screen in every view, the player stops evaluating
+/// altogether when [freezeOffscreen] is set, but its clips keep advancing,
+/// so the character is where it should be when it comes back into view.
+/// A character outside every camera but inside a shadow map's light
+/// frustum may still cast a visible shadow, so it is not frozen; it
+/// evaluates at the last level's interval instead.
+///
+/// Set one with [AnimationPlayer.lodPolicy].
+/// {@category Animation}
+class AnimationLodPolicy {
+  /// Creates a policy for a character fitting in a sphere of [radius]
+  /// around its node. [levels] are ordered largest
+  /// [AnimationLodLevel.screenSize] first; sizes below the last level use
+  /// its interval.
+  const AnimationLodPolicy({
+    required this.radius,
+    this.levels = const [
+      AnimationLodLevel(screenSize: 0.15, interval: 1),
+      AnimationLodLevel(screenSize: 0.05, interval: 2),
+      AnimationLodLevel(screenSize: 0.02, interval: 4),
+      AnimationLodLevel(screenSize: 0, interval: 8),
+    ],
+    this.freezeOffscreen = true,
+  });
+
+  /// The radius of the sphere, centered on the player's node, that bounds
+  /// the character in world units.
+  final double radius;
+
+  /// The evaluation rates by projected size, largest size first.
+  final List<AnimationLodLevel> levels;
+
+  /// Whether a character outside every view, shadow maps included, stops
+  /// evaluating.
+  final bool freezeOffscreen;
+
+  /// Frames between evaluations at [screenSize], or `0` to freeze. A
+  /// [screenSize] of `0` means off screen.
+  int intervalFor(double screenSize) {
+    if (screenSize <= 0 && freezeOffscreen) return 0;
+    for (final level in levels) {
+      if (screenSize >= level.screenSize) return level.interval;
+    }
+    return levels.isEmpty ? 1 : levels.last.interval;
+  }
+
+  /// The largest size a sphere of [radius] at [center] projects to across
+  /// the camera [views], `0` when it is outside all of them, or
+  /// [double.infinity] when there are no views yet or one is not a
+  /// perspective view. A sphere seen only by shadow views measures the
+  /// smallest positive size.
+  double measure(Vector3 center, List<LodView> views) {
+    if (views.isEmpty) return double.infinity;
+    final sphere = _measured;
+    sphere.center.setFrom(center);
+    sphere.radius = radius;
+    var largest = 0.0;
+    for (final view in views) {
+      if (!view.frustum.intersectsWithSphere(sphere)) continue;
+      if (view.shadow) {
+        largest = max(largest, double.minPositive);
+        continue;
+      }
+      final fovRadiansY = view.fovRadiansY;
+      if (fovRadiansY == null) return double.infinity;
+      largest = max(
+        largest,
+        lodScreenSize(
+          center: center,
+          radius: radius,
+          cameraPosition: view.position,
+          fovRadiansY: fovRadiansY,
+        ),
+      );
+    }
+    return largest;
+  }
+}
+
+// Scratch for [AnimationLodPolicy.measure], which runs for every player
+// every frame.
+final Sphere _measured = Sphere();
@@ -16,6 +16,29 @@ class AnimationPlayer {
   final Map<Node, AnimationTransforms> _targetTransforms = {};
   final Map<String, AnimationClip> _clips = {};
 
+  // The compiled form [update] blends through: the pose buffer laid out
+  // over [_targetTransforms] and the clips in [_clips] order. Rebuilt when
+  // clips are added, removed, or rebound.
+  _PoseBuffer? _pose;
+  final List<AnimationClip> _clipOrder = [];
+
+  /// Evaluates clips less often for characters small on screen or off
+  /// it; null (the default) evaluates every frame.
+  ///
+  /// The scene measures the player's node against the previous frame's
+  /// cameras and passes the result to [update].
+  AnimationLodPolicy? lodPolicy;
+
+  /// The clip evaluations the last [update] skipped under [lodPolicy]:
+  /// every registered clip on a skipped frame, otherwise `0`.
+  int get skippedEvaluations => _skippedEvaluations;
+  int _skippedEvaluations = 0;
+
+  // Frames since the last evaluation at a reduced rate, and whether the
+  // pose buffer holds the two evaluations those frames ease between.
+  int _framesSinceEvaluation = 0;
+  bool _easing = false;
+
   /// Instantiates [animation] as an [AnimationClip] bound to [bindTarget]
   /// and registers it with this player.
   ///
@@ -38,6 +61,7 @@ class AnimationPlayer {
     }
 
     _clips[animation.name] = clip;
+    _pose = null;
     return clip;
   }
 
@@ -66,6 +90,7 @@ class AnimationPlayer {
   /// them). No-op when [clip] is not registered.
   void removeClip(AnimationClip clip) {
     _clips.removeWhere((_, registered) => identical(registered, clip));
+    _pose = null;
   }
 
   /// Returns the registered clip whose [Animation.name] equals [name],
@@ -95,6 +120,7 @@ class AnimationPlayer {
         _recordChannelKind(transforms, binding);
       }
     }
+    _pose = null;
   }
 
   /// Prefers the node's authored decomposition over decomposing the
@@ -105,6 +131,22 @@ class AnimationPlayer {
         DecomposedTransform.fromMatrix(node.localTransform);
   }
 
+  // Lays out the pose buffer over the bound nodes and points every
+  // binding at its slot.
+  _PoseBuffer _compile() {
+    final pose = _PoseBuffer(_targetTransforms);
+    _clipOrder
+      ..clear()
+      ..addAll(_clips.values);
+    for (final clip in _clipOrder) {
+      for (final binding in clip._bindings) {
+        binding.slot = pose.slotOf(binding.node);
+      }
+      clip._rebound = false;
+    }
+    return pose;
+  }
+
   /// Advances all registered clips by [deltaSeconds] and applies their
   /// blended result to the bound nodes.
   ///
@@ -112,42 +154,77 @@ class AnimationPlayer {
   /// the delta, normalizes weights when their sum exceeds `1`, and then
   /// writes the resulting `(translation, rotation, scale)` decomposition
   /// back to [Node.localTransform].
-  void update(double deltaSeconds) {
-    // Reset the animated pose state.
-    for (final transforms in _targetTransforms.values) {
-      transforms.animatedPose = transforms.bindPose.clone();
-      final bindWeights = transforms.bindMorphWeights;
-      if (bindWeights != null) {
-        transforms.animatedMorphWeights!.setAll(0, bindWeights);
+  ///
+  /// The blend runs over a flat pose buffer, with keyframes sampled from
+  /// each channel's cached cursor, and the nodes are written in one pass
+  /// at the end; once playing, a frame allocates nothing.
+  ///
+  /// [screenSize] is the character's projected size for [lodPolicy] (`0`
+  /// when off screen); without a policy it is ignored. A frame the policy
+  /// skips only advances the clips, and either eases the nodes between
+  /// the last two evaluations or, off screen, leaves them untouched.
+  void update(double deltaSeconds, {double screenSize = double.infinity}) {
+    var pose = _pose;
+    if (pose == null || _anyClipRebound()) {
+      pose = _pose = _compile();
+      _easing = false;
+    }
+    final clips = _clipOrder;
+    final interval = lodPolicy?.intervalFor(screenSize) ?? 1;
+    _skippedEvaluations = 0;
+    if (interval == 0 ||
+        (interval > 1 && _easing && _framesSinceEvaluation + 1 < interval)) {
+      for (var i = 0; i < clips.length; i++) {
+        clips[i].advance(deltaSeconds);
+      }
+      _skippedEvaluations = clips.length;
+      if (interval == 0) {
+        // Frozen: evaluate afresh once back in view.
+        _easing = false;
+      } else {
+        _framesSinceEvaluation++;
+        pose.writeEased(_framesSinceEvaluation / interval);
       }
+      return;
     }
 
+    // Reset the animated pose state.
+    pose.reset();
+
     // Compute a weight multiplier for normalizing the animation.
     double totalWeight = 0.0;
-    for (final clip in _clips.values) {
-      totalWeight += clip.weight;
+    for (var i = 0; i < clips.length; i++) {
+      totalWeight += clips[i].weight;
     }
     double weightMultiplier = totalWeight > 1.0 ? 1.0 / totalWeight : 1.0;
 
     // Update and apply all clips to the animation pose state.
-    for (final clip in _clips.values) {
+    for (var i = 0; i < clips.length; i++) {
+      final clip = clips[i];
       clip.advance(deltaSeconds);
-      clip.applyToBindings(_targetTransforms, weightMultiplier);
+      clip._blendInto(pose, weightMultiplier);
     }
 
-    // Apply the animated pose to the bound joints, keeping the
-    // decomposition so a later rebind anchors to consistent scale signs.
-    // Nodes bound only by weights channels keep their manual transform.
-    for (final entry in _targetTransforms.entries) {
-      final node = entry.key;
-      final transforms = entry.value;
-      if (transforms.drivesTransform) {
-        node.setLocalTransformTrs(transforms.animatedPose);
-      }
-      final animatedWeights = transforms.animatedMorphWeights;
-      if (animatedWeights != null && node.internalMorphWeights != null) {
-        node.setMorphWeights(animatedWeights);
-      }
+    // Apply the animated pose to the bound nodes. At a reduced rate the
+    // nodes trail by one evaluation, easing toward this one until the
+    // next.
+    if (interval > 1) {
+      pose.keepEvaluation(continuing: _easing);
+      _easing = true;
+      _framesSinceEvaluation = 0;
+      pose.writeEased(0);
+    } else {
+      _easing = false;
+      pose.writeBack();
+    }
+  }
+
+  // Whether a clip was rebound behind the player's back (through
+  // [AnimationClip.rebind]) since the pose buffer was laid out.
+  bool _anyClipRebound() {
+    for (var i = 0; i < _clipOrder.length; i++) {
+      if (_clipOrder[i]._rebound) return true;
     }
+    return false;
   }
 }
@@ -48,16 +48,17 @@ class DecomposedTransform {
 /// Per-node animation state held by an [AnimationPlayer].
 ///
 /// Pairs the node's static [bindPose] (its rest transform) with a
-/// scratch [animatedPose] that the player resets each frame and that
-/// active [AnimationClip]s additively blend into.
+/// scratch [animatedPose] that [PropertyResolver.apply] blends into.
 class AnimationTransforms {
   /// The node's rest-pose transform, captured when the node is first
   /// registered with an [AnimationPlayer].
   DecomposedTransform bindPose;
 
-  /// Scratch transform mutated by clips during [AnimationPlayer.update].
+  /// Scratch transform mutated by [PropertyResolver.apply].
   ///
-  /// Reset to a copy of [bindPose] at the start of each frame.
+  /// The player blends timeline channels in its own pose buffer; it loads
+  /// the node's blend in progress here only around a custom resolver's
+  /// [PropertyResolver.apply], and reads the result back.
   DecomposedTransform animatedPose = DecomposedTransform(
     translation: Vector3.zero(),
     rotation: Quaternion.identity(),
@@ -0,0 +1,108 @@
+part of '../animation.dart';
+
+/// Resolves a translation, rotation, or scale timeline stored as
+/// [CompressedKeyframes], decoding just the two keys around the sampled
+/// time.
+///
+/// Blends by the same rules as the uncompressed resolvers for its
+/// [property]. Importers create these when asked to compress animations
+/// (see `animation_compression.dart`).
+class CompressedTimelineResolver extends TimelineResolver {
+  CompressedTimelineResolver._(
+    List<double> times,
+    this.property,
+    this.keyframes,
+  ) : assert(property != AnimationProperty.weights),
+      assert(
+        (property == AnimationProperty.rotation) ==
+            (keyframes.kind == CompressedKeyframesKind.rotation),
+      ),
+      assert(times.length == keyframes.count),
+      super._(times);
+
+  /// The property the keys drive.
+  final AnimationProperty property;
+
+  /// The quantized keys. Read by the scene serializer.
+  final CompressedKeyframes keyframes;
+
+  // Decoded keys, reused across samples.
+  final Float64List _a = Float64List(4);
+  final Float64List _b = Float64List(4);
+
+  // Decodes the value at [key] into [_b].
+  void _sample(_TimelineKey key, Float64List rotationScratch) {
+    final rotation = keyframes.kind == CompressedKeyframesKind.rotation;
+    final lerp = key.lerp;
+    if (rotation) {
+      keyframes.readRotation(key.index, _b);
+      if (lerp < 1) {
+        keyframes.readRotation(key.index - 1, _a);
+        _PoseBuffer.slerp(
+          _a[0],
+          _a[1],
+          _a[2],
+          _a[3],
+          _b[0],
+          _b[1],
+          _b[2],
+          _b[3],
+          lerp,
+          rotationScratch,
+        );
+        _b.setAll(0, rotationScratch);
+      }
+      return;
+    }
+    keyframes.readVector3(key.index, _b);
+    if (lerp < 1) {
+      keyframes.readVector3(key.index - 1, _a);
+      for (var c = 0; c < 3; c++) {
+        _b[c] = _a[c] + (_b[c] - _a[c]) * lerp;
+      }
+    }
+  }
+
+  @override
+  void apply(AnimationTransforms target, double timeInSeconds, double weight) {
+    if (keyframes.count == 0) {
+      return;
+    }
+    _sample(_getTimelineKey(timeInSeconds), Float64List(4));
+    switch (property) {
+      case AnimationProperty.translation:
+        _applyTranslation(target, Vector3(_b[0], _b[1], _b[2]), weight);
+      case AnimationProperty.rotation:
+        _applyRotation(target, Quaternion(_b[0], _b[1], _b[2], _b[3]), weight);
+      case AnimationProperty.scale:
+        _applyScale(target, Vector3(_b[0], _b[1], _b[2]), weight);
+      case AnimationProperty.weights:
+        break;
+    }
+  }
+
+  @override
+  void _blend(
+    _PoseBuffer pose,
+    int slot,
+    _TimelineKey key,
+    double time,
+    double weight,
+  ) {
+    if (keyframes.count == 0) {
+      return;
+    }
+    _sample(_seek(time, key), pose.quaternion);
+    switch (property) {
+      case AnimationProperty.translation:
+        pose.blendTranslation(slot, _b[0], _b[1], _b[2], weight);
+      case AnimationProperty.rotation:
+        final q = pose.quaternion..setAll(0, _b);
+        pose.blendRotation(slot, q, weight);
+      case AnimationProperty.scale:
+        pose.blendScale(slot, _b[0], _b[1], _b[2], weight);
+      case AnimationProperty.weights:
+        break;
+    }
+  }
+}
@@ -0,0 +1,261 @@
+part of '../animation.dart';
+
+/// The pose an [AnimationPlayer] blends, one slot per bound node, stored
+/// as flat floats rather than per-node transform objects.
+///
+/// [bind] holds each slot's rest pose and [pose] the running blend: a
+/// frame copies [bind] over [pose], every clip's channels blend into it in
+/// place, and [writeBack] hands the result to the nodes through transforms
+/// and matrices the buffer owns, so a steady frame allocates nothing.
+class _PoseBuffer {
+  _PoseBuffer(Map<Node, AnimationTransforms> targets)
+    : nodes = targets.keys.toList(growable: false),
+      transforms = targets.values.toList(growable: false),
+      pose = Float32List(targets.length * stride),
+      bind = Float32List(targets.length * stride) {
+    for (var slot = 0; slot < nodes.length; slot++) {
+      _slots[nodes[slot]] = slot;
+      final rest = transforms[slot].bindPose;
+      final o = slot * stride;
+      bind.setRange(o + translation, o + rotation, rest.translation.storage);
+      bind.setRange(o + rotation, o + scale, rest.rotation.storage);
+      bind.setRange(o + scale, o + stride, rest.scale.storage);
+      _outputs.add(rest.clone());
+      _matrices.add(Matrix4.identity());
+    }
+  }
+
+  /// Floats per slot: translation, rotation (x, y, z, w), then scale.
+  static const int stride = 10;
+  static const int translation = 0;
+  static const int rotation = 3;
+  static const int scale = 7;
+
+  /// The node in each slot.
+  final List<Node> nodes;
+
+  /// Each slot's bind pose and morph weight state.
+  final List<AnimationTransforms> transforms;
+
+  /// The blend in progress.
+  final Float32List pose;
+
+  /// The rest pose [reset] starts each frame from.
+  final Float32List bind;
+
+  /// Scratch for rotation blends.
+  final Float64List quaternion = Float64List(4);
+
+  final Map<Node, int> _slots = {};
+  final List<DecomposedTransform> _outputs = [];
+  final List<Matrix4> _matrices = [];
+
+  // The two latest evaluations a reduced-rate player eases between,
+  // allocated on first use.
+  Float32List? _from;
+  Float32List? _to;
+
+  /// The slot [node] blends into, or -1 when the player does not drive it.
+  int slotOf(Node node) => _slots[node] ?? -1;
+
+  /// Returns every slot to its rest pose and rest morph weights.
+  void reset() {
+    pose.setAll(0, bind);
+    for (var slot = 0; slot < transforms.length; slot++) {
+      final target = transforms[slot];
+      final bindWeights = target.bindMorphWeights;
+      if (bindWeights != null) {
+        target.animatedMorphWeights!.setAll(0, bindWeights);
+      }
+    }
+  }
+
+  /// Blends translation ([x], [y], [z]) into [slot] as an offset from the
+  /// bind pose.
+  void blendTranslation(int slot, double x, double y, double z, double weight) {
+    final t = slot * stride + translation;
+    pose[t] += (x - bind[t]) * weight;
+    pose[t + 1] += (y - bind[t + 1]) * weight;
+    pose[t + 2] += (z - bind[t + 2]) * weight;
+  }
+
+  /// Slerps [slot]'s rotation toward [q] (x, y, z, w) by [weight]; [q] is
+  /// used as scratch.
+  void blendRotation(int slot, Float64List q, double weight) {
+    final r = slot * stride + rotation;
+    slerp(
+      pose[r],
+      pose[r + 1],
+      pose[r + 2],
+      pose[r + 3],
+      q[0],
+      q[1],
+      q[2],
+      q[3],
+      weight,
+      q,
+    );
+    pose[r] = q[0];
+    pose[r + 1] = q[1];
+    pose[r + 2] = q[2];
+    pose[r + 3] = q[3];
+  }
+
+  /// Scales [slot] by the weighted ratio of ([x], [y], [z]) to the bind
+  /// scale, so a weight of `1` reaches it exactly.
+  void blendScale(int slot, double x, double y, double z, double weight) {
+    final s = slot * stride + scale;
+    pose[s] *= 1 + (x / bind[s] - 1) * weight;
+    pose[s + 1] *= 1 + (y / bind[s + 1] - 1) * weight;
+    pose[s + 2] *= 1 + (z / bind[s + 2] - 1) * weight;
+  }
+
+  /// Applies a resolver that only knows [PropertyResolver.apply]: loads
+  /// [slot]'s blend into its [AnimationTransforms.animatedPose], applies,
+  /// and reads the result back.
+  void applyResolver(
+    PropertyResolver resolver,
+    int slot,
+    double time,
+    double weight,
+  ) {
+    final target = transforms[slot];
+    final animated = target.animatedPose;
+    final o = slot * stride;
+    animated.translation.setValues(pose[o], pose[o + 1], pose[o + 2]);
+    animated.rotation.setValues(
+      pose[o + 3],
+      pose[o + 4],
+      pose[o + 5],
+      pose[o + 6],
+    );
+    animated.scale.setValues(pose[o + 7], pose[o + 8], pose[o + 9]);
+    resolver.apply(target, time, weight);
+    pose.setRange(o + translation, o + rotation, animated.translation.storage);
+    pose.setRange(o + rotation, o + scale, animated.rotation.storage);
+    pose.setRange(o + scale, o + stride, animated.scale.storage);
+  }
+
+  /// Keeps the pose just blended as the evaluation [writeEased] eases
+  /// toward, and the one before it (or, unless [continuing], the same
+  /// pose) as where it eases from.
+  void keepEvaluation({required bool continuing}) {
+    final from = _from ??= Float32List(pose.length);
+    final to = _to ??= Float32List(pose.length);
+    from.setAll(0, continuing ? to : pose);
+    to.setAll(0, pose);
+  }
+
+  /// Writes the pose [t] of the way from the evaluation before last to the
+  /// last one kept by [keepEvaluation] to the nodes. Morph weights are
+  /// written as last evaluated.
+  void writeEased(double t) {
+    final from = _from!;
+    final to = _to!;
+    for (var o = 0; o < pose.length; o += stride) {
+      for (var c = translation; c < rotation; c++) {
+        pose[o + c] = from[o + c] + (to[o + c] - from[o + c]) * t;
+      }
+      for (var c = scale; c < stride; c++) {
+        pose[o + c] = from[o + c] + (to[o + c] - from[o + c]) * t;
+      }
+      final r = o + rotation;
+      slerp(
+        from[r],
+        from[r + 1],
+        from[r + 2],
+        from[r + 3],
+        to[r],
+        to[r + 1],
+        to[r + 2],
+        to[r + 3],
+        t,
+        quaternion,
+      );
+      pose.setAll(r, quaternion);
+    }
+    writeBack();
+  }
+
+  /// Writes the blended pose to the nodes. Nodes bound only by weights
+  /// channels keep their manual transform.
+  void writeBack() {
+    for (var slot = 0; slot < nodes.length; slot++) {
+      final node = nodes[slot];
+      final target = transforms[slot];
+      if (target.drivesTransform) {
+        final out = _outputs[slot];
+        final o = slot * stride;
+        out.translation.setValues(pose[o], pose[o + 1], pose[o + 2]);
+        out.rotation.setValues(
+          pose[o + 3],
+          pose[o + 4],
+          pose[o + 5],
+          pose[o + 6],
+        );
+        out.scale.setValues(pose[o + 7], pose[o + 8], pose[o + 9]);
+        final matrix = _matrices[slot];
+        matrix.setFromTranslationRotationScale(
+          out.translation,
+          out.rotation,
+          out.scale,
+        );
+        // Keep the decomposition so a later rebind anchors to consistent
+        // scale signs.
+        node.adoptLocalTransformTrs(out, matrix);
+      }
+      final animatedWeights = target.animatedMorphWeights;
+      if (animatedWeights != null && node.internalMorphWeights != null) {
+        node.setMorphWeights(animatedWeights);
+      }
+    }
+  }
+
+  /// Writes the slerp from quaternion `a` toward `b` by [weight] into
+  /// [out], by the same rule as [QuaternionSlerp.slerp].
+  static void slerp(
+    double ax,
+    double ay,
+    double az,
+    double aw,
+    double bx,
+    double by,
+    double bz,
+    double bw,
+    double weight,
+    Float64List out,
+  ) {
+    var cosine = ax * bx + ay * by + az * bz + aw * bw;
+    // q and -q are the same rotation; pick the nearer one to take the
+    // short arc.
+    var sign = 1.0;
+    if (cosine < 0.0) {
+      sign = -1.0;
+      cosine = -cosine;
+    }
+    if (cosine < 1.0 - 1e-3) {
+      final sine = sqrt(1.0 - cosine * cosine);
+      final angle = atan2(sine, cosine);
+      final sineInverse = 1.0 / sine;
+      final c0 = sin((1.0 - weight) * angle) * sineInverse;
+      final c1 = sin(weight * angle) * sineInverse * sign;
+      out[0] = ax * c0 + bx * c1;
+      out[1] = ay * c0 + by * c1;
+      out[2] = az * c0 + bz * c1;
+      out[3] = aw * c0 + bw * c1;
+      return;
+    }
+    final c0 = 1.0 - weight;
+    final c1 = weight * sign;
+    final x = ax * c0 + bx * c1;
+    final y = ay * c0 + by * c1;
+    final z = az * c0 + bz * c1;
+    final w = aw * c0 + bw * c1;
+    final length = sqrt(x * x + y * y + z * z + w * w);
+    final inverse = length == 0.0 ? 1.0 : 1.0 / length;
+    out[0] = x * inverse;
+    out[1] = y * inverse;
+    out[2] = z * inverse;
+    out[3] = w * inverse;
+  }
+}
@@ -67,6 +67,20 @@ abstract class PropertyResolver {
   }) {
     return MorphWeightsTimelineResolver._(times, values, targetCount);
   }
+
+  /// Creates a translation, rotation, or scale resolver that samples the
+  /// quantized [keyframes] in place, blending like the matching
+  /// uncompressed timeline.
+  ///
+  /// [keyframes] must hold rotations exactly when [property] is
+  /// [AnimationProperty.rotation], one key per entry of [times].
+  static PropertyResolver makeCompressedTimeline(
+    AnimationProperty property,
+    List<double> times,
+    CompressedKeyframes keyframes,
+  ) {
+    return CompressedTimelineResolver._(times, property, keyframes);
+  }
 }
 
 class _TimelineKey {
@@ -83,12 +97,14 @@ class _TimelineKey {
 /// Shared keyframe lookup for the per-property timeline resolvers.
 ///
 /// Implementations supply the value-array storage and per-frame
-/// interpolation; this base class handles binary-style search through
-/// the time axis to compute a `(index, lerp)` pair.
+/// interpolation; this base class handles the search through the time
+/// axis to compute an `(index, lerp)` pair. Keyframes are stored flat
+/// (times in a [Float64List], values in a [Float32List]) so sampling reads
+/// them without touching per-key objects.
 abstract class TimelineResolver implements PropertyResolver {
-  final List<double> _times;
+  final Float64List _times;
 
-  TimelineResolver._(this._times);
+  TimelineResolver._(List<double> times) : _times = Float64List.fromList(times);
 
   /// The keyframe times, in seconds. Read by the scene serializer.
   List<double> get times => List.unmodifiable(_times);
@@ -99,34 +115,82 @@ abstract class TimelineResolver implements PropertyResolver {
   }
 
   _TimelineKey _getTimelineKey(double time) {
-    if (_times.length <= 1 || time <= _times.first) {
-      return _TimelineKey(0, 1);
+    return _seek(time, _TimelineKey(0, 1));
+  }
+
+  /// Moves [key] to the keyframe pair around [time] and returns it.
+  ///
+  /// [key]'s current index is the search's starting cursor: playback that
+  /// moves forward a little each frame finds its pair in a step or two,
+  /// and only a seek backwards (or a loop wrap) falls back to a binary
+  /// search.
+  _TimelineKey _seek(double time, _TimelineKey key) {
+    final times = _times;
+    final last = times.length - 1;
+    if (last <= 0 || time <= times[0]) {
+      return key
+        ..index = 0
+        ..lerp = 1;
     }
-    if (time >= _times.last) {
-      return _TimelineKey(_times.length - 1, 1);
+    if (time >= times[last]) {
+      return key
+        ..index = last
+        ..lerp = 1;
     }
-    int nextTimeIndex = _times.indexWhere((t) => t >= time);
-
-    double previousTime = _times[nextTimeIndex - 1];
-    double nextTime = _times[nextTimeIndex];
-
-    double lerp = (time - previousTime) / (nextTime - previousTime);
-    return _TimelineKey(nextTimeIndex, lerp);
+    // The first keyframe at or after time; times[0] < time < times[last],
+    // so it lies in [1, last].
+    var next = key.index;
+    if (next < 1 || next > last || times[next - 1] >= time) {
+      var low = 1;
+      var high = last;
+      while (low < high) {
+        final mid = (low + high) >> 1;
+        if (times[mid] < time) {
+          low = mid + 1;
+        } else {
+          high = mid;
+        }
+      }
+      next = low;
+    } else {
+      while (times[next] < time) {
+        next++;
+      }
+    }
+    final previousTime = times[next - 1];
+    return key
+      ..index = next
+      ..lerp = (time - previousTime) / (times[next] - previousTime);
   }
+
+  /// Samples this timeline at [time] (seeking from [key]) and blends the
+  /// result into [pose]'s [slot] with [weight], by the same rule [apply]
+  /// uses.
+  void _blend(
+    _PoseBuffer pose,
+    int slot,
+    _TimelineKey key,
+    double time,
+    double weight,
+  );
 }
 
 /// Resolves a translation timeline with per-component linear
 /// interpolation, blended into [AnimationTransforms.animatedPose] as an
 /// offset from the bind pose.
 class TranslationTimelineResolver extends TimelineResolver {
-  final List<Vector3> _values;
+  final Float32List _values;
 
   /// The keyframe values. Read by the scene serializer.
-  List<Vector3> get values => List.unmodifiable(_values);
-
-  TranslationTimelineResolver._(List<double> times, this._values)
-    : super._(times) {
-    assert(times.length == _values.length);
+  List<Vector3> get values => List.unmodifiable([
+    for (var i = 0; i < _values.length; i += 3)
+      Vector3(_values[i], _values[i + 1], _values[i + 2]),
+  ]);
+
+  TranslationTimelineResolver._(List<double> times, List<Vector3> values)
+    : _values = _flattenVector3s(values),
+      super._(times) {
+    assert(times.length == values.length);
   }
 
   @override
@@ -136,13 +200,43 @@ class TranslationTimelineResolver extends TimelineResolver {
     }
 
     _TimelineKey key = _getTimelineKey(timeInSeconds);
-    Vector3 value = _values[key.index];
+    final o = key.index * 3;
+    Vector3 value = Vector3(_values[o], _values[o + 1], _values[o + 2]);
     if (key.lerp < 1) {
-      value = _values[key.index - 1].lerp(value, key.lerp);
+      value = Vector3(
+        _values[o - 3],
+        _values[o - 2],
+        _values[o - 1],
+      ).lerp(value, key.lerp);
     }
 
-    target.animatedPose.translation +=
-        (value - target.bindPose.translation) * weight;
+    _applyTranslation(target, value, weight);
+  }
+
+  @override
+  void _blend(
+    _PoseBuffer pose,
+    int slot,
+    _TimelineKey key,
+    double time,
+    double weight,
+  ) {
+    if (_values.isEmpty) {
+      return;
+    }
+    _seek(time, key);
+    final values = _values;
+    final o = key.index * 3;
+    var x = values[o];
+    var y = values[o + 1];
+    var z = values[o + 2];
+    final lerp = key.lerp;
+    if (lerp < 1) {
+      x = values[o - 3] + (x - values[o - 3]) * lerp;
+      y = values[o - 2] + (y - values[o - 2]) * lerp;
+      z = values[o - 1] + (z - values[o - 1]) * lerp;
+    }
+    pose.blendTranslation(slot, x, y, z, weight);
   }
 }
 
@@ -150,14 +244,31 @@ class TranslationTimelineResolver extends TimelineResolver {
 /// slerping the current animated rotation toward the keyframed rotation
 /// by the supplied weight.
 class RotationTimelineResolver extends TimelineResolver {
-  final List<Quaternion> _values;
+  final Float32List _values;
 
   /// The keyframe values. Read by the scene serializer.
-  List<Quaternion> get values => List.unmodifiable(_values);
+  List<Quaternion> get values => List.unmodifiable([
+    for (var i = 0; i < _values.length; i += 4)
+      Quaternion(_values[i], _values[i + 1], _values[i + 2], _values[i + 3]),
+  ]);
+
+  RotationTimelineResolver._(List<double> times, List<Quaternion> values)
+    : _values = Float32List(values.length * 4),
+      super._(times) {
+    assert(times.length == values.length);
+    for (var i = 0; i < values.length; i++) {
+      _values.setRange(i * 4, i * 4 + 4, values[i].storage);
+    }
+  }
 
-  RotationTimelineResolver._(List<double> times, this._values)
-    : super._(times) {
-    assert(times.length == _values.length);
+  Quaternion _keyframe(int index) {
+    final o = index * 4;
+    return Quaternion(
+      _values[o],
+      _values[o + 1],
+      _values[o + 2],
+      _values[o + 3],
+    );
   }
 
   @override
@@ -167,15 +278,49 @@ class RotationTimelineResolver extends TimelineResolver {
     }
 
     _TimelineKey key = _getTimelineKey(timeInSeconds);
-    Quaternion value = _values[key.index];
+    Quaternion value = _keyframe(key.index);
     if (key.lerp < 1) {
-      value = _values[key.index - 1].slerp(value, key.lerp);
+      value = _keyframe(key.index - 1).slerp(value, key.lerp);
     }
 
-    target.animatedPose.rotation = target.animatedPose.rotation.slerp(
-      value,
-      weight,
-    );
+    _applyRotation(target, value, weight);
+  }
+
+  @override
+  void _blend(
+    _PoseBuffer pose,
+    int slot,
+    _TimelineKey key,
+    double time,
+    double weight,
+  ) {
+    if (_values.isEmpty) {
+      return;
+    }
+    _seek(time, key);
+    final values = _values;
+    final o = key.index * 4;
+    final q = pose.quaternion;
+    if (key.lerp < 1) {
+      _PoseBuffer.slerp(
+        values[o - 4],
+        values[o - 3],
+        values[o - 2],
+        values[o - 1],
+        values[o],
+        values[o + 1],
+        values[o + 2],
+        values[o + 3],
+        key.lerp,
+        q,
+      );
+    } else {
+      q[0] = values[o];
+      q[1] = values[o + 1];
+      q[2] = values[o + 2];
+      q[3] = values[o + 3];
+    }
+    pose.blendRotation(slot, q, weight);
   }
 }
 
@@ -185,13 +330,18 @@ class RotationTimelineResolver extends TimelineResolver {
 /// blends behave multiplicatively (a weight of `1` reaches the keyframe
 /// scale exactly).
 class ScaleTimelineResolver extends TimelineResolver {
-  final List<Vector3> _values;
+  final Float32List _values;
 
   /// The keyframe values. Read by the scene serializer.
-  List<Vector3> get values => List.unmodifiable(_values);
-
-  ScaleTimelineResolver._(List<double> times, this._values) : super._(times) {
-    assert(times.length == _values.length);
+  List<Vector3> get values => List.unmodifiable([
+    for (var i = 0; i < _values.length; i += 3)
+      Vector3(_values[i], _values[i + 1], _values[i + 2]),
+  ]);
+
+  ScaleTimelineResolver._(List<double> times, List<Vector3> values)
+    : _values = _flattenVector3s(values),
+      super._(times) {
+    assert(times.length == values.length);
   }
 
   @override
@@ -201,22 +351,43 @@ class ScaleTimelineResolver extends TimelineResolver {
     }
 
     _TimelineKey key = _getTimelineKey(timeInSeconds);
-    Vector3 value = _values[key.index];
+    final o = key.index * 3;
+    Vector3 value = Vector3(_values[o], _values[o + 1], _values[o + 2]);
     if (key.lerp < 1) {
-      value = _values[key.index - 1].lerp(value, key.lerp);
+      value = Vector3(
+        _values[o - 3],
+        _values[o - 2],
+        _values[o - 1],
+      ).lerp(value, key.lerp);
     }
 
-    Vector3 scale = Vector3(
-      1,
-      1,
-      1,
-    ).lerp(value.divided(target.bindPose.scale), weight);
+    _applyScale(target, value, weight);
+  }
 
-    target.animatedPose.scale = Vector3(
-      target.animatedPose.scale.x * scale.x,
-      target.animatedPose.scale.y * scale.y,
-      target.animatedPose.scale.z * scale.z,
-    );
+  @override
+  void _blend(
+    _PoseBuffer pose,
+    int slot,
+    _TimelineKey key,
+    double time,
+    double weight,
+  ) {
+    if (_values.isEmpty) {
+      return;
+    }
+    _seek(time, key);
+    final values = _values;
+    final o = key.index * 3;
+    var x = values[o];
+    var y = values[o + 1];
+    var z = values[o + 2];
+    final lerp = key.lerp;
+    if (lerp < 1) {
+      x = values[o - 3] + (x - values[o - 3]) * lerp;
+      y = values[o - 2] + (y - values[o - 2]) * lerp;
+      z = values[o - 1] + (z - values[o - 1]) * lerp;
+    }
+    pose.blendScale(slot, x, y, z, weight);
   }
 }
 
@@ -244,6 +415,25 @@ class MorphWeightsTimelineResolver extends TimelineResolver {
 
   @override
   void apply(AnimationTransforms target, double timeInSeconds, double weight) {
+    _blendWeights(target, _getTimelineKey(timeInSeconds), weight);
+  }
+
+  @override
+  void _blend(
+    _PoseBuffer pose,
+    int slot,
+    _TimelineKey key,
+    double time,
+    double weight,
+  ) {
+    _blendWeights(pose.transforms[slot], _seek(time, key), weight);
+  }
+
+  void _blendWeights(
+    AnimationTransforms target,
+    _TimelineKey key,
+    double weight,
+  ) {
     final animated = target.animatedMorphWeights;
     final bind = target.bindMorphWeights;
     if (animated == null || bind == null || targetCount == 0) {
@@ -253,7 +443,6 @@ class MorphWeightsTimelineResolver extends TimelineResolver {
       return;
     }
 
-    _TimelineKey key = _getTimelineKey(timeInSeconds);
     final current = key.index * targetCount;
     final previous = (key.index - 1) * targetCount;
     final count = targetCount < animated.length ? targetCount : animated.length;
@@ -267,3 +456,48 @@ class MorphWeightsTimelineResolver extends TimelineResolver {
     }
   }
 }
+
+// The blend rules [PropertyResolver.apply] follows for each property; the
+// pose buffer's blend* methods are their flat forms.
+
+void _applyTranslation(
+  AnimationTransforms target,
+  Vector3 value,
+  double weight,
+) {
+  target.animatedPose.translation +=
+      (value - target.bindPose.translation) * weight;
+}
+
+void _applyRotation(
+  AnimationTransforms target,
+  Quaternion value,
+  double weight,
+) {
+  target.animatedPose.rotation = target.animatedPose.rotation.slerp(
+    value,
+    weight,
+  );
+}
+
+void _applyScale(AnimationTransforms target, Vector3 value, double weight) {
+  Vector3 scale = Vector3(
+    1,
+    1,
+    1,
+  ).lerp(value.divided(target.bindPose.scale), weight);
+
+  target.animatedPose.scale = Vector3(
+    target.animatedPose.scale.x * scale.x,
+    target.animatedPose.scale.y * scale.y,
+    target.animatedPose.scale.z * scale.z,
+  );
+}
+
+Float32List _flattenVector3s(List<Vector3> values) {
+  final flat = Float32List(values.length * 3);
+  for (var i = 0; i < values.length; i++) {
+    flat.setRange(i * 3, i * 3 + 3, values[i].storage);
+  }
+  return flat;
+}
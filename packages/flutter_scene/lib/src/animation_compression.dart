@@ -0,0 +1,442 @@
+/// Keyframe compression for animation channels.
+///
+/// [compressChannel] drops the keys that interpolating their kept
+/// neighbours reproduces within an error tolerance, then quantizes what
+/// remains into [CompressedKeyframes]: rotations as smallest-three
+/// quaternions (the three smaller components at 15 bits each, the largest
+/// rebuilt from unit length) and translations and scales as 16-bit values
+/// over the channel's range. Both take 6 bytes a key, against 16 and 12 as
+/// floats. The engine samples the compressed form directly (see
+/// `PropertyResolver.makeCompressedTimeline`).
+///
+/// Errors are distances in scene units. A translation error moves the node
+/// by that much; rotation and scale errors are measured at an `errorScale`
+/// distance, the reach of the node's descendants, which is how far the
+/// error swings the end of the chain. The importer spreads its tolerance
+/// over the longest chain through each node, so errors accumulated down a
+/// hierarchy stay within it.
+///
+/// Pure Dart (no `dart:ui`), so the importer runs it in the build hook
+/// isolate.
+library;
+
+import 'dart:math';
+import 'dart:typed_data';
+
+/// The payload `format` of an `.fscene` keyframes chunk holding
+/// [CompressedKeyframes.toBytes] bytes.
+const String kCompressedKeyframesFormat = 'keyframes-q16';
+
+/// What a [CompressedKeyframes] stream stores.
+enum CompressedKeyframesKind {
+  /// Three components a key, range-quantized to 16 bits each.
+  vector3,
+
+  /// Unit quaternions (x, y, z, w), stored smallest-three.
+  rotation,
+}
+
+const int _kVersion = 1;
+const int _kHeaderBytes = 8;
+const int _kWordsPerKey = 3;
+const double _kRotationRange = 0.7071067811865476; // sqrt(1/2)
+const int _kRotationSteps = 0x7fff;
+
+/// A quantized keyframe value stream, 6 bytes a key, decoded one key at a
+/// time.
+class CompressedKeyframes {
+  CompressedKeyframes._(this.kind, this.count, this._ranges, this._words);
+
+  /// Quantizes [values] (three floats a key) to 16 bits per component over
+  /// each component's range.
+  factory CompressedKeyframes.vector3(Float32List values) {
+    final count = values.length ~/ 3;
+    final ranges = Float32List(6);
+    for (var c = 0; c < 3; c++) {
+      var low = double.infinity;
+      var high = double.negativeInfinity;
+      for (var i = 0; i < count; i++) {
+        final v = values[i * 3 + c];
+        low = min(low, v);
+        high = max(high, v);
+      }
+      if (count == 0) low = high = 0.0;
+      ranges[c] = low;
+      ranges[3 + c] = (high - low) / 0xffff;
+    }
+    final words = Uint16List(count * _kWordsPerKey);
+    for (var i = 0; i < count; i++) {
+      for (var c = 0; c < 3; c++) {
+        final step = ranges[3 + c];
+        words[i * 3 + c] = step == 0
+            ? 0
+            : ((values[i * 3 + c] - ranges[c]) / step).round().clamp(0, 0xffff);
+      }
+    }
+    return CompressedKeyframes._(
+      CompressedKeyframesKind.vector3,
+      count,
+      ranges,
+      words,
+    );
+  }
+
+  /// Quantizes [values] (x, y, z, w a key) to smallest-three quaternions.
+  ///
+  /// Each key is normalized and flipped so its largest component is
+  /// positive (the same rotation), which is the component left out.
+  factory CompressedKeyframes.rotation(Float32List values) {
+    final count = values.length ~/ 4;
+    final words = Uint16List(count * _kWordsPerKey);
+    final q = Float64List(4);
+    for (var i = 0; i < count; i++) {
+      var length = 0.0;
+      var largest = 0;
+      for (var c = 0; c < 4; c++) {
+        q[c] = values[i * 4 + c];
+        length += q[c] * q[c];
+        if (q[c].abs() > q[largest].abs()) largest = c;
+      }
+      length = sqrt(length);
+      final scale = (q[largest] < 0 ? -1 : 1) / (length == 0 ? 1 : length);
+      var word = 0;
+      for (var c = 0; c < 4; c++) {
+        if (c == largest) continue;
+        final v = (q[c] * scale).clamp(-_kRotationRange, _kRotationRange);
+        words[i * 3 + word++] =
+            ((v + _kRotationRange) / (2 * _kRotationRange) * _kRotationSteps)
+                .round();
+      }
+      // The dropped component's index rides in the two spare top bits.
+      words[i * 3] |= (largest >> 1) << 15;
+      words[i * 3 + 1] |= (largest & 1) << 15;
+    }
+    return CompressedKeyframes._(
+      CompressedKeyframesKind.rotation,
+      count,
+      Float32List(0),
+      words,
+    );
+  }
+
+  /// Reads the layout [toBytes] writes.
+  ///
+  /// Throws a [FormatException] when [bytes] is not one.
+  factory CompressedKeyframes.fromBytes(Uint8List bytes) {
+    if (bytes.length < _kHeaderBytes) {
+      throw const FormatException('Compressed keyframes header truncated');
+    }
+    final data = ByteData.sublistView(bytes);
+    if (data.getUint8(0) != _kVersion) {
+      throw FormatException(
+        'Unsupported compressed keyframes version ${data.getUint8(0)}',
+      );
+    }
+    final kindIndex = data.getUint8(1);
+    if (kindIndex >= CompressedKeyframesKind.values.length) {
+      throw FormatException('Unknown compressed keyframes kind $kindIndex');
+    }
+    final kind = CompressedKeyframesKind.values[kindIndex];
+    final count = data.getUint32(4, Endian.little);
+    final ranges = Float32List(
+      kind == CompressedKeyframesKind.vector3 ? 6 : 0,
+    );
+    final wordsOffset = _kHeaderBytes + ranges.lengthInBytes;
+    if (bytes.length != wordsOffset + count * _kWordsPerKey * 2) {
+      throw const FormatException('Compressed keyframes length mismatch');
+    }
+    for (var i = 0; i < ranges.length; i++) {
+      ranges[i] = data.getFloat32(_kHeaderBytes + i * 4, Endian.little);
+    }
+    final words = Uint16List(count * _kWordsPerKey);
+    for (var i = 0; i < words.length; i++) {
+      words[i] = data.getUint16(wordsOffset + i * 2, Endian.little);
+    }
+    return CompressedKeyframes._(kind, count, ranges, words);
+  }
+
+  /// What the keys store.
+  final CompressedKeyframesKind kind;
+
+  /// The number of keys.
+  final int count;
+
+  // vector3: the minimum of each component, then its quantization step.
+  final Float32List _ranges;
+  final Uint16List _words;
+
+  /// The encoded size: an 8-byte header, the ranges, and the keys.
+  int get lengthInBytes =>
+      _kHeaderBytes + _ranges.lengthInBytes + _words.lengthInBytes;
+
+  /// Serializes the keys, little-endian: version, kind, two reserved
+  /// bytes, the key count, the ranges (vector3 only), then three 16-bit
+  /// words a key.
+  Uint8List toBytes() {
+    final bytes = Uint8List(lengthInBytes);
+    final data = ByteData.sublistView(bytes)
+      ..setUint8(0, _kVersion)
+      ..setUint8(1, kind.index)
+      ..setUint32(4, count, Endian.little);
+    for (var i = 0; i < _ranges.length; i++) {
+      data.setFloat32(_kHeaderBytes + i * 4, _ranges[i], Endian.little);
+    }
+    final wordsOffset = _kHeaderBytes + _ranges.lengthInBytes;
+    for (var i = 0; i < _words.length; i++) {
+      data.setUint16(wordsOffset + i * 2, _words[i], Endian.little);
+    }
+    return bytes;
+  }
+
+  /// Decodes vector3 key [index] into the first three entries of [out].
+  void readVector3(int index, Float64List out) {
+    final o = index * _kWordsPerKey;
+    final ranges = _ranges;
+    out[0] = ranges[0] + _words[o] * ranges[3];
+    out[1] = ranges[1] + _words[o + 1] * ranges[4];
+    out[2] = ranges[2] + _words[o + 2] * ranges[5];
+  }
+
+  /// Decodes rotation key [index] into [out] as x, y, z, w.
+  void readRotation(int index, Float64List out) {
+    final o = index * _kWordsPerKey;
+    final w0 = _words[o];
+    final w1 = _words[o + 1];
+    final largest = ((w0 >> 15) << 1) | (w1 >> 15);
+    var sum = 0.0;
+    var word = 0;
+    for (var c = 0; c < 4; c++) {
+      if (c == largest) continue;
+      final q = _words[o + word++] & _kRotationSteps;
+      final v = q / _kRotationSteps * (2 * _kRotationRange) - _kRotationRange;
+      out[c] = v;
+      sum += v * v;
+    }
+    out[largest] = sqrt(max(0.0, 1.0 - sum));
+  }
+
+  /// Decodes every key, three or four floats each.
+  Float32List decodeAll() {
+    final components = kind == CompressedKeyframesKind.vector3 ? 3 : 4;
+    final out = Float32List(count * components);
+    final key = Float64List(4);
+    for (var i = 0; i < count; i++) {
+      if (kind == CompressedKeyframesKind.vector3) {
+        readVector3(i, key);
+      } else {
+        readRotation(i, key);
+      }
+      for (var c = 0; c < components; c++) {
+        out[i * components + c] = key[c];
+      }
+    }
+    return out;
+  }
+}
+
+/// One channel compressed by [compressChannel]: the kept key [times], their
+/// quantized [keyframes], and the largest error against the source keys.
+typedef CompressedChannel = ({
+  Float32List times,
+  CompressedKeyframes keyframes,
+  double maxError,
+});
+
+/// Compresses one channel's keys ([values] holds three or four floats a
+/// key, by [kind]) within [tolerance].
+///
+/// Keys are dropped while interpolating (linearly, or by slerp for
+/// rotations) between the kept keys around them stays within [tolerance]
+/// of every dropped key; the first and last keys always stay, so the
+/// channel keeps its length. [errorScale] is the distance a rotation or
+/// scale error is measured at (see the library docs); translations pass 1.
+/// The reported error includes quantization.
+CompressedChannel compressChannel(
+  Float32List times,
+  Float32List values, {
+  required CompressedKeyframesKind kind,
+  required double tolerance,
+  double errorScale = 1.0,
+}) {
+  final rotation = kind == CompressedKeyframesKind.rotation;
+  final components = rotation ? 4 : 3;
+  final count = min(times.length, values.length ~/ components);
+  final a = Float64List(4);
+  final b = Float64List(4);
+  final sample = Float64List(4);
+
+  // The error of key j against the interpolation between keys i and k.
+  double errorBetween(int i, int j, int k) {
+    for (var c = 0; c < components; c++) {
+      a[c] = values[i * components + c];
+      b[c] = values[k * components + c];
+    }
+    final span = times[k] - times[i];
+    final t = span > 0 ? (times[j] - times[i]) / span : 1.0;
+    _interpolate(a, b, t, rotation, sample);
+    for (var c = 0; c < components; c++) {
+      b[c] = values[j * components + c];
+    }
+    return _error(sample, b, rotation) * errorScale;
+  }
+
+  final kept = <int>[if (count > 0) 0];
+  var anchor = 0;
+  for (var end = 2; end < count; end++) {
+    for (var j = anchor + 1; j < end; j++) {
+      if (errorBetween(anchor, j, end) > tolerance) {
+        anchor = end - 1;
+        kept.add(anchor);
+        break;
+      }
+    }
+  }
+  if (count > 1) kept.add(count - 1);
+
+  final keptTimes = Float32List(kept.length);
+  final keptValues = Float32List(kept.length * components);
+  for (var i = 0; i < kept.length; i++) {
+    keptTimes[i] = times[kept[i]];
+    for (var c = 0; c < components; c++) {
+      keptValues[i * components + c] = values[kept[i] * components + c];
+    }
+  }
+  final keyframes = rotation
+      ? CompressedKeyframes.rotation(keptValues)
+      : CompressedKeyframes.vector3(keptValues);
+
+  // Measure what the runtime will sample against every source key.
+  var maxError = 0.0;
+  var next = 0;
+  for (var j = 0; j < count; j++) {
+    while (next < kept.length - 1 && keptTimes[next] < times[j]) {
+      next++;
+    }
+    if (next == 0 || keptTimes[next] <= times[j]) {
+      _read(keyframes, next, sample);
+    } else {
+      _read(keyframes, next - 1, a);
+      _read(keyframes, next, b);
+      final t =
+          (times[j] - keptTimes[next - 1]) /
+          (keptTimes[next] - keptTimes[next - 1]);
+      _interpolate(a, b, t, rotation, sample);
+    }
+    for (var c = 0; c < components; c++) {
+      b[c] = values[j * components + c];
+    }
+    maxError = max(maxError, _error(sample, b, rotation) * errorScale);
+  }
+  return (times: keptTimes, keyframes: keyframes, maxError: maxError);
+}
+
+void _read(CompressedKeyframes keyframes, int index, Float64List out) {
+  if (keyframes.kind == CompressedKeyframesKind.rotation) {
+    keyframes.readRotation(index, out);
+  } else {
+    keyframes.readVector3(index, out);
+  }
+}
+
+// Lerp, or the engine's shortest-arc slerp for rotations.
+void _interpolate(
+  Float64List a,
+  Float64List b,
+  double t,
+  bool rotation,
+  Float64List out,
+) {
+  if (!rotation) {
+    for (var c = 0; c < 3; c++) {
+      out[c] = a[c] + (b[c] - a[c]) * t;
+    }
+    return;
+  }
+  var cosine = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+  var sign = 1.0;
+  if (cosine < 0) {
+    sign = -1.0;
+    cosine = -cosine;
+  }
+  double c0;
+  double c1;
+  if (cosine < 1.0 - 1e-3) {
+    final sine = sqrt(1.0 - cosine * cosine);
+    final angle = atan2(sine, cosine);
+    c0 = sin((1.0 - t) * angle) / sine;
+    c1 = sin(t * angle) / sine * sign;
+  } else {
+    c0 = 1.0 - t;
+    c1 = t * sign;
+  }
+  var length = 0.0;
+  for (var c = 0; c < 4; c++) {
+    out[c] = a[c] * c0 + b[c] * c1;
+    length += out[c] * out[c];
+  }
+  length = sqrt(length);
+  if (length > 0) {
+    for (var c = 0; c < 4; c++) {
+      out[c] /= length;
+    }
+  }
+}
+
+// Distance for vectors, the rotation angle between quaternions for
+// rotations.
+double _error(Float64List a, Float64List b, bool rotation) {
+  if (!rotation) {
+    final dx = a[0] - b[0];
+    final dy = a[1] - b[1];
+    final dz = a[2] - b[2];
+    return sqrt(dx * dx + dy * dy + dz * dz);
+  }
+  var dot = 0.0;
+  var lengthA = 0.0;
+  var lengthB = 0.0;
+  for (var c = 0; c < 4; c++) {
+    dot += a[c] * b[c];
+    lengthA += a[c] * a[c];
+    lengthB += b[c] * b[c];
+  }
+  final cosine = dot.abs() / sqrt(max(lengthA * lengthB, 1e-30));
+  return 2 * acos(min(1.0, cosine));
+}
+
+/// What compressing one animation's channels saved, reported by the
+/// importer.
+class AnimationCompressionReport {
+  AnimationCompressionReport(
+    this.animationName, {
+    required this.sourceBytes,
+    required this.compressedBytes,
+    required this.sourceKeys,
+    required this.keptKeys,
+    required this.maxError,
+  });
+
+  /// The animation's name.
+  final String animationName;
+
+  /// The channels' time and value bytes as float32 keys.
+  final int sourceBytes;
+
+  /// The same channels' bytes once compressed.
+  final int compressedBytes;
+
+  /// The keys across all channels before and after key removal.
+  final int sourceKeys;
+  final int keptKeys;
+
+  /// The largest error across the channels, in scene units.
+  final double maxError;
+
+  /// [sourceBytes] over [compressedBytes].
+  double get ratio => compressedBytes == 0 ? 1 : sourceBytes / compressedBytes;
+
+  @override
+  String toString() =>
+      '$animationName: $sourceBytes -> $compressedBytes bytes '
+      '(${ratio.toStringAsFixed(2)}x), $sourceKeys -> $keptKeys keys, '
+      'max error ${maxError.toStringAsPrecision(3)}';
+}
@@ -0,0 +1,255 @@
+import 'package:vector_math/vector_math.dart';
+
+import 'package:flutter_scene/src/animation.dart';
+import 'package:flutter_scene/src/node.dart';
+import 'package:flutter_scene/src/skin.dart';
+
+/// Plays animations on many skinned characters, evaluating each distinct
+/// pose once.
+///
+/// Characters join with [add], naming the skeleton template they were
+/// cloned from and the animation they play. Every [update] advances each
+/// member's time and quantizes it to a multiple of [timeStep]; members of
+/// one template playing one animation in the same time bucket then draw a
+/// single set of joint matrices, uploaded as one joints texture. Animation
+/// cost and texture uploads scale with the distinct poses, not the
+/// characters, so a coarser [timeStep] shares more at the price of
+/// visibly stepped motion.
+///
+/// Poses are evaluated on private clones of each template, so a member's
+/// own joints stay at rest; members should not also play clips of their
+/// own. The template's current transforms are the rest pose.
+///
+/// Shared poses still go through the regular per-skin joints texture.
+/// Baking a whole clip into one texture sampled by time in the skinned
+/// vertex stage is out of scope for this class.
+///
+/// ```dart
+/// final crowd = AnimationCrowd();
+/// for (var i = 0; i < 200; i++) {
+///   final extra = template.clone()..localTransform = placement(i);
+///   scene.add(extra);
+///   crowd.add(extra, template: template, animation: walk, time: i * 0.13);
+/// }
+/// // Each frame:
+/// crowd.update(deltaSeconds);
+/// ```
+/// {@category Animation}
+class AnimationCrowd {
+  /// Creates a crowd that shares poses within buckets of [timeStep]
+  /// seconds.
+  AnimationCrowd({this.timeStep = 1 / 30}) : assert(timeStep > 0);
+
+  /// The length of a time bucket, in seconds.
+  final double timeStep;
+
+  final Map<(Node, Animation), _CrowdGroup> _groups = {};
+  final List<CrowdMember> _members = [];
+  int _frame = 0;
+  int _evaluatedPoseCount = 0;
+
+  /// The characters in the crowd, in the order they were added.
+  List<CrowdMember> get members => List.unmodifiable(_members);
+
+  /// The distinct poses the members drew after the last [update].
+  int get poseCount {
+    var count = 0;
+    for (final group in _groups.values) {
+      count += group.poses.length;
+    }
+    return count;
+  }
+
+  /// The poses the last [update] evaluated. A pose some member already
+  /// drew the frame before is kept, not evaluated again.
+  int get evaluatedPoseCount => _evaluatedPoseCount;
+
+  /// Adds [character], a clone of [template], playing [animation] from
+  /// [time] at [speed], looping when [loop] is true.
+  ///
+  /// Throws an [ArgumentError] when [character] does not have a skin
+  /// wherever [template] does, with the same joint count.
+  CrowdMember add(
+    Node character, {
+    required Node template,
+    required Animation animation,
+    double time = 0,
+    double speed = 1,
+    bool loop = true,
+  }) {
+    final group = _groups.putIfAbsent(
+      (template, animation),
+      () => _CrowdGroup(template, animation),
+    );
+    final skins = <Skin>[];
+    for (var i = 0; i < group.skinPaths.length; i++) {
+      final skin = character.getChildByIndexPath(group.skinPaths[i])?.skin;
+      if (skin == null ||
+          skin.joints.length != group.rigSkins[i].skin!.joints.length) {
+        throw ArgumentError.value(
+          character,
+          'character',
+          'does not share the skeleton of template "${template.name}"',
+        );
+      }
+      skins.add(skin);
+    }
+    final member = CrowdMember._(character, group, skins)
+      ..time = time
+      ..speed = speed
+      ..loop = loop;
+    group.memberCount++;
+    _members.add(member);
+    return member;
+  }
+
+  /// Removes [member], returning its skins to drawing their own joints.
+  /// No-op when [member] is not in this crowd.
+  void remove(CrowdMember member) {
+    if (!_members.remove(member)) return;
+    for (final skin in member._skins) {
+      skin.sharedPose = null;
+    }
+    final group = member._group;
+    if (--group.memberCount == 0) {
+      _groups.removeWhere((_, registered) => identical(registered, group));
+    }
+  }
+
+  /// Advances every member by [deltaSeconds] and points its skins at the
+  /// pose for its time bucket, evaluating poses no member held last frame.
+  void update(double deltaSeconds) {
+    final frame = ++_frame;
+    _evaluatedPoseCount = 0;
+    for (final member in _members) {
+      member._advance(deltaSeconds);
+      final group = member._group;
+      final end = group.animation.endTime;
+      final bucket = (member.time / timeStep).floor();
+      var pose = group.poses[bucket];
+      if (pose == null) {
+        pose = group.acquire(bucket, (bucket * timeStep).clamp(0.0, end));
+        _evaluatedPoseCount++;
+      }
+      pose.frame = frame;
+      for (var i = 0; i < member._skins.length; i++) {
+        member._skins[i].sharedPose = pose.joints[i];
+      }
+    }
+    for (final group in _groups.values) {
+      group.releaseUnused(frame);
+    }
+  }
+}
+
+/// A character in an [AnimationCrowd].
+/// {@category Animation}
+class CrowdMember {
+  CrowdMember._(this.character, this._group, this._skins);
+
+  /// The character's root node.
+  final Node character;
+
+  final _CrowdGroup _group;
+  final List<Skin> _skins;
+
+  /// The member's playback time, in seconds.
+  double time = 0;
+
+  /// The rate playback advances at; `1` is real time.
+  double speed = 1;
+
+  /// Whether playback wraps at the animation's end rather than holding the
+  /// last frame.
+  bool loop = true;
+
+  /// The animation the member plays.
+  Animation get animation => _group.animation;
+
+  void _advance(double deltaSeconds) {
+    final end = animation.endTime;
+    time += deltaSeconds * speed;
+    if (loop && end > 0) {
+      time %= end;
+    } else {
+      time = time.clamp(0.0, end);
+    }
+  }
+}
+
+// The poses of one template playing one animation, evaluated on a private
+// clone (the rig).
+class _CrowdGroup {
+  _CrowdGroup(Node template, this.animation) : rig = template.clone() {
+    void collect(Node node, List<int> path) {
+      if (node.skin != null) {
+        skinPaths.add(List.unmodifiable(path));
+        rigSkins.add(rig.getChildByIndexPath(path)!);
+      }
+      for (var i = 0; i < node.children.length; i++) {
+        collect(node.children[i], [...path, i]);
+      }
+    }
+
+    collect(template, const []);
+    _clip = _player.createAnimationClip(animation, rig)..weight = 1;
+  }
+
+  final Animation animation;
+  final Node rig;
+
+  /// Index paths from the template root to each skinned node.
+  final List<List<int>> skinPaths = [];
+
+  /// The rig's skinned nodes, parallel to [skinPaths].
+  final List<Node> rigSkins = [];
+
+  /// The poses members drew this frame, by time bucket.
+  final Map<int, _CrowdPose> poses = {};
+
+  int memberCount = 0;
+
+  final AnimationPlayer _player = AnimationPlayer();
+  late final AnimationClip _clip;
+  // Released poses, reused so their textures are not reallocated.
+  final List<_CrowdPose> _spare = [];
+
+  _CrowdPose acquire(int bucket, double time) {
+    final pose =
+        (_spare.isEmpty ? null : _spare.removeLast()) ??
+        _CrowdPose([
+          for (final node in rigSkins)
+            SharedJointPose(node.skin!.joints.length),
+        ]);
+    _clip.seek(time);
+    _player.update(0);
+    for (var i = 0; i < rigSkins.length; i++) {
+      final node = rigSkins[i];
+      final worldToMesh =
+          Matrix4.tryInvert(node.globalTransform) ?? Matrix4.identity();
+      final joints = pose.joints[i];
+      node.skin!.writeJointMatrices(joints.matrices, worldToMesh);
+      joints.markChanged();
+    }
+    poses[bucket] = pose;
+    return pose;
+  }
+
+  void releaseUnused(int frame) {
+    poses.removeWhere((_, pose) {
+      if (pose.frame == frame) return false;
+      _spare.add(pose);
+      return true;
+    });
+  }
+}
+
+class _CrowdPose {
+  _CrowdPose(this.joints);
+
+  /// One shared pose per skinned node of the rig.
+  final List<SharedJointPose> joints;
+
+  /// The last frame a member drew this pose.
+  int frame = 0;
+}
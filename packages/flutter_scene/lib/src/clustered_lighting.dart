@@ -0,0 +1,33 @@
+/// Froxel-clustered assignment of the scene's point, spot, and area lights.
+///
+/// By default each render item carries its own list of the lights that reach
+/// it, built on the CPU every frame by culling the lights against the scene's
+/// BVH. With clustering on, the view frustum is instead split into a grid of
+/// [tilesX] x [tilesY] screen tiles and [depthSlices] exponential depth
+/// slices, the lights are binned into those cells once per view, and every
+/// fragment shades only the lights of the cell it falls in. The CPU cost then
+/// follows the light count rather than the draw count, and a large object
+/// lit by many small lights no longer runs into the per-object light budget,
+/// which applies per cell instead.
+///
+/// Items with a non-default `Node.lightChannelMask` and shadow catchers keep
+/// their per-item lists. Non-perspective views fall back to a single cell
+/// holding every light. Off by default.
+///
+/// See `Scene.clusteredLighting`.
+/// {@category Lighting and environment}
+class ClusteredLightingSettings {
+  /// Whether lights are assigned per froxel instead of per item. Off by
+  /// default.
+  bool enabled = false;
+
+  /// Screen tiles across the view. Clamped to `1..64`.
+  int tilesX = 16;
+
+  /// Screen tiles down the view. Clamped to `1..64`.
+  int tilesY = 9;
+
+  /// Exponential depth slices between the camera's near and far planes.
+  /// Clamped to `1..64`.
+  int depthSlices = 24;
+}
@@ -99,7 +99,17 @@ class InstancedMeshComponent extends Component {
       item.instanceBounds = instancedMesh.aggregateBounds;
     }
     if (boundsChangedByInput) {
-      item.refreshInstanceData();
+      // Per-instance edits alone repack just the instances they touched.
+      final range =
+          worldTransformVersion == _worldTransformVersion &&
+              geometryBoundsVersion == _geometryBoundsVersion
+          ? instancedMesh.dirtyRangeSince(_instanceRevision)
+          : null;
+      if (range == null) {
+        item.refreshInstanceData();
+      } else if (range.start < range.end) {
+        item.refreshInstanceData(start: range.start, end: range.end);
+      }
     }
 
     final wasBounded = item.worldBounds != null;
@@ -113,9 +123,9 @@ class InstancedMeshComponent extends Component {
     // refit.
     final renderScene = node.internalRenderScene;
     if (frustumCulledChanged || wasBounded != isBounded) {
-      renderScene?.markBvhStructureDirty();
+      renderScene?.markBvhStructureDirty(item);
     } else if (boundsChanged && item.frustumCulled) {
-      renderScene?.markBvhBoundsDirty();
+      renderScene?.markBvhBoundsDirty(item);
     }
     _worldTransformVersion = worldTransformVersion;
     _instanceRevision = instanceRevision;
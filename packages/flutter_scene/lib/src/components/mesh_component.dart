@@ -169,9 +169,11 @@ class MeshComponent extends Component {
     final skin = node.skin;
     final jointsTexture = skin?.getJointsTexture();
     final jointsTextureWidth = skin?.getTextureWidth() ?? 0;
+    final jointsInModelSpace = skin?.sharedPose != null;
 
     final renderScene = node.internalRenderScene;
     final frustumCulled = node.frustumCulled;
+    final occluder = node.occluder;
     final layers = node.layers;
     final lightChannelMask = node.lightChannelMask;
     final highlightColor = node.highlightColor;
@@ -194,6 +196,7 @@ class MeshComponent extends Component {
       item.primitiveVisible = primitive.visible;
       final frustumCulledChanged = item.frustumCulled != frustumCulled;
       item.frustumCulled = frustumCulled;
+      item.occluder = index == 0 ? occluder : null;
       item.layers = layers;
       item.lightChannelMask = lightChannelMask;
       if (transformChanged) item.worldTransform.setFrom(worldTransform);
@@ -203,6 +206,7 @@ class MeshComponent extends Component {
       item.highlightColor = highlightColor;
       item.jointsTexture = jointsTexture;
       item.jointsTextureWidth = jointsTextureWidth;
+      item.jointsInModelSpace = jointsInModelSpace;
       item.morphWeights = node.internalMorphWeights;
       if (staticShadowChanged) renderScene?.markStaticShadowDirty();
 
@@ -219,9 +223,9 @@ class MeshComponent extends Component {
       // BVH membership and needs a rebuild; a plain move only needs a
       // refit.
       if (frustumCulledChanged || wasBounded != isBounded) {
-        renderScene?.markBvhStructureDirty();
+        renderScene?.markBvhStructureDirty(item);
       } else if (boundsChanged && item.frustumCulled) {
-        renderScene?.markBvhBoundsDirty();
+        renderScene?.markBvhBoundsDirty(item);
       }
     }
     _worldTransformVersion = worldTransformVersion;
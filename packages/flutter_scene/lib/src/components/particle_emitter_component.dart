@@ -1,10 +1,11 @@
+import 'package:flutter/foundation.dart' show debugPrint;
+
 import 'package:flutter_scene/src/components/mesh_component.dart';
 import 'package:flutter_scene/src/geometry/billboard_geometry.dart';
 import 'package:flutter_scene/src/material/sprite_material.dart';
 import 'package:flutter_scene/src/mesh.dart';
 import 'package:flutter_scene/src/particles/particle_system.dart';
-
-import 'package:vector_math/vector_math.dart';
+import 'package:flutter_scene/src/particles/particle_worker_pool.dart';
 
 /// An engine component that simulates a [ParticleSystem] on the CPU and draws
 /// its live particles as one instanced batch of camera-facing billboards.
@@ -18,6 +19,17 @@ import 'package:vector_math/vector_math.dart';
 /// Configure the effect through the [system] (shape, spawner, modules, start
 /// distributions, gravity) and the [material] (texture, tint, blend mode). Set
 /// [facing]/[velocityStretch] for spark-like streaks.
+///
+/// Given a [workers] pool, the system simulates on a worker isolate instead:
+/// [update] only queues the frame delta and uploads the latest frame the
+/// worker finished, so the drawn particles trail the simulation by a frame
+/// or two. The worker owns the system from the first update on; [system]
+/// on this isolate keeps its state from then (see
+/// [ParticleWorkerPool.attach]), and unmounting releases the worker's copy,
+/// so a remounted emitter restarts from it. If the worker stops (a module
+/// throws there, or the system cannot be copied to it), the emitter logs
+/// the error and simulates [system] in [update] from then on, restarting
+/// from the state it had when the worker took it.
 /// {@category Particles}
 class ParticleEmitterComponent extends MeshComponent {
   /// Creates an emitter that drives [system]. When [material] is omitted a
@@ -26,25 +38,49 @@ class ParticleEmitterComponent extends MeshComponent {
   factory ParticleEmitterComponent({
     required ParticleSystem system,
     SpriteMaterial? material,
+    ParticleWorkerPool? workers,
   }) {
     final geometry = BillboardGeometry(capacity: system.storage.capacity);
     final spriteMaterial = material ?? SpriteMaterial();
-    return ParticleEmitterComponent._(system, geometry, spriteMaterial);
+    return ParticleEmitterComponent._(
+      system,
+      geometry,
+      spriteMaterial,
+      workers,
+    );
   }
 
-  ParticleEmitterComponent._(this.system, this._geometry, this._material)
-    : super(Mesh(_geometry, _material));
+  ParticleEmitterComponent._(
+    this.system,
+    this._geometry,
+    this._material,
+    this.workers,
+  ) : assert(
+        BillboardGeometry.floatsPerInstance == kParticleBillboardFloats,
+      ),
+      super(Mesh(_geometry, _material));
 
   /// The simulation this emitter advances and renders.
   final ParticleSystem system;
 
+  /// The pool that simulates [system] off this thread, or null to simulate
+  /// it in [update].
+  final ParticleWorkerPool? workers;
+
   final BillboardGeometry _geometry;
   final SpriteMaterial _material;
 
-  // Scratch vectors reused every frame so repacking allocates nothing.
-  final Vector3 _center = Vector3.zero();
-  final Vector4 _color = Vector4.zero();
-  final Vector3 _velocity = Vector3.zero();
+  // Off-thread state: the worker's handle, the deltas not yet sent, the
+  // steps in flight, and the newest frame not yet uploaded.
+  OffThreadParticles? _offThread;
+  final List<double> _deltas = [];
+  int _inFlight = 0;
+  ParticleFrame? _frame;
+  // Set once the worker failed; the emitter then steps on this thread.
+  bool _workerFailed = false;
+
+  // At most this many steps in flight; further deltas batch into the next.
+  static const int _kMaxStepsInFlight = 2;
 
   /// The material the billboards are drawn with (texture, tint, blend mode).
   SpriteMaterial get material => _material;
@@ -88,32 +124,73 @@ class ParticleEmitterComponent extends MeshComponent {
 
   @override
   void update(double deltaSeconds) {
+    if (workers != null && !_workerFailed) {
+      _updateOffThread(deltaSeconds);
+      return;
+    }
     if (!paused) system.step(deltaSeconds);
-    _repack();
+    _geometry.commit(
+      packParticleBillboards(
+        system.storage,
+        _geometry.instanceData,
+        aspectRatio: aspectRatio,
+        randomFlipX: randomFlipX,
+      ),
+    );
   }
 
-  // Copies the live particle columns into the billboard instance buffer.
-  void _repack() {
-    final s = system.storage;
-    final count = s.aliveCount;
-    for (var i = 0; i < count; i++) {
-      final size = s.size[i];
-      var width = size * aspectRatio;
-      if (randomFlipX && s.random01[i] < 0.5) width = -width;
-      _center.setValues(s.posX[i], s.posY[i], s.posZ[i]);
-      _color.setValues(s.colorR[i], s.colorG[i], s.colorB[i], s.colorA[i]);
-      _velocity.setValues(s.velX[i], s.velY[i], s.velZ[i]);
-      _geometry.setInstance(
-        i,
-        center: _center,
-        width: width,
-        height: size,
-        rotation: s.rotation[i],
-        color: _color,
-        frame: s.frame[i],
-        velocity: _velocity,
-      );
+  @override
+  void onUnmount() {
+    super.onUnmount();
+    _offThread?.dispose();
+    _offThread = null;
+    _deltas.clear();
+    _inFlight = 0;
+    _frame = null;
+  }
+
+  // Every delta reaches the worker, in order (batched while two steps are
+  // in flight), so the run matches the on-thread one step for step.
+  void _updateOffThread(double deltaSeconds) {
+    final offThread = _offThread ??= workers!.attach(system);
+    if (!paused) _deltas.add(deltaSeconds);
+    if (_inFlight < _kMaxStepsInFlight) {
+      _inFlight++;
+      final deltas = List<double>.of(_deltas);
+      _deltas.clear();
+      offThread
+          .step(deltas, aspectRatio: aspectRatio, randomFlipX: randomFlipX)
+          .then((frame) {
+            // Released by an unmount.
+            if (!identical(offThread, _offThread)) return;
+            _inFlight--;
+            // Steps resolve in order, so this is the newest frame.
+            if (frame != null) _frame = frame;
+            final error = offThread.error;
+            if (error != null) _fallBackOnThread(error);
+          });
     }
-    _geometry.commit(count);
+    final frame = _frame;
+    if (frame == null) return;
+    _frame = null;
+    _geometry.instanceData.setRange(
+      0,
+      frame.count * kParticleBillboardFloats,
+      frame.instances,
+    );
+    _geometry.commit(frame.count);
+  }
+
+  void _fallBackOnThread(Object error) {
+    debugPrint(
+      'flutter_scene: particle worker failed, simulating on this thread: '
+      '$error',
+    );
+    _workerFailed = true;
+    _offThread?.dispose();
+    _offThread = null;
+    _deltas.clear();
+    _inFlight = 0;
+    _frame = null;
   }
 }
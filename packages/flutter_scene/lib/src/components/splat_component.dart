@@ -18,6 +18,9 @@ import 'package:flutter_scene/src/splats/gaussian_splats.dart';
 /// final splats = await GaussianSplats.fromAsset('assets/garden.ply');
 /// scene.add(Node()..addComponent(SplatComponent(splats)));
 /// ```
+///
+/// A set from [GaussianSplats.fromStream] can be attached while it loads;
+/// the component draws whatever has arrived.
 /// {@category Gaussian splatting}
 class SplatComponent extends MeshComponent {
   /// Creates a component that draws [splats].
@@ -64,6 +67,12 @@ class SplatComponent extends MeshComponent {
   bool get antialiased => _geometry.antialiased;
   set antialiased(bool value) => _geometry.antialiased = value;
 
+  /// The most splats drawn per frame, or null (the default) to draw them
+  /// all. Over budget, the least important splats for the current camera
+  /// (faint, small, and distant) are dropped.
+  int? get splatBudget => _geometry.splatBudget;
+  set splatBudget(int? value) => _geometry.splatBudget = value;
+
   /// The active crop box (a unit cube placed in the set's local space), or
   /// null when no crop is set. See [setCropBox].
   vm.Matrix4? get cropBox => _geometry.cropBox;
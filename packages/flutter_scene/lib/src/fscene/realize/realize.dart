@@ -3,6 +3,7 @@ import 'package:flutter/services.dart' show AssetBundle;
 import 'package:vector_math/vector_math.dart';
 
 import 'package:flutter_scene/src/animation.dart' as engine;
+import 'package:flutter_scene/src/animation_compression.dart';
 
 import 'package:flutter_scene/src/components/component.dart';
 import 'package:scene/scene.dart';
@@ -335,20 +336,27 @@ void _serializeAnimations(
       final resolver = channel.resolver;
       final AnimationProperty property;
       final List<double> times;
-      final Float32List keyframes;
+      final LocalId keyframes;
       switch (resolver) {
         case engine.TranslationTimelineResolver():
           property = AnimationProperty.translation;
           times = resolver.times;
-          keyframes = _packVec3(resolver.values);
+          keyframes = _floatsPayload(document, _packVec3(resolver.values));
         case engine.RotationTimelineResolver():
           property = AnimationProperty.rotation;
           times = resolver.times;
-          keyframes = _packQuaternions(resolver.values);
+          keyframes = _floatsPayload(
+            document,
+            _packQuaternions(resolver.values),
+          );
         case engine.ScaleTimelineResolver():
           property = AnimationProperty.scale;
           times = resolver.times;
-          keyframes = _packVec3(resolver.values);
+          keyframes = _floatsPayload(document, _packVec3(resolver.values));
+        case engine.CompressedTimelineResolver():
+          property = AnimationProperty.values.byName(resolver.property.name);
+          times = resolver.times;
+          keyframes = _compressedPayload(document, resolver.keyframes);
         default:
           debugPrint(
             'fscene: animation "${animation.name}" channel with a custom '
@@ -368,7 +376,7 @@ void _serializeAnimations(
           targetName: nodeName,
           property: property,
           timeline: _floatsPayload(document, Float32List.fromList(times)),
-          keyframes: _floatsPayload(document, keyframes),
+          keyframes: keyframes,
         ),
       );
     }
@@ -395,6 +403,24 @@ Float32List _packQuaternions(List<Quaternion> values) {
   return out;
 }
 
+LocalId _compressedPayload(
+  SceneDocument document,
+  CompressedKeyframes keyframes,
+) {
+  final bytes = keyframes.toBytes();
+  return document
+      .addPayload(
+        PayloadSpec(
+          document.newId(),
+          encoding: PayloadEncoding.bytes,
+          format: kCompressedKeyframesFormat,
+          length: bytes.length,
+          bytes: bytes,
+        ),
+      )
+      .id;
+}
+
 LocalId _floatsPayload(SceneDocument document, Float32List floats) => document
     .addPayload(
       PayloadSpec(
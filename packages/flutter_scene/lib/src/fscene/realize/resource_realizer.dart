@@ -676,6 +676,9 @@ class ResourceRealizer {
     int vertexCount,
   ) {
     final bytes = _payloadBytes(spec.deltas, 'morph delta');
+    if (document.payload(spec.deltas)!.format == kSparseMorphDeltasFormat) {
+      return _buildSparseMorphData(res, spec, bytes, vertexCount);
+    }
     final floats = bytes.offsetInBytes % 4 == 0
         ? bytes.buffer.asFloat32List(
             bytes.offsetInBytes,
@@ -711,6 +714,39 @@ class ResourceRealizer {
     );
   }
 
+  // Reads a [kSparseMorphDeltasFormat] payload, checking it against [spec]
+  // and the geometry's vertex count.
+  MorphTargetData _buildSparseMorphData(
+    GeometryResource res,
+    MorphTargetsSpec spec,
+    Uint8List bytes,
+    int vertexCount,
+  ) {
+    final SparseMorphDeltas deltas;
+    try {
+      deltas = SparseMorphDeltas.fromBytes(bytes);
+    } on FormatException catch (e) {
+      throw FsceneFormatException(
+        'Geometry ${res.id} morph delta payload: ${e.message}',
+      );
+    }
+    if (deltas.targetCount != spec.targetCount ||
+        deltas.vertexCount != vertexCount ||
+        (deltas.normals != null) != spec.hasNormalDeltas ||
+        (deltas.tangents != null) != spec.hasTangentDeltas) {
+      throw FsceneFormatException(
+        'Geometry ${res.id} morph delta payload covers '
+        '${deltas.targetCount} targets of ${deltas.vertexCount} vertices; '
+        'expected ${spec.targetCount} targets of $vertexCount vertices',
+      );
+    }
+    return MorphTargetData.sparse(
+      deltas,
+      targetNames: spec.targetNames,
+      defaultWeights: spec.defaultWeights,
+    );
+  }
+
   gpu.PrimitiveType _topology(String name) {
     try {
       return gpu.PrimitiveType.values.byName(name);
@@ -12,6 +12,7 @@ import 'dart:typed_data';
 import 'package:vector_math/vector_math.dart';
 
 import 'package:flutter_scene/src/animation.dart' as engine;
+import 'package:flutter_scene/src/animation_compression.dart';
 import 'package:scene/scene.dart';
 import 'package:flutter_scene/src/node.dart';
 import 'package:flutter_scene/src/skin.dart';
@@ -75,7 +76,11 @@ engine.Animation? buildAnimation(
   final channels = <engine.AnimationChannel>[];
   for (final channel in spec.channels) {
     final times = _floats(document.payload(channel.timeline)).toList();
-    final values = _floats(document.payload(channel.keyframes));
+    final keyframesPayload = document.payload(channel.keyframes);
+    final quantized = _compressedKeyframes(keyframesPayload, channel, times);
+    final values = quantized == null
+        ? _floats(keyframesPayload)
+        : Float32List(0);
     final name = nodes[channel.target]?.name ?? channel.targetName ?? '';
 
     final engine.AnimationProperty property;
@@ -83,22 +88,40 @@ engine.Animation? buildAnimation(
     switch (channel.property) {
       case AnimationProperty.translation:
         property = engine.AnimationProperty.translation;
-        resolver = engine.PropertyResolver.makeTranslationTimeline(
-          times,
-          _vec3List(values),
-        );
+        resolver = quantized != null
+            ? engine.PropertyResolver.makeCompressedTimeline(
+                property,
+                times,
+                quantized,
+              )
+            : engine.PropertyResolver.makeTranslationTimeline(
+                times,
+                _vec3List(values),
+              );
       case AnimationProperty.rotation:
         property = engine.AnimationProperty.rotation;
-        resolver = engine.PropertyResolver.makeRotationTimeline(
-          times,
-          _quaternionList(values),
-        );
+        resolver = quantized != null
+            ? engine.PropertyResolver.makeCompressedTimeline(
+                property,
+                times,
+                quantized,
+              )
+            : engine.PropertyResolver.makeRotationTimeline(
+                times,
+                _quaternionList(values),
+              );
       case AnimationProperty.scale:
         property = engine.AnimationProperty.scale;
-        resolver = engine.PropertyResolver.makeScaleTimeline(
-          times,
-          _vec3List(values),
-        );
+        resolver = quantized != null
+            ? engine.PropertyResolver.makeCompressedTimeline(
+                property,
+                times,
+                quantized,
+              )
+            : engine.PropertyResolver.makeScaleTimeline(
+                times,
+                _vec3List(values),
+              );
       case AnimationProperty.weights:
         // The keyframes payload is the flattened glTF shape, one weight per
         // target per keyframe. Trailing floats past a whole keyframe are
@@ -122,6 +145,31 @@ engine.Animation? buildAnimation(
   return engine.Animation(name: spec.name, channels: channels);
 }
 
+// Reads a keyframes payload the importer compressed (see
+// [kCompressedKeyframesFormat]), or returns null for a float payload.
+CompressedKeyframes? _compressedKeyframes(
+  PayloadSpec? payload,
+  AnimationChannelSpec channel,
+  List<double> times,
+) {
+  final bytes = payload?.bytes;
+  if (bytes == null || payload!.format != kCompressedKeyframesFormat) {
+    return null;
+  }
+  final keyframes = CompressedKeyframes.fromBytes(bytes);
+  final rotation = channel.property == AnimationProperty.rotation;
+  if (channel.property == AnimationProperty.weights ||
+      rotation != (keyframes.kind == CompressedKeyframesKind.rotation) ||
+      keyframes.count != times.length) {
+    throw FormatException(
+      'Compressed ${channel.property.name} keyframes do not match their '
+      'channel (${keyframes.kind.name}, ${keyframes.count} keys for '
+      '${times.length} times)',
+    );
+  }
+  return keyframes;
+}
+
 List<Matrix4> _matrices(PayloadSpec? payload) {
   final floats = _floats(payload);
   final count = floats.length ~/ 16;
@@ -766,6 +766,12 @@ abstract class Geometry {
   /// nodes carries the correct skeleton for every draw.
   void setJointsTexture(gpu.Texture? texture, int width) {}
 
+  /// Hook for skinned geometries to learn which space the joints texture
+  /// from [setJointsTexture] is in: world space (the default), or the
+  /// mesh node's space when [modelSpace] is true, as for a pose shared
+  /// between characters. Called alongside [setJointsTexture].
+  void setJointsInModelSpace(bool modelSpace) {}
+
   /// Binds vertex/index buffers and per-frame uniforms onto [pass] in
   /// preparation for a draw call.
   ///
@@ -1205,6 +1211,7 @@ class UnskinnedGeometry extends Geometry {
 class SkinnedGeometry extends Geometry {
   gpu.Texture? _jointsTexture;
   int _jointsTextureWidth = 0;
+  bool _jointsInModelSpace = false;
 
   /// Creates a [SkinnedGeometry] preconfigured with the `SkinnedVertex`
   /// shader from [baseShaderLibrary].
@@ -1245,6 +1252,11 @@ class SkinnedGeometry extends Geometry {
     _jointsTextureWidth = width;
   }
 
+  @override
+  void setJointsInModelSpace(bool modelSpace) {
+    _jointsInModelSpace = modelSpace;
+  }
+
   @override
   void bind(
     gpu.RenderPass pass,
@@ -1283,26 +1295,29 @@ class SkinnedGeometry extends Geometry {
     // applies them directly. Passing the mesh node's own transform here
     // would double-apply it (and glTF requires a skinned mesh node's
     // transform to be ignored). `modelTransform` is unused for skinned
-    // geometry as a result.
-    final identityTransform = vm.Matrix4.identity();
+    // geometry as a result, except under a shared pose, whose joint
+    // matrices are in the mesh node's space and need its transform.
+    final skinTransform = _jointsInModelSpace
+        ? modelTransform
+        : vm.Matrix4.identity();
     final frameInfoSlot = boundShader.getUniformSlot('FrameInfo');
     final frameInfoFloats = Float32List.fromList([
-      identityTransform.storage[0],
-      identityTransform.storage[1],
-      identityTransform.storage[2],
-      identityTransform.storage[3],
-      identityTransform.storage[4],
-      identityTransform.storage[5],
-      identityTransform.storage[6],
-      identityTransform.storage[7],
-      identityTransform.storage[8],
-      identityTransform.storage[9],
-      identityTransform.storage[10],
-      identityTransform.storage[11],
-      identityTransform.storage[12],
-      identityTransform.storage[13],
-      identityTransform.storage[14],
-      identityTransform.storage[15],
+      skinTransform.storage[0],
+      skinTransform.storage[1],
+      skinTransform.storage[2],
+      skinTransform.storage[3],
+      skinTransform.storage[4],
+      skinTransform.storage[5],
+      skinTransform.storage[6],
+      skinTransform.storage[7],
+      skinTransform.storage[8],
+      skinTransform.storage[9],
+      skinTransform.storage[10],
+      skinTransform.storage[11],
+      skinTransform.storage[12],
+      skinTransform.storage[13],
+      skinTransform.storage[14],
+      skinTransform.storage[15],
       cameraTransform.storage[0],
       cameraTransform.storage[1],
       cameraTransform.storage[2],
@@ -9,6 +9,10 @@ import 'dart:typed_data';
 /// {@category Geometry}
 const int kMaxGpuMorphTargets = 8;
 
+/// The payload `format` of an `.fscene` morph delta chunk holding
+/// [SparseMorphDeltas.toBytes] bytes rather than dense float slabs.
+const String kSparseMorphDeltasFormat = 'morph-runs';
+
 /// The largest morph texture dimension the GPU blend path assumes, the
 /// GLES 3.0 minimum guarantee. Geometry whose packed deltas do not fit
 /// falls back to CPU blending.
@@ -22,6 +26,12 @@ const int kMorphTextureMaxDimension = 2048;
 /// (`[target][vertex][xyz]`) and aligned with the owning geometry's packed
 /// vertex order.
 ///
+/// The deltas are held as [deltas], runs of the vertices each target moves.
+/// Data built from dense slabs holds one run per target over the slabs
+/// themselves; [MorphTargetData.sparse] holds only the moved vertices, so a
+/// facial rig whose targets each touch a few hundred vertices stores and
+/// blends just those. [deltaBytes] reports what is held.
+///
 /// Instances are usually built by the importers. The per-instance weights
 /// live on the mesh-bearing [Node] ([Node.setMorphWeight]); this object
 /// carries only the shared deltas, [targetNames], and [defaultWeights].
@@ -38,18 +48,23 @@ class MorphTargetData {
   MorphTargetData({
     required this.vertexCount,
     required this.targetCount,
-    required this.positionDeltas,
-    this.normalDeltas,
-    this.tangentDeltas,
+    required Float32List positionDeltas,
+    Float32List? normalDeltas,
+    Float32List? tangentDeltas,
     List<String>? targetNames,
     List<double>? defaultWeights,
-  }) : targetNames = List.unmodifiable([
-         for (var i = 0; i < targetCount; i++)
-           (targetNames != null && i < targetNames.length)
-               ? targetNames[i]
-               : '',
-       ]),
-       defaultWeights = Float32List(targetCount) {
+  }) : targetNames = _names(targetNames, targetCount),
+       defaultWeights = _weights(defaultWeights, targetCount),
+       _positionDeltas = positionDeltas,
+       _normalDeltas = normalDeltas,
+       _tangentDeltas = tangentDeltas,
+       deltas = SparseMorphDeltas.dense(
+         vertexCount: vertexCount,
+         targetCount: targetCount,
+         positions: positionDeltas,
+         normals: normalDeltas,
+         tangents: tangentDeltas,
+       ) {
     if (positionDeltas.length != targetCount * vertexCount * 3) {
       throw ArgumentError(
         'positionDeltas has ${positionDeltas.length} floats; expected '
@@ -68,11 +83,35 @@ class MorphTargetData {
         );
       }
     }
-    if (defaultWeights != null) {
-      for (var i = 0; i < targetCount && i < defaultWeights.length; i++) {
-        this.defaultWeights[i] = defaultWeights[i];
+  }
+
+  /// Creates morph data over run-encoded [deltas], which cover
+  /// [SparseMorphDeltas.targetCount] targets of
+  /// [SparseMorphDeltas.vertexCount] vertices. [targetNames] and
+  /// [defaultWeights] are padded/truncated as for the dense constructor.
+  MorphTargetData.sparse(
+    this.deltas, {
+    List<String>? targetNames,
+    List<double>? defaultWeights,
+  }) : vertexCount = deltas.vertexCount,
+       targetCount = deltas.targetCount,
+       targetNames = _names(targetNames, deltas.targetCount),
+       defaultWeights = _weights(defaultWeights, deltas.targetCount);
+
+  static List<String> _names(List<String>? names, int targetCount) =>
+      List.unmodifiable([
+        for (var i = 0; i < targetCount; i++)
+          (names != null && i < names.length) ? names[i] : '',
+      ]);
+
+  static Float32List _weights(List<double>? weights, int targetCount) {
+    final result = Float32List(targetCount);
+    if (weights != null) {
+      for (var i = 0; i < targetCount && i < weights.length; i++) {
+        result[i] = weights[i];
       }
     }
+    return result;
   }
 
   /// The number of vertices each target's deltas cover.
@@ -81,16 +120,53 @@ class MorphTargetData {
   /// The number of morph targets.
   final int targetCount;
 
+  /// The deltas as runs of moved vertices per target. The blends, the
+  /// GPU delta texture, and the bounds all read these.
+  final SparseMorphDeltas deltas;
+
+  // Dense slabs: given to the dense constructor, or expanded from [deltas]
+  // on first request.
+  Float32List? _positionDeltas;
+  Float32List? _normalDeltas;
+  Float32List? _tangentDeltas;
+
   /// Position deltas, target-major, `targetCount * vertexCount * 3` floats.
-  final Float32List positionDeltas;
+  ///
+  /// For [MorphTargetData.sparse] data this expands [deltas] to dense
+  /// slabs on first use and keeps them; the engine itself never asks.
+  Float32List get positionDeltas =>
+      _positionDeltas ??= deltas.expand(deltas.positions);
 
   /// Normal deltas (same shape as [positionDeltas]), or null when the
-  /// targets carry none.
-  final Float32List? normalDeltas;
+  /// targets carry none. Expanded like [positionDeltas].
+  Float32List? get normalDeltas {
+    final normals = deltas.normals;
+    if (normals == null) return null;
+    return _normalDeltas ??= deltas.expand(normals);
+  }
 
   /// Tangent deltas, xyz only, or null when absent. Stored but not applied
   /// yet. TODO(morph-tangent-deltas): blend tangents on both paths.
-  final Float32List? tangentDeltas;
+  Float32List? get tangentDeltas {
+    final tangents = deltas.tangents;
+    if (tangents == null) return null;
+    return _tangentDeltas ??= deltas.expand(tangents);
+  }
+
+  /// The bytes of delta storage this set holds: [deltas] (which share the
+  /// slabs of dense-constructed data) plus any slabs expanded from them.
+  int get deltaBytes {
+    var bytes = deltas.lengthInBytes;
+    if (deltas.isDense) return bytes;
+    for (final slab in [_positionDeltas, _normalDeltas, _tangentDeltas]) {
+      bytes += slab?.lengthInBytes ?? 0;
+    }
+    return bytes;
+  }
+
+  /// The bytes the deltas would take as dense float slabs.
+  int get denseDeltaBytes =>
+      deltas.attributeCount * targetCount * vertexCount * 12;
 
   /// The target names (from the asset's `extras.targetNames`), empty
   /// strings for unnamed targets. Always [targetCount] entries.
@@ -107,7 +183,7 @@ class MorphTargetData {
     Float32List basePositions,
     Float32List weights, {
     Float32List? out,
-  }) => _blendAdditive(basePositions, weights, positionDeltas, out);
+  }) => _blendAdditive(basePositions, weights, deltas.positions, out);
 
   /// Blends [weights] worth of normal deltas onto [baseNormals] and
   /// renormalizes each result, keeping the base normal where the weighted
@@ -118,13 +194,13 @@ class MorphTargetData {
     Float32List weights, {
     Float32List? out,
   }) {
-    final deltas = normalDeltas;
-    if (deltas == null) {
+    final normals = deltas.normals;
+    if (normals == null) {
       if (out == null) return Float32List.fromList(baseNormals);
       out.setAll(0, baseNormals);
       return out;
     }
-    final result = _blendAdditive(baseNormals, weights, deltas, out);
+    final result = _blendAdditive(baseNormals, weights, normals, out);
     for (var v = 0; v < vertexCount; v++) {
       final x = result[v * 3], y = result[v * 3 + 1], z = result[v * 3 + 2];
       final lengthSquared = x * x + y * y + z * z;
@@ -142,10 +218,12 @@ class MorphTargetData {
     return result;
   }
 
+  // Adds [weights] worth of [values] (one of [deltas]' attributes) to a
+  // copy of [base].
   Float32List _blendAdditive(
     Float32List base,
     Float32List weights,
-    Float32List deltas,
+    Float32List values,
     Float32List? out,
   ) {
     if (base.length != vertexCount * 3) {
@@ -160,13 +238,18 @@ class MorphTargetData {
       );
     }
     result.setAll(0, base);
+    final runs = deltas.runs;
+    final runOffsets = deltas.runOffsets;
     final count = weights.length < targetCount ? weights.length : targetCount;
     for (var t = 0; t < count; t++) {
       final w = weights[t];
       if (w == 0.0) continue;
-      final offset = t * vertexCount * 3;
-      for (var i = 0; i < vertexCount * 3; i++) {
-        result[i] += w * deltas[offset + i];
+      var d = deltas.valueOffset(t) * 3;
+      for (var r = runOffsets[t]; r < runOffsets[t + 1]; r++) {
+        final end = (runs[r * 2] + runs[r * 2 + 1]) * 3;
+        for (var i = runs[r * 2] * 3; i < end; i++) {
+          result[i] += w * values[d++];
+        }
       }
     }
     return result;
@@ -192,38 +275,358 @@ class MorphTargetData {
   }
 }
 
-/// The layout of a morph delta texture: an `RGBA32F` 2D texture where every
-/// target owns a contiguous band of rows.
+/// Morph deltas as runs of consecutive vertices per target, storing values
+/// only for the vertices inside a run.
 ///
+/// Target `t`'s runs are `runs[2 * r]` (first vertex) and `runs[2 * r + 1]`
+/// (vertex count) for `r` from `runOffsets[t]` up to `runOffsets[t + 1]`,
+/// ascending. The attribute arrays hold xyz for each vertex of each run,
+/// in run order; every attribute shares the runs, so a vertex any of them
+/// moves is stored for all.
+///
+/// The dense layout is the special case of one full run per target
+/// ([SparseMorphDeltas.dense]). The importer stores the sparse form
+/// ([SparseMorphDeltas.fromDense]) in `.fscene` as a
+/// [kSparseMorphDeltasFormat] payload.
+/// {@category Geometry}
+class SparseMorphDeltas {
+  SparseMorphDeltas._({
+    required this.vertexCount,
+    required this.targetCount,
+    required this.runOffsets,
+    required this.runs,
+    required this.positions,
+    this.normals,
+    this.tangents,
+    this.isDense = false,
+  }) : _valueOffsets = Uint32List(targetCount + 1) {
+    var values = 0;
+    for (var t = 0; t < targetCount; t++) {
+      _valueOffsets[t] = values;
+      for (var r = runOffsets[t]; r < runOffsets[t + 1]; r++) {
+        values += runs[r * 2 + 1];
+      }
+    }
+    _valueOffsets[targetCount] = values;
+  }
+
+  /// Wraps dense target-major slabs (`targetCount * vertexCount * 3`
+  /// floats each) as one run per target, without copying them.
+  factory SparseMorphDeltas.dense({
+    required int vertexCount,
+    required int targetCount,
+    required Float32List positions,
+    Float32List? normals,
+    Float32List? tangents,
+  }) => SparseMorphDeltas._(
+    vertexCount: vertexCount,
+    targetCount: targetCount,
+    runOffsets: Uint32List.fromList([for (var t = 0; t <= targetCount; t++) t]),
+    runs: Uint32List.fromList([
+      for (var t = 0; t < targetCount; t++) ...[0, vertexCount],
+    ]),
+    positions: positions,
+    normals: normals,
+    tangents: tangents,
+    isDense: true,
+  );
+
+  /// Encodes dense target-major slabs, keeping each target's runs of
+  /// vertices where some attribute's delta is nonzero.
+  factory SparseMorphDeltas.fromDense({
+    required int vertexCount,
+    required int targetCount,
+    required Float32List positions,
+    Float32List? normals,
+    Float32List? tangents,
+  }) {
+    final slabs = [positions, ?normals, ?tangents];
+    bool moves(int t, int v) {
+      final o = (t * vertexCount + v) * 3;
+      for (final slab in slabs) {
+        if (slab[o] != 0 || slab[o + 1] != 0 || slab[o + 2] != 0) return true;
+      }
+      return false;
+    }
+
+    final runOffsets = Uint32List(targetCount + 1);
+    final runs = <int>[];
+    final moved = <int>[];
+    for (var t = 0; t < targetCount; t++) {
+      runOffsets[t] = runs.length ~/ 2;
+      var v = 0;
+      while (v < vertexCount) {
+        if (!moves(t, v)) {
+          v++;
+          continue;
+        }
+        final first = v;
+        while (v < vertexCount && moves(t, v)) {
+          moved.add(t * vertexCount + v);
+          v++;
+        }
+        runs
+          ..add(first)
+          ..add(v - first);
+      }
+    }
+    runOffsets[targetCount] = runs.length ~/ 2;
+    Float32List gather(Float32List slab) {
+      final out = Float32List(moved.length * 3);
+      for (var i = 0; i < moved.length; i++) {
+        out.setRange(i * 3, i * 3 + 3, slab, moved[i] * 3);
+      }
+      return out;
+    }
+
+    return SparseMorphDeltas._(
+      vertexCount: vertexCount,
+      targetCount: targetCount,
+      runOffsets: runOffsets,
+      runs: Uint32List.fromList(runs),
+      positions: gather(positions),
+      normals: normals == null ? null : gather(normals),
+      tangents: tangents == null ? null : gather(tangents),
+    );
+  }
+
+  /// Reads the layout [toBytes] writes.
+  ///
+  /// Throws a [FormatException] when [bytes] is not one.
+  factory SparseMorphDeltas.fromBytes(Uint8List bytes) {
+    if (bytes.length < _kSparseHeaderBytes) {
+      throw const FormatException('Sparse morph deltas header truncated');
+    }
+    final data = ByteData.sublistView(bytes);
+    if (data.getUint8(0) != _kSparseVersion) {
+      throw FormatException(
+        'Unsupported sparse morph deltas version ${data.getUint8(0)}',
+      );
+    }
+    final flags = data.getUint8(1);
+    final targetCount = data.getUint32(4, Endian.little);
+    final vertexCount = data.getUint32(8, Endian.little);
+    final runCount = data.getUint32(12, Endian.little);
+    var offset = _kSparseHeaderBytes;
+    Uint32List readWords(int count) {
+      if (offset + count * 4 > bytes.length) {
+        throw const FormatException('Sparse morph deltas truncated');
+      }
+      final words = Uint32List(count);
+      for (var i = 0; i < count; i++) {
+        words[i] = data.getUint32(offset + i * 4, Endian.little);
+      }
+      offset += count * 4;
+      return words;
+    }
+
+    final runOffsets = readWords(targetCount + 1);
+    final runs = readWords(runCount * 2);
+    if (runOffsets[0] != 0 || runOffsets[targetCount] != runCount) {
+      throw const FormatException('Sparse morph run count mismatch');
+    }
+    var values = 0;
+    for (var t = 0; t < targetCount; t++) {
+      if (runOffsets[t + 1] < runOffsets[t]) {
+        throw const FormatException('Sparse morph run offsets out of order');
+      }
+      var end = 0;
+      for (var r = runOffsets[t]; r < runOffsets[t + 1]; r++) {
+        if (r >= runCount ||
+            runs[r * 2] < end ||
+            runs[r * 2] + runs[r * 2 + 1] > vertexCount) {
+          throw const FormatException('Sparse morph run out of range');
+        }
+        end = runs[r * 2] + runs[r * 2 + 1];
+        values += runs[r * 2 + 1];
+      }
+    }
+    final attributes = 1 + (flags & 1) + ((flags >> 1) & 1);
+    if (bytes.length != offset + attributes * values * 12) {
+      throw const FormatException('Sparse morph deltas length mismatch');
+    }
+    Float32List readFloats() {
+      final floats = Float32List(values * 3);
+      for (var i = 0; i < floats.length; i++) {
+        floats[i] = data.getFloat32(offset + i * 4, Endian.little);
+      }
+      offset += floats.lengthInBytes;
+      return floats;
+    }
+
+    return SparseMorphDeltas._(
+      vertexCount: vertexCount,
+      targetCount: targetCount,
+      runOffsets: runOffsets,
+      runs: runs,
+      positions: readFloats(),
+      normals: flags & 1 != 0 ? readFloats() : null,
+      tangents: flags & 2 != 0 ? readFloats() : null,
+    );
+  }
+
+  /// The number of vertices each target spans.
+  final int vertexCount;
+
+  /// The number of morph targets.
+  final int targetCount;
+
+  /// Each target's first run index, then the total run count.
+  final Uint32List runOffsets;
+
+  /// (first vertex, vertex count) pairs, target by target.
+  final Uint32List runs;
+
+  /// Position deltas, xyz per stored vertex.
+  final Float32List positions;
+
+  /// Normal deltas, or null when the targets carry none.
+  final Float32List? normals;
+
+  /// Tangent deltas (xyz), or null when absent.
+  final Float32List? tangents;
+
+  /// Whether this is the dense layout, one full run per target.
+  final bool isDense;
+
+  // Each target's first stored vertex in the attribute arrays.
+  final Uint32List _valueOffsets;
+
+  /// The index, in stored vertices, of [target]'s first value in the
+  /// attribute arrays.
+  int valueOffset(int target) => _valueOffsets[target];
+
+  /// The number of vertices stored across all targets.
+  int get storedVertexCount => _valueOffsets[targetCount];
+
+  /// The attributes stored: positions, plus normals and tangents when
+  /// present.
+  int get attributeCount =>
+      1 + (normals == null ? 0 : 1) + (tangents == null ? 0 : 1);
+
+  /// The size of [toBytes]: a 16-byte header, the run tables, then the
+  /// attribute values.
+  int get lengthInBytes =>
+      _kSparseHeaderBytes +
+      runOffsets.lengthInBytes +
+      runs.lengthInBytes +
+      attributeCount * storedVertexCount * 12;
+
+  /// Serializes the deltas, little-endian: version, attribute flags (bit 0
+  /// normals, bit 1 tangents), two reserved bytes, the target, vertex, and
+  /// run counts, [runOffsets], [runs], then positions, normals, and
+  /// tangents.
+  Uint8List toBytes() {
+    final bytes = Uint8List(lengthInBytes);
+    final data = ByteData.sublistView(bytes)
+      ..setUint8(0, _kSparseVersion)
+      ..setUint8(1, (normals == null ? 0 : 1) | (tangents == null ? 0 : 2))
+      ..setUint32(4, targetCount, Endian.little)
+      ..setUint32(8, vertexCount, Endian.little)
+      ..setUint32(12, runs.length ~/ 2, Endian.little);
+    var offset = _kSparseHeaderBytes;
+    for (final words in [runOffsets, runs]) {
+      for (final word in words) {
+        data.setUint32(offset, word, Endian.little);
+        offset += 4;
+      }
+    }
+    for (final floats in [positions, ?normals, ?tangents]) {
+      for (final value in floats) {
+        data.setFloat32(offset, value, Endian.little);
+        offset += 4;
+      }
+    }
+    return bytes;
+  }
+
+  /// Expands [values], one of the attribute arrays, to a dense
+  /// target-major slab.
+  Float32List expand(Float32List values) {
+    if (isDense) return values;
+    final out = Float32List(targetCount * vertexCount * 3);
+    var d = 0;
+    for (var t = 0; t < targetCount; t++) {
+      for (var r = runOffsets[t]; r < runOffsets[t + 1]; r++) {
+        final first = (t * vertexCount + runs[r * 2]) * 3;
+        final length = runs[r * 2 + 1] * 3;
+        out.setRange(first, first + length, values, d);
+        d += length;
+      }
+    }
+    return out;
+  }
+}
+
+const int _kSparseVersion = 1;
+const int _kSparseHeaderBytes = 16;
+
+/// The layout of a morph delta texture, an `RGBA32F` 2D texture in one of
+/// two layouts.
+///
+/// In the band layout every target owns a contiguous band of rows.
 /// Vertices wrap left to right inside a band, [width] per row, so a wrap
 /// boundary never crosses into another target's rows. Within a band the
 /// position rows come first, then (when [includesNormals]) the normal rows.
 /// A texel's xyz carry one vertex's delta; w is unused padding.
+///
+/// The run-indexed layout ([MorphTexturePacking.runs]) holds only the
+/// vertices each target moves. Texel `i` sits at column `i % width`, row
+/// `i ~/ width`. Each target stores its run table, one texel per run
+/// (first vertex, vertex count, index of the run's first delta texel),
+/// followed by its deltas, [texelsPerValue] texels per moved vertex
+/// (position, then normal).
 class MorphTexturePacking {
   MorphTexturePacking({
     required this.width,
     required this.rowsPerAttribute,
     required this.includesNormals,
     required this.targetCount,
-  });
+  }) : runTableStarts = null,
+       _height = null;
 
-  /// Texels per row, `min(vertexCount, max texture width)`.
+  /// Creates the run-indexed layout, [height] rows of [width] texels with
+  /// target `t`'s run table at texel `runTableStarts[t]`.
+  MorphTexturePacking.runs({
+    required this.width,
+    required int height,
+    required this.includesNormals,
+    required Uint32List this.runTableStarts,
+  }) : rowsPerAttribute = 0,
+       targetCount = runTableStarts.length,
+       _height = height;
+
+  /// Texels per row. In the band layout `min(vertexCount, max texture
+  /// width)`.
   final int width;
 
   /// Rows one attribute of one target occupies, `ceil(vertexCount/width)`.
+  /// Zero in the run-indexed layout.
   final int rowsPerAttribute;
 
-  /// Whether each band carries normal rows after its position rows.
+  /// Whether each band carries normal rows after its position rows, or
+  /// each moved vertex a normal texel after its position texel.
   final bool includesNormals;
 
-  /// The number of bands.
+  /// The number of bands, or of run tables.
   final int targetCount;
 
+  /// Each target's first run table texel, or null in the band layout.
+  final Uint32List? runTableStarts;
+
+  final int? _height;
+
+  /// Whether this is the run-indexed layout.
+  bool get runIndexed => runTableStarts != null;
+
+  /// Texels per moved vertex in the run-indexed layout.
+  int get texelsPerValue => includesNormals ? 2 : 1;
+
   /// Rows per target band.
   int get bandRows => rowsPerAttribute * (includesNormals ? 2 : 1);
 
   /// Total texture height in rows.
-  int get height => bandRows * targetCount;
+  int get height => _height ?? bandRows * targetCount;
 
   /// The first row of [target]'s band.
   int bandStart(int target) => target * bandRows;
@@ -232,6 +635,10 @@ class MorphTexturePacking {
 /// Computes the delta-texture packing for [data], or null when the packed
 /// texture would exceed [maxWidth] x [maxHeight] (the caller then blends on
 /// the CPU instead).
+///
+/// Run-encoded data packs run-indexed when that at most halves the texture
+/// or only it fits; each draw then pays a binary search over the run
+/// table per active target. Dense data always packs in bands.
 MorphTexturePacking? computeMorphTexturePacking(
   MorphTargetData data, {
   int maxWidth = kMorphTextureMaxDimension,
@@ -240,40 +647,107 @@ MorphTexturePacking? computeMorphTexturePacking(
   if (data.vertexCount == 0 || data.targetCount == 0) return null;
   final width = data.vertexCount < maxWidth ? data.vertexCount : maxWidth;
   final rowsPerAttribute = (data.vertexCount + width - 1) ~/ width;
-  final packing = MorphTexturePacking(
+  final bands = MorphTexturePacking(
     width: width,
     rowsPerAttribute: rowsPerAttribute,
-    includesNormals: data.normalDeltas != null,
+    includesNormals: data.deltas.normals != null,
     targetCount: data.targetCount,
   );
-  if (packing.height > maxHeight) return null;
-  return packing;
+  final bandsFit = bands.height <= maxHeight;
+  final runs = data.deltas.isDense
+      ? null
+      : _runPacking(data.deltas, maxWidth, maxHeight);
+  if (runs != null &&
+      (!bandsFit ||
+          runs.width * runs.height * 2 <= bands.width * bands.height)) {
+    return runs;
+  }
+  return bandsFit ? bands : null;
+}
+
+MorphTexturePacking? _runPacking(
+  SparseMorphDeltas deltas,
+  int maxWidth,
+  int maxHeight,
+) {
+  final texelsPerValue = deltas.normals != null ? 2 : 1;
+  final tableStarts = Uint32List(deltas.targetCount);
+  var texels = 0;
+  for (var t = 0; t < deltas.targetCount; t++) {
+    tableStarts[t] = texels;
+    texels += deltas.runOffsets[t + 1] - deltas.runOffsets[t];
+    texels +=
+        (deltas.valueOffset(t + 1) - deltas.valueOffset(t)) * texelsPerValue;
+  }
+  if (texels == 0) texels = 1; // A texture needs a texel.
+  final width = texels < maxWidth ? texels : maxWidth;
+  final height = (texels + width - 1) ~/ width;
+  if (height > maxHeight) return null;
+  return MorphTexturePacking.runs(
+    width: width,
+    height: height,
+    includesNormals: deltas.normals != null,
+    runTableStarts: tableStarts,
+  );
 }
 
 /// Fills the texel payload for [data] packed per [packing]: RGBA float32
 /// texels, row-major, `packing.width * packing.height * 4` floats. Slots past
-/// a band's last vertex stay zero.
+/// a band's last vertex, and vertices a target does not move, stay zero.
 Float32List buildMorphTexturePayload(
   MorphTargetData data,
   MorphTexturePacking packing,
 ) {
   final texels = Float32List(packing.width * packing.height * 4);
-  void writeAttribute(Float32List deltas, int target, int firstRow) {
-    final source = target * data.vertexCount * 3;
-    for (var v = 0; v < data.vertexCount; v++) {
-      final row = firstRow + v ~/ packing.width;
-      final column = v % packing.width;
-      final texel = (row * packing.width + column) * 4;
-      texels[texel] = deltas[source + v * 3];
-      texels[texel + 1] = deltas[source + v * 3 + 1];
-      texels[texel + 2] = deltas[source + v * 3 + 2];
+  final deltas = data.deltas;
+  final runs = deltas.runs;
+  if (packing.runTableStarts case final tableStarts?) {
+    final normals = deltas.normals;
+    for (var t = 0; t < data.targetCount; t++) {
+      final firstRun = deltas.runOffsets[t];
+      final lastRun = deltas.runOffsets[t + 1];
+      var table = tableStarts[t] * 4;
+      var value = tableStarts[t] + (lastRun - firstRun);
+      var d = deltas.valueOffset(t) * 3;
+      for (var r = firstRun; r < lastRun; r++) {
+        texels[table] = runs[r * 2].toDouble();
+        texels[table + 1] = runs[r * 2 + 1].toDouble();
+        texels[table + 2] = value.toDouble();
+        table += 4;
+        for (var v = 0; v < runs[r * 2 + 1]; v++, d += 3) {
+          texels.setRange(value * 4, value * 4 + 3, deltas.positions, d);
+          if (normals != null) {
+            texels.setRange(value * 4 + 4, value * 4 + 7, normals, d);
+          }
+          value += packing.texelsPerValue;
+        }
+      }
+    }
+    return texels;
+  }
+  void writeAttribute(Float32List values, int target, int firstRow) {
+    var d = deltas.valueOffset(target) * 3;
+    for (
+      var r = deltas.runOffsets[target];
+      r < deltas.runOffsets[target + 1];
+      r++
+    ) {
+      final end = runs[r * 2] + runs[r * 2 + 1];
+      for (var v = runs[r * 2]; v < end; v++) {
+        final row = firstRow + v ~/ packing.width;
+        final column = v % packing.width;
+        final texel = (row * packing.width + column) * 4;
+        texels[texel] = values[d++];
+        texels[texel + 1] = values[d++];
+        texels[texel + 2] = values[d++];
+      }
     }
   }
 
   for (var t = 0; t < data.targetCount; t++) {
     final band = packing.bandStart(t);
-    writeAttribute(data.positionDeltas, t, band);
-    final normals = data.normalDeltas;
+    writeAttribute(deltas.positions, t, band);
+    final normals = deltas.normals;
     if (packing.includesNormals && normals != null) {
       writeAttribute(normals, t, band + packing.rowsPerAttribute);
     }
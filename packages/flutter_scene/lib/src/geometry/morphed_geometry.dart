@@ -4,21 +4,25 @@
 /// with morphing always applied before skinning:
 ///
 ///  * GPU (the default): the deltas upload once into an RGBA32F texture
-///    (row band per target, see [MorphTexturePacking]) and the morphed
-///    vertex shader sums the highest-magnitude [kMaxGpuMorphTargets]
-///    weights per draw.
+///    (row band per target, or for sparse targets only the moved vertices
+///    behind per-target run tables, see [MorphTexturePacking]) and the
+///    morphed vertex shader sums the highest-magnitude
+///    [kMaxGpuMorphTargets] weights per draw. Weights matching the last
+///    upload reuse it.
 ///  * CPU (the fallback): when the packed deltas exceed the guaranteed
 ///    texture dimensions ([kMorphTextureMaxDimension]), a weight change
-///    re-blends position and normal into a fresh vertex upload.
+///    re-blends position and normal into a fresh vertex upload, visiting
+///    only the vertices each weighted target moves.
 ///
 /// The policy is deterministic: GPU whenever [computeMorphTexturePacking]
-/// fits, CPU otherwise; [usesGpuMorphing] reports the choice.
+/// fits, CPU otherwise; [usesGpuMorphing] reports the choice. What either
+/// path uploaded over the last frame is in [MorphFrameStats].
 library;
 
 import 'dart:math' show sqrt;
 import 'dart:typed_data';
 
-import 'package:flutter/foundation.dart' show debugPrint;
+import 'package:flutter/foundation.dart' show debugPrint, internal;
 import 'package:flutter_scene/src/geometry/geometry.dart';
 import 'package:flutter_scene/src/geometry/morph_targets.dart';
 import 'package:flutter_scene/src/geometry/vertex_layout.dart';
@@ -27,6 +31,80 @@ import 'package:flutter_scene/src/importer/constants.dart';
 import 'package:flutter_scene/src/render/frame_transients.dart';
 import 'package:vector_math/vector_math.dart' as vm;
 
+/// Morph target uploads over one rendered frame, for telemetry: how draws
+/// got their weights and the bytes morphing uploaded (see
+/// `Scene.morphStats`).
+/// {@category Rendering}
+class MorphFrameStats {
+  const MorphFrameStats({
+    this.weightUploads = 0,
+    this.reusedWeights = 0,
+    this.cpuBlends = 0,
+    this.weightBytes = 0,
+    this.vertexBytes = 0,
+    this.textureBytes = 0,
+  });
+
+  /// GPU-path draws that uploaded their weights, and draws that reused the
+  /// upload of an earlier draw with the same weights.
+  final int weightUploads;
+  final int reusedWeights;
+
+  /// CPU-path re-blends, each a vertex buffer upload.
+  final int cpuBlends;
+
+  /// Bytes of weight uniforms, re-blended vertices, and delta textures
+  /// built this frame.
+  final int weightBytes;
+  final int vertexBytes;
+  final int textureBytes;
+
+  /// Everything morphing uploaded this frame.
+  int get uploadBytes => weightBytes + vertexBytes + textureBytes;
+
+  @override
+  String toString() =>
+      'MorphFrameStats(weightUploads: $weightUploads, '
+      'reusedWeights: $reusedWeights, cpuBlends: $cpuBlends, '
+      'uploadBytes: $uploadBytes)';
+}
+
+/// Running totals of morph uploads. A scene brackets its render with
+/// [totals] and [since] to get its own [MorphFrameStats].
+@internal
+class MorphUploadCounters {
+  int weightUploads = 0;
+  int reusedWeights = 0;
+  int cpuBlends = 0;
+  int weightBytes = 0;
+  int vertexBytes = 0;
+  int textureBytes = 0;
+
+  /// The totals so far, as a mark for [since].
+  MorphFrameStats get totals => MorphFrameStats(
+    weightUploads: weightUploads,
+    reusedWeights: reusedWeights,
+    cpuBlends: cpuBlends,
+    weightBytes: weightBytes,
+    vertexBytes: vertexBytes,
+    textureBytes: textureBytes,
+  );
+
+  /// What was counted after [mark] was taken from [totals].
+  MorphFrameStats since(MorphFrameStats mark) => MorphFrameStats(
+    weightUploads: weightUploads - mark.weightUploads,
+    reusedWeights: reusedWeights - mark.reusedWeights,
+    cpuBlends: cpuBlends - mark.cpuBlends,
+    weightBytes: weightBytes - mark.weightBytes,
+    vertexBytes: vertexBytes - mark.vertexBytes,
+    textureBytes: textureBytes - mark.textureBytes,
+  );
+}
+
+/// The morph upload totals, counted by every morphed geometry.
+@internal
+final MorphUploadCounters morphUploads = MorphUploadCounters();
+
 /// Unskinned geometry with morph targets.
 ///
 /// Construct it, then upload the base vertices with
@@ -38,7 +116,13 @@ class MorphedUnskinnedGeometry extends UnskinnedGeometry with _MorphBlending {
   /// Creates unskinned geometry morphed by [morphTargets].
   MorphedUnskinnedGeometry(MorphTargetData morphTargets) {
     _initMorphState(morphTargets);
-    if (usesGpuMorphing) setVertexShaderName('MorphedUnskinnedVertex');
+    if (usesGpuMorphing) {
+      setVertexShaderName(
+        _packing!.runIndexed
+            ? 'MorphedSparseUnskinnedVertex'
+            : 'MorphedUnskinnedVertex',
+      );
+    }
   }
 
   @override
@@ -90,7 +174,13 @@ class MorphedSkinnedGeometry extends SkinnedGeometry with _MorphBlending {
   /// Creates skinned geometry morphed by [morphTargets].
   MorphedSkinnedGeometry(MorphTargetData morphTargets) {
     _initMorphState(morphTargets);
-    if (usesGpuMorphing) setVertexShaderName('MorphedSkinnedVertex');
+    if (usesGpuMorphing) {
+      setVertexShaderName(
+        _packing!.runIndexed
+            ? 'MorphedSparseSkinnedVertex'
+            : 'MorphedSkinnedVertex',
+      );
+    }
   }
 
   @override
@@ -150,6 +240,22 @@ mixin _MorphBlending on Geometry {
   );
   bool _warnedCustomVertexVariant = false;
 
+  // GPU path: the MorphInfo kept for reuse, the weights it was built from,
+  // and the ring of buffers holding it. A slot is only rewritten once the
+  // submissions that read it have completed, so draws still in flight keep
+  // reading the weights they were bound with.
+  gpu.BufferView? _retainedInfo;
+  int _retainedSlot = 0;
+  Float32List? _retainedWeights;
+  final SubmissionStampedSlots _infoSlots = SubmissionStampedSlots(3);
+  final List<gpu.DeviceBuffer?> _infoRing = List.filled(3, null);
+
+  /// Whether a GPU-path draw whose weights match the last ones uploaded
+  /// rebinds that upload instead of selecting and uploading them again. On
+  /// by default; with it off every draw uploads its weights to the frame's
+  /// transient buffer.
+  bool reuseUnchangedWeights = true;
+
   /// Floats per vertex of this geometry's interleaved layout. Position sits
   /// at offset 0 and normal at offset 3 in both layouts.
   int get _strideInFloats;
@@ -161,6 +267,13 @@ mixin _MorphBlending on Geometry {
   /// texture dimensions) or falls back to CPU blending.
   bool get usesGpuMorphing => _packing != null;
 
+  /// The bytes of the GPU delta texture, or `0` on the CPU path. The CPU
+  /// side holds [MorphTargetData.deltaBytes].
+  int get morphTextureBytes {
+    final packing = _packing;
+    return packing == null ? 0 : packing.width * packing.height * 16;
+  }
+
   // Called by the subclass constructors.
   void _initMorphState(MorphTargetData data) {
     _morphData = data;
@@ -224,6 +337,9 @@ mixin _MorphBlending on Geometry {
     } finally {
       _uploadingBlend = false;
     }
+    morphUploads
+      ..cpuBlends += 1
+      ..vertexBytes += blended.lengthInBytes;
   }
 
   // Binds the morph texture and the active (index, weight) pairs for one
@@ -264,22 +380,78 @@ mixin _MorphBlending on Geometry {
       ),
     );
 
+    final slot = shader.getUniformSlot('MorphInfo');
     final weights = _gpuWeights ?? _morphData.defaultWeights;
+    final retained = _retainedInfo;
+    if (reuseUnchangedWeights &&
+        retained != null &&
+        _sameWeights(_retainedWeights!, weights)) {
+      pass.bindUniform(slot, retained);
+      _infoSlots.touch(_retainedSlot);
+      morphUploads.reusedWeights++;
+      return;
+    }
+
     final active = MorphTargetData.selectActiveTargets(weights);
     final scratch = _morphInfoScratch;
     scratch.fillRange(0, scratch.length, 0);
     scratch[0] = active.length.toDouble();
     scratch[1] = packing.width.toDouble();
-    scratch[2] = packing.rowsPerAttribute.toDouble();
     scratch[3] = packing.includesNormals ? 1 : 0;
-    for (var i = 0; i < active.length; i++) {
-      scratch[4 + i * 4] = packing.bandStart(active[i].index).toDouble();
-      scratch[4 + i * 4 + 1] = active[i].weight;
+    final tableStarts = packing.runTableStarts;
+    if (tableStarts == null) {
+      scratch[2] = packing.rowsPerAttribute.toDouble();
+      for (var i = 0; i < active.length; i++) {
+        scratch[4 + i * 4] = packing.bandStart(active[i].index).toDouble();
+        scratch[4 + i * 4 + 1] = active[i].weight;
+      }
+    } else {
+      final runOffsets = _morphData.deltas.runOffsets;
+      scratch[2] = packing.texelsPerValue.toDouble();
+      for (var i = 0; i < active.length; i++) {
+        final t = active[i].index;
+        scratch[4 + i * 4] = tableStarts[t].toDouble();
+        scratch[4 + i * 4 + 1] = active[i].weight;
+        scratch[4 + i * 4 + 2] = (runOffsets[t + 1] - runOffsets[t])
+            .toDouble();
+      }
+    }
+    final bytes = ByteData.sublistView(scratch);
+    morphUploads
+      ..weightUploads += 1
+      ..weightBytes += bytes.lengthInBytes;
+    final ringSlot = reuseUnchangedWeights ? _infoSlots.claim() : null;
+    if (ringSlot == null) {
+      // Every slot is still read by work in flight (weights churning, or
+      // nodes sharing this geometry with different weights): go through the
+      // transient buffer.
+      pass.bindUniform(slot, transientsBuffer.emplace(bytes));
+      return;
     }
-    pass.bindUniform(
-      shader.getUniformSlot('MorphInfo'),
-      transientsBuffer.emplace(ByteData.sublistView(scratch)),
+    _retainedSlot = ringSlot;
+    final buffer = _infoRing[ringSlot] ??= gpu.gpuContext
+        .createDeviceBuffer(gpu.StorageMode.hostVisible, bytes.lengthInBytes);
+    buffer.overwrite(bytes);
+    final info = _retainedInfo = gpu.BufferView(
+      buffer,
+      offsetInBytes: 0,
+      lengthInBytes: bytes.lengthInBytes,
     );
+    final kept = _retainedWeights;
+    if (kept != null && kept.length == weights.length) {
+      kept.setAll(0, weights);
+    } else {
+      _retainedWeights = Float32List.fromList(weights);
+    }
+    pass.bindUniform(slot, info);
+  }
+
+  static bool _sameWeights(Float32List a, Float32List b) {
+    if (a.length != b.length) return false;
+    for (var i = 0; i < a.length; i++) {
+      if (a[i] != b[i]) return false;
+    }
+    return true;
   }
 
   // Uploads the packed delta texels once. The texture is static content, so
@@ -293,6 +465,7 @@ mixin _MorphBlending on Geometry {
       format: gpu.PixelFormat.r32g32b32a32Float,
     );
     texture.overwrite(ByteData.sublistView(texels));
+    morphUploads.textureBytes += texels.lengthInBytes;
     return texture;
   }
 
@@ -324,25 +497,31 @@ mixin _MorphBlending on Geometry {
     final data = _morphData;
     final stride = _strideInFloats;
     final vertexCount = data.vertexCount;
-    final positionDeltas = data.positionDeltas;
-    final normalDeltas = data.normalDeltas;
+    final deltas = data.deltas;
+    final runs = deltas.runs;
+    final runOffsets = deltas.runOffsets;
+    final positionDeltas = deltas.positions;
+    final normalDeltas = deltas.normals;
     final count = weights.length < data.targetCount
         ? weights.length
         : data.targetCount;
     for (var t = 0; t < count; t++) {
       final w = weights[t];
       if (w == 0.0) continue;
-      final offset = t * vertexCount * 3;
-      for (var v = 0; v < vertexCount; v++) {
-        final o = v * stride;
-        final d = offset + v * 3;
-        out[o] += w * positionDeltas[d];
-        out[o + 1] += w * positionDeltas[d + 1];
-        out[o + 2] += w * positionDeltas[d + 2];
-        if (normalDeltas != null) {
-          out[o + 3] += w * normalDeltas[d];
-          out[o + 4] += w * normalDeltas[d + 1];
-          out[o + 5] += w * normalDeltas[d + 2];
+      // Only the vertices the target moves.
+      var d = deltas.valueOffset(t) * 3;
+      for (var r = runOffsets[t]; r < runOffsets[t + 1]; r++) {
+        final end = runs[r * 2] + runs[r * 2 + 1];
+        for (var v = runs[r * 2]; v < end; v++, d += 3) {
+          final o = v * stride;
+          out[o] += w * positionDeltas[d];
+          out[o + 1] += w * positionDeltas[d + 1];
+          out[o + 2] += w * positionDeltas[d + 2];
+          if (normalDeltas != null) {
+            out[o + 3] += w * normalDeltas[d];
+            out[o + 4] += w * normalDeltas[d + 1];
+            out[o + 5] += w * normalDeltas[d + 2];
+          }
         }
       }
     }
@@ -372,16 +551,18 @@ mixin _MorphBlending on Geometry {
   void _expandBoundsForMorphRange() {
     final bounds = localBounds;
     if (bounds == null) return;
-    final data = _morphData;
+    final deltas = _morphData.deltas;
     final lo = [0.0, 0.0, 0.0];
     final hi = [0.0, 0.0, 0.0];
-    for (var t = 0; t < data.targetCount; t++) {
-      final offset = t * data.vertexCount * 3;
+    for (var t = 0; t < deltas.targetCount; t++) {
+      // Unmoved vertices contribute the zero both extremes start from.
+      final offset = deltas.valueOffset(t) * 3;
+      final stored = deltas.valueOffset(t + 1) - deltas.valueOffset(t);
       for (var axis = 0; axis < 3; axis++) {
         var minDelta = 0.0;
         var maxDelta = 0.0;
-        for (var v = 0; v < data.vertexCount; v++) {
-          final delta = data.positionDeltas[offset + v * 3 + axis];
+        for (var v = 0; v < stored; v++) {
+          final delta = deltas.positions[offset + v * 3 + axis];
           if (delta < minDelta) minDelta = delta;
           if (delta > maxDelta) maxDelta = delta;
         }
@@ -9,6 +9,7 @@ import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
 import 'package:flutter_scene/src/gpu/render_pass_compat.dart';
 import 'package:flutter_scene/src/scene_encoder.dart';
 import 'package:flutter_scene/src/splats/gaussian_splats.dart';
+import 'package:flutter_scene/src/splats/splat_codec.dart';
 import 'package:flutter_scene/src/splats/splat_data.dart';
 import 'package:flutter_scene/src/splats/splat_sort_service.dart';
 import 'package:flutter_scene/src/splats/splat_sorter.dart';
@@ -35,25 +36,66 @@ enum SplatCropMode {
 /// projected footprint. Instances draw presorted back to front, re-sorted
 /// when the view direction drifts. Small sets sort on the calling thread;
 /// larger sets sort in the background, so a fast orbit can lag the true
-/// order by a few frames.
+/// order by a few frames. A set still streaming in refreshes its bounds as
+/// it grows, and rebuilds its sorters each time it doubles; the splats
+/// loaded in between draw after the sorted ones until then.
 ///
 /// Pair with a `SplatMaterial` and attach through a `SplatComponent`.
 /// {@category Geometry}
 class SplatGeometry extends Geometry {
   /// Creates geometry for [splats].
   SplatGeometry(this.splats) {
-    setVertexShaderName('SplatsVertex');
-    final bounds = splats.bounds;
-    if (bounds != null) {
-      final center = (bounds.min + bounds.max) * 0.5;
-      final radius = (bounds.max - bounds.min).length * 0.5;
-      setLocalBounds(bounds, vm.Sphere.centerRadius(center, radius));
-    }
+    setVertexShaderName(
+      splats.packing == SplatPacking.compact
+          ? 'SplatsCompactVertex'
+          : 'SplatsVertex',
+    );
+    _syncBounds();
   }
 
   /// The splat set this geometry draws.
   final GaussianSplats splats;
 
+  // The set revisions the bounds and the drawn order were built for.
+  int _boundsRevision = -1;
+  int _sortRevision = 0;
+
+  // What the sorters cover, so a streaming set does not rebuild them (and
+  // respawn the background pool) for every run.
+  final SplatSortCoverage _coverage = SplatSortCoverage();
+
+  // Pulls a streaming set's grown bounds in before anything reads them.
+  void _syncBounds() {
+    if (_boundsRevision == splats.revision) return;
+    _boundsRevision = splats.revision;
+    final bounds = splats.bounds;
+    if (bounds == null) return;
+    final center = (bounds.min + bounds.max) * 0.5;
+    final radius = (bounds.max - bounds.min).length * 0.5;
+    setLocalBounds(
+      vm.Aabb3.copy(bounds),
+      vm.Sphere.centerRadius(center, radius),
+    );
+  }
+
+  @override
+  int get localBoundsVersion {
+    _syncBounds();
+    return super.localBoundsVersion;
+  }
+
+  @override
+  vm.Aabb3? get localBounds {
+    _syncBounds();
+    return super.localBounds;
+  }
+
+  @override
+  vm.Sphere? get localBoundingSphere {
+    _syncBounds();
+    return super.localBoundingSphere;
+  }
+
   /// Global opacity multiplier in [0, 1].
   double opacity = 1.0;
 
@@ -109,10 +151,35 @@ class SplatGeometry extends Geometry {
     _shDegree = value.clamp(0, 2);
   }
 
+  /// The most splats drawn per frame, or null to draw them all.
+  ///
+  /// Over budget, each sort keeps the splats ranked highest by importance
+  /// (opacity times footprint area) over squared distance from the camera,
+  /// so faint, small, distant splats drop first. The selection is redone
+  /// when the camera turns or moves a tenth of the set's radius.
+  int? get splatBudget => _splatBudget;
+  int? _splatBudget;
+  set splatBudget(int? value) {
+    if (value == _splatBudget) return;
+    _splatBudget = value;
+    // Only a budgeted sorter carries the importance; rebuild either way.
+    _resetSorters();
+  }
+
+  // Whether the budget cuts the set as it stands.
+  bool get _budgeted {
+    final budget = _splatBudget;
+    return budget != null && budget < splats.count;
+  }
+
   // Re-sort when the local-space view direction rotates by more than about
   // one degree (dot < cos(1.1 degrees)).
   static const double _kResortDotThreshold = 0.99982;
 
+  // Under a budget, re-select when the local-space eye moves this fraction
+  // of the set's bounding radius.
+  static const double _kBudgetResortDistance = 0.1;
+
   // A ring of sorted-order instance buffers, so a completing sort never
   // overwrites one a recent frame's command buffer may still read. Slots
   // fill lazily; _activeSlot is the one bind() uses this frame.
@@ -128,8 +195,16 @@ class SplatGeometry extends Geometry {
   bool _sortInFlight = false;
   vm.Vector3? _lastSortDir;
   vm.Vector3? _pendingSortDir;
+  SplatBudget? _pendingBudget;
+  vm.Vector3? _lastSortEye;
+
+  // The entries of the active order, or null while it is still the
+  // identity order, which covers every loaded splat.
+  int? _orderCount;
 
   SplatSortService? _sorter;
+  IncrementalSplatSorter? _syncSorter;
+  SplatBudgetFilter? _syncFilter;
 
   /// Shuts down the background sorter (called when the owning component
   /// unmounts). A later draw lazily respawns it.
@@ -138,10 +213,38 @@ class SplatGeometry extends Geometry {
     _sorter = null;
     _sortInFlight = false;
     _pendingSortDir = null;
-    // Force a fresh sort on remount.
+    _pendingBudget = null;
+    // Drop a sort that lands after this, and force a fresh one on remount.
+    _sortGeneration++;
     _lastSortDir = null;
   }
 
+  // Drops every sorter, so the next draw sorts the set's current count
+  // under the current budget.
+  void _resetSorters() {
+    disposeSorter();
+    _syncSorter = null;
+    _syncFilter = null;
+  }
+
+  // Catches the sorters up with a streaming set: rebuilds them when
+  // [_coverage] says so, and otherwise re-sorts after a run arrived so the
+  // new splats join the drawn tail.
+  void _syncSorters() {
+    final grew = _sortRevision != splats.revision;
+    _sortRevision = splats.revision;
+    if (_sorter == null && _syncSorter == null) return;
+    if (_coverage.stale(
+      splats.count,
+      loading: splats.isLoading,
+      budgeted: _budgeted,
+    )) {
+      _resetSorters();
+    } else if (grew) {
+      _lastSortDir = null;
+    }
+  }
+
   gpu.BufferView? _quadVertices;
   gpu.BufferView? _quadIndices;
 
@@ -194,8 +297,8 @@ class SplatGeometry extends Geometry {
     setIndices(_quadIndices!, gpu.IndexType.int16);
 
     // Slot 0 starts as identity order so the set renders (approximately)
-    // before the first sort lands.
-    final identity = Float32List(splats.count);
+    // before the first sort lands. Every slot holds a whole streaming set.
+    final identity = Float32List(splats.capacity);
     for (var i = 0; i < identity.length; i++) {
       identity[i] = i.toDouble();
     }
@@ -205,7 +308,8 @@ class SplatGeometry extends Geometry {
     _activeSlot = 0;
   }
 
-  // Sets with at most this many splats sort on the calling thread. The sort
+  // Sets with at most this many splats sort on the calling thread (repairing
+  // the previous order when the view turned only slightly). The sort
   // is far cheaper than a worker round-trip at this size, and the order takes
   // effect within the requesting frame, so a small set never draws in the
   // identity-order fallback (which single-frame captures can otherwise
@@ -217,55 +321,92 @@ class SplatGeometry extends Geometry {
   // background sorter, coalescing to the latest request while one is in
   // flight. The sorter worker holds its own copy of the positions, so a
   // request ships twelve bytes out and the order transfers back.
-  void _requestSort(vm.Vector3 dirLocal) {
+  void _requestSort(vm.Vector3 dirLocal, SplatBudget? budget) {
+    _lastSortEye = budget == null
+        ? null
+        : vm.Vector3(budget.eyeX, budget.eyeY, budget.eyeZ);
     if (splats.count <= _kSyncSortMax) {
       _lastSortDir = dirLocal;
-      _applyOrder(
-        sortSplatsBackToFront(
-          splats.data.positions,
-          splats.count,
-          dirLocal.x,
-          dirLocal.y,
-          dirLocal.z,
-        ),
+      final positions = splats.data.positions;
+      if (_syncSorter == null) {
+        _coverage.built(splats.count, budgeted: _budgeted);
+      }
+      final sorter = _syncSorter ??= IncrementalSplatSorter(
+        positions,
+        count: splats.count,
       );
+      final order = sorter.sort(dirLocal.x, dirLocal.y, dirLocal.z);
+      if (budget == null) {
+        _applyOrder(order, withTail: true);
+        return;
+      }
+      final filter = _syncFilter ??= SplatBudgetFilter(
+        positions,
+        splats.importance,
+        count: splats.count,
+      );
+      final kept = filter.select(order, budget);
+      _applyOrder(Float32List.sublistView(filter.selected, 0, kept));
       return;
     }
     if (_sortInFlight) {
       _pendingSortDir = dirLocal;
+      _pendingBudget = budget;
       return;
     }
     _sortInFlight = true;
     _lastSortDir = dirLocal;
     final generation = ++_sortGeneration;
+    if (_sorter == null) {
+      _coverage.built(splats.count, budgeted: _budgeted);
+    }
     final sorter = _sorter ??= SplatSortService(
       splats.data.positions,
       splats.count,
+      importance: _budgeted ? splats.importance : null,
     );
-    sorter.sort(dirLocal.x, dirLocal.y, dirLocal.z).then((order) {
-      _sortInFlight = false;
-      if (order == null) return; // Disposed mid-sort.
+    sorter.sort(dirLocal.x, dirLocal.y, dirLocal.z, budget: budget).then((
+      order,
+    ) {
+      // Superseded by a reset, which also covers a dispose mid-sort.
       if (generation != _sortGeneration) return;
-      _applyOrder(order);
+      _sortInFlight = false;
+      if (order == null) return;
+      _applyOrder(order, withTail: budget == null);
       final pending = _pendingSortDir;
       _pendingSortDir = null;
-      if (pending != null) _requestSort(pending);
+      if (pending != null) _requestSort(pending, _pendingBudget);
     });
   }
 
   // Uploads [order] into the next ring slot and makes it the active order.
-  void _applyOrder(Float32List order) {
+  // [withTail] follows an unbudgeted order with the splats loaded since the
+  // sorter was built, in load order.
+  void _applyOrder(Float32List order, {bool withTail = false}) {
     final slot = (_activeSlot + 1) % _kIndexRingSize;
     final bytes = ByteData.sublistView(order);
     final buffer =
         _indexRing[slot] ??
         gpu.gpuContext.createDeviceBuffer(
           gpu.StorageMode.hostVisible,
-          splats.count * 4,
+          splats.capacity * 4,
         );
     buffer.overwrite(bytes);
+    var count = order.length;
+    if (withTail && splats.count > count) {
+      final tail = Float32List(splats.count - count);
+      for (var i = 0; i < tail.length; i++) {
+        tail[i] = (count + i).toDouble();
+      }
+      buffer.overwrite(
+        ByteData.sublistView(tail),
+        destinationOffsetInBytes: bytes.lengthInBytes,
+      );
+      count = splats.count;
+    }
     _indexRing[slot] = buffer;
     _activeSlot = slot;
+    _orderCount = count;
   }
 
   @override
@@ -282,19 +423,24 @@ class SplatGeometry extends Geometry {
   }) {
     if (splats.count == 0) return;
     _ensureGpuResources();
+    _syncSorters();
 
     final mvp = cameraTransform * modelTransform;
 
     // The MVP's w row measures view depth per unit of local position, so its
     // xyz is the local-space sort direction. Ordering along a direction is
-    // unaffected by camera translation, so only rotation triggers a re-sort.
+    // unaffected by camera translation, so only rotation triggers a re-sort,
+    // unless a budget's selection depends on the eye position.
     final storage = mvp.storage;
     final sortDir = vm.Vector3(storage[3], storage[7], storage[11]);
     if (sortDir.length2 > 1e-12) {
       sortDir.normalize();
+      final budget = _budgetFor(modelTransform, cameraPosition);
       final last = _lastSortDir;
-      if (last == null || last.dot(sortDir) < _kResortDotThreshold) {
-        _requestSort(sortDir);
+      if (last == null ||
+          last.dot(sortDir) < _kResortDotThreshold ||
+          (budget != null && _eyeMoved(budget))) {
+        _requestSort(sortDir, budget);
       }
     }
 
@@ -305,7 +451,7 @@ class SplatGeometry extends Geometry {
       gpu.BufferView(
         indexBuffer,
         offsetInBytes: 0,
-        lengthInBytes: splats.count * 4,
+        lengthInBytes: _drawCount * 4,
       ),
       slot: 1,
     );
@@ -322,6 +468,14 @@ class SplatGeometry extends Geometry {
       splats.shTexture ?? splats.paramsTexture,
       sampler: _dataSampler,
     );
+    final chunkTexture = splats.chunkTexture;
+    if (chunkTexture != null) {
+      pass.bindTexture(
+        vertexShader.getUniformSlot('splat_chunk_texture'),
+        chunkTexture,
+        sampler: _dataSampler,
+      );
+    }
 
     final viewport = currentSceneEncoderViewport;
     final frameInfo = Float32List(72);
@@ -337,7 +491,8 @@ class SplatGeometry extends Geometry {
     frameInfo[51] = splats.colorSpace == SplatColorSpace.linear ? 1.0 : 0.0;
     frameInfo[52] = splats.paramsWidth.toDouble();
     frameInfo[53] = splats.paramsHeight.toDouble();
-    // [54], [55] reserved.
+    frameInfo[54] = splats.chunkWidth.toDouble();
+    frameInfo[55] = splats.chunkHeight.toDouble();
     frameInfo[56] = splats.shWidth.toDouble();
     frameInfo[57] = splats.shHeight.toDouble();
     frameInfo[58] = splats.shStride.toDouble();
@@ -363,10 +518,30 @@ class SplatGeometry extends Geometry {
     );
   }
 
+  // The splats the active order draws.
+  int get _drawCount => _orderCount ?? splats.count;
+
+  // The budget a sort would apply now, the eye in the set's local space, or
+  // null when no budget cuts the set.
+  SplatBudget? _budgetFor(vm.Matrix4 modelTransform, vm.Vector3 camera) {
+    if (!_budgeted) return null;
+    final eye = vm.Matrix4.inverted(modelTransform).transformed3(camera);
+    return (count: _splatBudget!, eyeX: eye.x, eyeY: eye.y, eyeZ: eye.z);
+  }
+
+  // Whether the eye moved far enough since the last selection to redo it.
+  bool _eyeMoved(SplatBudget budget) {
+    final last = _lastSortEye;
+    if (last == null) return true;
+    final eye = vm.Vector3(budget.eyeX, budget.eyeY, budget.eyeZ);
+    final radius = localBoundingSphere?.radius ?? 0;
+    return last.distanceTo(eye) >= radius * _kBudgetResortDistance;
+  }
+
   @override
   void draw(gpu.RenderPass pass, {int instanceCount = 1}) {
     if (splats.count == 0) return;
-    drawIndexedCompat(pass, _kQuadIndexCount, instanceCount: splats.count);
+    drawIndexedCompat(pass, _kQuadIndexCount, instanceCount: _drawCount);
   }
 }
 
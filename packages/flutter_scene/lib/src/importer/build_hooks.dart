@@ -138,6 +138,14 @@ Uri discoveryDependencyDirectory(Uri packageRoot, String discoveryRoot) {
 /// container and the GPU footprint. Sources must be a multiple of 4 in both
 /// dimensions; anything else is stored uncompressed, with a warning naming it.
 /// Textures are mipmapped either way.
+///
+/// Set [lodLevels] to generate that many simplified levels for each
+/// single-primitive glTF mesh, emitted as `lod` components with screen-size
+/// thresholds picked from each level's simplification error. Set
+/// [optimizeVertexOrder] to reorder glTF geometry for the GPU vertex cache,
+/// overdraw, and vertex fetch. Set [animationTolerance] (scene units) to
+/// compress glTF translation, rotation, and scale channels within it, as
+/// `importGltfToFsceneb` does; morph weight channels stay uncompressed.
 void buildScenes({
   required BuildInput buildInput,
   required BuildOutputBuilder buildOutput,
@@ -146,7 +154,17 @@ void buildScenes({
   SceneAssetMode assetMode = SceneAssetMode.generatedTree,
   bool compressTextures = false,
   bool alignForCompression = false,
+  int lodLevels = 0,
+  bool optimizeVertexOrder = false,
+  double? animationTolerance,
 }) {
+  if (animationTolerance != null && !(animationTolerance > 0)) {
+    throw ArgumentError.value(
+      animationTolerance,
+      'animationTolerance',
+      'must be positive',
+    );
+  }
   // ignore: deprecated_member_use_from_same_package
   if (assetMode == SceneAssetMode.legacyOnly) {
     throwRemovedAssetMode(
@@ -334,7 +352,8 @@ void buildScenes({
     final assetStamp = (assetHashes..sort()).join(',');
     final stamp =
         'rev=$buildCacheRevision scene compress=$compressTextures '
-        'kind=$extension src=$sourceHash assets=[$assetStamp]';
+        'lod=$lodLevels vertexOrder=$optimizeVertexOrder '
+        'animTolerance=$animationTolerance kind=$extension src=$sourceHash assets=[$assetStamp]';
     final stampFile = File('${outputSceneUri.toFilePath()}.inputs');
     // The generated tree ships every file in it, so the stamp lives in the
     // manifest there rather than in a sidecar next to the output.
@@ -354,6 +373,9 @@ void buildScenes({
           workingDirectory: packageRoot.toFilePath(),
           compressTextures: compressTextures,
           alignForCompression: alignForCompression,
+          lodLevels: lodLevels,
+          optimizeVertexOrder: optimizeVertexOrder,
+          animationTolerance: animationTolerance,
         );
       } else {
         // `.fscene` (authored text) -> `.fsceneb` (binary), embedding referenced
@@ -31,6 +31,9 @@ Never buildScenes({
   SceneAssetMode assetMode = SceneAssetMode.generatedTree,
   bool compressTextures = false,
   bool alignForCompression = false,
+  int lodLevels = 0,
+  bool optimizeVertexOrder = false,
+  double? animationTolerance,
 }) => throw UnsupportedError(
   'buildScenes runs at build time on native platforms only.',
 );
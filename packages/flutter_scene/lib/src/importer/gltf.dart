@@ -14,4 +14,5 @@ export 'src/gltf/meshopt_decoder.dart';
 export 'src/gltf/parser.dart';
 export 'src/gltf/primitive_packer.dart';
 export 'src/gltf/types.dart';
+export 'src/gltf/vertex_order_optimizer.dart';
 export 'src/gltf/warnings.dart';
@@ -2,6 +2,10 @@ import 'dart:io';
 
 import 'gltf.dart';
 import 'src/fscene_emitter/fscene_emitter.dart';
+import '../animation_compression.dart';
+
+export 'src/fscene_emitter/fscene_emitter.dart' show LodReport;
+export '../animation_compression.dart' show AnimationCompressionReport;
 
 /// Converts a single glTF binary at [inputGltfFilePath] to a flutter_scene
 /// `.fsceneb` package at [outputFscenebFilePath].
@@ -9,12 +13,31 @@ import 'src/fscene_emitter/fscene_emitter.dart';
 /// Both paths can be relative; they are resolved against [workingDirectory]
 /// (defaulting to the caller's current directory, so Windows-style paths
 /// round-trip correctly via Uri). Pure Dart, no native binary.
+///
+/// A positive [lodLevels] generates that many simplified levels per
+/// single-primitive mesh, each keeping about [lodReduction] of the previous
+/// level's triangles, and emits them as `lod` components; [onLodReport]
+/// receives each mesh's chain (triangle counts, errors, thresholds).
+///
+/// Set [optimizeVertexOrder] to reorder each primitive's triangles and
+/// vertices for the GPU vertex cache, overdraw, and vertex fetch.
+///
+/// A non-null [animationTolerance] (scene units) compresses animation
+/// translation, rotation, and scale channels within it;
+/// [onAnimationReport] receives each animation's ratio and largest error.
+/// Morph weight channels are stored uncompressed.
 void importGltfToFsceneb(
   String inputGltfFilePath,
   String outputFscenebFilePath, {
   String? workingDirectory,
   bool compressTextures = false,
   bool alignForCompression = false,
+  int lodLevels = 0,
+  double lodReduction = 0.5,
+  void Function(LodReport report)? onLodReport,
+  bool optimizeVertexOrder = false,
+  double? animationTolerance,
+  void Function(AnimationCompressionReport report)? onAnimationReport,
 }) {
   final workingDirectoryUri = Uri.directory(
     workingDirectory ?? Directory.current.path,
@@ -37,6 +60,12 @@ void importGltfToFsceneb(
     gltf.bufferData,
     compressTextures: compressTextures,
     alignForCompression: alignForCompression,
+    lodLevels: lodLevels,
+    lodReduction: lodReduction,
+    onLodReport: onLodReport,
+    optimizeVertexOrder: optimizeVertexOrder,
+    animationTolerance: animationTolerance,
+    onAnimationReport: onAnimationReport,
   );
   final outputFile = File(outputFscenebFilePath);
   outputFile.parent.createSync(recursive: true);
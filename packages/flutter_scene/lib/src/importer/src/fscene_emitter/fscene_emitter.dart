@@ -16,7 +16,7 @@
 /// bounds, and the realizer leaves it unbounded (always visible).
 library;
 
-import 'dart:math' show Random;
+import 'dart:math' show Random, max;
 import 'dart:typed_data';
 
 import 'package:image/image.dart' as img;
@@ -24,7 +24,9 @@ import 'package:vector_math/vector_math.dart';
 
 import 'package:scene/scene.dart';
 
+import '../../../animation_compression.dart';
 import '../../../geometry/interleaved_layout.dart';
+import '../../../geometry/morph_targets.dart';
 import '../../../texture/basisu/basis_ktx2.dart';
 import '../../../texture/block_alignment.dart';
 import '../../../texture/ktx2/ktx2.dart';
@@ -35,6 +37,7 @@ import '../gltf/accessor.dart';
 import '../gltf/bounds_baker.dart';
 import '../gltf/coordinate_policy.dart';
 import '../../gltf_light_units.dart';
+import '../gltf/mesh_simplifier.dart';
 import '../gltf/primitive_packer.dart';
 import '../gltf/types.dart';
 
@@ -45,15 +48,48 @@ Uint8List emitFsceneb(
   Uint8List bufferData, {
   bool compressTextures = false,
   bool alignForCompression = false,
+  int lodLevels = 0,
+  double lodReduction = 0.5,
+  void Function(LodReport report)? onLodReport,
+  bool optimizeVertexOrder = false,
+  double? animationTolerance,
+  void Function(AnimationCompressionReport report)? onAnimationReport,
 }) => writeFsceneb(
   buildSceneDocument(
     doc,
     bufferData,
     compressTextures: compressTextures,
     alignForCompression: alignForCompression,
+    optimizeVertexOrder: optimizeVertexOrder,
+    lodLevels: lodLevels,
+    lodReduction: lodReduction,
+    onLodReport: onLodReport,
+    animationTolerance: animationTolerance,
+    onAnimationReport: onAnimationReport,
   ),
 );
 
+/// The level-of-detail chain generated for one mesh, reported by
+/// [buildSceneDocument] when it emits `lod` components.
+class LodReport {
+  LodReport(this.meshName, this.levels);
+
+  /// The glTF mesh's name, or `mesh <index>` when it has none.
+  final String meshName;
+
+  /// The chain, highest detail first; the first level is the source mesh.
+  final List<({int triangles, double error, double screenSize})> levels;
+
+  @override
+  String toString() => [
+    meshName,
+    for (final (i, level) in levels.indexed)
+      '  LOD$i: ${level.triangles} triangles, '
+          'error ${(level.error * 100).toStringAsFixed(3)}% of radius, '
+          'screenSize ${level.screenSize.toStringAsFixed(4)}',
+  ].join('\n');
+}
+
 /// Builds an `.fscene` [SceneDocument] from a parsed glTF document.
 ///
 /// Spatial data is converted to native scene coordinates during emission.
@@ -63,12 +99,36 @@ Uint8List emitFsceneb(
 /// container; the realizer transcodes or decodes them at load. An image that is
 /// not block aligned is stored uncompressed, or resampled up to alignment when
 /// [alignForCompression] is also set.
+///
+/// When [lodLevels] is positive, each mesh made of one triangle primitive
+/// without morph targets gets up to that many simplified levels, each
+/// aiming at [lodReduction] of the previous level's triangles (see
+/// [generateLodLevels]), and its nodes carry an `lod` component instead of
+/// a `mesh` component. [onLodReport] receives each generated chain.
+///
+/// When [optimizeVertexOrder] is set, geometry is packed with its triangles
+/// and vertices reordered for the vertex cache, overdraw, and vertex fetch
+/// (see `packGltfPrimitive`).
+///
+/// When [animationTolerance] is set, translation, rotation, and scale
+/// channels are compressed (see `animation_compression.dart`): keys that
+/// interpolation reproduces within that many scene units, measured along
+/// the node hierarchy, are dropped, and the rest are quantized to 6 bytes
+/// each. Morph weight channels are stored uncompressed.
+/// [onAnimationReport] receives each animation's ratio and largest error.
 SceneDocument buildSceneDocument(
   GltfDocument doc,
   Uint8List bufferData, {
   bool compressTextures = false,
   bool alignForCompression = false,
+  int lodLevels = 0,
+  double lodReduction = 0.5,
+  void Function(LodReport report)? onLodReport,
+  bool optimizeVertexOrder = false,
+  double? animationTolerance,
+  void Function(AnimationCompressionReport report)? onAnimationReport,
 }) {
+  assert(animationTolerance == null || animationTolerance > 0);
   // The document id stays content-derived, so distinct imports get distinct
   // ids, but local ids are minted from a fixed session: a node's id then
   // depends only on its position in the glTF, not on the buffer bytes. So
@@ -136,13 +196,17 @@ SceneDocument buildSceneDocument(
 
   // Geometry resources per mesh primitive, shared across the nodes that
   // reference the same mesh.
+  // Meshes that got a generated LOD chain list (geometry, screenSize) per
+  // level instead; their pairs hold just the source level.
   final meshPairs = <(int, bool), List<(LocalId, LocalId)>>{};
+  final meshLods = <(int, bool), List<(LocalId, double)>>{};
   for (var meshIndex = 0; meshIndex < doc.meshes.length; meshIndex++) {
     validateMorphTargetConsistency(doc.meshes[meshIndex]);
     List<(LocalId, LocalId)> buildPairs(bool skinned) {
       final pairs = <(LocalId, LocalId)>[];
       var primIndex = 0;
       final mesh = doc.meshes[meshIndex];
+      final triangleCount = mesh.primitives.where((p) => p.mode == 4).length;
       for (final primitive in mesh.primitives) {
         if (primitive.mode != 4) continue; // triangles only
         final bounds = _primitiveBounds(
@@ -153,17 +217,51 @@ SceneDocument buildSceneDocument(
           alsoUsedUnskinned: false,
           poseUnions: poseUnions,
         );
-        final geometryId = _buildGeometry(
-          document,
-          primitive,
-          doc,
-          bufferData,
-          bounds: bounds,
+        final packed = packGltfPrimitive(
+          primitive: primitive,
+          accessors: doc.accessors,
+          bufferViews: doc.bufferViews,
+          bufferData: bufferData,
+          coordinatePolicy: GltfCoordinatePolicy.bakeNative,
           includeSkinning: skinned,
-          morphTargetNames: mesh.targetNames,
-          defaultMorphWeights: mesh.weights,
+          optimizeVertexOrder: optimizeVertexOrder,
         );
-        pairs.add((geometryId, materialFor(primitive.material)));
+        // A chain draws one geometry per level, so only single-primitive
+        // meshes get one; generateLodLevels passes morphed ones through.
+        final levels = lodLevels > 0 && triangleCount == 1
+            ? generateLodLevels(
+                packed,
+                levels: lodLevels,
+                reduction: lodReduction,
+              )
+            : [GeneratedLodLevel(packed, 0, 0)];
+        final geometryIds = [
+          for (final level in levels)
+            _buildGeometry(
+              document,
+              level.primitive,
+              bounds: bounds,
+              morphTargetNames: mesh.targetNames,
+              defaultMorphWeights: mesh.weights,
+            ),
+        ];
+        if (levels.length > 1) {
+          meshLods[(meshIndex, skinned)] = [
+            for (var i = 0; i < levels.length; i++)
+              (geometryIds[i], levels[i].screenSize),
+          ];
+          onLodReport?.call(
+            LodReport(mesh.name ?? 'mesh $meshIndex', [
+              for (final level in levels)
+                (
+                  triangles: level.triangleCount,
+                  error: level.error,
+                  screenSize: level.screenSize,
+                ),
+            ]),
+          );
+        }
+        pairs.add((geometryIds.first, materialFor(primitive.material)));
         primIndex++;
       }
       return pairs;
@@ -197,8 +295,12 @@ SceneDocument buildSceneDocument(
     final node = doc.nodes[i];
     final components = <ComponentSpec>[];
     if (node.mesh != null && node.mesh! < doc.meshes.length) {
-      final pairs = meshPairs[(node.mesh!, node.skin != null)] ?? const [];
-      if (pairs.isNotEmpty) {
+      final key = (node.mesh!, node.skin != null);
+      final pairs = meshPairs[key] ?? const [];
+      final lods = meshLods[key];
+      if (lods != null) {
+        components.add(_lodComponent(lods, pairs.first.$2));
+      } else if (pairs.isNotEmpty) {
         // node.weights overrides the mesh's default morph weights for this
         // instance; it rides the mesh component rather than the shared
         // geometry resource.
@@ -258,6 +360,9 @@ SceneDocument buildSceneDocument(
   }
 
   // Animations (one keyframe timeline/value payload per channel).
+  final reach = animationTolerance == null || doc.animations.isEmpty
+      ? null
+      : _AnimationReach(doc);
   for (final animation in doc.animations) {
     _buildAnimation(
       document,
@@ -266,6 +371,10 @@ SceneDocument buildSceneDocument(
       bufferData,
       nodeIds,
       GltfCoordinatePolicy.bakeNative,
+      compression: reach == null
+          ? null
+          : (tolerance: animationTolerance!, reach: reach),
+      onReport: onAnimationReport,
     );
   }
 
@@ -320,8 +429,25 @@ void _buildAnimation(
   GltfDocument doc,
   Uint8List bufferData,
   List<LocalId> nodeIds,
-  GltfCoordinatePolicy coordinatePolicy,
-) {
+  GltfCoordinatePolicy coordinatePolicy, {
+  ({double tolerance, _AnimationReach reach})? compression,
+  void Function(AnimationCompressionReport report)? onReport,
+}) {
+  // Each node's share of the tolerance is split across the transform
+  // channels this animation drives on it, since their errors add.
+  final transformChannels = <int, int>{};
+  for (final channel in animation.channels) {
+    final target = channel.targetNode;
+    if (target != null && channel.targetPath != 'weights') {
+      transformChannels[target] = (transformChannels[target] ?? 0) + 1;
+    }
+  }
+  var sourceBytes = 0;
+  var compressedBytes = 0;
+  var sourceKeys = 0;
+  var keptKeys = 0;
+  var maxError = 0.0;
+
   final channels = <AnimationChannelSpec>[];
   for (final channel in animation.channels) {
     final target = channel.targetNode;
@@ -370,17 +496,54 @@ void _buildAnimation(
       targetPath: channel.targetPath,
     );
 
+    var timeline = Float32List.fromList(times);
+    final LocalId keyframesId;
+    if (compression != null && property != AnimationProperty.weights) {
+      final reach = compression.reach;
+      final compressed = compressChannel(
+        timeline,
+        keyframes,
+        kind: property == AnimationProperty.rotation
+            ? CompressedKeyframesKind.rotation
+            : CompressedKeyframesKind.vector3,
+        tolerance:
+            compression.tolerance /
+            (reach.chain[target] * transformChannels[target]!),
+        errorScale: property == AnimationProperty.translation
+            ? 1.0
+            : reach.errorScale(target),
+      );
+      sourceBytes += timeline.lengthInBytes + keyframes.lengthInBytes;
+      sourceKeys += timeline.length;
+      timeline = compressed.times;
+      keyframesId = _compressedPayload(document, compressed.keyframes);
+      compressedBytes +=
+          timeline.lengthInBytes + compressed.keyframes.lengthInBytes;
+      keptKeys += timeline.length;
+      maxError = max(maxError, compressed.maxError);
+    } else {
+      keyframesId = _floatPayload(document, keyframes, PayloadEncoding.floats);
+    }
+
     channels.add(
       AnimationChannelSpec(
         target: nodeIds[target],
         targetName: resolveGltfNodeName(doc.nodes[target].name, target),
         property: property,
-        timeline: _floatPayload(
-          document,
-          Float32List.fromList(times),
-          PayloadEncoding.floats,
-        ),
-        keyframes: _floatPayload(document, keyframes, PayloadEncoding.floats),
+        timeline: _floatPayload(document, timeline, PayloadEncoding.floats),
+        keyframes: keyframesId,
+      ),
+    );
+  }
+  if (compression != null && onReport != null && sourceKeys > 0) {
+    onReport(
+      AnimationCompressionReport(
+        animation.name ?? '',
+        sourceBytes: sourceBytes,
+        compressedBytes: compressedBytes,
+        sourceKeys: sourceKeys,
+        keptKeys: keptKeys,
+        maxError: maxError,
       ),
     );
   }
@@ -394,6 +557,85 @@ void _buildAnimation(
   );
 }
 
+/// How far each node's transform errors carry down the hierarchy, for
+/// spreading an animation tolerance over a joint chain.
+class _AnimationReach {
+  _AnimationReach(GltfDocument doc)
+    : chain = List.filled(doc.nodes.length, 1),
+      _extent = List.filled(doc.nodes.length, 0.0) {
+    final nodes = doc.nodes;
+    final depth = List.filled(nodes.length, -1);
+    final height = List.filled(nodes.length, 0);
+    bool valid(int index) => index >= 0 && index < nodes.length;
+    void visit(int index, int level) {
+      // Shared or cyclic children (invalid glTF) are visited once.
+      if (depth[index] >= 0) return;
+      depth[index] = level;
+      for (final child in nodes[index].children) {
+        if (!valid(child)) continue;
+        visit(child, level + 1);
+        height[index] = max(height[index], height[child] + 1);
+        _extent[index] = max(
+          _extent[index],
+          _offset(nodes[child]) + _extent[child],
+        );
+      }
+    }
+
+    final isChild = List.filled(nodes.length, false);
+    for (final node in nodes) {
+      for (final child in node.children) {
+        if (valid(child)) isChild[child] = true;
+      }
+    }
+    for (var i = 0; i < nodes.length; i++) {
+      if (!isChild[i]) visit(i, 0);
+    }
+    for (var i = 0; i < nodes.length; i++) {
+      visit(i, 0);
+      chain[i] = depth[i] + height[i] + 1;
+      _largestExtent = max(_largestExtent, _extent[i]);
+    }
+  }
+
+  /// The number of nodes on the longest root-to-leaf chain through each
+  /// node.
+  final List<int> chain;
+
+  // The farthest a node's descendants sit from it, summing rest offsets.
+  final List<double> _extent;
+  double _largestExtent = 0.0;
+
+  /// The distance a rotation or scale error on [node] is measured at: its
+  /// descendants' reach, floored so leaves (whose meshes still swing)
+  /// are not measured at zero.
+  double errorScale(int node) => max(
+    _extent[node],
+    _largestExtent > 0 ? 0.1 * _largestExtent : 1.0,
+  );
+
+  static double _offset(GltfNode node) =>
+      node.matrix?.getTranslation().length ?? node.translation?.length ?? 0.0;
+}
+
+LocalId _compressedPayload(
+  SceneDocument document,
+  CompressedKeyframes keyframes,
+) {
+  final bytes = keyframes.toBytes();
+  return document
+      .addPayload(
+        PayloadSpec(
+          document.newId(),
+          encoding: PayloadEncoding.bytes,
+          format: kCompressedKeyframesFormat,
+          length: bytes.length,
+          bytes: bytes,
+        ),
+      )
+      .id;
+}
+
 LocalId _floatPayload(
   SceneDocument document,
   Float32List floats,
@@ -447,6 +689,22 @@ ComponentSpec _meshComponent(
   );
 }
 
+ComponentSpec _lodComponent(List<(LocalId, double)> levels, LocalId material) {
+  return ComponentSpec(
+    'lod',
+    properties: {
+      'levels': ListValue([
+        for (final (geometryId, screenSize) in levels)
+          MapValue({
+            'geometry': ResourceRefValue(geometryId),
+            'material': ResourceRefValue(material),
+            'screenSize': DoubleValue(screenSize),
+          }),
+      ]),
+    },
+  );
+}
+
 ComponentSpec? _lightComponent(GltfPunctualLight light) {
   // The extension carries no shadow metadata, so imported lights keep shadow
   // rendering disabled unless the authored scene overrides the component.
@@ -487,22 +745,11 @@ TransformSpec _transform(GltfNode node) {
 
 LocalId _buildGeometry(
   SceneDocument document,
-  GltfMeshPrimitive primitive,
-  GltfDocument doc,
-  Uint8List bufferData, {
+  PackedPrimitive packed, {
   required BoundsSpec? bounds,
-  required bool includeSkinning,
   List<String> morphTargetNames = const [],
   List<double> defaultMorphWeights = const [],
 }) {
-  final packed = packGltfPrimitive(
-    primitive: primitive,
-    accessors: doc.accessors,
-    bufferViews: doc.bufferViews,
-    bufferData: bufferData,
-    coordinatePolicy: GltfCoordinatePolicy.bakeNative,
-    includeSkinning: includeSkinning,
-  );
   final morph = packed.morphTargets;
   // Unskinned geometry is stored de-interleaved (structure of arrays) so the
   // realizer uploads each attribute straight to its own GPU buffer with no
@@ -545,22 +792,21 @@ LocalId _buildGeometry(
   );
   MorphTargetsSpec? morphSpec;
   if (morph != null) {
-    // Dense GPU-ready delta slabs, concatenated positions/normals/tangents.
-    final sections = BytesBuilder(copy: false);
-    void addSection(Float32List floats) {
-      sections.add(
-        floats.buffer.asUint8List(floats.offsetInBytes, floats.lengthInBytes),
-      );
-    }
-
-    addSection(morph.positionDeltas);
-    if (morph.normalDeltas != null) addSection(morph.normalDeltas!);
-    if (morph.tangentDeltas != null) addSection(morph.tangentDeltas!);
-    final deltaBytes = sections.toBytes();
+    // Runs of the vertices each target moves, rather than dense slabs: a
+    // blend shape touching a few hundred vertices stores only those, and
+    // one moving every vertex costs a run header over the dense size.
+    final deltaBytes = SparseMorphDeltas.fromDense(
+      vertexCount: morph.vertexCount,
+      targetCount: morph.targetCount,
+      positions: morph.positionDeltas,
+      normals: morph.normalDeltas,
+      tangents: morph.tangentDeltas,
+    ).toBytes();
     final deltas = document.addPayload(
       PayloadSpec(
         document.newId(),
-        encoding: PayloadEncoding.floats,
+        encoding: PayloadEncoding.bytes,
+        format: kSparseMorphDeltasFormat,
         length: deltaBytes.length,
         bytes: deltaBytes,
       ),
@@ -0,0 +1,503 @@
+/// Offline level-of-detail generation: quadric-error edge collapse over a
+/// packed primitive, and screen-size thresholds picked from each level's
+/// error.
+///
+/// Collapses move a vertex onto a neighboring vertex (never to a new
+/// position), so every surviving vertex keeps its authored attributes: UVs,
+/// colors, tangents, joints, and weights carry over exactly. Vertices on a
+/// UV or normal seam (one position, several attribute sets) and on an open
+/// border are never moved, so seams and outlines stay intact; the cost is
+/// less reduction on heavily split meshes.
+///
+/// Pure Dart (no `dart:ui`/GPU), so it runs in the build-hook isolate.
+library;
+
+import 'dart:math';
+import 'dart:typed_data';
+
+import '../../constants.dart';
+import 'primitive_packer.dart';
+
+/// One simplified triangle list over an unchanged vertex buffer.
+class SimplifiedTriangles {
+  SimplifiedTriangles(this.indices, this.error);
+
+  /// Triangle indices into the source vertex buffer.
+  final Uint32List indices;
+
+  /// The largest collapse error, as a distance relative to the mesh's
+  /// bounding radius (`0` when nothing moved).
+  final double error;
+}
+
+/// Simplifies the triangle list [indices] over [vertices] ([stride] floats
+/// per vertex, position first) toward [targetIndexCount] indices.
+///
+/// Stops early when no remaining collapse keeps the surface from folding
+/// over or stays under [maxError] (relative to the bounding radius).
+SimplifiedTriangles simplifyTriangles(
+  Float32List vertices,
+  int stride,
+  Uint32List indices, {
+  required int targetIndexCount,
+  double maxError = double.infinity,
+}) {
+  final vertexCount = vertices.length ~/ stride;
+
+  // Weld vertices by position: each position id lists how many vertices
+  // (attribute sets) share it and one of them.
+  final byPosition = List<int>.generate(vertexCount, (i) => i)
+    ..sort((a, b) {
+      for (var c = 0; c < 3; c++) {
+        final order = vertices[a * stride + c].compareTo(
+          vertices[b * stride + c],
+        );
+        if (order != 0) return order;
+      }
+      return 0;
+    });
+  final positionOf = Int32List(vertexCount);
+  final wedges = <int>[];
+  final firstVertex = <int>[];
+  for (var k = 0; k < vertexCount; k++) {
+    final v = byPosition[k];
+    if (k > 0 && _samePosition(vertices, stride, v, byPosition[k - 1])) {
+      positionOf[v] = wedges.length - 1;
+      wedges[wedges.length - 1]++;
+    } else {
+      positionOf[v] = wedges.length;
+      wedges.add(1);
+      firstVertex.add(v);
+    }
+  }
+  final positionCount = wedges.length;
+
+  var minX = double.infinity, minY = double.infinity, minZ = double.infinity;
+  var maxX = -double.infinity, maxY = -double.infinity;
+  var maxZ = -double.infinity;
+  for (var v = 0; v < vertexCount; v++) {
+    final o = v * stride;
+    minX = min(minX, vertices[o]);
+    minY = min(minY, vertices[o + 1]);
+    minZ = min(minZ, vertices[o + 2]);
+    maxX = max(maxX, vertices[o]);
+    maxY = max(maxY, vertices[o + 1]);
+    maxZ = max(maxZ, vertices[o + 2]);
+  }
+  final dx = maxX - minX, dy = maxY - minY, dz = maxZ - minZ;
+  final radius = vertexCount == 0 ? 0.0 : sqrt(dx * dx + dy * dy + dz * dz) / 2;
+  if (radius == 0 || indices.length <= targetIndexCount) {
+    return SimplifiedTriangles(Uint32List.fromList(indices), 0);
+  }
+
+  // Area-weighted plane quadrics per position (the 10 unique terms of the
+  // symmetric 4x4), and the summed area, so a cost divided by it is a mean
+  // squared distance to the planes.
+  final quadrics = Float64List(positionCount * 10);
+  final weights = Float64List(positionCount);
+  for (var t = 0; t + 2 < indices.length; t += 3) {
+    final a = indices[t] * stride;
+    final b = indices[t + 1] * stride;
+    final c = indices[t + 2] * stride;
+    final e1x = vertices[b] - vertices[a];
+    final e1y = vertices[b + 1] - vertices[a + 1];
+    final e1z = vertices[b + 2] - vertices[a + 2];
+    final e2x = vertices[c] - vertices[a];
+    final e2y = vertices[c + 1] - vertices[a + 1];
+    final e2z = vertices[c + 2] - vertices[a + 2];
+    var nx = e1y * e2z - e1z * e2y;
+    var ny = e1z * e2x - e1x * e2z;
+    var nz = e1x * e2y - e1y * e2x;
+    final length = sqrt(nx * nx + ny * ny + nz * nz);
+    if (length < 1e-20) continue;
+    final area = length / 2;
+    nx /= length;
+    ny /= length;
+    nz /= length;
+    final d = -(nx * vertices[a] + ny * vertices[a + 1] + nz * vertices[a + 2]);
+    for (var corner = 0; corner < 3; corner++) {
+      final p = positionOf[indices[t + corner]];
+      final q = p * 10;
+      quadrics[q] += area * nx * nx;
+      quadrics[q + 1] += area * nx * ny;
+      quadrics[q + 2] += area * nx * nz;
+      quadrics[q + 3] += area * nx * d;
+      quadrics[q + 4] += area * ny * ny;
+      quadrics[q + 5] += area * ny * nz;
+      quadrics[q + 6] += area * ny * d;
+      quadrics[q + 7] += area * nz * nz;
+      quadrics[q + 8] += area * nz * d;
+      quadrics[q + 9] += area * d * d;
+      weights[p] += area;
+    }
+  }
+
+  // Lock seams (several attribute sets at one position) and open or
+  // non-manifold edges (not shared by exactly two triangles).
+  final locked = Uint8List(positionCount);
+  for (var p = 0; p < positionCount; p++) {
+    if (wedges[p] > 1) locked[p] = 1;
+  }
+  final edgeUses = <int, int>{};
+  for (var t = 0; t + 2 < indices.length; t += 3) {
+    for (var e = 0; e < 3; e++) {
+      final a = positionOf[indices[t + e]];
+      final b = positionOf[indices[t + (e + 1) % 3]];
+      if (a == b) continue;
+      final key = a < b ? a * positionCount + b : b * positionCount + a;
+      edgeUses[key] = (edgeUses[key] ?? 0) + 1;
+    }
+  }
+  edgeUses.forEach((key, uses) {
+    if (uses == 2) return;
+    locked[key ~/ positionCount] = 1;
+    locked[key % positionCount] = 1;
+  });
+
+  final triangles = Uint32List.fromList(indices);
+  var triangleCount = indices.length ~/ 3;
+  final targetTriangles = targetIndexCount ~/ 3;
+  final costLimit = maxError.isFinite
+      ? (maxError * radius) * (maxError * radius)
+      : double.infinity;
+  var maxCost = 0.0;
+  final collapseTo = Int32List(vertexCount);
+  final touched = Uint8List(positionCount);
+  final around = Int32List(positionCount + 1);
+
+  while (triangleCount > targetTriangles) {
+    // Triangles around each position, compressed rows.
+    around.fillRange(0, positionCount + 1, 0);
+    for (var k = 0; k < triangleCount * 3; k++) {
+      around[positionOf[triangles[k]] + 1]++;
+    }
+    for (var p = 0; p < positionCount; p++) {
+      around[p + 1] += around[p];
+    }
+    final aroundList = Int32List(triangleCount * 3);
+    final fill = Int32List.fromList(around.sublist(0, positionCount));
+    for (var k = 0; k < triangleCount * 3; k++) {
+      aroundList[fill[positionOf[triangles[k]]]++] = k ~/ 3;
+    }
+
+    // Candidate collapses u -> v along every edge, cheapest first.
+    final costs = <double>[];
+    final froms = <int>[];
+    final toVertices = <int>[];
+    for (var k = 0; k < triangleCount * 3; k++) {
+      final t = k - k % 3;
+      final from = triangles[k];
+      final to = triangles[t + (k - t + 1) % 3];
+      for (var dir = 0; dir < 2; dir++) {
+        final a = dir == 0 ? from : to;
+        final b = dir == 0 ? to : from;
+        final u = positionOf[a], v = positionOf[b];
+        if (u == v || locked[u] != 0) continue;
+        costs.add(_collapseCost(quadrics, weights, u, v, vertices, stride, b));
+        froms.add(u);
+        toVertices.add(b);
+      }
+    }
+    final order = List<int>.generate(costs.length, (i) => i)
+      ..sort((a, b) => costs[a].compareTo(costs[b]));
+
+    touched.fillRange(0, positionCount, 0);
+    for (var v = 0; v < vertexCount; v++) {
+      collapseTo[v] = v;
+    }
+    var collapses = 0;
+    var remaining = triangleCount;
+    for (final candidate in order) {
+      if (remaining <= targetTriangles) break;
+      final cost = costs[candidate];
+      if (cost > costLimit) break;
+      final u = froms[candidate];
+      final target = toVertices[candidate];
+      final v = positionOf[target];
+      if (touched[u] != 0 || touched[v] != 0) continue;
+      final removed = _tryCollapse(
+        triangles,
+        positionOf,
+        aroundList,
+        around[u],
+        around[u + 1],
+        u,
+        v,
+        target,
+        vertices,
+        stride,
+      );
+      if (removed < 0) continue;
+      collapseTo[firstVertex[u]] = target;
+      for (var q = 0; q < 10; q++) {
+        quadrics[v * 10 + q] += quadrics[u * 10 + q];
+      }
+      weights[v] += weights[u];
+      for (var r = around[u]; r < around[u + 1]; r++) {
+        final t = aroundList[r] * 3;
+        touched[positionOf[triangles[t]]] = 1;
+        touched[positionOf[triangles[t + 1]]] = 1;
+        touched[positionOf[triangles[t + 2]]] = 1;
+      }
+      if (cost > maxCost) maxCost = cost;
+      remaining -= removed;
+      collapses++;
+    }
+    if (collapses == 0) break;
+
+    // Apply the pass and drop the triangles that collapsed to an edge.
+    var write = 0;
+    for (var t = 0; t < triangleCount * 3; t += 3) {
+      final a = collapseTo[triangles[t]];
+      final b = collapseTo[triangles[t + 1]];
+      final c = collapseTo[triangles[t + 2]];
+      final pa = positionOf[a], pb = positionOf[b], pc = positionOf[c];
+      if (pa == pb || pb == pc || pa == pc) continue;
+      triangles[write++] = a;
+      triangles[write++] = b;
+      triangles[write++] = c;
+    }
+    triangleCount = write ~/ 3;
+  }
+
+  return SimplifiedTriangles(
+    Uint32List.fromList(triangles.sublist(0, triangleCount * 3)),
+    sqrt(maxCost) / radius,
+  );
+}
+
+bool _samePosition(Float32List vertices, int stride, int a, int b) =>
+    vertices[a * stride] == vertices[b * stride] &&
+    vertices[a * stride + 1] == vertices[b * stride + 1] &&
+    vertices[a * stride + 2] == vertices[b * stride + 2];
+
+// The mean squared plane distance of moving position [u] onto vertex
+// [target] (at position [v]), under both positions' merged quadrics.
+double _collapseCost(
+  Float64List quadrics,
+  Float64List weights,
+  int u,
+  int v,
+  Float32List vertices,
+  int stride,
+  int target,
+) {
+  final x = vertices[target * stride];
+  final y = vertices[target * stride + 1];
+  final z = vertices[target * stride + 2];
+  final a = u * 10, b = v * 10;
+  double term(int i) => quadrics[a + i] + quadrics[b + i];
+  final cost =
+      term(0) * x * x +
+      2 * term(1) * x * y +
+      2 * term(2) * x * z +
+      2 * term(3) * x +
+      term(4) * y * y +
+      2 * term(5) * y * z +
+      2 * term(6) * y +
+      term(7) * z * z +
+      2 * term(8) * z +
+      term(9);
+  final weight = weights[u] + weights[v];
+  return weight > 0 ? max(0, cost) / weight : 0;
+}
+
+// Checks moving position [u] onto vertex [target] (position [v]) against
+// the triangles around [u] (rows [start, end) of [aroundList]) and returns
+// how many triangles it removes, or -1 when a triangle sharing the edge
+// sees a different attribute set at [v] (a seam the move would tear) or a
+// kept triangle would fold over.
+int _tryCollapse(
+  Uint32List triangles,
+  Int32List positionOf,
+  Int32List aroundList,
+  int start,
+  int end,
+  int u,
+  int v,
+  int target,
+  Float32List vertices,
+  int stride,
+) {
+  var removed = 0;
+  for (var r = start; r < end; r++) {
+    final t = aroundList[r] * 3;
+    var sharesEdge = false;
+    var uCorner = -1;
+    for (var c = 0; c < 3; c++) {
+      final vertex = triangles[t + c];
+      final p = positionOf[vertex];
+      if (p == v) {
+        if (vertex != target) return -1;
+        sharesEdge = true;
+      } else if (p == u) {
+        uCorner = c;
+      }
+    }
+    if (sharesEdge) {
+      removed++;
+      continue;
+    }
+    // The triangle keeps its other two corners; its normal must not flip.
+    final o0 = triangles[t + uCorner] * stride;
+    final o1 = triangles[t + (uCorner + 1) % 3] * stride;
+    final o2 = triangles[t + (uCorner + 2) % 3] * stride;
+    final moved = target * stride;
+    final before = _normal(vertices, o0, o1, o2);
+    final after = _normal(vertices, moved, o1, o2);
+    final dot =
+        before.$1 * after.$1 + before.$2 * after.$2 + before.$3 * after.$3;
+    final beforeLength =
+        before.$1 * before.$1 + before.$2 * before.$2 + before.$3 * before.$3;
+    final afterLength =
+        after.$1 * after.$1 + after.$2 * after.$2 + after.$3 * after.$3;
+    // Reject a flip, or a sliver whose normal turns more than ~75 degrees.
+    if (dot <= 0 || dot * dot < 0.0625 * beforeLength * afterLength) {
+      return -1;
+    }
+  }
+  return removed;
+}
+
+(double, double, double) _normal(Float32List v, int a, int b, int c) {
+  final e1x = v[b] - v[a], e1y = v[b + 1] - v[a + 1], e1z = v[b + 2] - v[a + 2];
+  final e2x = v[c] - v[a], e2y = v[c + 1] - v[a + 1], e2z = v[c + 2] - v[a + 2];
+  return (
+    e1y * e2z - e1z * e2y,
+    e1z * e2x - e1x * e2z,
+    e1x * e2y - e1y * e2x,
+  );
+}
+
+/// One generated level of detail.
+class GeneratedLodLevel {
+  GeneratedLodLevel(this.primitive, this.error, this.screenSize);
+
+  /// The level's geometry, its vertices compacted to the ones it uses.
+  final PackedPrimitive primitive;
+
+  /// The simplification error relative to the bounding radius (`0` for
+  /// the source level).
+  final double error;
+
+  /// The [LodLevel]-style threshold: the smallest projected size, as a
+  /// fraction of the viewport height, at which this level draws.
+  final double screenSize;
+
+  /// The level's triangle count.
+  int get triangleCount => primitive.indexCount ~/ 3;
+}
+
+/// The viewport height, in pixels, whose one-pixel error budget picks the
+/// generated thresholds.
+const double kLodReferenceHeightPixels = 1080;
+
+/// Builds [levels] simplified levels of [source], each targeting
+/// [reduction] of the previous level's triangles, and returns them after
+/// the source level, highest detail first.
+///
+/// Each level's threshold is the projected size below which the next
+/// level's error stays under one pixel at [kLodReferenceHeightPixels]; the
+/// last level never culls. Generation stops early once a level no longer
+/// removes a tenth of the triangles. Morph-targeted primitives are returned
+/// alone, since their deltas follow the full vertex set.
+List<GeneratedLodLevel> generateLodLevels(
+  PackedPrimitive source, {
+  required int levels,
+  double reduction = 0.5,
+}) {
+  if (levels <= 0 || source.morphTargets != null || source.indexCount < 3) {
+    return [GeneratedLodLevel(source, 0, 0)];
+  }
+  final stride =
+      (source.isSkinned ? kSkinnedPerVertexSize : kUnskinnedPerVertexSize) ~/ 4;
+  final vertices = Float32List.sublistView(source.vertexBytes);
+  final sourceIndices = _readIndices(source);
+  // Each level simplifies the one before it, so its error against the
+  // source is bounded by the sum of the steps.
+  final simplified = <SimplifiedTriangles>[];
+  var previous = sourceIndices;
+  var error = 0.0;
+  for (var level = 0; level < levels; level++) {
+    final target = (previous.length * reduction) ~/ 3 * 3;
+    if (target < 3) break;
+    final next = simplifyTriangles(
+      vertices,
+      stride,
+      previous,
+      targetIndexCount: target,
+    );
+    if (next.indices.length > previous.length * 0.9) break;
+    error += next.error;
+    simplified.add(SimplifiedTriangles(next.indices, error));
+    previous = next.indices;
+  }
+  if (simplified.isEmpty) return [GeneratedLodLevel(source, 0, 0)];
+
+  // Level i draws down to the size where level i + 1's error reaches a
+  // pixel: error * radius spans error * size / 2 of the viewport height.
+  final thresholds = <double>[];
+  for (var i = 0; i < simplified.length; i++) {
+    final error = simplified[i].error;
+    var threshold = error > 0
+        ? 2 / (error * kLodReferenceHeightPixels)
+        : double.infinity;
+    final ceiling = thresholds.isEmpty ? 1.0 : thresholds.last * 0.5;
+    if (threshold > ceiling) threshold = ceiling;
+    thresholds.add(threshold);
+  }
+  return [
+    GeneratedLodLevel(source, 0, thresholds[0]),
+    for (var i = 0; i < simplified.length; i++)
+      GeneratedLodLevel(
+        _compact(source, vertices, stride, simplified[i].indices),
+        simplified[i].error,
+        i + 1 < thresholds.length ? thresholds[i + 1] : 0,
+      ),
+  ];
+}
+
+Uint32List _readIndices(PackedPrimitive source) {
+  if (source.indices32Bit) {
+    return Uint32List.fromList(Uint32List.sublistView(source.indexBytes));
+  }
+  return Uint32List.fromList(Uint16List.sublistView(source.indexBytes));
+}
+
+// A primitive holding just the vertices [indices] reference, in first-use
+// order.
+PackedPrimitive _compact(
+  PackedPrimitive source,
+  Float32List vertices,
+  int stride,
+  Uint32List indices,
+) {
+  final vertexCount = source.vertexCount;
+  final newIndex = Int32List(vertexCount)..fillRange(0, vertexCount, -1);
+  var count = 0;
+  final remapped = Uint32List(indices.length);
+  for (var i = 0; i < indices.length; i++) {
+    final old = indices[i];
+    if (newIndex[old] < 0) newIndex[old] = count++;
+    remapped[i] = newIndex[old];
+  }
+  final out = Float32List(count * stride);
+  for (var old = 0; old < vertexCount; old++) {
+    final index = newIndex[old];
+    if (index < 0) continue;
+    out.setRange(index * stride, (index + 1) * stride, vertices, old * stride);
+  }
+  final wide = count > 0x10000;
+  final indexBytes = wide
+      ? remapped.buffer.asUint8List()
+      : Uint16List.fromList(remapped).buffer.asUint8List();
+  return PackedPrimitive(
+    vertexBytes: out.buffer.asUint8List(),
+    vertexCount: count,
+    indexBytes: indexBytes,
+    indexCount: remapped.length,
+    indices32Bit: wide,
+    isSkinned: source.isSkinned,
+    sourceWindingFlipped: source.sourceWindingFlipped,
+  );
+}
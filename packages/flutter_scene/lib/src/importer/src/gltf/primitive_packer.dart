@@ -8,6 +8,7 @@ import 'accessor.dart';
 import 'coordinate_policy.dart';
 import 'draco/gltf_draco.dart';
 import 'types.dart';
+import 'vertex_order_optimizer.dart';
 
 /// Pure-data result of packing a glTF mesh primitive into
 /// flutter_scene's vertex layout.
@@ -26,6 +27,7 @@ class PackedPrimitive {
     required this.isSkinned,
     required this.sourceWindingFlipped,
     this.morphTargets,
+    this.vertexCache,
   });
 
   /// Packed vertex buffer in the engine's vertex layout (72 bytes per
@@ -54,6 +56,11 @@ class PackedPrimitive {
   /// order and coordinate-converted like the base vertices, or null when
   /// the primitive declares no targets.
   final PackedMorphTargets? morphTargets;
+
+  /// The post-transform vertex cache efficiency of the source triangle
+  /// order and of the packed one, when the primitive was packed with
+  /// `optimizeVertexOrder`; null otherwise.
+  final ({VertexCacheStats before, VertexCacheStats after})? vertexCache;
 }
 
 /// Morph target deltas packed alongside a [PackedPrimitive], target-major
@@ -106,6 +113,13 @@ class PackedMorphTargets {
 ///
 /// Set [includeSkinning] to false when the owning node has no skin. Some
 /// exporters leave joint attributes on otherwise static primitives.
+///
+/// Set [optimizeVertexOrder] to reorder an indexed primitive's triangles
+/// for the post-transform vertex cache and for overdraw, and its vertices
+/// into first-use order (see [reorderForVertexCache]);
+/// [PackedPrimitive.vertexCache] then
+/// reports the cache efficiency before and after. De-indexed (flat-normal)
+/// primitives have no reuse to exploit and keep their order.
 PackedPrimitive packGltfPrimitive({
   required GltfMeshPrimitive primitive,
   required List<GltfAccessor> accessors,
@@ -113,6 +127,7 @@ PackedPrimitive packGltfPrimitive({
   required Uint8List bufferData,
   required GltfCoordinatePolicy coordinatePolicy,
   bool includeSkinning = true,
+  bool optimizeVertexOrder = false,
 }) {
   // KHR_draco_mesh_compression: decode the payload and swap in synthesized
   // accessor tables, so the packing below reads decoded data unchanged.
@@ -213,17 +228,37 @@ PackedPrimitive packGltfPrimitive({
   final Float32List normals; // output-vertex normals (3 per vertex)
   final Uint32List outIndexList;
   final bool outIndices32Bit;
+  ({VertexCacheStats before, VertexCacheStats after})? vertexCache;
 
   if (primitive.attributes.containsKey('NORMAL')) {
-    normals = _readVec3(
+    final sourceNormals = _readVec3(
       primitive.attributes['NORMAL']!,
       accessors,
       bufferViews,
       bufferData,
     );
-    srcOf = List<int>.generate(vertexCount, (i) => i);
-    outIndexList = indexList;
     outIndices32Bit = indices32Bit;
+    if (optimizeVertexOrder) {
+      final optimized = reorderForVertexCache(
+        indexList,
+        positions,
+        vertexCount,
+      );
+      srcOf = optimized.vertexOrder;
+      normals = Float32List(vertexCount * 3);
+      for (var k = 0; k < vertexCount; k++) {
+        final s = srcOf[k] * 3;
+        normals[k * 3] = sourceNormals[s];
+        normals[k * 3 + 1] = sourceNormals[s + 1];
+        normals[k * 3 + 2] = sourceNormals[s + 2];
+      }
+      outIndexList = optimized.indices;
+      vertexCache = (before: optimized.before, after: optimized.after);
+    } else {
+      normals = sourceNormals;
+      srcOf = List<int>.generate(vertexCount, (i) => i);
+      outIndexList = indexList;
+    }
   } else {
     final triCount = indexList.length ~/ 3;
     final outCount = triCount * 3;
@@ -358,6 +393,7 @@ PackedPrimitive packGltfPrimitive({
       sourceVertexCount: vertexCount,
       coordinatePolicy: coordinatePolicy,
     ),
+    vertexCache: vertexCache,
   );
 }
 
@@ -0,0 +1,354 @@
+/// Import-time reordering of a triangle list for the GPU's post-transform
+/// vertex cache, for overdraw, and for vertex fetch.
+///
+/// [reorderForVertexCache] runs three passes over an indexed triangle list:
+///
+/// 1. Tipsify (Sander et al. 2007) reorders triangles so that vertices are
+///    reused while they are still in a small FIFO cache.
+/// 2. The cache-friendly order is cut into clusters, which are sorted so
+///    that outward-facing clusters come first, front faces drawing before
+///    the faces they occlude.
+/// 3. Vertices are renumbered in first-use order, so vertex fetch walks the
+///    buffer forward.
+///
+/// [analyzeVertexCache] measures an order with a FIFO cache model, so the
+/// gain can be checked without a GPU. Pure Dart (no `dart:ui`/GPU), so it
+/// runs in the build-hook isolate and in the runtime importer's background
+/// isolate.
+library;
+
+import 'dart:math';
+import 'dart:typed_data';
+
+/// The cache size the passes optimize for and [analyzeVertexCache] models
+/// by default. Small enough to stay effective on hardware with larger
+/// caches.
+const int kVertexCacheSize = 16;
+
+/// Post-transform vertex cache efficiency of one triangle order.
+class VertexCacheStats {
+  VertexCacheStats({required this.acmr, required this.atvr});
+
+  /// Average cache miss ratio: vertex shader runs per triangle. Between
+  /// 0.5 (ideal for a large regular grid) and 3 (no reuse at all).
+  final double acmr;
+
+  /// Average transformed vertex ratio: vertex shader runs per referenced
+  /// vertex. 1 means every vertex is transformed once.
+  final double atvr;
+
+  @override
+  String toString() =>
+      'ACMR ${acmr.toStringAsFixed(3)}, ATVR ${atvr.toStringAsFixed(3)}';
+}
+
+/// Simulates a FIFO post-transform cache of [cacheSize] entries over
+/// [indices] (a triangle list over [vertexCount] vertices).
+VertexCacheStats analyzeVertexCache(
+  Uint32List indices,
+  int vertexCount, {
+  int cacheSize = kVertexCacheSize,
+}) {
+  // A vertex is cached while fewer than cacheSize misses happened since
+  // it was last loaded.
+  final loadedAt = Int32List(vertexCount)..fillRange(0, vertexCount, -1);
+  final referenced = Uint8List(vertexCount);
+  var misses = 0;
+  var unique = 0;
+  for (final index in indices) {
+    if (referenced[index] == 0) {
+      referenced[index] = 1;
+      unique++;
+    }
+    final at = loadedAt[index];
+    if (at < 0 || misses - at >= cacheSize) {
+      loadedAt[index] = misses++;
+    }
+  }
+  final triangles = indices.length ~/ 3;
+  return VertexCacheStats(
+    acmr: triangles == 0 ? 0 : misses / triangles,
+    atvr: unique == 0 ? 0 : misses / unique,
+  );
+}
+
+/// The result of [reorderForVertexCache].
+class OptimizedVertexOrder {
+  OptimizedVertexOrder({
+    required this.indices,
+    required this.vertexOrder,
+    required this.before,
+    required this.after,
+  });
+
+  /// The reordered triangle list, in the renumbered vertex space.
+  final Uint32List indices;
+
+  /// For each renumbered vertex, the source vertex it takes. Vertices no
+  /// triangle references follow the referenced ones.
+  final Int32List vertexOrder;
+
+  /// The cache efficiency of the source order.
+  final VertexCacheStats before;
+
+  /// The cache efficiency of [indices].
+  final VertexCacheStats after;
+}
+
+/// Reorders the triangle list [indices] over [vertexCount] vertices whose
+/// positions are [positions] (three floats each); see the library doc.
+///
+/// Each triangle keeps its corner order, so winding is unchanged.
+/// [overdrawThreshold] bounds how much the overdraw pass may worsen the
+/// cache miss ratio (1.05 allows 5%).
+OptimizedVertexOrder reorderForVertexCache(
+  Uint32List indices,
+  Float32List positions,
+  int vertexCount, {
+  double overdrawThreshold = 1.05,
+}) {
+  final before = analyzeVertexCache(indices, vertexCount);
+  var ordered = _tipsify(indices, vertexCount);
+  ordered = _sortClusters(ordered, positions, vertexCount, overdrawThreshold);
+
+  // First-use vertex order.
+  final newIndex = Int32List(vertexCount)..fillRange(0, vertexCount, -1);
+  final vertexOrder = Int32List(vertexCount);
+  var next = 0;
+  for (var i = 0; i < ordered.length; i++) {
+    final old = ordered[i];
+    if (newIndex[old] < 0) {
+      newIndex[old] = next;
+      vertexOrder[next++] = old;
+    }
+    ordered[i] = newIndex[old];
+  }
+  for (var old = 0; old < vertexCount; old++) {
+    if (newIndex[old] < 0) vertexOrder[next++] = old;
+  }
+  return OptimizedVertexOrder(
+    indices: ordered,
+    vertexOrder: vertexOrder,
+    before: before,
+    after: analyzeVertexCache(ordered, vertexCount),
+  );
+}
+
+// Tipsify: fan out from one vertex at a time, emitting all of its
+// remaining triangles, then continue from the emitted vertex that will
+// still be cached when its remaining triangles are emitted, falling back to
+// recently emitted vertices and then to a forward scan.
+Uint32List _tipsify(Uint32List indices, int vertexCount) {
+  final triangleCount = indices.length ~/ 3;
+  // Triangles around each vertex, compressed rows.
+  final start = Int32List(vertexCount + 1);
+  for (final index in indices) {
+    start[index + 1]++;
+  }
+  for (var v = 0; v < vertexCount; v++) {
+    start[v + 1] += start[v];
+  }
+  final live = Int32List(vertexCount);
+  final adjacency = Int32List(triangleCount * 3);
+  for (var i = 0; i < triangleCount * 3; i++) {
+    final v = indices[i];
+    adjacency[start[v] + live[v]++] = i ~/ 3;
+  }
+
+  final cacheTime = Int32List(vertexCount);
+  final emitted = Uint8List(triangleCount);
+  final deadEnd = <int>[];
+  final candidates = <int>[];
+  final out = Uint32List(triangleCount * 3);
+  var written = 0;
+  var time = kVertexCacheSize + 1;
+  var cursor = 0;
+
+  int skipDeadEnd() {
+    while (deadEnd.isNotEmpty) {
+      final v = deadEnd.removeLast();
+      if (live[v] > 0) return v;
+    }
+    while (cursor < vertexCount) {
+      if (live[cursor] > 0) return cursor;
+      cursor++;
+    }
+    return -1;
+  }
+
+  var fan = skipDeadEnd();
+  while (fan >= 0) {
+    candidates.clear();
+    for (var r = start[fan]; r < start[fan + 1]; r++) {
+      final t = adjacency[r];
+      if (emitted[t] != 0) continue;
+      emitted[t] = 1;
+      for (var c = 0; c < 3; c++) {
+        final v = indices[t * 3 + c];
+        out[written++] = v;
+        deadEnd.add(v);
+        candidates.add(v);
+        live[v]--;
+        if (time - cacheTime[v] > kVertexCacheSize) cacheTime[v] = time++;
+      }
+    }
+    // The candidate still in cache after emitting its remaining triangles
+    // (two new vertices each, at worst), preferring the oldest; otherwise a
+    // dead end.
+    var best = -1;
+    var bestPriority = -1;
+    for (final v in candidates) {
+      if (live[v] <= 0) continue;
+      var priority = 0;
+      if (time - cacheTime[v] + 2 * live[v] <= kVertexCacheSize) {
+        priority = time - cacheTime[v];
+      }
+      if (priority > bestPriority) {
+        bestPriority = priority;
+        best = v;
+      }
+    }
+    fan = best >= 0 ? best : skipDeadEnd();
+  }
+  return out;
+}
+
+// Cuts the cache-optimized [indices] into clusters and orders them so that
+// clusters facing away from the mesh center draw first. Hard cuts fall
+// where the cache model shows a full restart (a triangle of three misses);
+// each hard cluster is further cut wherever its running miss ratio is
+// within [threshold] of the whole cluster's, so reordering keeps the cache
+// efficiency within that factor.
+Uint32List _sortClusters(
+  Uint32List indices,
+  Float32List positions,
+  int vertexCount,
+  double threshold,
+) {
+  final triangleCount = indices.length ~/ 3;
+  if (triangleCount < 2) return indices;
+
+  final loadedAt = Int32List(vertexCount);
+  var misses = 0;
+  int missesOf(int t) {
+    var count = 0;
+    for (var c = 0; c < 3; c++) {
+      final v = indices[t * 3 + c];
+      if (misses - loadedAt[v] >= kVertexCacheSize) {
+        loadedAt[v] = misses++;
+        count++;
+      }
+    }
+    return count;
+  }
+
+  void resetCache() {
+    misses += kVertexCacheSize;
+  }
+
+  // Per-triangle misses with the cache as the order leaves it.
+  loadedAt.fillRange(0, vertexCount, -kVertexCacheSize);
+  final triangleMisses = Uint8List(triangleCount);
+  final hard = <int>[0];
+  for (var t = 0; t < triangleCount; t++) {
+    triangleMisses[t] = missesOf(t);
+    if (t > 0 && triangleMisses[t] == 3) hard.add(t);
+  }
+  hard.add(triangleCount);
+
+  final clusters = <int>[];
+  for (var h = 0; h + 1 < hard.length; h++) {
+    final from = hard[h], to = hard[h + 1];
+    var clusterMisses = 0;
+    for (var t = from; t < to; t++) {
+      clusterMisses += triangleMisses[t];
+    }
+    final limit = threshold * clusterMisses / (to - from);
+    // Replay the cluster, cutting where the running ratio is good enough;
+    // each cut starts the model over, as a reordered cluster would.
+    resetCache();
+    clusters.add(from);
+    var runMisses = 0;
+    var runStart = from;
+    for (var t = from; t < to; t++) {
+      runMisses += missesOf(t);
+      if (t + 1 < to && runMisses <= limit * (t + 1 - runStart)) {
+        clusters.add(t + 1);
+        runStart = t + 1;
+        runMisses = 0;
+        resetCache();
+      }
+    }
+  }
+  clusters.add(triangleCount);
+  final clusterCount = clusters.length - 1;
+  if (clusterCount < 2) return indices;
+
+  // The mean vertex position stands in for the mesh center.
+  var cx = 0.0, cy = 0.0, cz = 0.0;
+  for (var v = 0; v < vertexCount; v++) {
+    cx += positions[v * 3];
+    cy += positions[v * 3 + 1];
+    cz += positions[v * 3 + 2];
+  }
+  if (vertexCount > 0) {
+    cx /= vertexCount;
+    cy /= vertexCount;
+    cz /= vertexCount;
+  }
+
+  // Sort key: how far the cluster's area-weighted centroid sits along its
+  // average normal, out from the center.
+  final keys = Float64List(clusterCount);
+  for (var k = 0; k < clusterCount; k++) {
+    var nx = 0.0, ny = 0.0, nz = 0.0;
+    var px = 0.0, py = 0.0, pz = 0.0;
+    var area = 0.0;
+    for (var t = clusters[k]; t < clusters[k + 1]; t++) {
+      final a = indices[t * 3] * 3;
+      final b = indices[t * 3 + 1] * 3;
+      final c = indices[t * 3 + 2] * 3;
+      final e1x = positions[b] - positions[a];
+      final e1y = positions[b + 1] - positions[a + 1];
+      final e1z = positions[b + 2] - positions[a + 2];
+      final e2x = positions[c] - positions[a];
+      final e2y = positions[c + 1] - positions[a + 1];
+      final e2z = positions[c + 2] - positions[a + 2];
+      final tx = e1y * e2z - e1z * e2y;
+      final ty = e1z * e2x - e1x * e2z;
+      final tz = e1x * e2y - e1y * e2x;
+      final twiceArea = sqrt(tx * tx + ty * ty + tz * tz);
+      nx += tx;
+      ny += ty;
+      nz += tz;
+      for (final corner in [a, b, c]) {
+        px += positions[corner] * twiceArea;
+        py += positions[corner + 1] * twiceArea;
+        pz += positions[corner + 2] * twiceArea;
+      }
+      area += twiceArea;
+    }
+    final length = sqrt(nx * nx + ny * ny + nz * nz);
+    if (area == 0 || length == 0) continue;
+    final scale = 1 / (3 * area);
+    keys[k] =
+        ((px * scale - cx) * nx +
+            (py * scale - cy) * ny +
+            (pz * scale - cz) * nz) /
+        length;
+  }
+  final order = List<int>.generate(clusterCount, (k) => k)
+    ..sort((a, b) {
+      final byKey = keys[b].compareTo(keys[a]);
+      return byKey != 0 ? byKey : a - b;
+    });
+
+  final out = Uint32List(indices.length);
+  var written = 0;
+  for (final k in order) {
+    final from = clusters[k] * 3, to = clusters[k + 1] * 3;
+    out.setRange(written, written + to - from, indices, from);
+    written += to - from;
+  }
+  return out;
+}
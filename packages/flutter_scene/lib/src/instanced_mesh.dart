@@ -54,8 +54,41 @@ class InstancedMesh {
   Aabb3? _boundsCache;
   bool _boundsDirty = true;
   int _boundsGeometryVersion = -1;
+  // Moves hulled into [_boundsCache] since it was last computed exactly.
+  int _boundsLooseUpdates = 0;
+  static final Aabb3 _boundsScratch = Aabb3();
   int _revision = 0;
 
+  // Per-instance edits since [_dirtyFromRevision] cover the instances
+  // [_dirtyStart, _dirtyEnd). Edits that change the count, replace every
+  // instance, or flip an instance's winding (which repartitions the packed
+  // groups) set [_fullRevision] instead. A new range starts at the first
+  // edit after a consumer took the previous one.
+  int _fullRevision = 0;
+  int _dirtyFromRevision = 0;
+  int _dirtyStart = 0;
+  int _dirtyEnd = 0;
+  bool _dirtyRangeTaken = true;
+
+  void _markInstanceDirty(int index) {
+    if (_dirtyRangeTaken) {
+      _dirtyFromRevision = _revision;
+      _dirtyStart = index;
+      _dirtyEnd = index + 1;
+      _dirtyRangeTaken = false;
+    } else {
+      if (index < _dirtyStart) _dirtyStart = index;
+      if (index >= _dirtyEnd) _dirtyEnd = index + 1;
+    }
+    _revision++;
+  }
+
+  void _markAllDirty() {
+    _revision++;
+    _fullRevision = _revision;
+    _dirtyRangeTaken = true;
+  }
+
   /// The number of instances.
   int get instanceCount => _instances.length;
 
@@ -69,18 +102,49 @@ class InstancedMesh {
     _windingFlipped.add(transform.determinant() < 0);
     _growAttributeStorage();
     _boundsDirty = true;
-    _revision++;
+    _markAllDirty();
     return _instances.length - 1;
   }
 
   static final Vector4 _white = Vector4(1, 1, 1, 1);
 
   /// Replaces the transform of the instance at [index].
+  ///
+  /// Only this instance's record is repacked and uploaded on the next frame,
+  /// unless the new transform mirrors it (or stops mirroring it), which
+  /// regroups the instances by winding and repacks them all.
   void setInstanceTransform(int index, Matrix4 transform) {
     _instances[index].setFrom(transform);
-    _windingFlipped[index] = transform.determinant() < 0;
-    _boundsDirty = true;
-    _revision++;
+    final flipped = transform.determinant() < 0;
+    _growBounds(transform);
+    if (flipped != _windingFlipped[index]) {
+      _windingFlipped[index] = flipped;
+      _markAllDirty();
+    } else {
+      _markInstanceDirty(index);
+    }
+  }
+
+  // Widens the cached aggregate bounds to cover an instance moved to
+  // [transform]. The bounds only grow this way, so they are recomputed
+  // exactly once the moves since the last exact pass reach the instance
+  // count, which keeps a few moves per frame at constant cost.
+  void _growBounds(Matrix4 transform) {
+    final cache = _boundsCache;
+    final base = geometry.localBounds;
+    if (_boundsDirty ||
+        cache == null ||
+        base == null ||
+        _boundsLooseUpdates >= _instances.length) {
+      _boundsDirty = true;
+      return;
+    }
+    cache.hull(
+      _boundsScratch
+        ..copyFrom(base)
+        ..transform(transform),
+    );
+    _boundsLooseUpdates++;
   }
 
   /// Updates every instance transform in place and invalidates the batch once.
@@ -101,14 +165,14 @@ class InstancedMesh {
         }
       }
       _boundsDirty = true;
-      _revision++;
+      _markAllDirty();
     }
   }
 
   /// Replaces the color multiplier of the instance at [index].
   void setInstanceColor(int index, Vector4 color) {
     _colors[index].setFrom(color);
-    _revision++;
+    _markInstanceDirty(index);
   }
 
   /// Sets one declared per-instance attribute on the instance at [index].
@@ -141,7 +205,7 @@ class InstancedMesh {
           'a ${value.runtimeType}.',
         );
     }
-    _revision++;
+    _markInstanceDirty(index);
   }
 
   /// Writes every declared per-instance attribute of the instance at [index]
@@ -162,7 +226,7 @@ class InstancedMesh {
       );
     }
     _attributeData.setAll(index * schema.floatCount, packed);
-    _revision++;
+    _markInstanceDirty(index);
   }
 
   /// Removes the instance at [index]. Instances after it shift down by
@@ -187,7 +251,7 @@ class InstancedMesh {
     _colors.removeAt(index);
     _windingFlipped.removeAt(index);
     _boundsDirty = true;
-    _revision++;
+    _markAllDirty();
   }
 
   /// Removes every instance.
@@ -198,7 +262,7 @@ class InstancedMesh {
     _attributeUsed = 0;
     _attributeView = null;
     _boundsDirty = true;
-    _revision++;
+    _markAllDirty();
   }
 
   static final Float32List _noAttributes = Float32List(0);
@@ -296,15 +360,33 @@ class InstancedMesh {
   @internal
   int get revision => _revision;
 
+  /// The instances changed since [revision] was read, as one index range
+  /// (empty when nothing changed), or null when the change was not a
+  /// per-instance edit or predates the range still tracked; the caller then
+  /// repacks every instance.
+  ///
+  /// The range is kept until the first edit after it was taken, so a second
+  /// consumer that falls behind gets null rather than a partial range.
+  @internal
+  ({int start, int end})? dirtyRangeSince(int revision) {
+    if (revision == _revision) return (start: 0, end: 0);
+    if (revision < _fullRevision || revision < _dirtyFromRevision) return null;
+    _dirtyRangeTaken = true;
+    return (start: _dirtyStart, end: _dirtyEnd);
+  }
+
   /// Aggregate AABB over every instance, in the instanced mesh's local
   /// space, or `null` when [geometry] has no computable bounds or there
-  /// are no instances. Cached; recomputed after any instance change.
+  /// are no instances. Cached; recomputed after any instance change, except
+  /// that a moved instance only widens it until the moves add up to the
+  /// instance count.
   @internal
   Aabb3? get aggregateBounds {
     final geometryVersion = geometry.localBoundsVersion;
     if (_boundsDirty || _boundsGeometryVersion != geometryVersion) {
       _boundsCache = _computeAggregateBounds();
       _boundsDirty = false;
+      _boundsLooseUpdates = 0;
       _boundsGeometryVersion = geometryVersion;
     }
     return _boundsCache;
@@ -808,6 +808,7 @@ class Lighting {
     this.punctualParamsCount = 0,
     this.punctualIndexWidth = 0,
     this.punctualIndexHeight = 0,
+    this.punctualClusterHeader = 0,
     this.spotShadowCount = 0,
     this.spotShadowDepthBias = 0.0,
     this.spotShadowNormalBias = 0.0,
@@ -895,6 +896,11 @@ class Lighting {
   final int punctualIndexWidth;
   final int punctualIndexHeight;
 
+  /// One past the texel of [punctualIndexTexture] where the view's froxel
+  /// light grid starts, or `0` without one. Items with the light-list count
+  /// -1 read their lights from the grid cell under each fragment.
+  final int punctualClusterHeader;
+
   /// Number of shadow-casting spots this frame; their tiles follow the
   /// directional cascades in [shadowMap] and their matrices ride in
   /// [punctualParamsTexture]. Zero disables spot shadow sampling.
@@ -176,14 +176,17 @@ class EngineLightingUniforms {
     fragInfo[165] = lighting.ssaoMultiBounce.clamp(0.0, 1.0);
     fragInfo[166] = lighting.ssaoBentNormals ? 1.0 : 0.0;
     fragInfo[167] = lighting.ssaoContactShadows ? 1.0 : 0.0;
-    // punctual_dims [8..10] (the first unused diffuse-SH vec4 slot): the
+    // punctual_dims [8..11] (the first unused diffuse-SH vec4 slot): the
     // dimensions the shader needs to normalize its punctual-light fetches.
     // x: parameters-texture row count (all scene lights). y/z: the light-index
-    // texture width/height. These are frame-constant. The per-object slice
-    // (radiance_blend.z count, .w offset) is written per draw by the material.
+    // texture width/height. w: one past the froxel grid header texel (0 when
+    // lights are assigned per item). These are frame-constant. The per-object
+    // slice (radiance_blend.z count, .w offset) is written per draw by the
+    // material; count -1 reads the froxel grid instead.
     fragInfo[8] = lighting.punctualParamsCount.toDouble();
     fragInfo[9] = lighting.punctualIndexWidth.toDouble();
     fragInfo[10] = lighting.punctualIndexHeight.toDouble();
+    fragInfo[11] = lighting.punctualClusterHeader.toDouble();
     // spot_shadow_params [12..15] (more of the unused SH region): the shared
     // spot-shadow parameters. count 0 disables spot shadow sampling; the shader
     // also uses count to size the shared shadow atlas (cascades + spot tiles).
@@ -14,12 +14,18 @@ import 'package:flutter_scene/src/runtime_importer/runtime_importer.dart';
 import 'package:flutter_scene/src/scene.dart';
 import 'package:flutter_scene/src/animation.dart';
 import 'package:flutter_scene/src/mesh.dart';
+import 'package:flutter_scene/src/occlusion_culling.dart';
+import 'package:flutter_scene/src/render/frame_tracer.dart';
 import 'package:flutter_scene/src/render/render_layers.dart';
 import 'package:flutter_scene/src/render/render_scene.dart';
 import 'package:flutter_scene/src/skin.dart';
 import 'package:vector_math/vector_math.dart';
 import 'package:vector_math/vector_math.dart' as vm;
 
+// Scratch for the world position animation level of detail measures, so
+// the pre-pass allocates nothing per player.
+final Vector3 _lodCenter = Vector3.zero();
+
 void _visitMutable<T>(List<T> items, void Function(T item) visit) {
   HashSet<T>? visited;
   var index = 0;
@@ -113,6 +119,13 @@ base class Node implements SceneGraph {
   /// this flag.
   bool frustumCulled = true;
 
+  /// Low-poly geometry, in this node's local space, that hides whatever is
+  /// behind it. Used by `Scene.occlusionCulling` to skip drawing meshes
+  /// this node's mesh covers; `null` (the default) occludes nothing. The
+  /// occluder must lie inside this node's own mesh, and is only used while
+  /// the node has a mesh and is visible. Not inherited by children.
+  Occluder? occluder;
+
   /// The render layers this node occupies, a 32-bit bitmask. A
   /// [RenderView] renders this node's mesh only when its
   /// [RenderView.layerMask] intersects these layers
@@ -223,6 +236,18 @@ base class Node implements SceneGraph {
     markTransformDirty();
   }
 
+  /// Points [localTransform] at [matrix] and its decomposition at [trs],
+  /// without copying either.
+  ///
+  /// The animation player owns both and recomposes [matrix] from [trs] in
+  /// place each frame, so a steady pose allocates nothing.
+  @internal
+  void adoptLocalTransformTrs(DecomposedTransform trs, Matrix4 matrix) {
+    _localTransform = matrix;
+    _localTransformTrs = trs;
+    markTransformDirty();
+  }
+
   /// This node's position relative to its parent.
   ///
   /// The getter returns a copy, so editing it does not move the node, and
@@ -1035,6 +1060,12 @@ base class Node implements SceneGraph {
 
   AnimationPlayer? _animationPlayer;
 
+  /// The player blending this node's clips, created by the first
+  /// [createAnimationClip]; `null` until then. Set its
+  /// [AnimationPlayer.lodPolicy] to evaluate a small or off-screen
+  /// character less often.
+  AnimationPlayer? get animationPlayer => _animationPlayer;
+
   /// Searches this node's descendants for the first child whose [Node.name]
   /// matches [name].
   ///
@@ -1094,7 +1125,9 @@ base class Node implements SceneGraph {
   /// as user-uploaded models, network-loaded assets, or model editors.
   /// [onWarning], when given, receives non-fatal import issues (an
   /// unrecognized extension, an image that fell back to a placeholder);
-  /// without it they print instead.
+  /// without it they print instead. Set [optimizeVertexOrder] to reorder
+  /// the geometry for the GPU vertex cache, overdraw, and vertex fetch while
+  /// it is packed, at some extra load time.
   ///
   /// Example:
   /// ```dart
@@ -1104,14 +1137,20 @@ base class Node implements SceneGraph {
   static Future<Node> fromGlbBytes(
     Uint8List bytes, {
     GltfWarningCallback? onWarning,
+    bool optimizeVertexOrder = false,
   }) {
-    return importGlb(bytes, onWarning: onWarning);
+    return importGlb(
+      bytes,
+      onWarning: onWarning,
+      optimizeVertexOrder: optimizeVertexOrder,
+    );
   }
 
   /// Convenience wrapper for [fromGlbBytes] that loads from the asset bundle.
   static Future<Node> fromGlbAsset(
     String assetPath, {
     GltfWarningCallback? onWarning,
+    bool optimizeVertexOrder = false,
   }) async {
     final byteData = await rootBundle.load(assetPath);
     return importGlb(
@@ -1120,6 +1159,7 @@ base class Node implements SceneGraph {
         byteData.lengthInBytes,
       ),
       onWarning: onWarning,
+      optimizeVertexOrder: optimizeVertexOrder,
     );
   }
 
@@ -1149,8 +1189,14 @@ base class Node implements SceneGraph {
     Uint8List gltfJson, {
     required GltfResourceResolver resolveUri,
     GltfWarningCallback? onWarning,
+    bool optimizeVertexOrder = false,
   }) {
-    return importGltf(gltfJson, resolveUri: resolveUri, onWarning: onWarning);
+    return importGltf(
+      gltfJson,
+      resolveUri: resolveUri,
+      onWarning: onWarning,
+      optimizeVertexOrder: optimizeVertexOrder,
+    );
   }
 
   /// This list allows the node to act as a parent in the scene graph hierarchy. Transformations
@@ -1484,18 +1530,55 @@ base class Node implements SceneGraph {
   /// visible, and defaults to `true` for the root.
   void scenePrePass(double deltaSeconds, [bool ancestorsVisible = true]) {
     _effectiveVisible = ancestorsVisible && visible;
+    final tracer = FrameTracer.active;
 
     // Components tick whenever the node is mounted, independent of visibility.
-    _visitMutable(_components, (component) => component.tick(deltaSeconds));
+    if (tracer == null) {
+      _visitMutable(_components, (component) => component.tick(deltaSeconds));
+    } else {
+      _visitMutable(_components, (component) {
+        tracer.begin('${component.runtimeType}.tick', category: 'component');
+        try {
+          component.tick(deltaSeconds);
+        } finally {
+          tracer.end();
+        }
+      });
+    }
 
     if (_effectiveVisible) {
-      _animationPlayer?.update(deltaSeconds);
+      final animationPlayer = _animationPlayer;
+      if (animationPlayer != null) {
+        tracer?.begin('animation', args: {'node': name});
+        final lodPolicy = animationPlayer.lodPolicy;
+        final renderScene = _renderScene;
+        if (lodPolicy == null || renderScene == null) {
+          animationPlayer.update(deltaSeconds);
+        } else {
+          final world = globalTransform.storage;
+          animationPlayer.update(
+            deltaSeconds,
+            screenSize: lodPolicy.measure(
+              _lodCenter..setValues(world[12], world[13], world[14]),
+              renderScene.lodViews,
+            ),
+          );
+          renderScene.skippedAnimationEvaluations +=
+              animationPlayer.skippedEvaluations;
+        }
+        tracer?.end();
+      }
+      final refreshes =
+          tracer != null &&
+          (_meshComponents.isNotEmpty || _instancedMeshComponents.isNotEmpty);
+      if (refreshes) tracer.begin('transforms', args: {'node': name});
       for (final meshComponent in _meshComponents) {
         meshComponent.refreshRenderItems();
       }
       for (final instancedMeshComponent in _instancedMeshComponents) {
         instancedMeshComponent.refreshRenderItem();
       }
+      if (refreshes) tracer.end();
     } else {
       // Keep a hidden subtree's items out of the render passes.
       for (final meshComponent in _meshComponents) {
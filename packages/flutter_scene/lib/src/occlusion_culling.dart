@@ -0,0 +1,135 @@
+import 'dart:typed_data';
+
+import 'package:flutter/foundation.dart' show internal;
+import 'package:vector_math/vector_math.dart';
+
+/// Low-poly stand-in geometry that hides what is behind it, for CPU
+/// occlusion culling.
+///
+/// Set one on a node (`Node.occluder`) whose mesh is large and opaque, such
+/// as a wall, floor slab, or building shell. The triangles must lie inside
+/// the visible mesh: anything the occluder covers is assumed hidden, so an
+/// occluder that pokes out past its mesh wrongly culls what is behind the
+/// gap. Keep them to a handful of triangles; they are rasterized on the CPU
+/// every frame.
+/// {@category Rendering}
+class Occluder {
+  /// An occluder from local-space [positions] (xyz triples) and triangle
+  /// [indices] into them.
+  Occluder({required this.positions, required this.indices})
+    : assert(positions.length % 3 == 0),
+      assert(indices.length % 3 == 0);
+
+  /// An occluder filling [box], for meshes that fill their own bounds
+  /// (solid blocks, wall segments).
+  factory Occluder.box(Aabb3 box) {
+    final min = box.min;
+    final max = box.max;
+    final positions = Float32List(24);
+    for (var corner = 0; corner < 8; corner++) {
+      positions[corner * 3] = corner & 1 != 0 ? max.x : min.x;
+      positions[corner * 3 + 1] = corner & 2 != 0 ? max.y : min.y;
+      positions[corner * 3 + 2] = corner & 4 != 0 ? max.z : min.z;
+    }
+    return Occluder(positions: positions, indices: _boxIndices);
+  }
+
+  // Two triangles per face of the corner numbering in [Occluder.box],
+  // wound counter-clockwise seen from outside. Consistent winding keeps
+  // each face's diagonal an interior edge for the rasterizer.
+  static final Uint16List _boxIndices = Uint16List.fromList(const [
+    0, 2, 3, 0, 3, 1, // -z
+    4, 5, 7, 4, 7, 6, // +z
+    0, 1, 5, 0, 5, 4, // -y
+    2, 6, 7, 2, 7, 3, // +y
+    0, 4, 6, 0, 6, 2, // -x
+    1, 3, 7, 1, 7, 5, // +x
+  ]);
+
+  /// Local-space vertex positions, three floats per vertex.
+  final Float32List positions;
+
+  /// Triangle list indices into [positions], three per triangle.
+  final List<int> indices;
+
+  /// The number of triangles.
+  int get triangleCount => indices.length ~/ 3;
+
+  /// For each triangle edge (`triangle * 3 + edge`, edge `e` running from
+  /// corner `e` to corner `(e + 1) % 3`), the triangle sharing it, or `-1`
+  /// for a boundary or non-manifold edge. Vertices at equal positions are
+  /// welded first, so split normals do not open seams. Built on first use.
+  @internal
+  Int32List get edgeNeighbors => _edgeNeighbors ??= _buildEdgeNeighbors();
+  Int32List? _edgeNeighbors;
+
+  Int32List _buildEdgeNeighbors() {
+    final welded = <(double, double, double), int>{};
+    final vertexIds = Int32List(positions.length ~/ 3);
+    for (var v = 0; v < vertexIds.length; v++) {
+      final key = (
+        positions[v * 3],
+        positions[v * 3 + 1],
+        positions[v * 3 + 2],
+      );
+      vertexIds[v] = welded.putIfAbsent(key, () => welded.length);
+    }
+    final vertexCount = welded.length;
+    final edgeKeys = List<int>.filled(indices.length, -1);
+    final edgeCounts = <int, int>{};
+    for (var slot = 0; slot < indices.length; slot++) {
+      final a = vertexIds[indices[slot]];
+      final b = vertexIds[indices[slot - slot % 3 + (slot + 1) % 3]];
+      final key = a == b
+          ? -1
+          : a < b
+          ? a * vertexCount + b
+          : b * vertexCount + a;
+      edgeKeys[slot] = key;
+      if (key >= 0) edgeCounts[key] = (edgeCounts[key] ?? 0) + 1;
+    }
+    final neighbors = Int32List(indices.length)
+      ..fillRange(0, indices.length, -1);
+    final firstSlot = <int, int>{};
+    for (var slot = 0; slot < indices.length; slot++) {
+      final key = edgeKeys[slot];
+      // Only manifold edges (exactly two triangles) are interior.
+      if (key < 0 || edgeCounts[key] != 2) continue;
+      final other = firstSlot.remove(key);
+      if (other == null) {
+        firstSlot[key] = slot;
+      } else {
+        neighbors[other] = slot ~/ 3;
+        neighbors[slot] = other ~/ 3;
+      }
+    }
+    return neighbors;
+  }
+}
+
+/// CPU occlusion culling for a `Scene`'s main view.
+///
+/// Each frame the largest on-screen [Occluder]s are rasterized into a small
+/// CPU depth buffer, and every render item whose screen-space bounds are
+/// fully behind that depth is dropped before it is encoded. Depth is
+/// conservative and coverage stops short of each occluder's outline, so an
+/// item seen past an occluder is kept. The cost is a little CPU time per
+/// frame, which pays off in interiors and dense cities where walls hide
+/// most of the scene. Off by default. Items are only rejected by occluders
+/// the app authors (see `Node.occluder`).
+///
+/// See `Scene.occlusionCulling` and `Scene.occlusionCulledCount`.
+/// {@category Rendering}
+class OcclusionCullingSettings {
+  /// Whether the occlusion stage runs. Off by default.
+  bool enabled = false;
+
+  /// Width of the CPU depth buffer in pixels; the height follows the view's
+  /// aspect ratio. Clamped to `16..1024`. Higher resolutions cull thin gaps
+  /// more tightly at a linear cost per occluder pixel.
+  int resolution = 256;
+
+  /// The most occluders rasterized per frame, picked by projected size of
+  /// their render item's world bounds.
+  int occluderBudget = 32;
+}
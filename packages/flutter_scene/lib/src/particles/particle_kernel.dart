@@ -0,0 +1,377 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'package:flutter_scene/src/particles/distribution.dart';
+import 'package:flutter_scene/src/particles/particle_module.dart';
+import 'package:flutter_scene/src/particles/particle_storage.dart';
+
+// Lane groups (four particles each) per block. A block's columns stay in
+// cache while every fused module runs over it.
+const int _kBlockGroups = 64;
+
+// Same as FlipbookModule's start-frame salt.
+const int _saltFlipbookStart = 10;
+
+/// A particle system's per-step update, its module chain followed by the
+/// gravity integration, compiled into fused passes over the storage
+/// columns.
+///
+/// Consecutive built-in modules ([AccelerationModule], [LinearDragModule],
+/// [RotationModule], [SizeOverLifeModule], [ColorOverLifeModule], and
+/// [FlipbookModule]) fuse with each other and with the integration: each
+/// block of 256 particles runs through all of them in turn while its
+/// columns are in cache, four particles at a time in `Float32x4` lanes.
+/// Curve and gradient samples and flipbook frames stay scalar per particle
+/// within the block, since a table lookup has no lane form. Any other
+/// module (a subclass, a custom module, or [TurbulenceModule], whose noise
+/// is scalar) runs its own [ParticleModule.update] between the fused runs,
+/// in chain order.
+///
+/// Lane arithmetic is single precision where the module loops compute in
+/// double and round on store, so the result matches the per-module path to
+/// float rounding rather than bit for bit.
+class ParticleKernel {
+  /// Compiles [modules] (in order) over [storage].
+  ParticleKernel(List<ParticleModule> modules, this.storage)
+    : _segments = _compile(modules);
+
+  /// The storage the kernel updates.
+  final ParticleStorage storage;
+
+  final List<_Segment> _segments;
+
+  /// Whether [module] fuses into the kernel's passes rather than running
+  /// its own loop.
+  static bool fuses(ParticleModule module) =>
+      _fusedTypes.contains(module.runtimeType);
+
+  static const Set<Type> _fusedTypes = {
+    AccelerationModule,
+    LinearDragModule,
+    RotationModule,
+    SizeOverLifeModule,
+    ColorOverLifeModule,
+    FlipbookModule,
+  };
+
+  static List<_Segment> _compile(List<ParticleModule> modules) {
+    final segments = <_Segment>[];
+    var run = <_Op>[];
+    for (final module in modules) {
+      final op = !fuses(module)
+          ? null
+          : switch (module) {
+              AccelerationModule() => _Accelerate(module),
+              LinearDragModule() => _Drag(module),
+              RotationModule() => _Rotate(),
+              SizeOverLifeModule() => _SizeOverLife(module),
+              ColorOverLifeModule() => _ColorOverLife(module),
+              FlipbookModule() => _Flipbook(module),
+              _ => null,
+            };
+      if (op != null) {
+        run.add(op);
+        continue;
+      }
+      if (run.isNotEmpty) segments.add(_Segment.fused(run));
+      run = <_Op>[];
+      segments.add(_Segment.module(module));
+    }
+    segments.add(_Segment.fused([...run, _Integrate()]));
+    return segments;
+  }
+
+  /// Runs the module chain over every live particle, then adds
+  /// `gravity * dt` to each velocity and `velocity * dt` to each position
+  /// (semi-implicit Euler, as the per-module path does). Aging and reaping
+  /// are left to the caller.
+  void update(double dt, Vector3 gravity) {
+    // Views are rebuilt per step (cheap) rather than held, so a system
+    // copied to another isolate keeps no views of its old columns.
+    final lanes = _Lanes(storage);
+    final count = storage.aliveCount;
+    final groups = (count + 3) >> 2;
+    for (final segment in _segments) {
+      final module = segment.module;
+      if (module != null) {
+        module.update(storage, dt);
+        continue;
+      }
+      final ops = segment.ops;
+      for (final op in ops) {
+        op.prepare(dt, gravity);
+      }
+      for (var start = 0; start < groups; start += _kBlockGroups) {
+        final end = math.min(start + _kBlockGroups, groups);
+        for (final op in ops) {
+          op.run(lanes, start, end, count);
+        }
+      }
+    }
+  }
+}
+
+class _Segment {
+  _Segment.fused(this.ops) : module = null;
+  _Segment.module(ParticleModule this.module) : ops = const [];
+
+  final List<_Op> ops;
+  final ParticleModule? module;
+}
+
+// The storage columns as Float32x4 lanes, plus the columns themselves for
+// the scalar ops.
+class _Lanes {
+  _Lanes(this.storage)
+    : posX = _view(storage.posX),
+      posY = _view(storage.posY),
+      posZ = _view(storage.posZ),
+      velX = _view(storage.velX),
+      velY = _view(storage.velY),
+      velZ = _view(storage.velZ),
+      rotation = _view(storage.rotation),
+      angularVelocity = _view(storage.angularVelocity),
+      size = _view(storage.size),
+      baseSize = _view(storage.baseSize),
+      colorR = _view(storage.colorR),
+      colorG = _view(storage.colorG),
+      colorB = _view(storage.colorB),
+      colorA = _view(storage.colorA),
+      random01 = _view(storage.random01);
+
+  final ParticleStorage storage;
+  final Float32x4List posX, posY, posZ, velX, velY, velZ;
+  final Float32x4List rotation, angularVelocity, size, baseSize;
+  final Float32x4List colorR, colorG, colorB, colorA, random01;
+
+  static Float32x4List _view(Float32List column) => Float32x4List.view(
+    column.buffer,
+    column.offsetInBytes,
+    column.length >> 2,
+  );
+}
+
+// One fused step of the chain. [prepare] reads the module's parameters
+// once per step; [run] applies it to lane groups [start, end) of a block
+// (whose last group may run past the [count] live particles).
+sealed class _Op {
+  const _Op();
+
+  void prepare(double dt, Vector3 gravity) {}
+
+  void run(_Lanes lanes, int start, int end, int count);
+}
+
+class _Accelerate extends _Op {
+  _Accelerate(this.module);
+
+  final AccelerationModule module;
+  Float32x4 _x = Float32x4.zero(), _y = Float32x4.zero();
+  Float32x4 _z = Float32x4.zero();
+
+  @override
+  void prepare(double dt, Vector3 gravity) {
+    final a = module.acceleration;
+    _x = Float32x4.splat(a.x * dt);
+    _y = Float32x4.splat(a.y * dt);
+    _z = Float32x4.splat(a.z * dt);
+  }
+
+  @override
+  void run(_Lanes lanes, int start, int end, int count) {
+    final vx = lanes.velX, vy = lanes.velY, vz = lanes.velZ;
+    final x = _x, y = _y, z = _z;
+    for (var g = start; g < end; g++) {
+      vx[g] += x;
+      vy[g] += y;
+      vz[g] += z;
+    }
+  }
+}
+
+class _Drag extends _Op {
+  _Drag(this.module);
+
+  final LinearDragModule module;
+  Float32x4 _factor = Float32x4.zero();
+
+  @override
+  void prepare(double dt, Vector3 gravity) {
+    _factor = Float32x4.splat(math.max(0.0, 1.0 - module.coefficient * dt));
+  }
+
+  @override
+  void run(_Lanes lanes, int start, int end, int count) {
+    final vx = lanes.velX, vy = lanes.velY, vz = lanes.velZ;
+    final factor = _factor;
+    for (var g = start; g < end; g++) {
+      vx[g] *= factor;
+      vy[g] *= factor;
+      vz[g] *= factor;
+    }
+  }
+}
+
+class _Rotate extends _Op {
+  Float32x4 _dt = Float32x4.zero();
+
+  @override
+  void prepare(double dt, Vector3 gravity) {
+    _dt = Float32x4.splat(dt);
+  }
+
+  @override
+  void run(_Lanes lanes, int start, int end, int count) {
+    final rotation = lanes.rotation, angular = lanes.angularVelocity;
+    final dt = _dt;
+    for (var g = start; g < end; g++) {
+      rotation[g] += angular[g] * dt;
+    }
+  }
+}
+
+class _SizeOverLife extends _Op {
+  _SizeOverLife(this.module);
+
+  final SizeOverLifeModule module;
+
+  @override
+  void run(_Lanes lanes, int start, int end, int count) {
+    final size = lanes.size, base = lanes.baseSize;
+    switch (module.scale) {
+      case ConstantFloat(:final value):
+        final scale = Float32x4.splat(value);
+        for (var g = start; g < end; g++) {
+          size[g] = base[g] * scale;
+        }
+      case UniformFloat(:final min, :final max):
+        final lo = Float32x4.splat(min), span = Float32x4.splat(max - min);
+        final random = lanes.random01;
+        for (var g = start; g < end; g++) {
+          size[g] = base[g] * (lo + span * random[g]);
+        }
+      case final scale:
+        final s = lanes.storage;
+        final last = math.min(end * 4, count);
+        for (var i = start * 4; i < last; i++) {
+          final life = s.lifetime[i];
+          final nAge = life > 0.0 ? s.age[i] / life : 0.0;
+          s.size[i] = s.baseSize[i] * scale.sample(nAge, s.random01[i]);
+        }
+    }
+  }
+}
+
+class _ColorOverLife extends _Op {
+  _ColorOverLife(this.module);
+
+  final ColorOverLifeModule module;
+  final Vector4 _tmp = Vector4.zero();
+
+  @override
+  void run(_Lanes lanes, int start, int end, int count) {
+    final r = lanes.colorR, g = lanes.colorG;
+    final b = lanes.colorB, a = lanes.colorA;
+    switch (module.color) {
+      case ConstantColor(:final color):
+        final cr = Float32x4.splat(color.x), cg = Float32x4.splat(color.y);
+        final cb = Float32x4.splat(color.z), ca = Float32x4.splat(color.w);
+        for (var k = start; k < end; k++) {
+          r[k] = cr;
+          g[k] = cg;
+          b[k] = cb;
+          a[k] = ca;
+        }
+      case UniformColor(a: final from, b: final to):
+        final fr = Float32x4.splat(from.x), fg = Float32x4.splat(from.y);
+        final fb = Float32x4.splat(from.z), fa = Float32x4.splat(from.w);
+        final dr = Float32x4.splat(to.x - from.x);
+        final dg = Float32x4.splat(to.y - from.y);
+        final db = Float32x4.splat(to.z - from.z);
+        final da = Float32x4.splat(to.w - from.w);
+        final random = lanes.random01;
+        for (var k = start; k < end; k++) {
+          final t = random[k];
+          r[k] = fr + dr * t;
+          g[k] = fg + dg * t;
+          b[k] = fb + db * t;
+          a[k] = fa + da * t;
+        }
+      case final color:
+        final s = lanes.storage;
+        final tmp = _tmp;
+        final last = math.min(end * 4, count);
+        for (var i = start * 4; i < last; i++) {
+          final life = s.lifetime[i];
+          final nAge = life > 0.0 ? s.age[i] / life : 0.0;
+          color.sample(nAge, s.random01[i], tmp);
+          s.colorR[i] = tmp.x;
+          s.colorG[i] = tmp.y;
+          s.colorB[i] = tmp.z;
+          s.colorA[i] = tmp.w;
+        }
+    }
+  }
+}
+
+class _Flipbook extends _Op {
+  _Flipbook(this.module);
+
+  final FlipbookModule module;
+
+  // FlipbookModule.update, per particle, over the block's live particles.
+  @override
+  void run(_Lanes lanes, int start, int end, int count) {
+    final s = lanes.storage;
+    final frames = module.frameCount.toDouble();
+    final fps = module.framesPerSecond;
+    final last = math.min(end * 4, count);
+    for (var i = start * 4; i < last; i++) {
+      var frame = 0.0;
+      if (fps == null) {
+        final life = s.lifetime[i];
+        final nAge = life > 0.0 ? s.age[i] / life : 0.0;
+        frame = nAge * frames;
+        if (frame > frames - 1.0) frame = frames - 1.0;
+      } else {
+        frame = s.age[i] * fps;
+      }
+      if (module.randomStartFrame) {
+        frame += s.randomFor(i, _saltFlipbookStart) * frames;
+      }
+      s.frame[i] = frame % frames;
+    }
+  }
+}
+
+class _Integrate extends _Op {
+  Float32x4 _dt = Float32x4.zero();
+  Float32x4 _gx = Float32x4.zero(), _gy = Float32x4.zero();
+  Float32x4 _gz = Float32x4.zero();
+
+  @override
+  void prepare(double dt, Vector3 gravity) {
+    _dt = Float32x4.splat(dt);
+    _gx = Float32x4.splat(gravity.x * dt);
+    _gy = Float32x4.splat(gravity.y * dt);
+    _gz = Float32x4.splat(gravity.z * dt);
+  }
+
+  @override
+  void run(_Lanes lanes, int start, int end, int count) {
+    final px = lanes.posX, py = lanes.posY, pz = lanes.posZ;
+    final vx = lanes.velX, vy = lanes.velY, vz = lanes.velZ;
+    final dt = _dt, gx = _gx, gy = _gy, gz = _gz;
+    for (var g = start; g < end; g++) {
+      final x = vx[g] + gx, y = vy[g] + gy, z = vz[g] + gz;
+      vx[g] = x;
+      vy[g] = y;
+      vz[g] = z;
+      px[g] += x * dt;
+      py[g] += y * dt;
+      pz[g] += z * dt;
+    }
+  }
+}
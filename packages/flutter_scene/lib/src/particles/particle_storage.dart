@@ -16,36 +16,46 @@ import 'dart:typed_data';
 /// Color is stored as four floats per particle (matching the billboard
 /// instance buffer's `float32x4` color attribute and the over-life color
 /// math). A packed RGBA8 column is a later memory optimization.
+///
+/// Each column is padded to [paddedCapacity], a multiple of four, so the
+/// fused kernels (`ParticleKernel`) sweep it in whole `Float32x4` lanes.
+/// Slots past [aliveCount] hold stale values.
 /// {@category Particles}
 class ParticleStorage {
   /// Allocates storage for up to [capacity] simultaneous particles.
-  ParticleStorage(this.capacity)
+  ParticleStorage(int capacity) : this._(capacity, (capacity + 3) & ~3);
+
+  ParticleStorage._(this.capacity, this.paddedCapacity)
     : assert(capacity > 0),
-      posX = Float32List(capacity),
-      posY = Float32List(capacity),
-      posZ = Float32List(capacity),
-      velX = Float32List(capacity),
-      velY = Float32List(capacity),
-      velZ = Float32List(capacity),
-      age = Float32List(capacity),
-      lifetime = Float32List(capacity),
-      rotation = Float32List(capacity),
-      angularVelocity = Float32List(capacity),
-      size = Float32List(capacity),
-      baseSize = Float32List(capacity),
-      colorR = Float32List(capacity),
-      colorG = Float32List(capacity),
-      colorB = Float32List(capacity),
-      colorA = Float32List(capacity),
-      frame = Float32List(capacity),
-      axisX = Float32List(capacity),
-      axisY = Float32List(capacity),
-      axisZ = Float32List(capacity),
-      random01 = Float32List(capacity);
+      posX = Float32List(paddedCapacity),
+      posY = Float32List(paddedCapacity),
+      posZ = Float32List(paddedCapacity),
+      velX = Float32List(paddedCapacity),
+      velY = Float32List(paddedCapacity),
+      velZ = Float32List(paddedCapacity),
+      age = Float32List(paddedCapacity),
+      lifetime = Float32List(paddedCapacity),
+      rotation = Float32List(paddedCapacity),
+      angularVelocity = Float32List(paddedCapacity),
+      size = Float32List(paddedCapacity),
+      baseSize = Float32List(paddedCapacity),
+      colorR = Float32List(paddedCapacity),
+      colorG = Float32List(paddedCapacity),
+      colorB = Float32List(paddedCapacity),
+      colorA = Float32List(paddedCapacity),
+      frame = Float32List(paddedCapacity),
+      axisX = Float32List(paddedCapacity),
+      axisY = Float32List(paddedCapacity),
+      axisZ = Float32List(paddedCapacity),
+      random01 = Float32List(paddedCapacity);
 
   /// The maximum number of simultaneous particles.
   final int capacity;
 
+  /// The length of every column, [capacity] rounded up to a multiple of
+  /// four.
+  final int paddedCapacity;
+
   /// World-space position (in the emitter node's local space).
   final Float32List posX, posY, posZ;
 
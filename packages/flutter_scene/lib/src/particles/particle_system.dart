@@ -1,9 +1,11 @@
 import 'dart:math' as math;
 
+import 'package:flutter/foundation.dart' show internal;
 import 'package:vector_math/vector_math.dart';
 
 import 'package:flutter_scene/src/particles/distribution.dart';
 import 'package:flutter_scene/src/particles/emitter_shape.dart';
+import 'package:flutter_scene/src/particles/particle_kernel.dart';
 import 'package:flutter_scene/src/particles/particle_module.dart';
 import 'package:flutter_scene/src/particles/particle_storage.dart';
 import 'package:flutter_scene/src/particles/spawner.dart';
@@ -37,6 +39,10 @@ const double _minLifetime = 1e-4;
 /// (already-live particles still finish their lives). All randomness derives
 /// from [seed], so a given seed and step sequence reproduce exactly (the basis
 /// for byte-for-byte tests and editor scrubbing).
+///
+/// Each step runs the module stack and the integration as fused passes
+/// over the columns (see `ParticleKernel`); set [fusedKernels] to false for
+/// the reference path, one loop per module.
 /// {@category Particles}
 class ParticleSystem {
   /// Creates a particle system. The distributions, shape, spawner, gravity,
@@ -63,6 +69,7 @@ class ParticleSystem {
     this.maxFrameTime = 0.25,
     this.seed = 0,
     this.prewarm = 0.0,
+    this.fusedKernels = true,
   }) : assert(maxParticles > 0),
        assert(duration > 0),
        assert(fixedStep > 0),
@@ -127,6 +134,13 @@ class ParticleSystem {
   /// The seed for all spawn randomness.
   final int seed;
 
+  /// Whether [step] runs the fused `ParticleKernel` passes rather than one
+  /// loop per module. Both reproduce exactly for a given seed; they differ
+  /// from each other by float rounding.
+  bool fusedKernels;
+
+  late final ParticleKernel _kernel = ParticleKernel(modules, storage);
+
   math.Random _random;
   double _accumulator = 0.0;
   double _systemTime = 0.0;
@@ -135,6 +149,12 @@ class ParticleSystem {
   /// Seconds the system has been running (advances by whole fixed steps).
   double get time => _systemTime;
 
+  /// How many times [reset] has run, so a copy of the system (a particle
+  /// worker's) can replay the resets made to this one.
+  @internal
+  int get resetCount => _resetCount;
+  int _resetCount = 0;
+
   /// Advances the simulation by [dt] seconds in fixed-size steps, draining a
   /// clamped accumulator so the outcome is frame-rate independent.
   void step(double dt) {
@@ -158,6 +178,7 @@ class ParticleSystem {
     _random = math.Random(seed);
     _accumulator = 0.0;
     _systemTime = 0.0;
+    _resetCount++;
   }
 
   void _stepFixed(double dt) {
@@ -171,21 +192,27 @@ class ParticleSystem {
       }
     }
 
-    // Update-phase modules (forces, over-life evaluators) over all live.
-    for (final module in modules) {
-      module.update(storage, dt);
-    }
+    if (fusedKernels) {
+      // Modules and integration in one fused sweep.
+      _kernel.update(dt, gravity);
+    } else {
+      // Update-phase modules (forces, over-life evaluators) over all live.
+      for (final module in modules) {
+        module.update(storage, dt);
+      }
 
-    // Semi-implicit Euler: gravity into velocity, then velocity into position.
-    final gx = gravity.x * dt, gy = gravity.y * dt, gz = gravity.z * dt;
-    final n = storage.aliveCount;
-    for (var i = 0; i < n; i++) {
-      storage.velX[i] += gx;
-      storage.velY[i] += gy;
-      storage.velZ[i] += gz;
-      storage.posX[i] += storage.velX[i] * dt;
-      storage.posY[i] += storage.velY[i] * dt;
-      storage.posZ[i] += storage.velZ[i] * dt;
+      // Semi-implicit Euler: gravity into velocity, then velocity into
+      // position.
+      final gx = gravity.x * dt, gy = gravity.y * dt, gz = gravity.z * dt;
+      final n = storage.aliveCount;
+      for (var i = 0; i < n; i++) {
+        storage.velX[i] += gx;
+        storage.velY[i] += gy;
+        storage.velZ[i] += gz;
+        storage.posX[i] += storage.velX[i] * dt;
+        storage.posY[i] += storage.velY[i] * dt;
+        storage.posZ[i] += storage.velZ[i] * dt;
+      }
     }
 
     // Age and reap expired particles (reverse so swap-with-last is safe).
@@ -254,3 +281,76 @@ class ParticleSystem {
     }
   }
 }
+
+/// The settings of a [ParticleSystem] that may change after construction
+/// (its shape, spawn distributions, gravity, run, spawn rate, and kernel
+/// choice), captured to bring a copy of the system up to date.
+///
+/// The module stack and bursts are fixed at construction and not included.
+@internal
+final class ParticleSystemSettings {
+  /// Captures [system]'s current settings.
+  ParticleSystemSettings.of(ParticleSystem system)
+    : shape = system.shape,
+      lifetime = system.lifetime,
+      startSpeed = system.startSpeed,
+      startSize = system.startSize,
+      startRotation = system.startRotation,
+      startAngularVelocity = system.startAngularVelocity,
+      startColor = system.startColor,
+      gravityX = system.gravity.x,
+      gravityY = system.gravity.y,
+      gravityZ = system.gravity.z,
+      looping = system.looping,
+      duration = system.duration,
+      rate = system.spawner.rate,
+      fusedKernels = system.fusedKernels;
+
+  final EmitterShape shape;
+  final FloatDistribution lifetime,
+      startSpeed,
+      startSize,
+      startRotation,
+      startAngularVelocity;
+  final ColorDistribution startColor;
+  final double gravityX, gravityY, gravityZ;
+  final bool looping;
+  final double duration;
+  final double rate;
+  final bool fusedKernels;
+
+  /// Whether [system] still has these settings. Distributions and shapes
+  /// compare by identity; gravity, which changes in place, by value.
+  bool matches(ParticleSystem system) =>
+      identical(shape, system.shape) &&
+      identical(lifetime, system.lifetime) &&
+      identical(startSpeed, system.startSpeed) &&
+      identical(startSize, system.startSize) &&
+      identical(startRotation, system.startRotation) &&
+      identical(startAngularVelocity, system.startAngularVelocity) &&
+      identical(startColor, system.startColor) &&
+      gravityX == system.gravity.x &&
+      gravityY == system.gravity.y &&
+      gravityZ == system.gravity.z &&
+      looping == system.looping &&
+      duration == system.duration &&
+      rate == system.spawner.rate &&
+      fusedKernels == system.fusedKernels;
+
+  /// Gives [system] these settings. Its particles and clock carry on.
+  void applyTo(ParticleSystem system) {
+    system
+      ..shape = shape
+      ..lifetime = lifetime
+      ..startSpeed = startSpeed
+      ..startSize = startSize
+      ..startRotation = startRotation
+      ..startAngularVelocity = startAngularVelocity
+      ..startColor = startColor
+      ..looping = looping
+      ..duration = duration
+      ..fusedKernels = fusedKernels;
+    system.gravity.setValues(gravityX, gravityY, gravityZ);
+    system.spawner.rate = rate;
+  }
+}
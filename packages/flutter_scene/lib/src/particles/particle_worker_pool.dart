@@ -0,0 +1,117 @@
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/particles/particle_storage.dart';
+import 'package:flutter_scene/src/particles/particle_system.dart';
+import 'package:flutter_scene/src/particles/particle_worker_pool_native.dart'
+    if (dart.library.js_interop) 'package:flutter_scene/src/particles/particle_worker_pool_web.dart'
+    as impl;
+
+/// The floats per particle [packParticleBillboards] writes, matching the
+/// billboard batch's per-instance layout.
+const int kParticleBillboardFloats = 14;
+
+/// Writes [storage]'s live particles into [into] in the billboard instance
+/// layout (center x,y,z; size x,y; rotation; color r,g,b,a; frame; velocity
+/// x,y,z) and returns how many it wrote.
+///
+/// Each billboard is [aspectRatio] times as wide as its size; with
+/// [randomFlipX], about half (by their stable random) are mirrored.
+int packParticleBillboards(
+  ParticleStorage storage,
+  Float32List into, {
+  double aspectRatio = 1.0,
+  bool randomFlipX = false,
+}) {
+  final s = storage;
+  final count = s.aliveCount;
+  assert(into.length >= count * kParticleBillboardFloats);
+  for (var i = 0; i < count; i++) {
+    final o = i * kParticleBillboardFloats;
+    final size = s.size[i];
+    var width = size * aspectRatio;
+    if (randomFlipX && s.random01[i] < 0.5) width = -width;
+    into[o] = s.posX[i];
+    into[o + 1] = s.posY[i];
+    into[o + 2] = s.posZ[i];
+    into[o + 3] = width;
+    into[o + 4] = size;
+    into[o + 5] = s.rotation[i];
+    into[o + 6] = s.colorR[i];
+    into[o + 7] = s.colorG[i];
+    into[o + 8] = s.colorB[i];
+    into[o + 9] = s.colorA[i];
+    into[o + 10] = s.frame[i];
+    into[o + 11] = s.velX[i];
+    into[o + 12] = s.velY[i];
+    into[o + 13] = s.velZ[i];
+  }
+  return count;
+}
+
+/// One simulated frame of an off-thread emitter: [count] particles packed
+/// by [packParticleBillboards] into [instances].
+typedef ParticleFrame = ({Float32List instances, int count});
+
+/// A pool of worker isolates that simulate [ParticleSystem]s off the
+/// calling thread.
+///
+/// [attach] copies a system to one of the workers (round-robin), which
+/// from then on owns it: each [OffThreadParticles.step] ships only the
+/// frame deltas out, and the worker steps the system, packs its billboards,
+/// and transfers the packed frame back, so the render thread only uploads.
+/// Each frame is handed over (not shared), so the worker simulates the next
+/// one while the caller still uploads the last: the two sides work on
+/// separate buffers and never wait on each other.
+///
+/// The worker runs the same fixed-step code on the same step sequence, so
+/// an off-thread emitter reproduces its on-thread run exactly for a given
+/// seed.
+///
+/// The web has no shared-memory isolates, so there the pool steps each
+/// system synchronously on the main thread, in [OffThreadParticles.step]'s
+/// future; the results are the same, only the work stays on the caller.
+/// {@category Particles}
+abstract interface class ParticleWorkerPool {
+  /// Creates the platform pool. [workers] defaults to one per spare core,
+  /// at most four. The isolates spawn on first use.
+  factory ParticleWorkerPool({int? workers}) =>
+      impl.createParticleWorkerPool(workers: workers);
+
+  /// Hands [system] to a worker and returns the handle that steps it.
+  ///
+  /// The worker simulates its own copy, and the [system] on this isolate is
+  /// not stepped. Changes to its settings (shape, spawn distributions,
+  /// gravity, [ParticleSystem.looping], [ParticleSystem.duration], the
+  /// spawner's rate, [ParticleSystem.fusedKernels]) and calls to
+  /// [ParticleSystem.reset] reach the copy before the next
+  /// [OffThreadParticles.step]. Its modules and bursts are copied as they
+  /// are at attach time.
+  OffThreadParticles attach(ParticleSystem system);
+
+  /// Shuts down the workers. In-flight steps resolve null.
+  void dispose();
+}
+
+/// One [ParticleSystem] simulated by a [ParticleWorkerPool] worker.
+abstract interface class OffThreadParticles {
+  /// Steps the system by each of [deltas] in order (as
+  /// [ParticleSystem.step] would), then resolves with the packed frame, or
+  /// null if the handle or pool was disposed first.
+  ///
+  /// Steps may overlap; they run and resolve in the order issued. Once
+  /// [error] is set, every step resolves null.
+  Future<ParticleFrame?> step(
+    List<double> deltas, {
+    double aspectRatio = 1.0,
+    bool randomFlipX = false,
+  });
+
+  /// The error that stopped the worker simulating this system (a module
+  /// that threw, a system that could not be copied to it, or the worker
+  /// exiting), or null while it runs.
+  Object? get error;
+
+  /// Releases the worker's copy of the system. In-flight steps resolve
+  /// null.
+  void dispose();
+}
@@ -0,0 +1,295 @@
+import 'dart:async';
+import 'dart:collection';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/particles/particle_system.dart';
+import 'package:flutter_scene/src/particles/particle_worker_pool.dart';
+
+/// Creates the isolate-backed pool.
+ParticleWorkerPool createParticleWorkerPool({int? workers}) =>
+    _IsolateParticleWorkerPool(
+      workers ?? math.min(math.max(1, Platform.numberOfProcessors - 1), 4),
+    );
+
+// Worker message tags. [_attach] hands a worker a system under an id,
+// [_step] steps one (replying with its packed frame), [_detach] drops one,
+// and [_configure] and [_reset] bring one's settings and clock in line
+// with the original.
+const int _attach = 0;
+const int _step = 1;
+const int _detach = 2;
+const int _configure = 3;
+const int _reset = 4;
+
+class _IsolateParticleWorkerPool implements ParticleWorkerPool {
+  _IsolateParticleWorkerPool(int workers)
+    : _workerCount = math.max(1, workers);
+
+  final int _workerCount;
+  final Map<int, _IsolateParticles> _attached = {};
+  int _nextId = 0;
+  bool _disposed = false;
+  Future<List<SendPort>>? _workers;
+  ReceivePort? _fromWorkers;
+  // Per worker, the port its errors and exit arrive on, and the error that
+  // stopped it (non-null once it is gone).
+  final List<RawReceivePort> _faults = [];
+  late final List<Object?> _workerErrors = List.filled(_workerCount, null);
+
+  // Spawns the workers on first use; frames from all of them arrive on one
+  // port, tagged with the system's id. A worker that throws (or exits) is
+  // fatal to it, so its errors and exit are watched separately to fail the
+  // steps its systems were waiting on.
+  Future<List<SendPort>> _ensureWorkers() {
+    return _workers ??= () async {
+      final fromWorkers = ReceivePort();
+      _fromWorkers = fromWorkers;
+      final ports = List<SendPort?>.filled(_workerCount, null);
+      var registered = 0;
+      final ready = Completer<List<SendPort>>();
+      fromWorkers.listen((message) {
+        final fields = message as List;
+        if (fields[0] is SendPort) {
+          ports[fields[1] as int] = fields[0] as SendPort;
+          if (++registered == _workerCount) {
+            ready.complete([for (final port in ports) port!]);
+          }
+          return;
+        }
+        _attached[fields[0] as int]?._receive(
+          (fields[1] as TransferableTypedData).materialize().asFloat32List(),
+          fields[2] as int,
+        );
+      });
+      for (var w = 0; w < _workerCount; w++) {
+        final faults = RawReceivePort();
+        faults.handler = (Object? message) => _workerFailed(w, message);
+        _faults.add(faults);
+        await Isolate.spawn(
+          particleWorkerIsolateMain,
+          <Object>[fromWorkers.sendPort, w],
+          onError: faults.sendPort,
+          onExit: faults.sendPort,
+          debugName: 'flutter_scene particle worker $w',
+        );
+      }
+      return ready.future;
+    }();
+  }
+
+  // Handles worker [w]'s uncaught error (a `[error, stack]` pair) or exit
+  // (null): fails every system on it. Exits the pool asked for are
+  // expected.
+  void _workerFailed(int w, Object? message) {
+    if (message is List) {
+      _workerErrors[w] ??= RemoteError(
+        message[0] as String,
+        message[1] as String,
+      );
+      return;
+    }
+    _faults[w].close();
+    if (_disposed) return;
+    final error = _workerErrors[w] ??= StateError(
+      'Particle worker $w exited',
+    );
+    for (final particles in _attached.values.toList()) {
+      if (particles._id % _workerCount == w) particles._fail(error);
+    }
+  }
+
+  @override
+  OffThreadParticles attach(ParticleSystem system) {
+    assert(!_disposed, 'The pool was disposed.');
+    final id = _nextId++;
+    final particles = _IsolateParticles(this, id, system);
+    _attached[id] = particles;
+    // Assign round-robin; a system stays on its worker for life, so its
+    // steps run (and reply) in order.
+    particles._worker = _ensureWorkers().then((workers) {
+      final w = id % workers.length;
+      final worker = workers[w];
+      final failed = _workerErrors[w];
+      if (failed != null) {
+        particles._fail(failed);
+        return worker;
+      }
+      try {
+        worker.send(<Object>[_attach, id, system]);
+      } catch (error) {
+        // A module holding something that cannot cross isolates.
+        particles._fail(error);
+      }
+      return worker;
+    });
+    return particles;
+  }
+
+  @override
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    for (final particles in _attached.values.toList()) {
+      particles.dispose();
+    }
+    // Ask the workers to exit once they are up (they may still be
+    // spawning).
+    _workers?.then((workers) {
+      for (final worker in workers) {
+        worker.send(null);
+      }
+      _fromWorkers?.close();
+    });
+  }
+}
+
+class _IsolateParticles implements OffThreadParticles {
+  _IsolateParticles(this._pool, this._id, this._system)
+    : _settings = ParticleSystemSettings.of(_system),
+      _resets = _system.resetCount;
+
+  final _IsolateParticleWorkerPool _pool;
+  final int _id;
+  late final Future<SendPort> _worker;
+  // The original, and its settings and reset count as last sent to the
+  // worker's copy.
+  final ParticleSystem _system;
+  ParticleSystemSettings _settings;
+  int _resets;
+  final Queue<Completer<ParticleFrame?>> _pending = Queue();
+  bool _disposed = false;
+
+  @override
+  Object? get error => _error;
+  Object? _error;
+
+  @override
+  Future<ParticleFrame?> step(
+    List<double> deltas, {
+    double aspectRatio = 1.0,
+    bool randomFlipX = false,
+  }) {
+    if (_disposed || _error != null) return Future.value();
+    final pending = Completer<ParticleFrame?>();
+    _pending.add(pending);
+    // Changes to the original since the last step land before this one.
+    if (!_settings.matches(_system)) {
+      _settings = ParticleSystemSettings.of(_system);
+      _send(<Object>[_configure, _id, _settings]);
+    }
+    if (_resets != _system.resetCount) {
+      _resets = _system.resetCount;
+      _send(<Object>[_reset, _id]);
+    }
+    _send(<Object>[
+      _step,
+      _id,
+      Float64List.fromList(deltas),
+      aspectRatio,
+      randomFlipX,
+    ]);
+    return pending.future;
+  }
+
+  // Messages go out in the order sent, once the worker is up.
+  void _send(List<Object> message) {
+    _worker.then((worker) {
+      if (_disposed || _error != null) return;
+      try {
+        worker.send(message);
+      } catch (error) {
+        // A new shape or distribution that cannot cross isolates.
+        _fail(error);
+      }
+    });
+  }
+
+  // Stops the system for good: its pending steps resolve null.
+  void _fail(Object error) {
+    _error ??= error;
+    while (_pending.isNotEmpty) {
+      _pending.removeFirst().complete(null);
+    }
+  }
+
+  void _receive(Float32List instances, int count) {
+    if (_pending.isEmpty) return;
+    _pending.removeFirst().complete((instances: instances, count: count));
+  }
+
+  @override
+  void dispose() {
+    if (_disposed) return;
+    _disposed = true;
+    _pool._attached.remove(_id);
+    while (_pending.isNotEmpty) {
+      _pending.removeFirst().complete(null);
+    }
+    _worker.then((worker) => worker.send(<Object>[_detach, _id]));
+  }
+}
+
+/// One particle worker isolate. Serves its systems' steps until a null
+/// message asks it to exit.
+///
+/// Each attached system keeps a packing buffer sized for its capacity, so a
+/// steady step allocates only the transfer buffer.
+void particleWorkerIsolateMain(List<Object> init) {
+  final replyTo = init[0] as SendPort;
+  final index = init[1] as int;
+  final systems = <int, ParticleSystem>{};
+  final buffers = <int, Float32List>{};
+
+  final requests = ReceivePort();
+  replyTo.send(<Object>[requests.sendPort, index]);
+  requests.listen((message) {
+    if (message == null) {
+      requests.close();
+      return;
+    }
+    final fields = message as List;
+    final id = fields[1] as int;
+    switch (fields[0] as int) {
+      case _attach:
+        final system = fields[2] as ParticleSystem;
+        systems[id] = system;
+        buffers[id] = Float32List(
+          system.storage.capacity * kParticleBillboardFloats,
+        );
+      case _step:
+        final system = systems[id];
+        if (system == null) return;
+        for (final dt in fields[2] as Float64List) {
+          system.step(dt);
+        }
+        final buffer = buffers[id]!;
+        final count = packParticleBillboards(
+          system.storage,
+          buffer,
+          aspectRatio: fields[3] as double,
+          randomFlipX: fields[4] as bool,
+        );
+        final floats = count * kParticleBillboardFloats;
+        replyTo.send(<Object>[
+          id,
+          TransferableTypedData.fromList([
+            Float32List.sublistView(buffer, 0, floats),
+          ]),
+          count,
+        ]);
+      case _detach:
+        systems.remove(id);
+        buffers.remove(id);
+      case _configure:
+        final system = systems[id];
+        if (system != null) {
+          (fields[2] as ParticleSystemSettings).applyTo(system);
+        }
+      case _reset:
+        systems[id]?.reset();
+    }
+  });
+}
@@ -0,0 +1,79 @@
+import 'dart:async';
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/particles/particle_system.dart';
+import 'package:flutter_scene/src/particles/particle_worker_pool.dart';
+
+/// Creates the web pool, which steps every system synchronously on the main
+/// thread (the web platform has no shared-memory isolates). It steps the
+/// attached system itself, so changes to it apply directly.
+///
+/// [workers] is ignored; there is nothing to spread the systems across.
+ParticleWorkerPool createParticleWorkerPool({int? workers}) =>
+    _SynchronousParticleWorkerPool();
+
+class _SynchronousParticleWorkerPool implements ParticleWorkerPool {
+  final Set<_SynchronousParticles> _attached = {};
+
+  @override
+  OffThreadParticles attach(ParticleSystem system) {
+    final particles = _SynchronousParticles(system, _attached);
+    _attached.add(particles);
+    return particles;
+  }
+
+  @override
+  void dispose() {
+    for (final particles in _attached.toList()) {
+      particles.dispose();
+    }
+  }
+}
+
+class _SynchronousParticles implements OffThreadParticles {
+  _SynchronousParticles(this._system, this._pool);
+
+  final ParticleSystem _system;
+  final Set<_SynchronousParticles> _pool;
+  bool _disposed = false;
+
+  @override
+  Object? get error => _error;
+  Object? _error;
+
+  // Steps on this thread, so the system is not copied; the caller gets a
+  // fresh buffer per frame, as the native pool's caller does. A module
+  // that throws stops the system, as it stops a native worker.
+  @override
+  Future<ParticleFrame?> step(
+    List<double> deltas, {
+    double aspectRatio = 1.0,
+    bool randomFlipX = false,
+  }) => Future(() {
+    if (_disposed || _error != null) return null;
+    try {
+      for (final dt in deltas) {
+        _system.step(dt);
+      }
+    } catch (error) {
+      _error = error;
+      return null;
+    }
+    final instances = Float32List(
+      _system.storage.aliveCount * kParticleBillboardFloats,
+    );
+    final count = packParticleBillboards(
+      _system.storage,
+      instances,
+      aspectRatio: aspectRatio,
+      randomFlipX: randomFlipX,
+    );
+    return (instances: instances, count: count);
+  });
+
+  @override
+  void dispose() {
+    _disposed = true;
+    _pool.remove(this);
+  }
+}
@@ -137,6 +137,16 @@ class AutoExposurePass extends RenderGraphPass {
   @override
   String get name => 'AutoExposurePass';
 
+  @override
+  Set<Object> get inputs => const {kSceneColorBlackboardKey};
+
+  @override
+  Set<Object> get outputs => const {kAutoExposureFactorBlackboardKey};
+
+  // Advances the adaptation state.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final scene = context.blackboard.require<gpu.Texture>(
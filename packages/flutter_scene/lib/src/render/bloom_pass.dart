@@ -89,6 +89,12 @@ class BloomPass extends RenderGraphPass {
   @override
   String get name => 'BloomPass';
 
+  @override
+  Set<Object> get inputs => const {kSceneColorBlackboardKey};
+
+  @override
+  Set<Object> get outputs => const {kBloomTextureBlackboardKey};
+
   @override
   void execute(RenderGraphContext context) {
     final scene = context.blackboard.require<gpu.Texture>(
@@ -1,8 +1,146 @@
+import 'dart:math' as math;
 import 'dart:typed_data';
 
+import 'package:flutter_scene/src/render/render_profile.dart';
 import 'package:flutter_scene/src/render/render_scene.dart';
 import 'package:vector_math/vector_math.dart';
 
+/// The spatial queries render passes and the light culler run against a
+/// scene's bounded [RenderItem]s, implemented by [Bvh] and by the scene's
+/// two-level [SceneBvh].
+abstract interface class BvhQueries {
+  /// Calls [visit] once for every item whose world AABB intersects
+  /// [frustum] and lies on the visible side of every [additionalPlanes].
+  void query(
+    Frustum frustum,
+    void Function(RenderItem) visit, {
+    List<Plane> additionalPlanes = const [],
+  });
+
+  /// Calls [visit] once for every item whose world AABB intersects [box].
+  void queryAabb(Aabb3 box, void Function(RenderItem) visit);
+
+  /// Culls against every frustum in [frustums] in one traversal, appending
+  /// each item that [query] would visit for `frustums[v]` to `visible[v]`.
+  ///
+  /// `additionalPlanes[v]`, when present, plays the role of [query]'s
+  /// `additionalPlanes` for view `v`. [visible] must have at least one list
+  /// per frustum; it is appended to, not cleared.
+  void queryMany(
+    List<Frustum> frustums,
+    List<List<RenderItem>> visible, {
+    List<List<Plane>> additionalPlanes = const [],
+  });
+}
+
+/// The planes of up to [maxViews] frustums in one flat array, culling a box
+/// against all of them at once for [BvhQueries.queryMany].
+///
+/// A traversal carries a bitmask of the views still intersecting each node:
+/// [cull] tests a node's box only against the views whose bits are set and
+/// returns the ones it still intersects, so a subtree every view has
+/// rejected is never entered and traversal cost grows with the tree, not
+/// with tree size times view count.
+class FrustumBatch {
+  /// The most views one traversal tracks. Masks stay within 30 bits so
+  /// they are exact small integers on every platform, web included.
+  static const int maxViews = 30;
+
+  // Plane rows (nx, ny, nz, constant); view v owns the rows
+  // [_planeStart[v], _planeStart[v + 1]).
+  Float64List _planes = Float64List(maxViews * 6 * 4);
+  final Int32List _planeStart = Int32List(maxViews + 1);
+  int _viewCount = 0;
+
+  /// The mask with a bit set for every loaded view.
+  int get allViews => (1 << _viewCount) - 1;
+
+  /// Loads `count` views starting at `frustums[start]`, with their
+  /// optional additional planes.
+  void load(
+    List<Frustum> frustums,
+    List<List<Plane>> additionalPlanes,
+    int start,
+    int count,
+  ) {
+    assert(count <= maxViews);
+    var rows = 0;
+    for (var v = start; v < start + count; v++) {
+      rows += 6;
+      if (v < additionalPlanes.length) rows += additionalPlanes[v].length;
+    }
+    if (_planes.length < rows * 4) _planes = Float64List(rows * 4);
+    var o = 0;
+    for (var v = 0; v < count; v++) {
+      _planeStart[v] = o;
+      final frustum = frustums[start + v];
+      o = _store(o, frustum.plane0);
+      o = _store(o, frustum.plane1);
+      o = _store(o, frustum.plane2);
+      o = _store(o, frustum.plane3);
+      o = _store(o, frustum.plane4);
+      o = _store(o, frustum.plane5);
+      if (start + v < additionalPlanes.length) {
+        for (final plane in additionalPlanes[start + v]) {
+          o = _store(o, plane);
+        }
+      }
+    }
+    _planeStart[count] = o;
+    _viewCount = count;
+  }
+
+  int _store(int o, Plane plane) {
+    _planes[o] = plane.normal.x;
+    _planes[o + 1] = plane.normal.y;
+    _planes[o + 2] = plane.normal.z;
+    _planes[o + 3] = plane.constant;
+    return o + 4;
+  }
+
+  /// The views in [mask] whose frustum the box at `bounds[o..o+6)`
+  /// intersects. Uses the same farthest-corner test as [Bvh.query].
+  int cull(Float32List bounds, int o, int mask) {
+    final planes = _planes;
+    final minX = bounds[o], minY = bounds[o + 1], minZ = bounds[o + 2];
+    final maxX = bounds[o + 3], maxY = bounds[o + 4], maxZ = bounds[o + 5];
+    var result = mask;
+    var remaining = mask;
+    while (remaining != 0) {
+      final bit = remaining & -remaining;
+      remaining ^= bit;
+      final view = bit.bitLength - 1;
+      final end = _planeStart[view + 1];
+      for (var p = _planeStart[view]; p < end; p += 4) {
+        final nx = planes[p], ny = planes[p + 1], nz = planes[p + 2];
+        final px = nx < 0 ? minX : maxX;
+        final py = ny < 0 ? minY : maxY;
+        final pz = nz < 0 ? minZ : maxZ;
+        if (nx * px + ny * py + nz * pz + planes[p + 3] < 0) {
+          result ^= bit;
+          break;
+        }
+      }
+    }
+    return result;
+  }
+
+  /// Appends [item] to `visible[start + v]` for every view `v` in [mask].
+  static void scatter(
+    RenderItem item,
+    int mask,
+    List<List<RenderItem>> visible,
+    int start,
+  ) {
+    var remaining = mask;
+    while (remaining != 0) {
+      final bit = remaining & -remaining;
+      remaining ^= bit;
+      visible[start + bit.bitLength - 1].add(item);
+    }
+  }
+}
+
 /// A bounding volume hierarchy over the bounded [RenderItem]s of a
 /// [RenderScene].
 ///
@@ -16,9 +154,14 @@ import 'package:vector_math/vector_math.dart';
 /// median, which costs O(n) per level with no per-level sorting; children
 /// are allocated before their parent, so [refit] is a single forward pass.
 ///
-/// Engine-internal; rebuilt by [RenderScene] when the scene changes.
-class Bvh {
-  Bvh._(this._bounds, this._children, this._items, this._nodeCount);
+/// An item can be dropped without a rebuild with [retireLeaf]: its leaf
+/// stays in the tree but queries skip it.
+///
+/// Engine-internal; the static level of [RenderScene]'s [SceneBvh],
+/// rebuilt when enough of the scene has changed.
+class Bvh implements BvhQueries {
+  Bvh._(this._bounds, this._children, this._items, this._nodeCount)
+    : _retired = Uint8List(_items.length);
 
   /// Builds a BVH over [items]. Every item must have a non-null
   /// [RenderItem.worldBounds].
@@ -144,16 +287,52 @@ class Bvh {
   final List<RenderItem> _items;
   final int _nodeCount;
 
+  // Per-leaf retirement flags, and how many are set.
+  final Uint8List _retired;
+  int _retiredCount = 0;
+
+  int _nodeVisits = 0;
+
+  /// The number of leaves, one per item the tree was built over. Leaf
+  /// indices are stable for the tree's lifetime.
+  int get leafCount => _items.length;
+
+  /// The item the tree placed at [leaf].
+  RenderItem leafItem(int leaf) => _items[leaf];
+
+  /// How many leaves [retireLeaf] has dropped.
+  int get retiredLeafCount => _retiredCount;
+
+  /// Drops [leaf] from every later query. Its bounds stay in the tree
+  /// (conservatively) until the next build, and [refit] leaves them alone.
+  void retireLeaf(int leaf) {
+    if (_retired[leaf] != 0) return;
+    _retired[leaf] = 1;
+    _retiredCount++;
+  }
+
+  /// Nodes visited by queries since the last call, then resets the count.
+  /// Counted only when [profileRendering] is on.
+  int takeNodeVisits() {
+    final visits = _nodeVisits;
+    _nodeVisits = 0;
+    return visits;
+  }
+
   // Traversal stack, sized for a balanced tree far deeper than any
   // realistic item count. Queries are single-threaded and never nest (a
-  // visit callback must not query the same Bvh).
+  // visit callback must not query the same Bvh). [queryMany] pairs each
+  // entry with the view mask in _maskStack.
   final Int32List _stack = Int32List(64);
+  final Int32List _maskStack = Int32List(64);
+  final FrustumBatch _batch = FrustumBatch();
 
   // Frustum planes as (nx, ny, nz, constant) rows, reloaded per query.
   final Float64List _planes = Float64List(24);
 
   /// Calls [visit] once for every item whose world AABB intersects
   /// [frustum].
+  @override
   void query(
     Frustum frustum,
     void Function(RenderItem) visit, {
@@ -174,6 +353,7 @@ class Bvh {
     stack[top++] = _nodeCount - 1;
     while (top > 0) {
       final node = stack[--top];
+      if (profileRendering) _nodeVisits++;
       final o = node * 6;
       // Outside when the corner farthest along a plane's normal is below
       // that plane, matching Frustum.intersectsWithAabb3.
@@ -205,7 +385,7 @@ class Bvh {
       if (outside) continue;
       final left = children[node * 2];
       if (left < 0) {
-        visit(_items[~left]);
+        if (_retiredCount == 0 || _retired[~left] == 0) visit(_items[~left]);
         continue;
       }
       stack[top++] = left;
@@ -213,6 +393,49 @@ class Bvh {
     }
   }
 
+  /// Culls against many frustums in one traversal; see
+  /// [BvhQueries.queryMany]. Views beyond [FrustumBatch.maxViews] take
+  /// another traversal per batch.
+  @override
+  void queryMany(
+    List<Frustum> frustums,
+    List<List<RenderItem>> visible, {
+    List<List<Plane>> additionalPlanes = const [],
+  }) {
+    assert(visible.length >= frustums.length);
+    if (_nodeCount == 0) return;
+    final batch = _batch;
+    final bounds = _bounds;
+    final children = _children;
+    final stack = _stack;
+    final masks = _maskStack;
+    const batchSize = FrustumBatch.maxViews;
+    for (var start = 0; start < frustums.length; start += batchSize) {
+      final count = math.min(batchSize, frustums.length - start);
+      batch.load(frustums, additionalPlanes, start, count);
+      var top = 0;
+      stack[top] = _nodeCount - 1;
+      masks[top++] = batch.allViews;
+      while (top > 0) {
+        final node = stack[--top];
+        if (profileRendering) _nodeVisits++;
+        final mask = batch.cull(bounds, node * 6, masks[top]);
+        if (mask == 0) continue;
+        final left = children[node * 2];
+        if (left < 0) {
+          if (_retiredCount == 0 || _retired[~left] == 0) {
+            FrustumBatch.scatter(_items[~left], mask, visible, start);
+          }
+          continue;
+        }
+        stack[top] = left;
+        masks[top++] = mask;
+        stack[top] = children[node * 2 + 1];
+        masks[top++] = mask;
+      }
+    }
+  }
+
   void _loadPlane(int index, Plane plane) {
     final o = index * 4;
     _planes[o] = plane.normal.x;
@@ -225,6 +448,7 @@ class Bvh {
   ///
   /// Used to scatter a light's influence volume onto the items it can reach,
   /// so each item collects only the lights near it.
+  @override
   void queryAabb(Aabb3 box, void Function(RenderItem) visit) {
     if (_nodeCount == 0) return;
     final minX = box.min.x, minY = box.min.y, minZ = box.min.z;
@@ -236,6 +460,7 @@ class Bvh {
     stack[top++] = _nodeCount - 1;
     while (top > 0) {
       final node = stack[--top];
+      if (profileRendering) _nodeVisits++;
       final o = node * 6;
       if (bounds[o] > maxX ||
           bounds[o + 1] > maxY ||
@@ -247,7 +472,7 @@ class Bvh {
       }
       final left = children[node * 2];
       if (left < 0) {
-        visit(_items[~left]);
+        if (_retiredCount == 0 || _retired[~left] == 0) visit(_items[~left]);
         continue;
       }
       stack[top++] = left;
@@ -259,9 +484,10 @@ class Bvh {
   /// [RenderItem.worldBounds] without changing the tree topology.
   ///
   /// Valid only while the item set and each leaf's item are unchanged
-  /// since the build; a moved item is fine, an added or removed one
-  /// needs a rebuild. Cheaper than a rebuild (O(n), no sort), but tree
-  /// quality degrades as items drift from their build-time grouping.
+  /// since the build, apart from retired leaves; a moved item is fine, an
+  /// added one needs a rebuild. Cheaper than a rebuild (O(n), no sort),
+  /// but tree quality degrades as items drift from their build-time
+  /// grouping.
   void refit() {
     final bounds = _bounds;
     final children = _children;
@@ -270,6 +496,7 @@ class Bvh {
       final o = node * 6;
       final left = children[node * 2];
       if (left < 0) {
+        if (_retired[~left] != 0) continue;
         final b = _items[~left].worldBounds!;
         bounds[o] = b.min.x;
         bounds[o + 1] = b.min.y;
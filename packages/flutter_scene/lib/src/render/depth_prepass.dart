@@ -13,6 +13,7 @@ import 'package:flutter_scene/src/material/material.dart' show Material;
 import 'package:flutter_scene/src/render/render_graph.dart';
 import 'package:flutter_scene/src/render/render_layers.dart';
 import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:flutter_scene/src/render/retained_draw_order.dart';
 import 'package:flutter_scene/src/scene_encoder.dart' show resolvePipeline;
 import 'package:flutter_scene/src/shaders.dart';
 import 'package:flutter_scene/src/render/frame_transients.dart';
@@ -54,6 +55,8 @@ class DepthPrepass extends RenderGraphPass {
     Vector3? cameraRight,
     Vector3? cameraUp,
     List<Plane> cullingPlanes = const [],
+    RetainedDrawOrder? drawOrder,
+    List<RenderItem>? candidates,
   }) : _camera = camera,
        _renderScene = renderScene,
        _dimensions = dimensions,
@@ -64,7 +67,9 @@ class DepthPrepass extends RenderGraphPass {
        _writeNormals = writeNormals,
        _keepDepthStencil = keepDepthStencil,
        _cameraRight = cameraRight ?? Vector3.zero(),
-       _cameraUp = cameraUp ?? Vector3.zero();
+       _cameraUp = cameraUp ?? Vector3.zero(),
+       _drawOrder = drawOrder,
+       _candidates = candidates;
 
   final Camera _camera;
   final RenderScene _renderScene;
@@ -89,9 +94,27 @@ class DepthPrepass extends RenderGraphPass {
   final Vector3 _cameraRight;
   final Vector3 _cameraUp;
 
+  // This view's depth order kept from the last frame (see
+  // RenderScene.depthDrawOrder), or null to sort from scratch.
+  final RetainedDrawOrder? _drawOrder;
+
+  // The items potentially visible to this view, when culled ahead of the
+  // pass together with other views (RenderScene.cullMany); null to cull
+  // here.
+  final List<RenderItem>? _candidates;
+
   @override
   String get name => 'DepthPrepass';
 
+  @override
+  Set<Object> get inputs => const {};
+
+  @override
+  Set<Object> get outputs => const {
+    kLinearDepthBlackboardKey,
+    kPrepassDepthStencilBlackboardKey,
+  };
+
   @override
   void execute(RenderGraphContext context) {
     final width = _dimensions.width.toInt();
@@ -159,12 +182,20 @@ class DepthPrepass extends RenderGraphPass {
       writeNormals: _writeNormals,
       cameraRight: _cameraRight,
       cameraUp: _cameraUp,
+      retainedOrder: _drawOrder,
     );
-    _renderScene.cull(
-      encoder.frustum,
-      encoder.submit,
-      additionalPlanes: _cullingPlanes,
-    );
+    final candidates = _candidates;
+    if (candidates != null) {
+      for (final item in candidates) {
+        encoder.submit(item);
+      }
+    } else {
+      _renderScene.cull(
+        encoder.frustum,
+        encoder.submit,
+        additionalPlanes: _cullingPlanes,
+      );
+    }
     encoder.flush();
     rendererSubmissions.submit(commandBuffer);
 
@@ -221,6 +252,15 @@ class TranslucentDepthPatchPass extends RenderGraphPass {
   @override
   String get name => 'TranslucentDepthPatchPass';
 
+  @override
+  Set<Object> get inputs => const {
+    kLinearDepthBlackboardKey,
+    kPrepassDepthStencilBlackboardKey,
+  };
+
+  @override
+  Set<Object> get outputs => const {kLinearDepthBlackboardKey};
+
   static bool _qualifies(RenderItem item) =>
       !item.material.isOpaque() && item.material.translucentDepthWrite;
 
@@ -305,8 +345,10 @@ class _DepthPrepassEncoder {
     required Vector3 cameraRight,
     required Vector3 cameraUp,
     bool translucentPatch = false,
+    RetainedDrawOrder? retainedOrder,
   }) : _writeNormals = writeNormals,
-       _translucentPatch = translucentPatch {
+       _translucentPatch = translucentPatch,
+       _retainedOrder = retainedOrder {
     frustum = Frustum.matrix(_cameraTransform);
     _renderPass.setDepthWriteEnable(true);
     _renderPass.setColorBlendEnable(false);
@@ -383,6 +425,8 @@ class _DepthPrepassEncoder {
   /// consecutive objects that share one only bind it once.
   gpu.RenderPipeline? _boundPipeline;
   final List<RenderItem> _records = [];
+  // Where the draw order from the last prepass is kept, if anywhere.
+  final RetainedDrawOrder? _retainedOrder;
 
   /// Records [item]'s depth, unless it is hidden, rejected by its layer
   /// mask, or outside this encoder's set (prepass-participating items
@@ -401,19 +445,23 @@ class _DepthPrepassEncoder {
   }
 
   void flush() {
-    _records.sort((a, b) {
-      final byMaterial = identityHashCode(
-        a.material,
-      ).compareTo(identityHashCode(b.material));
-      if (byMaterial != 0) return byMaterial;
-      return identityHashCode(
-        a.geometry,
-      ).compareTo(identityHashCode(b.geometry));
-    });
+    final retainedOrder = _retainedOrder;
+    if (retainedOrder == null) {
+      sortDepthRecords(_records);
+    } else {
+      retainedOrder.sortItems(_records, compareDepthRecords, sortDepthRecords);
+    }
     var index = 0;
     while (index < _records.length) {
       final first = _records[index];
-      final end = depthBatchEnd(_records, index);
+      final end =
+          retainedOrder?.batchEnd(
+            _records,
+            index,
+            depthBatchEnd,
+            depthBatchJoins,
+          ) ??
+          depthBatchEnd(_records, index);
       if (end > index + 1) {
         final batches = <InstanceDataBatch>[];
         for (var batchIndex = index; batchIndex < end; batchIndex++) {
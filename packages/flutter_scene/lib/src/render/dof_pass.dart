@@ -74,6 +74,15 @@ class DofPass extends RenderGraphPass {
   @override
   String get name => 'DofPass';
 
+  @override
+  Set<Object> get inputs => const {
+    kSceneColorBlackboardKey,
+    kLinearDepthBlackboardKey,
+  };
+
+  @override
+  Set<Object> get outputs => const {kSceneColorBlackboardKey};
+
   @override
   void execute(RenderGraphContext context) {
     final scene = context.blackboard.require<gpu.Texture>(
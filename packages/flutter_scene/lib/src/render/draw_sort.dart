@@ -0,0 +1,170 @@
+import 'dart:typed_data';
+
+/// A stable least-significant-digit radix sort of draw records by a fixed set
+/// of unsigned 32-bit key columns, column 0 most significant.
+///
+/// The caller fills one key per record per column with [setKey] (see
+/// [sortableFloatBits] for doubles), then [sort] reorders the records. Each
+/// column is shifted by its minimum and only its significant bits are sorted,
+/// in 8- or 11-bit digits, skipping digits every record shares; constant
+/// columns (every fade 1, one light channel mask) cost a single scan.
+///
+/// Keys may be coarser than the order the records need (doubles are keyed at
+/// float precision). Runs of records with equal keys are finished with the
+/// exact comparator, so the result is the comparator's order, with full ties
+/// left in submission order.
+///
+/// Scratch buffers grow to the largest record count seen and are reused, so a
+/// steady frame sorts without allocating.
+class DrawKeySorter {
+  DrawKeySorter(this.columnCount) : assert(columnCount > 0);
+
+  /// The number of key columns per record.
+  final int columnCount;
+
+  int _capacity = 0;
+  int _count = 0;
+  // Column-major: column c of record r at [c * _capacity + r].
+  Uint32List _keys = Uint32List(0);
+  Int32List _order = Int32List(0);
+  Int32List _swap = Int32List(0);
+  final Int32List _histogram = Int32List(1 << 11);
+  final List<Object?> _scratch = [];
+
+  /// Prepares to key [count] records, growing the scratch buffers if needed.
+  void reset(int count) {
+    if (count > _capacity) {
+      var capacity = _capacity == 0 ? 256 : _capacity;
+      while (capacity < count) {
+        capacity *= 2;
+      }
+      _capacity = capacity;
+      _keys = Uint32List(capacity * columnCount);
+      _order = Int32List(capacity);
+      _swap = Int32List(capacity);
+    }
+    _count = count;
+  }
+
+  /// Whether [value] fits a key column. Callers whose fields can fall
+  /// outside it sort with their comparator instead.
+  static bool fitsKey(int value) => value >= 0 && value <= 0xFFFFFFFF;
+
+  /// Sets [record]'s key in [column] to the unsigned 32-bit [value].
+  void setKey(int column, int record, int value) {
+    assert(value >= 0 && value <= 0xFFFFFFFF);
+    _keys[column * _capacity + record] = value;
+  }
+
+  /// Reorders [records] (the [reset] count of them, keyed by index) by the
+  /// keys, finishing runs of equal keys with [compare].
+  void sort<T>(List<T> records, int Function(T a, T b) compare) {
+    final count = _count;
+    assert(records.length == count);
+    if (count < 2) return;
+    var order = _order;
+    var swap = _swap;
+    for (var i = 0; i < count; i++) {
+      order[i] = i;
+    }
+
+    final digitBits = count < 2048 ? 8 : 11;
+    final radix = 1 << digitBits;
+    final mask = radix - 1;
+    final histogram = _histogram;
+    final keys = _keys;
+    for (var column = columnCount - 1; column >= 0; column--) {
+      final base = column * _capacity;
+      var min = keys[base];
+      var max = min;
+      for (var i = 1; i < count; i++) {
+        final key = keys[base + i];
+        if (key < min) min = key;
+        if (key > max) max = key;
+      }
+      final width = (max - min).bitLength;
+      for (var shift = 0; shift < width; shift += digitBits) {
+        histogram.fillRange(0, radix, 0);
+        for (var i = 0; i < count; i++) {
+          histogram[((keys[base + order[i]] - min) >> shift) & mask]++;
+        }
+        final first = ((keys[base + order[0]] - min) >> shift) & mask;
+        if (histogram[first] == count) continue;
+        var total = 0;
+        for (var d = 0; d < radix; d++) {
+          final n = histogram[d];
+          histogram[d] = total;
+          total += n;
+        }
+        for (var i = 0; i < count; i++) {
+          final record = order[i];
+          final digit = ((keys[base + record] - min) >> shift) & mask;
+          swap[histogram[digit]++] = record;
+        }
+        final t = order;
+        order = swap;
+        swap = t;
+      }
+    }
+    // Keep the buffers paired with their latest roles.
+    _order = order;
+    _swap = swap;
+
+    final scratch = _scratch
+      ..clear()
+      ..addAll(records);
+    for (var i = 0; i < count; i++) {
+      records[i] = scratch[order[i]] as T;
+    }
+    scratch.clear();
+
+    // Equal keys only say the records tie at key precision; order each such
+    // run exactly. Insertion sort keeps full ties in submission order.
+    var start = 0;
+    while (start < count - 1) {
+      var end = start + 1;
+      while (end < count && _sameKeys(order[start], order[end])) {
+        end++;
+      }
+      if (end - start > 1) _insertionSort(records, start, end, compare);
+      start = end;
+    }
+  }
+
+  bool _sameKeys(int a, int b) {
+    for (var column = 0; column < columnCount; column++) {
+      final base = column * _capacity;
+      if (_keys[base + a] != _keys[base + b]) return false;
+    }
+    return true;
+  }
+
+  static void _insertionSort<T>(
+    List<T> records,
+    int start,
+    int end,
+    int Function(T a, T b) compare,
+  ) {
+    for (var i = start + 1; i < end; i++) {
+      final record = records[i];
+      var j = i - 1;
+      while (j >= start && compare(records[j], record) > 0) {
+        records[j + 1] = records[j];
+        j--;
+      }
+      records[j + 1] = record;
+    }
+  }
+
+  static final Float32List _float = Float32List(1);
+  static final Uint32List _floatBits = _float.buffer.asUint32List();
+
+  /// An unsigned key ordering [value] as [double.compareTo] does, at float
+  /// precision: negative zero below zero and NaN above everything.
+  static int sortableFloatBits(double value) {
+    if (value.isNaN) return 0xFFFFFFFF;
+    _float[0] = value;
+    final bits = _floatBits[0];
+    return (bits & 0x80000000) != 0 ? ~bits & 0xFFFFFFFF : bits | 0x80000000;
+  }
+}
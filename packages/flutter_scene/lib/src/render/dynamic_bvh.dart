@@ -0,0 +1,532 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/render/bvh.dart';
+import 'package:flutter_scene/src/render/render_profile.dart';
+import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:vector_math/vector_math.dart';
+
+/// An incrementally maintained AABB tree over [RenderItem]s that come and
+/// go or move from frame to frame.
+///
+/// Where [Bvh] is built once over a settled item set, this tree supports
+/// O(log n) [insert], [remove], and [move]. Each leaf stores the item's
+/// bounds fattened by a small margin, so an item that moves within its
+/// margin costs no tree update; a leaf that escapes is removed and
+/// reinserted beside the sibling with the cheapest surface-area cost, and
+/// AVL-style rotations on the way back up keep the tree balanced.
+///
+/// Nodes live in flat typed-data arrays like [Bvh]'s, grown by doubling,
+/// with freed nodes kept on an intrusive free list so steady-state churn
+/// allocates nothing.
+///
+/// Engine-internal; owned by [SceneBvh] beside its static [Bvh].
+class DynamicBvh implements BvhQueries {
+  // The fraction of an item's largest extent its leaf box is fattened by.
+  static const double _marginFraction = 0.1;
+
+  // Node storage. Node i owns bounds[i*6..i*6+6) as
+  // (minX, minY, minZ, maxX, maxY, maxZ): the union of its children, or
+  // the fattened item bounds for a leaf, whose exact bounds are kept in
+  // tight[i*6..i*6+6). left[i] is -1 for a leaf. A free node has height
+  // -1 and chains the free list through parent.
+  Float32List _bounds = Float32List(0);
+  Float32List _tight = Float32List(0);
+  Int32List _parent = Int32List(0);
+  Int32List _left = Int32List(0);
+  Int32List _right = Int32List(0);
+  Int32List _height = Int32List(0);
+  final List<RenderItem?> _items = [];
+  int _capacity = 0;
+  int _root = -1;
+  int _free = -1;
+  int _length = 0;
+  int _nodeVisits = 0;
+
+  // Traversal stack. The rotations bound the height to about 1.44 log2(n),
+  // so 64 entries cover any realistic item count. Queries are
+  // single-threaded and never nest. [queryMany] pairs each entry with the
+  // view mask in _maskStack.
+  final Int32List _stack = Int32List(64);
+  final Int32List _maskStack = Int32List(64);
+  final FrustumBatch _batch = FrustumBatch();
+
+  // Frustum planes as (nx, ny, nz, constant) rows, reloaded per query.
+  final Float64List _planes = Float64List(24);
+
+  /// The number of items in the tree.
+  int get length => _length;
+
+  /// Nodes visited by queries since the last call, then resets the count.
+  /// Counted only when [profileRendering] is on.
+  int takeNodeVisits() {
+    final visits = _nodeVisits;
+    _nodeVisits = 0;
+    return visits;
+  }
+
+  /// Adds [item] with world-space [bounds] and returns its proxy, the
+  /// handle [move] and [remove] take.
+  int insert(RenderItem item, Aabb3 bounds) {
+    final leaf = _allocate();
+    _items[leaf] = item;
+    _storeLeafBounds(leaf, bounds);
+    _insertLeaf(leaf);
+    _length++;
+    return leaf;
+  }
+
+  /// Removes the item behind [proxy]. The proxy is invalid afterwards.
+  void remove(int proxy) {
+    _removeLeaf(proxy);
+    _release(proxy);
+    _length--;
+  }
+
+  /// Updates the item behind [proxy] to world-space [bounds], and returns
+  /// whether the leaf had to be reinserted (it escaped its fattened box).
+  bool move(int proxy, Aabb3 bounds) {
+    final o = proxy * 6;
+    final tight = _tight;
+    tight[o] = bounds.min.x;
+    tight[o + 1] = bounds.min.y;
+    tight[o + 2] = bounds.min.z;
+    tight[o + 3] = bounds.max.x;
+    tight[o + 4] = bounds.max.y;
+    tight[o + 5] = bounds.max.z;
+    final fat = _bounds;
+    if (fat[o] <= tight[o] &&
+        fat[o + 1] <= tight[o + 1] &&
+        fat[o + 2] <= tight[o + 2] &&
+        fat[o + 3] >= tight[o + 3] &&
+        fat[o + 4] >= tight[o + 4] &&
+        fat[o + 5] >= tight[o + 5]) {
+      return false;
+    }
+    _removeLeaf(proxy);
+    _storeLeafBounds(proxy, bounds);
+    _insertLeaf(proxy);
+    return true;
+  }
+
+  /// Re-reads every leaf's [RenderItem.worldBounds], moving the leaves
+  /// whose items left their fattened box. Leaves whose item became
+  /// unbounded keep their last bounds until the owner removes them.
+  void refit() {
+    for (var node = 0; node < _capacity; node++) {
+      if (_height[node] != 0) continue;
+      final bounds = _items[node]?.worldBounds;
+      if (bounds != null) move(node, bounds);
+    }
+  }
+
+  /// Calls [visit] for every item in the tree.
+  void forEachItem(void Function(RenderItem) visit) {
+    for (var node = 0; node < _capacity; node++) {
+      if (_height[node] != 0) continue;
+      final item = _items[node];
+      if (item != null) visit(item);
+    }
+  }
+
+  /// Removes every item, keeping the node storage for reuse.
+  void clear() {
+    _root = -1;
+    _free = -1;
+    _length = 0;
+    for (var node = _capacity - 1; node >= 0; node--) {
+      _items[node] = null;
+      _height[node] = -1;
+      _parent[node] = _free;
+      _free = node;
+    }
+  }
+
+  @override
+  void query(
+    Frustum frustum,
+    void Function(RenderItem) visit, {
+    List<Plane> additionalPlanes = const [],
+  }) {
+    if (_root == -1) return;
+    _loadPlane(0, frustum.plane0);
+    _loadPlane(1, frustum.plane1);
+    _loadPlane(2, frustum.plane2);
+    _loadPlane(3, frustum.plane3);
+    _loadPlane(4, frustum.plane4);
+    _loadPlane(5, frustum.plane5);
+    final planes = _planes;
+    final left = _left;
+    final stack = _stack;
+    var top = 0;
+    stack[top++] = _root;
+    while (top > 0) {
+      final node = stack[--top];
+      if (profileRendering) _nodeVisits++;
+      final isLeaf = left[node] == -1;
+      // A leaf is tested against its exact bounds so results match a
+      // brute-force test, not against the fattened box.
+      final bounds = isLeaf ? _tight : _bounds;
+      final o = node * 6;
+      var outside = false;
+      for (var p = 0; p < 24; p += 4) {
+        final nx = planes[p], ny = planes[p + 1], nz = planes[p + 2];
+        final px = nx < 0 ? bounds[o] : bounds[o + 3];
+        final py = ny < 0 ? bounds[o + 1] : bounds[o + 4];
+        final pz = nz < 0 ? bounds[o + 2] : bounds[o + 5];
+        if (nx * px + ny * py + nz * pz + planes[p + 3] < 0) {
+          outside = true;
+          break;
+        }
+      }
+      if (!outside) {
+        for (final plane in additionalPlanes) {
+          final nx = plane.normal.x;
+          final ny = plane.normal.y;
+          final nz = plane.normal.z;
+          final px = nx < 0 ? bounds[o] : bounds[o + 3];
+          final py = ny < 0 ? bounds[o + 1] : bounds[o + 4];
+          final pz = nz < 0 ? bounds[o + 2] : bounds[o + 5];
+          if (nx * px + ny * py + nz * pz + plane.constant < 0) {
+            outside = true;
+            break;
+          }
+        }
+      }
+      if (outside) continue;
+      if (isLeaf) {
+        visit(_items[node]!);
+        continue;
+      }
+      stack[top++] = left[node];
+      stack[top++] = _right[node];
+    }
+  }
+
+  @override
+  void queryAabb(Aabb3 box, void Function(RenderItem) visit) {
+    if (_root == -1) return;
+    final minX = box.min.x, minY = box.min.y, minZ = box.min.z;
+    final maxX = box.max.x, maxY = box.max.y, maxZ = box.max.z;
+    final left = _left;
+    final stack = _stack;
+    var top = 0;
+    stack[top++] = _root;
+    while (top > 0) {
+      final node = stack[--top];
+      if (profileRendering) _nodeVisits++;
+      final isLeaf = left[node] == -1;
+      final bounds = isLeaf ? _tight : _bounds;
+      final o = node * 6;
+      if (bounds[o] > maxX ||
+          bounds[o + 1] > maxY ||
+          bounds[o + 2] > maxZ ||
+          bounds[o + 3] < minX ||
+          bounds[o + 4] < minY ||
+          bounds[o + 5] < minZ) {
+        continue;
+      }
+      if (isLeaf) {
+        visit(_items[node]!);
+        continue;
+      }
+      stack[top++] = left[node];
+      stack[top++] = _right[node];
+    }
+  }
+
+  @override
+  void queryMany(
+    List<Frustum> frustums,
+    List<List<RenderItem>> visible, {
+    List<List<Plane>> additionalPlanes = const [],
+  }) {
+    assert(visible.length >= frustums.length);
+    if (_root == -1) return;
+    final batch = _batch;
+    final left = _left;
+    final stack = _stack;
+    final masks = _maskStack;
+    const batchSize = FrustumBatch.maxViews;
+    for (var start = 0; start < frustums.length; start += batchSize) {
+      final count = math.min(batchSize, frustums.length - start);
+      batch.load(frustums, additionalPlanes, start, count);
+      var top = 0;
+      stack[top] = _root;
+      masks[top++] = batch.allViews;
+      while (top > 0) {
+        final node = stack[--top];
+        if (profileRendering) _nodeVisits++;
+        final isLeaf = left[node] == -1;
+        final bounds = isLeaf ? _tight : _bounds;
+        final mask = batch.cull(bounds, node * 6, masks[top]);
+        if (mask == 0) continue;
+        if (isLeaf) {
+          FrustumBatch.scatter(_items[node]!, mask, visible, start);
+          continue;
+        }
+        stack[top] = left[node];
+        masks[top++] = mask;
+        stack[top] = _right[node];
+        masks[top++] = mask;
+      }
+    }
+  }
+
+  void _loadPlane(int index, Plane plane) {
+    final o = index * 4;
+    _planes[o] = plane.normal.x;
+    _planes[o + 1] = plane.normal.y;
+    _planes[o + 2] = plane.normal.z;
+    _planes[o + 3] = plane.constant;
+  }
+
+  void _storeLeafBounds(int leaf, Aabb3 bounds) {
+    final min = bounds.min, max = bounds.max;
+    final margin =
+        math.max(max.x - min.x, math.max(max.y - min.y, max.z - min.z)) *
+        _marginFraction;
+    final o = leaf * 6;
+    _tight[o] = min.x;
+    _tight[o + 1] = min.y;
+    _tight[o + 2] = min.z;
+    _tight[o + 3] = max.x;
+    _tight[o + 4] = max.y;
+    _tight[o + 5] = max.z;
+    _bounds[o] = min.x - margin;
+    _bounds[o + 1] = min.y - margin;
+    _bounds[o + 2] = min.z - margin;
+    _bounds[o + 3] = max.x + margin;
+    _bounds[o + 4] = max.y + margin;
+    _bounds[o + 5] = max.z + margin;
+  }
+
+  int _allocate() {
+    if (_free == -1) _grow(math.max(16, _capacity * 2));
+    final node = _free;
+    _free = _parent[node];
+    _parent[node] = -1;
+    _left[node] = -1;
+    _right[node] = -1;
+    _height[node] = 0;
+    return node;
+  }
+
+  void _release(int node) {
+    _items[node] = null;
+    _height[node] = -1;
+    _parent[node] = _free;
+    _free = node;
+  }
+
+  void _grow(int capacity) {
+    _bounds = Float32List(capacity * 6)..setAll(0, _bounds);
+    _tight = Float32List(capacity * 6)..setAll(0, _tight);
+    _parent = Int32List(capacity)..setAll(0, _parent);
+    _left = Int32List(capacity)..setAll(0, _left);
+    _right = Int32List(capacity)..setAll(0, _right);
+    _height = Int32List(capacity)..setAll(0, _height);
+    _items.length = capacity;
+    for (var node = capacity - 1; node >= _capacity; node--) {
+      _height[node] = -1;
+      _parent[node] = _free;
+      _free = node;
+    }
+    _capacity = capacity;
+  }
+
+  // Half the surface area of node [n]'s box.
+  double _area(int n) {
+    final b = _bounds, o = n * 6;
+    final dx = b[o + 3] - b[o], dy = b[o + 4] - b[o + 1];
+    final dz = b[o + 5] - b[o + 2];
+    return dx * dy + dy * dz + dz * dx;
+  }
+
+  // Half the surface area of the box enclosing nodes [a] and [b].
+  double _unionArea(int a, int b) {
+    final bounds = _bounds, oa = a * 6, ob = b * 6;
+    final dx =
+        math.max(bounds[oa + 3], bounds[ob + 3]) -
+        math.min(bounds[oa], bounds[ob]);
+    final dy =
+        math.max(bounds[oa + 4], bounds[ob + 4]) -
+        math.min(bounds[oa + 1], bounds[ob + 1]);
+    final dz =
+        math.max(bounds[oa + 5], bounds[ob + 5]) -
+        math.min(bounds[oa + 2], bounds[ob + 2]);
+    return dx * dy + dy * dz + dz * dx;
+  }
+
+  void _setUnion(int node, int a, int b) {
+    final bounds = _bounds, o = node * 6, oa = a * 6, ob = b * 6;
+    for (var axis = 0; axis < 3; axis++) {
+      final aMin = bounds[oa + axis], bMin = bounds[ob + axis];
+      bounds[o + axis] = aMin < bMin ? aMin : bMin;
+      final aMax = bounds[oa + 3 + axis], bMax = bounds[ob + 3 + axis];
+      bounds[o + 3 + axis] = aMax > bMax ? aMax : bMax;
+    }
+  }
+
+  // The cost of descending into [child] to place [leaf] below it.
+  double _descendCost(int child, int leaf) {
+    final union = _unionArea(child, leaf);
+    return _left[child] == -1 ? union : union - _area(child);
+  }
+
+  void _insertLeaf(int leaf) {
+    if (_root == -1) {
+      _root = leaf;
+      _parent[leaf] = -1;
+      return;
+    }
+
+    // Walk down toward the sibling whose union with the leaf grows the
+    // tree's total surface area least.
+    var index = _root;
+    while (_left[index] != -1) {
+      final combined = _unionArea(index, leaf);
+      // Pairing with this node creates a parent of area `combined`;
+      // descending further also enlarges this node by the difference.
+      final cost = 2 * combined;
+      final inheritance = 2 * (combined - _area(index));
+      final leftCost = _descendCost(_left[index], leaf) + inheritance;
+      final rightCost = _descendCost(_right[index], leaf) + inheritance;
+      if (cost < leftCost && cost < rightCost) break;
+      index = leftCost < rightCost ? _left[index] : _right[index];
+    }
+
+    final sibling = index;
+    final oldParent = _parent[sibling];
+    final newParent = _allocate();
+    _parent[newParent] = oldParent;
+    _setUnion(newParent, sibling, leaf);
+    _height[newParent] = _height[sibling] + 1;
+    if (oldParent == -1) {
+      _root = newParent;
+    } else if (_left[oldParent] == sibling) {
+      _left[oldParent] = newParent;
+    } else {
+      _right[oldParent] = newParent;
+    }
+    _left[newParent] = sibling;
+    _right[newParent] = leaf;
+    _parent[sibling] = newParent;
+    _parent[leaf] = newParent;
+    _refitAncestors(newParent);
+  }
+
+  void _removeLeaf(int leaf) {
+    if (leaf == _root) {
+      _root = -1;
+      return;
+    }
+    final parent = _parent[leaf];
+    final grandParent = _parent[parent];
+    final sibling = _left[parent] == leaf ? _right[parent] : _left[parent];
+    _parent[leaf] = -1;
+    if (grandParent == -1) {
+      _root = sibling;
+      _parent[sibling] = -1;
+      _release(parent);
+      return;
+    }
+    if (_left[grandParent] == parent) {
+      _left[grandParent] = sibling;
+    } else {
+      _right[grandParent] = sibling;
+    }
+    _parent[sibling] = grandParent;
+    _release(parent);
+    _refitAncestors(grandParent);
+  }
+
+  // Rebalances and refreshes the bounds and height of [node] and every
+  // ancestor up to the root.
+  void _refitAncestors(int node) {
+    var index = node;
+    while (index != -1) {
+      index = _balance(index);
+      final left = _left[index], right = _right[index];
+      _height[index] = 1 + math.max(_height[left], _height[right]);
+      _setUnion(index, left, right);
+      index = _parent[index];
+    }
+  }
+
+  // Rotates the taller grandchild of [a] up when [a]'s subtrees differ in
+  // height by more than one, and returns the node now in [a]'s place.
+  int _balance(int a) {
+    if (_left[a] == -1 || _height[a] < 2) return a;
+    final b = _left[a], c = _right[a];
+    final balance = _height[c] - _height[b];
+
+    if (balance > 1) {
+      // Rotate c up.
+      final f = _left[c], g = _right[c];
+      _left[c] = a;
+      _parent[c] = _parent[a];
+      _parent[a] = c;
+      _replaceChild(_parent[c], a, c);
+      if (_height[f] > _height[g]) {
+        _right[c] = f;
+        _right[a] = g;
+        _parent[g] = a;
+        _setUnion(a, b, g);
+        _setUnion(c, a, f);
+        _height[a] = 1 + math.max(_height[b], _height[g]);
+        _height[c] = 1 + math.max(_height[a], _height[f]);
+      } else {
+        _right[c] = g;
+        _right[a] = f;
+        _parent[f] = a;
+        _setUnion(a, b, f);
+        _setUnion(c, a, g);
+        _height[a] = 1 + math.max(_height[b], _height[f]);
+        _height[c] = 1 + math.max(_height[a], _height[g]);
+      }
+      return c;
+    }
+
+    if (balance < -1) {
+      // Rotate b up.
+      final d = _left[b], e = _right[b];
+      _left[b] = a;
+      _parent[b] = _parent[a];
+      _parent[a] = b;
+      _replaceChild(_parent[b], a, b);
+      if (_height[d] > _height[e]) {
+        _right[b] = d;
+        _left[a] = e;
+        _parent[e] = a;
+        _setUnion(a, c, e);
+        _setUnion(b, a, d);
+        _height[a] = 1 + math.max(_height[c], _height[e]);
+        _height[b] = 1 + math.max(_height[a], _height[d]);
+      } else {
+        _right[b] = e;
+        _left[a] = d;
+        _parent[d] = a;
+        _setUnion(a, c, d);
+        _setUnion(b, a, e);
+        _height[a] = 1 + math.max(_height[c], _height[d]);
+        _height[b] = 1 + math.max(_height[a], _height[e]);
+      }
+      return b;
+    }
+
+    return a;
+  }
+
+  // Points [parent]'s link to [from] at [to], or the root when [parent] is
+  // -1.
+  void _replaceChild(int parent, int from, int to) {
+    if (parent == -1) {
+      _root = to;
+    } else if (_left[parent] == from) {
+      _left[parent] = to;
+    } else {
+      _right[parent] = to;
+    }
+  }
+}
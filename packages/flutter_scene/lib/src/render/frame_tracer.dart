@@ -0,0 +1,170 @@
+/// Opt-in per-frame CPU timeline: nested spans and counters recorded as
+/// Chrome trace events, which `chrome://tracing` and Perfetto load.
+///
+/// The engine reads [FrameTracer.active] once per instrumented region and
+/// does nothing else while it is null, so an untraced frame pays a static
+/// field load per span. Pure Dart (no GPU), so traces can be captured in
+/// headless tests and diffed in CI; pass a deterministic `clock` there.
+library;
+
+import 'dart:convert';
+
+/// Records the engine's spans (frame, tick, physics steps, component
+/// ticks, animation, transform refresh, BVH update and queries, light
+/// culling, draw sorting, instance packing, encoding, and every render
+/// graph pass) and counters (culled items, draws, uploaded bytes) while it
+/// is [active].
+///
+/// ```dart
+/// final tracer = FrameTracer.start();
+/// // ... render some frames ...
+/// File('frames.json').writeAsStringSync(FrameTracer.stop()!.encode());
+/// ```
+/// {@category Rendering}
+class FrameTracer {
+  /// Creates a tracer. [clock] returns microseconds and defaults to a
+  /// monotonic stopwatch; events past [maxEvents] are dropped (and counted
+  /// in [droppedEvents]) so a forgotten tracer cannot grow without bound.
+  FrameTracer({int Function()? clock, this.maxEvents = 1 << 20})
+    : _clock = clock ?? _stopwatchClock();
+
+  /// The tracer the engine records into, or null (the default) for none.
+  static FrameTracer? active;
+
+  /// Creates a tracer and makes it [active].
+  static FrameTracer start({int Function()? clock, int maxEvents = 1 << 20}) =>
+      active = FrameTracer(clock: clock, maxEvents: maxEvents);
+
+  /// Deactivates the [active] tracer, closing any spans still open, and
+  /// returns it.
+  static FrameTracer? stop() {
+    final tracer = active;
+    active = null;
+    if (tracer != null) {
+      while (tracer._open.isNotEmpty) {
+        tracer.end();
+      }
+    }
+    return tracer;
+  }
+
+  final int Function() _clock;
+
+  /// The most events kept; later ones are dropped.
+  final int maxEvents;
+
+  final List<_TraceEvent> _events = [];
+
+  // The names of the open spans, innermost last; null for a span whose
+  // begin event was dropped, so its end is dropped too.
+  final List<String?> _open = [];
+
+  int _droppedEvents = 0;
+  int _frames = 0;
+
+  /// The number of events recorded.
+  int get eventCount => _events.length;
+
+  /// The number of events dropped past [maxEvents].
+  int get droppedEvents => _droppedEvents;
+
+  /// The number of frames started with [beginFrame].
+  int get frameCount => _frames;
+
+  /// Opens a span named [name], closed by the matching [end]. Spans nest.
+  void begin(
+    String name, {
+    String category = 'engine',
+    Map<String, Object>? args,
+  }) {
+    if (_events.length >= maxEvents) {
+      _droppedEvents++;
+      _open.add(null);
+      return;
+    }
+    _events.add(_TraceEvent('B', name, category, _clock(), args));
+    _open.add(name);
+  }
+
+  /// Closes the innermost open span. Ignored when none is open.
+  void end() {
+    if (_open.isEmpty) return;
+    final name = _open.removeLast();
+    if (name == null) {
+      _droppedEvents++;
+      return;
+    }
+    // An end is always kept so every recorded span closes.
+    _events.add(_TraceEvent('E', name, '', _clock(), null));
+  }
+
+  /// Records the [values] of the counter track [name] at this instant.
+  void counter(String name, Map<String, num> values) {
+    if (_events.length >= maxEvents) {
+      _droppedEvents++;
+      return;
+    }
+    _events.add(_TraceEvent('C', name, 'counter', _clock(), values));
+  }
+
+  /// Opens the span of one rendered frame, numbered by [frameCount].
+  void beginFrame() => begin('frame', args: {'index': _frames});
+
+  /// Closes the span [beginFrame] opened.
+  void endFrame() {
+    end();
+    _frames++;
+  }
+
+  /// Discards every recorded event.
+  void clear() {
+    _events.clear();
+    _open.clear();
+    _droppedEvents = 0;
+    _frames = 0;
+  }
+
+  /// The trace in the Chrome trace-event JSON object format.
+  Map<String, Object> toJson() => {
+    'traceEvents': [
+      {
+        'name': 'process_name',
+        'ph': 'M',
+        'pid': 1,
+        'tid': 1,
+        'args': {'name': 'flutter_scene'},
+      },
+      for (final event in _events) event.toJson(),
+    ],
+    'displayTimeUnit': 'ms',
+    'otherData': {'droppedEvents': _droppedEvents},
+  };
+
+  /// [toJson] encoded as a string, ready to write to a `.json` file.
+  String encode() => jsonEncode(toJson());
+}
+
+int Function() _stopwatchClock() {
+  final stopwatch = Stopwatch()..start();
+  return () => stopwatch.elapsedMicroseconds;
+}
+
+class _TraceEvent {
+  _TraceEvent(this.phase, this.name, this.category, this.timestamp, this.args);
+
+  final String phase;
+  final String name;
+  final String category;
+  final int timestamp;
+  final Map<String, Object>? args;
+
+  Map<String, Object> toJson() => {
+    'name': name,
+    if (category.isNotEmpty) 'cat': category,
+    'ph': phase,
+    'ts': timestamp,
+    'pid': 1,
+    'tid': 1,
+    'args': ?args,
+  };
+}
@@ -2,6 +2,7 @@ import 'dart:collection';
 
 import 'package:flutter/foundation.dart';
 import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/render/render_profile.dart';
 // Whether GPU commands execute while passes are encoded (the WebGL2 backend)
 // rather than after submission. Decides the default transients strategy.
 import 'package:flutter_scene/src/render/transients_execution_native.dart'
@@ -61,6 +62,53 @@ class GpuSubmissionTracker {
 /// The tracker for every command buffer the renderer submits.
 final GpuSubmissionTracker rendererSubmissions = GpuSubmissionTracker();
 
+/// A ring of retained buffer slots, reused only once the GPU is done with
+/// them.
+///
+/// A slot is stamped with the submission that will read it (the next one
+/// [tracker] records) each time it is claimed or [touch]ed, and is free
+/// again once [GpuSubmissionTracker.completedThrough] reaches that stamp,
+/// the same rule the transient arenas recycle blocks by. This holds however
+/// many scenes render per display frame.
+@internal
+class SubmissionStampedSlots {
+  SubmissionStampedSlots(int length, [GpuSubmissionTracker? tracker])
+    : _stamps = List<int>.filled(length, 0, growable: true),
+      _tracker = tracker ?? rendererSubmissions;
+
+  final List<int> _stamps;
+  final GpuSubmissionTracker _tracker;
+  int _cursor = 0;
+
+  int get length => _stamps.length;
+
+  /// Claims the next slot no submitted work still reads and stamps it for
+  /// the coming submission, or returns null when every slot is in flight.
+  int? claim() {
+    final completed = _tracker.completedThrough;
+    for (var i = 1; i <= _stamps.length; i++) {
+      final slot = (_cursor + i) % _stamps.length;
+      if (_stamps[slot] > completed) continue;
+      _cursor = slot;
+      touch(slot);
+      return slot;
+    }
+    return null;
+  }
+
+  /// Appends a slot for a caller whose every slot is in flight, claims it,
+  /// and returns it.
+  int grow() {
+    _stamps.add(0);
+    _cursor = _stamps.length - 1;
+    touch(_cursor);
+    return _cursor;
+  }
+
+  /// Marks [slot] as read by the coming submission (a rebind).
+  void touch(int slot) => _stamps[slot] = _tracker.latestSubmission + 1;
+}
+
 /// Destination for per-frame transient GPU data (uniform blocks, instance
 /// vertex data). Emplaced data is valid for the current frame only.
 ///
@@ -80,6 +128,148 @@ abstract interface class FrameTransients implements TransientWriter {
   /// Recycles completed buffers and resets frame stats. Called once per
   /// frame from the render setup.
   void beginFrame();
+
+  /// The activity of the frame the latest [beginFrame] ended.
+  TransientFrameStats get lastFrameStats;
+}
+
+/// One frame of a [FrameTransients]' activity, for telemetry.
+///
+/// A frame runs from one [FrameTransients.beginFrame] to the next; the
+/// pool figures ([inFlightBlocks], [releasedBlocks], [pooledBytes]) are
+/// taken by the `beginFrame` that ends it.
+///
+/// {@category Rendering}
+class TransientFrameStats {
+  const TransientFrameStats({
+    this.emplacements = 0,
+    this.bytesEmplaced = 0,
+    this.wastedBytes = 0,
+    this.blocksAcquired = 0,
+    this.blocksAllocated = 0,
+    this.peakLiveBlocks = 0,
+    this.oversizeHits = 0,
+    this.stalls = 0,
+    this.inFlightBlocks = 0,
+    this.releasedBlocks = 0,
+    this.pooledBytes = 0,
+  });
+
+  /// Emplacements and the bytes they carried.
+  final int emplacements;
+  final int bytesEmplaced;
+
+  /// Capacity of the blocks acquired this frame that held no emplaced
+  /// bytes: alignment padding, unused block tails, and size-class rounding.
+  final int wastedBytes;
+
+  /// Blocks handed out this frame, and how many of them were new
+  /// allocations rather than recycled.
+  final int blocksAcquired;
+  final int blocksAllocated;
+
+  /// The most blocks the pool held at once.
+  final int peakLiveBlocks;
+
+  /// Emplacements larger than a standard block.
+  final int oversizeHits;
+
+  /// Allocations made while a block of the same size was pooled but its
+  /// GPU work had not completed.
+  final int stalls;
+
+  /// Pooled blocks still waiting for GPU completion when the frame ended.
+  final int inFlightBlocks;
+
+  /// Idle blocks the frame-end shrink dropped.
+  final int releasedBlocks;
+
+  /// Capacity of the blocks pooled after the shrink.
+  final int pooledBytes;
+
+  @override
+  String toString() =>
+      'TransientFrameStats(emplacements: $emplacements, '
+      'bytesEmplaced: $bytesEmplaced, wastedBytes: $wastedBytes, '
+      'blocksAcquired: $blocksAcquired, blocksAllocated: $blocksAllocated, '
+      'peakLiveBlocks: $peakLiveBlocks, oversizeHits: $oversizeHits, '
+      'stalls: $stalls, inFlightBlocks: $inFlightBlocks, '
+      'releasedBlocks: $releasedBlocks, pooledBytes: $pooledBytes)';
+}
+
+/// How a [FrameTransients] sizes its blocks and returns idle ones, for
+/// long-running apps whose load settles below the defaults.
+///
+/// Without a policy, pools keep last frame's usage plus a spare and a
+/// [TransientArena]'s block size is fixed.
+///
+/// {@category Rendering}
+class TransientSizingPolicy {
+  const TransientSizingPolicy({
+    this.windowFrames = 120,
+    this.idleFrames = 60,
+    this.minBlockLengthInBytes = 16 * 1024,
+    this.maxBlockLengthInBytes = 4 * 1024 * 1024,
+  });
+
+  /// The rolling window, in frames, a [TransientArena] sizes its blocks
+  /// from. Blocks grow as soon as one submission stages more than a block
+  /// holds, and shrink only after a whole window fits in a smaller size.
+  final int windowFrames;
+
+  /// A completed block unused for more than this many frames is released.
+  final int idleFrames;
+
+  /// The bounds of a [TransientArena]'s adaptive block size.
+  final int minBlockLengthInBytes;
+  final int maxBlockLengthInBytes;
+}
+
+// Per-frame counters behind [TransientFrameStats].
+class _FrameCounters {
+  int emplacements = 0;
+  int bytesEmplaced = 0;
+  int bytesAcquired = 0;
+  int blocksAcquired = 0;
+  int blocksAllocated = 0;
+  int peakLiveBlocks = 0;
+  int oversizeHits = 0;
+  int stalls = 0;
+
+  void acquired(_TransientBlock block, {required bool allocated}) {
+    blocksAcquired++;
+    bytesAcquired += block.length;
+    if (allocated) blocksAllocated++;
+  }
+
+  TransientFrameStats finish({
+    required int inFlightBlocks,
+    required int releasedBlocks,
+    required int pooledBytes,
+  }) {
+    final stats = TransientFrameStats(
+      emplacements: emplacements,
+      bytesEmplaced: bytesEmplaced,
+      wastedBytes: bytesAcquired - bytesEmplaced,
+      blocksAcquired: blocksAcquired,
+      blocksAllocated: blocksAllocated,
+      peakLiveBlocks: peakLiveBlocks,
+      oversizeHits: oversizeHits,
+      stalls: stalls,
+      inFlightBlocks: inFlightBlocks,
+      releasedBlocks: releasedBlocks,
+      pooledBytes: pooledBytes,
+    );
+    emplacements = 0;
+    bytesEmplaced = 0;
+    bytesAcquired = 0;
+    blocksAcquired = 0;
+    blocksAllocated = 0;
+    peakLiveBlocks = 0;
+    oversizeHits = 0;
+    stalls = 0;
+    return stats;
+  }
 }
 
 /// Per-emplacement pooled transients for the immediate-execution WebGL2
@@ -96,7 +286,7 @@ abstract interface class FrameTransients implements TransientWriter {
 /// and idle buffers beyond the previous frame's usage (plus a spare per
 /// class) are dropped, the same policies as [TransientArena].
 class ImmediatePoolTransients implements FrameTransients {
-  ImmediatePoolTransients(this._tracker) {
+  ImmediatePoolTransients(this._tracker, {this.sizing}) {
     _tracker.addBeforeSubmitListener(_onBeforeSubmit);
   }
 
@@ -105,6 +295,11 @@ class ImmediatePoolTransients implements FrameTransients {
 
   final GpuSubmissionTracker _tracker;
 
+  /// When set, completed buffers are released once idle for
+  /// [TransientSizingPolicy.idleFrames] frames instead of beyond last
+  /// frame's usage.
+  final TransientSizingPolicy? sizing;
+
   /// Buffers handed out since the last submission; stamped by it.
   final List<_TransientBlock> _used = [];
 
@@ -115,10 +310,17 @@ class ImmediatePoolTransients implements FrameTransients {
   final Map<int, int> _lastFrameUse = {};
   final Map<int, int> _thisFrameUse = {};
 
+  final _FrameCounters _counters = _FrameCounters();
+  TransientFrameStats _lastFrameStats = const TransientFrameStats();
+  int _frame = 0;
+
   /// Total live buffers. For tests.
   @visibleForTesting
   int get bufferCount => _used.length + _pooled.length;
 
+  @override
+  TransientFrameStats get lastFrameStats => _lastFrameStats;
+
   static int _sizeClassFor(int length) {
     var size = kMinBufferLengthInBytes;
     while (size < length) {
@@ -133,23 +335,41 @@ class ImmediatePoolTransients implements FrameTransients {
     final sizeClass = _sizeClassFor(length);
     final completed = _tracker.completedThrough;
 
+    // With a sizing policy, the most recently used buffer first, so
+    // surplus buffers go idle and are released.
     _TransientBlock? block;
-    for (var i = 0; i < _pooled.length; i++) {
+    var stalled = false;
+    final pooled = _pooled.length;
+    for (var n = 0; n < pooled; n++) {
+      final i = sizing == null ? n : pooled - 1 - n;
       final candidate = _pooled[i];
-      if (candidate.length == sizeClass && candidate.stamp <= completed) {
-        block = candidate;
-        _pooled.removeAt(i);
-        break;
+      if (candidate.length != sizeClass) continue;
+      if (candidate.stamp > completed) {
+        stalled = true;
+        continue;
       }
+      block = candidate;
+      _pooled.removeAt(i);
+      break;
     }
+    final allocated = block == null;
     block ??= _TransientBlock(
       gpu.gpuContext.createDeviceBuffer(gpu.StorageMode.hostVisible, sizeClass),
       ByteData(0), // No CPU staging: writes go straight to the device.
       sizeClass,
       false,
     );
+    block.lastUsedFrame = _frame;
     _used.add(block);
     _thisFrameUse[sizeClass] = (_thisFrameUse[sizeClass] ?? 0) + 1;
+    _counters
+      ..emplacements += 1
+      ..bytesEmplaced += length
+      ..acquired(block, allocated: allocated);
+    if (allocated && stalled) _counters.stalls++;
+    if (bufferCount > _counters.peakLiveBlocks) {
+      _counters.peakLiveBlocks = bufferCount;
+    }
 
     // Device-resident before the view is returned: the immediate backend
     // consumes it as soon as the caller binds and draws.
@@ -179,21 +399,45 @@ class ImmediatePoolTransients implements FrameTransients {
     _onBeforeSubmit(_tracker.latestSubmission);
 
     // Shrink: per size class, keep completed buffers up to last frame's
-    // usage plus one spare; drop the rest.
+    // usage plus one spare (or, with a sizing policy, those used recently);
+    // drop the rest.
     final completed = _tracker.completedThrough;
+    final policy = sizing;
     final kept = <int, int>{};
+    var inFlight = 0;
+    var released = 0;
+    var pooledBytes = 0;
     _pooled.removeWhere((block) {
-      if (block.stamp > completed) return false; // still in flight
-      final keep = (_lastFrameUse[block.length] ?? 0) + 1;
-      final count = (kept[block.length] ?? 0) + 1;
-      kept[block.length] = count;
-      return count > keep;
+      final bool drop;
+      if (block.stamp > completed) {
+        inFlight++; // still in flight
+        drop = false;
+      } else if (policy != null) {
+        drop = _frame - block.lastUsedFrame > policy.idleFrames;
+      } else {
+        final keep = (_lastFrameUse[block.length] ?? 0) + 1;
+        final count = (kept[block.length] ?? 0) + 1;
+        kept[block.length] = count;
+        drop = count > keep;
+      }
+      if (drop) {
+        released++;
+      } else {
+        pooledBytes += block.length;
+      }
+      return drop;
     });
 
     _lastFrameUse
       ..clear()
       ..addAll(_thisFrameUse);
     _thisFrameUse.clear();
+    _lastFrameStats = _counters.finish(
+      inFlightBlocks: inFlight,
+      releasedBlocks: released,
+      pooledBytes: pooledBytes,
+    );
+    _frame++;
   }
 }
 
@@ -204,9 +448,10 @@ class ImmediatePoolTransients implements FrameTransients {
 FrameTransients createFrameTransients(
   GpuSubmissionTracker tracker, {
   int? alignment,
+  TransientSizingPolicy? sizing,
 }) => kImmediateGpuExecution
-    ? ImmediatePoolTransients(tracker)
-    : TransientArena(tracker, alignment: alignment);
+    ? ImmediatePoolTransients(tracker, sizing: sizing)
+    : TransientArena(tracker, alignment: alignment, sizing: sizing);
 
 /// A completion-aware bump allocator for per-frame transient GPU data.
 ///
@@ -227,12 +472,19 @@ FrameTransients createFrameTransients(
 /// after load spikes. Requests larger than [blockLengthInBytes] use pooled
 /// power-of-two size classes so a changing visible-instance count does not
 /// allocate a new CPU/GPU buffer every frame.
+///
+/// With a [sizing] policy, idle blocks are instead released after a number
+/// of quiet frames, and the block size follows the load (see
+/// [TransientBlockSizer]).
 class TransientArena implements FrameTransients {
   TransientArena(
     this._tracker, {
     int? alignment,
-    this.blockLengthInBytes = kDefaultBlockLengthInBytes,
-  }) : _alignmentOverride = alignment {
+    int blockLengthInBytes = kDefaultBlockLengthInBytes,
+    this.sizing,
+  }) : _alignmentOverride = alignment,
+       _blockLength = blockLengthInBytes,
+       _sizer = sizing == null ? null : TransientBlockSizer(sizing) {
     _tracker.addBeforeSubmitListener(_onBeforeSubmit);
   }
 
@@ -242,7 +494,17 @@ class TransientArena implements FrameTransients {
   static const int kDefaultBlockLengthInBytes = 256 * 1024;
 
   final GpuSubmissionTracker _tracker;
-  final int blockLengthInBytes;
+
+  /// When set, idle blocks are released after
+  /// [TransientSizingPolicy.idleFrames] quiet frames and the block size
+  /// adapts to the load.
+  final TransientSizingPolicy? sizing;
+  final TransientBlockSizer? _sizer;
+
+  /// The standard block size: the constructor's, or under [sizing] the
+  /// current adaptive one.
+  int get blockLengthInBytes => _blockLength;
+  int _blockLength;
 
   /// Emplacement alignment. When null, the GPU context's minimum uniform
   /// alignment is used (resolved lazily; the context itself initializes on
@@ -271,35 +533,62 @@ class TransientArena implements FrameTransients {
   final Map<int, int> _lastOversizeUse = {};
   final Map<int, int> _thisOversizeUse = {};
 
+  final _FrameCounters _counters = _FrameCounters();
+  TransientFrameStats _lastFrameStats = const TransientFrameStats();
+  int _frame = 0;
+
+  /// Bytes staged into standard blocks since the last submission.
+  int _stagedSinceSubmit = 0;
+
   /// Total pooled blocks (open + sealed). For tests.
   @visibleForTesting
   int get blockCount => _open.length + _sealed.length;
 
+  @override
+  TransientFrameStats get lastFrameStats => _lastFrameStats;
+
   /// Begins a new frame: applies the shrink policy and resets frame stats.
   /// Open blocks from the previous frame (possible when a frame emplaced
   /// data but submitted nothing) seal with the latest submission stamp, so
   /// they stay safe against any in-flight work.
   @override
   void beginFrame() {
-    for (final block in _open) {
-      _seal(block, _tracker.latestSubmission);
-    }
-    _open.clear();
+    _onBeforeSubmit(_tracker.latestSubmission);
 
-    // Shrink each capacity class to last frame's usage plus one spare.
+    // Shrink each capacity class to last frame's usage plus one spare, or
+    // under a sizing policy drop blocks idle too long and standard blocks
+    // of a previous size.
     final completed = _tracker.completedThrough;
+    final policy = sizing;
     final keepStandard = _lastFrameBlockCount + 1;
     var idleStandard = 0;
     final keptOversize = <int, int>{};
+    var inFlight = 0;
+    var released = 0;
+    var pooledBytes = 0;
     _sealed.removeWhere((block) {
-      if (block.stamp > completed) return false; // still in flight
-      if (block.oversize) {
+      final bool drop;
+      if (block.stamp > completed) {
+        inFlight++; // still in flight
+        drop = false;
+      } else if (policy != null) {
+        drop =
+            _frame - block.lastUsedFrame > policy.idleFrames ||
+            (!block.oversize && block.length != _blockLength);
+      } else if (block.oversize) {
         final count = (keptOversize[block.length] ?? 0) + 1;
         keptOversize[block.length] = count;
-        return count > (_lastOversizeUse[block.length] ?? 0) + 1;
+        drop = count > (_lastOversizeUse[block.length] ?? 0) + 1;
+      } else {
+        idleStandard++;
+        drop = idleStandard > keepStandard;
       }
-      idleStandard++;
-      return idleStandard > keepStandard;
+      if (drop) {
+        released++;
+      } else {
+        pooledBytes += block.length;
+      }
+      return drop;
     });
 
     _lastFrameBlockCount = _thisFrameBlockCount;
@@ -308,6 +597,16 @@ class TransientArena implements FrameTransients {
       ..clear()
       ..addAll(_thisOversizeUse);
     _thisOversizeUse.clear();
+    _lastFrameStats = _counters.finish(
+      inFlightBlocks: inFlight,
+      releasedBlocks: released,
+      pooledBytes: pooledBytes,
+    );
+    // Blocks of the old size drain through the shrink above as their
+    // work completes.
+    final sizer = _sizer;
+    if (sizer != null) _blockLength = sizer.endFrame(_blockLength);
+    _frame++;
   }
 
   /// Decides where an emplacement of [length] lands: at the aligned offset
@@ -335,7 +634,10 @@ class TransientArena implements FrameTransients {
   @override
   gpu.BufferView emplace(ByteData bytes) {
     final length = bytes.lengthInBytes;
-    if (length > blockLengthInBytes) {
+    _counters
+      ..emplacements += 1
+      ..bytesEmplaced += length;
+    if (length > _blockLength) {
       return _emplaceOversize(bytes);
     }
 
@@ -352,7 +654,7 @@ class TransientArena implements FrameTransients {
       if (plan.rollOver) block = null;
     }
     if (block == null) {
-      block = _acquireBlock(blockLengthInBytes);
+      block = _acquireBlock(_blockLength);
       _open.add(block);
       _thisFrameBlockCount++;
       offset = 0;
@@ -378,6 +680,7 @@ class TransientArena implements FrameTransients {
     final block = _acquireBlock(capacity, oversize: true);
     _open.add(block);
     _thisOversizeUse[capacity] = (_thisOversizeUse[capacity] ?? 0) + 1;
+    _counters.oversizeHits++;
     block.staging.buffer
         .asUint8List(block.staging.offsetInBytes)
         .setRange(
@@ -394,30 +697,48 @@ class TransientArena implements FrameTransients {
   }
 
   int _oversizeSizeClass(int length) {
-    var capacity = blockLengthInBytes;
+    var capacity = _blockLength;
     while (capacity < length) {
       capacity <<= 1;
     }
     return capacity;
   }
 
-  /// Reuses a completed pooled block or creates a new one.
+  /// Reuses a completed pooled block or creates a new one. With a sizing
+  /// policy the most recently used block goes first, so surplus blocks go
+  /// idle and are released.
   _TransientBlock _acquireBlock(int length, {bool oversize = false}) {
     final completed = _tracker.completedThrough;
-    for (var i = 0; i < _sealed.length; i++) {
-      final block = _sealed[i];
-      if (block.stamp > completed) continue;
-      if (block.oversize != oversize) continue;
-      if (block.length != length) continue;
+    _TransientBlock? block;
+    var stalled = false;
+    final sealed = _sealed.length;
+    for (var n = 0; n < sealed; n++) {
+      final i = sizing == null ? n : sealed - 1 - n;
+      final candidate = _sealed[i];
+      if (candidate.oversize != oversize) continue;
+      if (candidate.length != length) continue;
+      if (candidate.stamp > completed) {
+        stalled = true;
+        continue;
+      }
       _sealed.removeAt(i);
-      block.cursor = 0;
-      return block;
+      candidate.cursor = 0;
+      block = candidate;
+      break;
     }
-    final device = gpu.gpuContext.createDeviceBuffer(
-      gpu.StorageMode.hostVisible,
+    final allocated = block == null;
+    block ??= _TransientBlock(
+      gpu.gpuContext.createDeviceBuffer(gpu.StorageMode.hostVisible, length),
+      ByteData(length),
       length,
+      oversize,
     );
-    return _TransientBlock(device, ByteData(length), length, oversize);
+    block.lastUsedFrame = _frame;
+    _counters.acquired(block, allocated: allocated);
+    if (allocated && stalled) _counters.stalls++;
+    final live = blockCount + 1;
+    if (live > _counters.peakLiveBlocks) _counters.peakLiveBlocks = live;
+    return block;
   }
 
   /// Uploads and seals every open block. Runs just before each submission,
@@ -429,9 +750,12 @@ class TransientArena implements FrameTransients {
       _seal(block, id);
     }
     _open.clear();
+    _sizer?.addSubmission(_stagedSinceSubmit);
+    _stagedSinceSubmit = 0;
   }
 
   void _seal(_TransientBlock block, int stamp) {
+    if (!block.oversize) _stagedSinceSubmit += block.cursor;
     if (block.cursor > 0) {
       final ok = block.device.overwrite(
         ByteData.sublistView(block.staging, 0, block.cursor),
@@ -466,12 +790,71 @@ class _TransientBlock {
 
   /// The last submission id that may reference this block's device buffer.
   int stamp = 0;
+
+  /// The frame that last acquired it, for the idle policy.
+  int lastUsedFrame = 0;
+}
+
+/// Picks a [TransientArena]'s block size under a [TransientSizingPolicy].
+///
+/// Every submission seals the blocks it staged into, so a block size that
+/// holds the largest submission in one block never rolls over, and any
+/// larger size only holds memory idle. The sizer takes the smallest power
+/// of two within the policy's bounds that holds the largest submission of a
+/// rolling window. It grows at once (the frame after the submission that
+/// outgrew the block) and shrinks only after a whole window since the last
+/// change, so the first frames keep the constructor's size and a brief lull
+/// does not trade memory for rollovers.
+class TransientBlockSizer {
+  TransientBlockSizer(this.policy);
+
+  final TransientSizingPolicy policy;
+
+  // The largest submission of each frame in the window.
+  final List<int> _window = [];
+  int _windowCursor = 0;
+  int _frameLargest = 0;
+  int _framesSinceResize = 0;
+
+  /// Records a submission that staged [bytes] into standard blocks.
+  void addSubmission(int bytes) {
+    if (bytes > _frameLargest) _frameLargest = bytes;
+  }
+
+  /// Closes the frame and returns the block size to use next, given the
+  /// [current] one.
+  int endFrame(int current) {
+    if (_window.length < policy.windowFrames) {
+      _window.add(_frameLargest);
+    } else {
+      _window[_windowCursor] = _frameLargest;
+      _windowCursor = (_windowCursor + 1) % policy.windowFrames;
+    }
+    _frameLargest = 0;
+    _framesSinceResize++;
+
+    var largest = 0;
+    for (final bytes in _window) {
+      if (bytes > largest) largest = bytes;
+    }
+    var target = policy.minBlockLengthInBytes;
+    while (target < largest && target < policy.maxBlockLengthInBytes) {
+      target <<= 1;
+    }
+    final grow = target > current;
+    final shrink =
+        target < current && _framesSinceResize >= policy.windowFrames;
+    if (!grow && !shrink) return current;
+    _framesSinceResize = 0;
+    return target;
+  }
 }
 
 /// The renderer's per-frame uniform transients (alignment resolved from the
 /// GPU context's minimum uniform alignment).
 final FrameTransients uniformTransients = createFrameTransients(
   rendererSubmissions,
+  sizing: const TransientSizingPolicy(),
 );
 
 /// The renderer's per-frame instance-rate vertex transients. Vertex fetch
@@ -479,4 +862,43 @@ final FrameTransients uniformTransients = createFrameTransients(
 final FrameTransients instanceTransients = createFrameTransients(
   rendererSubmissions,
   alignment: 16,
+  sizing: const TransientSizingPolicy(),
 );
+
+final RenderProfileAccumulator _transientsProfile = RenderProfileAccumulator();
+
+/// Adds the shared transients' last-frame stats to the profile, printed as
+/// `FLUTTER_SCENE_PROFILE_TRANSIENTS` once per sample window. Call after
+/// their [FrameTransients.beginFrame] when [profileRendering] is on.
+void recordTransientsProfile() {
+  for (final (name, transients) in [
+    ('uniform', uniformTransients),
+    ('instance', instanceTransients),
+  ]) {
+    final stats = transients.lastFrameStats;
+    _transientsProfile
+      ..add('${name}_bytes', stats.bytesEmplaced)
+      ..add('${name}_wasted', stats.wastedBytes)
+      ..add('${name}_blocks', stats.peakLiveBlocks, trackMax: true)
+      ..add('${name}_pooled', stats.pooledBytes, trackMax: true)
+      ..add('${name}_in_flight', stats.inFlightBlocks, trackMax: true)
+      ..add('${name}_oversize', stats.oversizeHits)
+      ..add('${name}_stalls', stats.stalls)
+      ..add('${name}_released', stats.releasedBlocks);
+  }
+  final snapshot = _transientsProfile.endSample();
+  if (snapshot == null) return;
+  final fields = [
+    for (final name in ['uniform', 'instance'])
+      '${name}_kib_mean=${snapshot.mean('${name}_bytes') ~/ 1024} '
+          '${name}_wasted_kib_mean=${snapshot.mean('${name}_wasted') ~/ 1024} '
+          '${name}_blocks_max=${snapshot.max('${name}_blocks')} '
+          '${name}_pooled_kib_max=${snapshot.max('${name}_pooled') ~/ 1024} '
+          '${name}_in_flight_max=${snapshot.max('${name}_in_flight')} '
+          '${name}_oversize_total=${snapshot.total('${name}_oversize')} '
+          '${name}_stalls_total=${snapshot.total('${name}_stalls')} '
+          '${name}_released_total=${snapshot.total('${name}_released')}',
+  ];
+  // ignore: avoid_print
+  print('FLUTTER_SCENE_PROFILE_TRANSIENTS ${fields.join(' ')}');
+}
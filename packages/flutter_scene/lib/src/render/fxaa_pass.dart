@@ -52,6 +52,16 @@ class FxaaPass extends RenderGraphPass {
   @override
   String get name => 'FxaaPass';
 
+  @override
+  Set<Object> get inputs => const {kDisplayColorBlackboardKey};
+
+  @override
+  Set<Object> get outputs => const {kDisplayColorBlackboardKey};
+
+  // Writes the caller's output color.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final input = context.blackboard.require<gpu.Texture>(
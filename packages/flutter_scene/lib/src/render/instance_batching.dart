@@ -17,6 +17,19 @@ abstract interface class OpaqueBatchRecord {
 
 int opaqueBatchEnd(List<OpaqueBatchRecord> records, int start) {
   final first = records[start];
+  if (!_opaqueBatchable(first)) return start + 1;
+  var end = start + 1;
+  while (end < records.length && _canBatchOpaque(first, records[end])) {
+    end++;
+  }
+  return end;
+}
+
+/// Whether [next] belongs in the batch [opaqueBatchEnd] starts at [first].
+bool opaqueBatchJoins(OpaqueBatchRecord first, OpaqueBatchRecord next) =>
+    _opaqueBatchable(first) && _canBatchOpaque(first, next);
+
+bool _opaqueBatchable(OpaqueBatchRecord first) {
   // Skinned and morphed items carry per-item state (skeleton, weights)
   // bound outside the instance buffer, so they draw unbatched. Batching also
   // synthesizes one instance per node, and a node carries no per-instance
@@ -24,17 +37,10 @@ int opaqueBatchEnd(List<OpaqueBatchRecord> records, int start) {
   // (each from its own instanced mesh's data).
   // TODO(instance-attributes-batching): give a node a per-node attribute
   // source so these can batch too.
-  if (first.geometry.instancedVertexLayout == null ||
-      first.jointsTexture != null ||
-      first.morphWeights != null ||
-      first.material.instanceAttributes != null) {
-    return start + 1;
-  }
-  var end = start + 1;
-  while (end < records.length && _canBatchOpaque(first, records[end])) {
-    end++;
-  }
-  return end;
+  return first.geometry.instancedVertexLayout != null &&
+      first.jointsTexture == null &&
+      first.morphWeights == null &&
+      first.material.instanceAttributes == null;
 }
 
 bool _canBatchOpaque(OpaqueBatchRecord first, OpaqueBatchRecord next) {
@@ -49,27 +55,45 @@ bool _canBatchOpaque(OpaqueBatchRecord first, OpaqueBatchRecord next) {
       next.morphWeights == null;
 }
 
+/// Depth-only draw order: material, then geometry, so [depthBatchEnd] runs
+/// are adjacent.
+int compareDepthRecords(RenderItem a, RenderItem b) {
+  final byMaterial = identityHashCode(
+    a.material,
+  ).compareTo(identityHashCode(b.material));
+  if (byMaterial != 0) return byMaterial;
+  return identityHashCode(a.geometry).compareTo(identityHashCode(b.geometry));
+}
+
+/// Sorts [records] into [compareDepthRecords] order from scratch.
+void sortDepthRecords(List<RenderItem> records) =>
+    records.sort(compareDepthRecords);
+
 int depthBatchEnd(List<RenderItem> records, int start) {
   final first = records[start];
-  if (first.geometry.instancedVertexLayout == null ||
-      first.jointsTexture != null ||
-      first.morphWeights != null) {
-    return start + 1;
-  }
+  if (!_depthBatchable(first)) return start + 1;
   var end = start + 1;
-  while (end < records.length) {
-    final next = records[end];
-    if (!identical(first.geometry, next.geometry) ||
-        !identical(first.material, next.material) ||
-        next.jointsTexture != null ||
-        next.morphWeights != null) {
-      break;
-    }
+  while (end < records.length && _canBatchDepth(first, records[end])) {
     end++;
   }
   return end;
 }
 
+/// Whether [next] belongs in the batch [depthBatchEnd] starts at [first].
+bool depthBatchJoins(RenderItem first, RenderItem next) =>
+    _depthBatchable(first) && _canBatchDepth(first, next);
+
+bool _depthBatchable(RenderItem first) =>
+    first.geometry.instancedVertexLayout != null &&
+    first.jointsTexture == null &&
+    first.morphWeights == null;
+
+bool _canBatchDepth(RenderItem first, RenderItem next) =>
+    identical(first.geometry, next.geometry) &&
+    identical(first.material, next.material) &&
+    next.jointsTexture == null &&
+    next.morphWeights == null;
+
 InstanceDataBatch instanceDataBatchFor(
   RenderItem item, {
   required List<int>? indices,
@@ -0,0 +1,404 @@
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+/// A two-level cluster hierarchy over one instanced item's per-instance
+/// world bounds, so a view that sees a corner of a large instance field
+/// tests a few hundred cluster boxes instead of every instance.
+///
+/// Instances are ordered along a Morton curve of their bound centers and
+/// cut into clusters of [clusterSize], and clusters into groups of
+/// [groupSize]. [cull] rejects whole groups and clusters outside a plane,
+/// accepts those inside every plane without testing their instances, and
+/// tests only the planes a partially visible cluster straddles against
+/// its instances.
+///
+/// Moved instances are reported with [markMoved]; their clusters are
+/// refit before the next [cull] and keep their membership. Once the
+/// refits have loosened the clusters to twice their built size, or the
+/// instance count changes, the next [cull] rebuilds.
+///
+/// Engine-internal; owned by [RenderItem] for items with many culled
+/// instances.
+class InstanceCullTree {
+  /// Instances per cluster.
+  static const int clusterSize = 64;
+
+  /// Clusters per group.
+  static const int groupSize = 16;
+
+  /// The most planes [cull] tracks per box; views with more are not
+  /// culled through the tree.
+  static const int maxPlanes = 30;
+
+  int _count = -1;
+  // Instance indices in Morton order; cluster c holds
+  // members[c * clusterSize, (c + 1) * clusterSize).
+  Int32List _members = Int32List(0);
+  // The cluster each instance belongs to.
+  Int32List _clusterOf = Int32List(0);
+  Float32List _clusterBounds = Float32List(0);
+  Float32List _groupBounds = Float32List(0);
+  int _clusterCount = 0;
+  int _groupCount = 0;
+
+  // Clusters awaiting a refit, flagged and listed, or every cluster.
+  Uint8List _clusterDirty = Uint8List(0);
+  final List<int> _dirtyClusters = [];
+  bool _refitAll = false;
+  // The summed cluster extents when built and now; their ratio measures
+  // how far refits have loosened the clusters.
+  double _builtExtent = 0;
+  double _extent = 0;
+  bool _needsBuild = true;
+
+  static final Float32List _planes = Float32List(maxPlanes * 4);
+
+  /// Records that the bounds of instances in `[start, end)` changed.
+  void markMoved(int start, int end) {
+    if (_needsBuild || _refitAll || start >= end) return;
+    if (end - start >= _clusterCount) {
+      _refitAll = true;
+      return;
+    }
+    final clusterOf = _clusterOf;
+    for (var i = start; i < end && i < _count; i++) {
+      final cluster = clusterOf[i];
+      if (_clusterDirty[cluster] == 0) {
+        _clusterDirty[cluster] = 1;
+        _dirtyClusters.add(cluster);
+      }
+    }
+  }
+
+  /// Adds to [visible] every instance whose bounds (six floats per
+  /// instance in [bounds], [count] instances) are not entirely outside one
+  /// of [frustum]'s planes or [additionalPlanes], in cluster order.
+  ///
+  /// Returns false, adding nothing, when there are more than [maxPlanes]
+  /// planes.
+  bool cull(
+    Float32List bounds,
+    int count,
+    Frustum frustum,
+    List<Plane> additionalPlanes,
+    List<int> visible,
+  ) {
+    final planeCount = 6 + additionalPlanes.length;
+    if (planeCount > maxPlanes) return false;
+    if (_needsBuild || count != _count) {
+      _build(bounds, count);
+    } else if (_refitAll || _dirtyClusters.isNotEmpty) {
+      _refit(bounds);
+      if (_extent > _builtExtent * 2 + 1e-6) _build(bounds, count);
+    }
+
+    final planes = _planes;
+    _loadPlane(0, frustum.plane0);
+    _loadPlane(1, frustum.plane1);
+    _loadPlane(2, frustum.plane2);
+    _loadPlane(3, frustum.plane3);
+    _loadPlane(4, frustum.plane4);
+    _loadPlane(5, frustum.plane5);
+    for (var p = 0; p < additionalPlanes.length; p++) {
+      _loadPlane(6 + p, additionalPlanes[p]);
+    }
+    final allPlanes = (1 << planeCount) - 1;
+    final members = _members;
+    for (var group = 0; group < _groupCount; group++) {
+      final groupMask = _classify(_groupBounds, group * 6, allPlanes, planes);
+      if (groupMask < 0) continue;
+      final firstCluster = group * groupSize;
+      var lastCluster = firstCluster + groupSize;
+      if (lastCluster > _clusterCount) lastCluster = _clusterCount;
+      if (groupMask == 0) {
+        _addMembers(
+          visible,
+          firstCluster * clusterSize,
+          lastCluster * clusterSize,
+        );
+        continue;
+      }
+      for (var cluster = firstCluster; cluster < lastCluster; cluster++) {
+        final mask = _classify(_clusterBounds, cluster * 6, groupMask, planes);
+        if (mask < 0) continue;
+        final lo = cluster * clusterSize;
+        if (mask == 0) {
+          _addMembers(visible, lo, lo + clusterSize);
+          continue;
+        }
+        var hi = lo + clusterSize;
+        if (hi > count) hi = count;
+        for (var k = lo; k < hi; k++) {
+          final instance = members[k];
+          if (!_outside(bounds, instance * 6, mask, planes)) {
+            visible.add(instance);
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  void _addMembers(List<int> visible, int lo, int hi) {
+    final members = _members;
+    final end = hi < _count ? hi : _count;
+    for (var k = lo; k < end; k++) {
+      visible.add(members[k]);
+    }
+  }
+
+  static void _loadPlane(int index, Plane plane) {
+    final o = index * 4;
+    _planes[o] = plane.normal.x;
+    _planes[o + 1] = plane.normal.y;
+    _planes[o + 2] = plane.normal.z;
+    _planes[o + 3] = plane.constant;
+  }
+
+  // The planes in [mask] the box at [o] straddles, 0 when it is inside
+  // them all, or -1 when it is outside one.
+  static int _classify(Float32List bounds, int o, int mask, Float32List p) {
+    var straddled = 0;
+    var remaining = mask;
+    while (remaining != 0) {
+      final bit = remaining & -remaining;
+      remaining ^= bit;
+      final q = (bit.bitLength - 1) * 4;
+      final nx = p[q], ny = p[q + 1], nz = p[q + 2], d = p[q + 3];
+      // The corners farthest along and against the normal.
+      final far =
+          nx * bounds[o + (nx < 0 ? 0 : 3)] +
+          ny * bounds[o + (ny < 0 ? 1 : 4)] +
+          nz * bounds[o + (nz < 0 ? 2 : 5)] +
+          d;
+      if (far < 0) return -1;
+      final near =
+          nx * bounds[o + (nx < 0 ? 3 : 0)] +
+          ny * bounds[o + (ny < 0 ? 4 : 1)] +
+          nz * bounds[o + (nz < 0 ? 5 : 2)] +
+          d;
+      if (near < 0) straddled |= bit;
+    }
+    return straddled;
+  }
+
+  static bool _outside(Float32List bounds, int o, int mask, Float32List p) {
+    var remaining = mask;
+    while (remaining != 0) {
+      final bit = remaining & -remaining;
+      remaining ^= bit;
+      final q = (bit.bitLength - 1) * 4;
+      final nx = p[q], ny = p[q + 1], nz = p[q + 2];
+      if (nx * bounds[o + (nx < 0 ? 0 : 3)] +
+              ny * bounds[o + (ny < 0 ? 1 : 4)] +
+              nz * bounds[o + (nz < 0 ? 2 : 5)] +
+              p[q + 3] <
+          0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void _build(Float32List bounds, int count) {
+    _count = count;
+    _clusterCount = (count + clusterSize - 1) ~/ clusterSize;
+    _groupCount = (_clusterCount + groupSize - 1) ~/ groupSize;
+    if (_members.length != count) {
+      _members = Int32List(count);
+      _clusterOf = Int32List(count);
+    }
+    if (_clusterDirty.length != _clusterCount) {
+      _clusterDirty = Uint8List(_clusterCount);
+      _clusterBounds = Float32List(_clusterCount * 6);
+      _groupBounds = Float32List(_groupCount * 6);
+    } else {
+      _clusterDirty.fillRange(0, _clusterCount, 0);
+    }
+    _dirtyClusters.clear();
+    _refitAll = false;
+    _needsBuild = false;
+    _sortMorton(bounds, count);
+    final clusterOf = _clusterOf;
+    final members = _members;
+    for (var k = 0; k < count; k++) {
+      clusterOf[members[k]] = k ~/ clusterSize;
+    }
+    _extent = 0;
+    for (var cluster = 0; cluster < _clusterCount; cluster++) {
+      _extent += _fitCluster(bounds, cluster);
+    }
+    _builtExtent = _extent;
+    for (var group = 0; group < _groupCount; group++) {
+      _fitGroup(group);
+    }
+  }
+
+  void _refit(Float32List bounds) {
+    if (_refitAll) {
+      _extent = 0;
+      for (var cluster = 0; cluster < _clusterCount; cluster++) {
+        _extent += _fitCluster(bounds, cluster);
+      }
+      for (var group = 0; group < _groupCount; group++) {
+        _fitGroup(group);
+      }
+      _clusterDirty.fillRange(0, _clusterCount, 0);
+    } else {
+      for (final cluster in _dirtyClusters) {
+        _extent -= _clusterExtent(cluster);
+        _extent += _fitCluster(bounds, cluster);
+        _clusterDirty[cluster] = 0;
+      }
+      // Each dirty cluster's group once: flag it through its first cluster.
+      for (final cluster in _dirtyClusters) {
+        final group = cluster ~/ groupSize;
+        final first = group * groupSize;
+        if (_clusterDirty[first] == 2) continue;
+        _clusterDirty[first] = 2;
+        _fitGroup(group);
+      }
+      for (final cluster in _dirtyClusters) {
+        _clusterDirty[cluster ~/ groupSize * groupSize] = 0;
+      }
+    }
+    _dirtyClusters.clear();
+    _refitAll = false;
+  }
+
+  double _clusterExtent(int cluster) {
+    final b = _clusterBounds;
+    final o = cluster * 6;
+    return (b[o + 3] - b[o]) + (b[o + 4] - b[o + 1]) + (b[o + 5] - b[o + 2]);
+  }
+
+  // Fits [cluster]'s box to its members and returns its summed extent.
+  double _fitCluster(Float32List bounds, int cluster) {
+    final members = _members;
+    final lo = cluster * clusterSize;
+    var hi = lo + clusterSize;
+    if (hi > _count) hi = _count;
+    var minX = double.infinity, minY = double.infinity, minZ = double.infinity;
+    var maxX = -double.infinity,
+        maxY = -double.infinity,
+        maxZ = -double.infinity;
+    for (var k = lo; k < hi; k++) {
+      final o = members[k] * 6;
+      if (bounds[o] < minX) minX = bounds[o];
+      if (bounds[o + 1] < minY) minY = bounds[o + 1];
+      if (bounds[o + 2] < minZ) minZ = bounds[o + 2];
+      if (bounds[o + 3] > maxX) maxX = bounds[o + 3];
+      if (bounds[o + 4] > maxY) maxY = bounds[o + 4];
+      if (bounds[o + 5] > maxZ) maxZ = bounds[o + 5];
+    }
+    final b = _clusterBounds;
+    final o = cluster * 6;
+    b[o] = minX;
+    b[o + 1] = minY;
+    b[o + 2] = minZ;
+    b[o + 3] = maxX;
+    b[o + 4] = maxY;
+    b[o + 5] = maxZ;
+    return (maxX - minX) + (maxY - minY) + (maxZ - minZ);
+  }
+
+  void _fitGroup(int group) {
+    final clusters = _clusterBounds;
+    final b = _groupBounds;
+    final o = group * 6;
+    final first = group * groupSize;
+    var last = first + groupSize;
+    if (last > _clusterCount) last = _clusterCount;
+    for (var axis = 0; axis < 3; axis++) {
+      var min = double.infinity, max = -double.infinity;
+      for (var cluster = first; cluster < last; cluster++) {
+        final c = cluster * 6;
+        if (clusters[c + axis] < min) min = clusters[c + axis];
+        if (clusters[c + 3 + axis] > max) max = clusters[c + 3 + axis];
+      }
+      b[o + axis] = min;
+      b[o + 3 + axis] = max;
+    }
+  }
+
+  static Uint32List _keys = Uint32List(0);
+  static Int32List _scratch = Int32List(0);
+  static final Uint32List _histogram = Uint32List(1024);
+
+  // Orders [_members] by the 30-bit Morton key of each instance's bound
+  // center, three 10-bit radix passes.
+  void _sortMorton(Float32List bounds, int count) {
+    var minX = double.infinity, minY = double.infinity, minZ = double.infinity;
+    var maxX = -double.infinity,
+        maxY = -double.infinity,
+        maxZ = -double.infinity;
+    for (var i = 0; i < count; i++) {
+      final o = i * 6;
+      final cx = bounds[o] + bounds[o + 3];
+      final cy = bounds[o + 1] + bounds[o + 4];
+      final cz = bounds[o + 2] + bounds[o + 5];
+      if (cx < minX) minX = cx;
+      if (cy < minY) minY = cy;
+      if (cz < minZ) minZ = cz;
+      if (cx > maxX) maxX = cx;
+      if (cy > maxY) maxY = cy;
+      if (cz > maxZ) maxZ = cz;
+    }
+    final spanX = maxX - minX, spanY = maxY - minY, spanZ = maxZ - minZ;
+    final scaleX = spanX > 0 ? 1023.0 / spanX : 0.0;
+    final scaleY = spanY > 0 ? 1023.0 / spanY : 0.0;
+    final scaleZ = spanZ > 0 ? 1023.0 / spanZ : 0.0;
+    if (_keys.length < count) {
+      _keys = Uint32List(count);
+      _scratch = Int32List(count);
+    }
+    final keys = _keys;
+    for (var i = 0; i < count; i++) {
+      final o = i * 6;
+      final qx = ((bounds[o] + bounds[o + 3] - minX) * scaleX).toInt();
+      final qy = ((bounds[o + 1] + bounds[o + 4] - minY) * scaleY).toInt();
+      final qz = ((bounds[o + 2] + bounds[o + 5] - minZ) * scaleZ).toInt();
+      keys[i] =
+          _spreadBits(qx) | (_spreadBits(qy) << 1) | (_spreadBits(qz) << 2);
+    }
+    var order = _members;
+    var scratch = _scratch;
+    for (var i = 0; i < count; i++) {
+      order[i] = i;
+    }
+    final histogram = _histogram;
+    for (var shift = 0; shift < 30; shift += 10) {
+      histogram.fillRange(0, 1024, 0);
+      for (var i = 0; i < count; i++) {
+        histogram[(keys[order[i]] >> shift) & 1023]++;
+      }
+      var sum = 0;
+      for (var bucket = 0; bucket < 1024; bucket++) {
+        final n = histogram[bucket];
+        histogram[bucket] = sum;
+        sum += n;
+      }
+      for (var i = 0; i < count; i++) {
+        final index = order[i];
+        scratch[histogram[(keys[index] >> shift) & 1023]++] = index;
+      }
+      final swap = order;
+      order = scratch;
+      scratch = swap;
+    }
+    // Three passes leave the result in the scratch buffer.
+    _members.setRange(0, count, order);
+  }
+
+  // Spreads the low 10 bits of [value] so consecutive bits land three
+  // apart (Morton interleave).
+  static int _spreadBits(int value) {
+    var x = value & 0x3ff;
+    x = (x | (x << 16)) & 0x030000ff;
+    x = (x | (x << 8)) & 0x0300f00f;
+    x = (x | (x << 4)) & 0x030c30c3;
+    x = (x | (x << 2)) & 0x09249249;
+    return x;
+  }
+}
@@ -0,0 +1,371 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'package:flutter_scene/src/render/light_culling.dart';
+
+/// A view-space froxel grid binning punctual lights into clusters: screen
+/// tiles [tilesX] x [tilesY] split into [slices] exponential depth slices
+/// between the view's near and far planes.
+///
+/// Each fragment finds its cluster from its screen UV and view depth (see
+/// [clusterAt], mirrored by `PunctualLightSlice` in
+/// `shaders/material_shadow_sampling.glsl`) and loops only the lights binned
+/// there. Binning is a conservative tile/slice range per light followed by a
+/// tight test against each candidate cluster's view-space bounds: sphere vs
+/// AABB for point and area lights, plus a cone vs bounding-sphere test for
+/// spots. The cost scales with lights times the clusters they touch and is
+/// independent of the draw count.
+///
+/// Buffers are reused across builds, so a steady scene allocates nothing per
+/// frame. Tile row 0 is the top of the screen (UV y = 0 at NDC y = +1).
+class LightClusterGrid {
+  LightClusterGrid({this.tilesX = 16, this.tilesY = 9, this.slices = 24})
+    : assert(tilesX > 0 && tilesY > 0 && slices > 0),
+      _counts = Int32List(tilesX * tilesY * slices),
+      _offsets = Int32List(tilesX * tilesY * slices),
+      _cursors = Int32List(tilesX * tilesY * slices),
+      _bounds = Float64List(tilesX * tilesY * slices * 6);
+
+  /// The grid dimensions.
+  final int tilesX;
+  final int tilesY;
+  final int slices;
+
+  /// The number of clusters, `tilesX * tilesY * slices`.
+  int get clusterCount => tilesX * tilesY * slices;
+
+  /// Per cluster, the light count and the start of its slice of [indices].
+  /// Valid after [build] or [buildGlobal]; a global build fills cluster 0
+  /// only.
+  Int32List get counts => _counts;
+  Int32List get offsets => _offsets;
+  final Int32List _counts;
+  final Int32List _offsets;
+  final Int32List _cursors;
+
+  /// The flattened per-cluster light rows; only the first [indexCount] entries
+  /// are meaningful.
+  Int32List get indices => _indices;
+  Int32List _indices = Int32List(256);
+
+  /// The number of valid entries in [indices].
+  int get indexCount => _indexCount;
+  int _indexCount = 0;
+
+  /// Whether the last build dropped lights from a cluster past its budget.
+  bool get overflowed => _overflowed;
+  bool _overflowed = false;
+
+  /// Whether the last build was [buildGlobal] (a single cluster for every
+  /// fragment).
+  bool get isGlobal => _global;
+  bool _global = false;
+
+  /// Maps view depth to a slice: `floor(log(depth) * sliceScale + sliceBias)`.
+  /// Both are zero after [buildGlobal].
+  double get sliceScale => _sliceScale;
+  double get sliceBias => _sliceBias;
+  double _sliceScale = 0.0;
+  double _sliceBias = 0.0;
+
+  // View-space AABB of every cluster (min xyz, max xyz), rebuilt when the
+  // frustum changes.
+  final Float64List _bounds;
+  double _tanX = -1.0;
+  double _tanY = -1.0;
+  double _near = -1.0;
+  double _far = -1.0;
+
+  // (cluster, light row) pairs for the ranged lights, in light order.
+  Int32List _pairs = Int32List(512);
+  int _pairCount = 0;
+
+  /// Bins [lights] into the froxels of the view described by [view] (world to
+  /// view, x right, y up, z forward as built by `Camera.getViewMatrix`), the
+  /// half-angle tangents of its field of view, and its [near]/[far] planes.
+  ///
+  /// Lights with no position or range reach every cluster and come first in
+  /// each list. Lights whose channel mask misses the default item channels are
+  /// skipped; items on other channels keep their per-item lists. Each cluster
+  /// keeps at most [maxPerCluster] lights, dropping the excess in light order.
+  void build({
+    required Matrix4 view,
+    required double tanHalfFovX,
+    required double tanHalfFovY,
+    required double near,
+    required double far,
+    required List<CullableLight> lights,
+    required int maxPerCluster,
+  }) {
+    assert(near > 0.0 && far > near);
+    _global = false;
+    if (tanHalfFovX != _tanX ||
+        tanHalfFovY != _tanY ||
+        near != _near ||
+        far != _far) {
+      _tanX = tanHalfFovX;
+      _tanY = tanHalfFovY;
+      _near = near;
+      _far = far;
+      _rebuildBounds();
+    }
+    final logRange = math.log(far / near);
+    _sliceScale = slices / logRange;
+    _sliceBias = -slices * math.log(near) / logRange;
+
+    final count = clusterCount;
+    _counts.fillRange(0, count, 0);
+    _pairCount = 0;
+    var infiniteCount = 0;
+    final m = view.storage;
+    for (final light in lights) {
+      if ((light.channelMask & _defaultChannels) == 0) continue;
+      final position = light.worldPosition;
+      final range = light.range;
+      if (position == null || range <= 0.0) {
+        infiniteCount++;
+        continue;
+      }
+      final px = position.x;
+      final py = position.y;
+      final pz = position.z;
+      final vx = m[0] * px + m[4] * py + m[8] * pz + m[12];
+      final vy = m[1] * px + m[5] * py + m[9] * pz + m[13];
+      final vz = m[2] * px + m[6] * py + m[10] * pz + m[14];
+      final zLo = math.max(vz - range, near);
+      final zHi = math.min(vz + range, far);
+      if (zLo > zHi) continue;
+
+      // Conservative tile range: x / z over the sphere's view AABB peaks at
+      // its corners.
+      final xLo = vx - range;
+      final xHi = vx + range;
+      final yLo = vy - range;
+      final yHi = vy + range;
+      final ndcMinX = math.min(xLo / zLo, xLo / zHi) / tanHalfFovX;
+      final ndcMaxX = math.max(xHi / zLo, xHi / zHi) / tanHalfFovX;
+      final ndcMinY = math.min(yLo / zLo, yLo / zHi) / tanHalfFovY;
+      final ndcMaxY = math.max(yHi / zLo, yHi / zHi) / tanHalfFovY;
+      if (ndcMinX > 1.0 || ndcMaxX < -1.0) continue;
+      if (ndcMinY > 1.0 || ndcMaxY < -1.0) continue;
+      final tx0 = _tile(ndcMinX * 0.5 + 0.5, tilesX);
+      final tx1 = _tile(ndcMaxX * 0.5 + 0.5, tilesX);
+      final ty0 = _tile(0.5 - ndcMaxY * 0.5, tilesY);
+      final ty1 = _tile(0.5 - ndcMinY * 0.5, tilesY);
+      final s0 = _slice(zLo);
+      final s1 = _slice(zHi);
+
+      // A spot also tests its cone against each cluster's bounding sphere.
+      final direction = light.spotDirection;
+      final isSpot = direction != null && light.spotAngle < math.pi * 0.5;
+      var dx = 0.0;
+      var dy = 0.0;
+      var dz = 0.0;
+      var cosAngle = 0.0;
+      var sinAngle = 0.0;
+      if (isSpot) {
+        dx = m[0] * direction.x + m[4] * direction.y + m[8] * direction.z;
+        dy = m[1] * direction.x + m[5] * direction.y + m[9] * direction.z;
+        dz = m[2] * direction.x + m[6] * direction.y + m[10] * direction.z;
+        final length = math.sqrt(dx * dx + dy * dy + dz * dz);
+        if (length > 0.0) {
+          dx /= length;
+          dy /= length;
+          dz /= length;
+        }
+        cosAngle = math.cos(light.spotAngle);
+        sinAngle = math.sin(light.spotAngle);
+      }
+
+      final rangeSquared = range * range;
+      final b = _bounds;
+      for (var s = s0; s <= s1; s++) {
+        for (var ty = ty0; ty <= ty1; ty++) {
+          for (var tx = tx0; tx <= tx1; tx++) {
+            final cluster = (s * tilesY + ty) * tilesX + tx;
+            final o = cluster * 6;
+            final minX = b[o];
+            final minY = b[o + 1];
+            final minZ = b[o + 2];
+            final maxX = b[o + 3];
+            final maxY = b[o + 4];
+            final maxZ = b[o + 5];
+            final ex = vx < minX ? minX - vx : (vx > maxX ? vx - maxX : 0.0);
+            final ey = vy < minY ? minY - vy : (vy > maxY ? vy - maxY : 0.0);
+            final ez = vz < minZ ? minZ - vz : (vz > maxZ ? vz - maxZ : 0.0);
+            if (ex * ex + ey * ey + ez * ez > rangeSquared) continue;
+            if (isSpot) {
+              final hx = (maxX - minX) * 0.5;
+              final hy = (maxY - minY) * 0.5;
+              final hz = (maxZ - minZ) * 0.5;
+              final radius = math.sqrt(hx * hx + hy * hy + hz * hz);
+              final cx = minX + hx - vx;
+              final cy = minY + hy - vy;
+              final cz = minZ + hz - vz;
+              final along = cx * dx + cy * dy + cz * dz;
+              final lengthSquared = cx * cx + cy * cy + cz * cz;
+              final across = math.sqrt(
+                math.max(lengthSquared - along * along, 0.0),
+              );
+              if (cosAngle * across - along * sinAngle > radius ||
+                  along > radius + range ||
+                  along < -radius) {
+                continue;
+              }
+            }
+            _addPair(cluster, light.index);
+          }
+        }
+      }
+    }
+
+    _fill(count, lights, infiniteCount, maxPerCluster);
+  }
+
+  /// Bins [lights] into a single cluster every fragment reads, for views the
+  /// froxel grid cannot describe (non-perspective projections).
+  void buildGlobal({
+    required List<CullableLight> lights,
+    required int maxPerCluster,
+  }) {
+    _global = true;
+    _sliceScale = 0.0;
+    _sliceBias = 0.0;
+    _pairCount = 0;
+    var infiniteCount = 0;
+    for (final light in lights) {
+      if ((light.channelMask & _defaultChannels) == 0) continue;
+      if (light.worldPosition == null || light.range <= 0.0) {
+        infiniteCount++;
+      } else {
+        _addPair(0, light.index);
+      }
+    }
+    _fill(1, lights, infiniteCount, maxPerCluster);
+  }
+
+  /// The cluster a fragment at view-space ([viewX], [viewY], [viewZ]) reads,
+  /// computed the way the shader does from its screen UV and view depth.
+  /// Cluster 0 after [buildGlobal].
+  int clusterAt(double viewX, double viewY, double viewZ) {
+    if (_global) return 0;
+    final u = 0.5 + 0.5 * viewX / (viewZ * _tanX);
+    final v = 0.5 - 0.5 * viewY / (viewZ * _tanY);
+    final tx = _tile(u, tilesX);
+    final ty = _tile(v, tilesY);
+    final s = _slice(viewZ);
+    return (s * tilesY + ty) * tilesX + tx;
+  }
+
+  // Items that never set lightChannelMask read the clusters, so only the
+  // lights reaching those channels are binned.
+  static const int _defaultChannels = 0xFF;
+
+  static int _tile(double uv, int tiles) =>
+      (uv * tiles).floor().clamp(0, tiles - 1);
+
+  int _slice(double depth) =>
+      (math.log(math.max(depth, 1e-6)) * _sliceScale + _sliceBias)
+          .floor()
+          .clamp(0, slices - 1);
+
+  void _addPair(int cluster, int row) {
+    if (_pairCount * 2 + 2 > _pairs.length) {
+      _pairs = Int32List(_pairs.length * 2)
+        ..setRange(0, _pairCount * 2, _pairs);
+    }
+    _pairs[_pairCount * 2] = cluster;
+    _pairs[_pairCount * 2 + 1] = row;
+    _pairCount++;
+  }
+
+  // Counts, prefix-sums, and scatters the pairs, with the [infiniteCount]
+  // unbounded lights first in each of the first [count] clusters.
+  void _fill(
+    int count,
+    List<CullableLight> lights,
+    int infiniteCount,
+    int maxPerCluster,
+  ) {
+    final infinite = math.min(infiniteCount, maxPerCluster);
+    _overflowed = infiniteCount > maxPerCluster;
+    for (var c = 0; c < count; c++) {
+      _counts[c] = infinite;
+    }
+    for (var p = 0; p < _pairCount; p++) {
+      _counts[_pairs[p * 2]]++;
+    }
+    var total = 0;
+    for (var c = 0; c < count; c++) {
+      var n = _counts[c];
+      if (n > maxPerCluster) {
+        n = maxPerCluster;
+        _overflowed = true;
+      }
+      _counts[c] = n;
+      _offsets[c] = total;
+      total += n;
+    }
+    if (total > _indices.length) {
+      var capacity = _indices.length;
+      while (capacity < total) {
+        capacity *= 2;
+      }
+      _indices = Int32List(capacity);
+    }
+    _indexCount = total;
+    if (total == 0) return;
+
+    // Unbounded lights head every list; fill cursors then track the rest.
+    if (infinite > 0) {
+      var i = 0;
+      for (final light in lights) {
+        if (i == infinite) break;
+        if ((light.channelMask & _defaultChannels) == 0) continue;
+        if (light.worldPosition != null && light.range > 0.0) continue;
+        _indices[i++] = light.index;
+      }
+      for (var c = 1; c < count; c++) {
+        _indices.setRange(_offsets[c], _offsets[c] + infinite, _indices);
+      }
+    }
+    final cursors = _cursors;
+    for (var c = 0; c < count; c++) {
+      cursors[c] = infinite;
+    }
+    for (var p = 0; p < _pairCount; p++) {
+      final cluster = _pairs[p * 2];
+      final cursor = cursors[cluster];
+      if (cursor >= _counts[cluster]) continue;
+      _indices[_offsets[cluster] + cursor] = _pairs[p * 2 + 1];
+      cursors[cluster] = cursor + 1;
+    }
+  }
+
+  void _rebuildBounds() {
+    final b = _bounds;
+    final ratio = _far / _near;
+    for (var s = 0; s < slices; s++) {
+      final zNear = _near * math.pow(ratio, s / slices);
+      final zFar = _near * math.pow(ratio, (s + 1) / slices);
+      for (var ty = 0; ty < tilesY; ty++) {
+        // Row 0 is the top of the screen.
+        final top = (1.0 - 2.0 * ty / tilesY) * _tanY;
+        final bottom = (1.0 - 2.0 * (ty + 1) / tilesY) * _tanY;
+        for (var tx = 0; tx < tilesX; tx++) {
+          final left = (2.0 * tx / tilesX - 1.0) * _tanX;
+          final right = (2.0 * (tx + 1) / tilesX - 1.0) * _tanX;
+          final o = ((s * tilesY + ty) * tilesX + tx) * 6;
+          b[o] = math.min(left * zNear, left * zFar);
+          b[o + 1] = math.min(bottom * zNear, bottom * zFar);
+          b[o + 2] = zNear;
+          b[o + 3] = math.max(right * zNear, right * zFar);
+          b[o + 4] = math.max(top * zNear, top * zFar);
+          b[o + 5] = zFar;
+        }
+      }
+    }
+  }
+}
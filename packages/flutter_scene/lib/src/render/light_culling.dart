@@ -12,12 +12,19 @@ import 'package:flutter_scene/src/render/render_scene.dart';
 /// spot light with no range), so the light reaches every item and is never
 /// culled. A null [worldPosition] identifies a directional light, which sorts
 /// ahead of local lights because its influence is independent of distance.
+///
+/// The froxel cluster builder tests the exact influence sphere ([range] around
+/// [worldPosition]) and, for a spot, its cone ([spotDirection], [spotAngle])
+/// rather than [bounds].
 class CullableLight {
   const CullableLight(
     this.index,
     this.bounds, {
     this.worldPosition,
     this.channelMask = 0xFF,
+    this.range = 0.0,
+    this.spotDirection,
+    this.spotAngle = 0.0,
   });
 
   final int index;
@@ -27,6 +34,17 @@ class CullableLight {
   /// The light's channel mask; it reaches an item only when this intersects
   /// [RenderItem.lightChannelMask].
   final int channelMask;
+
+  /// The radius of the influence sphere around [worldPosition], or `0` for
+  /// infinite influence.
+  final double range;
+
+  /// A spot's world-space travel direction (unit length), or null for a light
+  /// that shines every way.
+  final Vector3? spotDirection;
+
+  /// A spot's outer cone half-angle in radians.
+  final double spotAngle;
 }
 
 /// The world-space AABB a point or spot light at [worldPosition] with [range]
@@ -64,7 +82,7 @@ class LightCullResult {
 /// the excess is dropped and flagged in the result.
 LightCullResult assignLightsToItems({
   required List<RenderItem> items,
-  required Bvh bvh,
+  required BvhQueries bvh,
   required List<CullableLight> lights,
   required int maxPerItem,
 }) {
@@ -32,6 +32,20 @@ double lodScreenSize({
   return radius / (distance * math.tan(fovRadiansY / 2));
 }
 
+/// A camera a frame was rendered from, as per-object level-of-detail
+/// policies measure against it: its `position`, vertical field of view
+/// (null for a non-perspective camera), and `frustum`.
+///
+/// A `shadow` view is a shadow map's light frustum rather than a camera:
+/// what it contains may cast a shadow on screen, but its size there says
+/// nothing about how large it appears, so only containment counts.
+typedef LodView = ({
+  Vector3 position,
+  double? fovRadiansY,
+  Frustum frustum,
+  bool shadow,
+});
+
 /// Selects the level-of-detail index for a projected [screenSize] against a
 /// list of [thresholds], or `-1` to cull (draw nothing).
 ///
@@ -0,0 +1,398 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:vector_math/vector_math.dart';
+
+import 'package:flutter_scene/src/occlusion_culling.dart';
+import 'package:flutter_scene/src/render/render_layers.dart';
+import 'package:flutter_scene/src/render/render_scene.dart';
+
+/// A software depth buffer that rejects render items hidden behind
+/// authored [Occluder]s.
+///
+/// Per view: [begin] clears the buffer for a view-projection, [rasterize]
+/// draws occluder triangles into it, and [isOccluded] tests a world-space
+/// box against it. [cull] runs the whole stage over a frustum-culled item
+/// list. Everything runs on the CPU, so it needs no GPU context.
+///
+/// Both halves are conservative. An occluder writes a pixel at its
+/// triangle's farthest depth, and only when the pixel lies completely
+/// inside the occluder's projected outline: interior edges between
+/// same-facing triangles are sampled at pixel centers, silhouette edges
+/// must contain the whole pixel. An item is hidden only when every pixel
+/// its projected bounds touch holds a depth strictly nearer than the
+/// nearest corner of those bounds. Depth is NDC `z / w`, which is
+/// monotonic in view distance for both perspective and orthographic
+/// projections.
+class OcclusionCuller {
+  /// The smallest clip `w` treated as in front of the camera. Occluder
+  /// triangles and item bounds that reach behind it are skipped (drawn,
+  /// for items) rather than clipped.
+  static const double _minW = 1e-5;
+
+  final Float64List _viewProjection = Float64List(16);
+  final Float64List _model = Float64List(16);
+  Float32List _depth = Float32List(0);
+  Float32List _screen = Float32List(0);
+  Int8List _signs = Int8List(0);
+  int _width = 0;
+  int _height = 0;
+
+  // The pixel rectangle any occluder has written, so boxes outside it are
+  // accepted without touching the buffer. Empty when min > max.
+  int _writtenMinX = 0;
+  int _writtenMinY = 0;
+  int _writtenMaxX = -1;
+  int _writtenMaxY = -1;
+
+  // Scratch for [cull]'s occluder selection.
+  final List<RenderItem> _occluders = [];
+  Float64List _occluderAreas = Float64List(64);
+  final List<int> _occluderOrder = [];
+
+  /// Width of the depth buffer from the last [begin].
+  int get width => _width;
+
+  /// Height of the depth buffer from the last [begin].
+  int get height => _height;
+
+  /// The depth buffer, row-major with row 0 at the top of the view.
+  /// Cleared pixels hold `double.infinity`.
+  Float32List get depth => Float32List.sublistView(_depth, 0, _width * _height);
+
+  /// How many occluders the last [cull] rasterized.
+  int lastOccluderCount = 0;
+
+  /// How many items the last [cull] rejected.
+  int lastCulledCount = 0;
+
+  /// Clears the buffer to [width] x [height] pixels for a view with
+  /// [viewProjection].
+  void begin(Matrix4 viewProjection, int width, int height) {
+    assert(width > 0 && height > 0);
+    final storage = viewProjection.storage;
+    for (var i = 0; i < 16; i++) {
+      _viewProjection[i] = storage[i];
+    }
+    final pixels = width * height;
+    if (_depth.length < pixels) _depth = Float32List(pixels);
+    _width = width;
+    _height = height;
+    _depth.fillRange(0, pixels, double.infinity);
+    _writtenMinX = width;
+    _writtenMinY = height;
+    _writtenMaxX = -1;
+    _writtenMaxY = -1;
+  }
+
+  /// Draws [occluder], placed by [worldTransform], into the buffer.
+  void rasterize(Occluder occluder, Matrix4 worldTransform) {
+    _concat(worldTransform);
+    final m = _model;
+    final positions = occluder.positions;
+    final vertexCount = positions.length ~/ 3;
+    if (_screen.length < vertexCount * 4) {
+      _screen = Float32List(vertexCount * 4);
+    }
+    final screen = _screen;
+    final halfWidth = _width * 0.5;
+    final halfHeight = _height * 0.5;
+    for (var v = 0; v < vertexCount; v++) {
+      final x = positions[v * 3];
+      final y = positions[v * 3 + 1];
+      final z = positions[v * 3 + 2];
+      final w = m[3] * x + m[7] * y + m[11] * z + m[15];
+      final o = v * 4;
+      screen[o + 3] = w;
+      if (w < _minW) continue;
+      final invW = 1.0 / w;
+      screen[o] =
+          ((m[0] * x + m[4] * y + m[8] * z + m[12]) * invW + 1.0) * halfWidth;
+      screen[o + 1] =
+          (1.0 - (m[1] * x + m[5] * y + m[9] * z + m[13]) * invW) * halfHeight;
+      screen[o + 2] = (m[2] * x + m[6] * y + m[10] * z + m[14]) * invW;
+    }
+    // Each triangle's screen winding: +1, -1, or 0 when it is skipped.
+    final indices = occluder.indices;
+    final triangleCount = indices.length ~/ 3;
+    if (_signs.length < triangleCount) _signs = Int8List(triangleCount);
+    final signs = _signs;
+    for (var t = 0; t < triangleCount; t++) {
+      signs[t] = _screenSign(
+        indices[t * 3] * 4,
+        indices[t * 3 + 1] * 4,
+        indices[t * 3 + 2] * 4,
+      );
+    }
+    final neighbors = occluder.edgeNeighbors;
+    for (var t = 0; t < triangleCount; t++) {
+      final sign = signs[t];
+      if (sign == 0) continue;
+      // Edges shared with a same-facing triangle are inside the occluder's
+      // silhouette and need no margin; all others are pulled in.
+      var silhouette = 0;
+      for (var e = 0; e < 3; e++) {
+        final neighbor = neighbors[t * 3 + e];
+        if (neighbor < 0 || signs[neighbor] != sign) silhouette |= 1 << e;
+      }
+      _rasterizeTriangle(
+        indices[t * 3] * 4,
+        indices[t * 3 + 1] * 4,
+        indices[t * 3 + 2] * 4,
+        sign,
+        silhouette,
+      );
+    }
+  }
+
+  /// Whether the world-space [bounds] are completely hidden by what has
+  /// been rasterized since [begin].
+  bool isOccluded(Aabb3 bounds) {
+    if (_writtenMaxX < 0) return false;
+    final m = _viewProjection;
+    final min = bounds.min;
+    final max = bounds.max;
+    var minX = double.infinity;
+    var minY = double.infinity;
+    var maxX = double.negativeInfinity;
+    var maxY = double.negativeInfinity;
+    var nearest = double.infinity;
+    for (var corner = 0; corner < 8; corner++) {
+      final x = corner & 1 != 0 ? max.x : min.x;
+      final y = corner & 2 != 0 ? max.y : min.y;
+      final z = corner & 4 != 0 ? max.z : min.z;
+      final w = m[3] * x + m[7] * y + m[11] * z + m[15];
+      // Reaches behind the camera: its projection is unbounded.
+      if (w < _minW) return false;
+      final invW = 1.0 / w;
+      final sx =
+          ((m[0] * x + m[4] * y + m[8] * z + m[12]) * invW + 1.0) *
+          0.5 *
+          _width;
+      final sy =
+          (1.0 - (m[1] * x + m[5] * y + m[9] * z + m[13]) * invW) *
+          0.5 *
+          _height;
+      final sz = (m[2] * x + m[6] * y + m[10] * z + m[14]) * invW;
+      if (sx < minX) minX = sx;
+      if (sx > maxX) maxX = sx;
+      if (sy < minY) minY = sy;
+      if (sy > maxY) maxY = sy;
+      if (sz < nearest) nearest = sz;
+    }
+    // Every pixel the rectangle touches, even partially.
+    final x0 = math.max(minX.floor(), 0);
+    final y0 = math.max(minY.floor(), 0);
+    final x1 = math.min(math.max(maxX.ceil() - 1, minX.floor()), _width - 1);
+    final y1 = math.min(math.max(maxY.ceil() - 1, minY.floor()), _height - 1);
+    if (x0 > x1 || y0 > y1) return false;
+    if (x0 < _writtenMinX ||
+        y0 < _writtenMinY ||
+        x1 > _writtenMaxX ||
+        y1 > _writtenMaxY) {
+      return false;
+    }
+    final depth = _depth;
+    for (var y = y0; y <= y1; y++) {
+      final row = y * _width;
+      for (var x = x0; x <= x1; x++) {
+        if (depth[row + x] >= nearest) return false;
+      }
+    }
+    return true;
+  }
+
+  /// Runs the occlusion stage over [candidates], the items that survived
+  /// frustum culling for a view with [viewProjection], and passes each
+  /// item that may be visible to [visit]. Returns how many were rejected.
+  ///
+  /// Up to [occluderBudget] items carrying a [RenderItem.occluder] are
+  /// rasterized first, largest projected world bounds first. Items hidden
+  /// by the owning node, or outside [layerMask], neither occlude nor are
+  /// tested; they are passed through for the encoder to skip as usual.
+  int cull(
+    List<RenderItem> candidates,
+    void Function(RenderItem) visit, {
+    required Matrix4 viewProjection,
+    required int width,
+    required int height,
+    int occluderBudget = 32,
+    int layerMask = kRenderLayerAll,
+  }) {
+    begin(viewProjection, width, height);
+    _selectOccluders(candidates, occluderBudget, layerMask);
+    for (final index in _occluderOrder) {
+      final item = _occluders[index];
+      rasterize(item.occluder!, item.worldTransform);
+    }
+    lastOccluderCount = _occluderOrder.length;
+    _occluders.clear();
+    _occluderOrder.clear();
+
+    var culled = 0;
+    for (final item in candidates) {
+      final bounds = item.worldBounds;
+      if (bounds != null &&
+          item.frustumCulled &&
+          item.visible &&
+          (item.layers & layerMask) != 0 &&
+          isOccluded(bounds)) {
+        culled++;
+        continue;
+      }
+      visit(item);
+    }
+    lastCulledCount = culled;
+    return culled;
+  }
+
+  void _selectOccluders(
+    List<RenderItem> candidates,
+    int budget,
+    int layerMask,
+  ) {
+    if (budget <= 0) return;
+    for (final item in candidates) {
+      if (item.occluder == null ||
+          !item.visible ||
+          !item.primitiveVisible ||
+          (item.layers & layerMask) == 0) {
+        continue;
+      }
+      final bounds = item.worldBounds;
+      if (bounds == null) continue;
+      final index = _occluders.length;
+      if (index == _occluderAreas.length) {
+        _occluderAreas = Float64List(index * 2)..setAll(0, _occluderAreas);
+      }
+      _occluderAreas[index] = _projectedArea(bounds);
+      _occluders.add(item);
+      _occluderOrder.add(index);
+    }
+    if (_occluderOrder.length <= budget) return;
+    final areas = _occluderAreas;
+    _occluderOrder.sort((a, b) => areas[b].compareTo(areas[a]));
+    _occluderOrder.length = budget;
+  }
+
+  // The screen-space area of [bounds]' projected rectangle, or infinity
+  // when it reaches behind the camera (the camera is inside or next to it,
+  // so it is the best occluder there is).
+  double _projectedArea(Aabb3 bounds) {
+    final m = _viewProjection;
+    final min = bounds.min;
+    final max = bounds.max;
+    var minX = double.infinity;
+    var minY = double.infinity;
+    var maxX = double.negativeInfinity;
+    var maxY = double.negativeInfinity;
+    for (var corner = 0; corner < 8; corner++) {
+      final x = corner & 1 != 0 ? max.x : min.x;
+      final y = corner & 2 != 0 ? max.y : min.y;
+      final z = corner & 4 != 0 ? max.z : min.z;
+      final w = m[3] * x + m[7] * y + m[11] * z + m[15];
+      if (w < _minW) return double.infinity;
+      final sx = (m[0] * x + m[4] * y + m[8] * z + m[12]) / w;
+      final sy = (m[1] * x + m[5] * y + m[9] * z + m[13]) / w;
+      if (sx < minX) minX = sx;
+      if (sx > maxX) maxX = sx;
+      if (sy < minY) minY = sy;
+      if (sy > maxY) maxY = sy;
+    }
+    final width = math.min(maxX, 1.0) - math.max(minX, -1.0);
+    final height = math.min(maxY, 1.0) - math.max(minY, -1.0);
+    return width > 0 && height > 0 ? width * height : 0.0;
+  }
+
+  // [_model] = view-projection * [worldTransform].
+  void _concat(Matrix4 worldTransform) {
+    final a = _viewProjection;
+    final b = worldTransform.storage;
+    final out = _model;
+    for (var col = 0; col < 4; col++) {
+      final b0 = b[col * 4];
+      final b1 = b[col * 4 + 1];
+      final b2 = b[col * 4 + 2];
+      final b3 = b[col * 4 + 3];
+      for (var row = 0; row < 4; row++) {
+        out[col * 4 + row] =
+            a[row] * b0 + a[4 + row] * b1 + a[8 + row] * b2 + a[12 + row] * b3;
+      }
+    }
+  }
+
+  // The winding of the projected triangle at screen offsets [i0], [i1],
+  // [i2] in [_screen], or 0 when it is degenerate or reaches behind the
+  // camera.
+  int _screenSign(int i0, int i1, int i2) {
+    final s = _screen;
+    if (s[i0 + 3] < _minW || s[i1 + 3] < _minW || s[i2 + 3] < _minW) return 0;
+    final area =
+        (s[i1] - s[i0]) * (s[i2 + 1] - s[i0 + 1]) -
+        (s[i2] - s[i0]) * (s[i1 + 1] - s[i0 + 1]);
+    if (area.abs() < 1e-6) return 0;
+    return area > 0 ? 1 : -1;
+  }
+
+  // Writes the triangle at screen offsets [i0], [i1], [i2] in [_screen],
+  // whose winding is [sign], at its farthest depth. Pixel centers inside
+  // every edge are covered, except that for the edges flagged in
+  // [silhouette] (bit `e` for the edge from corner `e`) the whole pixel
+  // must be inside, so coverage never spills past the occluder's outline.
+  void _rasterizeTriangle(int i0, int i1, int i2, int sign, int silhouette) {
+    final s = _screen;
+    final x0 = s[i0], y0 = s[i0 + 1];
+    final x1 = s[i1], y1 = s[i1 + 1];
+    final x2 = s[i2], y2 = s[i2 + 1];
+    final z = math.max(s[i0 + 2], math.max(s[i1 + 2], s[i2 + 2]));
+
+    // Edge functions e(x, y) = a * x + b * y + c, flipped by the winding
+    // so they are positive inside.
+    final flip = sign.toDouble();
+    final a0 = (y0 - y1) * flip, b0 = (x1 - x0) * flip;
+    final a1 = (y1 - y2) * flip, b1 = (x2 - x1) * flip;
+    final a2 = (y2 - y0) * flip, b2 = (x0 - x2) * flip;
+    var c0 = (x0 * y1 - x1 * y0) * flip;
+    var c1 = (x1 * y2 - x2 * y1) * flip;
+    var c2 = (x2 * y0 - x0 * y2) * flip;
+    // A pixel is fully inside an edge when its center is at least half
+    // its extent inside.
+    if (silhouette & 1 != 0) c0 -= 0.5 * (a0.abs() + b0.abs());
+    if (silhouette & 2 != 0) c1 -= 0.5 * (a1.abs() + b1.abs());
+    if (silhouette & 4 != 0) c2 -= 0.5 * (a2.abs() + b2.abs());
+
+    final minX = math.max(math.min(x0, math.min(x1, x2)).floor(), 0);
+    final maxX = math.min(math.max(x0, math.max(x1, x2)).ceil(), _width - 1);
+    final minY = math.max(math.min(y0, math.min(y1, y2)).floor(), 0);
+    final maxY = math.min(math.max(y0, math.max(y1, y2)).ceil(), _height - 1);
+    if (minX > maxX || minY > maxY) return;
+
+    final depth = _depth;
+    final width = _width;
+    var wrote = false;
+    for (var y = minY; y <= maxY; y++) {
+      final py = y + 0.5;
+      final row = y * width;
+      var e0 = a0 * (minX + 0.5) + b0 * py + c0;
+      var e1 = a1 * (minX + 0.5) + b1 * py + c1;
+      var e2 = a2 * (minX + 0.5) + b2 * py + c2;
+      for (var x = minX; x <= maxX; x++) {
+        if (e0 >= 0 && e1 >= 0 && e2 >= 0) {
+          final index = row + x;
+          if (z < depth[index]) depth[index] = z;
+          wrote = true;
+        }
+        e0 += a0;
+        e1 += a1;
+        e2 += a2;
+      }
+    }
+    if (!wrote) return;
+    // The covered rectangle may be tighter than the triangle's bounds, but
+    // the bounds are a safe superset for the early accept in [isOccluded].
+    if (minX < _writtenMinX) _writtenMinX = minX;
+    if (minY < _writtenMinY) _writtenMinY = minY;
+    if (maxX > _writtenMaxX) _writtenMaxX = maxX;
+    if (maxY > _writtenMaxY) _writtenMaxY = maxY;
+  }
+}
@@ -68,6 +68,16 @@ class PostEffectPass extends RenderGraphPass {
   @override
   String get name => 'PostEffectPass';
 
+  @override
+  Set<Object> get inputs => {_inputKey};
+
+  @override
+  Set<Object> get outputs => {_outputKey};
+
+  // Writes the caller's output texture.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final input = context.blackboard.require<gpu.Texture>(_inputKey);
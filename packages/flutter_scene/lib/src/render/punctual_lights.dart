@@ -1,14 +1,20 @@
 import 'dart:math' as math;
+import 'dart:ui' as ui;
 
 import 'package:flutter/foundation.dart';
 
+import 'package:flutter_scene/src/camera.dart';
+import 'package:flutter_scene/src/clustered_lighting.dart';
 import 'package:flutter_scene/src/components/directional_light_component.dart';
 import 'package:flutter_scene/src/components/point_light_component.dart';
 import 'package:flutter_scene/src/components/rect_area_light_component.dart';
 import 'package:flutter_scene/src/components/spot_light_component.dart';
 import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/material/shadow_catcher_material.dart';
 import 'package:flutter_scene/src/render/bvh.dart';
+import 'package:flutter_scene/src/render/light_clusters.dart';
 import 'package:flutter_scene/src/render/light_culling.dart';
+import 'package:flutter_scene/src/render/planar_reflection.dart';
 import 'package:flutter_scene/src/render/render_scene.dart';
 import 'package:flutter_scene/src/render/spot_shadow.dart';
 
@@ -17,14 +23,13 @@ import 'package:flutter_scene/src/render/spot_shadow.dart';
 /// the lights that reach it, and the fragment loops that slice. Must match
 /// `MAX_PUNCTUAL_LIGHTS` in `shaders/material_lighting.glsl` (the fragment loop
 /// bound is a compile-time constant under GLSL ES 1.00), so this is a per-object
-/// budget, not a global cap.
+/// budget, not a global cap. With `Scene.clusteredLighting` on it is the
+/// budget of each froxel instead.
 ///
-/// TODO(lighting): for the massive-scale tier, froxel clustering replaces the
-/// per-object lists (no per-draw light state, CPU cost independent of draw
-/// count); constrained mobile keeps this direct loop. TODO(#188474): with
-/// Flutter GPU storage buffers/compute, a higher-tier variant can read a storage
-/// buffer with a real dynamic loop and assign lights in a compute pass, with the
-/// data-texture path here as the base-tier fallback.
+/// TODO(#188474): with Flutter GPU storage buffers/compute, a higher-tier
+/// variant can read a storage buffer with a real dynamic loop and assign lights
+/// in a compute pass, with the data-texture path here as the base-tier
+/// fallback.
 const int kMaxPunctualLights = 16;
 
 // A punctual light is one row of the parameters texture, eight RGBA32F texels
@@ -45,6 +50,13 @@ const int _floatsPerLight = _texelsPerLight * 4;
 // The per-object light-index buffer is packed into a 2D texture at most this
 // many texels wide (each texel one light index in .r), so a large scene's
 // index buffer stays within the max texture width; the height grows instead.
+//
+// A clustered view appends its froxel grid to the per-item slices:
+//   header + 0: tilesX, tilesY, slices, unused
+//   header + 1: slice scale, slice bias (slice = log(depth) * scale + bias)
+//   header + 2 + cluster: offset of the cluster's lights in .r, count in .g
+// followed by the clusters' light rows. Items reading the clusters carry the
+// light-list count -1, and punctual_dims.w holds header + 1.
 const int _indexTexMaxWidth = 2048;
 
 const double _typeDirectional = 0.0;
@@ -66,6 +78,8 @@ class PunctualLighting {
     this.spotShadowDepthBias = 0.0,
     this.spotShadowNormalBias = 0.0,
     this.spotShadowSoftness = 0.0,
+    this.clusterHeader = 0,
+    this.clusters,
   });
 
   /// An empty result (no punctual lights this frame).
@@ -78,7 +92,9 @@ class PunctualLighting {
       spotShadowCount = 0,
       spotShadowDepthBias = 0.0,
       spotShadowNormalBias = 0.0,
-      spotShadowSoftness = 0.0;
+      spotShadowSoftness = 0.0,
+      clusterHeader = 0,
+      clusters = null;
 
   /// All scene lights, one per row (RGBA32F, `paramsCount` rows), or null when
   /// there are none.
@@ -105,6 +121,104 @@ class PunctualLighting {
   final double spotShadowDepthBias;
   final double spotShadowNormalBias;
   final double spotShadowSoftness;
+
+  /// One past the texel of [indexTexture] where the view's froxel grid
+  /// header starts, or `0` when it holds no grid (only per-item slices).
+  final int clusterHeader;
+
+  /// The frame's clustered light assignment awaiting a view, or null when
+  /// lights are assigned per item. See [forView].
+  final PunctualLightClusters? clusters;
+
+  /// The lighting for a view through [camera] into a [size] target. When
+  /// [clusters] is set this bins the lights into that view's froxels and
+  /// returns lighting whose index texture carries the grid; otherwise it
+  /// returns this.
+  PunctualLighting forView(Camera camera, ui.Size size) =>
+      clusters?._resolve(this, camera, size) ?? this;
+}
+
+/// The view-independent half of a clustered frame: the packed lights and the
+/// per-item slices of the items that cannot read the clusters. Each view
+/// resolves it into its own froxel grid and index texture.
+class PunctualLightClusters {
+  PunctualLightClusters._(this._buffer, this._lights, this._itemIndices);
+
+  final PunctualLightBuffer _buffer;
+  final List<CullableLight> _lights;
+  final List<int> _itemIndices;
+
+  PunctualLighting _resolve(
+    PunctualLighting shared,
+    Camera camera,
+    ui.Size size,
+  ) {
+    final slot = _buffer._clusterViews++;
+    final grid = _buffer._clusterGrid(slot);
+    var projection = camera.projection;
+    if (projection is ObliqueNearClipProjection) projection = projection.base;
+    if (projection is PerspectiveProjection && size.height > 0) {
+      final tanHalfFovY = math.tan(projection.fovRadiansY / 2.0);
+      grid.build(
+        view: camera.getViewMatrix(),
+        tanHalfFovX: tanHalfFovY * size.width / size.height,
+        tanHalfFovY: tanHalfFovY,
+        near: projection.near,
+        far: projection.far,
+        lights: _lights,
+        maxPerCluster: kMaxPunctualLights,
+      );
+    } else {
+      grid.buildGlobal(lights: _lights, maxPerCluster: kMaxPunctualLights);
+    }
+    _buffer._warnOverflow(grid.overflowed);
+
+    final header = _itemIndices.length;
+    final global = grid.isGlobal;
+    final tableLength = global ? 1 : grid.clusterCount;
+    final lightsStart = header + 2 + tableLength;
+    final length = lightsStart + grid.indexCount;
+    final indexWidth = math.min(length, _indexTexMaxWidth);
+    final indexHeight = (length + indexWidth - 1) ~/ indexWidth;
+    final indexData = Float32List(indexWidth * indexHeight * 4);
+    for (var i = 0; i < header; i++) {
+      indexData[i * 4] = _itemIndices[i].toDouble();
+    }
+    final h = header * 4;
+    indexData[h] = global ? 1.0 : grid.tilesX.toDouble();
+    indexData[h + 1] = global ? 1.0 : grid.tilesY.toDouble();
+    indexData[h + 2] = global ? 1.0 : grid.slices.toDouble();
+    indexData[h + 4] = grid.sliceScale;
+    indexData[h + 5] = grid.sliceBias;
+    final offsets = grid.offsets;
+    final counts = grid.counts;
+    for (var c = 0; c < tableLength; c++) {
+      final t = (header + 2 + c) * 4;
+      indexData[t] = (lightsStart + offsets[c]).toDouble();
+      indexData[t + 1] = counts[c].toDouble();
+    }
+    final indices = grid.indices;
+    for (var i = 0; i < grid.indexCount; i++) {
+      indexData[(lightsStart + i) * 4] = indices[i].toDouble();
+    }
+    final indexTexture = _buffer
+        ._clusterRing(slot)
+        .acquire(indexWidth, indexHeight);
+    indexTexture.overwrite(indexData.buffer.asByteData());
+
+    return PunctualLighting(
+      paramsTexture: shared.paramsTexture,
+      indexTexture: indexTexture,
+      paramsCount: shared.paramsCount,
+      indexWidth: indexWidth,
+      indexHeight: indexHeight,
+      spotShadowCount: shared.spotShadowCount,
+      spotShadowDepthBias: shared.spotShadowDepthBias,
+      spotShadowNormalBias: shared.spotShadowNormalBias,
+      spotShadowSoftness: shared.spotShadowSoftness,
+      clusterHeader: header + 1,
+    );
+  }
 }
 
 // A ring of exactly-sized host-visible RGBA32F textures, so a frame in flight is
@@ -147,19 +261,63 @@ class _PackedLights {
 /// light-index texture produced by culling those lights against the items.
 ///
 /// One instance lives on the `Scene` and is rebuilt once per frame (the
-/// light-object assignment is view-independent).
+/// light-object assignment is view-independent). With clustering on, the
+/// froxel grids are built per view instead (see [PunctualLighting.forView]).
 class PunctualLightBuffer {
   final _TextureRing _paramsRing = _TextureRing();
   final _TextureRing _indexRing = _TextureRing();
 
+  // Per-view froxel grids and index textures, indexed by the order views
+  // resolve within a frame so views never share an in-flight texture.
+  final List<LightClusterGrid> _clusterGrids = [];
+  final List<_TextureRing> _clusterRings = [];
+  int _clusterViews = 0;
+  int _tilesX = 0;
+  int _tilesY = 0;
+  int _slices = 0;
+
   bool _warnedOverflow = false;
 
+  LightClusterGrid _clusterGrid(int slot) {
+    while (_clusterGrids.length <= slot) {
+      _clusterGrids.add(
+        LightClusterGrid(tilesX: _tilesX, tilesY: _tilesY, slices: _slices),
+      );
+    }
+    return _clusterGrids[slot];
+  }
+
+  _TextureRing _clusterRing(int slot) {
+    while (_clusterRings.length <= slot) {
+      _clusterRings.add(_TextureRing());
+    }
+    return _clusterRings[slot];
+  }
+
+  void _warnOverflow(bool overflowed) {
+    assert(() {
+      if (overflowed && !_warnedOverflow) {
+        _warnedOverflow = true;
+        debugPrint(
+          'flutter_scene: an object is reached by more than $kMaxPunctualLights '
+          'punctual lights; the excess is not shaded.',
+        );
+      }
+      return true;
+    }());
+  }
+
   /// Packs the scene's [directionals] (skipping [primaryDirectional], which
   /// the shadow-capable `FragInfo` path already shades), [points], and [spots]
   /// into the parameters buffer, culls them against [items] using [bvh], and
   /// uploads both the parameters and per-object index textures. Returns
   /// [PunctualLighting.empty] when there are no punctual lights, so a scene with
   /// only a single directional light allocates nothing and renders as before.
+  ///
+  /// With [clustered] enabled only the items that cannot read the froxel grid
+  /// (a custom light channel mask, or a shadow catcher) get per-item slices;
+  /// the rest carry the light-list count -1 and the result's
+  /// [PunctualLighting.clusters] bins the lights per view.
   PunctualLighting build({
     required List<DirectionalLightComponent> directionals,
     required DirectionalLightComponent? primaryDirectional,
@@ -167,9 +325,11 @@ class PunctualLightBuffer {
     required List<SpotLightComponent> spots,
     List<RectAreaLightComponent> areas = const [],
     required List<RenderItem> items,
-    required Bvh bvh,
+    required BvhQueries bvh,
     SpotShadowFrame? spotShadows,
+    ClusteredLightingSettings? clustered,
   }) {
+    _clusterViews = 0;
     final packed = _packLights(
       directionals,
       points,
@@ -202,23 +362,42 @@ class PunctualLightBuffer {
       }
     }
 
-    final cull = assignLightsToItems(
-      items: items,
-      bvh: bvh,
-      lights: packed.cullables,
-      maxPerItem: kMaxPunctualLights,
-    );
-
-    assert(() {
-      if (cull.overflowed && !_warnedOverflow) {
-        _warnedOverflow = true;
-        debugPrint(
-          'flutter_scene: an object is reached by more than $kMaxPunctualLights '
-          'punctual lights; the excess is not shaded.',
-        );
+    final PunctualLightClusters? clusters;
+    final LightCullResult cull;
+    if (clustered != null && clustered.enabled) {
+      _configureClusters(clustered);
+      // Only the items that cannot read the clusters keep per-item lists,
+      // culled through a BVH of just those items.
+      final listed = <RenderItem>[];
+      for (final item in items) {
+        if (item.lightChannelMask != 0xFF ||
+            item.material is ShadowCatcherMaterial) {
+          listed.add(item);
+        } else {
+          item.lightListOffset = 0;
+          item.lightListCount = -1;
+        }
       }
-      return true;
-    }());
+      cull = assignLightsToItems(
+        items: listed,
+        bvh: Bvh.build([
+          for (final item in listed)
+            if (item.worldBounds != null) item,
+        ]),
+        lights: packed.cullables,
+        maxPerItem: kMaxPunctualLights,
+      );
+      clusters = PunctualLightClusters._(this, packed.cullables, cull.indices);
+    } else {
+      cull = assignLightsToItems(
+        items: items,
+        bvh: bvh,
+        lights: packed.cullables,
+        maxPerItem: kMaxPunctualLights,
+      );
+      clusters = null;
+    }
+    _warnOverflow(cull.overflowed);
 
     final paramsTexture = _paramsRing.acquire(_texelsPerLight, count);
     paramsTexture.overwrite(packed.params.buffer.asByteData());
@@ -238,6 +417,7 @@ class PunctualLightBuffer {
         spotShadowDepthBias: spotShadows?.depthBias ?? 0.0,
         spotShadowNormalBias: spotShadows?.normalBias ?? 0.0,
         spotShadowSoftness: spotShadows?.softness ?? 0.0,
+        clusters: clusters,
       );
     }
 
@@ -261,9 +441,22 @@ class PunctualLightBuffer {
       spotShadowDepthBias: spotShadows?.depthBias ?? 0.0,
       spotShadowNormalBias: spotShadows?.normalBias ?? 0.0,
       spotShadowSoftness: spotShadows?.softness ?? 0.0,
+      clusters: clusters,
     );
   }
 
+  // Drops the per-view grids when the grid dimensions change.
+  void _configureClusters(ClusteredLightingSettings settings) {
+    final tilesX = settings.tilesX.clamp(1, 64);
+    final tilesY = settings.tilesY.clamp(1, 64);
+    final slices = settings.depthSlices.clamp(1, 64);
+    if (tilesX == _tilesX && tilesY == _tilesY && slices == _slices) return;
+    _tilesX = tilesX;
+    _tilesY = tilesY;
+    _slices = slices;
+    _clusterGrids.clear();
+  }
+
   /// Packs the additional analytic lights into the parameters buffer, returning
   /// it and the light count. Pure and GPU-independent so the texel layout,
   /// falloff, and cone math can be unit tested; [build] wraps it with culling
@@ -345,6 +538,7 @@ class PunctualLightBuffer {
           lightInfluenceBounds(position, light.range),
           worldPosition: position,
           channelMask: light.channelMask,
+          range: light.range,
         ),
       );
       row++;
@@ -382,6 +576,9 @@ class PunctualLightBuffer {
           lightInfluenceBounds(position, light.range),
           worldPosition: position,
           channelMask: light.channelMask,
+          range: light.range,
+          spotDirection: direction,
+          spotAngle: light.outerConeAngle,
         ),
       );
       row++;
@@ -421,6 +618,7 @@ class PunctualLightBuffer {
           reach > 0.0 ? lightInfluenceBounds(position, reach) : null,
           worldPosition: position,
           channelMask: light.channelMask,
+          range: reach,
         ),
       );
       row++;
@@ -1,4 +1,5 @@
 import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/render/frame_tracer.dart';
 import 'package:flutter_scene/src/render/frame_transients.dart';
 import 'package:flutter_scene/src/render/render_profile.dart';
 
@@ -35,7 +36,8 @@ class Blackboard {
 }
 
 /// Observes one [RenderGraph.execute] run: pass boundaries with CPU times,
-/// every blackboard read/write, and every transient-texture acquisition.
+/// every blackboard read/write, every transient-texture acquisition, the
+/// passes culled from the run, and the frame's transient texture memory.
 ///
 /// Attached only for capture frames (the render graph inspector); steady
 /// state frames pay nothing. Reads and writes made while a pass executes
@@ -50,6 +52,19 @@ abstract interface class RenderGraphObserver {
     TransientTextureDescriptor descriptor,
     gpu.Texture texture,
   );
+
+  /// [pass] was skipped: it has no side effects and no pass that runs
+  /// reads its outputs.
+  void onPassCulled(RenderGraphPass pass, int indexInGraph);
+
+  /// Reported once after the passes ran: the bytes of transient textures
+  /// the frame acquired, counted once per descriptor ([unaliasedBytes],
+  /// what one texture per descriptor would hold) and once per physical
+  /// texture after lifetime aliasing ([aliasedBytes]).
+  void onTransientMemory({
+    required int unaliasedBytes,
+    required int aliasedBytes,
+  });
 }
 
 /// A [Blackboard] view that reports every access to an observer while
@@ -101,6 +116,22 @@ class ObservedTexturePool extends TransientTexturePool {
     return texture;
   }
 
+  @override
+  int reservePasses(int count) => _inner.reservePasses(count);
+
+  @override
+  void beginPass(int clock, {int? releaseAfter}) =>
+      _inner.beginPass(clock, releaseAfter: releaseAfter);
+
+  @override
+  void endPass() => _inner.endPass();
+
+  @override
+  int get unaliasedBytes => _inner.unaliasedBytes;
+
+  @override
+  int get aliasedBytes => _inner.aliasedBytes;
+
   @override
   void clear() => _inner.clear();
 }
@@ -108,9 +139,9 @@ class ObservedTexturePool extends TransientTexturePool {
 /// Description of a transient GPU texture requested from a
 /// [TransientTexturePool].
 ///
-/// Two descriptors that compare equal share a pool slot, so a pass that
-/// needs two live textures with otherwise-identical parameters in the
-/// same frame must distinguish them with [debugName].
+/// Two descriptors that compare equal share a texture while it is live, so
+/// a pass that needs two live textures with otherwise-identical parameters
+/// in the same frame must distinguish them with [debugName].
 class TransientTextureDescriptor {
   const TransientTextureDescriptor({
     required this.width,
@@ -166,9 +197,25 @@ class TransientTextureDescriptor {
   final bool enableShaderReadUsage;
 
   /// Optional disambiguator so two otherwise-identical descriptors map to
-  /// separate pool slots. Does not affect the allocated texture.
+  /// separate textures while both are live. Does not affect the allocated
+  /// texture.
   final String? debugName;
 
+  /// The size of the allocated texture in bytes (an estimate for formats
+  /// whose storage the backend pads).
+  int get sizeInBytes =>
+      width * height * sampleCount * _bytesPerPixel(format);
+
+  /// Whether a texture allocated for [other] can serve this descriptor:
+  /// everything but [debugName] matches.
+  bool isCompatibleWith(TransientTextureDescriptor other) =>
+      other.width == width &&
+      other.height == height &&
+      other.format == format &&
+      other.sampleCount == sampleCount &&
+      other.storageMode == storageMode &&
+      other.enableShaderReadUsage == enableShaderReadUsage;
+
   @override
   bool operator ==(Object other) =>
       other is TransientTextureDescriptor &&
@@ -192,38 +239,53 @@ class TransientTextureDescriptor {
   );
 }
 
-/// Recycles GPU textures used as transient render-graph attachments
-/// across frames.
+int _bytesPerPixel(gpu.PixelFormat format) => switch (format) {
+  gpu.PixelFormat.a8UNormInt ||
+  gpu.PixelFormat.r8UNormInt ||
+  gpu.PixelFormat.s8UInt => 1,
+  gpu.PixelFormat.r8g8UNormInt => 2,
+  gpu.PixelFormat.r16g16b16a16Float ||
+  gpu.PixelFormat.b10g10r10a10XR ||
+  gpu.PixelFormat.d32FloatS8UInt => 8,
+  gpu.PixelFormat.r32g32b32a32Float => 16,
+  _ => 4,
+};
+
+/// Recycles GPU textures used as transient render-graph attachments,
+/// across frames and, with lifetime aliasing, within one.
+///
+/// Each of [framesInFlight] frame slots owns its own textures, so a texture
+/// written this frame is not overwritten while an earlier frame still
+/// references it. Within a frame, an [acquire] binds its descriptor to a
+/// texture until the acquisition's release point; a later acquisition of
+/// the same descriptor while the binding is live returns the same texture,
+/// and one of a compatible descriptor (see
+/// [TransientTextureDescriptor.isCompatibleWith]) after the release point
+/// may reuse it.
 ///
-/// Keyed by [TransientTextureDescriptor]; for each descriptor it keeps a
-/// ring of [framesInFlight] textures so a texture written this frame is
-/// not overwritten while an earlier frame still references it. This is the
-/// minimal "transient resource" mechanism — there is no intra-frame
-/// lifetime aliasing; a pass that needs two simultaneously-live textures
-/// of the same shape must give them distinct [TransientTextureDescriptor.debugName]s.
+/// [RenderGraph.execute] sets the release points from the passes' declared
+/// inputs and outputs (see [RenderGraphPass.outputs]). Acquisitions outside
+/// a pass, and in passes that declare no outputs, live for the rest of the
+/// frame. With [aliasing] off every acquisition lives for the frame, so
+/// each descriptor keeps a texture of its own.
 class TransientTexturePool {
-  TransientTexturePool({this.framesInFlight = 2});
+  TransientTexturePool({this.framesInFlight = 2, this.aliasing = true});
 
   final int framesInFlight;
-  final Map<TransientTextureDescriptor, List<gpu.Texture?>> _rings = {};
-  int _frame = 0;
 
-  /// Advances to the next frame's ring slot. Call once per frame before
-  /// any [acquire] calls.
-  void beginFrame() {
-    _frame = (_frame + 1) % framesInFlight;
-  }
+  /// Whether textures whose lifetimes do not overlap within a frame may
+  /// share memory.
+  final bool aliasing;
 
-  /// Returns a texture matching [descriptor] from the pool for the
-  /// current frame, allocating it on first use.
-  gpu.Texture acquire(TransientTextureDescriptor descriptor) {
-    final ring = _rings.putIfAbsent(
-      descriptor,
-      () => List<gpu.Texture?>.filled(framesInFlight, null),
-    );
-    var texture = ring[_frame];
-    if (texture == null) {
-      texture = gpu.gpuContext.createTexture(
+  late final TransientTextureAllocator<gpu.Texture> _allocator =
+      TransientTextureAllocator(
+        create: _createTexture,
+        framesInFlight: framesInFlight,
+        aliasing: aliasing,
+      );
+
+  static gpu.Texture _createTexture(TransientTextureDescriptor descriptor) =>
+      gpu.gpuContext.createTexture(
         descriptor.storageMode,
         descriptor.width,
         descriptor.height,
@@ -232,15 +294,191 @@ class TransientTexturePool {
         enableRenderTargetUsage: true,
         enableShaderReadUsage: descriptor.enableShaderReadUsage,
       );
-      ring[_frame] = texture;
-    }
-    return texture;
-  }
+
+  /// Advances to the next frame's slot. Call once per frame before any
+  /// [acquire] calls.
+  void beginFrame() => _allocator.beginFrame();
+
+  /// Returns a texture matching [descriptor] for the current frame, live
+  /// until the current release point, allocating one when no compatible
+  /// texture is free.
+  gpu.Texture acquire(TransientTextureDescriptor descriptor) =>
+      _allocator.acquire(descriptor);
+
+  /// Reserves [count] consecutive points on this frame's pass clock for a
+  /// graph's passes and returns the first.
+  int reservePasses(int count) => _allocator.reservePasses(count);
+
+  /// Makes [clock] the current point: acquisitions until [endPass] are
+  /// live through [releaseAfter], or the rest of the frame when null.
+  void beginPass(int clock, {int? releaseAfter}) =>
+      _allocator.beginPass(clock, releaseAfter: releaseAfter);
+
+  /// Ends the current pass; later acquisitions live for the rest of the
+  /// frame.
+  void endPass() => _allocator.endPass();
+
+  /// This frame's acquisitions counted once per descriptor, in bytes.
+  int get unaliasedBytes => _allocator.unaliasedBytes;
+
+  /// The textures this frame's acquisitions bound, in bytes.
+  int get aliasedBytes => _allocator.aliasedBytes;
 
   /// Drops all cached textures. The next [acquire] for any descriptor
   /// reallocates. Call when the output size changes so stale-sized
   /// textures aren't kept alive.
-  void clear() => _rings.clear();
+  void clear() => _allocator.clear();
+}
+
+/// The bookkeeping behind [TransientTexturePool], generic over the texture
+/// handle [create] returns so it runs without a GPU.
+class TransientTextureAllocator<T extends Object> {
+  TransientTextureAllocator({
+    required this.create,
+    this.framesInFlight = 2,
+    this.aliasing = true,
+  });
+
+  /// Allocates a texture for a descriptor.
+  final T Function(TransientTextureDescriptor descriptor) create;
+
+  final int framesInFlight;
+
+  /// See [TransientTexturePool.aliasing].
+  final bool aliasing;
+
+  static const int _frameEnd = 1 << 30;
+
+  late final List<List<_PooledTexture<T>>> _slots = List.generate(
+    framesInFlight,
+    (_) => <_PooledTexture<T>>[],
+  );
+  final Map<TransientTextureDescriptor, _PooledTexture<T>> _bindings = {};
+  final Set<TransientTextureDescriptor> _acquired = {};
+  final Set<_PooledTexture<T>> _used = Set.identity();
+  int _frame = 0;
+  int _now = 0;
+  int _releaseAt = _frameEnd;
+  int _nextClock = 1;
+
+  /// The textures allocated across all frame slots.
+  int get allocatedCount {
+    var count = 0;
+    for (final slot in _slots) {
+      count += slot.length;
+    }
+    return count;
+  }
+
+  /// See [TransientTexturePool.beginFrame].
+  void beginFrame() {
+    _frame = (_frame + 1) % framesInFlight;
+    for (final texture in _slots[_frame]) {
+      texture.busyUntil = -1;
+    }
+    _bindings.clear();
+    _acquired.clear();
+    _used.clear();
+    _now = 0;
+    _releaseAt = _frameEnd;
+    _nextClock = 1;
+  }
+
+  /// See [TransientTexturePool.acquire].
+  T acquire(TransientTextureDescriptor descriptor) {
+    final releaseAt = aliasing ? _releaseAt : _frameEnd;
+    _acquired.add(descriptor);
+    final bound = _bindings[descriptor];
+    if (bound != null && bound.busyUntil >= _now) {
+      if (releaseAt > bound.busyUntil) bound.busyUntil = releaseAt;
+      return bound.texture;
+    }
+    final slot = _slots[_frame];
+    // A free compatible texture, preferring the one this descriptor was
+    // last bound to, so a steady frame binds the same textures every time.
+    _PooledTexture<T>? pooled;
+    for (final candidate in slot) {
+      if (candidate.busyUntil >= _now ||
+          !candidate.descriptor.isCompatibleWith(descriptor)) {
+        continue;
+      }
+      if (candidate.lastBound == descriptor) {
+        pooled = candidate;
+        break;
+      }
+      pooled ??= candidate;
+    }
+    if (pooled == null) {
+      pooled = _PooledTexture(descriptor, create(descriptor));
+      slot.add(pooled);
+    }
+    pooled
+      ..busyUntil = releaseAt
+      ..lastBound = descriptor;
+    _bindings[descriptor] = pooled;
+    _used.add(pooled);
+    return pooled.texture;
+  }
+
+  /// See [TransientTexturePool.reservePasses].
+  int reservePasses(int count) {
+    final first = _nextClock;
+    _nextClock += count;
+    return first;
+  }
+
+  /// See [TransientTexturePool.beginPass].
+  void beginPass(int clock, {int? releaseAfter}) {
+    _now = clock;
+    _releaseAt = releaseAfter ?? _frameEnd;
+  }
+
+  /// See [TransientTexturePool.endPass].
+  void endPass() {
+    _now = _nextClock;
+    _releaseAt = _frameEnd;
+  }
+
+  /// See [TransientTexturePool.unaliasedBytes].
+  int get unaliasedBytes {
+    var bytes = 0;
+    for (final descriptor in _acquired) {
+      bytes += descriptor.sizeInBytes;
+    }
+    return bytes;
+  }
+
+  /// See [TransientTexturePool.aliasedBytes].
+  int get aliasedBytes {
+    var bytes = 0;
+    for (final texture in _used) {
+      bytes += texture.descriptor.sizeInBytes;
+    }
+    return bytes;
+  }
+
+  /// See [TransientTexturePool.clear].
+  void clear() {
+    for (final slot in _slots) {
+      slot.clear();
+    }
+    _bindings.clear();
+    _acquired.clear();
+    _used.clear();
+  }
+}
+
+class _PooledTexture<T extends Object> {
+  _PooledTexture(this.descriptor, this.texture);
+
+  // The descriptor it was allocated for (compatible with every one it
+  // serves).
+  final TransientTextureDescriptor descriptor;
+  final T texture;
+
+  // The last pass clock reading it this frame; -1 while free.
+  int busyUntil = -1;
+  TransientTextureDescriptor? lastBound;
 }
 
 /// Per-frame state handed to every [RenderGraphPass] when the graph
@@ -272,8 +510,15 @@ class RenderGraphContext {
 /// hosting one `gpu.RenderPass` against some render target), reading
 /// their inputs from and publishing their outputs to
 /// [RenderGraphContext.blackboard]. Passes run in the order they were
-/// added to the graph; there is no automatic reordering or culling, so
-/// the code building the graph decides which passes to add.
+/// added to the graph; there is no automatic reordering.
+///
+/// A pass may declare the blackboard keys it reads ([inputs]) and
+/// publishes ([outputs]). The graph uses the declarations to cull passes
+/// whose outputs nothing reads and to release each pass's transient
+/// textures after the last pass that reads its outputs, so later passes can
+/// reuse the memory (see [TransientTexturePool]). Undeclared passes are
+/// treated conservatively: they may read anything, are never culled, and
+/// keep their textures for the rest of the frame.
 ///
 /// Named `RenderGraphPass` rather than `RenderPass` to avoid colliding
 /// with `gpu.RenderPass` from `package:flutter_gpu`.
@@ -284,6 +529,73 @@ abstract class RenderGraphPass {
   /// Records and submits this pass's work, using [context] for transient
   /// uniforms / attachments and to read/publish cross-pass handles.
   void execute(RenderGraphContext context);
+
+  /// The blackboard keys this pass may read, or null (the default) when it
+  /// may read any key.
+  Set<Object>? get inputs => null;
+
+  /// The blackboard keys this pass may publish, or null (the default) when
+  /// undeclared. Every texture the pass acquires stays live until the last
+  /// pass reading one of these keys, so a pass must declare every key it
+  /// publishes a transient texture under.
+  Set<Object>? get outputs => null;
+
+  /// Whether the pass does more than publish its [outputs] (draws into a
+  /// caller-owned target, advances persistent state), so it runs even when
+  /// nothing reads them. True unless [outputs] are declared.
+  bool get hasSideEffects => outputs == null;
+}
+
+/// Which passes of a graph run, and how long the transient textures each
+/// one acquires must live, from the passes' declared inputs and outputs.
+class RenderGraphSchedule {
+  RenderGraphSchedule(List<RenderGraphPass> passes)
+    : culled = List<bool>.filled(passes.length, false),
+      releaseAfter = List<int?>.filled(passes.length, null) {
+    // Walk backwards collecting the keys later running passes may read.
+    final needed = <Object>{};
+    var readsAnything = false;
+    for (var i = passes.length - 1; i >= 0; i--) {
+      final pass = passes[i];
+      final outputs = pass.outputs;
+      final runs =
+          pass.hasSideEffects ||
+          outputs == null ||
+          (readsAnything && outputs.isNotEmpty) ||
+          outputs.any(needed.contains);
+      if (!runs) {
+        culled[i] = true;
+        continue;
+      }
+      final inputs = pass.inputs;
+      if (inputs == null) {
+        readsAnything = true;
+      } else {
+        needed.addAll(inputs);
+      }
+    }
+    // A pass with declared outputs keeps its textures through the last
+    // running pass that may read one of them.
+    for (var i = 0; i < passes.length; i++) {
+      final outputs = passes[i].outputs;
+      if (culled[i] || outputs == null) continue;
+      var last = i;
+      for (var j = i + 1; j < passes.length; j++) {
+        if (culled[j]) continue;
+        final inputs = passes[j].inputs;
+        if (inputs == null || outputs.any(inputs.contains)) last = j;
+      }
+      releaseAfter[i] = last;
+    }
+  }
+
+  /// Per pass, whether it is skipped.
+  final List<bool> culled;
+
+  /// Per pass, the index of the last pass that may read its outputs (its
+  /// own index when none does), or null when its textures must live for
+  /// the rest of the frame.
+  final List<int?> releaseAfter;
 }
 
 /// An ordered list of [RenderGraphPass]es executed once per frame.
@@ -292,8 +604,9 @@ abstract class RenderGraphPass {
 /// insertion order, transient render targets come from a shared
 /// [TransientTexturePool], and passes communicate through a per-frame
 /// [Blackboard]. It does not insert GPU barriers (Flutter GPU handles
-/// synchronization internally), alias transient memory, or cull unused
-/// passes.
+/// synchronization internally). From the passes' declared inputs and
+/// outputs it culls passes nothing reads and bounds each pass's transient
+/// textures' lifetimes, so the pool can alias them (see [RenderGraphPass]).
 class RenderGraph {
   static final RenderProfileAccumulator _profile = RenderProfileAccumulator();
 
@@ -303,6 +616,10 @@ class RenderGraph {
   /// Appends [pass] to the end of the execution order.
   void addPass(RenderGraphPass pass) => _passes.add(pass);
 
+  /// The culling and texture lifetimes [execute] applies to the passes
+  /// added so far.
+  RenderGraphSchedule schedule() => RenderGraphSchedule(_passes);
+
   /// Runs every pass in order, using [transientsBuffer] for transient
   /// uniforms and [texturePool] for transient attachments. Each pass
   /// creates and submits its own command buffer. Clears the blackboard
@@ -324,25 +641,59 @@ class RenderGraph {
           ? _blackboard
           : _RecordingBlackboard(_blackboard, observer),
     );
+    final schedule = this.schedule();
+    final firstClock = texturePool.reservePasses(_passes.length);
+    final tracer = FrameTracer.active;
     if (observer != null) {
       for (var i = 0; i < _passes.length; i++) {
         final pass = _passes[i];
+        if (schedule.culled[i]) {
+          observer.onPassCulled(pass, i);
+          continue;
+        }
+        _beginPass(texturePool, schedule, firstClock, i);
         observer.onPassBegin(pass, i);
+        tracer?.begin(pass.name, category: 'pass');
         final stopwatch = Stopwatch()..start();
-        pass.execute(context);
+        try {
+          pass.execute(context);
+        } finally {
+          tracer?.end();
+        }
         stopwatch.stop();
         observer.onPassEnd(pass, stopwatch.elapsedMicroseconds);
+        texturePool.endPass();
       }
+      observer.onTransientMemory(
+        unaliasedBytes: texturePool.unaliasedBytes,
+        aliasedBytes: texturePool.aliasedBytes,
+      );
       return;
     }
-    for (final pass in _passes) {
+    for (var i = 0; i < _passes.length; i++) {
+      if (schedule.culled[i]) continue;
+      final pass = _passes[i];
+      _beginPass(texturePool, schedule, firstClock, i);
+      // A throwing pass still closes its span, so later spans in the trace
+      // do not nest under it.
+      tracer?.begin(pass.name, category: 'pass');
       if (!profileRendering) {
-        pass.execute(context);
+        try {
+          pass.execute(context);
+        } finally {
+          tracer?.end();
+        }
+        texturePool.endPass();
         continue;
       }
       final stopwatch = Stopwatch()..start();
-      pass.execute(context);
+      try {
+        pass.execute(context);
+      } finally {
+        tracer?.end();
+      }
       stopwatch.stop();
+      texturePool.endPass();
       _profile.add(pass.name, stopwatch.elapsedMicroseconds, trackMax: true);
     }
     if (profileRendering) {
@@ -361,4 +712,17 @@ class RenderGraph {
       print('FLUTTER_SCENE_PROFILE $summary');
     }
   }
+
+  static void _beginPass(
+    TransientTexturePool pool,
+    RenderGraphSchedule schedule,
+    int firstClock,
+    int index,
+  ) {
+    final releaseAfter = schedule.releaseAfter[index];
+    pool.beginPass(
+      firstClock + index,
+      releaseAfter: releaseAfter == null ? null : firstClock + releaseAfter,
+    );
+  }
 }
@@ -138,10 +138,23 @@ class RenderGraphCaptureResult {
     required this.resources,
     required this.pixelWidth,
     required this.pixelHeight,
+    this.culledPasses = const [],
+    this.transientBytes = 0,
+    this.aliasedTransientBytes = 0,
   });
 
   final List<CapturedPass> passes;
 
+  /// The names of the passes the graph culled because nothing read their
+  /// outputs, in graph order.
+  final List<String> culledPasses;
+
+  /// The frame's transient textures in bytes, counted once per descriptor
+  /// ([transientBytes]) and once per physical texture after lifetime
+  /// aliasing ([aliasedTransientBytes]).
+  final int transientBytes;
+  final int aliasedTransientBytes;
+
   /// Every observed resource, in write order (build-time acquisitions
   /// first). A key rewritten by a later pass appears once per write, each
   /// entry carrying that write's snapshot.
@@ -178,6 +191,9 @@ class RenderGraphCapturer implements RenderGraphObserver {
   final Map<String, Object?> _pendingWrites = {};
   // Acquired this pass but (not yet) published to the blackboard.
   final List<gpu.Texture> _pendingAcquires = [];
+  final List<String> _culledPasses = [];
+  int _transientBytes = 0;
+  int _aliasedTransientBytes = 0;
   CapturedPass? _current;
 
   /// Finishes the capture over the executed graph.
@@ -189,6 +205,9 @@ class RenderGraphCapturer implements RenderGraphObserver {
     resources: _resources,
     pixelWidth: pixelWidth,
     pixelHeight: pixelHeight,
+    culledPasses: _culledPasses,
+    transientBytes: _transientBytes,
+    aliasedTransientBytes: _aliasedTransientBytes,
   );
 
   @override
@@ -237,6 +256,20 @@ class RenderGraphCapturer implements RenderGraphObserver {
     _current = null;
   }
 
+  @override
+  void onPassCulled(RenderGraphPass pass, int indexInGraph) {
+    _culledPasses.add(pass.name);
+  }
+
+  @override
+  void onTransientMemory({
+    required int unaliasedBytes,
+    required int aliasedBytes,
+  }) {
+    _transientBytes = unaliasedBytes;
+    _aliasedTransientBytes = aliasedBytes;
+  }
+
   @override
   void onBlackboardRead(Object key, Object? value) {
     final current = _current;
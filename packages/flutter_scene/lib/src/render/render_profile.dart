@@ -42,4 +42,5 @@ class RenderProfileSnapshot {
 
   int mean(String name) => totals[name]! ~/ counts[name]!;
   int max(String name) => maxima[name] ?? 0;
+  int total(String name) => totals[name] ?? 0;
 }
@@ -16,10 +16,17 @@ import 'package:flutter_scene/src/components/spot_light_component.dart';
 import 'package:flutter_scene/src/geometry/geometry.dart';
 import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
 import 'package:flutter_scene/src/material/material.dart';
-import 'package:flutter_scene/src/render/bvh.dart';
+import 'package:flutter_scene/src/occlusion_culling.dart';
 import 'package:flutter_scene/src/render/custom_render_pass.dart';
+import 'package:flutter_scene/src/render/frame_tracer.dart';
+import 'package:flutter_scene/src/render/instance_cull_tree.dart';
 import 'package:flutter_scene/src/render/lod.dart';
 import 'package:flutter_scene/src/render/render_layers.dart';
+import 'package:flutter_scene/src/render/retained_draw_order.dart';
+import 'package:flutter_scene/src/render/retained_instance_buffer.dart';
+import 'package:flutter_scene/src/render/scene_bvh.dart';
+import 'package:flutter_scene/src/render/shadow_encoder.dart'
+    show ShadowCasterFilter;
 
 /// One drawable primitive in the flat render layer.
 ///
@@ -65,6 +72,11 @@ class RenderItem {
   /// Mirrors the owning node's frustum-cull opt-in, refreshed each frame.
   bool frustumCulled = true;
 
+  /// The owning node's [Occluder], placed by [worldTransform], refreshed
+  /// each frame. Set on the node's first primitive only, so a multi-primitive
+  /// mesh rasterizes it once.
+  Occluder? occluder;
+
   /// The owning node's render layers (a 32-bit bitmask), refreshed each
   /// frame. A render pass skips this item when its view's layer mask does
   /// not intersect (`layers & layerMask == 0`).
@@ -111,6 +123,10 @@ class RenderItem {
   gpu.Texture? jointsTexture;
   int jointsTextureWidth = 0;
 
+  /// Whether [jointsTexture] holds a pose shared between characters, in
+  /// the mesh node's space rather than world space (see [Skin.sharedPose]).
+  bool jointsInModelSpace = false;
+
   /// Applies this item's joints texture to [drawnGeometry] (which differs
   /// from [geometry] when a level of detail was selected). No-op for
   /// unskinned items. Render passes call this immediately before the
@@ -120,6 +136,7 @@ class RenderItem {
     final texture = jointsTexture;
     if (texture == null) return;
     drawnGeometry.setJointsTexture(texture, jointsTextureWidth);
+    drawnGeometry.setJointsInModelSpace(jointsInModelSpace);
   }
 
   /// The owning node's live morph target weights, or null for an unmorphed
@@ -161,6 +178,26 @@ class RenderItem {
   /// swap removal instead of a list scan.
   int sceneSlot = -1;
 
+  /// This item's place in the scene's [SceneBvh]: its leaf in the static
+  /// tree, its proxy in the dynamic tree, and its index in the
+  /// always-visible list, each `-1` when it has none. Maintained by
+  /// [SceneBvh].
+  @internal
+  int bvhStaticLeaf = -1;
+  @internal
+  int bvhDynamicProxy = -1;
+  @internal
+  int bvhAlwaysVisibleSlot = -1;
+
+  /// The [SceneBvh] frame this item last moved in, which decides whether a
+  /// static rebuild may place it in the static tree. Starts long settled.
+  @internal
+  int bvhMovedFrame = -0x40000000;
+
+  /// Whether this item is queued for the next [SceneBvh.update].
+  @internal
+  bool bvhQueued = false;
+
   /// Per-instance model transforms, or `null` for a non-instanced item.
   ///
   /// When set, this item draws [geometry] / [material] once per entry,
@@ -196,6 +233,11 @@ class RenderItem {
   /// Packed world-space instance AABBs, six floats per instance.
   Float32List? _instanceWorldBounds;
 
+  // Culls the instances of items with at least [_instanceCullTreeMin] of
+  // them; created on first use.
+  InstanceCullTree? _instanceCullTree;
+  static const int _instanceCullTreeMin = 1024;
+
   /// Packed world transform and color records, twenty floats per instance plus
   /// [instanceAttributeFloats] custom attribute floats.
   @internal
@@ -205,13 +247,26 @@ class RenderItem {
   @internal
   Uint8List? instanceWorldWindingFlipped;
 
+  RetainedInstanceBuffer? _retainedInstances;
+
+  /// [instanceWorldData] kept in device memory across frames, created on
+  /// first use and kept in step by [refreshInstanceData].
+  @internal
+  RetainedInstanceBuffer get retainedInstances =>
+      _retainedInstances ??= RetainedInstanceBuffer();
+
   static final Matrix4 _instanceWorldScratch = Matrix4.zero();
   static final Aabb3 _instanceAabbScratch = Aabb3();
 
   /// Rebuilds cached world-space bounds and draw data after a node, geometry,
   /// or instance change. Static groups pay this once during setup.
+  ///
+  /// With [start] and [end], only the instances in that range are repacked,
+  /// for edits that left the instance count and everything else unchanged;
+  /// a range falls back to a full rebuild while the packed data is missing
+  /// or sized for a different count.
   @internal
-  void refreshInstanceData() {
+  void refreshInstanceData({int start = 0, int? end}) {
     final instances = instanceTransforms;
     final bounds = geometry.localBounds;
     final colors = instanceColors;
@@ -219,29 +274,42 @@ class RenderItem {
       _instanceWorldBounds = null;
       instanceWorldData = null;
       instanceWorldWindingFlipped = null;
+      _retainedInstances = null;
       return;
     }
-    final boundsLength = instances.length * 6;
-    final packedBounds = bounds == null || !cullInstances
-        ? null
-        : (_instanceWorldBounds?.length == boundsLength
-              ? _instanceWorldBounds!
-              : Float32List(boundsLength));
+    final count = instances.length;
+    final boundsLength = count * 6;
+    var reused = true;
+    Float32List? packedBounds;
+    if (bounds != null && cullInstances) {
+      packedBounds = _instanceWorldBounds;
+      if (packedBounds?.length != boundsLength) {
+        packedBounds = Float32List(boundsLength);
+        reused = false;
+      }
+    }
     final attributes = instanceAttributeData;
     final attributeFloats = attributes == null ? 0 : instanceAttributeFloats;
     final recordFloats = 20 + attributeFloats;
-    final dataLength = instances.length * recordFloats;
-    final packedData = colors == null || colors.length != instances.length
-        ? null
-        : (instanceWorldData?.length == dataLength
-              ? instanceWorldData!
-              : Float32List(dataLength));
-    final packedWinding =
-        instanceWorldWindingFlipped?.length == instances.length
+    final dataLength = count * recordFloats;
+    Float32List? packedData;
+    if (colors != null && colors.length == count) {
+      packedData = instanceWorldData;
+      if (packedData?.length != dataLength) {
+        packedData = Float32List(dataLength);
+        reused = false;
+      }
+    }
+    final packedWinding = instanceWorldWindingFlipped?.length == count
         ? instanceWorldWindingFlipped!
-        : Uint8List(instances.length);
+        : Uint8List(count);
+    if (!identical(packedWinding, instanceWorldWindingFlipped)) reused = false;
+    final first = reused ? start.clamp(0, count) : 0;
+    final last = reused ? (end ?? count).clamp(first, count) : count;
+    final full = first == 0 && last == count;
+    var windingChanged = false;
     final retainedWinding = instanceWindingFlipped;
-    for (var i = 0; i < instances.length; i++) {
+    for (var i = first; i < last; i++) {
       _instanceWorldScratch
         ..setFrom(worldTransform)
         ..multiply(instances[i]);
@@ -272,11 +340,22 @@ class RenderItem {
       }
       final instanceFlipped =
           retainedWinding?[i] ?? (instances[i].determinant() < 0);
-      packedWinding[i] = windingFlipped != instanceFlipped ? 1 : 0;
+      final winding = windingFlipped != instanceFlipped ? 1 : 0;
+      if (packedWinding[i] != winding) windingChanged = true;
+      packedWinding[i] = winding;
     }
     _instanceWorldBounds = packedBounds;
     instanceWorldData = packedData;
     instanceWorldWindingFlipped = packedWinding;
+    if (packedBounds != null) _instanceCullTree?.markMoved(first, last);
+    final retained = _retainedInstances;
+    if (retained != null) {
+      if (full || windingChanged) {
+        retained.markAll();
+      } else {
+        retained.markDirty(first, last);
+      }
+    }
   }
 
   /// Refreshes [visibleInstanceIndices] and returns whether anything remains.
@@ -316,6 +395,26 @@ class RenderItem {
     final instanceWorldBounds = _instanceWorldBounds!;
 
     final visible = _visibleInstanceScratch..clear();
+    if (instances.length >= _instanceCullTreeMin &&
+        (_instanceCullTree ??= InstanceCullTree()).cull(
+          instanceWorldBounds,
+          instances.length,
+          frustum,
+          additionalPlanes,
+          visible,
+        )) {
+      // The tree lists instances by cluster; restore instance order where
+      // it is the draw order.
+      if (!sortTransparentInstances &&
+          visible.length < instances.length &&
+          !material.isOpaque()) {
+        visible.sort();
+      }
+      visibleInstanceIndices = visible.length == instances.length
+          ? null
+          : visible;
+      return visible.isNotEmpty;
+    }
     for (var i = 0; i < instances.length; i++) {
       final offset = i * 6;
       if (_outsidePlane(instanceWorldBounds, offset, frustum.plane0) ||
@@ -417,7 +516,7 @@ class RenderItem {
 ///
 /// The node graph registers and unregisters items as mesh-bearing nodes
 /// are mounted into and out of the scene. Bounded items are placed in a
-/// [Bvh]; unbounded items (no [RenderItem.worldBounds], or
+/// two-level [SceneBvh]; unbounded items (no [RenderItem.worldBounds], or
 /// [RenderItem.frustumCulled] off) are always visited.
 class RenderScene {
   /// Every registered render item, in no particular order.
@@ -628,12 +727,20 @@ class RenderScene {
     cameras.remove(camera);
   }
 
+  /// The cameras the last frame rendered from, which animation level of
+  /// detail measures characters against in the next pre-pass.
+  final List<LodView> lodViews = [];
+
+  /// Clip evaluations animation level of detail skipped in the last
+  /// pre-pass, summed over every node's player.
+  int skippedAnimationEvaluations = 0;
+
   /// The scene's primary camera: the explicit [cameraOverride] if set, else
   /// the first mounted [CameraComponent]'s camera, else null.
   Camera? get primaryCamera =>
       cameraOverride ?? (cameras.isEmpty ? null : cameras.first.toCamera());
 
-  Bvh _bvh = Bvh.build([]);
+  final SceneBvh _bvh = SceneBvh();
   int _structureRevision = 0;
   int _staticShadowRevision = 0;
 
@@ -643,6 +750,48 @@ class RenderScene {
   /// Changes when a retained static shadow caster changes.
   int get staticShadowRevision => _staticShadowRevision;
 
+  /// The last sorted opaque draw list of the color pass of the [index]th
+  /// [view], reused across frames while [structureRevision] holds.
+  ///
+  /// Each view culls its own set and sees it front to back from its own
+  /// camera (a reflection capture or cube face sees the scene mirrored or
+  /// turned away), so each keeps its own order rather than starting from
+  /// another view's ranks.
+  RetainedDrawOrder opaqueDrawOrder(DrawOrderView view, int index) =>
+      _drawOrderAt(_opaqueDrawOrders[view.index], index);
+
+  /// The last sorted draw list of the depth prepass of the [index]th
+  /// [view] (see [opaqueDrawOrder]).
+  RetainedDrawOrder depthDrawOrder(DrawOrderView view, int index) =>
+      _drawOrderAt(_depthDrawOrders[view.index], index);
+
+  final List<List<RetainedDrawOrder>> _opaqueDrawOrders = [
+    for (final _ in DrawOrderView.values) [],
+  ];
+  final List<List<RetainedDrawOrder>> _depthDrawOrders = [
+    for (final _ in DrawOrderView.values) [],
+  ];
+
+  /// The last sorted draw list of shadow map [tile] (the cascades, then
+  /// the spot cones) drawn under [filter].
+  ///
+  /// Every tile culls its own caster set, and a cached cascade's static
+  /// refresh and dynamic composite sort subsets of it, so each pair keeps
+  /// its own order rather than starting from another tile's ranks.
+  RetainedDrawOrder shadowDrawOrder(int tile, ShadowCasterFilter filter) =>
+      _drawOrderAt(_shadowDrawOrders[filter.index], tile);
+
+  RetainedDrawOrder _drawOrderAt(List<RetainedDrawOrder> orders, int index) {
+    while (orders.length <= index) {
+      orders.add(RetainedDrawOrder(this));
+    }
+    return orders[index];
+  }
+
+  final List<List<RetainedDrawOrder>> _shadowDrawOrders = [
+    for (final _ in ShadowCasterFilter.values) [],
+  ];
+
   /// Invalidates the cached static-caster fingerprint.
   void markStaticShadowDirty() {
     _staticShadowRevision++;
@@ -651,22 +800,13 @@ class RenderScene {
   /// The spatial structure over the bounded items, current after
   /// [rebuildIfDirty]. Used by the light culler to scatter each light onto the
   /// items it reaches.
-  Bvh get bvh => _bvh;
-
-  final List<RenderItem> _alwaysVisible = [];
-
-  // The BVH needs a full rebuild: an item was added or removed, or an
-  // item's BVH membership changed.
-  bool _structureDirty = true;
-
-  // A bounded item moved; the BVH can refit instead of rebuilding.
-  bool _boundsDirty = false;
+  SceneBvh get bvh => _bvh;
 
   void add(RenderItem item) {
     item.sceneSlot = items.length;
     items.add(item);
     _structureRevision++;
-    _structureDirty = true;
+    _bvh.markItemDirty(item);
   }
 
   void remove(RenderItem item) {
@@ -679,44 +819,37 @@ class RenderScene {
     }
     item.sceneSlot = -1;
     _structureRevision++;
-    _structureDirty = true;
+    _bvh.removeItem(item);
   }
 
-  /// Flags the BVH for a full rebuild. Called when an item's BVH
-  /// membership changed (its `frustumCulled` flag toggled, or it became
-  /// bounded or unbounded).
-  void markBvhStructureDirty() {
-    _structureDirty = true;
+  /// Flags [item]'s BVH membership as changed (its `frustumCulled` flag
+  /// toggled, or it became bounded or unbounded). Without an item, the
+  /// whole BVH is rebuilt.
+  void markBvhStructureDirty([RenderItem? item]) {
+    if (item == null) {
+      _bvh.markAllDirty();
+    } else {
+      _bvh.markItemDirty(item);
+    }
   }
 
-  /// Flags the BVH for a refit. Called when a bounded item moved but the
-  /// item set and membership are unchanged.
-  void markBvhBoundsDirty() {
-    _boundsDirty = true;
+  /// Flags [item] as moved, with its membership unchanged. Without an
+  /// item, every indexed item's bounds are re-read.
+  void markBvhBoundsDirty([RenderItem? item]) {
+    if (item == null) {
+      _bvh.markAllMoved();
+    } else {
+      _bvh.markItemDirty(item);
+    }
   }
 
   /// Brings the spatial structure up to date with the current items.
   /// Call once per frame, after the pre-pass and before the render
-  /// passes. Rebuilds on a structural change, otherwise refits when an
-  /// item moved, otherwise does nothing.
+  /// passes. Added and moved items go to the dynamic tree in O(log n)
+  /// each; the static tree is rebuilt only when enough of it went stale
+  /// (see [SceneBvh]).
   void rebuildIfDirty() {
-    if (_structureDirty) {
-      _structureDirty = false;
-      _boundsDirty = false;
-      _alwaysVisible.clear();
-      final bounded = <RenderItem>[];
-      for (final item in items) {
-        if (item.frustumCulled && item.worldBounds != null) {
-          bounded.add(item);
-        } else {
-          _alwaysVisible.add(item);
-        }
-      }
-      _bvh = Bvh.build(bounded);
-    } else if (_boundsDirty) {
-      _boundsDirty = false;
-      _bvh.refit();
-    }
+    _bvh.update(items);
   }
 
   /// Visits every item potentially visible to [frustum]: the bounded
@@ -727,18 +860,58 @@ class RenderScene {
     void Function(RenderItem) visit, {
     List<Plane> additionalPlanes = const [],
   }) {
+    final tracer = FrameTracer.active;
+    var visible = 0;
+    if (tracer != null) {
+      // Count what the query accepts, for the culled-items counter.
+      final uncounted = visit;
+      visit = (item) {
+        visible++;
+        uncounted(item);
+      };
+      tracer.begin('bvh.query');
+    }
     _bvh.query(frustum, visit, additionalPlanes: additionalPlanes);
-    for (final item in _alwaysVisible) {
+    for (final item in _bvh.alwaysVisible) {
       visit(item);
     }
+    if (tracer != null) {
+      tracer.end();
+      tracer.counter('culling', {
+        'visible': visible,
+        'culled': items.length - visible,
+      });
+    }
   }
 
-  /// Collects material inputs requested by this view's frustum candidates.
+  /// [cull] for several views in one BVH traversal: appends every item
+  /// potentially visible to `frustums[v]` to `visible[v]`, always-visible
+  /// items included. `additionalPlanes[v]`, when present, applies to view
+  /// `v` only.
+  void cullMany(
+    List<Frustum> frustums,
+    List<List<RenderItem>> visible, {
+    List<List<Plane>> additionalPlanes = const [],
+  }) {
+    final tracer = FrameTracer.active;
+    tracer?.begin('bvh.queryMany', args: {'views': frustums.length});
+    _bvh.queryMany(frustums, visible, additionalPlanes: additionalPlanes);
+    tracer?.end();
+    final alwaysVisible = _bvh.alwaysVisible;
+    if (alwaysVisible.isEmpty) return;
+    for (var v = 0; v < frustums.length; v++) {
+      visible[v].addAll(alwaysVisible);
+    }
+  }
+
+  /// Collects material inputs requested by this view's frustum candidates,
+  /// or by [candidates] when the view was already culled ([cullMany]).
   Set<RenderInput> collectMaterialInputs(
     Frustum frustum, {
     int layerMask = kRenderLayerAll,
     List<Plane> additionalPlanes = const [],
     bool includeOffscreen = false,
+    List<RenderItem>? candidates,
   }) {
     final inputs = <RenderInput>{};
     void collect(RenderItem item) {
@@ -760,6 +933,10 @@ class RenderScene {
       for (final item in items) {
         collect(item);
       }
+    } else if (candidates != null) {
+      for (final item in candidates) {
+        collect(item);
+      }
     } else {
       cull(frustum, collect, additionalPlanes: additionalPlanes);
     }
@@ -71,6 +71,20 @@ class ResolvePass extends RenderGraphPass {
   @override
   String get name => 'ResolvePass';
 
+  @override
+  Set<Object> get inputs => const {
+    kSceneColorBlackboardKey,
+    kBloomTextureBlackboardKey,
+    kAutoExposureFactorBlackboardKey,
+  };
+
+  @override
+  Set<Object> get outputs => const {kDisplayColorBlackboardKey};
+
+  // Writes the caller's output color.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final hdrColor = context.blackboard.require<gpu.Texture>(
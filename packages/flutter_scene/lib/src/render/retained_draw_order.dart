@@ -0,0 +1,267 @@
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/material/material.dart';
+import 'package:flutter_scene/src/render/draw_sort.dart';
+import 'package:flutter_scene/src/render/render_scene.dart';
+
+/// The kinds of view that keep their own retained draw orders, each
+/// numbered from zero per frame (see [RenderScene.opaqueDrawOrder]).
+enum DrawOrderView {
+  /// A view drawn to the screen, by its index among the screen views.
+  screen,
+
+  /// A view drawn into a render texture, by its index among the texture
+  /// views.
+  texture,
+
+  /// A planar reflection capture, by its index among the frame's captures.
+  planarCapture,
+
+  /// A face of an environment capture, by its index in the cube's faces.
+  cubeFace,
+}
+
+/// The sorted order of one kind of draw list, kept from the last frame and
+/// reused while the scene's structure is unchanged.
+///
+/// A steady scene submits the same items frame after frame, in the order
+/// its BVH happens to visit them. While [RenderScene.structureRevision] and
+/// the material scene-input revision hold, each item keeps its scene slot,
+/// so [sort] places this frame's draws by the rank their items had in the
+/// last sorted list (one key column instead of one per compared field),
+/// settles what changed (a swapped material, a new level of detail, depth
+/// drift as the camera moves) with an insertion pass under the exact
+/// comparator, and merges in the items that came into view. When more
+/// changed than that can cheaply absorb, it falls back to the full sort.
+/// Either way the result is in comparator order; only full ties may keep
+/// last frame's order instead of submission order.
+///
+/// Every view culls its own set and sees it in its own depth order, so the
+/// scene keeps one order per view and list kind: per screen or texture
+/// view, planar reflection capture, and environment cube face
+/// ([RenderScene.opaqueDrawOrder], [RenderScene.depthDrawOrder]), and per
+/// shadow map tile ([RenderScene.shadowDrawOrder]).
+///
+/// The order also keeps the batch boundaries the encoder found in it
+/// ([batchEnd]), which carry over while the order comes back unchanged.
+class RetainedDrawOrder {
+  RetainedDrawOrder(this._scene);
+
+  final RenderScene _scene;
+  final DrawKeySorter _sorter = DrawKeySorter(1);
+  final List<Object?> _fresh = [];
+
+  int _structureRevision = -1;
+  int _materialRevision = -1;
+  // Per scene slot, the slot item's rank in the last order offset by
+  // [_rankBase]; entries below [_rankBase] are from older orders. Moving the
+  // base past the last order's ranks retires them without clearing.
+  Int32List _ranks = Int32List(0);
+  int _rankBase = 0;
+  int _rankCount = 0;
+  bool _lastReused = false;
+  // Per position in the last order, the end of the batch [batchEnd] found
+  // starting there (0 where none did). Cleared when the order changes.
+  Int32List _batchEnds = Int32List(0);
+
+  /// Whether the last [sort] started from the retained order (and did not
+  /// fall back to the full sort).
+  bool get lastReused => _lastReused;
+
+  /// Sorts [records] into [compare] order and remembers the result.
+  ///
+  /// [itemOf] maps a record to the render item it draws; several records may
+  /// draw the same item. [fullSort] sorts from scratch, for the first frame
+  /// after a structure or material change, or when the retained order is
+  /// too far off.
+  void sort<T>(
+    List<T> records,
+    int Function(T a, T b) compare,
+    RenderItem Function(T record) itemOf,
+    void Function(List<T> records) fullSort,
+  ) {
+    final structureRevision = _scene.structureRevision;
+    final materialRevision = materialSceneInputsRevision;
+    _lastReused =
+        records.length > 1 &&
+        structureRevision == _structureRevision &&
+        materialRevision == _materialRevision &&
+        _sortFromRanks(records, compare, itemOf);
+    if (!_lastReused) fullSort(records);
+    _structureRevision = structureRevision;
+    _materialRevision = materialRevision;
+    _remember(records, itemOf);
+  }
+
+  /// The end of the batch of records that starts at [start] in the list
+  /// the last [sort] ordered, found by [find] (`opaqueBatchEnd` or
+  /// `depthBatchEnd`) and kept for the next frame.
+  ///
+  /// While the order comes back unchanged, the run kept from the last
+  /// frame is reused once [joins] confirms its members (and not the record
+  /// after it) still batch with [start]'s, so a batch split or merged by a
+  /// change that kept every position (a new light list, a level-of-detail
+  /// fade) is found again; [find] runs only for runs that changed.
+  int batchEnd<T>(
+    List<T> records,
+    int start,
+    int Function(List<T> records, int start) find,
+    bool Function(T first, T next) joins,
+  ) {
+    if (start < _batchEnds.length) {
+      final kept = _batchEnds[start];
+      if (kept > start && kept <= records.length) {
+        final first = records[start];
+        var end = start + 1;
+        while (end < kept && joins(first, records[end])) {
+          end++;
+        }
+        if (end == kept &&
+            (kept == records.length || !joins(first, records[kept]))) {
+          return kept;
+        }
+      }
+    }
+    final end = find(records, start);
+    if (_batchEnds.length < records.length) {
+      _batchEnds = Int32List(records.length + (records.length >> 1));
+    }
+    _batchEnds
+      ..fillRange(start, end, 0)
+      ..[start] = end;
+    return end;
+  }
+
+  /// [sort] for lists of the render items themselves.
+  void sortItems(
+    List<RenderItem> items,
+    int Function(RenderItem a, RenderItem b) compare,
+    void Function(List<RenderItem> items) fullSort,
+  ) => sort(items, compare, _itemOfItem, fullSort);
+
+  static RenderItem _itemOfItem(RenderItem item) => item;
+
+  bool _sortFromRanks<T>(
+    List<T> records,
+    int Function(T a, T b) compare,
+    RenderItem Function(T record) itemOf,
+  ) {
+    final count = records.length;
+    // Move the records whose items have a retained rank to the front; the
+    // rest (items that came into view) are sorted apart and merged in.
+    final fresh = _fresh..clear();
+    var ranked = 0;
+    for (var i = 0; i < count; i++) {
+      final record = records[i];
+      if (_rankOf(itemOf(record)) < 0) {
+        fresh.add(record);
+      } else {
+        records[ranked++] = record;
+      }
+    }
+    if (fresh.length * 2 > count) {
+      records.setAll(ranked, fresh.cast<T>());
+      fresh.clear();
+      return false;
+    }
+    records.length = ranked;
+    final sorter = _sorter..reset(ranked);
+    for (var i = 0; i < ranked; i++) {
+      sorter.setKey(0, i, _rankOf(itemOf(records[i])));
+    }
+    sorter.sort(records, compare);
+    final settled = _settle(records, compare, ranked);
+    if (!settled) {
+      records.addAll(fresh.cast<T>());
+    } else if (fresh.isNotEmpty) {
+      fresh.sort((a, b) => compare(a as T, b as T));
+      _mergeFresh(records, fresh, compare);
+    }
+    fresh.clear();
+    return settled;
+  }
+
+  // The rank [item] had in the last order, or -1.
+  int _rankOf(RenderItem item) {
+    final slot = item.sceneSlot;
+    if (slot < 0 || slot >= _ranks.length) return -1;
+    final stored = _ranks[slot];
+    return stored >= _rankBase ? stored - _rankBase : -1;
+  }
+
+  // Merges the sorted [fresh] records into the sorted [records], back to
+  // front in place. A fresh record goes after the retained ones it ties.
+  static void _mergeFresh<T>(
+    List<T> records,
+    List<Object?> fresh,
+    int Function(T a, T b) compare,
+  ) {
+    var i = records.length - 1;
+    var j = fresh.length - 1;
+    records.addAll(fresh.cast<T>());
+    var write = records.length - 1;
+    while (j >= 0) {
+      final next = fresh[j] as T;
+      if (i >= 0 && compare(records[i], next) > 0) {
+        records[write--] = records[i--];
+      } else {
+        records[write--] = next;
+        j--;
+      }
+    }
+  }
+
+  // Insertion-sorts [records] unless that takes more than [budget] moves, in
+  // which case it stops (leaving a permutation) and returns false.
+  static bool _settle<T>(
+    List<T> records,
+    int Function(T a, T b) compare,
+    int budget,
+  ) {
+    var moves = 0;
+    for (var i = 1; i < records.length; i++) {
+      final record = records[i];
+      var j = i - 1;
+      while (j >= 0 && compare(records[j], record) > 0) {
+        records[j + 1] = records[j];
+        j--;
+        if (++moves > budget) {
+          records[j + 1] = record;
+          return false;
+        }
+      }
+      records[j + 1] = record;
+    }
+    return true;
+  }
+
+  void _remember<T>(List<T> records, RenderItem Function(T record) itemOf) {
+    final count = records.length;
+    // The batch ends carry over only to an order identical to the last.
+    var unchanged = _lastReused && count == _rankCount;
+    for (var i = 0; unchanged && i < count; i++) {
+      unchanged = _rankOf(itemOf(records[i])) == i;
+    }
+    if (!unchanged) _batchEnds.fillRange(0, _batchEnds.length, 0);
+    var base = _rankBase + _rankCount;
+    if (base + count > 0x3fffffff) {
+      _ranks.fillRange(0, _ranks.length, -1);
+      base = 0;
+    }
+    final slots = _scene.items.length;
+    if (_ranks.length < slots) {
+      final grown = Int32List(slots + (slots >> 1))
+        ..fillRange(0, slots + (slots >> 1), -1)
+        ..setRange(0, _ranks.length, _ranks);
+      _ranks = grown;
+    }
+    final ranks = _ranks;
+    for (var i = count - 1; i >= 0; i--) {
+      final slot = itemOf(records[i]).sceneSlot;
+      // Walking backwards leaves each item at its first record's rank.
+      if (slot >= 0 && slot < ranks.length) ranks[slot] = base + i;
+    }
+    _rankBase = base;
+    _rankCount = count;
+  }
+}
@@ -0,0 +1,228 @@
+import 'dart:typed_data';
+
+import 'package:flutter/foundation.dart' show visibleForTesting;
+import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/render/frame_transients.dart';
+
+/// A render item's packed instance records kept in device memory across
+/// frames, so a frame that edits a few instances uploads only their records.
+///
+/// The records are laid out by winding group, the counter-clockwise
+/// instances first and then the clockwise (mirrored) ones, each group in
+/// instance order, so each group draws from one range of the buffer. When
+/// every instance shares a winding the layout is the item's own
+/// `instanceWorldData`, uploaded straight from it; otherwise a partitioned
+/// copy is kept here.
+///
+/// The owner reports edits with [markDirty] (a range of instances whose
+/// records changed in place) or [markAll] (the count, record width, or a
+/// winding changed), then calls [sync] before drawing. A ring of buffers
+/// keeps a frame in flight from being overwritten: [sync] moves to another
+/// buffer only when something changed, and writes into it just the records
+/// it has not seen yet. A buffer is rewritten only once the submissions
+/// that read it have completed (see [SubmissionStampedSlots]); when the CPU
+/// runs further ahead than the ring covers, the ring grows.
+class RetainedInstanceBuffer {
+  /// Creates an empty buffer whose ring reuse follows [tracker], the
+  /// renderer's submissions by default.
+  RetainedInstanceBuffer([GpuSubmissionTracker? tracker])
+    : _slots = SubmissionStampedSlots(_initialRingSize, tracker);
+
+  static const int _initialRingSize = 3;
+
+  final SubmissionStampedSlots _slots;
+  final List<gpu.DeviceBuffer?> _ring = List<gpu.DeviceBuffer?>.filled(
+    _initialRingSize,
+    null,
+    growable: true,
+  );
+  // Per ring buffer, the packed records it lacks: [lo, hi) in the
+  // counter-clockwise group, then [lo, hi) in the clockwise group.
+  final List<int> _stale = List<int>.filled(
+    _initialRingSize * 4,
+    0,
+    growable: true,
+  );
+  int _cursor = 0;
+
+  bool _layoutValid = false;
+  int _count = 0;
+  int _recordFloats = 0;
+  int _ccwCount = 0;
+  // The partitioned records and each instance's place in them, or null
+  // while every instance shares a winding (records stay in instance order).
+  Float32List? _partitioned;
+  Int32List? _position;
+
+  // Instances edited since the last [sync], [_dirtyStart, _dirtyEnd).
+  int _dirtyStart = 0;
+  int _dirtyEnd = 0;
+
+  /// Instances drawn from the start of [buffer] with counter-clockwise
+  /// winding.
+  int get ccwCount => _ccwCount;
+
+  /// Instances drawn after the [ccwCount] ones with clockwise winding.
+  int get cwCount => _count - _ccwCount;
+
+  /// The buffer the last [sync] brought up to date.
+  gpu.DeviceBuffer get buffer => _ring[_cursor]!;
+
+  /// The buffers in the ring.
+  @visibleForTesting
+  int get ringLength => _ring.length;
+
+  /// Records that the instances in `[start, end)` changed in place.
+  void markDirty(int start, int end) {
+    if (start >= end) return;
+    if (_dirtyStart >= _dirtyEnd) {
+      _dirtyStart = start;
+      _dirtyEnd = end;
+    } else {
+      if (start < _dirtyStart) _dirtyStart = start;
+      if (end > _dirtyEnd) _dirtyEnd = end;
+    }
+  }
+
+  /// Records that every instance must be repacked.
+  void markAll() {
+    _layoutValid = false;
+  }
+
+  /// Brings the next ring buffer up to date with [data] (the item's packed
+  /// records, [recordFloats] floats each) and [winding] (one byte per
+  /// instance, nonzero when mirrored), and returns the bytes written, zero
+  /// when nothing changed since the last call.
+  int sync(Float32List data, Uint8List winding, int recordFloats) {
+    final count = winding.length;
+    if (!_layoutValid || count != _count || recordFloats != _recordFloats) {
+      _partition(data, winding, recordFloats);
+    } else if (_dirtyStart < _dirtyEnd) {
+      _repackDirty(data);
+    } else if (_ring[_cursor] != null) {
+      // Drawn again as is: the coming submission reads it too.
+      _slots.touch(_cursor);
+      return 0;
+    }
+    _dirtyStart = _dirtyEnd = 0;
+
+    final claimed = _slots.claim();
+    if (claimed == null) {
+      // Every buffer is still read by work in flight: add one, missing
+      // every record.
+      _ring.add(null);
+      _stale.addAll(const [0, 0, 0, 0]);
+      _cursor = _slots.grow();
+    } else {
+      _cursor = claimed;
+    }
+    final source = _partitioned ?? data;
+    final bytes = count * recordFloats * 4;
+    final current = _ring[_cursor];
+    final base = _cursor * 4;
+    if (current == null || current.sizeInBytes != bytes) {
+      _ring[_cursor] = gpu.gpuContext.createDeviceBufferWithCopy(
+        ByteData.sublistView(source),
+      );
+      _stale.fillRange(base, base + 4, 0);
+      return bytes;
+    }
+    var written = 0;
+    for (var group = 0; group < 2; group++) {
+      final lo = _stale[base + group * 2];
+      final hi = _stale[base + group * 2 + 1];
+      if (lo >= hi) continue;
+      final offset = lo * recordFloats * 4;
+      final view = ByteData.sublistView(source, offset, hi * recordFloats * 4);
+      current.overwrite(view, destinationOffsetInBytes: offset);
+      written += view.lengthInBytes;
+    }
+    _stale.fillRange(base, base + 4, 0);
+    return written;
+  }
+
+  void _partition(Float32List data, Uint8List winding, int recordFloats) {
+    final count = winding.length;
+    var ccwCount = 0;
+    for (var i = 0; i < count; i++) {
+      if (winding[i] == 0) ccwCount++;
+    }
+    _count = count;
+    _recordFloats = recordFloats;
+    _ccwCount = ccwCount;
+    _layoutValid = true;
+    if (ccwCount == 0 || ccwCount == count) {
+      _partitioned = null;
+      _position = null;
+    } else {
+      final partitioned = _partitioned?.length == data.length
+          ? _partitioned!
+          : Float32List(data.length);
+      final position = _position?.length == count
+          ? _position!
+          : Int32List(count);
+      var ccw = 0, cw = ccwCount;
+      for (var i = 0; i < count; i++) {
+        final target = winding[i] == 0 ? ccw++ : cw++;
+        position[i] = target;
+        partitioned.setRange(
+          target * recordFloats,
+          (target + 1) * recordFloats,
+          data,
+          i * recordFloats,
+        );
+      }
+      _partitioned = partitioned;
+      _position = position;
+    }
+    // Every buffer in the ring is now stale in full.
+    for (var slot = 0; slot < _ring.length; slot++) {
+      final base = slot * 4;
+      _stale[base] = 0;
+      _stale[base + 1] = ccwCount;
+      _stale[base + 2] = ccwCount;
+      _stale[base + 3] = count;
+    }
+  }
+
+  void _repackDirty(Float32List data) {
+    final recordFloats = _recordFloats;
+    final partitioned = _partitioned;
+    final position = _position;
+    // A contiguous run of instances lands in one contiguous run per group.
+    var ccwLo = _count, ccwHi = 0, cwLo = _count, cwHi = 0;
+    for (var i = _dirtyStart; i < _dirtyEnd && i < _count; i++) {
+      final target = position == null ? i : position[i];
+      if (partitioned != null) {
+        partitioned.setRange(
+          target * recordFloats,
+          (target + 1) * recordFloats,
+          data,
+          i * recordFloats,
+        );
+      }
+      if (target < _ccwCount) {
+        if (target < ccwLo) ccwLo = target;
+        if (target >= ccwHi) ccwHi = target + 1;
+      } else {
+        if (target < cwLo) cwLo = target;
+        if (target >= cwHi) cwHi = target + 1;
+      }
+    }
+    for (var slot = 0; slot < _ring.length; slot++) {
+      _widen(slot * 4, ccwLo, ccwHi);
+      _widen(slot * 4 + 2, cwLo, cwHi);
+    }
+  }
+
+  void _widen(int index, int lo, int hi) {
+    if (lo >= hi) return;
+    if (_stale[index] >= _stale[index + 1]) {
+      _stale[index] = lo;
+      _stale[index + 1] = hi;
+      return;
+    }
+    if (lo < _stale[index]) _stale[index] = lo;
+    if (hi > _stale[index + 1]) _stale[index + 1] = hi;
+  }
+}
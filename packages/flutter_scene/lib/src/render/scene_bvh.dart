@@ -0,0 +1,306 @@
+import 'dart:math' as math;
+
+import 'package:flutter_scene/src/render/bvh.dart';
+import 'package:flutter_scene/src/render/dynamic_bvh.dart';
+import 'package:flutter_scene/src/render/frame_tracer.dart';
+import 'package:flutter_scene/src/render/render_profile.dart';
+import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:vector_math/vector_math.dart';
+
+/// Why [SceneBvh] rebuilt its static level.
+enum BvhRebuildCause {
+  /// The first build, before any item was indexed.
+  initial,
+
+  /// An explicit whole-scene invalidation
+  /// ([RenderScene.markBvhStructureDirty] without an item).
+  structure,
+
+  /// Too many static leaves were retired by moves and removals.
+  retired,
+
+  /// Enough items in the dynamic tree stopped moving to promote them.
+  settled,
+}
+
+/// The two-level spatial index over a [RenderScene]'s items.
+///
+/// Settled items live in a static [Bvh], built with its Morton sort and
+/// rebuilt rarely. Items added after that build, and static items that
+/// move, live in a small [DynamicBvh] with O(log n) insert, remove, and
+/// move, so spawning or despawning an actor never costs a full rebuild.
+/// Queries walk both trees. Items that cannot be culled (unbounded, or
+/// with [RenderItem.frustumCulled] off) are kept in [alwaysVisible].
+///
+/// A static item that moves is retired from the static tree (its leaf is
+/// skipped) and inserted into the dynamic one. The static tree is rebuilt
+/// over the items that have not moved for [settleFrames] frames once
+/// either retired static leaves or settled dynamic items outnumber a
+/// quarter of the static tree; recently moved items stay dynamic.
+///
+/// Changes are queued with [markItemDirty] and applied by [update], once
+/// per frame before the render passes query.
+class SceneBvh implements BvhQueries {
+  SceneBvh({this.settleFrames = 60}) : assert(settleFrames > 0);
+
+  /// How many frames an item must go without moving before a static
+  /// rebuild will place it in the static tree.
+  final int settleFrames;
+
+  // The floor for the rebuild thresholds, so tiny scenes do not rebuild
+  // on every change.
+  static const int _minRebuildBudget = 64;
+
+  static final RenderProfileAccumulator _profile = RenderProfileAccumulator();
+
+  Bvh _static = Bvh.build(const []);
+  final DynamicBvh _dynamic = DynamicBvh();
+  final List<RenderItem> _alwaysVisible = [];
+  final List<RenderItem> _pending = [];
+  BvhRebuildCause? _rebuildCause = BvhRebuildCause.initial;
+  bool _refitAll = false;
+  int _frame = 0;
+  int _staticBuildCount = 0;
+
+  // Per-frame profile counters, reset by [update].
+  int _builds = 0;
+  int _inserts = 0;
+  int _removes = 0;
+  int _moves = 0;
+  int _migrations = 0;
+
+  /// The items that cannot be culled, visited by every view.
+  List<RenderItem> get alwaysVisible => _alwaysVisible;
+
+  /// The settled level.
+  Bvh get staticBvh => _static;
+
+  /// The incrementally maintained level.
+  DynamicBvh get dynamicBvh => _dynamic;
+
+  /// How many times the static level has been built.
+  int get staticBuildCount => _staticBuildCount;
+
+  /// Queues [item] to be re-indexed by the next [update]: it was added,
+  /// moved, or its culling membership (bounded, [RenderItem.frustumCulled])
+  /// changed.
+  void markItemDirty(RenderItem item) {
+    if (item.bvhQueued) return;
+    item.bvhQueued = true;
+    _pending.add(item);
+  }
+
+  /// Drops [item] from the index immediately. Called when it leaves the
+  /// scene.
+  void removeItem(RenderItem item) {
+    item.bvhQueued = false;
+    _detach(item);
+    _removeAlwaysVisible(item);
+  }
+
+  /// Rebuilds the whole index on the next [update].
+  void markAllDirty() {
+    _rebuildCause ??= BvhRebuildCause.structure;
+  }
+
+  /// Re-reads every indexed item's bounds on the next [update], for a
+  /// move whose item is unknown.
+  void markAllMoved() {
+    _refitAll = true;
+  }
+
+  /// Applies the queued changes to [items], the scene's full item list.
+  void update(List<RenderItem> items) {
+    _frame++;
+    final tracer = FrameTracer.active;
+    tracer?.begin('bvh.update');
+    final cause = _rebuildCause;
+    if (cause != null) {
+      _rebuild(items, cause);
+    } else {
+      for (final item in _pending) {
+        if (!item.bvhQueued) continue;
+        item.bvhQueued = false;
+        if (item.sceneSlot < 0) continue;
+        _sync(item);
+      }
+      _pending.clear();
+      if (_refitAll) {
+        tracer?.begin('bvh.refit');
+        _static.refit();
+        _dynamic.refit();
+        tracer?.end();
+      }
+      final budget = math.max(
+        _minRebuildBudget,
+        (_static.leafCount - _static.retiredLeafCount) ~/ 4,
+      );
+      if (_static.retiredLeafCount > budget) {
+        _rebuild(items, BvhRebuildCause.retired);
+      } else if (_frame % settleFrames == 0 && _dynamic.length > budget) {
+        var settled = 0;
+        _dynamic.forEachItem((item) {
+          if (_frame - item.bvhMovedFrame >= settleFrames) settled++;
+        });
+        if (settled > budget) _rebuild(items, BvhRebuildCause.settled);
+      }
+    }
+    _refitAll = false;
+    tracer?.end();
+    if (profileRendering) _recordProfile();
+  }
+
+  @override
+  void query(
+    Frustum frustum,
+    void Function(RenderItem) visit, {
+    List<Plane> additionalPlanes = const [],
+  }) {
+    _static.query(frustum, visit, additionalPlanes: additionalPlanes);
+    _dynamic.query(frustum, visit, additionalPlanes: additionalPlanes);
+  }
+
+  @override
+  void queryAabb(Aabb3 box, void Function(RenderItem) visit) {
+    _static.queryAabb(box, visit);
+    _dynamic.queryAabb(box, visit);
+  }
+
+  @override
+  void queryMany(
+    List<Frustum> frustums,
+    List<List<RenderItem>> visible, {
+    List<List<Plane>> additionalPlanes = const [],
+  }) {
+    _static.queryMany(frustums, visible, additionalPlanes: additionalPlanes);
+    _dynamic.queryMany(frustums, visible, additionalPlanes: additionalPlanes);
+  }
+
+  // Moves [item] to the level its current state calls for.
+  void _sync(RenderItem item) {
+    final bounds = item.frustumCulled ? item.worldBounds : null;
+    if (bounds == null) {
+      _detach(item);
+      if (item.bvhAlwaysVisibleSlot < 0) {
+        item.bvhAlwaysVisibleSlot = _alwaysVisible.length;
+        _alwaysVisible.add(item);
+      }
+      return;
+    }
+    _removeAlwaysVisible(item);
+    item.bvhMovedFrame = _frame;
+    final leaf = item.bvhStaticLeaf;
+    if (leaf >= 0) {
+      _static.retireLeaf(leaf);
+      item.bvhStaticLeaf = -1;
+      _migrations++;
+    }
+    final proxy = item.bvhDynamicProxy;
+    if (proxy >= 0) {
+      _dynamic.move(proxy, bounds);
+      _moves++;
+    } else {
+      item.bvhDynamicProxy = _dynamic.insert(item, bounds);
+      _inserts++;
+    }
+  }
+
+  void _detach(RenderItem item) {
+    final leaf = item.bvhStaticLeaf;
+    if (leaf >= 0) {
+      _static.retireLeaf(leaf);
+      item.bvhStaticLeaf = -1;
+    }
+    final proxy = item.bvhDynamicProxy;
+    if (proxy >= 0) {
+      _dynamic.remove(proxy);
+      item.bvhDynamicProxy = -1;
+      _removes++;
+    }
+  }
+
+  void _removeAlwaysVisible(RenderItem item) {
+    final slot = item.bvhAlwaysVisibleSlot;
+    if (slot < 0) return;
+    final last = _alwaysVisible.removeLast();
+    if (!identical(last, item)) {
+      _alwaysVisible[slot] = last;
+      last.bvhAlwaysVisibleSlot = slot;
+    }
+    item.bvhAlwaysVisibleSlot = -1;
+  }
+
+  void _rebuild(List<RenderItem> items, BvhRebuildCause cause) {
+    final tracer = FrameTracer.active;
+    tracer?.begin('bvh.rebuild', args: {'cause': cause.name});
+    _rebuildCause = null;
+    for (final item in _pending) {
+      item.bvhQueued = false;
+    }
+    _pending.clear();
+    _dynamic.clear();
+    _alwaysVisible.clear();
+    final settled = <RenderItem>[];
+    for (final item in items) {
+      item.bvhStaticLeaf = -1;
+      item.bvhDynamicProxy = -1;
+      item.bvhAlwaysVisibleSlot = -1;
+      final bounds = item.frustumCulled ? item.worldBounds : null;
+      if (bounds == null) {
+        item.bvhAlwaysVisibleSlot = _alwaysVisible.length;
+        _alwaysVisible.add(item);
+      } else if (_frame - item.bvhMovedFrame < settleFrames) {
+        item.bvhDynamicProxy = _dynamic.insert(item, bounds);
+      } else {
+        settled.add(item);
+      }
+    }
+    final bvh = Bvh.build(settled);
+    for (var leaf = 0; leaf < bvh.leafCount; leaf++) {
+      bvh.leafItem(leaf).bvhStaticLeaf = leaf;
+    }
+    _static = bvh;
+    _staticBuildCount++;
+    _builds++;
+    tracer?.end();
+    if (profileRendering) {
+      _profile.add('bvh_rebuild_${cause.name}', 1);
+    }
+  }
+
+  void _recordProfile() {
+    _profile.add('bvh_query_visits', _static.takeNodeVisits(), trackMax: true);
+    _profile.add('bvh_query_visits_dynamic', _dynamic.takeNodeVisits());
+    _profile.add('bvh_builds', _builds);
+    _profile.add('bvh_inserts', _inserts);
+    _profile.add('bvh_removes', _removes);
+    _profile.add('bvh_moves', _moves);
+    _profile.add('bvh_migrations', _migrations);
+    _profile.add('bvh_dynamic_items', _dynamic.length, trackMax: true);
+    _builds = 0;
+    _inserts = 0;
+    _removes = 0;
+    _moves = 0;
+    _migrations = 0;
+    final snapshot = _profile.endSample();
+    if (snapshot == null) return;
+    final causes = [
+      for (final cause in BvhRebuildCause.values)
+        '${cause.name}=${snapshot.total('bvh_rebuild_${cause.name}')}',
+    ].join(',');
+    // ignore: avoid_print
+    print(
+      'FLUTTER_SCENE_PROFILE_BVH '
+      'builds_total=${snapshot.total('bvh_builds')} '
+      'rebuild_causes=$causes '
+      'static_visits_mean=${snapshot.mean('bvh_query_visits')} '
+      'static_visits_max=${snapshot.max('bvh_query_visits')} '
+      'dynamic_visits_mean=${snapshot.mean('bvh_query_visits_dynamic')} '
+      'dynamic_items_max=${snapshot.max('bvh_dynamic_items')} '
+      'inserts_total=${snapshot.total('bvh_inserts')} '
+      'removes_total=${snapshot.total('bvh_removes')} '
+      'moves_total=${snapshot.total('bvh_moves')} '
+      'migrations_total=${snapshot.total('bvh_migrations')}',
+    );
+  }
+}
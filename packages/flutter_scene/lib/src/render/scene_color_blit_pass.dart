@@ -45,6 +45,16 @@ class SceneColorBlitPass extends RenderGraphPass {
   @override
   String get name => 'SceneColorBlitPass';
 
+  @override
+  Set<Object> get inputs => const {kSceneColorBlackboardKey};
+
+  @override
+  Set<Object> get outputs => const {};
+
+  // Writes the caller's output color.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final input = context.blackboard.require<gpu.Texture>(
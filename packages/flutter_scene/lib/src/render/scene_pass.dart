@@ -9,14 +9,17 @@ import 'package:vector_math/vector_math.dart';
 import 'package:flutter_scene/src/camera.dart';
 import 'package:flutter_scene/src/fog.dart';
 import 'package:flutter_scene/src/light.dart';
+import 'package:flutter_scene/src/occlusion_culling.dart';
 import 'package:flutter_scene/src/material/environment.dart';
 import 'package:flutter_scene/src/render/punctual_lights.dart';
 import 'package:flutter_scene/src/gpu/render_pass_compat.dart';
 import 'package:flutter_scene/src/render/depth_prepass.dart';
+import 'package:flutter_scene/src/render/occlusion_culler.dart';
 import 'package:flutter_scene/src/render/render_graph.dart';
 import 'package:flutter_scene/src/render/render_layers.dart';
 import 'package:flutter_scene/src/render/render_profile.dart';
 import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:flutter_scene/src/render/retained_draw_order.dart';
 import 'package:flutter_scene/src/render/shadow_pass.dart';
 import 'package:flutter_scene/src/render/sh_composite.dart';
 import 'package:flutter_scene/src/render/skybox_encoder.dart';
@@ -61,6 +64,8 @@ int transmissionFilterBandOffset(int width, int level) {
 /// the blackboard and threaded into the per-draw [Lighting].
 class ScenePass extends RenderGraphPass {
   static final RenderProfileAccumulator _profile = RenderProfileAccumulator();
+  static final RenderProfileAccumulator _occlusionProfile =
+      RenderProfileAccumulator();
 
   ScenePass({
     required Camera camera,
@@ -91,6 +96,10 @@ class ScenePass extends RenderGraphPass {
     List<Plane> cullingPlanes = const [],
     bool includeOffscreen = false,
     bool suppressPlanarReflections = false,
+    OcclusionCuller? occlusionCuller,
+    OcclusionCullingSettings? occlusionCulling,
+    RetainedDrawOrder? drawOrder,
+    List<RenderItem>? candidates,
   }) : _captureOpaqueColor = captureOpaqueColor,
        _suppressPlanarReflections = suppressPlanarReflections,
        _bindSceneDepth = bindSceneDepth,
@@ -118,7 +127,11 @@ class ScenePass extends RenderGraphPass {
        _ssaoIndirectLight = ssaoIndirectLight,
        _fog = fog,
        _cullingPlanes = cullingPlanes,
-       _includeOffscreen = includeOffscreen;
+       _includeOffscreen = includeOffscreen,
+       _occlusionCuller = occlusionCuller,
+       _occlusionCulling = occlusionCulling,
+       _drawOrder = drawOrder,
+       _candidates = candidates;
 
   final Camera _camera;
   final RenderScene _renderScene;
@@ -153,11 +166,45 @@ class ScenePass extends RenderGraphPass {
   final List<Plane> _cullingPlanes;
   final bool _includeOffscreen;
 
+  // The CPU occlusion stage between frustum culling and encoding; both
+  // null when it is off.
+  final OcclusionCuller? _occlusionCuller;
+  final OcclusionCullingSettings? _occlusionCulling;
+
+  // This view's opaque order kept from the last frame (see
+  // RenderScene.opaqueDrawOrder), or null to sort from scratch.
+  final RetainedDrawOrder? _drawOrder;
+
+  // The items potentially visible to this view, when culled ahead of the
+  // pass together with other views (RenderScene.cullMany); null to cull
+  // here.
+  final List<RenderItem>? _candidates;
+
+  // Frustum-culled candidates handed to the occlusion stage, reused
+  // across frames.
+  static final List<RenderItem> _occlusionCandidates = [];
+
   static const gpu.PixelFormat _hdrFormat = gpu.PixelFormat.r16g16b16a16Float;
 
   @override
   String get name => 'ScenePass';
 
+  @override
+  Set<Object> get inputs => const {
+    kShadowMapBlackboardKey,
+    kSsaoTextureBlackboardKey,
+    kLinearDepthBlackboardKey,
+  };
+
+  @override
+  Set<Object> get outputs => const {kSceneColorBlackboardKey};
+
+  // The pass draws the view's final color, which a graph may hand on
+  // without a declared reader, and it records the occlusion stage's
+  // tested/culled telemetry; neither may disappear with the pass.
+  @override
+  bool get hasSideEffects => true;
+
   /// Whether draws in this pass suppress planar reflection sampling (the
   /// pass is itself a planar capture, which must not recurse).
   @visibleForTesting
@@ -276,6 +323,7 @@ class ScenePass extends RenderGraphPass {
         ? math.tan(projection.fovRadiansY / 2.0)
         : 0.0;
     final tanHalfFovX = height > 0 ? tanHalfFovY * width / height : 0.0;
+    final punctual = _punctualLighting.forView(camera, _dimensions);
     final lighting = Lighting(
       environmentMap: _environmentMap,
       environmentMapB: _environmentMapB,
@@ -285,18 +333,17 @@ class ScenePass extends RenderGraphPass {
       environmentTransform: _environmentTransform,
       directionalLight: _directionalLight,
       directionalLightDirection: _directionalLightDirection,
-      punctualParamsTexture: _punctualLighting.paramsTexture,
-      punctualIndexTexture: _punctualLighting.indexTexture,
-      punctualParamsCount: _punctualLighting.paramsCount,
-      punctualIndexWidth: _punctualLighting.indexWidth,
-      punctualIndexHeight: _punctualLighting.indexHeight,
+      punctualParamsTexture: punctual.paramsTexture,
+      punctualIndexTexture: punctual.indexTexture,
+      punctualParamsCount: punctual.paramsCount,
+      punctualIndexWidth: punctual.indexWidth,
+      punctualIndexHeight: punctual.indexHeight,
+      punctualClusterHeader: punctual.clusterHeader,
       // Spot shadows share the atlas, so only sample them when it was produced.
-      spotShadowCount: shadowMap == null
-          ? 0
-          : _punctualLighting.spotShadowCount,
-      spotShadowDepthBias: _punctualLighting.spotShadowDepthBias,
-      spotShadowNormalBias: _punctualLighting.spotShadowNormalBias,
-      spotShadowSoftness: _punctualLighting.spotShadowSoftness,
+      spotShadowCount: shadowMap == null ? 0 : punctual.spotShadowCount,
+      spotShadowDepthBias: punctual.spotShadowDepthBias,
+      spotShadowNormalBias: punctual.spotShadowNormalBias,
+      spotShadowSoftness: punctual.spotShadowSoftness,
       shadowMap: shadowMap,
       cascades: shadowMap == null ? const [] : _cascades,
       ssaoMap: ssaoMap,
@@ -352,12 +399,50 @@ class ScenePass extends RenderGraphPass {
       _layerMask,
       _cullingPlanes,
       !_includeOffscreen,
+      _drawOrder,
     );
     final cullWatch = profileRendering ? (Stopwatch()..start()) : null;
     if (_includeOffscreen) {
       for (final item in _renderScene.items) {
         encoder.submit(item);
       }
+    } else if (_occlusionCuller case final culler?) {
+      final settings = _occlusionCulling!;
+      final candidates = _occlusionCandidates;
+      if (_candidates case final precomputed?) {
+        candidates.addAll(precomputed);
+      } else {
+        _renderScene.cull(
+          encoder.frustum,
+          candidates.add,
+          additionalPlanes: _cullingPlanes,
+        );
+      }
+      final bufferWidth = settings.resolution.clamp(16, 1024);
+      final bufferHeight = (bufferWidth * height / math.max(width, 1))
+          .round()
+          .clamp(1, 1024);
+      final culled = culler.cull(
+        candidates,
+        encoder.submit,
+        viewProjection: _camera.getViewTransform(_dimensions),
+        width: bufferWidth,
+        height: bufferHeight,
+        occluderBudget: settings.occluderBudget,
+        layerMask: _layerMask,
+      );
+      if (profileRendering) {
+        _recordOcclusionProfile(
+          candidates.length,
+          culled,
+          culler.lastOccluderCount,
+        );
+      }
+      candidates.clear();
+    } else if (_candidates case final candidates?) {
+      for (final item in candidates) {
+        encoder.submit(item);
+      }
     } else {
       _renderScene.cull(
         encoder.frustum,
@@ -511,6 +596,22 @@ class ScenePass extends RenderGraphPass {
     );
   }
 
+  static void _recordOcclusionProfile(int tested, int culled, int occluders) {
+    _occlusionProfile.add('tested', tested, trackMax: true);
+    _occlusionProfile.add('culled', culled, trackMax: true);
+    _occlusionProfile.add('occluders', occluders, trackMax: true);
+    final snapshot = _occlusionProfile.endSample();
+    if (snapshot == null) return;
+    // ignore: avoid_print
+    print(
+      'FLUTTER_SCENE_PROFILE_OCCLUSION '
+      'tested_mean=${snapshot.mean('tested')} '
+      'culled_mean=${snapshot.mean('culled')} '
+      'culled_max=${snapshot.max('culled')} '
+      'occluders_mean=${snapshot.mean('occluders')}',
+    );
+  }
+
   static final gpu.Shader _copyVertexShader =
       baseShaderLibrary['FullscreenVertex']!;
   static final gpu.Shader _copyFragmentShader =
@@ -64,6 +64,12 @@ class SelectionMaskPass extends RenderGraphPass {
   @override
   String get name => 'SelectionMaskPass';
 
+  @override
+  Set<Object> get inputs => const {};
+
+  @override
+  Set<Object> get outputs => const {kSelectionMaskBlackboardKey};
+
   @override
   void execute(RenderGraphContext context) {
     final width = _dimensions.width.toInt();
@@ -149,6 +155,19 @@ class SelectionOutlinePass extends RenderGraphPass {
   @override
   String get name => 'SelectionOutlinePass';
 
+  @override
+  Set<Object> get inputs => const {
+    kDisplayColorBlackboardKey,
+    kSelectionMaskBlackboardKey,
+  };
+
+  @override
+  Set<Object> get outputs => const {kDisplayColorBlackboardKey};
+
+  // Writes the caller's output color.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final sceneColor = context.blackboard.require<gpu.Texture>(
@@ -89,6 +89,16 @@ class ShadowCatcherBakePass extends RenderGraphPass {
   @override
   String get name => 'ShadowCatcherBakePass';
 
+  @override
+  Set<Object> get inputs => const {kShadowMapBlackboardKey};
+
+  @override
+  Set<Object> get outputs => const {};
+
+  // Writes the catchers' persistent footprint caches.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final shadowMap = context.blackboard.get<gpu.Texture>(
@@ -7,6 +7,7 @@ import 'package:flutter_scene/src/render/instance_packing.dart';
 import 'package:vector_math/vector_math.dart';
 
 import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:flutter_scene/src/render/retained_draw_order.dart';
 import 'package:flutter_scene/src/scene_encoder.dart' show resolvePipeline;
 import 'package:flutter_scene/src/shaders.dart';
 import 'package:flutter_scene/src/render/frame_transients.dart';
@@ -55,8 +56,10 @@ class ShadowEncoder {
     ShadowCasterFaces casterFaces, {
     ShadowCasterFilter filter = ShadowCasterFilter.all,
     int casterChannelMask = 0xFF,
+    RetainedDrawOrder? retainedOrder,
   }) : _filter = filter,
-       _casterChannelMask = casterChannelMask {
+       _casterChannelMask = casterChannelMask,
+       _retainedOrder = retainedOrder {
     frustum = Frustum.matrix(_lightSpaceMatrix);
     _renderPass.setDepthWriteEnable(true);
     _renderPass.setColorBlendEnable(false);
@@ -86,6 +89,9 @@ class ShadowEncoder {
   // shades it.
   final int _casterChannelMask;
 
+  // Where the caster order from the last shadow render is kept, if anywhere.
+  final RetainedDrawOrder? _retainedOrder;
+
   // The scene camera position, bound as FrameInfo.camera_position so a
   // `vertex { }` material's camera-relative displacement (e.g. a world curve)
   // bends shadow casters the same way as the color pass. The depth fragment
@@ -145,19 +151,23 @@ class ShadowEncoder {
   /// Emits the accepted casters, merging compatible spatial cells back into
   /// one hardware-instanced draw after culling.
   void flush() {
-    _records.sort((a, b) {
-      final byMaterial = identityHashCode(
-        a.material,
-      ).compareTo(identityHashCode(b.material));
-      if (byMaterial != 0) return byMaterial;
-      return identityHashCode(
-        a.geometry,
-      ).compareTo(identityHashCode(b.geometry));
-    });
+    final retainedOrder = _retainedOrder;
+    if (retainedOrder == null) {
+      sortDepthRecords(_records);
+    } else {
+      retainedOrder.sortItems(_records, compareDepthRecords, sortDepthRecords);
+    }
     var index = 0;
     while (index < _records.length) {
       final first = _records[index];
-      final end = depthBatchEnd(_records, index);
+      final end =
+          retainedOrder?.batchEnd(
+            _records,
+            index,
+            depthBatchEnd,
+            depthBatchJoins,
+          ) ??
+          depthBatchEnd(_records, index);
       if (end > index + 1) {
         final batches = <InstanceDataBatch>[];
         for (var batchIndex = index; batchIndex < end; batchIndex++) {
@@ -105,6 +105,19 @@ class ShadowPass extends RenderGraphPass {
   @override
   String get name => 'ShadowPass';
 
+  @override
+  Set<Object> get inputs => const {};
+
+  @override
+  Set<Object> get outputs => const {
+    kShadowMapBlackboardKey,
+    kShadowUniformBlackboardKey,
+  };
+
+  // Refreshes the persistent static shadow tiles.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final plan = _cachePlan;
@@ -155,7 +168,8 @@ class ShadowPass extends RenderGraphPass {
     void renderTile(
       int tile,
       Matrix4 matrix,
-      ShadowCasterFaces faces, {
+      ShadowCasterFaces faces,
+      List<RenderItem> casters, {
       ShadowCasterFilter filter = ShadowCasterFilter.all,
       int casterChannelMask = 0xFF,
     }) {
@@ -175,11 +189,24 @@ class ShadowPass extends RenderGraphPass {
         faces,
         filter: filter,
         casterChannelMask: casterChannelMask,
+        retainedOrder: _renderScene.shadowDrawOrder(tile, filter),
       );
-      _renderScene.cull(encoder.frustum, encoder.submitCulled);
+      for (final item in casters) {
+        encoder.submitCulled(item);
+      }
       encoder.flush();
     }
 
+    // Every tile that draws the full caster set is culled in one BVH
+    // traversal: the cascades when there is no cache plan, then the spot
+    // cones.
+    final spots = _spotShadows;
+    final tileCasters = _cullTiles([
+      if (plan == null)
+        for (final cascade in _cascades) cascade.lightSpaceMatrix,
+      ...?spots?.matrices,
+    ]);
+
     // Cascade tiles first (0..cascades.length), then the spot cones. With a
     // cache plan, each cascade tile replays its cached static content and
     // draws only the dynamic casters; otherwise everything renders. The
@@ -206,6 +233,10 @@ class ShadowPass extends RenderGraphPass {
           _casterFaces,
           filter: ShadowCasterFilter.dynamicOnly,
           casterChannelMask: _casterChannelMask,
+          retainedOrder: _renderScene.shadowDrawOrder(
+            c,
+            ShadowCasterFilter.dynamicOnly,
+          ),
         );
         for (final item in _renderScene.items) {
           encoder.submit(item);
@@ -216,14 +247,20 @@ class ShadowPass extends RenderGraphPass {
           c,
           _cascades[c].lightSpaceMatrix,
           _casterFaces,
+          tileCasters[c],
           casterChannelMask: _casterChannelMask,
         );
       }
     }
-    final spots = _spotShadows;
     if (spots != null) {
+      final firstSpotList = plan == null ? _cascades.length : 0;
       for (var s = 0; s < spots.matrices.length; s++) {
-        renderTile(_cascades.length + s, spots.matrices[s], spots.casterFaces);
+        renderTile(
+          _cascades.length + s,
+          spots.matrices[s],
+          spots.casterFaces,
+          tileCasters[firstSpotList + s],
+        );
       }
     }
 
@@ -240,7 +277,11 @@ class ShadowPass extends RenderGraphPass {
   /// a single render pass encoder), submitted before the atlas buffer so the
   /// composite below reads the fresh content.
   void _renderStaticTiles(RenderGraphContext context, ShadowCachePlan plan) {
-    for (final refresh in plan.refreshes) {
+    final tileCasters = _cullTiles([
+      for (final refresh in plan.refreshes) refresh.entry.matrix,
+    ]);
+    for (var r = 0; r < plan.refreshes.length; r++) {
+      final refresh = plan.refreshes[r];
       final commandBuffer = gpu.gpuContext.createCommandBuffer();
       final entry = refresh.entry;
       entry.tile ??= gpu.gpuContext.createTexture(
@@ -279,13 +320,39 @@ class ShadowPass extends RenderGraphPass {
         _casterFaces,
         filter: ShadowCasterFilter.staticOnly,
         casterChannelMask: _casterChannelMask,
+        retainedOrder: _renderScene.shadowDrawOrder(
+          refresh.cascadeIndex,
+          ShadowCasterFilter.staticOnly,
+        ),
       );
-      _renderScene.cull(encoder.frustum, encoder.submitCulled);
+      for (final item in tileCasters[r]) {
+        encoder.submitCulled(item);
+      }
       encoder.flush();
       rendererSubmissions.submit(commandBuffer);
     }
   }
 
+  // Per-tile caster lists, reused across frames. Passes run one at a time,
+  // and each use is consumed before the next [_cullTiles].
+  static final List<List<RenderItem>> _tileCasters = [];
+
+  // Culls the scene against every light-space matrix in [matrices] with a
+  // single multi-frustum BVH traversal, returning one caster list per matrix.
+  List<List<RenderItem>> _cullTiles(List<Matrix4> matrices) {
+    while (_tileCasters.length < matrices.length) {
+      _tileCasters.add([]);
+    }
+    for (final casters in _tileCasters) {
+      casters.clear();
+    }
+    if (matrices.isEmpty) return _tileCasters;
+    _renderScene.cullMany([
+      for (final matrix in matrices) Frustum.matrix(matrix),
+    ], _tileCasters);
+    return _tileCasters;
+  }
+
   /// Replays cascade [tile]'s cached static content into its atlas slot,
   /// writing the stored depth to both the color channel and the fragment
   /// depth so the dynamic casters drawn after depth-test against it.
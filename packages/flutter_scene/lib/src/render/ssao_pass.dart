@@ -164,6 +164,12 @@ class SsaoPass extends RenderGraphPass {
   @override
   String get name => 'SsaoPass';
 
+  @override
+  Set<Object> get inputs => const {kLinearDepthBlackboardKey};
+
+  @override
+  Set<Object> get outputs => const {_kSsaoRawBlackboardKey};
+
   // Downsamples [source] into a half-size (rounded down) depth level via the
   // depth-downsample shader (rotated-grid subsample). Used to build the chain.
   gpu.Texture _downsampleDepth(
@@ -382,6 +388,15 @@ class SsaoBlurPass extends RenderGraphPass {
   @override
   String get name => 'SsaoBlurPass';
 
+  @override
+  Set<Object> get inputs => const {
+    _kSsaoRawBlackboardKey,
+    kLinearDepthBlackboardKey,
+  };
+
+  @override
+  Set<Object> get outputs => const {kSsaoTextureBlackboardKey};
+
   @override
   void execute(RenderGraphContext context) {
     final raw = context.blackboard.require<gpu.Texture>(_kSsaoRawBlackboardKey);
@@ -488,6 +503,16 @@ class SceneColorHistoryPass extends RenderGraphPass {
   @override
   String get name => 'SceneColorHistoryPass';
 
+  @override
+  Set<Object> get inputs => const {kSceneColorBlackboardKey};
+
+  @override
+  Set<Object> get outputs => const {};
+
+  // Writes the caller's history texture.
+  @override
+  bool get hasSideEffects => true;
+
   @override
   void execute(RenderGraphContext context) {
     final source = context.blackboard.get<gpu.Texture>(
@@ -87,6 +87,15 @@ class SsrPass extends RenderGraphPass {
   @override
   String get name => 'SsrPass';
 
+  @override
+  Set<Object> get inputs => const {
+    kSceneColorBlackboardKey,
+    kLinearDepthBlackboardKey,
+  };
+
+  @override
+  Set<Object> get outputs => const {kSceneColorBlackboardKey};
+
   @override
   void execute(RenderGraphContext context) {
     final sceneColor = context.blackboard.require<gpu.Texture>(
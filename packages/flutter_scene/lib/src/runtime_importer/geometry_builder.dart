@@ -51,18 +51,21 @@ Geometry geometryFromPacked(
   return geometry;
 }
 
-/// Wraps packed morph deltas as engine [MorphTargetData], attaching the
-/// mesh-level [targetNames] and [defaultWeights].
+/// Encodes packed morph deltas as sparse engine [MorphTargetData] (runs of
+/// the vertices each target moves), attaching the mesh-level [targetNames]
+/// and [defaultWeights].
 MorphTargetData morphDataFromPacked(
   PackedMorphTargets packed, {
   List<String>? targetNames,
   List<double>? defaultWeights,
-}) => MorphTargetData(
-  vertexCount: packed.vertexCount,
-  targetCount: packed.targetCount,
-  positionDeltas: packed.positionDeltas,
-  normalDeltas: packed.normalDeltas,
-  tangentDeltas: packed.tangentDeltas,
+}) => MorphTargetData.sparse(
+  SparseMorphDeltas.fromDense(
+    vertexCount: packed.vertexCount,
+    targetCount: packed.targetCount,
+    positions: packed.positionDeltas,
+    normals: packed.normalDeltas,
+    tangents: packed.tangentDeltas,
+  ),
   targetNames: targetNames,
   defaultWeights: defaultWeights,
 );
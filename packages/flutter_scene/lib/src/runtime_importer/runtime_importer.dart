@@ -37,10 +37,13 @@ export 'gltf_resources.dart' show GltfResourceResolver;
 /// GLB's default scene. Each scene node is created and wired up to match the
 /// glTF node hierarchy. [onWarning], when given, receives non-fatal import
 /// issues (an unrecognized extension, an image that fell back to a
-/// placeholder); without it they print instead.
+/// placeholder); without it they print instead. Set [optimizeVertexOrder]
+/// to reorder each primitive's triangles and vertices for the GPU vertex
+/// cache, overdraw, and vertex fetch while packing.
 Future<Node> importGlb(
   Uint8List bytes, {
   GltfWarningCallback? onWarning,
+  bool optimizeVertexOrder = false,
 }) async {
   final container = parseGlb(bytes);
   final doc = parseGltfJson(container.json);
@@ -51,7 +54,11 @@ Future<Node> importGlb(
     resolveUri: null,
   );
   final gltf = decodeMeshoptBufferViews(normalized.doc, normalized.bufferData);
-  final packed = await _packPrimitives(gltf.doc, gltf.bufferData);
+  final packed = await _packPrimitives(
+    gltf.doc,
+    gltf.bufferData,
+    optimizeVertexOrder: optimizeVertexOrder,
+  );
   return _buildScene(
     gltf.doc,
     gltf.bufferData,
@@ -70,11 +77,12 @@ Future<Node> importGlb(
 /// than one buffer has every buffer concatenated and its bufferViews
 /// rebased, the same normalization the offline importer performs.
 /// [onWarning], when given, receives non-fatal import issues; without it
-/// they print instead.
+/// they print instead. [optimizeVertexOrder] is as for [importGlb].
 Future<Node> importGltf(
   Uint8List gltfJson, {
   required GltfResourceResolver resolveUri,
   GltfWarningCallback? onWarning,
+  bool optimizeVertexOrder = false,
 }) async {
   final json = jsonDecode(utf8.decode(gltfJson)) as Map<String, Object?>;
   final doc = parseGltfJson(json);
@@ -85,7 +93,11 @@ Future<Node> importGltf(
     resolveUri: resolveUri,
   );
   final gltf = decodeMeshoptBufferViews(normalized.doc, normalized.bufferData);
-  final packed = await _packPrimitives(gltf.doc, gltf.bufferData);
+  final packed = await _packPrimitives(
+    gltf.doc,
+    gltf.bufferData,
+    optimizeVertexOrder: optimizeVertexOrder,
+  );
   return _buildScene(
     gltf.doc,
     gltf.bufferData,
@@ -131,13 +143,18 @@ typedef _PackedPrimitiveVariants = ({
 
 Future<List<List<_PackedPrimitiveVariants?>>> _packPrimitives(
   GltfDocument doc,
-  Uint8List bufferData,
-) => compute(_packPrimitivesIsolate, (doc: doc, bufferData: bufferData));
+  Uint8List bufferData, {
+  required bool optimizeVertexOrder,
+}) => compute(_packPrimitivesIsolate, (
+  doc: doc,
+  bufferData: bufferData,
+  optimizeVertexOrder: optimizeVertexOrder,
+));
 
 // Top-level so it can run on a background isolate. Packs each primitive with
 // the shared [packGltfPrimitive]; non-triangle topologies pack to null.
 List<List<_PackedPrimitiveVariants?>> _packPrimitivesIsolate(
-  ({GltfDocument doc, Uint8List bufferData}) input,
+  ({GltfDocument doc, Uint8List bufferData, bool optimizeVertexOrder}) input,
 ) {
   final doc = input.doc;
   final skinnedMeshes = <int>{};
@@ -156,6 +173,7 @@ List<List<_PackedPrimitiveVariants?>> _packPrimitivesIsolate(
       bufferData: input.bufferData,
       coordinatePolicy: GltfCoordinatePolicy.runtimeBoundary,
       includeSkinning: includeSkinning,
+      optimizeVertexOrder: input.optimizeVertexOrder,
     );
     final carriesSkinning =
         primitive.attributes.containsKey('JOINTS_0') &&
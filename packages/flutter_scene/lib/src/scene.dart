@@ -15,17 +15,20 @@ import 'ambient_occlusion.dart';
 import 'audio/audio_engine.dart';
 import 'auto_exposure.dart';
 import 'camera.dart';
+import 'clustered_lighting.dart';
 import 'components/camera_component.dart';
 import 'components/directional_light_component.dart';
 import 'components/planar_reflector_component.dart';
 import 'components/reflection_probe_component.dart';
 import 'fog.dart';
+import 'geometry/morphed_geometry.dart' show MorphFrameStats, morphUploads;
 import 'god_rays.dart';
 import 'light.dart';
 import 'material/environment.dart';
 import 'material/material.dart';
 import 'mesh.dart';
 import 'node.dart';
+import 'occlusion_culling.dart';
 import 'raycast.dart';
 import 'physics/physics_world.dart';
 import 'environment_settings.dart';
@@ -37,6 +40,7 @@ import 'render/bloom_pass.dart';
 import 'render/custom_render_pass.dart';
 import 'render/depth_prepass.dart';
 import 'render/fxaa_pass.dart';
+import 'render/occlusion_culler.dart';
 import 'render/scene_color_blit_pass.dart';
 import 'render/sky_bake.dart'
     show
@@ -47,8 +51,11 @@ import 'render/sky_bake.dart'
 import 'render/smaa_pass.dart';
 import 'render/post_effect_pass.dart';
 import 'render/render_graph.dart';
+import 'render/frame_tracer.dart';
 import 'render/render_graph_capture.dart';
+import 'render/render_profile.dart';
 import 'render/render_scene.dart';
+import 'render/retained_draw_order.dart';
 import 'render/planar_reflection.dart';
 import 'render/planar_reflection_pass.dart';
 import 'render/punctual_lights.dart';
@@ -165,6 +172,31 @@ base class Scene implements SceneGraph {
   /// {@category Assets and loading}
   static bool get isReadyToRender => _readyToRender;
 
+  /// What the renderer's shared per-frame buffers (uniform blocks and
+  /// instance-rate vertex data, shared by every scene) did over the last
+  /// rendered frame: bytes emplaced and wasted, live and in-flight blocks,
+  /// oversize emplacements, and allocations forced by blocks still in use
+  /// by the GPU.
+  ///
+  /// Both pools release blocks unused for 60 frames, and the block-based
+  /// pools size their blocks from a rolling 120-frame window, so
+  /// steady-state memory follows the load.
+  /// {@category Rendering}
+  static ({TransientFrameStats uniforms, TransientFrameStats instances})
+  get transientStats => (
+    uniforms: uniformTransients.lastFrameStats,
+    instances: instanceTransients.lastFrameStats,
+  );
+
+  /// What morph targets uploaded over this scene's last rendered frame:
+  /// weight uniforms written or reused, CPU re-blends, and their bytes.
+  /// Other scenes' renders are not counted, even when they share morphed
+  /// geometry. Per-set memory is `MorphTargetData.deltaBytes` and the
+  /// geometry's `morphTextureBytes`.
+  /// {@category Rendering}
+  MorphFrameStats get morphStats => _morphStats;
+  MorphFrameStats _morphStats = const MorphFrameStats();
+
   /// Computes the linear exposure multiplier for a physical pinhole
   /// camera, the way photographers reason about it: [aperture] (f-stops),
   /// [shutterSpeed] (seconds), and sensor [iso].
@@ -739,7 +771,11 @@ base class Scene implements SceneGraph {
     final light = lightComponent?.light;
     final lightDirection = lightComponent?.worldDirection;
     final passes = <PlanarReflectionCapturePass>[];
+    final captureFrustums = <Frustum>[];
+    final captureCandidates = <List<RenderItem>>[];
+    final capturePlanes = <List<Plane>>[];
     groups.forEach((key, members) {
+      final captureIndex = passes.length;
       // Members of a shared group are co-planar by contract; the first one
       // supplies the plane and capture settings.
       final lead = members.first;
@@ -765,6 +801,15 @@ base class Scene implements SceneGraph {
       for (final member in members) {
         member.internalDistributeFrame(frame);
       }
+      // Rejects whole objects behind the mirror on the CPU; the oblique
+      // projection clips whatever straddles the plane.
+      final cullingPlanes = [
+        Plane.normalconstant(plane.normal, plane.constant - lead.clipBias),
+      ];
+      final candidates = <RenderItem>[];
+      captureFrustums.add(reflectedCamera.getFrustum(captureSize));
+      captureCandidates.add(candidates);
+      capturePlanes.add(cullingPlanes);
       passes.add(
         PlanarReflectionCapturePass(
           scenePass: ScenePass(
@@ -785,15 +830,13 @@ base class Scene implements SceneGraph {
             layerMask: lead.layerMask,
             fog: fog,
             time: time,
-            // Rejects whole objects behind the mirror on the CPU; the
-            // oblique projection clips whatever straddles the plane.
-            cullingPlanes: [
-              Plane.normalconstant(
-                plane.normal,
-                plane.constant - lead.clipBias,
-              ),
-            ],
+            cullingPlanes: cullingPlanes,
             suppressPlanarReflections: true,
+            drawOrder: renderScene.opaqueDrawOrder(
+              DrawOrderView.planarCapture,
+              captureIndex,
+            ),
+            candidates: candidates,
           ),
           output: texture,
           pool: resources.pool,
@@ -803,6 +846,13 @@ base class Scene implements SceneGraph {
         ),
       );
     });
+    // Every capture culls in one traversal (its mirror plane rejecting what
+    // lies behind it) rather than each walking the BVH in its pass.
+    renderScene.cullMany(
+      captureFrustums,
+      captureCandidates,
+      additionalPlanes: capturePlanes,
+    );
     debugLastPlanarCapturePasses = passes;
     return passes;
   }
@@ -844,6 +894,7 @@ base class Scene implements SceneGraph {
       items: renderScene.items,
       bvh: renderScene.bvh,
       spotShadows: spotShadowFrame,
+      clustered: clusteredLighting,
     );
     return _captureEnvironmentAt(
       position: position,
@@ -874,20 +925,27 @@ base class Scene implements SceneGraph {
     // equirect's edge texel centers land on the cube-edge directions.
     final fov = 2.0 * math.atan(1.0 / cubeFaceOverscan(faceResolution));
     final size = ui.Size(faceResolution.toDouble(), faceResolution.toDouble());
+    final cameras = [
+      for (final (forward, up) in cubeFaceBases)
+        PerspectiveCamera(
+          fovRadiansY: fov,
+          position: position,
+          target: position + forward,
+          up: up,
+        ),
+    ];
+    // The six faces cull in one traversal instead of six.
+    final candidates = [for (final _ in cameras) <RenderItem>[]];
+    renderScene.cullMany([
+      for (final camera in cameras) camera.getFrustum(size),
+    ], candidates);
     final faces = <gpu.Texture>[];
-    for (final (forward, up) in cubeFaceBases) {
+    for (final camera in cameras) {
+      final faceIndex = faces.length;
       final face = createHdrCaptureTarget(faceResolution);
       pool.beginFrame();
       _renderViewToTexture(
-        view: RenderView(
-          camera: PerspectiveCamera(
-            fovRadiansY: fov,
-            position: position,
-            target: position + forward,
-            up: up,
-          ),
-          layerMask: layerMask,
-        ),
+        view: RenderView(camera: camera, layerMask: layerMask),
         outputColor: face,
         pixelSize: size,
         pool: pool,
@@ -896,6 +954,9 @@ base class Scene implements SceneGraph {
         lightComponent: lightComponent,
         punctualLighting: punctualLighting,
         spotShadowFrame: spotShadowFrame,
+        drawOrderView: DrawOrderView.cubeFace,
+        drawOrderIndex: faceIndex,
+        candidates: candidates[faceIndex],
         captureLinearColor: true,
       );
       faces.add(face);
@@ -1096,6 +1157,30 @@ base class Scene implements SceneGraph {
   final GodRaysSettings godRays = GodRaysSettings();
   late final GodRaysPass _godRaysPass = GodRaysPass(godRays);
 
+  /// Froxel-clustered assignment of point, spot, and area lights. Off by
+  /// default, leaving each render item its own light list; set
+  /// [ClusteredLightingSettings.enabled] for scenes with many small lights
+  /// over large or numerous meshes.
+  final ClusteredLightingSettings clusteredLighting =
+      ClusteredLightingSettings();
+
+  /// CPU occlusion culling for the main view. Off by default; set
+  /// [OcclusionCullingSettings.enabled] and give large opaque nodes an
+  /// [Node.occluder] to skip drawing meshes they hide. Reflection, probe,
+  /// and shadow views are not occlusion culled.
+  final OcclusionCullingSettings occlusionCulling = OcclusionCullingSettings();
+  final OcclusionCuller _occlusionCuller = OcclusionCuller();
+
+  /// How many render items occlusion culling rejected in the last rendered
+  /// view, or `0` while [occlusionCulling] is off.
+  int get occlusionCulledCount =>
+      occlusionCulling.enabled ? _occlusionCuller.lastCulledCount : 0;
+
+  /// Clip evaluations skipped in the last tick by animation players with an
+  /// [AnimationPlayer.lodPolicy], for small or off-screen characters.
+  int get skippedAnimationEvaluations =>
+      renderScene.skippedAnimationEvaluations;
+
   /// Depth of field with bokeh. Off by default; set [DepthOfField.enabled]
   /// to turn it on. Requires a [PerspectiveCamera] (it reconstructs blur from
   /// camera depth); skipped otherwise.
@@ -1156,9 +1241,15 @@ base class Scene implements SceneGraph {
 
   void _tick(double deltaSeconds) {
     _lastTickMillis = DateTime.now().millisecondsSinceEpoch;
+    final tracer = FrameTracer.active;
+    tracer?.begin('tick', args: {'deltaSeconds': deltaSeconds});
     _stepPhysics(deltaSeconds);
+    tracer?.begin('prepass');
+    renderScene.skippedAnimationEvaluations = 0;
     root.scenePrePass(deltaSeconds);
+    tracer?.end();
     _syncAudio(deltaSeconds);
+    tracer?.end();
   }
 
   // Syncs the active [AudioEngine] (if any) after component ticks, so
@@ -1206,10 +1297,16 @@ base class Scene implements SceneGraph {
   }) {
     accumulator += frameDt;
     final fixed = world.fixedTimestep;
+    final tracer = FrameTracer.active;
+    tracer?.begin('physics');
     var steps = 0;
     while (accumulator >= fixed && steps < world.maxSubsteps) {
+      tracer?.begin('physics.fixedTick');
       fixedUpdateWalk(fixed);
+      tracer?.end();
+      tracer?.begin('physics.step');
       world.step(fixed);
+      tracer?.end();
       accumulator -= fixed;
       steps++;
     }
@@ -1220,6 +1317,7 @@ base class Scene implements SceneGraph {
     }
     final alpha = (accumulator / fixed).clamp(0.0, 1.0);
     world.interpolateTransforms(alpha);
+    tracer?.end();
     return accumulator;
   }
 
@@ -1363,6 +1461,9 @@ base class Scene implements SceneGraph {
       return;
     }
 
+    final tracer = FrameTracer.active;
+    tracer?.beginFrame();
+
     // Blend the environment volumes over the base by the primary view's camera
     // position, before the environment, sky bake, and sun light are read.
     _applyEnvironmentVolumes(views.first.camera);
@@ -1425,6 +1526,16 @@ base class Scene implements SceneGraph {
     // and reset the frame stats. Shared by every view this frame.
     uniformTransients.beginFrame();
     instanceTransients.beginFrame();
+    final morphMark = morphUploads.totals;
+    if (profileRendering) recordTransientsProfile();
+    if (tracer != null) {
+      // The stats describe the previous frame's uploads.
+      tracer.counter('transientBytes', {
+        'uniforms': uniformTransients.lastFrameStats.bytesEmplaced,
+        'instances': instanceTransients.lastFrameStats.bytesEmplaced,
+        'morphs': _morphStats.uploadBytes,
+      });
+    }
     final TransientWriter transientsBuffer = uniformTransients;
 
     // Advance the scene once per frame (not once per view): tick components
@@ -1440,6 +1551,10 @@ base class Scene implements SceneGraph {
     // Rebuild the spatial culling structure once if the pre-pass changed the
     // scene, before the views' render passes query it.
     renderScene.rebuildIfDirty();
+    // Collected afresh for the next pre-pass's animation level of detail.
+    renderScene.lodViews.clear();
+
+    tracer?.begin('lights');
 
     // A hidden node's lights stop contributing, matching its meshes.
     final visibleDirectionals = [
@@ -1465,6 +1580,7 @@ base class Scene implements SceneGraph {
 
     // Select this frame's shadow-casting spots (view-independent).
     final spotShadowFrame = collectSpotShadows(visibleSpots);
+    _recordShadowLodViews(spotShadowFrame?.matrices ?? const []);
 
     // The additional analytic lights (point, spot, and directional lights past
     // the first) are view-independent, so build their shared data texture once
@@ -1478,7 +1594,9 @@ base class Scene implements SceneGraph {
       items: renderScene.items,
       bvh: renderScene.bvh,
       spotShadows: spotShadowFrame,
+      clustered: clusteredLighting,
     );
+    tracer?.end();
 
     // Pending reflection-probe captures render before any view. The frame's
     // cross-fade was resolved before this point, so a probe's very first
@@ -1528,21 +1646,29 @@ base class Scene implements SceneGraph {
     planarCaptureView ??= textureViews.isNotEmpty ? textureViews.first : null;
 
     final now = DateTime.now();
-    for (final view in textureViews) {
+    for (var t = 0; t < textureViews.length; t++) {
+      final view = textureViews[t];
       final target = view.target!;
       if (!target.shouldUpdate(now)) {
         continue;
       }
+      final pixelSize = ui.Size(
+        target.width.toDouble(),
+        target.height.toDouble(),
+      );
+      _recordLodView(view.camera, pixelSize);
       _renderViewToTexture(
         view: view,
         outputColor: target.acquireNextTexture(),
-        pixelSize: ui.Size(target.width.toDouble(), target.height.toDouble()),
+        pixelSize: pixelSize,
         pool: target.transientTexturePool,
         environmentMap: environmentMap,
         transientsBuffer: transientsBuffer,
         lightComponent: lightComponent,
         punctualLighting: punctualLighting,
         spotShadowFrame: spotShadowFrame,
+        drawOrderView: DrawOrderView.texture,
+        drawOrderIndex: t,
         capturePlanarReflections: identical(view, planarCaptureView),
       );
       target.markUpdated(now);
@@ -1581,6 +1707,8 @@ base class Scene implements SceneGraph {
     // A frame has now been submitted; the next one runs on a warm context (see
     // the rebuild near the environment resolution above).
     _hasPresentedFrame = true;
+    _morphStats = morphUploads.since(morphMark);
+    tracer?.endFrame();
 
     assert(() {
       _reportBlankFrame(ordered, regionEmpty: false, noViews: false);
@@ -1758,6 +1886,33 @@ base class Scene implements SceneGraph {
     );
   }
 
+  // Notes a camera this frame renders from for animation level of detail.
+  void _recordLodView(Camera camera, ui.Size pixelSize) {
+    final projection = camera.projection;
+    renderScene.lodViews.add((
+      position: camera.position.clone(),
+      fovRadiansY: projection is PerspectiveProjection
+          ? projection.fovRadiansY
+          : null,
+      frustum: camera.getFrustum(pixelSize),
+      shadow: false,
+    ));
+  }
+
+  // Notes the shadow maps this frame renders, by their light-space
+  // matrices, so a character whose shadow may be on screen keeps animating.
+  void _recordShadowLodViews(Iterable<Matrix4> lightSpaceMatrices) {
+    for (final matrix in lightSpaceMatrices) {
+      // Shadow views are tested for containment only; no eye is needed.
+      renderScene.lodViews.add((
+        position: Vector3.zero(),
+        fovRadiansY: null,
+        frustum: Frustum.matrix(matrix),
+        shadow: true,
+      ));
+    }
+  }
+
   // Renders one [view] into [drawArea] on [canvas], using that view's own
   // swapchain texture and transient texture pool (so simultaneous views in a
   // frame do not share render targets). The per-frame work (tick, spatial
@@ -1792,6 +1947,7 @@ base class Scene implements SceneGraph {
     if (pixelSize.width < 1 || pixelSize.height < 1) {
       return;
     }
+    _recordLodView(view.camera, pixelSize);
 
     // Consume a pending render-graph capture aimed at this screen view.
     RenderGraphCapturer? capturer;
@@ -1815,6 +1971,8 @@ base class Scene implements SceneGraph {
       lightComponent: lightComponent,
       punctualLighting: punctualLighting,
       spotShadowFrame: spotShadowFrame,
+      drawOrderView: DrawOrderView.screen,
+      drawOrderIndex: viewIndex,
       capturer: capturer,
       capturePlanarReflections: capturePlanarReflections,
     );
@@ -1848,6 +2006,13 @@ base class Scene implements SceneGraph {
     required DirectionalLightComponent? lightComponent,
     required PunctualLighting punctualLighting,
     required SpotShadowFrame? spotShadowFrame,
+    // Which view's retained draw orders (see RenderScene.opaqueDrawOrder)
+    // its depth prepass and scene pass start from.
+    required DrawOrderView drawOrderView,
+    required int drawOrderIndex,
+    // The items potentially visible to the view, when it was culled ahead
+    // of its graph together with other views (RenderScene.cullMany).
+    List<RenderItem>? candidates,
     RenderGraphCapturer? capturer,
     // A linear-HDR capture (environment probes): the graph stops after the
     // scene pass and blits the lit scene color into [outputColor], with no
@@ -1888,6 +2053,9 @@ base class Scene implements SceneGraph {
             lightDirection,
           )
         : const <ShadowCascade>[];
+    _recordShadowLodViews([
+      for (final cascade in cascades) cascade.lightSpaceMatrix,
+    ]);
 
     // God rays march the cascaded shadow map against the camera depth, so they
     // need both and a shadow-casting directional light.
@@ -1907,10 +2075,10 @@ base class Scene implements SceneGraph {
 
     // Most scenes request no material scene inputs. Cache that whole-scene
     // answer across movement, then cull per view only when at least one
-    // material can need an attachment. Opaque occlusion remains a GPU
-    // depth-test concern because an AABB cannot prove a mesh is hidden.
-    // TODO(occlusion-culling): use a previous-frame hierarchical depth buffer
-    // to reject fully hidden render items and scene-input requests.
+    // material can need an attachment. Draws hidden behind authored
+    // occluders are rejected by the main ScenePass (occlusionCulling).
+    // TODO(occlusion-culling): reject scene-input requests of fully hidden
+    // render items with the same CPU depth buffer.
     final structureRevision = renderScene.structureRevision;
     final materialRevision = materialSceneInputsRevision;
     if (_materialInputStructureRevision != structureRevision ||
@@ -1927,6 +2095,7 @@ base class Scene implements SceneGraph {
             layerMask: view.layerMask,
             additionalPlanes: view.cullingPlanes,
             includeOffscreen: _warmUpIncludeOffscreen,
+            candidates: candidates,
           );
 
     // The retained metadata below fingerprints static shadow casters.
@@ -2153,6 +2322,16 @@ base class Scene implements SceneGraph {
             cameraRight: cameraRight,
             cameraUp: cameraUp,
             cullingPlanes: view.cullingPlanes,
+            drawOrder: renderScene.depthDrawOrder(
+              drawOrderView,
+              drawOrderIndex,
+            ),
+            // A prepass at another aspect than the view culls its own
+            // frustum.
+            candidates:
+                depthDimensions.aspectRatio == pixelSize.aspectRatio
+                ? candidates
+                : null,
           ),
         );
       }
@@ -2255,6 +2434,10 @@ base class Scene implements SceneGraph {
         time: DateTime.now().millisecondsSinceEpoch.remainder(100000) / 1000.0,
         cullingPlanes: view.cullingPlanes,
         includeOffscreen: _warmUpIncludeOffscreen,
+        occlusionCuller: occlusionCulling.enabled ? _occlusionCuller : null,
+        occlusionCulling: occlusionCulling,
+        drawOrder: renderScene.opaqueDrawOrder(drawOrderView, drawOrderIndex),
+        candidates: _warmUpIncludeOffscreen ? null : candidates,
       ),
     );
     if (wantIndirectLight) {
@@ -14,10 +14,14 @@ import 'package:flutter_scene/src/material/instance_attributes.dart';
 import 'package:flutter_scene/src/material/material.dart';
 import 'package:flutter_scene/src/material/engine_lighting.dart';
 import 'package:flutter_scene/src/render/custom_render_pass.dart';
+import 'package:flutter_scene/src/render/draw_sort.dart';
+import 'package:flutter_scene/src/render/frame_tracer.dart';
 import 'package:flutter_scene/src/render/instance_packing.dart';
 import 'package:flutter_scene/src/render/lod.dart';
 import 'package:flutter_scene/src/render/render_scene.dart';
 import 'package:flutter_scene/src/render/render_profile.dart';
+import 'package:flutter_scene/src/render/retained_draw_order.dart';
+import 'package:flutter_scene/src/render/retained_instance_buffer.dart';
 import 'package:flutter_scene/src/render/frame_transients.dart';
 import 'package:flutter_scene/src/render/instance_batching.dart';
 
@@ -400,6 +404,7 @@ base class SceneEncoder {
   int _instancePackMicros = 0;
   int _instanceBindMicros = 0;
   int _instanceBytes = 0;
+  int _instancePackedBytes = 0;
   int _opaqueSortMicros = 0;
   int _opaqueEncodeMicros = 0;
 
@@ -409,7 +414,9 @@ base class SceneEncoder {
   /// `dimensions` is the viewport size used to derive the camera's view
   /// transform; [lighting] is the scene's IBL environment and analytic
   /// lights, passed to each material's `bind`. The render pass is
-  /// configured for the opaque phase (depth writes on, blending off).
+  /// configured for the opaque phase (depth writes on, blending off). Given
+  /// a [RetainedDrawOrder], the opaque draws start from the order it kept
+  /// from the last frame instead of sorting from scratch.
   SceneEncoder(
     gpu.RenderPass renderPass,
     TransientWriter transientsBuffer,
@@ -418,9 +425,10 @@ base class SceneEncoder {
     this._lighting,
     this._layerMask,
     this._cullingPlanes,
-    this._cullInstances,
-  ) : _renderPass = renderPass,
-      _transientsBuffer = transientsBuffer {
+    this._cullInstances, [
+    this._retainedOrder,
+  ]) : _renderPass = renderPass,
+       _transientsBuffer = transientsBuffer {
     currentSceneEncoderViewport = _dimensions;
     _cameraTransform = _camera.getViewTransform(_dimensions);
     frustum = Frustum.matrix(_cameraTransform);
@@ -441,6 +449,7 @@ base class SceneEncoder {
   final int _layerMask;
   final List<Plane> _cullingPlanes;
   final bool _cullInstances;
+  final RetainedDrawOrder? _retainedOrder;
   // Not final because opaque and translucent draws can use separate passes.
   gpu.RenderPass _renderPass;
   final TransientWriter _transientsBuffer;
@@ -453,6 +462,12 @@ base class SceneEncoder {
   static final List<_OpaqueRecord> _opaqueRecordPool = [];
   static final List<_TranslucentRecord> _translucentRecordPool = [];
   static const int _recordPoolLimit = 8192;
+  // Instanced items with at least this many instances draw every instance
+  // from a [RetainedInstanceBuffer] rather than a per-frame transient copy.
+  static const int _retainedInstanceMin = 256;
+  // Radix sort scratch shared by every encoder (passes encode one at a time).
+  static final DrawKeySorter _opaqueSorter = DrawKeySorter(8);
+  static final DrawKeySorter _translucentSorter = DrawKeySorter(1);
 
   /// View frustum derived from the camera's view-projection matrix at
   /// the start of this frame. Used by [submit] for per-item culling.
@@ -821,6 +836,57 @@ base class SceneEncoder {
       watch!.stop();
       _instanceBindMicros += watch.elapsedMicroseconds;
       _instanceBytes += packed.lengthInBytes;
+      _instancePackedBytes += packed.lengthInBytes;
+    }
+  }
+
+  // Brings [retained] up to date with the item's packed records and draws
+  // both winding groups from it.
+  void _drawRetainedInstances(
+    Geometry geometry,
+    RetainedInstanceBuffer retained,
+    Float32List packedWorldData,
+    Uint8List packedWorldWindingFlipped,
+    int attributeFloats,
+  ) {
+    final watch = profileRendering ? (Stopwatch()..start()) : null;
+    final recordBytes = (kInstanceRecordFloats + attributeFloats) * 4;
+    final written = retained.sync(
+      packedWorldData,
+      packedWorldWindingFlipped,
+      kInstanceRecordFloats + attributeFloats,
+    );
+    if (profileRendering) {
+      watch!.stop();
+      _instancePackMicros += watch.elapsedMicroseconds;
+      _instancePackedBytes += written;
+      _instanceBytes += packedWorldData.lengthInBytes;
+    }
+    final slot = geometry.vertexStreamCount;
+    final ccwBytes = retained.ccwCount * recordBytes;
+    if (retained.ccwCount > 0) {
+      _renderPass.bindVertexBuffer(
+        gpu.BufferView(
+          retained.buffer,
+          offsetInBytes: 0,
+          lengthInBytes: ccwBytes,
+        ),
+        slot: slot,
+      );
+      _setWindingOrder(gpu.WindingOrder.counterClockwise);
+      _drawGeometry(geometry, instanceCount: retained.ccwCount);
+    }
+    if (retained.cwCount > 0) {
+      _renderPass.bindVertexBuffer(
+        gpu.BufferView(
+          retained.buffer,
+          offsetInBytes: ccwBytes,
+          lengthInBytes: retained.cwCount * recordBytes,
+        ),
+        slot: slot,
+      );
+      _setWindingOrder(gpu.WindingOrder.clockwise);
+      _drawGeometry(geometry, instanceCount: retained.cwCount);
     }
   }
 
@@ -908,6 +974,7 @@ base class SceneEncoder {
     Uint8List? packedWorldWindingFlipped,
     Float32List? attributeData,
     int attributeFloats = 0,
+    RetainedInstanceBuffer? retainedInstances,
   }) {
     checkInstanceRecordWidth(material.instanceAttributes, attributeFloats);
     if (!identical(_boundPipeline, pipeline)) {
@@ -942,6 +1009,24 @@ base class SceneEncoder {
     }
 
     _bindGeometry(geometry, nodeTransform, materialVertex, material.depthBias);
+    // Every instance drawn in stored order: the records can stay on the GPU
+    // and only the edited ones are uploaded.
+    if (retainedInstances != null &&
+        sortBackToFrontFrom == null &&
+        instanceIndices == null &&
+        packedWorldData != null &&
+        packedWorldWindingFlipped != null) {
+      _drawRetainedInstances(
+        geometry,
+        retainedInstances,
+        packedWorldData,
+        packedWorldWindingFlipped,
+        attributeFloats,
+      );
+      return;
+    }
+    final tracer = FrameTracer.active;
+    tracer?.begin('instances.pack');
     final packWatch = profileRendering ? (Stopwatch()..start()) : null;
     final packed =
         sortBackToFrontFrom == null &&
@@ -971,6 +1056,7 @@ base class SceneEncoder {
             attributeFloats: attributeFloats,
             scratch: transientInstancePackingScratch,
           );
+    tracer?.end();
     if (profileRendering) {
       packWatch!.stop();
       _instancePackMicros += packWatch.elapsedMicroseconds;
@@ -1013,11 +1099,14 @@ base class SceneEncoder {
       materialVertex,
       material.depthBias,
     );
+    final tracer = FrameTracer.active;
+    tracer?.begin('instances.pack');
     final packWatch = profileRendering ? (Stopwatch()..start()) : null;
     final packed = packInstanceDataBatches(
       batches,
       scratch: transientInstancePackingScratch,
     );
+    tracer?.end();
     if (profileRendering) {
       packWatch!.stop();
       _instancePackMicros += packWatch.elapsedMicroseconds;
@@ -1053,31 +1142,23 @@ base class SceneEncoder {
   /// Emits only the opaque phase (see [flush]). Used with [flushTranslucent]
   /// when the scene pass snapshots the opaque color between them.
   void flushOpaque() {
+    final tracer = FrameTracer.active;
+    tracer?.begin('sort.opaque', args: {'draws': _opaqueRecords.length});
     final sortWatch = profileRendering ? (Stopwatch()..start()) : null;
-    _opaqueRecords.sort((a, b) {
-      final byPipeline = a.pipelineKey.compareTo(b.pipelineKey);
-      if (byPipeline != 0) return byPipeline;
-      final byMaterial = a.materialKey.compareTo(b.materialKey);
-      if (byMaterial != 0) return byMaterial;
-      final byGeometry = a.geometryKey.compareTo(b.geometryKey);
-      if (byGeometry != 0) return byGeometry;
-      final byLightOffset = a.item.lightListOffset.compareTo(
-        b.item.lightListOffset,
-      );
-      if (byLightOffset != 0) return byLightOffset;
-      final byLightCount = a.item.lightListCount.compareTo(
-        b.item.lightListCount,
-      );
-      if (byLightCount != 0) return byLightCount;
-      final byChannels = a.item.lightChannelMask.compareTo(
-        b.item.lightChannelMask,
+    final retainedOrder = _retainedOrder;
+    if (retainedOrder == null) {
+      _sortOpaque(_opaqueRecords);
+    } else {
+      retainedOrder.sort(
+        _opaqueRecords,
+        _compareOpaque,
+        _opaqueItemOf,
+        _sortOpaque,
       );
-      if (byChannels != 0) return byChannels;
-      final byFade = a.fade.compareTo(b.fade);
-      if (byFade != 0) return byFade;
-      return a.depth.compareTo(b.depth);
-    });
+    }
     sortWatch?.stop();
+    tracer?.end();
+    tracer?.begin('encode.opaque');
     final encodeWatch = profileRendering ? (Stopwatch()..start()) : null;
     var index = 0;
     while (index < _opaqueRecords.length) {
@@ -1089,7 +1170,14 @@ base class SceneEncoder {
       item.applyJointsTexture(record.geometry);
       item.applyMorphWeights(record.geometry);
 
-      final end = opaqueBatchEnd(_opaqueRecords, index);
+      final end =
+          retainedOrder?.batchEnd(
+            _opaqueRecords,
+            index,
+            opaqueBatchEnd,
+            opaqueBatchJoins,
+          ) ??
+          opaqueBatchEnd(_opaqueRecords, index);
       if (end > index + 1) {
         final batches = <InstanceDataBatch>[];
         for (var batchIndex = index; batchIndex < end; batchIndex++) {
@@ -1135,6 +1223,11 @@ base class SceneEncoder {
               : null,
           attributeData: item.instanceAttributeData,
           attributeFloats: item.instanceAttributeFloats,
+          retainedInstances:
+              instances.length >= _retainedInstanceMin &&
+                  record.windingFlipped == item.windingFlipped
+              ? item.retainedInstances
+              : null,
         );
       } else {
         _encode(
@@ -1149,6 +1242,7 @@ base class SceneEncoder {
       index++;
     }
     encodeWatch?.stop();
+    tracer?.end();
     if (profileRendering) {
       _opaqueSortMicros = sortWatch!.elapsedMicroseconds;
       _opaqueEncodeMicros = encodeWatch!.elapsedMicroseconds;
@@ -1161,6 +1255,82 @@ base class SceneEncoder {
     _opaqueRecords.clear();
   }
 
+  // Opaque draw order: pipeline, material, and geometry (state-change
+  // grouping), then the per-draw material state that splits a batch, then
+  // front to back.
+  static int _compareOpaque(_OpaqueRecord a, _OpaqueRecord b) {
+    final byPipeline = a.pipelineKey.compareTo(b.pipelineKey);
+    if (byPipeline != 0) return byPipeline;
+    final byMaterial = a.materialKey.compareTo(b.materialKey);
+    if (byMaterial != 0) return byMaterial;
+    final byGeometry = a.geometryKey.compareTo(b.geometryKey);
+    if (byGeometry != 0) return byGeometry;
+    final byLightOffset = a.item.lightListOffset.compareTo(
+      b.item.lightListOffset,
+    );
+    if (byLightOffset != 0) return byLightOffset;
+    final byLightCount = a.item.lightListCount.compareTo(
+      b.item.lightListCount,
+    );
+    if (byLightCount != 0) return byLightCount;
+    final byChannels = a.item.lightChannelMask.compareTo(
+      b.item.lightChannelMask,
+    );
+    if (byChannels != 0) return byChannels;
+    final byFade = a.fade.compareTo(b.fade);
+    if (byFade != 0) return byFade;
+    return a.depth.compareTo(b.depth);
+  }
+
+  static RenderItem _opaqueItemOf(_OpaqueRecord record) => record.item;
+
+  static int _compareTranslucent(_TranslucentRecord a, _TranslucentRecord b) =>
+      b.depth.compareTo(a.depth);
+
+  // Sorts [records] into [_compareOpaque] order with one key column per
+  // compared field, so each identity hash is read once per record rather
+  // than once per comparison. A light field outside the key range (a
+  // negative or wider-than-32-bit value set on an item) falls back to the
+  // comparison sort, so the order never depends on which sort ran.
+  static void _sortOpaque(List<_OpaqueRecord> records) {
+    final sorter = _opaqueSorter..reset(records.length);
+    for (var i = 0; i < records.length; i++) {
+      final record = records[i];
+      final item = record.item;
+      // Clustered lighting marks its items with the count -1.
+      final lightCountKey = item.lightListCount + 1;
+      if (!DrawKeySorter.fitsKey(item.lightListOffset) ||
+          !DrawKeySorter.fitsKey(lightCountKey) ||
+          !DrawKeySorter.fitsKey(item.lightChannelMask)) {
+        records.sort(_compareOpaque);
+        return;
+      }
+      sorter
+        ..setKey(0, i, record.pipelineKey)
+        ..setKey(1, i, record.materialKey)
+        ..setKey(2, i, record.geometryKey)
+        ..setKey(3, i, item.lightListOffset)
+        ..setKey(4, i, lightCountKey)
+        ..setKey(5, i, item.lightChannelMask)
+        ..setKey(6, i, DrawKeySorter.sortableFloatBits(record.fade))
+        ..setKey(7, i, DrawKeySorter.sortableFloatBits(record.depth));
+    }
+    sorter.sort(records, _compareOpaque);
+  }
+
+  // Sorts [records] back to front; the key inverts the depth.
+  static void _sortTranslucent(List<_TranslucentRecord> records) {
+    final sorter = _translucentSorter..reset(records.length);
+    for (var i = 0; i < records.length; i++) {
+      sorter.setKey(
+        0,
+        i,
+        0xFFFFFFFF - DrawKeySorter.sortableFloatBits(records[i].depth),
+      );
+    }
+    sorter.sort(records, _compareTranslucent);
+  }
+
   void _recordProfile(
     int sortMicros,
     int encodeMicros,
@@ -1172,12 +1342,14 @@ base class SceneEncoder {
     _profile.add('instance_pack', _instancePackMicros, trackMax: true);
     _profile.add('instance_bind', _instanceBindMicros);
     _profile.add('instance_bytes', _instanceBytes);
+    _profile.add('instance_packed_bytes', _instancePackedBytes);
     _profile.add('draws', draws);
     _profile.add('instances', instances);
     final snapshot = _profile.endSample();
     _instancePackMicros = 0;
     _instanceBindMicros = 0;
     _instanceBytes = 0;
+    _instancePackedBytes = 0;
     _opaqueSortMicros = 0;
     _opaqueEncodeMicros = 0;
     if (snapshot == null) return;
@@ -1190,6 +1362,8 @@ base class SceneEncoder {
       'instance_pack_max_us=${snapshot.max('instance_pack')} '
       'instance_bind_mean_us=${snapshot.mean('instance_bind')} '
       'instance_kib_mean=${snapshot.mean('instance_bytes') ~/ 1024} '
+      'instance_packed_kib_mean='
+      '${snapshot.mean('instance_packed_bytes') ~/ 1024} '
       'draws_mean=${snapshot.mean('draws')} '
       'instances_mean=${snapshot.mean('instances')}',
     );
@@ -1311,9 +1485,15 @@ base class SceneEncoder {
 
   void _prepareTranslucent() {
     if (_translucentPrepared) return;
+    final tracer = FrameTracer.active;
+    tracer?.begin(
+      'sort.translucent',
+      args: {'draws': _translucentRecords.length},
+    );
     final sortWatch = profileRendering ? (Stopwatch()..start()) : null;
-    _translucentRecords.sort((a, b) => b.depth.compareTo(a.depth));
+    _sortTranslucent(_translucentRecords);
     sortWatch?.stop();
+    tracer?.end();
     _translucentSortMicros = sortWatch?.elapsedMicroseconds ?? 0;
     _translucentPrepared = true;
   }
@@ -1428,6 +1608,8 @@ base class SceneEncoder {
       EngineLightingUniforms.invalidateBindMemo();
     }
     _renderPass.setDepthCompareOperation(gpu.CompareFunction.lessEqual);
+    final tracer = FrameTracer.active;
+    tracer?.begin('encode.translucent');
     final encodeWatch = profileRendering ? (Stopwatch()..start()) : null;
     _renderPass.setDepthWriteEnable(false);
     _renderPass.setColorBlendEnable(true);
@@ -1451,6 +1633,7 @@ base class SceneEncoder {
       final joints = record.jointsTexture;
       if (joints != null) {
         record.geometry.setJointsTexture(joints, record.jointsTextureWidth);
+        record.geometry.setJointsInModelSpace(record.item.jointsInModelSpace);
       }
       record.item.applyMorphWeights(record.geometry);
       final instances = record.item.instanceTransforms;
@@ -1492,8 +1675,13 @@ base class SceneEncoder {
     }
     encodeWatch?.stop();
     _translucentEncodeMicros += encodeWatch?.elapsedMicroseconds ?? 0;
+    tracer?.end();
 
     if (_translucentCursor == _translucentRecords.length) {
+      tracer?.counter('draws', {
+        'draws': _encodedDraws,
+        'instances': _encodedInstances,
+      });
       if (profileRendering) {
         _recordProfile(
           _opaqueSortMicros + _translucentSortMicros,
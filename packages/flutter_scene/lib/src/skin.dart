@@ -59,19 +59,21 @@ base class Skin {
   /// `joints[i]`.
   final List<Matrix4> inverseBindMatrices = [];
 
-  /// Ring of joints textures reused across frames by [getJointsTexture].
+  final _JointsTextureRing _jointsTextures = _JointsTextureRing();
+
+  // The last upload, and each joint's world transform version when it was
+  // made (-1 for a null joint), so an unmoved skeleton is not re-uploaded.
+  gpu.Texture? _uploadedTexture;
+  Float32List? _jointMatrices;
+  final List<int> _uploadedJointVersions = [];
+
+  /// Joint matrices shared with other skins in the same pose, drawn in
+  /// place of this skin's own joints when set.
   ///
-  /// Each frame writes the next slot so the GPU is never handed a texture
-  /// it may still be sampling from a recent frame. The ring is allocated
-  /// lazily and dropped if the joint count (and therefore the texture
-  /// size) ever changes.
-  static const int _jointsTextureRingSize = 3;
-  final List<gpu.Texture?> _jointsTextureRing = List<gpu.Texture?>.filled(
-    _jointsTextureRingSize,
-    null,
-  );
-  int _jointsTextureRingCursor = 0;
-  int _jointsTextureDimension = 0;
+  /// Managed by `AnimationCrowd`; the joints themselves are not read while
+  /// it is set.
+  @internal
+  SharedJointPose? sharedPose;
 
   /// Computes the joint matrices for the current frame and uploads them as
   /// a square `RGBA32F` GPU texture.
@@ -82,38 +84,58 @@ base class Skin {
   ///
   /// The companion [getTextureWidth] returns the same edge length so the
   /// vertex shader can index into the texture.
+  ///
+  /// When no joint's world transform changed since the last call (a
+  /// frozen or paused character), the previous texture is returned without
+  /// uploading again. Replacing [inverseBindMatrices] in place is not
+  /// tracked; do it before the skin is first drawn.
+  ///
+  /// When [sharedPose] is set, returns its texture instead, uploaded at
+  /// most once per pose change however many skins draw it.
   gpu.Texture getJointsTexture() {
-    final int dimensionSize = _jointsTextureEdge(joints.length);
-
-    // Drop the ring if the texture size changed (joint count is fixed
-    // after construction, so this normally never triggers).
-    if (dimensionSize != _jointsTextureDimension) {
-      _jointsTextureRing.fillRange(0, _jointsTextureRing.length, null);
-      _jointsTextureDimension = dimensionSize;
+    final shared = sharedPose;
+    if (shared != null) {
+      _uploadedTexture = null;
+      return shared.getJointsTexture();
     }
 
-    // Advance to the next ring slot, allocating it on first use.
-    _jointsTextureRingCursor =
-        (_jointsTextureRingCursor + 1) % _jointsTextureRingSize;
-    final gpu.Texture texture = _jointsTextureRing[_jointsTextureRingCursor] ??=
-        gpu.gpuContext.createTexture(
-          gpu.StorageMode.hostVisible,
-          dimensionSize,
-          dimensionSize,
-          format: gpu.PixelFormat.r32g32b32a32Float,
-        );
+    final uploaded = _uploadedTexture;
+    if (uploaded != null && !_jointsMovedSinceUpload()) return uploaded;
+
+    final int dimensionSize = _jointsTextureEdge(joints.length);
     // 64 bytes per matrix. 4 bytes per pixel.
-    Float32List jointMatrixFloats = Float32List(
-      dimensionSize * dimensionSize * 4,
+    var jointMatrixFloats = _jointMatrices;
+    if (jointMatrixFloats == null ||
+        jointMatrixFloats.length != dimensionSize * dimensionSize * 4) {
+      jointMatrixFloats = _jointMatrices = _identityMatrices(dimensionSize);
+    }
+    writeJointMatrices(jointMatrixFloats);
+    _uploadedJointVersions.clear();
+    for (final joint in joints) {
+      _uploadedJointVersions.add(joint?.worldTransformVersion ?? -1);
+    }
+    return _uploadedTexture = _jointsTextures.upload(
+      jointMatrixFloats,
+      dimensionSize,
     );
-    // Initialize with identity matrices.
-    for (int i = 0; i < jointMatrixFloats.length; i += 16) {
-      jointMatrixFloats[i] = 1.0;
-      jointMatrixFloats[i + 5] = 1.0;
-      jointMatrixFloats[i + 10] = 1.0;
-      jointMatrixFloats[i + 15] = 1.0;
+  }
+
+  bool _jointsMovedSinceUpload() {
+    if (_uploadedJointVersions.length != joints.length) return true;
+    for (var i = 0; i < joints.length; i++) {
+      final version = joints[i]?.worldTransformVersion ?? -1;
+      if (version != _uploadedJointVersions[i]) return true;
     }
+    return false;
+  }
 
+  /// Writes each joint's skinning matrix into [out], 16 floats a joint in
+  /// [joints] order. Null joints are skipped, leaving their slot as is.
+  ///
+  /// The matrices are in world space, or in the space [worldToSpace] maps
+  /// world space into when given.
+  @internal
+  void writeJointMatrices(Float32List out, [Matrix4? worldToSpace]) {
     for (int jointIndex = 0; jointIndex < joints.length; jointIndex++) {
       final Node? joint = joints[jointIndex];
       // A null joint (Node.clone couldn't relocate it) keeps the
@@ -131,18 +153,106 @@ base class Skin {
       //
       // The shader applies this matrix directly, so the mesh node's own
       // transform must not be applied again -- SkinnedGeometry.bind
-      // passes an identity model transform.
-      final Matrix4 matrix =
-          joint.globalTransform * inverseBindMatrices[jointIndex];
+      // passes an identity model transform (unless the matrices were
+      // written into the mesh node's space, as shared poses are).
+      Matrix4 matrix = joint.globalTransform * inverseBindMatrices[jointIndex];
+      if (worldToSpace != null) matrix = worldToSpace * matrix;
       final floatOffset = jointIndex * 16;
-      jointMatrixFloats.setRange(floatOffset, floatOffset + 16, matrix.storage);
+      out.setRange(floatOffset, floatOffset + 16, matrix.storage);
     }
-
-    texture.overwrite(jointMatrixFloats.buffer.asByteData());
-    return texture;
   }
 
   /// The edge length, in texels, of the joints texture produced by
   /// [getJointsTexture].
-  int getTextureWidth() => _jointsTextureEdge(joints.length);
+  int getTextureWidth() =>
+      sharedPose?.textureWidth ?? _jointsTextureEdge(joints.length);
+}
+
+/// Skinning matrices evaluated once and drawn by every [Skin] whose
+/// [Skin.sharedPose] references them (see `AnimationCrowd`).
+///
+/// The matrices are in the skinned mesh node's space rather than world
+/// space, so characters posed alike in different places share them; their
+/// draws apply the mesh node's world transform as the model transform.
+@internal
+final class SharedJointPose {
+  SharedJointPose(this.jointCount)
+    : textureWidth = _jointsTextureEdge(jointCount),
+      matrices = _identityMatrices(_jointsTextureEdge(jointCount));
+
+  /// The number of joints the pose holds.
+  final int jointCount;
+
+  /// The edge length, in texels, of the texture [getJointsTexture] returns.
+  final int textureWidth;
+
+  /// The texture's contents: 16 floats a joint, then identity padding.
+  /// Call [markChanged] after writing them.
+  final Float32List matrices;
+
+  int _version = 0;
+  int _uploadedVersion = -1;
+  gpu.Texture? _texture;
+  final _JointsTextureRing _ring = _JointsTextureRing();
+
+  /// The number of times [matrices] have been uploaded.
+  int get uploadCount => _uploadCount;
+  int _uploadCount = 0;
+
+  /// Flags [matrices] as rewritten, so the next draw uploads them.
+  void markChanged() => _version++;
+
+  /// The texture holding [matrices], uploaded only if they changed since
+  /// the last call.
+  gpu.Texture getJointsTexture() {
+    if (_uploadedVersion != _version || _texture == null) {
+      _texture = _ring.upload(matrices, textureWidth);
+      _uploadedVersion = _version;
+      _uploadCount++;
+    }
+    return _texture!;
+  }
+}
+
+// Identity matrices filling a [dimension]-square RGBA32F texture.
+Float32List _identityMatrices(int dimension) {
+  final floats = Float32List(dimension * dimension * 4);
+  for (int i = 0; i < floats.length; i += 16) {
+    floats[i] = 1.0;
+    floats[i + 5] = 1.0;
+    floats[i + 10] = 1.0;
+    floats[i + 15] = 1.0;
+  }
+  return floats;
+}
+
+/// Ring of joints textures reused across frames.
+///
+/// Each upload writes the next slot so the GPU is never handed a texture
+/// it may still be sampling from a recent frame. The ring is allocated
+/// lazily and dropped if the texture size ever changes (joint count is
+/// fixed after construction, so this normally never triggers).
+class _JointsTextureRing {
+  static const int _size = 3;
+  final List<gpu.Texture?> _textures = List<gpu.Texture?>.filled(_size, null);
+  int _cursor = 0;
+  int _dimension = 0;
+
+  gpu.Texture upload(Float32List matrices, int dimension) {
+    if (dimension != _dimension) {
+      _textures.fillRange(0, _textures.length, null);
+      _dimension = dimension;
+    }
+    // Advance to the next ring slot, allocating it on first use.
+    _cursor = (_cursor + 1) % _size;
+    final gpu.Texture texture = _textures[_cursor] ??= gpu.gpuContext
+        .createTexture(
+          gpu.StorageMode.hostVisible,
+          dimension,
+          dimension,
+          format: gpu.PixelFormat.r32g32b32a32Float,
+        );
+    texture.overwrite(matrices.buffer.asByteData());
+    return texture;
+  }
 }
@@ -1,3 +1,7 @@
+import 'dart:async';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
 import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
 import 'package:vector_math/vector_math.dart' as vm;
@@ -5,28 +9,41 @@ import 'package:vector_math/vector_math.dart' as vm;
 import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
 import 'package:flutter_scene/src/splats/splat_codec.dart';
 import 'package:flutter_scene/src/splats/splat_data.dart';
+import 'package:flutter_scene/src/splats/splat_stream.dart';
 
 /// A loaded Gaussian splat set, the decoded arrays plus the GPU textures the
 /// splat shaders fetch from.
 ///
 /// Load one with [fromAsset] or [fromBytes] (decoded and packed on a
-/// background isolate), or build one procedurally with [fromData], then
-/// attach it through a `SplatComponent`.
+/// background isolate), stream one in with [fromStream], or build one
+/// procedurally with [fromData], then attach it through a
+/// `SplatComponent`.
 ///
 /// The GPU textures are created lazily on first draw, so a `GaussianSplats`
 /// can be constructed before `Scene.initializeStaticResources` completes.
 /// {@category Gaussian splatting}
 class GaussianSplats {
-  GaussianSplats._(PackedSplats packed, this.colorSpace)
-    : data = packed.data,
+  GaussianSplats._(
+    PackedSplats packed,
+    this.colorSpace, {
+    bool streaming = false,
+  }) : _data = streaming ? packed.data.prefix(0) : packed.data,
+      _stream = streaming ? packed : null,
+      capacity = packed.data.count,
+      packing = packed.packing,
+      gpuBytes = packed.gpuBytes,
       paramsWidth = packed.paramsWidth,
-      paramsHeight = packed.paramsHeight,
+      _paramsRows = packed.paramsHeight,
       shWidth = packed.shWidth,
-      shHeight = packed.shHeight,
+      _shRows = packed.shHeight,
       shStride = packed.shStride,
+      chunkWidth = packed.chunkWidth,
+      _chunkRows = packed.chunkHeight,
       _paramsTexels = packed.paramsTexels,
-      _shTexels = packed.shTexels {
-    bounds = data.computeBounds();
+      _shTexels = packed.shTexels,
+      _chunkTexels = packed.chunkTexels {
+    _bounds = _data.computeBounds();
+    if (!streaming) _loaded.complete();
   }
 
   /// Wraps an already-decoded-and-packed splat set. Takes the internal
@@ -46,19 +63,23 @@ class GaussianSplats {
   factory GaussianSplats.fromData(
     SplatData data, {
     SplatColorSpace colorSpace = SplatColorSpace.linear,
-  }) => GaussianSplats._(packSplats(data), colorSpace);
+    SplatPacking packing = SplatPacking.full,
+  }) => GaussianSplats._(packSplats(data, packing: packing), colorSpace);
 
   /// Loads and decodes a splat file from the asset bundle.
   ///
   /// The format is sniffed from the file magic, falling back to the asset
   /// extension (`.ply` vs `.splat`); pass [format] to override. Decoding and
-  /// packing run on a background isolate.
+  /// packing run on a background isolate. [SplatPacking.compact] cuts GPU
+  /// memory to about a quarter; a compressed PLY loads into it without
+  /// re-quantizing.
   static Future<GaussianSplats> fromAsset(
     String assetPath, {
     SplatFormat? format,
     double alphaCullThreshold = 1.0 / 255.0,
     int maxShDegree = 2,
     SplatColorSpace colorSpace = SplatColorSpace.displayReferred,
+    SplatPacking packing = SplatPacking.full,
   }) async {
     final bytes = await rootBundle.load(assetPath);
     return fromBytes(
@@ -71,6 +92,7 @@ class GaussianSplats {
       alphaCullThreshold: alphaCullThreshold,
       maxShDegree: maxShDegree,
       colorSpace: colorSpace,
+      packing: packing,
     );
   }
 
@@ -81,6 +103,7 @@ class GaussianSplats {
     double alphaCullThreshold = 1.0 / 255.0,
     int maxShDegree = 2,
     SplatColorSpace colorSpace = SplatColorSpace.displayReferred,
+    SplatPacking packing = SplatPacking.full,
   }) async {
     final sniffed = sniffSplatFormat(bytes, fallback: format);
     final packed = await compute(decodeSplatsForIsolate, (
@@ -88,32 +111,206 @@ class GaussianSplats {
       format: sniffed,
       alphaCullThreshold: alphaCullThreshold,
       maxShDegree: maxShDegree,
+      packing: packing,
     ), debugLabel: 'decodeSplats');
     return GaussianSplats._(packed, colorSpace);
   }
 
+  /// Loads a splat file progressively from [bytes] (an asset, file, or
+  /// network stream), completing as soon as its header has arrived.
+  ///
+  /// The set starts empty and grows as runs of records decode on
+  /// background isolates, so it can be attached at once and draws whatever
+  /// has arrived; [loaded] completes when the whole file is in, or with
+  /// the error that stopped it. A file written most important first
+  /// ([SplatData.orderedByImportance], [encodeSplatPly]) shows a coarse
+  /// version of the whole set after its first runs.
+  ///
+  /// Training PLYs stream, as do `.splat` files whose [lengthInBytes] is
+  /// given; other files are buffered and decoded whole, as [fromBytes]
+  /// does. A compact streamed set keeps every splat (no alpha cull), since
+  /// a cull would misalign its 256-splat chunks. While loading, decoded
+  /// runs join the drawn set once they add half again as many splats as it
+  /// holds, and the textures grow by doubling their rows, so the bytes
+  /// uploaded over a load stay a small multiple of the file's.
+  static Future<GaussianSplats> fromStream(
+    Stream<List<int>> bytes, {
+    SplatFormat? format,
+    int? lengthInBytes,
+    double alphaCullThreshold = 1.0 / 255.0,
+    int maxShDegree = 2,
+    SplatColorSpace colorSpace = SplatColorSpace.displayReferred,
+    SplatPacking packing = SplatPacking.full,
+  }) {
+    final ready = Completer<GaussianSplats>();
+    final reader = SplatStreamReader(
+      format: format,
+      options: SplatDecodeOptions(maxShDegree: maxShDegree),
+      lengthInBytes: lengthInBytes,
+    );
+    final cull = packing == SplatPacking.compact ? 0.0 : alphaCullThreshold;
+    GaussianSplats? splats;
+
+    GaussianSplats start() {
+      final layout = reader.layout!;
+      final started = GaussianSplats._(
+        allocatePackedSplats(
+          reader.count!,
+          shDegree: layout.shDegree,
+          packing: packing,
+        ),
+        colorSpace,
+        streaming: true,
+      );
+      ready.complete(started);
+      return started;
+    }
+
+    Future<void> decode(GaussianSplats into, Uint8List run) async {
+      into._append(
+        await compute(decodeSplatRecordsForIsolate, (
+          layout: reader.layout!,
+          records: run,
+          alphaCullThreshold: cull,
+          packing: packing,
+        ), debugLabel: 'decodeSplatRecords'),
+      );
+    }
+
+    // Awaiting each run inside the loop pauses the source, so at most one
+    // run is in flight and the file is never held whole.
+    () async {
+      try {
+        await for (final chunk in bytes) {
+          final runs = reader.add(chunk);
+          if (reader.layout == null) continue;
+          final into = splats ??= start();
+          for (final run in runs) {
+            await decode(into, run);
+          }
+        }
+        final last = reader.close();
+        if (reader.buffered) {
+          ready.complete(
+            await fromBytes(
+              last!,
+              format: reader.format ?? format,
+              alphaCullThreshold: alphaCullThreshold,
+              maxShDegree: maxShDegree,
+              colorSpace: colorSpace,
+              packing: packing,
+            ),
+          );
+          return;
+        }
+        final into = splats ??= start();
+        if (last != null) await decode(into, last);
+        into._finishLoading();
+      } catch (error, stack) {
+        if (!ready.isCompleted) {
+          ready.completeError(error, stack);
+        } else {
+          splats?._publish();
+          splats?._loaded.completeError(error, stack);
+        }
+      }
+    }();
+    return ready.future;
+  }
+
   /// The decoded splat arrays (positions drive depth sorting; the rest are
-  /// kept for bounds and readback).
-  final SplatData data;
+  /// kept for bounds and readback). Covers the splats loaded so far.
+  SplatData get data => _data;
+  SplatData _data;
+
+  // The full-capacity arrays a streaming load fills, until it completes,
+  // and the splats decoded into them (ahead of [_data] until published).
+  PackedSplats? _stream;
+  int _decoded = 0;
+
+  /// The number of splats the set holds once loaded. Equal to [count]
+  /// except while a [fromStream] load is in progress.
+  final int capacity;
+
+  /// Completes when every splat has loaded (at once, unless the set came
+  /// from [fromStream]).
+  Future<void> get loaded => _loaded.future;
+  final Completer<void> _loaded = Completer<void>();
+
+  /// Whether a [fromStream] load is still adding splats.
+  bool get isLoading => !_loaded.isCompleted;
+
+  /// Counts the changes to the loaded splats. Consumed by `SplatGeometry`
+  /// to notice a streaming set grow; not application API.
+  @internal
+  int get revision => _revision;
+  int _revision = 0;
+
+  /// Each loaded splat's importance ([SplatData.computeImportance]),
+  /// computed on first use. Consumed by `SplatGeometry` for splat budgets;
+  /// not application API.
+  @internal
+  Float32List get importance => _importance ??= _data.computeImportance();
+  Float32List? _importance;
+
+  // Adds a decoded run to a streaming set. Runs are published (drawn, and
+  // so uploaded) once they grow the set by half, keeping the whole-texture
+  // uploads geometric in number rather than one per run.
+  void _append(PackedSplats batch) {
+    copyPackedSplats(batch, _stream!, _decoded);
+    _decoded += batch.data.count;
+    final batchBounds = batch.data.computeBounds();
+    final bounds = _bounds;
+    if (batchBounds != null) {
+      _bounds = bounds == null ? batchBounds : (bounds..hull(batchBounds));
+    }
+    if (_decoded >= _data.count + (_data.count >> 1)) _publish();
+  }
+
+  // Makes every decoded splat part of [data].
+  void _publish() {
+    final stream = _stream;
+    if (stream == null || _decoded == _data.count) return;
+    _data = stream.data.prefix(_decoded);
+    _importance = null;
+    _revision++;
+  }
+
+  void _finishLoading() {
+    _publish();
+    _stream = null;
+    _loaded.complete();
+  }
 
   /// How [data]'s colors map into the linear HDR pipeline.
   final SplatColorSpace colorSpace;
 
+  /// The GPU layout of the splat parameters.
+  final SplatPacking packing;
+
+  /// The bytes the set's textures occupy on the GPU.
+  final int gpuBytes;
+
   /// Local-space bounds of the set (splat centers padded by three standard
   /// deviations), or null for an empty set.
-  late final vm.Aabb3? bounds;
+  vm.Aabb3? get bounds => _bounds;
+  vm.Aabb3? _bounds;
 
-  /// The number of splats.
-  int get count => data.count;
+  /// The number of splats (loaded so far, for a [fromStream] set).
+  int get count => _data.count;
 
   /// Parameter texture dimensions in texels. Consumed by `SplatGeometry` to
   /// address the data texture; not application API.
+  ///
+  /// While a [fromStream] load is in progress the heights are the rows the
+  /// textures hold so far, so read them after the textures.
   @internal
   final int paramsWidth;
 
   /// See [paramsWidth].
   @internal
-  final int paramsHeight;
+  int get paramsHeight => _paramsTexture?.height ?? _paramsRows;
+  final int _paramsRows;
 
   /// Rest-SH texture dimensions and per-splat texel stride (zero when the
   /// set carries no rest coefficients). Consumed by `SplatGeometry`; not
@@ -123,55 +320,134 @@ class GaussianSplats {
 
   /// See [shWidth].
   @internal
-  final int shHeight;
+  int get shHeight => _shTexture?.height ?? _shRows;
+  final int _shRows;
 
   /// See [shWidth].
   @internal
   final int shStride;
 
-  // Texel arrays are held only until the first upload, then released.
-  Float32List? _paramsTexels;
-  Float32List? _shTexels;
+  /// Chunk-range texture dimensions (zero unless [packing] is
+  /// [SplatPacking.compact]). Consumed by `SplatGeometry`; not application
+  /// API.
+  @internal
+  final int chunkWidth;
+
+  /// See [chunkWidth].
+  @internal
+  int get chunkHeight => _chunkTexture?.height ?? _chunkRows;
+  final int _chunkRows;
+
+  // Texel arrays are held until the first upload after loading finishes,
+  // then released. Each texture re-uploads the rows it has when the
+  // revision moved on.
+  TypedData? _paramsTexels;
+  TypedData? _shTexels;
+  Float32List? _chunkTexels;
 
   gpu.Texture? _paramsTexture;
   gpu.Texture? _shTexture;
+  gpu.Texture? _chunkTexture;
+  int _paramsRevision = -1;
+  int _shRevision = -1;
+  int _chunkRevision = -1;
 
-  /// The RGBA32F parameter texture ([kParamsTexelsPerSplat] texels per
-  /// splat). Created on first access; requires the GPU context. Consumed by
-  /// `SplatGeometry`; not application API.
+  // The texel format of the per-splat textures.
+  gpu.PixelFormat get _splatFormat => packing == SplatPacking.compact
+      ? gpu.PixelFormat.r8g8b8a8UNormInt
+      : gpu.PixelFormat.r32g32b32a32Float;
+
+  /// The parameter texture ([kParamsTexelsPerSplat] texels per splat,
+  /// RGBA32F or, compact, RGBA8). Created on first access; requires the GPU
+  /// context. Consumed by `SplatGeometry`; not application API.
   @internal
   gpu.Texture get paramsTexture {
-    var texture = _paramsTexture;
-    if (texture == null) {
-      texture = _upload(_paramsTexels!, paramsWidth, paramsHeight);
-      _paramsTexture = texture;
-      _paramsTexels = null;
+    if (_paramsRevision != _revision) {
+      _paramsTexture = _upload(
+        _paramsTexture,
+        _paramsTexels!,
+        paramsWidth,
+        _paramsRows,
+        count * kParamsTexelsPerSplat,
+        _splatFormat,
+      );
+      _paramsRevision = _revision;
     }
-    return texture;
+    if (!isLoading) _paramsTexels = null;
+    return _paramsTexture!;
   }
 
-  /// The RGBA32F rest-SH texture, or null when [SplatData.shDegree] is 0.
-  /// Consumed by `SplatGeometry`; not application API.
+  /// The rest-SH texture, or null when [SplatData.shDegree] is 0. Consumed
+  /// by `SplatGeometry`; not application API.
   @internal
   gpu.Texture? get shTexture {
     if (data.shDegree == 0) return null;
-    var texture = _shTexture;
-    if (texture == null) {
-      texture = _upload(_shTexels!, shWidth, shHeight);
-      _shTexture = texture;
-      _shTexels = null;
+    if (_shRevision != _revision) {
+      _shTexture = _upload(
+        _shTexture,
+        _shTexels!,
+        shWidth,
+        _shRows,
+        count * shStride,
+        _splatFormat,
+      );
+      _shRevision = _revision;
     }
-    return texture;
+    if (!isLoading) _shTexels = null;
+    return _shTexture;
   }
 
-  static gpu.Texture _upload(Float32List texels, int width, int height) {
-    final texture = gpu.gpuContext.createTexture(
-      gpu.StorageMode.hostVisible,
-      width,
-      height,
-      format: gpu.PixelFormat.r32g32b32a32Float,
+  /// The RGBA32F chunk-range texture of a compact set, or null for a full
+  /// one. Consumed by `SplatGeometry`; not application API.
+  @internal
+  gpu.Texture? get chunkTexture {
+    if (packing != SplatPacking.compact) return null;
+    if (_chunkRevision != _revision) {
+      final chunks = (count + kSplatChunkSize - 1) ~/ kSplatChunkSize;
+      _chunkTexture = _upload(
+        _chunkTexture,
+        _chunkTexels!,
+        chunkWidth,
+        _chunkRows,
+        chunks * kSplatChunkTexels,
+        gpu.PixelFormat.r32g32b32a32Float,
+      );
+      _chunkRevision = _revision;
+    }
+    if (!isLoading) _chunkTexels = null;
+    return _chunkTexture;
+  }
+
+  // Uploads the rows of [texels] (four elements per texel, [width] texels
+  // per row, [rows] rows once loaded) that hold the first [used] texels.
+  // [texture] is kept while it has the rows, and otherwise replaced by one
+  // with twice as many as needed, up to [rows], so a streaming set
+  // recreates each texture only a few times and uploads at most twice the
+  // rows it uses.
+  static gpu.Texture _upload(
+    gpu.Texture? texture,
+    TypedData texels,
+    int width,
+    int rows,
+    int used,
+    gpu.PixelFormat format,
+  ) {
+    final needed = math.max(1, (used + width - 1) ~/ width);
+    if (texture == null || texture.height < needed) {
+      var height = 1;
+      while (height < needed) {
+        height <<= 1;
+      }
+      texture = gpu.gpuContext.createTexture(
+        gpu.StorageMode.hostVisible,
+        width,
+        math.min(height, rows),
+        format: format,
+      );
+    }
+    texture.overwrite(
+      ByteData.sublistView(texels, 0, width * texture.height * 4),
     );
-    texture.overwrite(ByteData.sublistView(texels));
     return texture;
   }
 }
@@ -13,6 +13,27 @@ enum SplatFormat {
   /// The compact 32-byte-per-splat `.splat` layout common in web pipelines,
   /// float position and scale, 8-bit color/opacity, 8-bit quaternion.
   splat,
+
+  /// The chunked compressed PLY written by SuperSplat and splat-transform
+  /// (`.compressed.ply`): 16 bytes per splat quantized within 256-splat
+  /// chunks, plus 8-bit rest SH. See [encodeCompressedSplatPly].
+  compressedPly,
+}
+
+/// How a splat set's parameters are laid out in GPU memory.
+/// {@category Gaussian splatting}
+enum SplatPacking {
+  /// Full-precision RGBA32F texels, 64 bytes per splat plus 16 per rest SH
+  /// coefficient. Exact, and the cheapest to shade.
+  full,
+
+  /// The compressed PLY's quantization, 16 bytes per splat plus 4 per rest
+  /// SH coefficient (and a few bytes per 256-splat chunk). Positions, log
+  /// scales, colors, and SH are stored within per-chunk ranges and the
+  /// rotation as a 10-bit smallest-three quaternion; the vertex shader
+  /// rebuilds the covariance. About a quarter of [full]'s memory, at a
+  /// precision finer than a pixel for typical captures.
+  compact,
 }
 
 /// Options applied while decoding a splat file.
@@ -20,6 +41,7 @@ class SplatDecodeOptions {
   const SplatDecodeOptions({
     this.alphaCullThreshold = 1.0 / 255.0,
     this.maxShDegree = 2,
+    this.packing = SplatPacking.full,
   });
 
   /// Splats whose decoded opacity falls below this are dropped at load.
@@ -28,6 +50,9 @@ class SplatDecodeOptions {
   /// The highest spherical-harmonic degree to keep (0 to 2). Coefficients
   /// beyond it are discarded at load, saving GPU memory.
   final int maxShDegree;
+
+  /// The GPU layout to pack into.
+  final SplatPacking packing;
 }
 
 /// A decoded splat set together with its GPU-ready texel arrays.
@@ -44,35 +69,71 @@ class PackedSplats {
     this.shWidth = 0,
     this.shHeight = 0,
     this.shStride = 0,
+    this.packing = SplatPacking.full,
+    this.chunkTexels,
+    this.chunkWidth = 0,
+    this.chunkHeight = 0,
   });
 
   /// The decoded splat arrays (kept for sorting, bounds, and readback).
   final SplatData data;
 
-  /// RGBA32F parameter texels, [kParamsTexelsPerSplat] per splat, laid out as
+  /// The layout of the texel arrays.
+  final SplatPacking packing;
+
+  /// Parameter texels, [kParamsTexelsPerSplat] per splat.
+  ///
+  /// For [SplatPacking.full], a [Float32List] of RGBA32F texels laid out as
   /// `pos.xyz, opacity | cov.xx,xy,xz,yy | cov.yz,zz,0,0 | color.rgb, 0`.
-  final Float32List paramsTexels;
+  /// For [SplatPacking.compact], a [Uint8List] of RGBA8 texels, each one
+  /// little-endian word of the compressed PLY's vertex record
+  /// (`packed_position, packed_rotation, packed_scale, packed_color`).
+  final TypedData paramsTexels;
 
   /// Parameter texture dimensions. The width is a power of two so the
   /// per-splat texel groups never straddle a row.
   final int paramsWidth;
   final int paramsHeight;
 
-  /// RGBA32F texels for the rest-SH texture ([shStride] texels per splat,
-  /// one coefficient's `r, g, b` per texel), or null when the set carries
-  /// no rest coefficients.
-  final Float32List? shTexels;
+  /// Texels for the rest-SH texture ([shStride] texels per splat, one
+  /// coefficient's `r, g, b` per texel), or null when the set carries no
+  /// rest coefficients. RGBA32F ([Float32List]) for [SplatPacking.full];
+  /// RGBA8 ([Uint8List]) unorm within the chunk's SH range for
+  /// [SplatPacking.compact].
+  final TypedData? shTexels;
   final int shWidth;
   final int shHeight;
 
   /// Texels per splat in the SH texture, a power of two so groups never
   /// straddle rows (4 for degree 1, 8 for degree 2).
   final int shStride;
+
+  /// RGBA32F per-chunk quantization ranges for [SplatPacking.compact]
+  /// ([kSplatChunkTexels] texels per [kSplatChunkSize] splats), laid out as
+  /// `pos min.xyz, sh min | pos max.xyz, sh max | log scale min.xyz, 0 |
+  /// log scale max.xyz, 0 | color min.rgb, 0 | color max.rgb, 0 | 0 | 0`.
+  /// Null for [SplatPacking.full].
+  final Float32List? chunkTexels;
+  final int chunkWidth;
+  final int chunkHeight;
+
+  /// The bytes the texel arrays occupy on the GPU.
+  int get gpuBytes =>
+      paramsTexels.lengthInBytes +
+      (shTexels?.lengthInBytes ?? 0) +
+      (chunkTexels?.lengthInBytes ?? 0);
 }
 
 /// Texels per splat in the parameter texture.
 const int kParamsTexelsPerSplat = 4;
 
+/// Splats per quantization chunk in [SplatPacking.compact] (and in the
+/// compressed PLY).
+const int kSplatChunkSize = 256;
+
+/// Texels per chunk in the compact chunk texture.
+const int kSplatChunkTexels = 8;
+
 /// The widest data texture the packer will emit. 4096 is universally
 /// supported by the backends flutter_scene ships on.
 const int kMaxSplatTextureWidth = 4096;
@@ -88,11 +149,20 @@ PackedSplats decodeSplats(
   SplatFormat format, {
   SplatDecodeOptions options = const SplatDecodeOptions(),
 }) {
+  if (format == SplatFormat.compressedPly &&
+      options.packing == SplatPacking.compact) {
+    // Already in the compact layout, so the splat records copy through.
+    return _decodeCompressedPlyCompact(bytes, options);
+  }
   final data = switch (format) {
     SplatFormat.ply => parseSplatPly(bytes, options: options),
     SplatFormat.splat => parseSplatFile(bytes, options: options),
+    SplatFormat.compressedPly => parseCompressedSplatPly(
+      bytes,
+      options: options,
+    ),
   };
-  return packSplats(data);
+  return packSplats(data, packing: options.packing);
 }
 
 /// The top-level `compute` entry point for [decodeSplats].
@@ -102,6 +172,7 @@ PackedSplats decodeSplatsForIsolate(
     SplatFormat format,
     double alphaCullThreshold,
     int maxShDegree,
+    SplatPacking packing,
   })
   args,
 ) {
@@ -111,10 +182,30 @@ PackedSplats decodeSplatsForIsolate(
     options: SplatDecodeOptions(
       alphaCullThreshold: args.alphaCullThreshold,
       maxShDegree: args.maxShDegree,
+      packing: args.packing,
     ),
   );
 }
 
+/// The top-level `compute` entry point for a streaming load: decodes one
+/// run of records ([decodeSplatRecords]) and packs it.
+PackedSplats decodeSplatRecordsForIsolate(
+  ({
+    SplatRecordLayout layout,
+    Uint8List records,
+    double alphaCullThreshold,
+    SplatPacking packing,
+  })
+  args,
+) {
+  final data = decodeSplatRecords(
+    args.layout,
+    args.records,
+    options: SplatDecodeOptions(alphaCullThreshold: args.alphaCullThreshold),
+  );
+  return packSplats(data, packing: args.packing);
+}
+
 /// Parses a binary little-endian Gaussian-splat PLY.
 ///
 /// Recognizes the training properties by name (`x`, `f_dc_0`, `f_rest_*`,
@@ -126,72 +217,134 @@ SplatData parseSplatPly(
   SplatDecodeOptions options = const SplatDecodeOptions(),
 }) {
   final header = _parsePlyHeader(bytes);
-  final props = header.properties;
+  final layout = _PlyRecordLayout(header, options.maxShDegree);
+  final total = header.vertexCount;
+  final end = header.dataOffset + total * header.strideInBytes;
+  if (bytes.length < end) {
+    throw FormatException('Splat PLY is truncated.');
+  }
+  return _decodePlyRecords(
+    layout,
+    ByteData.sublistView(bytes, header.dataOffset, end),
+    total,
+    options.alphaCullThreshold,
+  );
+}
 
-  int require(String name) {
-    final offset = props[name];
-    if (offset == null) {
-      throw FormatException('Splat PLY is missing property "$name".');
+/// The byte offsets of the training properties within a PLY vertex record,
+/// and the SH degree kept from it.
+class _PlyRecordLayout {
+  factory _PlyRecordLayout(_PlyHeader header, int maxShDegree) {
+    final props = header.properties;
+    int require(String name) {
+      final offset = props[name];
+      if (offset == null) {
+        throw FormatException('Splat PLY is missing property "$name".');
+      }
+      return offset;
     }
-    return offset;
-  }
-
-  final xOff = require('x'), yOff = require('y'), zOff = require('z');
-  final dc0 = require('f_dc_0'),
-      dc1 = require('f_dc_1'),
-      dc2 = require('f_dc_2');
-  final opacityOff = require('opacity');
-  final s0 = require('scale_0'),
-      s1 = require('scale_1'),
-      s2 = require('scale_2');
-  final r0 = require('rot_0'),
-      r1 = require('rot_1'),
-      r2 = require('rot_2'),
-      r3 = require('rot_3');
-
-  // The f_rest count determines the file's SH degree. The PLY stores rest
-  // coefficients channel-major (all R coefficients, then G, then B).
-  var fileRest = 0;
-  while (props.containsKey('f_rest_$fileRest')) {
-    fileRest++;
-  }
-  final restPerChannel = fileRest ~/ 3;
-  final fileDegree = switch (restPerChannel) {
-    0 => 0,
-    3 => 1,
-    8 => 2,
-    15 => 3,
-    _ => throw FormatException(
-      'Splat PLY has an unexpected f_rest count ($fileRest).',
-    ),
-  };
-  final degree = math.min(math.min(fileDegree, options.maxShDegree), 2);
-  final keptRest = SplatData.shRestCoeffCount(degree);
 
-  final stride = header.strideInBytes;
-  final view = ByteData.sublistView(bytes, header.dataOffset);
-  final total = header.vertexCount;
-  if (view.lengthInBytes < total * stride) {
-    throw FormatException('Splat PLY is truncated.');
+    // The f_rest count determines the file's SH degree. The PLY stores
+    // rest coefficients channel-major (all R coefficients, then G, then B).
+    var fileRest = 0;
+    while (props.containsKey('f_rest_$fileRest')) {
+      fileRest++;
+    }
+    final restPerChannel = fileRest ~/ 3;
+    final fileDegree = switch (restPerChannel) {
+      0 => 0,
+      3 => 1,
+      8 => 2,
+      15 => 3,
+      _ => throw FormatException(
+        'Splat PLY has an unexpected f_rest count ($fileRest).',
+      ),
+    };
+    final degree = math.min(math.min(fileDegree, maxShDegree), 2);
+    return _PlyRecordLayout._(
+      stride: header.strideInBytes,
+      position: [require('x'), require('y'), require('z')],
+      dc: [require('f_dc_0'), require('f_dc_1'), require('f_dc_2')],
+      opacity: require('opacity'),
+      scale: [require('scale_0'), require('scale_1'), require('scale_2')],
+      rotation: [
+        require('rot_0'),
+        require('rot_1'),
+        require('rot_2'),
+        require('rot_3'),
+      ],
+      restBase: degree > 0 ? require('f_rest_0') : 0,
+      restPerChannel: restPerChannel,
+      shDegree: degree,
+    );
   }
 
+  _PlyRecordLayout._({
+    required this.stride,
+    required this.position,
+    required this.dc,
+    required this.opacity,
+    required this.scale,
+    required this.rotation,
+    required this.restBase,
+    required this.restPerChannel,
+    required this.shDegree,
+  });
+
+  final int stride;
+  final List<int> position;
+  final List<int> dc;
+  final int opacity;
+  final List<int> scale;
+
+  /// `rot_0` (the scalar, w) through `rot_3`.
+  final List<int> rotation;
+  final int restBase;
+  final int restPerChannel;
+
+  /// The SH degree kept, at most the file's.
+  final int shDegree;
+}
+
+// Decodes [total] training-layout vertex records from [view], dropping
+// splats below [alphaCullThreshold].
+SplatData _decodePlyRecords(
+  _PlyRecordLayout layout,
+  ByteData view,
+  int total,
+  double alphaCullThreshold,
+) {
+  final stride = layout.stride;
+  final xOff = layout.position[0],
+      yOff = layout.position[1],
+      zOff = layout.position[2];
+  final dc0 = layout.dc[0], dc1 = layout.dc[1], dc2 = layout.dc[2];
+  final opacityOff = layout.opacity;
+  final s0 = layout.scale[0], s1 = layout.scale[1], s2 = layout.scale[2];
+  final r0 = layout.rotation[0],
+      r1 = layout.rotation[1],
+      r2 = layout.rotation[2],
+      r3 = layout.rotation[3];
+  final restBase = layout.restBase;
+  final restPerChannel = layout.restPerChannel;
+  final keptRest = SplatData.shRestCoeffCount(layout.shDegree);
+
   // Count survivors of the alpha cull first, so the arrays allocate once.
   var kept = 0;
   for (var i = 0; i < total; i++) {
     final op = _sigmoid(
       view.getFloat32(i * stride + opacityOff, Endian.little),
     );
-    if (op >= options.alphaCullThreshold) kept++;
+    if (op >= alphaCullThreshold) kept++;
   }
 
-  final out = SplatData.zeroed(kept, shDegree: degree);
+  final out = SplatData.zeroed(kept, shDegree: layout.shDegree);
   final sh = out.sh;
-  final restBase = sh != null ? require('f_rest_0') : 0;
   var w = 0;
   for (var i = 0; i < total; i++) {
     final base = i * stride;
     final opacity = _sigmoid(view.getFloat32(base + opacityOff, Endian.little));
-    if (opacity < options.alphaCullThreshold) continue;
+    if (opacity < alphaCullThreshold) continue;
 
     final p = w * 3;
     out.positions[p] = view.getFloat32(base + xOff, Endian.little);
@@ -250,16 +403,24 @@ SplatData parseSplatFile(
   Uint8List bytes, {
   SplatDecodeOptions options = const SplatDecodeOptions(),
 }) {
-  const stride = 32;
-  if (bytes.length % stride != 0) {
+  if (bytes.length % _kSplatFileStride != 0) {
     throw FormatException('.splat data length is not a multiple of 32.');
   }
+  return _decodeSplatFileRecords(bytes, options.alphaCullThreshold);
+}
+
+const int _kSplatFileStride = 32;
+
+// Decodes the whole `.splat` records in [bytes], dropping splats below
+// [alphaCullThreshold].
+SplatData _decodeSplatFileRecords(Uint8List bytes, double alphaCullThreshold) {
+  const stride = _kSplatFileStride;
   final total = bytes.length ~/ stride;
   final view = ByteData.sublistView(bytes);
 
   var kept = 0;
   for (var i = 0; i < total; i++) {
-    if (bytes[i * stride + 27] / 255.0 >= options.alphaCullThreshold) kept++;
+    if (bytes[i * stride + 27] / 255.0 >= alphaCullThreshold) kept++;
   }
 
   final out = SplatData.zeroed(kept);
@@ -267,7 +428,7 @@ SplatData parseSplatFile(
   for (var i = 0; i < total; i++) {
     final base = i * stride;
     final opacity = bytes[base + 27] / 255.0;
-    if (opacity < options.alphaCullThreshold) continue;
+    if (opacity < alphaCullThreshold) continue;
 
     final p = w * 3;
     out.positions[p] = view.getFloat32(base, Endian.little);
@@ -297,20 +458,576 @@ SplatData parseSplatFile(
   return out;
 }
 
-/// Packs [data] into the RGBA32F texel arrays the splat shaders fetch.
+/// The record layout of a streamable splat file, read from its header.
+///
+/// [SplatFormat.ply] and [SplatFormat.splat] files are a header followed by
+/// fixed-size, independent records, so any run of whole records decodes on
+/// its own through [decodeSplatRecords]. That is what lets a loader decode
+/// a file while it is still arriving. ([SplatFormat.compressedPly] is not
+/// streamable: its rest SH follows every vertex record.)
+class SplatRecordLayout {
+  SplatRecordLayout._({
+    required this.format,
+    required this.headerLength,
+    required this.stride,
+    required this.count,
+    required this.shDegree,
+    _PlyRecordLayout? ply,
+  }) : _ply = ply;
+
+  final SplatFormat format;
+
+  /// The bytes before the first record.
+  final int headerLength;
+
+  /// The bytes per record.
+  final int stride;
+
+  /// The number of records in the file, or null when the header does not
+  /// say (a `.splat` file has no header).
+  final int? count;
+
+  /// The SH degree the decoded splats carry, after the options' cap.
+  final int shDegree;
+
+  final _PlyRecordLayout? _ply;
+}
+
+/// Reads the record layout from [head], the start of a [format] file, or
+/// returns null when [head] does not yet hold the whole header.
+///
+/// Only [SplatDecodeOptions.maxShDegree] of [options] applies here. Throws
+/// an [ArgumentError] for [SplatFormat.compressedPly].
+SplatRecordLayout? readSplatRecordLayout(
+  Uint8List head,
+  SplatFormat format, {
+  SplatDecodeOptions options = const SplatDecodeOptions(),
+}) {
+  switch (format) {
+    case SplatFormat.splat:
+      return SplatRecordLayout._(
+        format: format,
+        headerLength: 0,
+        stride: _kSplatFileStride,
+        count: null,
+        shDegree: 0,
+      );
+    case SplatFormat.ply:
+      if (_indexOfSequence(head, 'end_header\n'.codeUnits) < 0) {
+        // The header search gives up past its window; so does this wait.
+        if (head.length < _kMaxPlyHeaderLength) return null;
+        throw FormatException('PLY header is missing end_header.');
+      }
+      final header = _parsePlyHeader(head);
+      final layout = _PlyRecordLayout(header, options.maxShDegree);
+      return SplatRecordLayout._(
+        format: format,
+        headerLength: header.dataOffset,
+        stride: header.strideInBytes,
+        count: header.vertexCount,
+        shDegree: layout.shDegree,
+        ply: layout,
+      );
+    case SplatFormat.compressedPly:
+      throw ArgumentError.value(
+        format,
+        'format',
+        'Compressed PLY records cannot be decoded piecewise',
+      );
+  }
+}
+
+/// Decodes [records], a run of whole records laid out as [layout], applying
+/// [options]' alpha cull. Pure, so runs can decode on background isolates.
+SplatData decodeSplatRecords(
+  SplatRecordLayout layout,
+  Uint8List records, {
+  SplatDecodeOptions options = const SplatDecodeOptions(),
+}) {
+  assert(records.length % layout.stride == 0);
+  final ply = layout._ply;
+  if (ply == null) {
+    return _decodeSplatFileRecords(records, options.alphaCullThreshold);
+  }
+  return _decodePlyRecords(
+    ply,
+    ByteData.sublistView(records),
+    records.length ~/ layout.stride,
+    options.alphaCullThreshold,
+  );
+}
+
+/// Parses a compressed PLY ([SplatFormat.compressedPly]), dequantizing
+/// every splat into float arrays.
 ///
-/// The 3D covariance is precomputed here (`M = R * S`, `Sigma = M * Mt`) so
-/// the vertex shader fetches six floats instead of rebuilding it from the
-/// quaternion and scales per vertex.
-PackedSplats packSplats(SplatData data) {
+/// Reads the `chunk` element's ranges (its color ranges are optional and
+/// default to [0, 1]), the `vertex` element's four packed words, and the
+/// optional `sh` element's 8-bit rest coefficients, then applies the alpha
+/// cull and SH truncation as [parseSplatPly] does.
+SplatData parseCompressedSplatPly(
+  Uint8List bytes, {
+  SplatDecodeOptions options = const SplatDecodeOptions(),
+}) {
+  return _CompressedPly.parse(
+    bytes,
+  ).decode(options.alphaCullThreshold, options.maxShDegree);
+}
+
+/// Encodes [data] as a training-layout PLY ([SplatFormat.ply]), the
+/// inverse of [parseSplatPly] up to float rounding.
+///
+/// Records are written in [data]'s order; write
+/// [SplatData.orderedByImportance] to get a file that streams coarse to
+/// fine.
+Uint8List encodeSplatPly(SplatData data) {
+  final count = data.count;
+  final rest = SplatData.shRestCoeffCount(data.shDegree);
+  final properties = [
+    'x',
+    'y',
+    'z',
+    'f_dc_0',
+    'f_dc_1',
+    'f_dc_2',
+    for (var k = 0; k < rest * 3; k++) 'f_rest_$k',
+    'opacity',
+    'scale_0',
+    'scale_1',
+    'scale_2',
+    'rot_0',
+    'rot_1',
+    'rot_2',
+    'rot_3',
+  ];
+  final header = StringBuffer()
+    ..write('ply\n')
+    ..write('format binary_little_endian 1.0\n')
+    ..write('element vertex $count\n');
+  for (final name in properties) {
+    header.write('property float $name\n');
+  }
+  header.write('end_header\n');
+
+  final headerBytes = header.toString().codeUnits;
+  final stride = properties.length * 4;
+  final out = Uint8List(headerBytes.length + count * stride);
+  out.setAll(0, headerBytes);
+  final view = ByteData.sublistView(out, headerBytes.length);
+  final sh = data.sh;
+  var o = 0;
+  void put(double value) {
+    view.setFloat32(o, value, Endian.little);
+    o += 4;
+  }
+
+  for (var i = 0; i < count; i++) {
+    final p = i * 3, q = i * 4;
+    put(data.positions[p]);
+    put(data.positions[p + 1]);
+    put(data.positions[p + 2]);
+    for (var ch = 0; ch < 3; ch++) {
+      put((data.colors[p + ch] - 0.5) / kShC0);
+    }
+    // Channel-major, as parseSplatPly reads it.
+    for (var ch = 0; ch < 3; ch++) {
+      for (var k = 0; k < rest; k++) {
+        put(sh![(i * rest + k) * 3 + ch]);
+      }
+    }
+    final opacity = data.opacities[i].clamp(1e-6, 1 - 1e-6);
+    put(math.log(opacity / (1 - opacity)));
+    put(_logScale(data.scales[p]));
+    put(_logScale(data.scales[p + 1]));
+    put(_logScale(data.scales[p + 2]));
+    put(data.rotations[q + 3]);
+    put(data.rotations[q]);
+    put(data.rotations[q + 1]);
+    put(data.rotations[q + 2]);
+  }
+  return out;
+}
+
+/// Encodes [data] as a compressed PLY ([SplatFormat.compressedPly]), about
+/// a quarter the size of a training PLY. The records are exactly the
+/// [SplatPacking.compact] texels, so loading the file compact copies them
+/// straight through. Rest SH uses the format's fixed 8-bit range.
+Uint8List encodeCompressedSplatPly(SplatData data) {
   final count = data.count;
-  final paramsWidth = _textureWidthFor(count * kParamsTexelsPerSplat);
-  final paramsHeight = math.max(
-    1,
-    ((count * kParamsTexelsPerSplat) / paramsWidth).ceil(),
+  final packed = _packSplatsCompact(data);
+  final chunks = packed.chunkTexels!;
+  final chunkCount = (count + kSplatChunkSize - 1) ~/ kSplatChunkSize;
+  final coeffs = SplatData.shRestCoeffCount(data.shDegree);
+  final header = StringBuffer()
+    ..write('ply\n')
+    ..write('format binary_little_endian 1.0\n')
+    ..write('comment flutter_scene compressed splats\n')
+    ..write('element chunk $chunkCount\n');
+  for (final name in _kCompressedPlyChunkProperties) {
+    header.write('property float $name\n');
+  }
+  header
+    ..write('element vertex $count\n')
+    ..write('property uint packed_position\n')
+    ..write('property uint packed_rotation\n')
+    ..write('property uint packed_scale\n')
+    ..write('property uint packed_color\n');
+  if (coeffs > 0) {
+    header.write('element sh $count\n');
+    for (var k = 0; k < coeffs * 3; k++) {
+      header.write('property uchar f_rest_$k\n');
+    }
+  }
+  header.write('end_header\n');
+
+  final headerBytes = header.toString().codeUnits;
+  final chunkBytes = chunkCount * _kCompressedPlyChunkProperties.length * 4;
+  final out = Uint8List(
+    headerBytes.length + chunkBytes + count * 16 + count * coeffs * 3,
   );
-  _checkTextureHeight(paramsHeight, 'parameter');
-  final params = Float32List(paramsWidth * paramsHeight * 4);
+  out.setAll(0, headerBytes);
+  var offset = headerBytes.length;
+  final view = ByteData.sublistView(out);
+  for (var c = 0; c < chunkCount; c++) {
+    final base = c * kSplatChunkTexels * 4;
+    for (final texel in _kCompressedPlyChunkTexelOffsets) {
+      view.setFloat32(offset, chunks[base + texel], Endian.little);
+      offset += 4;
+    }
+  }
+  out.setRange(offset, offset + count * 16, packed.paramsTexels as Uint8List);
+  offset += count * 16;
+
+  // Channel-major per splat, as the training PLY orders f_rest.
+  final sh = data.sh;
+  if (sh != null) {
+    for (var i = 0; i < count; i++) {
+      final src = i * coeffs * 3;
+      for (var ch = 0; ch < 3; ch++) {
+        for (var k = 0; k < coeffs; k++) {
+          out[offset++] = _unorm(
+            sh[src + k * 3 + ch],
+            -_kCompressedPlyShRange,
+            _kCompressedPlyShRange,
+            255,
+          );
+        }
+      }
+    }
+  }
+  return out;
+}
+
+/// Decodes a compressed PLY straight into the compact layout, copying the
+/// packed records rather than re-quantizing. Every splat is kept, since
+/// culling would shift later splats out of their chunks.
+PackedSplats _decodeCompressedPlyCompact(
+  Uint8List bytes,
+  SplatDecodeOptions options,
+) {
+  final ply = _CompressedPly.parse(bytes);
+  final data = ply.decode(0, options.maxShDegree);
+  final texels = _CompactTexels(data.count, data.shDegree);
+  ply.copyTo(texels);
+  return texels.toPacked(data);
+}
+
+/// The located elements of a compressed PLY.
+class _CompressedPly {
+  _CompressedPly._({
+    required this.bytes,
+    required this.count,
+    required this.chunks,
+    required this.vertexStart,
+    required this.vertexStride,
+    required this.wordOffsets,
+    required this.shStart,
+    required this.shStride,
+    required this.shOffsets,
+    required this.fileShDegree,
+  });
+
+  factory _CompressedPly.parse(Uint8List bytes) {
+    final (:elements, :dataOffset) = _parsePlyElements(bytes);
+    final starts = <String, int>{};
+    var offset = dataOffset;
+    for (final element in elements) {
+      starts[element.name] = offset;
+      offset += element.count * element.stride;
+    }
+    if (offset > bytes.length) {
+      throw FormatException('Compressed splat PLY is truncated.');
+    }
+    _PlyElement? find(String name) {
+      for (final element in elements) {
+        if (element.name == name) return element;
+      }
+      return null;
+    }
+
+    final chunk = find('chunk');
+    final vertex = find('vertex');
+    if (chunk == null || vertex == null) {
+      throw FormatException(
+        'Compressed splat PLY is missing its chunk or vertex element.',
+      );
+    }
+    final count = vertex.count;
+    final chunkCount = (count + kSplatChunkSize - 1) ~/ kSplatChunkSize;
+    if (chunk.count < chunkCount) {
+      throw FormatException(
+        'Compressed splat PLY has ${chunk.count} chunks for $count splats.',
+      );
+    }
+
+    // The ranges, already in the compact chunk texel layout.
+    final view = ByteData.sublistView(bytes);
+    final chunks = Float32List(chunkCount * kSplatChunkTexels * 4);
+    for (var k = 0; k < _kCompressedPlyChunkProperties.length; k++) {
+      final name = _kCompressedPlyChunkProperties[k];
+      final property = chunk.properties[name];
+      // The color ranges (the last six) are optional; writers before they
+      // existed stored unit-range color.
+      final fallback = name.startsWith('max_') ? 1.0 : 0.0;
+      if (property == null && k < 12) {
+        throw FormatException('Compressed splat PLY is missing "$name".');
+      }
+      if (property != null && !_isFloat(property.type)) {
+        throw FormatException('Compressed splat PLY "$name" is not a float.');
+      }
+      final texel = _kCompressedPlyChunkTexelOffsets[k];
+      for (var c = 0; c < chunkCount; c++) {
+        chunks[c * kSplatChunkTexels * 4 + texel] = property == null
+            ? fallback
+            : view.getFloat32(
+                starts['chunk']! + c * chunk.stride + property.offset,
+                Endian.little,
+              );
+      }
+    }
+    for (var c = 0; c < chunkCount; c++) {
+      final base = c * kSplatChunkTexels * 4;
+      chunks[base + _kChunkShMin] = -_kCompressedPlyShRange;
+      chunks[base + _kChunkShMax] = _kCompressedPlyShRange;
+    }
+
+    final wordOffsets = [
+      for (final name in const [
+        'packed_position',
+        'packed_rotation',
+        'packed_scale',
+        'packed_color',
+      ])
+        switch (vertex.properties[name]) {
+          (:final offset, type: 'uint' || 'uint32') => offset,
+          _ => throw FormatException(
+            'Compressed splat PLY is missing uint "$name".',
+          ),
+        },
+    ];
+
+    final sh = find('sh');
+    final shOffsets = <int>[];
+    if (sh != null) {
+      if (sh.count != count) {
+        throw FormatException(
+          'Compressed splat PLY has ${sh.count} SH records for $count splats.',
+        );
+      }
+      for (var k = 0; ; k++) {
+        final property = sh.properties['f_rest_$k'];
+        if (property == null) break;
+        if (property.type != 'uchar' && property.type != 'uint8') {
+          throw FormatException('Compressed splat PLY SH is not 8-bit.');
+        }
+        shOffsets.add(property.offset);
+      }
+    }
+    final fileShDegree = switch (shOffsets.length ~/ 3) {
+      0 => 0,
+      3 => 1,
+      8 => 2,
+      15 => 3,
+      _ => throw FormatException(
+        'Compressed splat PLY has an unexpected f_rest count '
+        '(${shOffsets.length}).',
+      ),
+    };
+
+    return _CompressedPly._(
+      bytes: bytes,
+      count: count,
+      chunks: chunks,
+      vertexStart: starts['vertex']!,
+      vertexStride: vertex.stride,
+      wordOffsets: wordOffsets,
+      shStart: starts['sh'] ?? 0,
+      shStride: sh?.stride ?? 0,
+      shOffsets: shOffsets,
+      fileShDegree: fileShDegree,
+    );
+  }
+
+  final Uint8List bytes;
+  final int count;
+
+  /// The chunk ranges in the compact chunk texel layout.
+  final Float32List chunks;
+
+  final int vertexStart;
+  final int vertexStride;
+
+  /// Record offsets of the position, rotation, scale, and color words.
+  final List<int> wordOffsets;
+
+  final int shStart;
+  final int shStride;
+
+  /// Record offsets of `f_rest_0` onward (channel-major).
+  final List<int> shOffsets;
+  final int fileShDegree;
+
+  /// Dequantizes the splats with opacity of at least [alphaCullThreshold],
+  /// keeping SH up to [maxShDegree].
+  SplatData decode(double alphaCullThreshold, int maxShDegree) {
+    final degree = math.min(math.min(fileShDegree, maxShDegree), 2);
+    final keptRest = SplatData.shRestCoeffCount(degree);
+    final restPerChannel = shOffsets.length ~/ 3;
+    final view = ByteData.sublistView(bytes);
+    final colorOffset = wordOffsets[3];
+
+    // The opacity is the color word's low byte, first in little-endian.
+    var kept = 0;
+    for (var i = 0; i < count; i++) {
+      final alpha = bytes[vertexStart + i * vertexStride + colorOffset] / 255;
+      if (alpha >= alphaCullThreshold) kept++;
+    }
+
+    final out = SplatData.zeroed(kept, shDegree: degree);
+    final sh = out.sh;
+    final positions = out.positions;
+    final scales = out.scales;
+    final colors = out.colors;
+    var w = 0;
+    for (var i = 0; i < count; i++) {
+      final base = vertexStart + i * vertexStride;
+      final color = view.getUint32(base + colorOffset, Endian.little);
+      final opacity = (color & 0xff) / 255;
+      if (opacity < alphaCullThreshold) continue;
+      final r = (i ~/ kSplatChunkSize) * kSplatChunkTexels * 4;
+      final p = w * 3;
+
+      _unpack111011(
+        view.getUint32(base + wordOffsets[0], Endian.little),
+        chunks,
+        r + _kChunkPosMin,
+        r + _kChunkPosMax,
+        positions,
+        p,
+      );
+      _unpack111011(
+        view.getUint32(base + wordOffsets[2], Endian.little),
+        chunks,
+        r + _kChunkScaleMin,
+        r + _kChunkScaleMax,
+        scales,
+        p,
+      );
+      scales[p] = math.exp(scales[p]);
+      scales[p + 1] = math.exp(scales[p + 1]);
+      scales[p + 2] = math.exp(scales[p + 2]);
+      _unpackRotation(
+        view.getUint32(base + wordOffsets[1], Endian.little),
+        out.rotations,
+        w * 4,
+      );
+      final lo = r + _kChunkColorMin;
+      final hi = r + _kChunkColorMax;
+      colors[p] = _fromUnorm(color >>> 24, chunks[lo], chunks[hi], 255);
+      colors[p + 1] = _fromUnorm(
+        (color >>> 16) & 0xff,
+        chunks[lo + 1],
+        chunks[hi + 1],
+        255,
+      );
+      colors[p + 2] = _fromUnorm(
+        (color >>> 8) & 0xff,
+        chunks[lo + 2],
+        chunks[hi + 2],
+        255,
+      );
+      out.opacities[w] = opacity;
+
+      if (sh != null) {
+        final src = shStart + i * shStride;
+        final dst = w * keptRest * 3;
+        for (var k = 0; k < keptRest; k++) {
+          for (var ch = 0; ch < 3; ch++) {
+            sh[dst + k * 3 + ch] = _fromUnorm(
+              bytes[src + shOffsets[ch * restPerChannel + k]],
+              -_kCompressedPlyShRange,
+              _kCompressedPlyShRange,
+              255,
+            );
+          }
+        }
+      }
+      w++;
+    }
+    return out;
+  }
+
+  /// Copies the packed records, ranges, and SH into the compact [texels]
+  /// (sized for every splat, at the SH degree [decode] kept).
+  void copyTo(_CompactTexels texels) {
+    final params = texels.params;
+    if (vertexStride == 16 &&
+        wordOffsets[0] == 0 &&
+        wordOffsets[1] == 4 &&
+        wordOffsets[2] == 8 &&
+        wordOffsets[3] == 12) {
+      params.setRange(0, count * 16, bytes, vertexStart);
+    } else {
+      for (var i = 0; i < count; i++) {
+        final base = vertexStart + i * vertexStride;
+        for (var k = 0; k < 4; k++) {
+          final o = i * 16 + k * 4;
+          params.setRange(o, o + 4, bytes, base + wordOffsets[k]);
+        }
+      }
+    }
+    texels.chunks.setRange(0, chunks.length, chunks);
+
+    final sh = texels.sh;
+    if (sh == null) return;
+    final keptRest = SplatData.shRestCoeffCount(texels.shDegree);
+    final restPerChannel = shOffsets.length ~/ 3;
+    for (var i = 0; i < count; i++) {
+      final src = shStart + i * shStride;
+      final dst = i * texels.shStride * 4;
+      for (var k = 0; k < keptRest; k++) {
+        for (var ch = 0; ch < 3; ch++) {
+          final from = src + shOffsets[ch * restPerChannel + k];
+          sh[dst + k * 4 + ch] = bytes[from];
+        }
+      }
+    }
+  }
+}
+
+/// Packs [data] into the texel arrays the splat shaders fetch, in the
+/// [packing] layout.
+///
+/// For [SplatPacking.full] the 3D covariance is precomputed here
+/// (`M = R * S`, `Sigma = M * Mt`) so the vertex shader fetches six floats
+/// instead of rebuilding it from the quaternion and scales per vertex.
+PackedSplats packSplats(
+  SplatData data, {
+  SplatPacking packing = SplatPacking.full,
+}) {
+  if (packing == SplatPacking.compact) return _packSplatsCompact(data);
+  final count = data.count;
+  final texels = _FullTexels(count, data.shDegree);
+  final params = texels.params;
 
   for (var i = 0; i < count; i++) {
     final p = i * 3, q = i * 4;
@@ -356,18 +1073,11 @@ PackedSplats packSplats(SplatData data) {
     // o+15 reserved.
   }
 
-  Float32List? shTexels;
-  var shWidth = 0, shHeight = 0, shStride = 0;
   final sh = data.sh;
-  if (sh != null && data.shDegree > 0) {
+  final shTexels = texels.sh;
+  if (sh != null && shTexels != null) {
     final coeffs = SplatData.shRestCoeffCount(data.shDegree);
-    // Pad the per-splat group to a power of two so groups never straddle a
-    // row of the power-of-two-wide texture.
-    shStride = coeffs <= 4 ? 4 : 8;
-    shWidth = _textureWidthFor(count * shStride);
-    shHeight = math.max(1, ((count * shStride) / shWidth).ceil());
-    _checkTextureHeight(shHeight, 'spherical-harmonics');
-    shTexels = Float32List(shWidth * shHeight * 4);
+    final shStride = texels.shStride;
     for (var i = 0; i < count; i++) {
       final src = i * coeffs * 3;
       final dst = i * shStride * 4;
@@ -379,26 +1089,460 @@ PackedSplats packSplats(SplatData data) {
     }
   }
 
-  return PackedSplats(
+  return texels.toPacked(data);
+}
+
+/// A zeroed [PackedSplats] with room for [capacity] splats at SH
+/// [shDegree], for a loader that packs batches separately and assembles
+/// them with [copyPackedSplats]. Its [PackedSplats.data] is zeroed too.
+PackedSplats allocatePackedSplats(
+  int capacity, {
+  int shDegree = 0,
+  SplatPacking packing = SplatPacking.full,
+}) {
+  final data = SplatData.zeroed(capacity, shDegree: shDegree);
+  return switch (packing) {
+    SplatPacking.full => _FullTexels(capacity, shDegree).toPacked(data),
+    SplatPacking.compact => _CompactTexels(capacity, shDegree).toPacked(data),
+  };
+}
+
+/// Copies every splat of [batch] into [into] (see [allocatePackedSplats])
+/// starting at splat [at], arrays and texels alike.
+///
+/// Both must share a packing and SH degree. A compact batch is quantized
+/// within its own chunks, so [at] must then fall on a chunk boundary (a
+/// multiple of [kSplatChunkSize]).
+void copyPackedSplats(PackedSplats batch, PackedSplats into, int at) {
+  final src = batch.data, dst = into.data;
+  final count = src.count;
+  assert(batch.packing == into.packing && src.shDegree == dst.shDegree);
+  assert(at + count <= dst.count);
+  dst.positions.setRange(at * 3, (at + count) * 3, src.positions);
+  dst.scales.setRange(at * 3, (at + count) * 3, src.scales);
+  dst.rotations.setRange(at * 4, (at + count) * 4, src.rotations);
+  dst.colors.setRange(at * 3, (at + count) * 3, src.colors);
+  dst.opacities.setRange(at, at + count, src.opacities);
+  final coeffs = SplatData.shRestCoeffCount(src.shDegree) * 3;
+  if (coeffs > 0) {
+    dst.sh!.setRange(at * coeffs, (at + count) * coeffs, src.sh!);
+  }
+
+  // Texels are addressed linearly by splat index, so each array's batch
+  // prefix lands at the same offset whatever the two textures' widths.
+  void copy(TypedData? from, TypedData? to, int elementsPerSplat) {
+    if (from == null || to == null) return;
+    final size = from.elementSizeInBytes * elementsPerSplat;
+    Uint8List.sublistView(
+      to,
+    ).setRange(at * size, (at + count) * size, Uint8List.sublistView(from));
+  }
+
+  copy(batch.paramsTexels, into.paramsTexels, kParamsTexelsPerSplat * 4);
+  copy(batch.shTexels, into.shTexels, batch.shStride * 4);
+  final chunks = batch.chunkTexels;
+  if (chunks != null) {
+    assert(at % kSplatChunkSize == 0);
+    const perChunk = kSplatChunkTexels * 4;
+    final first = at ~/ kSplatChunkSize * perChunk;
+    final length = (count + kSplatChunkSize - 1) ~/ kSplatChunkSize * perChunk;
+    into.chunkTexels!.setRange(first, first + length, chunks);
+  }
+}
+
+/// The rest-SH range of the compressed PLY's fixed 8-bit encoding
+/// (`(byte + 0.5) / 256` mapped onto [-4, 4], an affine map equal to unorm
+/// over +/- this bound).
+const double _kCompressedPlyShRange = 3.984375;
+
+// Float offsets of the ranges within a chunk's compact texels.
+const int _kChunkPosMin = 0;
+const int _kChunkShMin = 3;
+const int _kChunkPosMax = 4;
+const int _kChunkShMax = 7;
+const int _kChunkScaleMin = 8;
+const int _kChunkScaleMax = 12;
+const int _kChunkColorMin = 16;
+const int _kChunkColorMax = 20;
+
+// The compressed PLY's chunk properties, in the order its writers emit.
+const List<String> _kCompressedPlyChunkProperties = [
+  'min_x', 'min_y', 'min_z', 'max_x', 'max_y', 'max_z', //
+  'min_scale_x', 'min_scale_y', 'min_scale_z', //
+  'max_scale_x', 'max_scale_y', 'max_scale_z', //
+  'min_r', 'min_g', 'min_b', 'max_r', 'max_g', 'max_b', //
+];
+
+// Where each chunk property lands in the compact chunk texels.
+const List<int> _kCompressedPlyChunkTexelOffsets = [
+  _kChunkPosMin, _kChunkPosMin + 1, _kChunkPosMin + 2, //
+  _kChunkPosMax, _kChunkPosMax + 1, _kChunkPosMax + 2, //
+  _kChunkScaleMin, _kChunkScaleMin + 1, _kChunkScaleMin + 2, //
+  _kChunkScaleMax, _kChunkScaleMax + 1, _kChunkScaleMax + 2, //
+  _kChunkColorMin, _kChunkColorMin + 1, _kChunkColorMin + 2, //
+  _kChunkColorMax, _kChunkColorMax + 1, _kChunkColorMax + 2, //
+];
+
+/// The full-precision texel arrays for [count] splats at SH [shDegree],
+/// zeroed.
+class _FullTexels {
+  _FullTexels(this.count, int shDegree)
+    : paramsWidth = _textureWidthFor(count * kParamsTexelsPerSplat),
+      // Pad the per-splat group to a power of two so groups never straddle
+      // a row of the power-of-two-wide texture.
+      shStride = shDegree == 0 ? 0 : (shDegree == 1 ? 4 : 8) {
+    paramsHeight = math.max(
+      1,
+      ((count * kParamsTexelsPerSplat) / paramsWidth).ceil(),
+    );
+    _checkTextureHeight(paramsHeight, 'parameter');
+    params = Float32List(paramsWidth * paramsHeight * 4);
+
+    if (shStride > 0) {
+      shWidth = _textureWidthFor(count * shStride);
+      shHeight = math.max(1, ((count * shStride) / shWidth).ceil());
+      _checkTextureHeight(shHeight, 'spherical-harmonics');
+      sh = Float32List(shWidth * shHeight * 4);
+    }
+  }
+
+  final int count;
+  final int paramsWidth;
+  late final int paramsHeight;
+  late final Float32List params;
+  final int shStride;
+  int shWidth = 0;
+  int shHeight = 0;
+  Float32List? sh;
+
+  PackedSplats toPacked(SplatData data) => PackedSplats(
+    data: data,
+    paramsTexels: params,
+    paramsWidth: paramsWidth,
+    paramsHeight: paramsHeight,
+    shTexels: sh,
+    shWidth: shWidth,
+    shHeight: shHeight,
+    shStride: shStride,
+  );
+}
+
+/// The compact texel arrays for [count] splats at SH [shDegree], zeroed.
+class _CompactTexels {
+  _CompactTexels(this.count, this.shDegree)
+    : chunkCount = (count + kSplatChunkSize - 1) ~/ kSplatChunkSize,
+      paramsWidth = _textureWidthFor(count * kParamsTexelsPerSplat),
+      shStride = shDegree == 0 ? 0 : (shDegree == 1 ? 4 : 8) {
+    paramsHeight = math.max(
+      1,
+      ((count * kParamsTexelsPerSplat) / paramsWidth).ceil(),
+    );
+    _checkTextureHeight(paramsHeight, 'parameter');
+    params = Uint8List(paramsWidth * paramsHeight * 4);
+
+    chunkWidth = _textureWidthFor(chunkCount * kSplatChunkTexels);
+    chunkHeight = math.max(
+      1,
+      ((chunkCount * kSplatChunkTexels) / chunkWidth).ceil(),
+    );
+    _checkTextureHeight(chunkHeight, 'chunk');
+    chunks = Float32List(chunkWidth * chunkHeight * 4);
+
+    if (shStride > 0) {
+      shWidth = _textureWidthFor(count * shStride);
+      shHeight = math.max(1, ((count * shStride) / shWidth).ceil());
+      _checkTextureHeight(shHeight, 'spherical-harmonics');
+      sh = Uint8List(shWidth * shHeight * 4);
+    }
+  }
+
+  final int count;
+  final int shDegree;
+  final int chunkCount;
+  final int paramsWidth;
+  late final int paramsHeight;
+  late final Uint8List params;
+  late final int chunkWidth;
+  late final int chunkHeight;
+  late final Float32List chunks;
+  final int shStride;
+  int shWidth = 0;
+  int shHeight = 0;
+  Uint8List? sh;
+
+  PackedSplats toPacked(SplatData data) => PackedSplats(
     data: data,
+    packing: SplatPacking.compact,
     paramsTexels: params,
     paramsWidth: paramsWidth,
     paramsHeight: paramsHeight,
-    shTexels: shTexels,
+    shTexels: sh,
     shWidth: shWidth,
     shHeight: shHeight,
     shStride: shStride,
+    chunkTexels: chunks,
+    chunkWidth: chunkWidth,
+    chunkHeight: chunkHeight,
   );
 }
 
-/// Sniffs [bytes] for a PLY magic, falling back to [fallback].
+// Scratch for the quaternion in the compressed PLY's component order.
+final Float64List _wxyz = Float64List(4);
+
+/// Packs [data] into the compact layout (see [SplatPacking.compact]).
+PackedSplats _packSplatsCompact(SplatData data) {
+  final count = data.count;
+  final texels = _CompactTexels(count, data.shDegree);
+  final words = ByteData.sublistView(texels.params);
+  final chunks = texels.chunks;
+  final sh = data.sh;
+  final shTexels = texels.sh;
+  final coeffs = SplatData.shRestCoeffCount(data.shDegree);
+  final positions = data.positions;
+  final scales = data.scales;
+  final colors = data.colors;
+  final rotations = data.rotations;
+
+  for (var c = 0; c < texels.chunkCount; c++) {
+    final start = c * kSplatChunkSize;
+    final end = math.min(count, start + kSplatChunkSize);
+    final r = c * kSplatChunkTexels * 4;
+    _measureChunk(data, start, end, chunks, r);
+    final shMin = chunks[r + _kChunkShMin];
+    final shMax = chunks[r + _kChunkShMax];
+
+    for (var i = start; i < end; i++) {
+      final p = i * 3;
+      final o = i * 16;
+      words.setUint32(
+        o,
+        _pack111011(
+          positions[p],
+          positions[p + 1],
+          positions[p + 2],
+          chunks,
+          r + _kChunkPosMin,
+          r + _kChunkPosMax,
+        ),
+        Endian.little,
+      );
+      final q = i * 4;
+      words.setUint32(
+        o + 4,
+        _packRotation(
+          rotations[q],
+          rotations[q + 1],
+          rotations[q + 2],
+          rotations[q + 3],
+        ),
+        Endian.little,
+      );
+      words.setUint32(
+        o + 8,
+        _pack111011(
+          _logScale(scales[p]),
+          _logScale(scales[p + 1]),
+          _logScale(scales[p + 2]),
+          chunks,
+          r + _kChunkScaleMin,
+          r + _kChunkScaleMax,
+        ),
+        Endian.little,
+      );
+      final lo = r + _kChunkColorMin;
+      final hi = r + _kChunkColorMax;
+      final red = _unorm(colors[p], chunks[lo], chunks[hi], 255);
+      final green = _unorm(colors[p + 1], chunks[lo + 1], chunks[hi + 1], 255);
+      final blue = _unorm(colors[p + 2], chunks[lo + 2], chunks[hi + 2], 255);
+      final alpha = _unorm(data.opacities[i], 0, 1, 255);
+      words.setUint32(
+        o + 12,
+        (red << 24) | (green << 16) | (blue << 8) | alpha,
+        Endian.little,
+      );
+
+      if (sh != null && shTexels != null) {
+        final src = i * coeffs * 3;
+        final dst = i * texels.shStride * 4;
+        for (var k = 0; k < coeffs; k++) {
+          for (var ch = 0; ch < 3; ch++) {
+            shTexels[dst + k * 4 + ch] = _unorm(
+              sh[src + k * 3 + ch],
+              shMin,
+              shMax,
+              255,
+            );
+          }
+        }
+      }
+    }
+  }
+  return texels.toPacked(data);
+}
+
+// Writes the ranges of splats [start]..[end] into the chunk texels at
+// [offset].
+void _measureChunk(
+  SplatData data,
+  int start,
+  int end,
+  Float32List chunks,
+  int offset,
+) {
+  for (var axis = 0; axis < 3; axis++) {
+    var posMin = double.infinity, posMax = double.negativeInfinity;
+    var scaleMin = double.infinity, scaleMax = double.negativeInfinity;
+    var colorMin = double.infinity, colorMax = double.negativeInfinity;
+    for (var i = start; i < end; i++) {
+      final p = i * 3 + axis;
+      final pos = data.positions[p];
+      if (pos < posMin) posMin = pos;
+      if (pos > posMax) posMax = pos;
+      final scale = _logScale(data.scales[p]);
+      if (scale < scaleMin) scaleMin = scale;
+      if (scale > scaleMax) scaleMax = scale;
+      final color = data.colors[p];
+      if (color < colorMin) colorMin = color;
+      if (color > colorMax) colorMax = color;
+    }
+    chunks[offset + _kChunkPosMin + axis] = posMin;
+    chunks[offset + _kChunkPosMax + axis] = posMax;
+    chunks[offset + _kChunkScaleMin + axis] = scaleMin;
+    chunks[offset + _kChunkScaleMax + axis] = scaleMax;
+    chunks[offset + _kChunkColorMin + axis] = colorMin;
+    chunks[offset + _kChunkColorMax + axis] = colorMax;
+  }
+  final sh = data.sh;
+  var shMin = 0.0, shMax = 0.0;
+  if (sh != null) {
+    final perSplat = SplatData.shRestCoeffCount(data.shDegree) * 3;
+    shMin = double.infinity;
+    shMax = double.negativeInfinity;
+    for (var k = start * perSplat; k < end * perSplat; k++) {
+      final v = sh[k];
+      if (v < shMin) shMin = v;
+      if (v > shMax) shMax = v;
+    }
+  }
+  chunks[offset + _kChunkShMin] = shMin;
+  chunks[offset + _kChunkShMax] = shMax;
+}
+
+double _logScale(double scale) => math.log(math.max(scale, 1e-30));
+
+/// [value] as an integer in 0..[max] across [lo]..[hi], rounded. A
+/// degenerate range maps to 0.
+int _unorm(double value, double lo, double hi, int max) {
+  final t = (value - lo) / (hi - lo);
+  if (!(t > 0)) return 0;
+  if (t >= 1) return max;
+  return (t * max + 0.5).toInt();
+}
+
+/// The inverse of [_unorm].
+double _fromUnorm(int value, double lo, double hi, int max) =>
+    lo + (hi - lo) * (value / max);
+
+// Packs x, y, z (11, 10, 11 bits, x highest) within the ranges at
+// [ranges] offsets [lo] and [hi].
+int _pack111011(
+  double x,
+  double y,
+  double z,
+  Float32List ranges,
+  int lo,
+  int hi,
+) =>
+    (_unorm(x, ranges[lo], ranges[hi], 2047) << 21) |
+    (_unorm(y, ranges[lo + 1], ranges[hi + 1], 1023) << 11) |
+    _unorm(z, ranges[lo + 2], ranges[hi + 2], 2047);
+
+// Packs a unit quaternion (x, y, z, w) as the compressed PLY's smallest
+// three: the largest component's index in w, x, y, z order in the top two
+// bits, then the other three, negated so the largest is positive, 10 bits
+// each over +/- 1/sqrt(2).
+int _packRotation(double x, double y, double z, double w) {
+  final q = _wxyz
+    ..[0] = w
+    ..[1] = x
+    ..[2] = y
+    ..[3] = z;
+  var largest = 0;
+  for (var k = 1; k < 4; k++) {
+    if (q[k].abs() > q[largest].abs()) largest = k;
+  }
+  final sign = q[largest] < 0 ? -1.0 : 1.0;
+  var packed = largest;
+  for (var k = 0; k < 4; k++) {
+    if (k == largest) continue;
+    packed =
+        (packed << 10) | _unorm(q[k] * sign, -math.sqrt1_2, math.sqrt1_2, 1023);
+  }
+  return packed;
+}
+
+// Unpacks an 11/10/11 word (x highest) within the [ranges] at offsets [lo]
+// and [hi] into [out] at [o].
+void _unpack111011(
+  int word,
+  Float32List ranges,
+  int lo,
+  int hi,
+  Float32List out,
+  int o,
+) {
+  out[o] = _fromUnorm(word >>> 21, ranges[lo], ranges[hi], 2047);
+  out[o + 1] = _fromUnorm(
+    (word >>> 11) & 0x3ff,
+    ranges[lo + 1],
+    ranges[hi + 1],
+    1023,
+  );
+  out[o + 2] = _fromUnorm(word & 0x7ff, ranges[lo + 2], ranges[hi + 2], 2047);
+}
+
+// Unpacks a [_packRotation] word into [out] at [o] as x, y, z, w.
+void _unpackRotation(int word, Float32List out, int o) {
+  final q = _wxyz;
+  final largest = word >>> 30;
+  var shift = 20;
+  var sum = 0.0;
+  for (var k = 0; k < 4; k++) {
+    if (k == largest) continue;
+    final v = _fromUnorm(
+      (word >>> shift) & 0x3ff,
+      -math.sqrt1_2,
+      math.sqrt1_2,
+      1023,
+    );
+    q[k] = v;
+    sum += v * v;
+    shift -= 10;
+  }
+  q[largest] = math.sqrt(math.max(0.0, 1 - sum));
+  out[o] = q[1];
+  out[o + 1] = q[2];
+  out[o + 2] = q[3];
+  out[o + 3] = q[0];
+}
+
+/// Sniffs [bytes] for a PLY magic (telling a compressed PLY by its packed
+/// vertex properties), falling back to [fallback].
 SplatFormat sniffSplatFormat(Uint8List bytes, {SplatFormat? fallback}) {
   if (bytes.length >= 4 &&
       bytes[0] == 0x70 && // p
       bytes[1] == 0x6C && // l
       bytes[2] == 0x79 && // y
       (bytes[3] == 0x0A || bytes[3] == 0x0D)) {
-    return SplatFormat.ply;
+    final headerEnd = _indexOfSequence(bytes, 'end_header'.codeUnits);
+    final header = String.fromCharCodes(
+      bytes,
+      0,
+      headerEnd < 0 ? math.min(bytes.length, 4096) : headerEnd,
+    );
+    return header.contains('packed_position')
+        ? SplatFormat.compressedPly
+        : SplatFormat.ply;
   }
   return fallback ?? SplatFormat.splat;
 }
@@ -426,6 +1570,103 @@ void _checkTextureHeight(int height, String label) {
   }
 }
 
+// The byte size of each PLY scalar type.
+const Map<String, int> _kPlyTypeSizes = {
+  'float': 4,
+  'float32': 4,
+  'double': 8,
+  'float64': 8,
+  'char': 1,
+  'int8': 1,
+  'uchar': 1,
+  'uint8': 1,
+  'short': 2,
+  'int16': 2,
+  'ushort': 2,
+  'uint16': 2,
+  'int': 4,
+  'int32': 4,
+  'uint': 4,
+  'uint32': 4,
+};
+
+bool _isFloat(String type) => type == 'float' || type == 'float32';
+
+/// One element of a PLY header, with its record layout.
+class _PlyElement {
+  _PlyElement(this.name, this.count);
+
+  final String name;
+  final int count;
+
+  /// Bytes per record.
+  int stride = 0;
+
+  /// The byte offset and type of each property within a record.
+  final Map<String, ({int offset, String type})> properties = {};
+}
+
+/// Parses a binary little-endian PLY header into its elements, in file
+/// order (their records follow one another from `dataOffset`).
+({List<_PlyElement> elements, int dataOffset}) _parsePlyElements(
+  Uint8List bytes,
+) {
+  final headerEnd = _indexOfSequence(bytes, 'end_header\n'.codeUnits);
+  if (headerEnd < 0) {
+    throw FormatException('PLY header is missing end_header.');
+  }
+  final lines = String.fromCharCodes(
+    bytes,
+    0,
+    headerEnd,
+  ).split(RegExp(r'\r?\n'));
+  if (lines.isEmpty || lines.first.trim() != 'ply') {
+    throw FormatException('Not a PLY file.');
+  }
+
+  final elements = <_PlyElement>[];
+  var sawFormat = false;
+  for (final raw in lines.skip(1)) {
+    final line = raw.trim();
+    if (line.isEmpty || line.startsWith('comment')) continue;
+    final parts = line.split(RegExp(r'\s+'));
+    switch (parts[0]) {
+      case 'format':
+        if (parts.length < 2 || parts[1] != 'binary_little_endian') {
+          throw FormatException(
+            'Only binary little-endian splat PLYs are supported '
+            '(got "${parts.length > 1 ? parts[1] : ''}").',
+          );
+        }
+        sawFormat = true;
+      case 'element':
+        if (parts.length < 3) {
+          throw FormatException('Malformed PLY element "$line".');
+        }
+        elements.add(_PlyElement(parts[1], int.parse(parts[2])));
+      case 'property':
+        if (elements.isEmpty) continue;
+        if (parts[1] == 'list') {
+          throw FormatException('List properties are not supported.');
+        }
+        final size = _kPlyTypeSizes[parts[1]];
+        if (size == null) {
+          throw FormatException('Unknown PLY property type "${parts[1]}".');
+        }
+        final element = elements.last;
+        element.properties[parts[2]] = (
+          offset: element.stride,
+          type: parts[1],
+        );
+        element.stride += size;
+    }
+  }
+  if (!sawFormat) {
+    throw FormatException('PLY header is missing its format.');
+  }
+  return (elements: elements, dataOffset: headerEnd + 'end_header\n'.length);
+}
+
 class _PlyHeader {
   _PlyHeader({
     required this.vertexCount,
@@ -462,25 +1703,6 @@ _PlyHeader _parsePlyHeader(Uint8List bytes) {
   final properties = <String, int>{};
   var sawFormat = false;
 
-  const sizes = {
-    'float': 4,
-    'float32': 4,
-    'double': 8,
-    'float64': 8,
-    'char': 1,
-    'int8': 1,
-    'uchar': 1,
-    'uint8': 1,
-    'short': 2,
-    'int16': 2,
-    'ushort': 2,
-    'uint16': 2,
-    'int': 4,
-    'int32': 4,
-    'uint': 4,
-    'uint32': 4,
-  };
-
   for (final raw in lines.skip(1)) {
     final line = raw.trim();
     if (line.isEmpty || line.startsWith('comment')) continue;
@@ -508,11 +1730,11 @@ _PlyHeader _parsePlyHeader(Uint8List bytes) {
         if (parts[1] == 'list') {
           throw FormatException('List properties are not supported.');
         }
-        final size = sizes[parts[1]];
+        final size = _kPlyTypeSizes[parts[1]];
         if (size == null) {
           throw FormatException('Unknown PLY property type "${parts[1]}".');
         }
-        if (size == 4 && (parts[1] == 'float' || parts[1] == 'float32')) {
+        if (_isFloat(parts[1])) {
           properties[parts[2]] = stride;
         }
         stride += size;
@@ -529,8 +1751,14 @@ _PlyHeader _parsePlyHeader(Uint8List bytes) {
   );
 }
 
+// How far into a file the PLY header search looks.
+const int _kMaxPlyHeaderLength = 64 * 1024;
+
 int _indexOfSequence(Uint8List haystack, List<int> needle) {
-  final limit = math.min(haystack.length - needle.length, 64 * 1024);
+  final limit = math.min(
+    haystack.length - needle.length,
+    _kMaxPlyHeaderLength,
+  );
   outer:
   for (var i = 0; i <= limit; i++) {
     for (var j = 0; j < needle.length; j++) {
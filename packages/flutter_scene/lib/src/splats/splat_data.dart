@@ -103,6 +103,61 @@ class SplatData {
   /// [degree] 0, 3 at 1, 8 at 2.
   static int shRestCoeffCount(int degree) => (degree + 1) * (degree + 1) - 1;
 
+  /// Computes each splat's importance, its opacity times the mean face area
+  /// of its scale box (`(sx*sy + sy*sz + sz*sx) / 3`), a view-independent
+  /// proxy for how much it contributes to an image.
+  Float32List computeImportance() {
+    final importance = Float32List(count);
+    for (var i = 0; i < count; i++) {
+      final o = i * 3;
+      final sx = scales[o], sy = scales[o + 1], sz = scales[o + 2];
+      importance[i] = opacities[i] * (sx * sy + sy * sz + sz * sx) / 3;
+    }
+    return importance;
+  }
+
+  /// A copy with the splats reordered most important first (see
+  /// [computeImportance]).
+  ///
+  /// A file written in this order streams coarse to fine: any prefix of it
+  /// is the most important subset of its size, so a progressive load shows
+  /// the set's overall shape from the first records.
+  SplatData orderedByImportance() {
+    final importance = computeImportance();
+    final order = List<int>.generate(count, (i) => i)
+      ..sort((a, b) => importance[b].compareTo(importance[a]));
+    final out = SplatData.zeroed(count, shDegree: shDegree);
+    final coeffs = shRestCoeffCount(shDegree) * 3;
+    for (var w = 0; w < count; w++) {
+      final i = order[w];
+      out.positions.setRange(w * 3, w * 3 + 3, positions, i * 3);
+      out.scales.setRange(w * 3, w * 3 + 3, scales, i * 3);
+      out.rotations.setRange(w * 4, w * 4 + 4, rotations, i * 4);
+      out.colors.setRange(w * 3, w * 3 + 3, colors, i * 3);
+      out.opacities[w] = opacities[i];
+      if (coeffs > 0) {
+        out.sh!.setRange(w * coeffs, (w + 1) * coeffs, sh!, i * coeffs);
+      }
+    }
+    return out;
+  }
+
+  /// A view of the first [length] splats, sharing this set's arrays.
+  SplatData prefix(int length) {
+    assert(length >= 0 && length <= count);
+    final coeffs = shRestCoeffCount(shDegree) * 3;
+    return SplatData(
+      count: length,
+      positions: Float32List.sublistView(positions, 0, length * 3),
+      scales: Float32List.sublistView(scales, 0, length * 3),
+      rotations: Float32List.sublistView(rotations, 0, length * 4),
+      colors: Float32List.sublistView(colors, 0, length * 3),
+      opacities: Float32List.sublistView(opacities, 0, length),
+      sh: sh == null ? null : Float32List.sublistView(sh!, 0, length * coeffs),
+      shDegree: shDegree,
+    );
+  }
+
   /// Computes the axis-aligned bounds of the splat centers, each padded by
   /// [sigmaPadding] times the splat's largest axis scale so the visible
   /// footprint stays inside the box.
@@ -3,6 +3,7 @@ import 'dart:typed_data';
 import 'package:flutter_scene/src/splats/splat_sort_service_native.dart'
     if (dart.library.js_interop) 'package:flutter_scene/src/splats/splat_sort_service_web.dart'
     as impl;
+import 'package:flutter_scene/src/splats/splat_sorter.dart';
 
 /// A long-lived background sorter for one splat set.
 ///
@@ -11,20 +12,91 @@ import 'package:flutter_scene/src/splats/splat_sort_service_native.dart'
 /// `compute` would re-copy the whole positions array on the UI thread every
 /// time, a rhythmic stutter while orbiting a large set.
 ///
+/// On native platforms a large set is split across a pool of worker
+/// isolates: each computes keys and a depth histogram for its own slice in
+/// parallel, and the first merges the slices' bucket runs into the reply.
+/// The workers keep their working arrays between sorts, and a sort after a
+/// small rotation repairs the previous order instead of starting over
+/// ([IncrementalSplatSorter]).
+///
 /// The web has no isolates, so its fallback sorts synchronously on the main
 /// thread. TODO(splats): move the web path into a web worker.
 abstract interface class SplatSortService {
   /// Creates the platform sorter over [positions] (`x, y, z` per splat).
-  factory SplatSortService(Float32List positions, int count) =>
-      impl.createSplatSortService(positions, count);
+  ///
+  /// [workers] is the number of isolates to split the sort across; it
+  /// defaults to one per quarter-million splats, bounded by the spare
+  /// cores. Ignored on the web. [importance] (per splat) enables sorts
+  /// with a [SplatBudget].
+  factory SplatSortService(
+    Float32List positions,
+    int count, {
+    int? workers,
+    Float32List? importance,
+  }) => impl.createSplatSortService(
+    positions,
+    count,
+    workers: workers,
+    importance: importance,
+  );
 
   /// Resolves with the splat indices in back-to-front order along the given
   /// local-space view-depth direction (ready to upload as the instance
   /// stream), or null if the service was disposed first.
   ///
+  /// With a [budget] (which needs the service's importance), only the
+  /// splats [SplatBudgetFilter] keeps are returned.
+  ///
   /// Callers must not issue a new sort until the previous one resolves.
-  Future<Float32List?> sort(double dirX, double dirY, double dirZ);
+  Future<Float32List?> sort(
+    double dirX,
+    double dirY,
+    double dirZ, {
+    SplatBudget? budget,
+  });
 
   /// Shuts down the worker. In-flight sorts resolve null.
   void dispose();
 }
+
+/// Tracks how many splats a streaming set's sorters were built over, and
+/// decides when they are rebuilt.
+///
+/// A sorter copies the positions it covers when it is built, and the
+/// background one spawns its worker pool then too, so rebuilding for every
+/// streamed run would pay a pool spawn and a full position copy per run.
+/// While the set loads, the sorters are rebuilt only once it has doubled
+/// since they were built, and once more when it finishes; the splats that
+/// arrived in between draw after the sorted ones, in load order (or, under
+/// a splat budget, wait for the rebuild).
+class SplatSortCoverage {
+  /// The splat count the sorters were built over (0 before the first).
+  int get sortedCount => _sortedCount;
+  int _sortedCount = 0;
+
+  /// Whether the sorters were built to apply a splat budget.
+  bool get budgeted => _budgeted;
+  bool _budgeted = false;
+
+  /// How many times [stale] asked for a rebuild.
+  int get rebuilds => _rebuilds;
+  int _rebuilds = 0;
+
+  /// Records sorters built over [count] splats, carrying the importance
+  /// when [budgeted].
+  void built(int count, {required bool budgeted}) {
+    _sortedCount = count;
+    _budgeted = budgeted;
+  }
+
+  /// Whether sorters built over [sortedCount] must be rebuilt for a set
+  /// now holding [count] splats, still [loading] or not, that [budgeted]
+  /// says needs the importance or not. Counts a rebuild when it does.
+  bool stale(int count, {required bool loading, required bool budgeted}) {
+    if (count == _sortedCount && budgeted == _budgeted) return false;
+    final rebuild =
+        !loading || count >= _sortedCount * 2 || budgeted != _budgeted;
+    if (rebuild) _rebuilds++;
+    return rebuild;
+  }
+}
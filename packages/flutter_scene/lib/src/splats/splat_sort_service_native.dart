@@ -1,35 +1,87 @@
 import 'dart:async';
+import 'dart:io';
 import 'dart:isolate';
+import 'dart:math' as math;
 import 'dart:typed_data';
 
 import 'package:flutter_scene/src/splats/splat_sort_service.dart';
 import 'package:flutter_scene/src/splats/splat_sorter.dart';
 
 /// Creates the isolate-backed sorter.
-SplatSortService createSplatSortService(Float32List positions, int count) =>
-    _IsolateSplatSortService(positions, count);
+SplatSortService createSplatSortService(
+  Float32List positions,
+  int count, {
+  int? workers,
+  Float32List? importance,
+}) => _IsolateSplatSortService(
+  positions,
+  count,
+  workers ?? defaultSplatSortWorkers(count),
+  importance,
+);
+
+/// The fewest splats worth a worker of their own. Below this, the extra
+/// message round-trip costs more than the split saves.
+const int kMinSplatsPerSortWorker = 1 << 18;
+
+/// The worker count a sorter over [count] splats uses by default: one per
+/// [kMinSplatsPerSortWorker] splats, at most one per spare core and four.
+int defaultSplatSortWorkers(int count) {
+  final cores = math.max(1, Platform.numberOfProcessors - 1);
+  final wanted =
+      (count + kMinSplatsPerSortWorker - 1) ~/ kMinSplatsPerSortWorker;
+  return wanted.clamp(1, math.min(cores, 4));
+}
+
+// Worker message tags. A sort runs as: the service sends [_sort] to worker
+// 0 (the coordinator), which replies at once if it can repair its previous
+// order and otherwise forwards [_sort] to every other worker; each computes
+// its keys and sends its key range to the coordinator as [_range]; the
+// coordinator sends the global range back as [_bucket]; each worker buckets
+// its partition and sends it to the coordinator as [_partial]; the
+// coordinator merges and replies with the order, cut to the sort's budget
+// when it has one.
+const int _peers = 0;
+const int _sort = 1;
+const int _range = 2;
+const int _bucket = 3;
+const int _partial = 4;
 
 class _IsolateSplatSortService implements SplatSortService {
-  _IsolateSplatSortService(this._positions, this._count);
+  _IsolateSplatSortService(
+    this._positions,
+    this._count,
+    int workers,
+    this._importance,
+  ) : _workerCount = math.max(1, math.min(workers, _count));
 
   final Float32List _positions;
   final int _count;
+  final int _workerCount;
+  final Float32List? _importance;
 
   bool _disposed = false;
-  Future<SendPort>? _requests;
-  ReceivePort? _fromWorker;
+  Future<List<SendPort>>? _workers;
+  ReceivePort? _fromWorkers;
   Completer<Float32List?>? _pending;
 
-  // Spawns the worker on first use, transferring the positions in once
-  // rather than re-serializing them per sort.
-  Future<SendPort> _ensureWorker() {
-    return _requests ??= () async {
-      final fromWorker = ReceivePort();
-      _fromWorker = fromWorker;
-      final ready = Completer<SendPort>();
-      fromWorker.listen((message) {
-        if (!ready.isCompleted) {
-          ready.complete(message as SendPort);
+  // Spawns the workers on first use, transferring each its slice of the
+  // positions once rather than re-serializing them per sort. The
+  // coordinator gets every position (and the importance, if any), since it
+  // repairs and budgets the whole order.
+  Future<List<SendPort>> _ensureWorkers() {
+    return _workers ??= () async {
+      final fromWorkers = ReceivePort();
+      _fromWorkers = fromWorkers;
+      final ports = List<SendPort?>.filled(_workerCount, null);
+      var registered = 0;
+      final ready = Completer<List<SendPort>>();
+      fromWorkers.listen((message) {
+        if (message is List) {
+          ports[message[0] as int] = message[1] as SendPort;
+          if (++registered == _workerCount) {
+            ready.complete([for (final port in ports) port!]);
+          }
           return;
         }
         final pending = _pending;
@@ -38,24 +90,62 @@ class _IsolateSplatSortService implements SplatSortService {
           (message as TransferableTypedData).materialize().asFloat32List(),
         );
       });
-      await Isolate.spawn(splatSorterIsolateMain, <Object>[
-        fromWorker.sendPort,
-        TransferableTypedData.fromList([_positions]),
-        _count,
-      ], debugName: 'flutter_scene splat sorter');
-      return ready.future;
+      for (var w = 0; w < _workerCount; w++) {
+        final start = _count * w ~/ _workerCount;
+        final end = _count * (w + 1) ~/ _workerCount;
+        await Isolate.spawn(splatSorterIsolateMain, <Object>[
+          fromWorkers.sendPort,
+          TransferableTypedData.fromList([
+            if (w == 0)
+              Float32List.sublistView(_positions, 0, _count * 3)
+            else
+              Float32List.sublistView(_positions, start * 3, end * 3),
+          ]),
+          start,
+          end - start,
+          w,
+          _workerCount,
+          _count,
+          if (w == 0 && _importance != null)
+            TransferableTypedData.fromList([
+              Float32List.sublistView(_importance, 0, _count),
+            ]),
+        ], debugName: 'flutter_scene splat sorter $w');
+      }
+      final workers = await ready.future;
+      for (final worker in workers) {
+        worker.send(<Object>[_peers, workers]);
+      }
+      return workers;
     }();
   }
 
   @override
-  Future<Float32List?> sort(double dirX, double dirY, double dirZ) async {
+  Future<Float32List?> sort(
+    double dirX,
+    double dirY,
+    double dirZ, {
+    SplatBudget? budget,
+  }) async {
     if (_disposed) return null;
     assert(_pending == null, 'A sort is already in flight.');
-    final worker = await _ensureWorker();
+    assert(budget == null || _importance != null, 'No importance to budget.');
+    final workers = await _ensureWorkers();
     if (_disposed) return null;
     final pending = Completer<Float32List?>();
     _pending = pending;
-    worker.send(<double>[dirX, dirY, dirZ]);
+    workers.first.send(<Object>[
+      _sort,
+      dirX,
+      dirY,
+      dirZ,
+      if (budget != null) ...[
+        budget.count,
+        budget.eyeX,
+        budget.eyeY,
+        budget.eyeZ,
+      ],
+    ]);
     return pending.future;
   }
 
@@ -65,38 +155,170 @@ class _IsolateSplatSortService implements SplatSortService {
     _disposed = true;
     _pending?.complete(null);
     _pending = null;
-    // Ask the worker to exit once it is up (it may still be spawning).
-    _requests?.then((worker) {
-      worker.send(null);
-      _fromWorker?.close();
+    // Ask the workers to exit once they are up (they may still be
+    // spawning).
+    _workers?.then((workers) {
+      for (final worker in workers) {
+        worker.send(null);
+      }
+      _fromWorkers?.close();
     });
   }
 }
 
-/// The sorter isolate. Receives the positions once at spawn, then serves
-/// direction requests until a null message asks it to exit.
+/// One sorter isolate. Receives its slice of the positions once at spawn,
+/// then serves sort requests until a null message asks it to exit.
+///
+/// Worker 0 also coordinates. It first tries an [IncrementalSplatSorter]
+/// repair of the previous order, which suits a slowly orbiting camera;
+/// otherwise it gathers the key ranges, broadcasts the global range, and
+/// merges every partition into the reply, cut to the sort's [SplatBudget]
+/// by a [SplatBudgetFilter] when it carries one. Each worker's
+/// [SplatSortPartition] (and the coordinator's merge target) persists
+/// across sorts, so a steady re-sort allocates only the transfer buffers.
 void splatSorterIsolateMain(List<Object> init) {
   final replyTo = init[0] as SendPort;
   final positions = (init[1] as TransferableTypedData)
       .materialize()
       .asFloat32List();
-  final count = init[2] as int;
+  final start = init[2] as int;
+  final count = init[3] as int;
+  final index = init[4] as int;
+  final workerCount = init[5] as int;
+  final total = init[6] as int;
+  final partition = SplatSortPartition(positions, count: count, start: start);
+  final incremental = index == 0
+      ? IncrementalSplatSorter(positions, count: total)
+      : null;
+  final filter = init.length > 7
+      ? SplatBudgetFilter(
+          positions,
+          (init[7] as TransferableTypedData).materialize().asFloat32List(),
+          count: total,
+        )
+      : null;
 
   final requests = ReceivePort();
-  replyTo.send(requests.sendPort);
+  var peers = const <SendPort>[];
+
+  // Coordinator state, used by worker 0 only.
+  var ranges = 0;
+  var minKey = double.infinity;
+  var maxKey = double.negativeInfinity;
+  var partials = 0;
+  final histograms = List<Uint32List>.filled(workerCount, partition.histogram);
+  final orders = List<Float32List>.filled(workerCount, partition.order);
+  Float32List? merged;
+  var sortDir = const <double>[];
+  SplatBudget? budget;
+
+  void reply(Float32List order) {
+    final cut = budget;
+    if (cut != null && filter != null) {
+      final kept = filter.select(order, cut);
+      replyTo.send(
+        TransferableTypedData.fromList([
+          Float32List.sublistView(filter.selected, 0, kept),
+        ]),
+      );
+      return;
+    }
+    replyTo.send(TransferableTypedData.fromList([order]));
+  }
+
+  void receivePartial(int from, Uint32List histogram, Float32List order) {
+    histograms[from] = histogram;
+    orders[from] = order;
+    if (++partials < workerCount) return;
+    partials = 0;
+    final result = workerCount == 1
+        ? order
+        : mergeSplatPartitions(
+            histograms,
+            orders,
+            merged ??= Float32List(total),
+          );
+    incremental!.reset(result, sortDir[0], sortDir[1], sortDir[2]);
+    reply(result);
+  }
+
+  void bucket(double lo, double hi) {
+    partition.bucket(lo, hi);
+    if (index == 0) {
+      receivePartial(0, partition.histogram, partition.order);
+      return;
+    }
+    peers[0].send(<Object>[
+      _partial,
+      index,
+      TransferableTypedData.fromList([partition.histogram]),
+      TransferableTypedData.fromList([partition.order]),
+    ]);
+  }
+
+  void receiveRange(double lo, double hi) {
+    if (lo < minKey) minKey = lo;
+    if (hi > maxKey) maxKey = hi;
+    if (++ranges < workerCount) return;
+    final globalMin = minKey;
+    final globalMax = maxKey;
+    ranges = 0;
+    minKey = double.infinity;
+    maxKey = double.negativeInfinity;
+    for (var w = 1; w < workerCount; w++) {
+      peers[w].send(<Object>[_bucket, globalMin, globalMax]);
+    }
+    bucket(globalMin, globalMax);
+  }
+
+  replyTo.send(<Object>[index, requests.sendPort]);
   requests.listen((message) {
     if (message == null) {
       requests.close();
       return;
     }
-    final dir = message as List<double>;
-    final order = sortSplatsBackToFront(
-      positions,
-      count,
-      dir[0],
-      dir[1],
-      dir[2],
-    );
-    replyTo.send(TransferableTypedData.fromList([order]));
+    final fields = message as List;
+    switch (fields[0] as int) {
+      case _peers:
+        peers = (fields[1] as List).cast<SendPort>();
+      case _sort:
+        final dirX = fields[1] as double;
+        final dirY = fields[2] as double;
+        final dirZ = fields[3] as double;
+        if (incremental != null) {
+          budget = fields.length > 4
+              ? (
+                  count: fields[4] as int,
+                  eyeX: fields[5] as double,
+                  eyeY: fields[6] as double,
+                  eyeZ: fields[7] as double,
+                )
+              : null;
+          if (incremental.repair(dirX, dirY, dirZ)) {
+            reply(incremental.order);
+            return;
+          }
+          sortDir = [dirX, dirY, dirZ];
+          for (var w = 1; w < workerCount; w++) {
+            peers[w].send(message);
+          }
+        }
+        final keys = partition.computeKeys(dirX, dirY, dirZ);
+        if (index == 0) {
+          receiveRange(keys.minKey, keys.maxKey);
+        } else {
+          peers[0].send(<Object>[_range, keys.minKey, keys.maxKey]);
+        }
+      case _range:
+        receiveRange(fields[1] as double, fields[2] as double);
+      case _bucket:
+        bucket(fields[1] as double, fields[2] as double);
+      case _partial:
+        receivePartial(
+          fields[1] as int,
+          (fields[2] as TransferableTypedData).materialize().asUint32List(),
+          (fields[3] as TransferableTypedData).materialize().asFloat32List(),
+        );
+    }
   });
 }
@@ -7,22 +7,47 @@ import 'package:flutter_scene/src/splats/splat_sorter.dart';
 /// Creates the web sorter, which runs synchronously on the main thread
 /// (the web platform has no shared-memory isolates).
 /// TODO(splats): move this into a web worker for large sets.
-SplatSortService createSplatSortService(Float32List positions, int count) =>
-    _SynchronousSplatSortService(positions, count);
+///
+/// [workers] is ignored; there is nothing to spread the sort across.
+SplatSortService createSplatSortService(
+  Float32List positions,
+  int count, {
+  int? workers,
+  Float32List? importance,
+}) => _SynchronousSplatSortService(positions, count, importance);
 
 class _SynchronousSplatSortService implements SplatSortService {
-  _SynchronousSplatSortService(this._positions, this._count);
+  _SynchronousSplatSortService(
+    Float32List positions,
+    int count,
+    Float32List? importance,
+  ) : _sorter = IncrementalSplatSorter(positions, count: count),
+      _filter = importance == null
+          ? null
+          : SplatBudgetFilter(positions, importance, count: count);
 
-  final Float32List _positions;
-  final int _count;
+  final IncrementalSplatSorter _sorter;
+  final SplatBudgetFilter? _filter;
   bool _disposed = false;
 
+  // The sorter's order is reused by the next sort, so the caller gets a
+  // copy (as the native service's caller does).
   @override
-  Future<Float32List?> sort(double dirX, double dirY, double dirZ) =>
-      Future(() {
-        if (_disposed) return null;
-        return sortSplatsBackToFront(_positions, _count, dirX, dirY, dirZ);
-      });
+  Future<Float32List?> sort(
+    double dirX,
+    double dirY,
+    double dirZ, {
+    SplatBudget? budget,
+  }) => Future(() {
+    if (_disposed) return null;
+    final order = _sorter.sort(dirX, dirY, dirZ);
+    final filter = _filter;
+    if (budget == null || filter == null) return Float32List.fromList(order);
+    final kept = filter.select(order, budget);
+    return Float32List.fromList(
+      Float32List.sublistView(filter.selected, 0, kept),
+    );
+  });
 
   @override
   void dispose() {
@@ -1,3 +1,4 @@
+import 'dart:math' as math;
 import 'dart:typed_data';
 
 /// Sorts splats back to front along a view direction.
@@ -13,7 +14,8 @@ import 'dart:typed_data';
 /// needed when the direction changes.
 ///
 /// Uses a 16-bit counting sort, two O(n) passes over a 65536-bucket histogram
-/// rather than a comparison sort.
+/// rather than a comparison sort. This one-shot form allocates its working
+/// arrays; a long-lived sorter keeps a [SplatSortPartition] instead.
 Float32List sortSplatsBackToFront(
   Float32List positions,
   int count,
@@ -21,52 +23,387 @@ Float32List sortSplatsBackToFront(
   double dirY,
   double dirZ,
 ) {
-  final keys = Float32List(count);
-  var minKey = double.infinity;
-  var maxKey = double.negativeInfinity;
-  for (var i = 0; i < count; i++) {
-    final o = i * 3;
-    final k =
-        positions[o] * dirX + positions[o + 1] * dirY + positions[o + 2] * dirZ;
-    keys[i] = k;
-    if (k < minKey) minKey = k;
-    if (k > maxKey) maxKey = k;
-  }
+  final partition = SplatSortPartition(positions, count: count);
+  final (:minKey, :maxKey) = partition.computeKeys(dirX, dirY, dirZ);
+  partition.bucket(minKey, maxKey);
+  return partition.order;
+}
+
+/// The number of depth buckets the counting sort quantizes keys into.
+const int kSplatSortBuckets = 1 << 16;
+
+/// One contiguous run of splats in a partitioned [sortSplatsBackToFront].
+///
+/// A sort over several workers splits the splats into index ranges, one
+/// partition each. Every partition computes its keys and reports their
+/// range ([computeKeys]); given the global range, it quantizes, counts, and
+/// orders its own splats ([bucket]); [mergeSplatPartitions] then
+/// concatenates each bucket's runs across partitions. The result is exactly
+/// the single-pass order, since the counting sort is stable and partitions
+/// cover increasing index ranges.
+///
+/// The working arrays are allocated once and reused by every sort, so a
+/// long-lived worker sorts without allocating.
+class SplatSortPartition {
+  /// A partition over the first [count] splats of [positions] (`x, y, z`
+  /// per splat), whose first splat has the global index [start].
+  SplatSortPartition(this.positions, {required this.count, this.start = 0})
+    : _keys = Float32List(count),
+      _quantized = Uint16List(count),
+      order = Float32List(count);
+
+  final Float32List positions;
+
+  /// The number of splats in this partition.
+  final int count;
 
-  final out = Float32List(count);
-  final range = maxKey - minKey;
-  if (count == 0) return out;
-  if (range <= 0 || !range.isFinite) {
+  /// The global index of this partition's first splat.
+  final int start;
+
+  /// The number of splats per depth bucket, filled by [bucket].
+  final Uint32List histogram = Uint32List(kSplatSortBuckets);
+
+  /// This partition's global splat indices, back to front, filled by
+  /// [bucket].
+  final Float32List order;
+
+  final Float32List _keys;
+  final Uint16List _quantized;
+  final Uint32List _offsets = Uint32List(kSplatSortBuckets);
+
+  /// Computes every splat's depth key along `dir*` and returns their range
+  /// (infinite bounds when the partition is empty).
+  ({double minKey, double maxKey}) computeKeys(
+    double dirX,
+    double dirY,
+    double dirZ,
+  ) {
+    final keys = _keys;
+    var minKey = double.infinity;
+    var maxKey = double.negativeInfinity;
     for (var i = 0; i < count; i++) {
-      out[i] = i.toDouble();
+      final o = i * 3;
+      final k =
+          positions[o] * dirX +
+          positions[o + 1] * dirY +
+          positions[o + 2] * dirZ;
+      keys[i] = k;
+      if (k < minKey) minKey = k;
+      if (k > maxKey) maxKey = k;
     }
-    return out;
+    return (minKey: minKey, maxKey: maxKey);
   }
 
-  const buckets = 1 << 16;
-  final scale = (buckets - 1) / range;
-  final histogram = Uint32List(buckets);
-  final quantized = Uint16List(count);
-  for (var i = 0; i < count; i++) {
-    final q = ((keys[i] - minKey) * scale).toInt();
-    quantized[i] = q;
-    histogram[q]++;
+  /// Quantizes the keys from the last [computeKeys] into the global range
+  /// [minKey]..[maxKey], then fills [histogram] and [order]. A degenerate
+  /// range (every splat at one depth) keeps index order in bucket 0.
+  void bucket(double minKey, double maxKey) {
+    final histogram = this.histogram..fillRange(0, kSplatSortBuckets, 0);
+    final order = this.order;
+    final range = maxKey - minKey;
+    if (range <= 0 || !range.isFinite) {
+      histogram[0] = count;
+      for (var i = 0; i < count; i++) {
+        order[i] = (start + i).toDouble();
+      }
+      return;
+    }
+
+    final keys = _keys;
+    final quantized = _quantized;
+    final scale = (kSplatSortBuckets - 1) / range;
+    for (var i = 0; i < count; i++) {
+      final q = ((keys[i] - minKey) * scale).toInt();
+      quantized[i] = q;
+      histogram[q]++;
+    }
+
+    // Turn the histogram into each bucket's starting output offset, walking
+    // far to near so the largest depth bucket writes first (back to front).
+    final offsets = _offsets;
+    var offset = 0;
+    for (var b = kSplatSortBuckets - 1; b >= 0; b--) {
+      offsets[b] = offset;
+      offset += histogram[b];
+    }
+    for (var i = 0; i < count; i++) {
+      order[offsets[quantized[i]]++] = (start + i).toDouble();
+    }
   }
+}
 
-  // Turn the histogram into each bucket's starting output offset, walking
-  // far to near so the largest depth bucket writes first (back to front).
+/// Concatenates the bucketed [orders] of consecutive partitions (with their
+/// [histograms]) into [out], far bucket first and, within a bucket, in
+/// partition order. Returns [out].
+Float32List mergeSplatPartitions(
+  List<Uint32List> histograms,
+  List<Float32List> orders,
+  Float32List out,
+) {
+  final cursors = List<int>.filled(orders.length, 0);
   var offset = 0;
-  for (var b = buckets - 1; b >= 0; b--) {
-    final n = histogram[b];
-    histogram[b] = offset;
-    offset += n;
-  }
-  for (var i = 0; i < count; i++) {
-    out[histogram[quantized[i]]++] = i.toDouble();
+  for (var b = kSplatSortBuckets - 1; b >= 0; b--) {
+    for (var p = 0; p < orders.length; p++) {
+      final n = histograms[p][b];
+      if (n == 0) continue;
+      final from = cursors[p];
+      out.setRange(offset, offset + n, orders[p], from);
+      cursors[p] = from + n;
+      offset += n;
+    }
   }
   return out;
 }
 
+/// A sorter that repairs its previous order after a small rotation instead
+/// of sorting from scratch.
+///
+/// An orbiting camera turns the view direction a little every frame, which
+/// moves few splats across depth buckets. [repair] re-keys the splats in
+/// their previous order (at the full sort's bucket resolution) and runs an
+/// insertion pass, which costs one move per bucket inversion. It gives up
+/// when the direction turned by more than [maxRepairAngle] or the pass
+/// exceeds [repairBudget] moves per splat, and the caller falls back to a
+/// full sort ([sort] does this itself).
+///
+/// Inversions grow with the rotation and the set's density, so a dense set
+/// turning quickly would pay for a doomed repair on every sort. After a
+/// repair runs over budget, repairs are only tried for turns under half
+/// that one; each full sort widens the limit back toward [maxRepairAngle].
+///
+/// The result is back to front at the same resolution as
+/// [sortSplatsBackToFront], though splats sharing a bucket may come out in
+/// a different order.
+class IncrementalSplatSorter {
+  /// Creates a sorter over the first [count] splats of [positions]
+  /// (`x, y, z` per splat).
+  IncrementalSplatSorter(
+    this.positions, {
+    required this.count,
+    this.maxRepairAngle = 0.1,
+    this.repairBudget = 2,
+  }) : _repairAngleLimit = maxRepairAngle,
+       order = Float32List(count),
+       _keys = Float32List(count),
+       _quantized = Uint16List(count);
+
+  final Float32List positions;
+  final int count;
+
+  /// The largest rotation, in radians, since the last sort that [repair]
+  /// attempts.
+  final double maxRepairAngle;
+
+  /// The most insertion moves per splat [repair] spends before giving up.
+  final double repairBudget;
+
+  /// The splat indices from the last successful [sort], [repair], or
+  /// [reset], back to front.
+  final Float32List order;
+
+  double _repairAngleLimit;
+  final Float32List _keys;
+  final Uint16List _quantized;
+  SplatSortPartition? _partition;
+
+  bool _hasOrder = false;
+  double _dirX = 0;
+  double _dirY = 0;
+  double _dirZ = 0;
+
+  /// The number of sorts served by [repair].
+  int repairs = 0;
+
+  /// The number of sorts that needed a full counting sort.
+  int fullSorts = 0;
+
+  /// Sorts along `dir*`, repairing the previous order when possible.
+  /// Returns [order].
+  Float32List sort(double dirX, double dirY, double dirZ) {
+    if (repair(dirX, dirY, dirZ)) return order;
+    final partition = _partition ??= SplatSortPartition(
+      positions,
+      count: count,
+    );
+    final keys = partition.computeKeys(dirX, dirY, dirZ);
+    partition.bucket(keys.minKey, keys.maxKey);
+    reset(partition.order, dirX, dirY, dirZ);
+    return order;
+  }
+
+  /// Adopts [sorted], a full sort along `dir*`, as the order later repairs
+  /// start from. Copies it into [order].
+  void reset(Float32List sorted, double dirX, double dirY, double dirZ) {
+    order.setAll(0, sorted);
+    _hasOrder = true;
+    _dirX = dirX;
+    _dirY = dirY;
+    _dirZ = dirZ;
+    fullSorts++;
+    _repairAngleLimit = math.min(maxRepairAngle, _repairAngleLimit * 1.25);
+  }
+
+  /// Repairs [order] for the direction `dir*`. Returns false, leaving
+  /// [order] unusable until the next [reset], when there is no previous
+  /// order, the direction turned too far, or the repair ran over budget.
+  bool repair(double dirX, double dirY, double dirZ) {
+    if (!_hasOrder) return false;
+    final lengths = math.sqrt(
+      (dirX * dirX + dirY * dirY + dirZ * dirZ) *
+          (_dirX * _dirX + _dirY * _dirY + _dirZ * _dirZ),
+    );
+    if (!(lengths > 0)) return false;
+    final dot = dirX * _dirX + dirY * _dirY + dirZ * _dirZ;
+    final angle = math.acos((dot / lengths).clamp(-1.0, 1.0));
+    if (angle > _repairAngleLimit) return false;
+
+    final order = this.order;
+    final keys = _keys;
+    var minKey = double.infinity;
+    var maxKey = double.negativeInfinity;
+    for (var j = 0; j < count; j++) {
+      final o = order[j].toInt() * 3;
+      final k =
+          positions[o] * dirX +
+          positions[o + 1] * dirY +
+          positions[o + 2] * dirZ;
+      keys[j] = k;
+      if (k < minKey) minKey = k;
+      if (k > maxKey) maxKey = k;
+    }
+
+    // A degenerate range puts every splat in one bucket, which any order
+    // already satisfies.
+    final range = maxKey - minKey;
+    if (range > 0 && range.isFinite) {
+      final quantized = _quantized;
+      final scale = (kSplatSortBuckets - 1) / range;
+      for (var j = 0; j < count; j++) {
+        quantized[j] = ((keys[j] - minKey) * scale).toInt();
+      }
+      // Insertion pass over the nearly sorted buckets, far to near.
+      final budget = (count * repairBudget).toInt();
+      var moves = 0;
+      for (var j = 1; j < count; j++) {
+        final q = quantized[j];
+        if (q <= quantized[j - 1]) continue;
+        final splat = order[j];
+        var m = j;
+        do {
+          quantized[m] = quantized[m - 1];
+          order[m] = order[m - 1];
+          m--;
+        } while (m > 0 && quantized[m - 1] < q);
+        quantized[m] = q;
+        order[m] = splat;
+        moves += j - m;
+        if (moves > budget) {
+          _hasOrder = false;
+          _repairAngleLimit = angle * 0.5;
+          return false;
+        }
+      }
+    }
+
+    _dirX = dirX;
+    _dirY = dirY;
+    _dirZ = dirZ;
+    repairs++;
+    return true;
+  }
+}
+
+/// A splat-count budget for one sort: keep at most [count] splats, ranked
+/// as seen from the local-space eye position `eye*` (see
+/// [SplatBudgetFilter]).
+typedef SplatBudget = ({int count, double eyeX, double eyeY, double eyeZ});
+
+// Rank buckets: a positive float's exponent and top three mantissa bits.
+const int _kBudgetRankShift = 20;
+const int _kBudgetBuckets = 1 << (31 - _kBudgetRankShift);
+
+/// Cuts a back-to-front order down to a splat-count budget, dropping the
+/// splats that matter least from the current viewpoint.
+///
+/// A splat's rank is its importance (`SplatData.computeImportance`) over
+/// its squared distance from the eye, roughly its screen coverage, so
+/// faint, small, distant splats go first. [select] keeps the [SplatBudget]
+/// highest-ranked splats in their sorted order. The cut comes from one
+/// histogram pass over the ranks' float exponents and top mantissa bits,
+/// so ranks within about 10% share a bucket; in the bucket straddling the
+/// cut, the nearer splats are kept. The working arrays persist across
+/// calls, so a long-lived sorter selects without allocating.
+class SplatBudgetFilter {
+  /// Creates a filter over the first [count] splats of [positions] (`x, y,
+  /// z` per splat) with per-splat [importance].
+  SplatBudgetFilter(this.positions, this.importance, {required this.count})
+    : selected = Float32List(count),
+      _buckets = Uint16List(count);
+
+  final Float32List positions;
+  final Float32List importance;
+  final int count;
+
+  /// The kept splat indices from the last [select], back to front.
+  final Float32List selected;
+
+  final Uint16List _buckets;
+  final Uint32List _histogram = Uint32List(_kBudgetBuckets);
+  final Float32List _rank = Float32List(1);
+  late final Uint32List _rankBits = Uint32List.view(_rank.buffer);
+
+  /// Filters [order] (every splat, back to front) into [selected] and
+  /// returns the number kept, at most [SplatBudget.count].
+  int select(Float32List order, SplatBudget budget) {
+    final limit = budget.count;
+    if (limit >= count) {
+      selected.setAll(0, order);
+      return count;
+    }
+    final histogram = _histogram..fillRange(0, _kBudgetBuckets, 0);
+    final buckets = _buckets;
+    for (var i = 0; i < count; i++) {
+      final o = i * 3;
+      final dx = positions[o] - budget.eyeX;
+      final dy = positions[o + 1] - budget.eyeY;
+      final dz = positions[o + 2] - budget.eyeZ;
+      final rank = importance[i] / (dx * dx + dy * dy + dz * dz + 1e-12);
+      // Non-positive and NaN ranks share the lowest bucket.
+      _rank[0] = rank > 0 ? rank : 0;
+      final bucket = _rankBits[0] >> _kBudgetRankShift;
+      buckets[i] = bucket;
+      histogram[bucket]++;
+    }
+
+    // Every bucket above the cut fits the budget; the cut bucket fills
+    // what remains.
+    var kept = 0;
+    var cut = _kBudgetBuckets - 1;
+    while (cut >= 0 && kept + histogram[cut] <= limit) {
+      kept += histogram[cut];
+      cut--;
+    }
+    // The nearer splats of the cut bucket come last in the order, so skip
+    // its first ones.
+    var skip = cut >= 0 ? histogram[cut] - (limit - kept) : 0;
+    var w = 0;
+    for (var k = 0; k < count; k++) {
+      final splat = order[k];
+      final bucket = buckets[splat.toInt()];
+      if (bucket > cut) {
+        selected[w++] = splat;
+      } else if (bucket == cut) {
+        if (skip > 0) {
+          skip--;
+        } else {
+          selected[w++] = splat;
+        }
+      }
+    }
+    return w;
+  }
+}
+
 /// The top-level `compute` entry point for [sortSplatsBackToFront].
 Float32List sortSplatsForIsolate(
   ({Float32List positions, int count, double dirX, double dirY, double dirZ})
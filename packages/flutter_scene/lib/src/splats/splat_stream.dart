@@ -0,0 +1,212 @@
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/splats/splat_codec.dart';
+
+/// Splits a splat file arriving in arbitrary byte chunks (an asset or
+/// network stream) into runs of whole records, so a loader can decode and
+/// show the first splats while the rest are still in flight.
+///
+/// Feed chunks to [add], which returns the runs they completed, then call
+/// [close] at the end of the stream for the last one. Runs start at
+/// [firstBatchSplats] records, so the first arrives within the first
+/// megabyte or so, and double up to [maxBatchSplats] to keep the per-run
+/// overhead low. Every run but the last holds a multiple of
+/// [kSplatChunkSize] records, so compact batches stay chunk-aligned.
+///
+/// A file that cannot stream is buffered whole: a compressed PLY, whose
+/// rest SH follows every vertex record, or a `.splat` of unknown length,
+/// whose count is unknown until the end. Then [layout] stays null, [add]
+/// returns no runs, and [close] returns the entire file.
+class SplatStreamReader {
+  SplatStreamReader({
+    SplatFormat? format,
+    this.options = const SplatDecodeOptions(),
+    this.lengthInBytes,
+    this.firstBatchSplats = 1 << 12,
+    this.maxBatchSplats = 1 << 17,
+  }) : _fallback = format,
+       _batch = firstBatchSplats,
+       assert(firstBatchSplats % kSplatChunkSize == 0),
+       assert(maxBatchSplats % kSplatChunkSize == 0);
+
+  /// The options the records decode with; only the SH cap applies here.
+  final SplatDecodeOptions options;
+
+  /// The file's total length, when known. Lets a `.splat` file stream.
+  final int? lengthInBytes;
+
+  /// The records in the first run.
+  final int firstBatchSplats;
+
+  /// The most records in one run.
+  final int maxBatchSplats;
+
+  final SplatFormat? _fallback;
+  final BytesBuilder _pending = BytesBuilder(copy: false);
+  int _batch;
+  bool _buffering = false;
+
+  /// The file's format, sniffed from its first bytes (null until enough
+  /// have arrived).
+  SplatFormat? get format => _format;
+  SplatFormat? _format;
+
+  /// The record layout, once the header has arrived, or null while it has
+  /// not or when the file is buffered whole.
+  SplatRecordLayout? get layout => _layout;
+  SplatRecordLayout? _layout;
+
+  /// The number of records the file holds, once [layout] is known.
+  int? get count => _count;
+  int? _count;
+
+  /// The records returned in runs so far.
+  int get emitted => _emitted;
+  int _emitted = 0;
+
+  /// Appends [chunk] and returns the record runs it completed, in order.
+  List<Uint8List> add(List<int> chunk) {
+    final bytes = chunk is Uint8List ? chunk : Uint8List.fromList(chunk);
+    _pending.add(bytes);
+    if (_buffering) return const [];
+    if (_layout == null && !_readHeader(bytes)) return const [];
+    final layout = _layout!;
+    final count = _count!;
+    final next = math.min(_batch, count - _emitted);
+    if (next == 0 || _pending.length < next * layout.stride) return const [];
+
+    // Runs are views into one consolidated buffer; the remainder carries
+    // over to the next chunk.
+    final taken = _pending.takeBytes();
+    final runs = <Uint8List>[];
+    var offset = 0;
+    while (_emitted < count) {
+      final run = math.min(_batch, count - _emitted);
+      final length = run * layout.stride;
+      if (taken.length - offset < length) break;
+      runs.add(Uint8List.sublistView(taken, offset, offset + length));
+      offset += length;
+      _emitted += run;
+      _batch = math.min(_batch * 2, maxBatchSplats);
+    }
+    if (offset < taken.length) {
+      _pending.add(Uint8List.sublistView(taken, offset));
+    }
+    return runs;
+  }
+
+  /// Ends the stream, returning the last run (null when there is none) or,
+  /// for a buffered file, the whole file. Throws a [FormatException] when
+  /// the stream ended early.
+  Uint8List? close() {
+    if (_buffering || _layout == null) {
+      // Too short to sniff or still in the header: let the whole-file
+      // decoder report what is wrong with it.
+      _buffering = true;
+      return _pending.takeBytes();
+    }
+    final layout = _layout!;
+    final missing = _count! - _emitted;
+    final bytes = _pending.takeBytes();
+    if (bytes.length < missing * layout.stride) {
+      throw FormatException(
+        'Splat stream ended after $_emitted of $_count records.',
+      );
+    }
+    if (missing == 0) return null;
+    _emitted += missing;
+    return Uint8List.sublistView(bytes, 0, missing * layout.stride);
+  }
+
+  /// Whether [close] returned the whole file rather than a run.
+  bool get buffered => _buffering;
+
+  // The file's first bytes (its magic), and while the header's end has not
+  // turned up, how many bytes were searched for it and the last few of
+  // them, so an end split across chunks is still found.
+  final List<int> _magic = [];
+  int _headerScanned = 0;
+  Uint8List _headerTail = Uint8List(0);
+  bool _headerEnded = false;
+
+  // Sniffs the format and parses the header once enough bytes are in;
+  // strips the header from the pending bytes. False while waiting (or when
+  // falling back to buffering). Each [chunk] is searched once, so waiting
+  // for a long header does not rescan (or copy) what came before it.
+  bool _readHeader(Uint8List chunk) {
+    _scanHeader(chunk);
+    for (var i = 0; i < chunk.length && _magic.length < 4; i++) {
+      _magic.add(chunk[i]);
+    }
+    if (_magic.length < 4) return false;
+    final magic = Uint8List.fromList(_magic);
+    if (sniffSplatFormat(magic, fallback: _fallback) != SplatFormat.splat &&
+        !_headerEnded) {
+      // A compressed PLY differs from a training one only inside the
+      // header, so the sniff is final once all of it is in.
+      if (_pending.length < _kMaxHeaderWait) return false;
+      _buffering = true;
+      return false;
+    }
+    final head = _pending.toBytes();
+    final format = sniffSplatFormat(head, fallback: _fallback);
+    _format = format;
+    if (format == SplatFormat.ply) {
+      final layout = readSplatRecordLayout(head, format, options: options)!;
+      return _start(layout, layout.count!, head);
+    }
+    final length = lengthInBytes;
+    if (format == SplatFormat.splat && length != null) {
+      final layout = readSplatRecordLayout(head, format)!;
+      return _start(layout, length ~/ layout.stride, head);
+    }
+    _buffering = true;
+    return false;
+  }
+
+  // The header bytes to wait for before handing the file to the whole-file
+  // decoder to diagnose.
+  static const int _kMaxHeaderWait = 64 * 1024;
+
+  static final List<int> _kHeaderEnd = 'end_header\n'.codeUnits;
+
+  // Searches [chunk], after the bytes already searched, for the header's
+  // end, within the first [_kMaxHeaderWait] bytes of the file.
+  void _scanHeader(Uint8List chunk) {
+    if (_headerEnded) return;
+    final length = math.min(chunk.length, _kMaxHeaderWait - _headerScanned);
+    if (length <= 0) return;
+    final tail = _headerTail;
+    final window = Uint8List(tail.length + length)
+      ..setAll(0, tail)
+      ..setRange(tail.length, tail.length + length, chunk);
+    _headerScanned += length;
+    if (_hasHeaderEnd(window)) {
+      _headerEnded = true;
+      return;
+    }
+    final keep = math.min(window.length, _kHeaderEnd.length - 1);
+    _headerTail = Uint8List.sublistView(window, window.length - keep);
+  }
+
+  static bool _hasHeaderEnd(Uint8List bytes) {
+    final limit = bytes.length - _kHeaderEnd.length;
+    outer:
+    for (var i = 0; i <= limit; i++) {
+      for (var j = 0; j < _kHeaderEnd.length; j++) {
+        if (bytes[i + j] != _kHeaderEnd[j]) continue outer;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  bool _start(SplatRecordLayout layout, int count, Uint8List head) {
+    _layout = layout;
+    _count = count;
+    _pending.clear();
+    _pending.add(Uint8List.sublistView(head, layout.headerLength));
+    return true;
+  }
+}
@@ -9,26 +9,83 @@
 // highest-magnitude nonzero weights each frame and uploads them as
 // (band start row, weight) pairs; the loop below runs the fixed pair count
 // with dynamically indexed rows.
+//
+// With FLUTTER_SCENE_SPARSE_MORPH_TARGETS also defined, the texture holds
+// only the vertices each target moves (MorphTexturePacking.runs): texels
+// are addressed linearly, and each target stores a run table (first vertex,
+// vertex count, first delta texel per run) ahead of its deltas. A pair
+// then carries the target's table texel and run count, and each vertex
+// binary-searches the table for its run.
 
 const int kMaxMorphTargets = 8;
 
 uniform MorphInfo {
   // x: active pair count, y: texture width in texels,
-  // z: rows per attribute per band, w: 1 when normal rows are present.
+  // z: rows per attribute per band (sparse: texels per moved vertex),
+  // w: 1 when normal deltas are present.
   vec4 morph_params;
-  // x: the target's band start row, y: the target's weight.
+  // x: the target's band start row (sparse: run table texel),
+  // y: the target's weight, z: (sparse only) the target's run count.
   vec4 morph_pairs[kMaxMorphTargets];
 }
 morph_info;
 
 uniform sampler2D morph_texture;
 
+#ifdef FLUTTER_SCENE_SPARSE_MORPH_TARGETS
+// Enough halvings for a run table filling a 2048x2048 texture.
+const int kMaxMorphRunSearchSteps = 23;
+
+vec4 MorphTexel(int index) {
+  int width = int(morph_info.morph_params.y);
+  return texelFetch(morph_texture, ivec2(index % width, index / width), 0);
+}
+
+// The pair's delta texel for `attribute` (0 position, 1 normal), or a zero
+// delta when the target does not move this vertex.
+vec3 MorphTargetDelta(int pair, int attribute) {
+  int table = int(morph_info.morph_pairs[pair].x);
+  int low = 0;
+  int high = int(morph_info.morph_pairs[pair].z);
+  // Finds the first run starting past the vertex; the one before it is the
+  // only run that can hold it.
+  for (int i = 0; i < kMaxMorphRunSearchSteps; i++) {
+    if (low >= high) {
+      break;
+    }
+    int middle = (low + high) / 2;
+    if (int(MorphTexel(table + middle).x) <= gl_VertexIndex) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low == 0) {
+    return vec3(0.0);
+  }
+  vec4 run = MorphTexel(table + low - 1);
+  int offset = gl_VertexIndex - int(run.x);
+  if (offset >= int(run.y)) {
+    return vec3(0.0);
+  }
+  int texels_per_value = int(morph_info.morph_params.z);
+  return MorphTexel(int(run.z) + offset * texels_per_value + attribute).xyz;
+}
+#else
 vec3 MorphDelta(int row_start, int vertex_index) {
   int width = int(morph_info.morph_params.y);
   ivec2 texel = ivec2(vertex_index % width, row_start + vertex_index / width);
   return texelFetch(morph_texture, texel, 0).xyz;
 }
 
+vec3 MorphTargetDelta(int pair, int attribute) {
+  int rows_per_attribute = int(morph_info.morph_params.z);
+  return MorphDelta(int(morph_info.morph_pairs[pair].x) +
+                        attribute * rows_per_attribute,
+                    gl_VertexIndex);
+}
+#endif
+
 vec3 MorphedPosition(vec3 base_position) {
   vec3 result = base_position;
   int count = int(morph_info.morph_params.x);
@@ -36,8 +93,7 @@ vec3 MorphedPosition(vec3 base_position) {
     if (i >= count) {
       break;
     }
-    result += morph_info.morph_pairs[i].y *
-        MorphDelta(int(morph_info.morph_pairs[i].x), gl_VertexIndex);
+    result += morph_info.morph_pairs[i].y * MorphTargetDelta(i, 0);
   }
   return result;
 }
@@ -50,14 +106,11 @@ vec3 MorphedNormal(vec3 base_normal) {
   }
   vec3 result = base_normal;
   int count = int(morph_info.morph_params.x);
-  int rows_per_attribute = int(morph_info.morph_params.z);
   for (int i = 0; i < kMaxMorphTargets; i++) {
     if (i >= count) {
       break;
     }
-    result += morph_info.morph_pairs[i].y *
-        MorphDelta(int(morph_info.morph_pairs[i].x) + rows_per_attribute,
-                   gl_VertexIndex);
+    result += morph_info.morph_pairs[i].y * MorphTargetDelta(i, 1);
   }
   float length_squared = dot(result, result);
   return length_squared > 1e-12 ? result * inversesqrt(length_squared)
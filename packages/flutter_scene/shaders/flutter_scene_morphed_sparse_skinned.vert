@@ -0,0 +1,7 @@
+// Morphed skinned vertex shader over run-indexed (sparse) deltas: the
+// morphed skinned variant reading MorphTexturePacking.runs textures, still
+// blended before the skin matrix.
+#define FLUTTER_SCENE_MORPH_TARGETS
+#define FLUTTER_SCENE_SPARSE_MORPH_TARGETS
+#include <material_vertex.glsl>
+#include <flutter_scene_skinned_body.glsl>
@@ -0,0 +1,7 @@
+// Morphed unskinned vertex shader over run-indexed (sparse) deltas: the
+// morphed unskinned variant reading MorphTexturePacking.runs textures,
+// which hold only the vertices each target moves.
+#define FLUTTER_SCENE_MORPH_TARGETS
+#define FLUTTER_SCENE_SPARSE_MORPH_TARGETS
+#include <material_vertex.glsl>
+#include <flutter_scene_unskinned_body.glsl>
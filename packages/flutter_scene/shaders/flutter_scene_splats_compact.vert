@@ -0,0 +1,111 @@
+// Gaussian splat vertex stage over the compact layout, four RGBA8 texels
+// (one little-endian 32-bit word each) per splat, the compressed PLY
+// encoding:
+//   position 11/10/11 | rotation 2/10/10/10 | log scale 11/10/11 | color
+//   8888 (r, g, b, opacity)
+// Position, log scale, and color are unorm within their 256-splat chunk's
+// ranges, read from the chunk texture (RGBA32F, eight texels per chunk):
+//   pos min.xyz, sh min | pos max.xyz, sh max | log scale min.xyz, 0 |
+//   log scale max.xyz, 0 | color min.rgb, 0 | color max.rgb, 0 | 0 | 0
+// Rest SH is one RGBA8 texel per coefficient, unorm within the chunk's SH
+// range.
+
+uniform sampler2D splat_params_texture;
+uniform sampler2D splat_sh_texture;
+uniform sampler2D splat_chunk_texture;
+
+#include <flutter_scene_splats_body.glsl>
+
+// The current splat's chunk SH range, set by fetchSplat for fetchRestSh.
+vec2 sh_range;
+
+// A texel's four bytes, exactly (unorm8 samples are byte / 255).
+vec4 fetchBytes(float index) {
+  return floor(
+      fetchTexel(splat_params_texture, index, frame_info.params_texture.xy) *
+          255.0 +
+      0.5);
+}
+
+// Unpacks an 11/10/11 word (x in the top bits) to unorm x, y, z.
+vec3 unpack111011(vec4 b) {
+  return vec3(floor(b.z / 32.0) + b.w * 8.0,
+              floor(b.y / 8.0) + mod(b.z, 32.0) * 32.0,
+              b.x + mod(b.y, 8.0) * 256.0) /
+         vec3(2047.0, 1023.0, 2047.0);
+}
+
+// Unpacks a smallest-three quaternion: the top two bits index the largest
+// component in file order (w, x, y, z), the rest hold the other three in
+// order, 10 bits each over [-1/sqrt(2), 1/sqrt(2)]. Returns x, y, z, w.
+vec4 unpackRotation(vec4 b) {
+  vec3 abc = vec3(floor(b.z / 16.0) + mod(b.w, 64.0) * 16.0,
+                  floor(b.y / 4.0) + mod(b.z, 16.0) * 64.0,
+                  b.x + mod(b.y, 4.0) * 256.0);
+  abc = (abc / 1023.0 - 0.5) * 1.4142135623730951;
+  float m = sqrt(max(1.0 - dot(abc, abc), 0.0));
+  float largest = floor(b.w / 64.0);
+  vec4 wxyz;
+  if (largest < 0.5) {
+    wxyz = vec4(m, abc);
+  } else if (largest < 1.5) {
+    wxyz = vec4(abc.x, m, abc.yz);
+  } else if (largest < 2.5) {
+    wxyz = vec4(abc.xy, m, abc.z);
+  } else {
+    wxyz = vec4(abc, m);
+  }
+  return vec4(wxyz.yzw, wxyz.x);
+}
+
+void fetchSplat(
+    float index,
+    out vec3 position,
+    out float opacity,
+    out mat3 covariance,
+    out vec3 color) {
+  float base = index * 4.0;
+  vec4 packed_position = fetchBytes(base);
+  vec4 packed_rotation = fetchBytes(base + 1.0);
+  vec4 packed_scale = fetchBytes(base + 2.0);
+  vec4 packed_color = fetchBytes(base + 3.0);
+
+  float chunk = floor(index / 256.0) * 8.0;
+  vec2 chunk_dims = frame_info.params_texture.zw;
+  vec4 c0 = fetchTexel(splat_chunk_texture, chunk, chunk_dims);
+  vec4 c1 = fetchTexel(splat_chunk_texture, chunk + 1.0, chunk_dims);
+  vec4 c2 = fetchTexel(splat_chunk_texture, chunk + 2.0, chunk_dims);
+  vec4 c3 = fetchTexel(splat_chunk_texture, chunk + 3.0, chunk_dims);
+  vec4 c4 = fetchTexel(splat_chunk_texture, chunk + 4.0, chunk_dims);
+  vec4 c5 = fetchTexel(splat_chunk_texture, chunk + 5.0, chunk_dims);
+  sh_range = vec2(c0.w, c1.w);
+
+  position = mix(c0.xyz, c1.xyz, unpack111011(packed_position));
+  vec3 s = exp(mix(c2.xyz, c3.xyz, unpack111011(packed_scale)));
+  // The word's bytes are opacity, b, g, r from least significant.
+  color = mix(c4.rgb, c5.rgb, packed_color.wzy / 255.0);
+  opacity = packed_color.x / 255.0;
+
+  // Sigma = (R * S) * (R * S)^T, rebuilt here rather than stored.
+  vec4 q = unpackRotation(packed_rotation);
+  float x = q.x;
+  float y = q.y;
+  float z = q.z;
+  float w = q.w;
+  mat3 m = mat3(
+      vec3(1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + w * z),
+           2.0 * (x * z - w * y)) * s.x,
+      vec3(2.0 * (x * y - w * z), 1.0 - 2.0 * (x * x + z * z),
+           2.0 * (y * z + w * x)) * s.y,
+      vec3(2.0 * (x * z + w * y), 2.0 * (y * z - w * x),
+           1.0 - 2.0 * (x * x + y * y)) * s.z);
+  covariance = m * transpose(m);
+}
+
+vec3 fetchRestSh(float index, float coefficient) {
+  vec3 t = fetchTexel(splat_sh_texture,
+                      index * frame_info.sh_texture.z + coefficient,
+                      frame_info.sh_texture.xy)
+               .rgb;
+  return mix(vec3(sh_range.x), vec3(sh_range.y), t);
+}
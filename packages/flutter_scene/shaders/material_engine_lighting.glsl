@@ -10,8 +10,10 @@ uniform FragInfo {
   vec4 emissive_factor;
   // Punctual light texture dimensions, for normalizing the shader's fetch
   // coordinates. x: parameters-texture row count (all scene lights). y/z:
-  // light-index texture width/height. (Reuses the first of the once-diffuse-SH
-  // slots, which are unused now that SH is sampled from sh_coefficients.)
+  // light-index texture width/height. w: one past the froxel grid header
+  // texel in the light-index texture, 0 without a grid. (Reuses the first of
+  // the once-diffuse-SH slots, which are unused now that SH is sampled from
+  // sh_coefficients.)
   vec4 punctual_dims;
   // Spot-shadow parameters (more of the unused SH region). x: shadow-casting
   // spot count (0 disables spot shadows; their atlas tiles follow the
@@ -194,9 +196,11 @@ uniform sampler2D ssao_texture;
 uniform sampler2D punctual_lights;
 // The per-object light-index buffer: a 2D RGBA32F texture whose texels (row
 // major, index in .r) are light rows into punctual_lights. Each object shades
-// the slice [radiance_blend.w, radiance_blend.w + radiance_blend.z). Read by
-// computed UV (punctual_dims.yz give its width/height). A white placeholder is
-// bound and never read when the per-object count is 0.
+// the slice [radiance_blend.w, radiance_blend.w + radiance_blend.z), or, when
+// the count is -1, the slice of the froxel grid cell it falls in (the grid
+// follows the per-object slices; see PunctualLightSlice). Read by computed UV
+// (punctual_dims.yz give its width/height). A white placeholder is bound and
+// never read when the per-object count is 0.
 uniform sampler2D punctual_index;
 #endif
 
@@ -676,14 +676,12 @@ vec4 EvaluateLighting(MaterialInputs material) {
   // within a frame and defeats material-sorted batching, worst on tile GPUs. A
   // coarse (per-frame-global / capability-tier) permutation that compiles the
   // loop out for sun/IBL-only scenes is a possible low-end win, but only if the
-  // never-entered loop is measured to cost occupancy on real hardware. Froxel
-  // clustering is the high-end tier (no per-draw light state).
-  // punctual_dims.x is the parameters-texture row count; 0 means the scene has
-  // no punctual lights this frame, so ignore any stale per-object count (and
-  // never divide by the zero texture height in the fetch helpers).
-  int punctual_count =
-      frag_info.punctual_dims.x < 0.5 ? 0 : int(frag_info.radiance_blend.z);
-  int punctual_offset = int(frag_info.radiance_blend.w);
+  // never-entered loop is measured to cost occupancy on real hardware. With
+  // clustered lighting the slice comes from the froxel under this fragment
+  // (no per-draw light state).
+  ivec2 punctual_slice = PunctualLightSlice();
+  int punctual_count = punctual_slice.x;
+  int punctual_offset = punctual_slice.y;
   for (int i = 0; i < MAX_PUNCTUAL_LIGHTS; i++) {
     if (i >= punctual_count) {
       break;
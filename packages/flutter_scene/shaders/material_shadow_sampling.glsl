@@ -236,7 +236,7 @@ float SampleShadow(vec3 world_pos, vec3 n) {
 // lights past the first) the loop below can shade in one draw. Must match
 // kMaxPunctualLights in lib/src/render/punctual_lights.dart. The loop is
 // unrolled to this constant bound because GLSL ES 1.00 requires a compile-time
-// loop bound; the active count (frag_info.radiance_blend.z) ends it early.
+// loop bound; the active count (PunctualLightSlice) ends it early.
 #define MAX_PUNCTUAL_LIGHTS 16
 
 // A shadow catcher's no-shadow variant declares no punctual textures (its
@@ -254,15 +254,52 @@ vec4 FetchPunctualTexel(int light_index, int col) {
   return texture(punctual_lights, uv);
 }
 
-// Reads entry `j` of the per-object light-index buffer, returning the light row
-// it points at. The buffer is a 2D texture (index in .r); `j` is decomposed to
-// a texel with the width/height in punctual_dims.yz.
-float FetchPunctualIndex(int j) {
+// Reads texel `j` of the light-index buffer. The buffer is a 2D texture; `j`
+// is decomposed to a texel with the width/height in punctual_dims.yz.
+vec4 FetchPunctualIndexTexel(int j) {
   float width = frag_info.punctual_dims.y;
   float fj = float(j);
   vec2 uv = vec2((mod(fj, width) + 0.5) / width,
                  (floor(fj / width) + 0.5) / frag_info.punctual_dims.z);
-  return texture(punctual_index, uv).r;
+  return texture(punctual_index, uv);
+}
+
+// Reads entry `j` of the per-object light-index buffer, returning the light row
+// it points at (index in .r).
+float FetchPunctualIndex(int j) { return FetchPunctualIndexTexel(j).r; }
+
+// The punctual-light slice shading this fragment: x the light count, y the
+// offset of its light rows in the index buffer. Objects carry their own slice
+// in radiance_blend.zw; a count of -1 reads the view's froxel grid instead,
+// whose header starts at texel punctual_dims.w - 1 (tiles x/y and slice count,
+// then the log-depth slice scale/bias, then one offset/count texel per
+// cluster). Mirrors LightClusterGrid.clusterAt.
+ivec2 PunctualLightSlice() {
+  // punctual_dims.x is the parameters-texture row count; 0 means the scene has
+  // no punctual lights this frame, so ignore any stale per-object count (and
+  // never divide by the zero texture height in the fetch helpers).
+  if (frag_info.punctual_dims.x < 0.5) {
+    return ivec2(0, 0);
+  }
+  if (frag_info.radiance_blend.z > -0.5) {
+    return ivec2(int(frag_info.radiance_blend.z),
+                 int(frag_info.radiance_blend.w));
+  }
+  if (frag_info.punctual_dims.w < 0.5) {
+    return ivec2(0, 0);
+  }
+  int header = int(frag_info.punctual_dims.w - 0.5);
+  vec4 grid = FetchPunctualIndexTexel(header);
+  vec4 slicing = FetchPunctualIndexTexel(header + 1);
+  vec2 uv = GetScreenUv();
+  float tile_x = clamp(floor(uv.x * grid.x), 0.0, grid.x - 1.0);
+  float tile_y = clamp(floor(uv.y * grid.y), 0.0, grid.y - 1.0);
+  float depth = max(GetFragmentViewDepth(), 1e-6);
+  float slice = clamp(floor(log(depth) * slicing.x + slicing.y), 0.0,
+                      grid.z - 1.0);
+  float cluster = (slice * grid.y + tile_y) * grid.x + tile_x;
+  vec4 cell = FetchPunctualIndexTexel(header + 2 + int(cluster + 0.5));
+  return ivec2(int(cell.g + 0.5), int(cell.r + 0.5));
 }
 #endif  // punctual fetch helpers
 
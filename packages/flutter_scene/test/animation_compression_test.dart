@@ -0,0 +1,198 @@
+/// Covers keyframe compression: quantization stays within a step, the
+/// byte layout round-trips and rejects truncation, key removal keeps what
+/// interpolation cannot rebuild, and [PropertyResolver.makeCompressedTimeline]
+/// samples like the float resolvers within the reported error.
+library;
+
+import 'dart:math';
+import 'dart:typed_data';
+
+// The channel/resolver data model is internal; tests reach it directly.
+// ignore: implementation_imports
+import 'package:flutter_scene/src/animation.dart'
+    show
+        AnimationProperty,
+        AnimationTransforms,
+        DecomposedTransform,
+        PropertyResolver;
+// ignore: implementation_imports
+import 'package:flutter_scene/src/animation_compression.dart';
+import 'package:test/test.dart';
+import 'package:vector_math/vector_math.dart';
+
+Float32List _randomRotations(Random random, int count) {
+  final out = Float32List(count * 4);
+  for (var i = 0; i < count; i++) {
+    final axis = Vector3(
+      random.nextDouble() - 0.5,
+      random.nextDouble() - 0.5,
+      random.nextDouble() - 0.5,
+    )..normalize();
+    final q = Quaternion.axisAngle(axis, random.nextDouble() * 2 * pi);
+    out.setAll(i * 4, q.storage);
+  }
+  return out;
+}
+
+// The angle between two rotations, in radians.
+double _angle(List<double> a, List<double> b) {
+  var dot = 0.0;
+  for (var c = 0; c < 4; c++) {
+    dot += a[c] * b[c];
+  }
+  return 2 * acos(min(1.0, dot.abs()));
+}
+
+AnimationTransforms _target() {
+  final rest = DecomposedTransform.fromMatrix(Matrix4.identity());
+  return AnimationTransforms(bindPose: rest)..animatedPose = rest.clone();
+}
+
+void main() {
+  test('quantizes within a step of each component', () {
+    final random = Random(3);
+    final rotations = _randomRotations(random, 200);
+    final decoded = CompressedKeyframes.rotation(rotations).decodeAll();
+    for (var i = 0; i < 200; i++) {
+      expect(
+        _angle(
+          rotations.sublist(i * 4, i * 4 + 4),
+          decoded.sublist(i * 4, i * 4 + 4),
+        ),
+        lessThan(2e-4),
+      );
+    }
+
+    final vectors = Float32List.fromList([
+      for (var i = 0; i < 300; i++) random.nextDouble() * 20 - 10,
+    ]);
+    final unpacked = CompressedKeyframes.vector3(vectors).decodeAll();
+    for (var i = 0; i < vectors.length; i++) {
+      expect(unpacked[i], closeTo(vectors[i], 20 / 0xffff));
+    }
+  });
+
+  test('bytes round-trip and reject truncation', () {
+    final keyframes = CompressedKeyframes.vector3(
+      Float32List.fromList([1, 2, 3, 4, 5, 6, -1, 0, 1]),
+    );
+    final bytes = keyframes.toBytes();
+    expect(bytes.length, keyframes.lengthInBytes);
+    final read = CompressedKeyframes.fromBytes(bytes);
+    expect(read.kind, CompressedKeyframesKind.vector3);
+    expect(read.count, 3);
+    expect(read.decodeAll(), keyframes.decodeAll());
+
+    expect(
+      () => CompressedKeyframes.fromBytes(bytes.sublist(0, bytes.length - 2)),
+      throwsFormatException,
+    );
+    expect(
+      () => CompressedKeyframes.fromBytes(Uint8List(4)),
+      throwsFormatException,
+    );
+    expect(
+      () => CompressedKeyframes.fromBytes(Uint8List.fromList(bytes)..[0] = 9),
+      throwsFormatException,
+    );
+  });
+
+  test('drops the keys interpolation rebuilds', () {
+    final times = Float32List.fromList([for (var i = 0; i < 100; i++) i / 30]);
+    final ramp = Float32List.fromList([
+      for (var i = 0; i < 100; i++) ...[i * 0.1, 1, -i * 0.05],
+    ]);
+    final straight = compressChannel(
+      times,
+      ramp,
+      kind: CompressedKeyframesKind.vector3,
+      tolerance: 1e-3,
+    );
+    expect(straight.times, [times.first, times.last]);
+    expect(straight.maxError, lessThan(1e-3));
+
+    // A kink in the middle has to stay.
+    final bent = Float32List.fromList([
+      for (var i = 0; i < 100; i++) ...[(50 - (i - 50).abs()) * 0.1, 0, 0],
+    ]);
+    final kinked = compressChannel(
+      times,
+      bent,
+      kind: CompressedKeyframesKind.vector3,
+      tolerance: 1e-3,
+    );
+    expect(kinked.times, contains(times[50]));
+    expect(kinked.times.length, lessThan(6));
+  });
+
+  test('compressed timelines sample like the float resolvers', () {
+    final random = Random(7);
+    final times = [for (var i = 0; i < 120; i++) i / 30];
+    // Smooth motion with a little noise, as captured animation has.
+    final rotations = Float32List(times.length * 4);
+    final translations = Float32List(times.length * 3);
+    for (var i = 0; i < times.length; i++) {
+      final angle = sin(times[i] * 2) + random.nextDouble() * 1e-3;
+      rotations.setAll(
+        i * 4,
+        Quaternion.axisAngle(Vector3(0, 1, 0), angle).storage,
+      );
+      translations.setAll(i * 3, [cos(times[i]), times[i], 0]);
+    }
+    const tolerance = 1e-2;
+    for (final (property, values) in [
+      (AnimationProperty.rotation, rotations),
+      (AnimationProperty.translation, translations),
+    ]) {
+      final rotation = property == AnimationProperty.rotation;
+      final compressed = compressChannel(
+        Float32List.fromList(times),
+        values,
+        kind: rotation
+            ? CompressedKeyframesKind.rotation
+            : CompressedKeyframesKind.vector3,
+        tolerance: tolerance,
+      );
+      expect(compressed.times.length, lessThan(times.length ~/ 2));
+      expect(compressed.maxError, lessThan(tolerance * 1.1));
+
+      final reference = rotation
+          ? PropertyResolver.makeRotationTimeline(times, [
+              for (var i = 0; i < times.length; i++)
+                Quaternion.fromFloat64List(
+                  Float64List.fromList(values.sublist(i * 4, i * 4 + 4)),
+                ),
+            ])
+          : PropertyResolver.makeTranslationTimeline(times, [
+              for (var i = 0; i < times.length; i++)
+                Vector3(values[i * 3], values[i * 3 + 1], values[i * 3 + 2]),
+            ]);
+      final resolver = PropertyResolver.makeCompressedTimeline(
+        property,
+        compressed.times,
+        compressed.keyframes,
+      );
+      expect(resolver.getEndTime(), closeTo(reference.getEndTime(), 1e-6));
+      for (var t = 0.0; t < times.last; t += 0.0123) {
+        final want = _target();
+        final got = _target();
+        reference.apply(want, t, 1);
+        resolver.apply(got, t, 1);
+        if (rotation) {
+          expect(
+            _angle(
+              want.animatedPose.rotation.storage,
+              got.animatedPose.rotation.storage,
+            ),
+            lessThan(tolerance * 2),
+          );
+        } else {
+          final error = (want.animatedPose.translation -
+                  got.animatedPose.translation)
+              .length;
+          expect(error, lessThan(tolerance * 2));
+        }
+      }
+    }
+  });
+}
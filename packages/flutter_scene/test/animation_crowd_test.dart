@@ -0,0 +1,178 @@
+/// Covers [AnimationCrowd]'s pose sharing: members in one time bucket draw
+/// one shared pose, the shared matrices place the mesh where the member's
+/// own skeleton would, held poses are not evaluated again, and removing a
+/// member hands its skin back. No GPU: poses are uploaded only when drawn.
+library;
+
+import 'dart:typed_data';
+
+import 'package:flutter_scene/scene.dart';
+// The channel/resolver data model is internal; tests reach it directly.
+// ignore: implementation_imports
+import 'package:flutter_scene/src/animation.dart'
+    show AnimationChannel, AnimationProperty, BindKey, PropertyResolver;
+import 'package:test/test.dart';
+import 'package:vector_math/vector_math.dart';
+
+final _times = [for (var i = 0; i < 31; i++) i / 10];
+
+Animation _wave() => Animation(
+  name: 'wave',
+  channels: [
+    AnimationChannel(
+      bindTarget: BindKey(
+        nodeName: 'hip',
+        property: AnimationProperty.rotation,
+      ),
+      resolver: PropertyResolver.makeRotationTimeline(_times, [
+        for (final t in _times) Quaternion.axisAngle(Vector3(0, 0, 1), t),
+      ]),
+    ),
+    AnimationChannel(
+      bindTarget: BindKey(nodeName: 'knee'),
+      resolver: PropertyResolver.makeTranslationTimeline(_times, [
+        for (final t in _times) Vector3(0, 1 + t * 0.1, 0),
+      ]),
+    ),
+  ],
+);
+
+/// A root with a two-joint chain and a skinned body node beside it.
+Node _template() {
+  final root = Node(name: 'character');
+  final hip = Node(name: 'hip');
+  final knee = Node(
+    name: 'knee',
+    localTransform: Matrix4.translationValues(0, 1, 0),
+  );
+  hip.add(knee);
+  final body = Node(
+    name: 'body',
+    localTransform: Matrix4.translationValues(0.5, 0, 0),
+  );
+  body.skin = Skin()
+    ..joints.addAll([hip, knee])
+    ..inverseBindMatrices.addAll([
+      Matrix4.identity(),
+      Matrix4.translationValues(0, -1, 0),
+    ]);
+  root
+    ..add(hip)
+    ..add(body);
+  return root;
+}
+
+Skin _skinOf(Node character) => character.getChildByName('body')!.skin!;
+
+void main() {
+  test('members in one time bucket share a pose', () {
+    final template = _template();
+    final animation = _wave();
+    final crowd = AnimationCrowd(timeStep: 0.1);
+    final members = [
+      for (final time in [0.0, 0.02, 0.05, 1.03, 2.5])
+        crowd.add(
+          template.clone(),
+          template: template,
+          animation: animation,
+          time: time,
+        ),
+    ];
+
+    crowd.update(0.01);
+
+    expect(crowd.poseCount, 3);
+    expect(crowd.evaluatedPoseCount, 3);
+    final poses = [for (final m in members) _skinOf(m.character).sharedPose];
+    expect(poses, everyElement(isNotNull));
+    expect(poses[1], same(poses[0]));
+    expect(poses[2], same(poses[0]));
+    expect(poses[3], isNot(same(poses[0])));
+    expect(poses[4], isNot(same(poses[3])));
+  });
+
+  test('shared matrices match the member posed by its own skeleton', () {
+    final template = _template();
+    final animation = _wave();
+    final crowd = AnimationCrowd(timeStep: 0.25);
+    final character = template.clone()
+      ..localTransform = Matrix4.translationValues(4, 0, -2);
+    final member = crowd.add(
+      character,
+      template: template,
+      animation: animation,
+      time: 1.3,
+    );
+    crowd.update(0);
+
+    // Pose a second clone directly at the bucket's time.
+    final reference = template.clone()
+      ..localTransform = character.localTransform.clone();
+    final clip = reference.createAnimationClip(animation)..seek(1.25);
+    reference.scenePrePass(0);
+    expect(clip.playbackTime, 1.25);
+    final expected = Float32List(32);
+    _skinOf(reference).writeJointMatrices(expected);
+
+    final body = character.getChildByName('body')!;
+    final shared = _skinOf(member.character).sharedPose!.matrices;
+    for (var joint = 0; joint < 2; joint++) {
+      final world =
+          body.globalTransform *
+          Matrix4.fromFloat32List(shared.sublist(joint * 16, joint * 16 + 16));
+      for (var i = 0; i < 16; i++) {
+        expect(world.storage[i], closeTo(expected[joint * 16 + i], 1e-5));
+      }
+    }
+  });
+
+  test('held poses are not evaluated again', () {
+    final template = _template();
+    final animation = _wave();
+    final crowd = AnimationCrowd(timeStep: 0.5);
+    for (var i = 0; i < 20; i++) {
+      crowd.add(
+        template.clone(),
+        template: template,
+        animation: animation,
+        time: (i % 2) * 0.5,
+      );
+    }
+    crowd.update(0.01);
+    expect(crowd.poseCount, 2);
+    expect(crowd.evaluatedPoseCount, 2);
+    crowd.update(0.01);
+    expect(crowd.poseCount, 2);
+    expect(crowd.evaluatedPoseCount, 0);
+  });
+
+  test('removing a member returns its skin to its own joints', () {
+    final template = _template();
+    final crowd = AnimationCrowd();
+    final member = crowd.add(
+      template.clone(),
+      template: template,
+      animation: _wave(),
+    );
+    crowd.update(0.1);
+    expect(_skinOf(member.character).sharedPose, isNotNull);
+
+    crowd.remove(member);
+    expect(_skinOf(member.character).sharedPose, isNull);
+    expect(crowd.members, isEmpty);
+    crowd.update(0.1);
+    expect(crowd.poseCount, 0);
+  });
+
+  test('rejects characters without the template skeleton', () {
+    final template = _template();
+    expect(
+      () => AnimationCrowd().add(
+        Node(name: 'stranger'),
+        template: template,
+        animation: _wave(),
+      ),
+      throwsArgumentError,
+    );
+  });
+}
@@ -0,0 +1,152 @@
+/// Covers animation level of detail: policies pick an interval by
+/// projected size, off-screen characters freeze while their clips keep
+/// time unless a shadow map sees them, reduced rates ease one interval
+/// behind the evaluations, and
+/// [AnimationPlayer.skippedEvaluations] counts what was skipped.
+library;
+
+import 'dart:math';
+
+import 'package:flutter_scene/scene.dart';
+// The channel/resolver data model is internal; tests reach it directly.
+// ignore: implementation_imports
+import 'package:flutter_scene/src/animation.dart'
+    show AnimationChannel, BindKey, PropertyResolver;
+import 'package:test/test.dart';
+import 'package:vector_math/vector_math.dart';
+
+final _times = [for (var i = 0; i <= 100; i++) i / 10];
+
+// Slides the hip along x at one unit a second.
+Animation _slide() => Animation(
+  name: 'slide',
+  channels: [
+    AnimationChannel(
+      bindTarget: BindKey(nodeName: 'hip'),
+      resolver: PropertyResolver.makeTranslationTimeline(_times, [
+        for (final t in _times) Vector3(t, 0, 0),
+      ]),
+    ),
+  ],
+);
+
+(Node, Node, AnimationClip) _character() {
+  final root = Node(name: 'character');
+  final hip = Node(name: 'hip');
+  root.add(hip);
+  final clip = root.createAnimationClip(_slide())..play();
+  return (root, hip, clip);
+}
+
+double _x(Node node) => node.localTransform.getTranslation().x;
+
+LodView _view({double? fovRadiansY = pi / 2}) => (
+  position: Vector3.zero(),
+  fovRadiansY: fovRadiansY,
+  frustum: Frustum.matrix(
+    makePerspectiveMatrix(pi / 2, 1, 0.1, 100) *
+        makeViewMatrix(Vector3.zero(), Vector3(0, 0, -1), Vector3(0, 1, 0)),
+  ),
+  shadow: false,
+);
+
+// A light looking down -x over a box around the origin.
+LodView _shadow() => (
+  position: Vector3.zero(),
+  fovRadiansY: null,
+  frustum: Frustum.matrix(
+    makeOrthographicMatrix(-20, 20, -20, 20, 0.1, 100) *
+        makeViewMatrix(Vector3(50, 0, 0), Vector3.zero(), Vector3(0, 1, 0)),
+  ),
+  shadow: true,
+);
+
+void main() {
+  test('intervals follow projected size', () {
+    const policy = AnimationLodPolicy(radius: 1);
+    expect(policy.intervalFor(double.infinity), 1);
+    expect(policy.intervalFor(0.2), 1);
+    expect(policy.intervalFor(0.1), 2);
+    expect(policy.intervalFor(0.03), 4);
+    expect(policy.intervalFor(0.001), 8);
+    expect(policy.intervalFor(0), 0);
+
+    const visibleOnly = AnimationLodPolicy(radius: 1, freezeOffscreen: false);
+    expect(visibleOnly.intervalFor(0), 8);
+  });
+
+  test('measures against the views that can see the sphere', () {
+    const policy = AnimationLodPolicy(radius: 1);
+    final ahead = Vector3(0, 0, -10);
+    expect(policy.measure(ahead, const []), double.infinity);
+    // A 90 degree view spans 20 units at a depth of 10.
+    expect(policy.measure(ahead, [_view()]), closeTo(0.1, 1e-9));
+    expect(policy.measure(Vector3(0, 0, 10), [_view()]), 0);
+    expect(policy.measure(ahead, [_view(fovRadiansY: null)]), double.infinity);
+  });
+
+  test('a shadow view keeps an unseen character animating slowly', () {
+    const policy = AnimationLodPolicy(radius: 1);
+    final behind = Vector3(0, 0, 10);
+    final size = policy.measure(behind, [_view(), _shadow()]);
+    expect(size, greaterThan(0));
+    expect(policy.intervalFor(size), 8);
+    // Where the camera sees it, the shadow view does not change its size.
+    final ahead = Vector3(0, 0, -10);
+    expect(policy.measure(ahead, [_view(), _shadow()]), closeTo(0.1, 1e-9));
+    // Outside the light's box too, it freezes.
+    expect(policy.measure(Vector3(0, 0, 40), [_view(), _shadow()]), 0);
+  });
+
+  test('off-screen players keep time without evaluating', () {
+    final (root, hip, clip) = _character();
+    final player = root.animationPlayer!
+      ..lodPolicy = const AnimationLodPolicy(radius: 1);
+    player.update(0.5);
+    expect(_x(hip), closeTo(0.5, 1e-6));
+
+    for (var i = 0; i < 3; i++) {
+      player.update(0.5, screenSize: 0);
+      expect(player.skippedEvaluations, 1);
+    }
+    expect(clip.playbackTime, closeTo(2, 1e-6));
+    expect(_x(hip), closeTo(0.5, 1e-6));
+
+    // Back in view, the pose catches up at once.
+    player.update(0.5);
+    expect(player.skippedEvaluations, 0);
+    expect(_x(hip), closeTo(2.5, 1e-6));
+  });
+
+  test('reduced rates ease one interval behind the evaluations', () {
+    const dt = 0.1;
+    final (root, hip, clip) = _character();
+    final player = root.animationPlayer!
+      ..lodPolicy = const AnimationLodPolicy(radius: 1);
+    // Every fourth frame.
+    const screenSize = 0.03;
+
+    final skipped = <int>[];
+    final positions = <double>[];
+    for (var frame = 0; frame < 12; frame++) {
+      player.update(dt, screenSize: screenSize);
+      skipped.add(player.skippedEvaluations);
+      positions.add(_x(hip));
+    }
+    expect(skipped, [0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1]);
+    expect(clip.playbackTime, closeTo(1.2, 1e-6));
+    // The first interval holds the first evaluation; after it, every frame
+    // shows the pose from four frames earlier.
+    for (var frame = 0; frame < 4; frame++) {
+      expect(positions[frame], closeTo(0.1, 1e-6));
+    }
+    for (var frame = 4; frame < 12; frame++) {
+      expect(positions[frame], closeTo((frame - 3) * dt, 1e-6));
+    }
+
+    // At full size it evaluates every frame again, on time.
+    player.update(dt);
+    expect(player.skippedEvaluations, 0);
+    expect(_x(hip), closeTo(1.3, 1e-6));
+  });
+}
@@ -0,0 +1,219 @@
+/// Covers [AnimationPlayer]'s pose buffer path: blends match applying each
+/// channel's resolver to per-node transforms (the rule
+/// [PropertyResolver.apply] defines), keyframe cursors survive seeks and
+/// loop wraps, custom resolvers still blend in channel order, and a
+/// steady frame reuses the transforms it hands the nodes.
+library;
+
+import 'package:flutter_scene/scene.dart';
+// The channel/resolver data model is internal; tests reach it directly.
+// ignore: implementation_imports
+import 'package:flutter_scene/src/animation.dart'
+    show
+        AnimationChannel,
+        AnimationProperty,
+        AnimationTransforms,
+        BindKey,
+        DecomposedTransform,
+        PropertyResolver;
+import 'package:test/test.dart';
+import 'package:vector_math/vector_math.dart';
+
+/// Offsets the translation by a fixed amount, ignoring time.
+class _NudgeResolver implements PropertyResolver {
+  @override
+  double getEndTime() => 0;
+
+  @override
+  void apply(AnimationTransforms target, double timeInSeconds, double weight) {
+    target.animatedPose.translation.x += 0.25 * weight;
+  }
+}
+
+const _bones = ['hip', 'knee', 'foot'];
+
+// A long, uneven timeline so cursors walk many keys.
+final _times = [for (var i = 0; i < 40; i++) i * 0.05 + (i.isOdd ? 0.01 : 0)];
+
+Animation _walk(String name, double phase, {bool nudge = false}) {
+  final channels = <AnimationChannel>[];
+  for (var b = 0; b < _bones.length; b++) {
+    final bone = _bones[b];
+    double wave(int i) => phase + b + i * 0.3;
+    channels.addAll([
+      AnimationChannel(
+        bindTarget: BindKey(nodeName: bone),
+        resolver: PropertyResolver.makeTranslationTimeline(_times, [
+          for (var i = 0; i < _times.length; i++)
+            Vector3(wave(i) % 1, (wave(i) * 2) % 1.5, b.toDouble()),
+        ]),
+      ),
+      AnimationChannel(
+        bindTarget: BindKey(
+          nodeName: bone,
+          property: AnimationProperty.rotation,
+        ),
+        resolver: PropertyResolver.makeRotationTimeline(_times, [
+          for (var i = 0; i < _times.length; i++)
+            Quaternion.axisAngle(Vector3(0, 1, 1)..normalize(), wave(i)),
+        ]),
+      ),
+      AnimationChannel(
+        bindTarget: BindKey(nodeName: bone, property: AnimationProperty.scale),
+        resolver: PropertyResolver.makeScaleTimeline(_times, [
+          for (var i = 0; i < _times.length; i++)
+            Vector3.all(1 + (wave(i) % 0.5)),
+        ]),
+      ),
+      if (nudge)
+        AnimationChannel(
+          bindTarget: BindKey(nodeName: bone),
+          resolver: _NudgeResolver(),
+        ),
+    ]);
+  }
+  return Animation(name: name, channels: channels);
+}
+
+Node _rig() {
+  final root = Node(name: 'root');
+  Node parent = root;
+  for (final name in _bones) {
+    final bone = Node(
+      name: name,
+      localTransform: Matrix4.compose(
+        Vector3(0, 1, 0),
+        Quaternion.axisAngle(Vector3(1, 0, 0), 0.2),
+        Vector3.all(1),
+      ),
+    );
+    parent.add(bone);
+    parent = bone;
+  }
+  return root;
+}
+
+/// Blends [clips] onto fresh copies of [bindPoses] by applying every
+/// channel's resolver in order, the player's rule.
+Map<String, DecomposedTransform> _reference(
+  Map<String, DecomposedTransform> bindPoses,
+  List<(Animation, double time, double weight)> clips,
+) {
+  final targets = {
+    for (final entry in bindPoses.entries)
+      entry.key: AnimationTransforms(bindPose: entry.value)
+        ..animatedPose = entry.value.clone(),
+  };
+  final total = clips.fold(0.0, (sum, clip) => sum + clip.$3);
+  final multiplier = total > 1 ? 1 / total : 1.0;
+  for (final (animation, time, weight) in clips) {
+    for (final channel in animation.channels) {
+      channel.resolver.apply(
+        targets[channel.bindTarget.nodeName]!,
+        time,
+        weight * multiplier,
+      );
+    }
+  }
+  return {
+    for (final entry in targets.entries) entry.key: entry.value.animatedPose,
+  };
+}
+
+void _expectPose(Node root, Map<String, DecomposedTransform> expected) {
+  for (final entry in expected.entries) {
+    final actual = root.getChildByName(entry.key)!.localTransformTrs!;
+    final want = entry.value;
+    for (var i = 0; i < 3; i++) {
+      expect(actual.translation[i], closeTo(want.translation[i], 1e-4));
+      expect(actual.scale[i], closeTo(want.scale[i], 1e-4));
+    }
+    for (var i = 0; i < 4; i++) {
+      expect(actual.rotation[i], closeTo(want.rotation[i], 1e-4));
+    }
+  }
+}
+
+void main() {
+  test('blends match applying each resolver in order', () {
+    final root = _rig();
+    final bindPoses = {
+      for (final name in _bones)
+        name: DecomposedTransform.fromMatrix(
+          root.getChildByName(name)!.localTransform,
+        ),
+    };
+    final walk = _walk('walk', 0);
+    final run = _walk('run', 0.7, nudge: true);
+    final a = root.createAnimationClip(walk)
+      ..loop = true
+      ..weight = 0.8
+      ..play();
+    final b = root.createAnimationClip(run)
+      ..loop = true
+      ..weight = 0.6
+      ..playbackTimeScale = 1.7
+      ..play();
+
+    // Steady playback through a loop wrap, then seeks in both directions.
+    for (var frame = 0; frame < 150; frame++) {
+      if (frame == 90) a.seek(0.2);
+      if (frame == 120) b.seek(1.9);
+      root.scenePrePass(1 / 60);
+      _expectPose(
+        root,
+        _reference(bindPoses, [
+          (walk, a.playbackTime, a.weight),
+          (run, b.playbackTime, b.weight),
+        ]),
+      );
+    }
+  });
+
+  test('a steady frame reuses the transforms it hands the nodes', () {
+    final root = _rig();
+    root.createAnimationClip(_walk('walk', 0))
+      ..loop = true
+      ..play();
+    root.scenePrePass(1 / 60);
+    final knee = root.getChildByName('knee')!;
+    final matrix = knee.localTransform;
+    final trs = knee.localTransformTrs;
+    final before = matrix.clone();
+
+    root.scenePrePass(1 / 60);
+
+    expect(knee.localTransform, same(matrix));
+    expect(knee.localTransformTrs, same(trs));
+    expect(knee.localTransform, isNot(before));
+    expect(knee.localTransform, trs!.toMatrix4());
+  });
+
+  test('adding a clip mid-playback keeps the recorded bind pose', () {
+    final root = _rig();
+    final knee = root.getChildByName('knee')!;
+    final bindPoses = {
+      for (final name in _bones)
+        name: DecomposedTransform.fromMatrix(
+          root.getChildByName(name)!.localTransform,
+        ),
+    };
+    final walk = _walk('walk', 0);
+    final a = root.createAnimationClip(walk)..play();
+    root.scenePrePass(0.3);
+    expect(knee.localTransformTrs!.translation.z, closeTo(1, 1e-6));
+
+    final run = _walk('run', 0.4);
+    final b = root.createAnimationClip(run)
+      ..weight = 0.5
+      ..play();
+    root.scenePrePass(0.1);
+    _expectPose(
+      root,
+      _reference(bindPoses, [
+        (walk, a.playbackTime, a.weight),
+        (run, b.playbackTime, b.weight),
+      ]),
+    );
+  });
+}
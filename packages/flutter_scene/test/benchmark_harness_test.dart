@@ -0,0 +1,99 @@
+// Covers the benchmark harness: results round-trip through JSON, the
+// runner honours its run bounds and filter, and the baseline comparison
+// flags only cases slower than the threshold above the noise floor.
+
+import 'package:flutter_test/flutter_test.dart';
+
+import '../benchmark/harness.dart';
+
+BenchmarkResult _result(String name, double medianMicros, {int size = 1000}) =>
+    BenchmarkResult(
+      name: name,
+      size: size,
+      runs: 5,
+      medianMicros: medianMicros,
+      minMicros: medianMicros,
+      meanMicros: medianMicros,
+    );
+
+void main() {
+  test('reports round-trip through JSON', () {
+    final report = BenchmarkReport(
+      [
+        _result('bvh.build', 123.4567),
+        BenchmarkResult(
+          name: 'splats.pack.compact',
+          size: 10,
+          runs: 3,
+          medianMicros: 1,
+          minMicros: 1,
+          meanMicros: 1,
+          metrics: {'bytesPerSplat': 16.5},
+        ),
+      ],
+      environment: {'dart': '3.10.0'},
+    );
+    final restored = BenchmarkReport.decode(report.encode());
+    expect(restored.environment, {'dart': '3.10.0'});
+    final result = restored.results.first;
+    expect(result.key, 'bvh.build/1000');
+    expect(result.medianMicros, closeTo(123.457, 1e-9));
+    expect(result.runs, 5);
+    expect(result.metrics, isEmpty);
+    expect(restored.results.last.metrics, {'bytesPerSplat': 16.5});
+    expect(
+      () => BenchmarkReport.fromJson({'schema': 99, 'results': []}),
+      throwsFormatException,
+    );
+  });
+
+  test('runs between the run bounds and honours the filter', () {
+    var calls = 0;
+    final runner = BenchmarkRunner(
+      minDuration: Duration.zero,
+      minRuns: 4,
+      filter: 'bvh',
+    );
+    runner.run('bvh.query', 10, () => calls++);
+    runner.run('splats.sort', 10, () => calls++);
+    // One warm-up run plus the timed ones; the filtered case never runs.
+    expect(calls, 5);
+    expect(runner.results.single.runs, 4);
+
+    final capped = BenchmarkRunner(
+      minDuration: const Duration(hours: 1),
+      maxRuns: 7,
+    )..run('capped', 1, () {});
+    expect(capped.results.single.runs, 7);
+  });
+
+  test('times asynchronous cases to completion', () async {
+    var completed = 0;
+    final runner = BenchmarkRunner(minDuration: Duration.zero, minRuns: 3);
+    await runner.runAsync('splats.sortService.w2', 10, () async {
+      await Future<void>.delayed(Duration.zero);
+      completed++;
+    });
+    expect(completed, 4);
+    expect(runner.results.single.key, 'splats.sortService.w2/10');
+  });
+
+  test('flags regressions past the threshold above the noise floor', () {
+    final baseline = BenchmarkReport([
+      _result('a', 100),
+      _result('b', 100),
+      _result('c', 0.5),
+      _result('a', 100, size: 10000),
+    ]);
+    final current = BenchmarkReport([
+      _result('a', 109),
+      _result('b', 125),
+      _result('c', 5),
+      _result('d', 1000),
+    ]);
+    final regressions = compareToBaseline(current, baseline, threshold: 0.1);
+    expect(regressions.map((r) => r.current.key), ['b/1000']);
+    expect(regressions.single.ratio, closeTo(1.25, 1e-9));
+    expect(regressions.single.toString(), contains('+25.0%'));
+  });
+}
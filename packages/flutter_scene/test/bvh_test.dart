@@ -1,9 +1,12 @@
 // BVH tests. Builds a Bvh over RenderItems with stub geometry/material
 // and checks that query agrees with a brute-force frustum test.
 
+import 'dart:math' as math;
+
 import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
 import 'package:flutter_scene/scene.dart';
 import 'package:flutter_scene/src/render/bvh.dart';
+import 'package:flutter_scene/src/render/dynamic_bvh.dart';
 import 'package:flutter_scene/src/render/render_scene.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:vector_math/vector_math.dart';
@@ -55,6 +58,14 @@ RenderItem _itemAt(double x) {
     );
 }
 
+/// Moves [item]'s unit AABB to be centered at ([x], [y], [z]).
+void _moveTo(RenderItem item, double x, double y, double z) {
+  item.worldBounds = Aabb3.minMax(
+    Vector3(x - 0.5, y - 0.5, z - 0.5),
+    Vector3(x + 0.5, y + 0.5, z + 0.5),
+  );
+}
+
 void main() {
   group('Bvh', () {
     test('an empty BVH yields nothing', () {
@@ -174,6 +185,278 @@ void main() {
       ).queryAabb(Aabb3.minMax(Vector3.zero(), Vector3.all(1)), hits.add);
       expect(hits, isEmpty);
     });
+
+    test('a retired leaf is skipped by queries and refit', () {
+      final items = [for (int i = 0; i < 4; i++) _itemAt(i * 4.0)];
+      final bvh = Bvh.build(items);
+      final retired = [
+        for (var leaf = 0; leaf < bvh.leafCount; leaf++)
+          if (identical(bvh.leafItem(leaf), items[1])) leaf,
+      ].single;
+      bvh.retireLeaf(retired);
+      items[1].worldBounds = null;
+      bvh.refit();
+
+      final hits = <RenderItem>{};
+      bvh.query(
+        Frustum.matrix(
+          makeOrthographicMatrix(-1000, 1000, -1000, 1000, -1000, 1000),
+        ),
+        hits.add,
+      );
+      expect(hits, {items[0], items[2], items[3]});
+      expect(bvh.retiredLeafCount, 1);
+    });
+  });
+
+  group('queryMany', () {
+    // Views spread over the item field, enough to span two traversal
+    // batches, some with an extra clip plane.
+    List<Frustum> views(int count) => [
+      for (var v = 0; v < count; v++)
+        Frustum.matrix(
+          makeOrthographicMatrix(
+            v * 3.0 - 10,
+            v * 3.0 + 6,
+            -10 + (v % 3) * 4.0,
+            10,
+            -100,
+            100,
+          ),
+        ),
+    ];
+    List<List<Plane>> clipPlanes(int count) => [
+      for (var v = 0; v < count; v++)
+        if (v % 4 == 1) [Plane.components(-1, 0, 0, v * 3.0)] else const [],
+    ];
+
+    void expectMatchesRepeatedQuery(BvhQueries bvh, int viewCount) {
+      final frustums = views(viewCount);
+      final planes = clipPlanes(viewCount);
+      final visible = [for (var v = 0; v < viewCount; v++) <RenderItem>[]];
+      bvh.queryMany(frustums, visible, additionalPlanes: planes);
+      for (var v = 0; v < viewCount; v++) {
+        final expected = <RenderItem>[];
+        bvh.query(frustums[v], expected.add, additionalPlanes: planes[v]);
+        expect(visible[v].toSet(), expected.toSet(), reason: 'view $v');
+        expect(visible[v].length, expected.length, reason: 'view $v');
+      }
+    }
+
+    final items = [
+      for (int i = 0; i < 64; i++)
+        _renderItem()..worldBounds = Aabb3.minMax(
+          Vector3(i * 2.0 - 0.5, (i % 5) * 2.0 - 5, -0.5),
+          Vector3(i * 2.0 + 0.5, (i % 5) * 2.0 - 4, 0.5),
+        ),
+    ];
+
+    test('a static BVH matches repeated query calls', () {
+      expectMatchesRepeatedQuery(Bvh.build(items), 6);
+      expectMatchesRepeatedQuery(Bvh.build(items), 40);
+    });
+
+    test('a dynamic BVH matches repeated query calls', () {
+      final tree = DynamicBvh();
+      for (final item in items) {
+        tree.insert(item, item.worldBounds!);
+      }
+      expectMatchesRepeatedQuery(tree, 40);
+    });
+
+    test('RenderScene.cullMany adds always-visible items to every view', () {
+      final scene = RenderScene();
+      final bounded = _itemAt(0);
+      final unbounded = _renderItem();
+      scene.add(bounded);
+      scene.add(unbounded);
+      scene.rebuildIfDirty();
+
+      final frustums = [
+        Frustum.matrix(makeOrthographicMatrix(-5, 5, -5, 5, -5, 5)),
+        Frustum.matrix(makeOrthographicMatrix(500, 510, 500, 510, -1, 1)),
+      ];
+      final visible = [<RenderItem>[], <RenderItem>[]];
+      scene.cullMany(frustums, visible);
+      expect(visible[0].toSet(), {bounded, unbounded});
+      expect(visible[1], [unbounded]);
+    });
+  });
+
+  group('DynamicBvh', () {
+    test('tracks random inserts, moves, and removals', () {
+      final random = math.Random(7);
+      final tree = DynamicBvh();
+      final proxies = <RenderItem, int>{};
+      double coordinate() => random.nextDouble() * 200 - 100;
+
+      for (var step = 0; step < 2000; step++) {
+        final roll = random.nextInt(10);
+        if (roll < 4 || proxies.isEmpty) {
+          final item = _renderItem();
+          _moveTo(item, coordinate(), coordinate(), coordinate());
+          proxies[item] = tree.insert(item, item.worldBounds!);
+        } else if (roll < 8) {
+          final item = proxies.keys.elementAt(random.nextInt(proxies.length));
+          // Mix small jitters (inside the fattened box) with long jumps.
+          final b = item.worldBounds!;
+          final jump = random.nextBool() ? 0.02 : 40.0;
+          _moveTo(
+            item,
+            (b.min.x + 0.5) + (random.nextDouble() - 0.5) * jump,
+            (b.min.y + 0.5) + (random.nextDouble() - 0.5) * jump,
+            (b.min.z + 0.5) + (random.nextDouble() - 0.5) * jump,
+          );
+          tree.move(proxies[item]!, item.worldBounds!);
+        } else {
+          final item = proxies.keys.elementAt(random.nextInt(proxies.length));
+          tree.remove(proxies.remove(item)!);
+        }
+      }
+      expect(tree.length, proxies.length);
+
+      for (var probe = 0; probe < 20; probe++) {
+        final x = coordinate(), y = coordinate(), z = coordinate();
+        final box = Aabb3.minMax(
+          Vector3(x - 20, y - 20, z - 20),
+          Vector3(x + 20, y + 20, z + 20),
+        );
+        final expected = proxies.keys
+            .where((i) => i.worldBounds!.intersectsWithAabb3(box))
+            .toSet();
+        final hits = <RenderItem>{};
+        tree.queryAabb(box, hits.add);
+        expect(hits, expected);
+
+        final frustum = Frustum.matrix(
+          makeOrthographicMatrix(x - 30, x + 30, y - 30, y + 30, -200, 200),
+        );
+        final frustumExpected = proxies.keys
+            .where((i) => frustum.intersectsWithAabb3(i.worldBounds!))
+            .toSet();
+        final frustumHits = <RenderItem>{};
+        tree.query(frustum, frustumHits.add);
+        expect(frustumHits, frustumExpected);
+      }
+    });
+
+    test('a move within the margin does not reinsert', () {
+      final tree = DynamicBvh();
+      final item = _itemAt(0);
+      final proxy = tree.insert(item, item.worldBounds!);
+      _moveTo(item, 0.01, 0, 0);
+      expect(tree.move(proxy, item.worldBounds!), isFalse);
+      _moveTo(item, 10, 0, 0);
+      expect(tree.move(proxy, item.worldBounds!), isTrue);
+    });
+
+    test('clear empties the tree and keeps it usable', () {
+      final tree = DynamicBvh();
+      for (var i = 0; i < 40; i++) {
+        final item = _itemAt(i * 2.0);
+        tree.insert(item, item.worldBounds!);
+      }
+      tree.clear();
+      expect(tree.length, 0);
+      final hits = <RenderItem>[];
+      tree.queryAabb(
+        Aabb3.minMax(Vector3.all(-1000), Vector3.all(1000)),
+        hits.add,
+      );
+      expect(hits, isEmpty);
+
+      final item = _itemAt(0);
+      tree.insert(item, item.worldBounds!);
+      tree.queryAabb(item.worldBounds!, hits.add);
+      expect(hits, [item]);
+    });
+  });
+
+  group('SceneBvh', () {
+    test('spawns, moves, and despawns without a static rebuild', () {
+      final scene = RenderScene();
+      final props = [for (int i = 0; i < 100; i++) _itemAt(i * 4.0)];
+      props.forEach(scene.add);
+      scene.rebuildIfDirty();
+      expect(scene.bvh.staticBuildCount, 1);
+      expect(scene.bvh.dynamicBvh.length, 0);
+
+      final actor = _itemAt(2);
+      scene.add(actor);
+      scene.rebuildIfDirty();
+      expect(scene.bvh.dynamicBvh.length, 1);
+
+      final everything = Frustum.matrix(
+        makeOrthographicMatrix(-1000, 1000, -1000, 1000, -1000, 1000),
+      );
+      var hits = <RenderItem>{};
+      scene.cull(everything, hits.add);
+      expect(hits, {...props, actor});
+
+      // A static prop that moves migrates to the dynamic tree.
+      _moveTo(props[0], 0, 50, 0);
+      scene.markBvhBoundsDirty(props[0]);
+      scene.remove(actor);
+      scene.rebuildIfDirty();
+      expect(scene.bvh.dynamicBvh.length, 1);
+      expect(scene.bvh.staticBvh.retiredLeafCount, 1);
+
+      hits = <RenderItem>{};
+      scene.cull(
+        Frustum.matrix(makeOrthographicMatrix(-2, 2, 48, 52, -100, 100)),
+        hits.add,
+      );
+      expect(hits, {props[0]});
+
+      hits = <RenderItem>{};
+      scene.cull(everything, hits.add);
+      expect(hits, props.toSet());
+      expect(scene.bvh.staticBuildCount, 1);
+    });
+
+    test('rebuilds once enough static leaves are retired', () {
+      final scene = RenderScene();
+      final props = [for (int i = 0; i < 400; i++) _itemAt(i * 4.0)];
+      props.forEach(scene.add);
+      scene.rebuildIfDirty();
+
+      for (final prop in props.take(120)) {
+        scene.remove(prop);
+      }
+      scene.rebuildIfDirty();
+      expect(scene.bvh.staticBuildCount, 2);
+      expect(scene.bvh.staticBvh.leafCount, 280);
+      expect(scene.bvh.staticBvh.retiredLeafCount, 0);
+    });
+
+    test('membership changes move items to and from always-visible', () {
+      final scene = RenderScene();
+      final item = _itemAt(0);
+      scene.add(item);
+      scene.rebuildIfDirty();
+
+      final far = Frustum.matrix(
+        makeOrthographicMatrix(500, 510, 500, 510, -1, 1),
+      );
+      var hits = <RenderItem>{};
+      scene.cull(far, hits.add);
+      expect(hits, isEmpty);
+
+      item.frustumCulled = false;
+      scene.markBvhStructureDirty(item);
+      scene.rebuildIfDirty();
+      hits = <RenderItem>{};
+      scene.cull(far, hits.add);
+      expect(hits, {item});
+
+      item.frustumCulled = true;
+      scene.markBvhStructureDirty(item);
+      scene.rebuildIfDirty();
+      hits = <RenderItem>{};
+      scene.cull(far, hits.add);
+      expect(hits, isEmpty);
+      expect(scene.bvh.staticBuildCount, 1);
+    });
   });
 
   group('RenderScene.cull', () {
@@ -0,0 +1,127 @@
+// Covers DrawKeySorter: the radix order matches the comparator order the
+// encoder used before (with full ties kept in submission order), including
+// depths that only differ below float precision, negative zero, and NaN.
+
+import 'dart:math' as math;
+
+import 'package:flutter_scene/src/render/draw_sort.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+class _Record {
+  _Record(this.id, this.pipeline, this.material, this.lights, this.depth);
+
+  final int id;
+  final int pipeline;
+  final int material;
+  final int lights;
+  final double depth;
+}
+
+int _compare(_Record a, _Record b) {
+  final byPipeline = a.pipeline.compareTo(b.pipeline);
+  if (byPipeline != 0) return byPipeline;
+  final byMaterial = a.material.compareTo(b.material);
+  if (byMaterial != 0) return byMaterial;
+  final byLights = a.lights.compareTo(b.lights);
+  if (byLights != 0) return byLights;
+  return a.depth.compareTo(b.depth);
+}
+
+List<int> _radixOrder(List<_Record> records) {
+  final sorter = DrawKeySorter(4)..reset(records.length);
+  for (var i = 0; i < records.length; i++) {
+    final record = records[i];
+    sorter
+      ..setKey(0, i, record.pipeline)
+      ..setKey(1, i, record.material)
+      ..setKey(2, i, record.lights + 1)
+      ..setKey(3, i, DrawKeySorter.sortableFloatBits(record.depth));
+  }
+  final sorted = List.of(records);
+  sorter.sort(sorted, _compare);
+  return [for (final record in sorted) record.id];
+}
+
+// The comparator order with full ties broken by submission order.
+List<int> _referenceOrder(List<_Record> records) {
+  final sorted = List.of(records)
+    ..sort((a, b) {
+      final order = _compare(a, b);
+      return order != 0 ? order : a.id.compareTo(b.id);
+    });
+  return [for (final record in sorted) record.id];
+}
+
+List<_Record> _records(int count, int seed) {
+  final random = math.Random(seed);
+  final pipelines = [for (var i = 0; i < 5; i++) random.nextInt(1 << 30)];
+  final materials = [for (var i = 0; i < 40; i++) random.nextInt(1 << 30)];
+  return List.generate(count, (i) {
+    // Depths on a coarse grid tie often; tiny offsets collide at float
+    // precision and must still order exactly.
+    final depth =
+        random.nextInt(64) * 0.5 + random.nextInt(3) * 1e-12;
+    return _Record(
+      i,
+      pipelines[random.nextInt(pipelines.length)],
+      materials[random.nextInt(materials.length)],
+      random.nextInt(4) - 1,
+      depth,
+    );
+  });
+}
+
+void main() {
+  test('matches the comparator order below the wide-digit threshold', () {
+    final records = _records(1500, 1);
+    expect(_radixOrder(records), _referenceOrder(records));
+  });
+
+  test('matches the comparator order with wide digits', () {
+    final records = _records(20000, 2);
+    expect(_radixOrder(records), _referenceOrder(records));
+  });
+
+  test('orders special depths as double.compareTo does', () {
+    final depths = [
+      double.nan,
+      1.0,
+      -0.0,
+      double.infinity,
+      0.0,
+      -1e-300,
+      1e300,
+      double.negativeInfinity,
+      1.0 + 1e-15,
+    ];
+    final records = [
+      for (var i = 0; i < depths.length; i++) _Record(i, 0, 0, 0, depths[i]),
+    ];
+    expect(_radixOrder(records), _referenceOrder(records));
+  });
+
+  test('reports which values fit a key column', () {
+    expect(DrawKeySorter.fitsKey(0), isTrue);
+    expect(DrawKeySorter.fitsKey(0xFFFFFFFF), isTrue);
+    expect(DrawKeySorter.fitsKey(-1), isFalse);
+    expect(DrawKeySorter.fitsKey(0x100000000), isFalse);
+  });
+
+  test('reuses its buffers across sizes', () {
+    final sorter = DrawKeySorter(1);
+    for (final count in [300, 5, 3000, 40]) {
+      final records = [
+        for (var i = 0; i < count; i++)
+          _Record(i, 0, 0, 0, ((i * 7919) % count).toDouble()),
+      ];
+      sorter.reset(count);
+      for (var i = 0; i < count; i++) {
+        sorter.setKey(0, i, DrawKeySorter.sortableFloatBits(records[i].depth));
+      }
+      sorter.sort(records, _compare);
+      for (var i = 1; i < count; i++) {
+        expect(records[i - 1].depth, lessThan(records[i].depth));
+      }
+    }
+  });
+}
@@ -0,0 +1,154 @@
+// Covers FrameTracer: spans nest and balance, counters and frame numbers
+// land in the Chrome trace-event JSON, events past the cap are dropped
+// without unbalancing spans, and the engine's tick path records component
+// ticks and render graph passes with no GPU (so CI can diff traces).
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:flutter_scene/scene.dart';
+import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/render/render_graph.dart';
+import 'package:test/test.dart';
+
+class _Ticker extends Component {
+  @override
+  void update(double deltaSeconds) {}
+}
+
+class _ThrowingWriter implements TransientWriter {
+  @override
+  gpu.BufferView emplace(ByteData bytes) =>
+      throw UnimplementedError('not used by these passes');
+}
+
+class _NamedPass extends RenderGraphPass {
+  _NamedPass(this.name);
+
+  @override
+  final String name;
+
+  @override
+  void execute(RenderGraphContext context) {}
+}
+
+class _ThrowingPass extends _NamedPass {
+  _ThrowingPass() : super('throws');
+
+  @override
+  void execute(RenderGraphContext context) => throw StateError('pass');
+}
+
+// A clock advancing one microsecond per read, so traces are exact.
+FrameTracer _tracer({int maxEvents = 1 << 20}) {
+  var now = 0;
+  return FrameTracer(clock: () => now++, maxEvents: maxEvents);
+}
+
+List<Map<String, Object?>> _events(FrameTracer tracer) {
+  final json = jsonDecode(tracer.encode()) as Map<String, Object?>;
+  return [
+    for (final event in json['traceEvents']! as List)
+      if ((event as Map<String, Object?>)['ph'] != 'M') event,
+  ];
+}
+
+void main() {
+  tearDown(() => FrameTracer.active = null);
+
+  test('records nested spans, counters, and frames', () {
+    final tracer = _tracer()
+      ..beginFrame()
+      ..begin('outer')
+      ..begin('inner', args: {'n': 2})
+      ..end()
+      ..counter('draws', {'draws': 12})
+      ..end()
+      ..endFrame();
+    final events = _events(tracer);
+    expect(events.map((e) => '${e['ph']}:${e['name']}'), [
+      'B:frame',
+      'B:outer',
+      'B:inner',
+      'E:inner',
+      'C:draws',
+      'E:outer',
+      'E:frame',
+    ]);
+    expect(events.map((e) => e['ts']), [0, 1, 2, 3, 4, 5, 6]);
+    expect(events.first['args'], {'index': 0});
+    expect(events[2]['args'], {'n': 2});
+    expect(events[4]['args'], {'draws': 12});
+    expect(tracer.frameCount, 1);
+  });
+
+  test('drops events past the cap and keeps spans balanced', () {
+    final tracer = _tracer(maxEvents: 2)
+      ..begin('kept')
+      ..begin('dropped')
+      ..counter('dropped', {'x': 1})
+      ..end()
+      ..end();
+    expect(_events(tracer).map((e) => '${e['ph']}:${e['name']}'), [
+      'B:kept',
+      'E:kept',
+    ]);
+    expect(tracer.droppedEvents, 3);
+  });
+
+  test('stop closes open spans and deactivates the tracer', () {
+    FrameTracer.start(clock: () => 0).begin('open');
+    final tracer = FrameTracer.stop()!;
+    expect(FrameTracer.active, isNull);
+    expect(_events(tracer).map((e) => e['ph']), ['B', 'E']);
+  });
+
+  test('traces component ticks and render graph passes headless', () async {
+    final component = _Ticker();
+    final root = Node()..add(Node()..addComponent(component));
+    component.mount();
+    await Future<void>.delayed(Duration.zero);
+
+    final tracer = FrameTracer.start(clock: () => 0);
+    root.scenePrePass(0.016);
+    RenderGraph()
+      ..addPass(_NamedPass('first'))
+      ..addPass(_NamedPass('second'))
+      ..execute(
+        transientsBuffer: _ThrowingWriter(),
+        texturePool: TransientTexturePool(),
+      );
+    FrameTracer.stop();
+
+    expect(_events(tracer).map((e) => '${e['ph']}:${e['name']}'), [
+      'B:_Ticker.tick',
+      'E:_Ticker.tick',
+      'B:first',
+      'E:first',
+      'B:second',
+      'E:second',
+    ]);
+  });
+
+  test('a throwing pass closes its span', () {
+    final tracer = FrameTracer.start(clock: () => 0);
+    final graph = RenderGraph()..addPass(_ThrowingPass());
+    expect(
+      () => graph.execute(
+        transientsBuffer: _ThrowingWriter(),
+        texturePool: TransientTexturePool(),
+      ),
+      throwsStateError,
+    );
+    tracer.begin('next');
+    tracer.end();
+    FrameTracer.stop();
+
+    expect(_events(tracer).map((e) => '${e['ph']}:${e['name']}'), [
+      'B:throws',
+      'E:throws',
+      'B:next',
+      'E:next',
+    ]);
+  });
+}
@@ -14,6 +14,7 @@ import 'dart:convert';
 import 'dart:typed_data';
 
 import 'package:scene/scene.dart';
+import 'package:flutter_scene/src/animation_compression.dart';
 import 'package:flutter_scene/src/geometry/interleaved_layout.dart';
 import 'package:flutter_scene/src/importer/gltf.dart';
 import 'package:flutter_scene/src/importer/in_memory_import.dart';
@@ -216,6 +217,48 @@ void main() {
       }
     });
 
+    test('compresses transform channels within the tolerance', () {
+      final path = _resolve('examples/assets_src/dash.glb');
+      if (!File(path).existsSync()) {
+        // ignore: avoid_print
+        print('Test data missing ($path) - skipping.');
+        return;
+      }
+      final container = parseGlb(File(path).readAsBytesSync());
+      final gltf = decodeMeshoptBufferViews(
+        parseGltfJson(container.json),
+        container.binaryChunk,
+      );
+      final reports = <AnimationCompressionReport>[];
+      final document = buildSceneDocument(
+        gltf.doc,
+        gltf.bufferData,
+        animationTolerance: 0.01,
+        onAnimationReport: reports.add,
+      );
+      expect(reports, isNotEmpty);
+      for (final report in reports) {
+        expect(report.ratio, greaterThan(1));
+        expect(report.keptKeys, lessThanOrEqualTo(report.sourceKeys));
+        expect(report.maxError, lessThanOrEqualTo(0.01));
+      }
+      for (final channel in document.animations.values.expand(
+        (a) => a.channels,
+      )) {
+        final keyframes = document.payload(channel.keyframes)!;
+        if (channel.property == AnimationProperty.weights) {
+          expect(keyframes.encoding, PayloadEncoding.floats);
+          continue;
+        }
+        expect(keyframes.format, kCompressedKeyframesFormat);
+        final timeline = document.payload(channel.timeline)!;
+        expect(
+          CompressedKeyframes.fromBytes(keyframes.bytes!).count,
+          timeline.bytes!.length ~/ 4,
+        );
+      }
+    });
+
     test('joint attributes without a skin emit unskinned geometry', () {
       final document = importGlbToSceneDocument(_jointedStaticGlb());
       final geometry =
@@ -1,5 +1,5 @@
-// Covers the .fscene path for morph targets: the emitter bakes dense delta
-// payloads, default weights, target names, node overrides, and weights
+// Covers the .fscene path for morph targets: the emitter bakes run-encoded
+// delta payloads, default weights, target names, node overrides, and weights
 // animation channels; the .fsceneb container round-trips them; and the
 // document animation builder decodes weights channels. Byte parity against
 // the shared packer follows the project's import-verification method.
@@ -9,6 +9,7 @@ import 'dart:typed_data';
 
 import 'package:flutter_scene/src/animation.dart' as engine;
 import 'package:flutter_scene/src/fscene/realize/skin_animation.dart';
+import 'package:flutter_scene/src/geometry/morph_targets.dart';
 import 'package:flutter_scene/src/importer/gltf.dart';
 // ignore: implementation_imports
 import 'package:flutter_scene/src/importer/src/fscene_emitter/fscene_emitter.dart';
@@ -23,16 +24,14 @@ import 'package:scene/scene.dart';
   return (doc: parseGltfJson(container.json), bin: container.binaryChunk);
 }
 
-Uint8List _expectedDeltaBytes(PackedMorphTargets morph) {
-  final builder = BytesBuilder(copy: false);
-  void add(Float32List floats) => builder.add(
-    floats.buffer.asUint8List(floats.offsetInBytes, floats.lengthInBytes),
-  );
-  add(morph.positionDeltas);
-  if (morph.normalDeltas != null) add(morph.normalDeltas!);
-  if (morph.tangentDeltas != null) add(morph.tangentDeltas!);
-  return builder.toBytes();
-}
+Uint8List _expectedDeltaBytes(PackedMorphTargets morph) =>
+    SparseMorphDeltas.fromDense(
+      vertexCount: morph.vertexCount,
+      targetCount: morph.targetCount,
+      positions: morph.positionDeltas,
+      normals: morph.normalDeltas,
+      tangents: morph.tangentDeltas,
+    ).toBytes();
 
 void main() {
   group('emitter', () {
@@ -59,7 +58,8 @@ void main() {
         InterleavedLayoutAdapter.unskinnedInterleavedLayout,
       );
 
-      // The delta payload is byte-for-byte the shared packer's slabs.
+      // The delta payload is byte-for-byte the shared packer's slabs,
+      // run-encoded, and expands back to them.
       final packed = packGltfPrimitive(
         primitive: doc.meshes.single.primitives.single,
         accessors: doc.accessors,
@@ -67,9 +67,13 @@ void main() {
         bufferData: bin,
         coordinatePolicy: GltfCoordinatePolicy.bakeNative,
       );
+      final payload = document.payload(morph.deltas)!;
+      expect(payload.format, kSparseMorphDeltasFormat);
+      expect(payload.bytes, _expectedDeltaBytes(packed.morphTargets!));
+      final deltas = SparseMorphDeltas.fromBytes(payload.bytes!);
       expect(
-        document.payload(morph.deltas)!.bytes,
-        _expectedDeltaBytes(packed.morphTargets!),
+        deltas.expand(deltas.positions),
+        packed.morphTargets!.positionDeltas,
       );
 
       final animation = document.animations.values.single;
@@ -218,6 +222,7 @@ void main() {
         reread.payload(morph.deltas)!.bytes,
         original.payload(originalGeometry.morphTargets!.deltas)!.bytes,
       );
+      expect(reread.payload(morph.deltas)!.format, kSparseMorphDeltasFormat);
       expect(
         reread.payload(geometry.vertices!)!.bytes,
         original.payload(originalGeometry.vertices!)!.bytes,
@@ -48,9 +48,13 @@ void main() {
       ..writeAsBytesSync(_corpusGlb.readAsBytesSync());
   }
 
-  BuildOutput run() {
+  BuildOutput run({double? animationTolerance}) {
     final output = BuildOutputBuilder();
-    buildScenes(buildInput: _input(temp.uri), buildOutput: output);
+    buildScenes(
+      buildInput: _input(temp.uri),
+      buildOutput: output,
+      animationTolerance: animationTolerance,
+    );
     return output.build();
   }
 
@@ -90,6 +94,17 @@ void main() {
     expect(writtenAt('assets/one').isAfter(first), isTrue);
   });
 
+  test('reconverts when the animation tolerance changes', () {
+    addScene('one.glb');
+    run();
+    final first = writtenAt('assets/one');
+    run(animationTolerance: 0.001);
+    final compressed = writtenAt('assets/one');
+    expect(compressed.isAfter(first), isTrue);
+    run(animationTolerance: 0.001);
+    expect(writtenAt('assets/one'), compressed);
+  });
+
   test('adding a source converts only the new one', () {
     addScene('one.glb');
     run();
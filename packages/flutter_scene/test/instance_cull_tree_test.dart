@@ -0,0 +1,148 @@
+// Covers InstanceCullTree: the instances it accepts match a per-instance
+// plane test, for random views, after instances move (refit) and spread
+// far from their build-time clusters (rebuild), and when the count
+// changes.
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/render/instance_cull_tree.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vector_math/vector_math.dart';
+
+final math.Random _random = math.Random(5);
+
+void _place(Float32List bounds, int i, double spread) {
+  final x = _random.nextDouble() * spread;
+  final y = _random.nextDouble() * spread;
+  final z = _random.nextDouble() * 5;
+  bounds.setAll(i * 6, [x - 0.5, y - 0.5, z - 0.5, x + 0.5, y + 0.5, z + 0.5]);
+}
+
+Float32List _field(int count) {
+  final bounds = Float32List(count * 6);
+  for (var i = 0; i < count; i++) {
+    _place(bounds, i, 100);
+  }
+  return bounds;
+}
+
+// A box-shaped view over part of the field.
+Frustum _view() {
+  final x = _random.nextDouble() * 80;
+  final y = _random.nextDouble() * 80;
+  final size = 5 + _random.nextDouble() * 30;
+  return Frustum.matrix(
+    makeOrthographicMatrix(x, x + size, y, y + size, -10, 10),
+  );
+}
+
+List<int> _reference(
+  Float32List bounds,
+  int count,
+  Frustum frustum,
+  List<Plane> additionalPlanes,
+) {
+  final planes = [
+    frustum.plane0,
+    frustum.plane1,
+    frustum.plane2,
+    frustum.plane3,
+    frustum.plane4,
+    frustum.plane5,
+    ...additionalPlanes,
+  ];
+  return [
+    for (var i = 0; i < count; i++)
+      if (planes.every((plane) {
+        final n = plane.normal;
+        final o = i * 6;
+        return n.x * bounds[o + (n.x < 0 ? 0 : 3)] +
+                n.y * bounds[o + (n.y < 0 ? 1 : 4)] +
+                n.z * bounds[o + (n.z < 0 ? 2 : 5)] +
+                plane.constant >=
+            0;
+      }))
+        i,
+  ];
+}
+
+List<int> _cull(
+  InstanceCullTree tree,
+  Float32List bounds,
+  int count,
+  Frustum frustum, [
+  List<Plane> additionalPlanes = const [],
+]) {
+  final visible = <int>[];
+  expect(tree.cull(bounds, count, frustum, additionalPlanes, visible), isTrue);
+  return visible..sort();
+}
+
+void main() {
+  test('accepts the instances a per-instance test accepts', () {
+    final bounds = _field(5000);
+    final tree = InstanceCullTree();
+    for (var view = 0; view < 20; view++) {
+      final frustum = _view();
+      final planes = [Plane.components(1, 0, 0, -_random.nextDouble() * 50)];
+      expect(
+        _cull(tree, bounds, 5000, frustum, planes),
+        _reference(bounds, 5000, frustum, planes),
+      );
+    }
+  });
+
+  test('refits after moves and rebuilds once they spread', () {
+    final bounds = _field(3000);
+    final tree = InstanceCullTree();
+    _cull(tree, bounds, 3000, _view());
+    for (var frame = 0; frame < 20; frame++) {
+      for (var move = 0; move < 50; move++) {
+        final i = _random.nextInt(3000);
+        _place(bounds, i, 100);
+        tree.markMoved(i, i + 1);
+      }
+      final frustum = _view();
+      expect(
+        _cull(tree, bounds, 3000, frustum),
+        _reference(bounds, 3000, frustum, const []),
+      );
+    }
+    // Everything moves far away at once.
+    for (var i = 0; i < 3000; i++) {
+      _place(bounds, i, 1000);
+    }
+    tree.markMoved(0, 3000);
+    final frustum = _view();
+    expect(
+      _cull(tree, bounds, 3000, frustum),
+      _reference(bounds, 3000, frustum, const []),
+    );
+  });
+
+  test('rebuilds when the count changes', () {
+    final bounds = _field(4000);
+    final tree = InstanceCullTree();
+    final frustum = _view();
+    _cull(tree, bounds, 4000, frustum);
+    expect(
+      _cull(tree, bounds, 2500, frustum),
+      _reference(bounds, 2500, frustum, const []),
+    );
+  });
+
+  test('declines views with more planes than it tracks', () {
+    final bounds = _field(100);
+    final planes = List.filled(
+      InstanceCullTree.maxPlanes,
+      Plane.components(1, 0, 0, 0),
+    );
+    final visible = <int>[];
+    expect(
+      InstanceCullTree().cull(bounds, 100, _view(), planes, visible),
+      isFalse,
+    );
+    expect(visible, isEmpty);
+  });
+}
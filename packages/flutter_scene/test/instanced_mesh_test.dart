@@ -296,4 +296,79 @@ void main() {
       expect(item.cullVisibleInstances(frustum, const []), isFalse);
     });
   });
+
+  group('InstancedMesh dirty ranges', () {
+    InstancedMesh meshWith(int count) {
+      final mesh = _instancedMesh(
+        aabb: Aabb3.minMax(Vector3.all(-0.5), Vector3.all(0.5)),
+      );
+      for (var i = 0; i < count; i++) {
+        mesh.addInstance(Matrix4.translation(Vector3(i.toDouble(), 0, 0)));
+      }
+      return mesh;
+    }
+
+    test('reports the instances edited in place', () {
+      final mesh = meshWith(10);
+      final revision = mesh.revision;
+      expect(mesh.dirtyRangeSince(revision), (start: 0, end: 0));
+
+      mesh
+        ..setInstanceTransform(3, Matrix4.translation(Vector3(3, 1, 0)))
+        ..setInstanceColor(7, Vector4(1, 0, 0, 1));
+      expect(mesh.dirtyRangeSince(revision), (start: 3, end: 8));
+    });
+
+    test('reports a full change for added and mirrored instances', () {
+      final mesh = meshWith(4);
+      var revision = mesh.revision;
+      mesh.addInstance(Matrix4.identity());
+      expect(mesh.dirtyRangeSince(revision), isNull);
+
+      revision = mesh.revision;
+      mesh.setInstanceTransform(1, Matrix4.diagonal3Values(-1, 1, 1));
+      expect(mesh.dirtyRangeSince(revision), isNull);
+    });
+
+    test('a consumer that fell behind gets a full change', () {
+      final mesh = meshWith(6);
+      final behind = mesh.revision;
+      mesh.setInstanceTransform(1, Matrix4.translation(Vector3(1, 1, 0)));
+      final current = mesh.revision;
+      expect(mesh.dirtyRangeSince(behind), (start: 1, end: 2));
+
+      mesh.setInstanceTransform(4, Matrix4.translation(Vector3(4, 1, 0)));
+      expect(mesh.dirtyRangeSince(current), (start: 4, end: 5));
+      expect(mesh.dirtyRangeSince(behind), isNull);
+    });
+
+    test('a moved instance widens the aggregate bounds', () {
+      final mesh = meshWith(4);
+      expect(mesh.aggregateBounds!.max.y, closeTo(0.5, 1e-6));
+      mesh.setInstanceTransform(2, Matrix4.translation(Vector3(2, 5, 0)));
+      expect(mesh.aggregateBounds!.max.y, closeTo(5.5, 1e-6));
+    });
+
+    test('a ranged refresh repacks only that range', () {
+      final item =
+          RenderItem(geometry: _StubGeometry(), material: _StubMaterial())
+            ..instanceTransforms = [
+              for (var i = 0; i < 4; i++)
+                Matrix4.translation(Vector3(i.toDouble(), 0, 0)),
+            ]
+            ..instanceColors = [for (var i = 0; i < 4; i++) Vector4.all(1)];
+      item.refreshInstanceData();
+      final data = item.instanceWorldData!;
+
+      item.instanceTransforms![1].setTranslationRaw(10, 0, 0);
+      item.instanceTransforms![2].setTranslationRaw(20, 0, 0);
+      item.refreshInstanceData(start: 1, end: 2);
+      expect(item.instanceWorldData, same(data));
+      expect(data[20 + 12], 10);
+      expect(data[40 + 12], 2);
+
+      item.refreshInstanceData();
+      expect(data[40 + 12], 20);
+    });
+  });
 }
@@ -0,0 +1,115 @@
+// Covers LightClusterGrid: a ranged light lands in every froxel a point it
+// lights falls in (the shader's lookup via clusterAt) and not in far-off ones,
+// a spot's cone trims the clusters its sphere alone would reach, unbounded
+// lights head every list, and each cluster is capped at its budget.
+
+import 'dart:math' as math;
+
+import 'package:flutter_scene/src/render/light_clusters.dart';
+import 'package:flutter_scene/src/render/light_culling.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vector_math/vector_math.dart';
+
+// A 60-degree, 16:9 view from the origin down +z (the identity view matrix).
+const double _tanY = 0.5773502691896257;
+const double _tanX = _tanY * 16 / 9;
+
+LightClusterGrid _build(List<CullableLight> lights, {int maxPerCluster = 16}) =>
+    LightClusterGrid()..build(
+      view: Matrix4.identity(),
+      tanHalfFovX: _tanX,
+      tanHalfFovY: _tanY,
+      near: 0.1,
+      far: 100.0,
+      lights: lights,
+      maxPerCluster: maxPerCluster,
+    );
+
+CullableLight _point(int index, Vector3 position, double range) =>
+    CullableLight(
+      index,
+      lightInfluenceBounds(position, range),
+      worldPosition: position,
+      range: range,
+    );
+
+List<int> _lightsAt(LightClusterGrid grid, Vector3 view) {
+  final cluster = grid.clusterAt(view.x, view.y, view.z);
+  final offset = grid.offsets[cluster];
+  return grid.indices.sublist(offset, offset + grid.counts[cluster]);
+}
+
+void main() {
+  test('a point light reaches every fragment inside its range', () {
+    final center = Vector3(2, -1, 12);
+    final grid = _build([_point(7, center, 3.0)]);
+    final random = math.Random(1);
+    for (var i = 0; i < 500; i++) {
+      final offset = Vector3(
+        random.nextDouble() * 2 - 1,
+        random.nextDouble() * 2 - 1,
+        random.nextDouble() * 2 - 1,
+      );
+      if (offset.length > 1.0) continue;
+      expect(_lightsAt(grid, center + offset * 2.99), [7]);
+    }
+    expect(_lightsAt(grid, Vector3(-6, 3, 12)), isEmpty);
+    expect(_lightsAt(grid, Vector3(2, -1, 40)), isEmpty);
+    expect(_lightsAt(grid, Vector3(2, -1, 2)), isEmpty);
+    expect(grid.overflowed, isFalse);
+  });
+
+  test('a spot cone trims clusters its sphere reaches', () {
+    final apex = Vector3(0, 0, 10);
+    final spot = CullableLight(
+      0,
+      lightInfluenceBounds(apex, 10.0),
+      worldPosition: apex,
+      range: 10.0,
+      spotDirection: Vector3(0, 0, 1),
+      spotAngle: 20 * degrees2Radians,
+    );
+    final grid = _build([spot, _point(1, apex, 10.0)]);
+    // Down the axis both lights reach; behind the apex and well off-axis only
+    // the point light does.
+    expect(_lightsAt(grid, Vector3(0, 0, 15)), [0, 1]);
+    expect(_lightsAt(grid, Vector3(0, 0, 5)), [1]);
+    expect(_lightsAt(grid, Vector3(5, 0, 11)), [1]);
+  });
+
+  test('unbounded lights head every cluster', () {
+    final grid = _build([
+      _point(0, Vector3(0, 0, 5), 1.0),
+      const CullableLight(1, null),
+      const CullableLight(2, null, channelMask: 0),
+    ]);
+    for (var c = 0; c < grid.clusterCount; c++) {
+      expect(grid.counts[c], greaterThanOrEqualTo(1));
+      expect(grid.indices[grid.offsets[c]], 1);
+    }
+    expect(_lightsAt(grid, Vector3(0, 0, 5)), [1, 0]);
+  });
+
+  test('each cluster keeps at most its budget', () {
+    final grid = _build([
+      for (var i = 0; i < 6; i++) _point(i, Vector3(0, 0, 5), 2.0),
+    ], maxPerCluster: 4);
+    expect(_lightsAt(grid, Vector3(0, 0, 5)), [0, 1, 2, 3]);
+    expect(grid.overflowed, isTrue);
+  });
+
+  test('a global build puts every light in one cluster', () {
+    final grid = LightClusterGrid()
+      ..buildGlobal(
+        lights: [
+          _point(0, Vector3(0, 0, -50), 1.0),
+          const CullableLight(1, null),
+          _point(2, Vector3(100, 0, 0), 1.0),
+        ],
+        maxPerCluster: 16,
+      );
+    expect(grid.isGlobal, isTrue);
+    expect(grid.clusterAt(1, 2, 3), 0);
+    expect(_lightsAt(grid, Vector3(1, 2, 3)), [1, 0, 2]);
+  });
+}
@@ -0,0 +1,162 @@
+// Covers the offline LOD simplifier: a flat grid halves with no error, a
+// curved one reduces with a small error, UV-seam vertices survive, and the
+// generated chain keeps each vertex's skin weights and orders its
+// thresholds from the source level down to zero.
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/importer/src/gltf/mesh_simplifier.dart';
+import 'package:flutter_scene/src/importer/src/gltf/primitive_packer.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+// An n x n quad grid in the XY plane, [stride] floats per vertex with the
+// position first, heights from [height]. With [seam], the column at n / 2
+// is split into two vertices (as a UV seam is), the right half of the grid
+// using the second.
+({Float32List vertices, Uint32List indices}) _grid(
+  int n, {
+  int stride = 3,
+  double Function(int x, int y)? height,
+  bool seam = false,
+}) {
+  final vertices = <double>[];
+  final left = <(int, int), int>{};
+  final right = <(int, int), int>{};
+  void add(int x, int y) {
+    vertices.addAll([x.toDouble(), y.toDouble(), height?.call(x, y) ?? 0]);
+    for (var c = 3; c < stride; c++) {
+      vertices.add(x * 0.25 + y + c);
+    }
+  }
+
+  for (var y = 0; y <= n; y++) {
+    for (var x = 0; x <= n; x++) {
+      left[(x, y)] = vertices.length ~/ stride;
+      add(x, y);
+      if (seam && x == n ~/ 2) {
+        right[(x, y)] = vertices.length ~/ stride;
+        add(x, y);
+      }
+    }
+  }
+  final indices = <int>[];
+  for (var y = 0; y < n; y++) {
+    for (var x = 0; x < n; x++) {
+      int at(int cx, int cy) =>
+          (x >= n ~/ 2 ? right[(cx, cy)] : null) ?? left[(cx, cy)]!;
+      final a = at(x, y), b = at(x + 1, y);
+      final c = at(x + 1, y + 1), d = at(x, y + 1);
+      indices.addAll([a, b, c, a, c, d]);
+    }
+  }
+  return (
+    vertices: Float32List.fromList(vertices),
+    indices: Uint32List.fromList(indices),
+  );
+}
+
+double _signedArea(Float32List vertices, int stride, Uint32List indices) {
+  var area = 0.0;
+  for (var t = 0; t < indices.length; t += 3) {
+    final a = indices[t] * stride;
+    final b = indices[t + 1] * stride;
+    final c = indices[t + 2] * stride;
+    area +=
+        ((vertices[b] - vertices[a]) * (vertices[c + 1] - vertices[a + 1]) -
+            (vertices[b + 1] - vertices[a + 1]) * (vertices[c] - vertices[a])) /
+        2;
+  }
+  return area;
+}
+
+void main() {
+  test('halves a flat grid without error or holes', () {
+    final grid = _grid(20);
+    final result = simplifyTriangles(
+      grid.vertices,
+      3,
+      grid.indices,
+      targetIndexCount: grid.indices.length ~/ 2,
+    );
+    expect(result.indices.length, lessThanOrEqualTo(grid.indices.length ~/ 2));
+    expect(result.error, 0);
+    expect(_signedArea(grid.vertices, 3, result.indices), closeTo(400, 1e-3));
+  });
+
+  test('reduces a curved grid with a small error', () {
+    final grid = _grid(
+      20,
+      height: (x, y) => 0.3 * math.sin(x * 0.7) * math.cos(y * 0.5),
+    );
+    final result = simplifyTriangles(
+      grid.vertices,
+      3,
+      grid.indices,
+      targetIndexCount: grid.indices.length ~/ 4,
+    );
+    expect(result.indices.length, lessThanOrEqualTo(grid.indices.length ~/ 4));
+    expect(result.error, greaterThan(0));
+    expect(result.error, lessThan(0.05));
+  });
+
+  test('keeps every vertex on a seam', () {
+    final grid = _grid(20, seam: true);
+    final result = simplifyTriangles(
+      grid.vertices,
+      3,
+      grid.indices,
+      targetIndexCount: grid.indices.length ~/ 4,
+    );
+    expect(result.indices.length, lessThan(grid.indices.length ~/ 2));
+    final used = result.indices.toSet();
+    for (var v = 0; v < grid.vertices.length ~/ 3; v++) {
+      if (grid.vertices[v * 3] == 10) expect(used, contains(v));
+    }
+  });
+
+  test('generates a chain that keeps skin weights', () {
+    const stride = 26;
+    final grid = _grid(
+      24,
+      stride: stride,
+      height: (x, y) => 0.5 * math.sin(x * 0.4 + y * 0.3),
+    );
+    final source = PackedPrimitive(
+      vertexBytes: grid.vertices.buffer.asUint8List(),
+      vertexCount: grid.vertices.length ~/ stride,
+      indexBytes: Uint16List.fromList(grid.indices).buffer.asUint8List(),
+      indexCount: grid.indices.length,
+      indices32Bit: false,
+      isSkinned: true,
+      sourceWindingFlipped: false,
+    );
+    final levels = generateLodLevels(source, levels: 3);
+    expect(levels.length, greaterThan(1));
+    expect(levels.first.primitive, same(source));
+    expect(levels.last.screenSize, 0);
+    for (var i = 1; i < levels.length; i++) {
+      expect(levels[i].triangleCount, lessThan(levels[i - 1].triangleCount));
+      expect(levels[i].screenSize, lessThan(levels[i - 1].screenSize));
+      expect(levels[i].screenSize, greaterThanOrEqualTo(0));
+      expect(levels[i].error, greaterThanOrEqualTo(levels[i - 1].error));
+    }
+    expect(levels.first.screenSize, lessThanOrEqualTo(1));
+
+    // Every vertex of a simplified level is a source vertex, attributes and
+    // all.
+    final sourceVertices = {
+      for (var v = 0; v < source.vertexCount; v++)
+        grid.vertices.sublist(v * stride, (v + 1) * stride).join(','),
+    };
+    for (final level in levels.skip(1)) {
+      final vertices = Float32List.sublistView(level.primitive.vertexBytes);
+      for (var v = 0; v < level.primitive.vertexCount; v++) {
+        expect(
+          sourceVertices,
+          contains(vertices.sublist(v * stride, (v + 1) * stride).join(',')),
+        );
+      }
+    }
+  });
+}
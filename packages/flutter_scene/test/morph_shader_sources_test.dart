@@ -1,8 +1,8 @@
-// Guards the GPU morph path's shader structure: the morphed variants exist
-// in the base bundle, the shared bodies stay define-guarded so unmorphed
-// shaders compile unchanged, morphing happens before skinning, and the
-// morphed entries compile (with the expected uniforms) on every backend
-// impellerc targets.
+// Guards the GPU morph path's shader structure: the morphed variants (band
+// and sparse) exist in the base bundle, the shared bodies stay
+// define-guarded so unmorphed shaders compile unchanged, morphing happens
+// before skinning, and the morphed entries compile (with the expected
+// uniforms) on every backend impellerc targets.
 
 import 'dart:convert';
 import 'dart:io';
@@ -38,6 +38,14 @@ void main() {
       manifest['MorphedSkinnedVertex']['file'],
       'shaders/flutter_scene_morphed_skinned.vert',
     );
+    expect(
+      manifest['MorphedSparseUnskinnedVertex']['file'],
+      'shaders/flutter_scene_morphed_sparse_unskinned.vert',
+    );
+    expect(
+      manifest['MorphedSparseSkinnedVertex']['file'],
+      'shaders/flutter_scene_morphed_sparse_skinned.vert',
+    );
   });
 
   test('unmorphed bodies stay define-guarded', () {
@@ -55,10 +63,14 @@ void main() {
     for (final wrapper in [
       'flutter_scene_morphed_unskinned.vert',
       'flutter_scene_morphed_skinned.vert',
+      'flutter_scene_morphed_sparse_unskinned.vert',
+      'flutter_scene_morphed_sparse_skinned.vert',
     ]) {
+      final source = File('shaders/$wrapper').readAsStringSync();
+      expect(source, contains('#define FLUTTER_SCENE_MORPH_TARGETS'));
       expect(
-        File('shaders/$wrapper').readAsStringSync(),
-        contains('#define FLUTTER_SCENE_MORPH_TARGETS'),
+        source.contains('#define FLUTTER_SCENE_SPARSE_MORPH_TARGETS'),
+        wrapper.contains('_sparse_'),
       );
     }
     for (final plain in [
@@ -104,6 +116,8 @@ void main() {
       for (final entry in [
         'flutter_scene_morphed_unskinned',
         'flutter_scene_morphed_skinned',
+        'flutter_scene_morphed_sparse_unskinned',
+        'flutter_scene_morphed_sparse_skinned',
       ]) {
         for (final backend in ['opengl-es', 'metal-desktop', 'vulkan']) {
           final reflection = File.fromUri(
@@ -168,5 +182,26 @@ void main() {
       data(targetCount: 4, vertexCount: 16),
     );
     expect(skinned.usesGpuMorphing, isTrue);
+
+    // One vertex past the guaranteed width gives every band two rows, too
+    // many for this many targets; with each target moving one vertex the
+    // run-indexed layout (a run texel and a delta texel each) fits.
+    const vertexCount = kMorphTextureMaxDimension + 1;
+    const sparseTargets = kMorphTextureMaxDimension ~/ 2 + 1;
+    final positions = Float32List(sparseTargets * vertexCount * 3);
+    for (var t = 0; t < sparseTargets; t++) {
+      positions[(t * vertexCount + t) * 3] = 1;
+    }
+    final sparse = MorphedUnskinnedGeometry(
+      MorphTargetData.sparse(
+        SparseMorphDeltas.fromDense(
+          vertexCount: vertexCount,
+          targetCount: sparseTargets,
+          positions: positions,
+        ),
+      ),
+    );
+    expect(sparse.usesGpuMorphing, isTrue);
+    expect(sparse.morphTextureBytes, kMorphTextureMaxDimension * 2 * 16);
   });
 }
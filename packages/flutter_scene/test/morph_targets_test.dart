@@ -1,7 +1,8 @@
 // Morph target (blend shape) coverage over the pure-data layers: glTF
 // parsing and packing (dense and sparse deltas), additive CPU blending,
-// top-N weight selection, the delta-texture packing layout, node weight
-// defaults/overrides, and weights-channel playback. No GPU needed.
+// top-N weight selection, the delta-texture packing layout, run-encoded
+// deltas, node weight defaults/overrides, and weights-channel playback. No
+// GPU needed.
 
 import 'dart:io';
 import 'dart:typed_data';
@@ -131,6 +132,20 @@ _syntheticMorphFixture() {
   );
 }
 
+// The fixture's deltas as runs of moved vertices.
+MorphTargetData _sparseFromFixture() {
+  final dense = _dataFromFixture();
+  return MorphTargetData.sparse(
+    SparseMorphDeltas.fromDense(
+      vertexCount: dense.vertexCount,
+      targetCount: dense.targetCount,
+      positions: dense.positionDeltas,
+      normals: dense.normalDeltas,
+      tangents: dense.tangentDeltas,
+    ),
+  );
+}
+
 MorphTargetData _dataFromFixture({GltfCoordinatePolicy? policy}) {
   final fixture = _syntheticMorphFixture();
   final packed = packGltfPrimitive(
@@ -510,6 +525,81 @@ void main() {
       expect(packing.height, 4);
     });
 
+    test('sparse targets pack run tables ahead of their moved deltas', () {
+      const vertexCount = 2000;
+      const targetCount = 60;
+      final positions = Float32List(targetCount * vertexCount * 3);
+      final normals = Float32List(targetCount * vertexCount * 3);
+      for (var t = 0; t < targetCount; t++) {
+        for (final first in [t * 20, 1000 + t * 10]) {
+          for (var v = first; v < first + 50; v++) {
+            final o = (t * vertexCount + v) * 3;
+            positions[o] = (t * 10000 + v + 1).toDouble();
+            normals[o + 2] = -(v + 1).toDouble();
+          }
+        }
+      }
+      final data = MorphTargetData.sparse(
+        SparseMorphDeltas.fromDense(
+          vertexCount: vertexCount,
+          targetCount: targetCount,
+          positions: positions,
+          normals: normals,
+        ),
+      );
+      final packing = computeMorphTexturePacking(data)!;
+      expect(packing.runIndexed, isTrue);
+      expect(packing.texelsPerValue, 2);
+      // Two runs and 100 moved vertices per target.
+      expect(packing.width * packing.height, greaterThanOrEqualTo(60 * 202));
+      expect(packing.height, 6);
+
+      // The lookup the sparse vertex shader runs: binary-search the
+      // target's run table, then read the run's delta texels.
+      final texels = buildMorphTexturePayload(data, packing);
+      double? lookup(int target, int vertex, int attribute, int axis) {
+        final table = packing.runTableStarts![target];
+        final runs =
+            data.deltas.runOffsets[target + 1] -
+            data.deltas.runOffsets[target];
+        var low = 0;
+        var high = runs;
+        while (low < high) {
+          final middle = (low + high) ~/ 2;
+          if (texels[(table + middle) * 4] <= vertex) {
+            low = middle + 1;
+          } else {
+            high = middle;
+          }
+        }
+        if (low == 0) return null;
+        final run = (table + low - 1) * 4;
+        final offset = vertex - texels[run].toInt();
+        if (offset >= texels[run + 1]) return null;
+        final texel =
+            texels[run + 2].toInt() + offset * packing.texelsPerValue;
+        return texels[(texel + attribute) * 4 + axis];
+      }
+
+      for (var t = 0; t < targetCount; t++) {
+        for (var v = 0; v < vertexCount; v += 7) {
+          final o = (t * vertexCount + v) * 3;
+          final moved = positions[o] != 0;
+          expect(lookup(t, v, 0, 0), moved ? positions[o] : isNull);
+          expect(lookup(t, v, 1, 2), moved ? normals[o + 2] : isNull);
+        }
+      }
+    });
+
+    test('dense data keeps the band layout', () {
+      final data = MorphTargetData(
+        vertexCount: 4,
+        targetCount: 2,
+        positionDeltas: Float32List(2 * 4 * 3),
+      );
+      expect(computeMorphTexturePacking(data)!.runIndexed, isFalse);
+    });
+
     test('oversized data reports no packing', () {
       final data = MorphTargetData(
         vertexCount: 4,
@@ -523,6 +613,109 @@ void main() {
     });
   });
 
+  group('run-encoded deltas', () {
+    test('keeps runs of the vertices each target moves', () {
+      final sparse = _sparseFromFixture().deltas;
+      // Target 0 moves vertex 1 only; target 1 moves all three.
+      expect(sparse.runOffsets, [0, 1, 2]);
+      expect(sparse.runs, [1, 1, 0, 3]);
+      expect(sparse.storedVertexCount, 4);
+      expect(sparse.positions.sublist(0, 3), [0.5, 0, 0.25]);
+      expect(sparse.isDense, isFalse);
+
+      final dense = _dataFromFixture();
+      final data = _sparseFromFixture();
+      expect(data.positionDeltas, dense.positionDeltas);
+      expect(data.normalDeltas, dense.normalDeltas);
+      expect(data.tangentDeltas, isNull);
+    });
+
+    test('blends and packs like the dense slabs', () {
+      final dense = _dataFromFixture();
+      final sparse = _sparseFromFixture();
+      final base = Float32List.fromList([0, 0, 1, 1, 0, 1, 0, 1, 1]);
+      for (final weights in [
+        Float32List.fromList([2.0, 0.5]),
+        Float32List.fromList([0.0, -1.0]),
+        Float32List.fromList([0.3, 0.0]),
+      ]) {
+        expect(
+          sparse.blendPositions(base, weights),
+          dense.blendPositions(base, weights),
+        );
+        expect(
+          sparse.blendNormals(base, weights),
+          dense.blendNormals(base, weights),
+        );
+      }
+      final packing = computeMorphTexturePacking(sparse)!;
+      expect(
+        buildMorphTexturePayload(sparse, packing),
+        buildMorphTexturePayload(dense, computeMorphTexturePacking(dense)!),
+      );
+    });
+
+    test('bytes round-trip and reject malformed payloads', () {
+      final deltas = _sparseFromFixture().deltas;
+      final bytes = deltas.toBytes();
+      expect(bytes.length, deltas.lengthInBytes);
+      final read = SparseMorphDeltas.fromBytes(bytes);
+      expect(read.targetCount, 2);
+      expect(read.vertexCount, 3);
+      expect(read.runs, deltas.runs);
+      expect(read.positions, deltas.positions);
+      expect(read.normals, deltas.normals);
+      expect(read.tangents, isNull);
+
+      expect(
+        () => SparseMorphDeltas.fromBytes(bytes.sublist(0, bytes.length - 4)),
+        throwsFormatException,
+      );
+      expect(
+        () => SparseMorphDeltas.fromBytes(Uint8List.fromList(bytes)..[0] = 9),
+        throwsFormatException,
+      );
+      // A run past the last vertex.
+      final outOfRange = Uint8List.fromList(bytes);
+      ByteData.sublistView(outOfRange).setUint32(28, 7, Endian.little);
+      expect(
+        () => SparseMorphDeltas.fromBytes(outOfRange),
+        throwsFormatException,
+      );
+    });
+
+    test('a rig of small blend shapes holds a fraction of the dense bytes', () {
+      const vertexCount = 2000;
+      const targetCount = 60;
+      final positions = Float32List(targetCount * vertexCount * 3);
+      for (var t = 0; t < targetCount; t++) {
+        // Each target moves 100 vertices in two patches.
+        for (final first in [t * 20, 1000 + t * 10]) {
+          for (var v = first; v < first + 50; v++) {
+            positions[(t * vertexCount + v) * 3 + 1] = 0.01;
+          }
+        }
+      }
+      final data = MorphTargetData.sparse(
+        SparseMorphDeltas.fromDense(
+          vertexCount: vertexCount,
+          targetCount: targetCount,
+          positions: positions,
+        ),
+      );
+      expect(data.deltas.runs.length, targetCount * 4);
+      expect(data.denseDeltaBytes, positions.lengthInBytes);
+      expect(data.deltaBytes, lessThan(data.denseDeltaBytes ~/ 15));
+      final weights = Float32List(targetCount)..[7] = 1;
+      final blended = data.blendPositions(
+        Float32List(vertexCount * 3),
+        weights,
+      );
+      expect(blended[(140 * 3) + 1], closeTo(0.01, 1e-6));
+      expect(blended[(139 * 3) + 1], 0);
+    });
+  });
+
   group('node weights', () {
     Node morphedNode({List<double>? defaults}) {
       final data = MorphTargetData(
@@ -0,0 +1,228 @@
+// CPU occlusion culling tests. Drives OcclusionCuller directly over
+// hand-built render items, so no GPU context is needed. Uses the stub
+// Geometry / Material pattern from bvh_test.dart.
+
+import 'dart:typed_data';
+import 'dart:ui' as ui;
+
+import 'package:flutter_scene/scene.dart';
+import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/render/occlusion_culler.dart';
+import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vector_math/vector_math.dart';
+
+class _StubGeometry extends Geometry {
+  _StubGeometry(Aabb3 aabb) {
+    setLocalBounds(
+      aabb,
+      Sphere.centerRadius(
+        (aabb.min + aabb.max) * 0.5,
+        ((aabb.max - aabb.min) * 0.5).length,
+      ),
+    );
+  }
+
+  @override
+  void bind(
+    gpu.RenderPass pass,
+    TransientWriter transientsBuffer,
+    Matrix4 modelTransform,
+    Matrix4 cameraTransform,
+    Vector3 cameraPosition, {
+    gpu.Shader? shaderOverride,
+    double depthBias = 0.0,
+  }) {
+    throw UnsupportedError('Stub geometry is not renderable');
+  }
+}
+
+class _StubMaterial extends Material {
+  @override
+  void bind(
+    gpu.RenderPass pass,
+    TransientWriter transientsBuffer,
+    Lighting lighting,
+  ) {
+    throw UnsupportedError('Stub material is not renderable');
+  }
+}
+
+const ui.Size _viewport = ui.Size(256, 256);
+
+// Eye at -10z looking down +z at the origin.
+Matrix4 _viewProjection() => PerspectiveCamera(
+  position: Vector3(0, 0, -10),
+  target: Vector3.zero(),
+).getViewTransform(_viewport);
+
+// A visible item filling the box from [min] to [max].
+RenderItem _boxItem(Vector3 min, Vector3 max, {bool occludes = false}) {
+  final box = Aabb3.minMax(min, max);
+  final item =
+      RenderItem(geometry: _StubGeometry(box), material: _StubMaterial())
+        ..visible = true;
+  if (occludes) item.occluder = Occluder.box(box);
+  item.refreshWorldBounds();
+  return item;
+}
+
+// A wall across the view at z = 0, thin in z.
+RenderItem _wall({double halfWidth = 20.0}) => _boxItem(
+  Vector3(-halfWidth, -halfWidth, -0.1),
+  Vector3(halfWidth, halfWidth, 0.1),
+  occludes: true,
+);
+
+List<RenderItem> _cull(
+  OcclusionCuller culler,
+  List<RenderItem> items, {
+  int occluderBudget = 32,
+}) {
+  final visible = <RenderItem>[];
+  culler.cull(
+    items,
+    visible.add,
+    viewProjection: _viewProjection(),
+    width: 128,
+    height: 128,
+    occluderBudget: occluderBudget,
+  );
+  return visible;
+}
+
+void main() {
+  group('OcclusionCuller', () {
+    test('rejects an item behind a wall and keeps the rest', () {
+      final wall = _wall();
+      final behind = _boxItem(Vector3(-1, -1, 5), Vector3(1, 1, 7));
+      final inFront = _boxItem(Vector3(-1, -1, -5), Vector3(1, 1, -3));
+      final culler = OcclusionCuller();
+      final visible = _cull(culler, [wall, behind, inFront]);
+      expect(visible, unorderedEquals([wall, inFront]));
+      expect(culler.lastCulledCount, 1);
+      expect(culler.lastOccluderCount, 1);
+    });
+
+    test('keeps an item that peeks past the occluder edge', () {
+      final wall = _wall(halfWidth: 2.0);
+      // Far behind, so the wall's projection covers most of it, but one
+      // side pokes out past the wall's silhouette.
+      final peeking = _boxItem(Vector3(1.0, -1, 20), Vector3(8.0, 1, 22));
+      final hidden = _boxItem(Vector3(-1, -1, 20), Vector3(1, 1, 22));
+      final visible = _cull(OcclusionCuller(), [wall, peeking, hidden]);
+      expect(visible, unorderedEquals([wall, peeking]));
+    });
+
+    test('keeps an item that intersects the occluder', () {
+      final wall = _wall();
+      final straddling = _boxItem(Vector3(-1, -1, -1), Vector3(1, 1, 1));
+      final visible = _cull(OcclusionCuller(), [wall, straddling]);
+      expect(visible, unorderedEquals([wall, straddling]));
+    });
+
+    test('keeps an item reaching behind the camera', () {
+      final wall = _wall();
+      final around = _boxItem(Vector3(-1, -1, -20), Vector3(1, 1, 20));
+      final visible = _cull(OcclusionCuller(), [wall, around]);
+      expect(visible, contains(around));
+    });
+
+    test('culls nothing without occluders or budget', () {
+      final wall = _boxItem(Vector3(-20, -20, -0.1), Vector3(20, 20, 0.1));
+      final behind = _boxItem(Vector3(-1, -1, 5), Vector3(1, 1, 7));
+      expect(_cull(OcclusionCuller(), [wall, behind]), hasLength(2));
+
+      final occluding = _wall();
+      final culler = OcclusionCuller();
+      expect(_cull(culler, [occluding, behind], occluderBudget: 0), [
+        occluding,
+        behind,
+      ]);
+      expect(culler.lastOccluderCount, 0);
+    });
+
+    test('a hidden node does not occlude', () {
+      final wall = _wall()..visible = false;
+      final behind = _boxItem(Vector3(-1, -1, 5), Vector3(1, 1, 7));
+      expect(_cull(OcclusionCuller(), [wall, behind]), contains(behind));
+    });
+
+    test('the budget keeps the largest occluders', () {
+      // A small occluder near the edge of the view and a large wall; with
+      // a budget of one only the wall is drawn.
+      final small = _boxItem(
+        Vector3(3, 3, -0.1),
+        Vector3(3.5, 3.5, 0.1),
+        occludes: true,
+      );
+      final wall = _wall();
+      final behind = _boxItem(Vector3(-1, -1, 5), Vector3(1, 1, 7));
+      final culler = OcclusionCuller();
+      final visible = _cull(culler, [small, wall, behind], occluderBudget: 1);
+      expect(visible, isNot(contains(behind)));
+      expect(culler.lastOccluderCount, 1);
+    });
+
+    test('coverage is conservative at triangle edges', () {
+      final culler = OcclusionCuller()
+        ..begin(Matrix4.identity(), 8, 8)
+        // One triangle over the left half of NDC, depth 0.5.
+        ..rasterize(
+          Occluder(
+            positions: Float32List.fromList([
+              -1, -1, 0.5, //
+              0, -1, 0.5, //
+              -1, 1, 0.5, //
+            ]),
+            indices: const [0, 1, 2],
+          ),
+          Matrix4.identity(),
+        );
+      final depth = culler.depth;
+      for (var y = 0; y < 8; y++) {
+        for (var x = 0; x < 8; x++) {
+          final value = depth[y * 8 + x];
+          if (value.isFinite) {
+            expect(value, 0.5);
+            // The hypotenuse runs from pixel (4, 8) to (0, 0); a written
+            // pixel's far corner must be on its inner side.
+            expect(2 * (x + 1), lessThanOrEqualTo(y));
+          }
+        }
+      }
+      // Its center is inside the triangle, but its corner is not.
+      expect(depth[5 * 8 + 2], double.infinity);
+      expect(depth[7 * 8 + 0], 0.5);
+    });
+
+    test('interior edges leave no gaps', () {
+      // A full-screen quad split along its diagonal: pixels straddling the
+      // diagonal are covered by one triangle or the other.
+      final culler = OcclusionCuller()
+        ..begin(Matrix4.identity(), 8, 8)
+        ..rasterize(
+          Occluder(
+            positions: Float32List.fromList([
+              -1, -1, 0.5, //
+              1, -1, 0.5, //
+              -1, 1, 0.5, //
+              1, 1, 0.5, //
+            ]),
+            indices: const [0, 1, 3, 0, 3, 2],
+          ),
+          Matrix4.identity(),
+        );
+      expect(culler.depth.every((value) => value == 0.5), isTrue);
+    });
+
+    test('Occluder.box covers its bounds with twelve triangles', () {
+      final occluder = Occluder.box(
+        Aabb3.minMax(Vector3(-1, -2, -3), Vector3(1, 2, 3)),
+      );
+      expect(occluder.triangleCount, 12);
+      expect(occluder.positions, hasLength(24));
+      expect(occluder.indices.every((index) => index < 8), isTrue);
+    });
+  });
+}
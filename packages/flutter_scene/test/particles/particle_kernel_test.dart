@@ -0,0 +1,115 @@
+import 'package:flutter_scene/src/particles/distribution.dart';
+import 'package:flutter_scene/src/particles/emitter_shape.dart';
+import 'package:flutter_scene/src/particles/particle_kernel.dart';
+import 'package:flutter_scene/src/particles/particle_module.dart';
+import 'package:flutter_scene/src/particles/particle_storage.dart';
+import 'package:flutter_scene/src/particles/particle_system.dart';
+import 'package:flutter_scene/src/particles/spawner.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vector_math/vector_math.dart';
+
+// A module the kernel cannot fuse, so it splits the chain.
+class _Spin extends RotationModule {
+  const _Spin();
+}
+
+ParticleSystem _system(List<ParticleModule> modules, {required bool fused}) =>
+    ParticleSystem(
+      // Not a multiple of four, so the padded tail lanes are exercised.
+      maxParticles: 1001,
+      shape: const ConeEmitterShape(angle: 0.4, radius: 0.2),
+      spawner: Spawner(rate: 600),
+      lifetime: const UniformFloat(0.5, 1.5),
+      startSpeed: const UniformFloat(2, 5),
+      startAngularVelocity: const UniformFloat(-3, 3),
+      gravity: Vector3(0, -9.8, 0),
+      modules: modules,
+      seed: 11,
+      fusedKernels: fused,
+    );
+
+List<ParticleModule> _chain() => [
+  AccelerationModule(Vector3(0.5, 0, -0.25)),
+  LinearDragModule(0.4),
+  SizeOverLifeModule(
+    CurveFloat(
+      ParticleCurve(const [
+        ParticleKeyframe(0, 0.2),
+        ParticleKeyframe(0.3, 1),
+        ParticleKeyframe(1, 0),
+      ]),
+    ),
+  ),
+  ColorOverLifeModule(
+    GradientColor(
+      ColorGradient([
+        ColorStop(0, Vector4(1, 0.8, 0.2, 1)),
+        ColorStop(1, Vector4(0.2, 0.2, 0.2, 0)),
+      ]),
+    ),
+  ),
+  const FlipbookModule(frameCount: 16, randomStartFrame: true),
+  TurbulenceModule(strength: 0.3),
+  const _Spin(),
+  const RotationModule(),
+];
+
+void _expectClose(ParticleStorage a, ParticleStorage b) {
+  expect(a.aliveCount, b.aliveCount);
+  final columns = [
+    (a.posX, b.posX),
+    (a.posY, b.posY),
+    (a.posZ, b.posZ),
+    (a.velX, b.velX),
+    (a.velY, b.velY),
+    (a.velZ, b.velZ),
+    (a.rotation, b.rotation),
+    (a.size, b.size),
+    (a.colorR, b.colorR),
+    (a.colorA, b.colorA),
+    (a.frame, b.frame),
+  ];
+  for (final (x, y) in columns) {
+    for (var i = 0; i < a.aliveCount; i++) {
+      expect(x[i], closeTo(y[i], 1e-3 * (1 + y[i].abs())));
+    }
+  }
+  // Aging is shared, so lifetimes end on the same step.
+  expect(a.age.sublist(0, a.aliveCount), b.age.sublist(0, b.aliveCount));
+}
+
+void main() {
+  test('fuses the built-in modules and splits around the rest', () {
+    expect(ParticleKernel.fuses(LinearDragModule(1)), isTrue);
+    expect(ParticleKernel.fuses(TurbulenceModule()), isFalse);
+    expect(ParticleKernel.fuses(const _Spin()), isFalse);
+  });
+
+  test('matches the per-module path within float rounding', () {
+    final fused = _system(_chain(), fused: true);
+    final reference = _system(_chain(), fused: false);
+    for (var i = 0; i < 150; i++) {
+      fused.step(1 / 60);
+      reference.step(1 / 60);
+    }
+    expect(fused.storage.aliveCount, greaterThan(300));
+    _expectClose(fused.storage, reference.storage);
+  });
+
+  test('lane forms of constant and uniform distributions match', () {
+    List<ParticleModule> chain() => [
+      const SizeOverLifeModule(UniformFloat(0.5, 2)),
+      ColorOverLifeModule(
+        UniformColor(Vector4(1, 0, 0, 1), Vector4(0, 0, 1, 0)),
+      ),
+      const RotationModule(),
+    ];
+    final fused = _system(chain(), fused: true);
+    final reference = _system(chain(), fused: false);
+    for (var i = 0; i < 30; i++) {
+      fused.step(1 / 60);
+      reference.step(1 / 60);
+    }
+    _expectClose(fused.storage, reference.storage);
+  });
+}
@@ -0,0 +1,171 @@
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/particles/distribution.dart';
+import 'package:flutter_scene/src/particles/emitter_shape.dart';
+import 'package:flutter_scene/src/particles/particle_module.dart';
+import 'package:flutter_scene/src/particles/particle_storage.dart';
+import 'package:flutter_scene/src/particles/particle_system.dart';
+import 'package:flutter_scene/src/particles/particle_worker_pool.dart';
+import 'package:flutter_scene/src/particles/spawner.dart';
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vector_math/vector_math.dart';
+
+ParticleSystem _fountain({int seed = 3}) => ParticleSystem(
+  maxParticles: 500,
+  shape: const SphereEmitterShape(radius: 0.5),
+  spawner: Spawner(rate: 200),
+  lifetime: const UniformFloat(0.5, 1.5),
+  startSpeed: const UniformFloat(1, 4),
+  startAngularVelocity: const ConstantFloat(2),
+  gravity: Vector3(0, -9.8, 0),
+  modules: [LinearDragModule(0.3), const RotationModule()],
+  seed: seed,
+);
+
+// A custom module that throws once particles have lived [after] seconds.
+class _ThrowingModule extends ParticleModule {
+  const _ThrowingModule(this.after);
+
+  final double after;
+
+  @override
+  void update(ParticleStorage storage, double dt) {
+    for (var i = 0; i < storage.aliveCount; i++) {
+      if (storage.age[i] > after) throw StateError('module failed');
+    }
+  }
+}
+
+// The frame an on-thread run of [deltas] packs.
+Float32List _onThread(List<double> deltas, {bool randomFlipX = false}) {
+  final system = _fountain();
+  for (final dt in deltas) {
+    system.step(dt);
+  }
+  final out = Float32List(
+    system.storage.aliveCount * kParticleBillboardFloats,
+  );
+  packParticleBillboards(system.storage, out, randomFlipX: randomFlipX);
+  return out;
+}
+
+void main() {
+  // Uneven frame times, including one past maxFrameTime.
+  final deltas = [
+    for (var i = 0; i < 40; i++) i == 17 ? 0.4 : 0.011 + (i % 5) * 0.003,
+  ];
+
+  test('off-thread frames match the on-thread run exactly', () async {
+    final pool = ParticleWorkerPool(workers: 2);
+    final particles = pool.attach(_fountain());
+    // Overlapping steps, some batching several deltas, resolve in order.
+    final frames = [
+      particles.step(deltas.sublist(0, 10)),
+      particles.step(deltas.sublist(10, 11)),
+      particles.step(deltas.sublist(11), randomFlipX: true),
+    ];
+    final results = await Future.wait(frames);
+
+    expect(results[1]!.instances, _onThread(deltas.sublist(0, 11)));
+    final last = results[2]!;
+    expect(last.count, greaterThan(0));
+    expect(last.instances, _onThread(deltas, randomFlipX: true));
+    pool.dispose();
+  });
+
+  test('systems on one worker stay independent', () async {
+    final pool = ParticleWorkerPool(workers: 1);
+    final a = pool.attach(_fountain());
+    final b = pool.attach(_fountain(seed: 9));
+    final frameA = await a.step(deltas);
+    await b.step(deltas);
+    expect(frameA!.instances, _onThread(deltas));
+
+    b.dispose();
+    expect(await b.step(deltas), isNull);
+    pool.dispose();
+    expect(await a.step(deltas), isNull);
+  });
+
+  test('a module that throws fails its steps instead of hanging', () async {
+    final pool = ParticleWorkerPool(workers: 2);
+    final failing = pool.attach(
+      ParticleSystem(
+        maxParticles: 50,
+        shape: const SphereEmitterShape(radius: 0.5),
+        spawner: Spawner(rate: 200),
+        lifetime: const ConstantFloat(2),
+        modules: const [_ThrowingModule(0.1)],
+      ),
+    );
+    final healthy = pool.attach(_fountain());
+
+    expect(await failing.step(deltas.sublist(0, 2)), isNotNull);
+    expect(failing.error, isNull);
+    // The step that throws, and one queued behind it, both resolve.
+    final steps = [failing.step(deltas), failing.step(deltas)];
+    expect(await Future.wait(steps), [isNull, isNull]);
+    expect(failing.error, isNotNull);
+    expect(await failing.step(deltas), isNull);
+
+    // The other worker's system keeps running.
+    final frame = await healthy.step(deltas);
+    expect(frame!.instances, _onThread(deltas));
+    pool.dispose();
+  });
+
+  test('setting changes and resets reach the worker', () async {
+    // Changes made between steps, applied to an on-thread run at the same
+    // point.
+    void change(ParticleSystem system) {
+      system
+        ..shape = const SphereEmitterShape(radius: 2)
+        ..lifetime = const ConstantFloat(0.3)
+        ..startColor = ConstantColor(Vector4(1, 0, 0, 1))
+        ..looping = false
+        ..duration = 0.4
+        ..fusedKernels = false;
+      system.gravity.y = -2;
+      system.spawner.rate = 50;
+    }
+
+    final expected = _fountain();
+    for (final dt in deltas.sublist(0, 10)) {
+      expected.step(dt);
+    }
+    change(expected);
+    for (final dt in deltas.sublist(10)) {
+      expected.step(dt);
+    }
+    final out = Float32List(
+      expected.storage.aliveCount * kParticleBillboardFloats,
+    );
+    packParticleBillboards(expected.storage, out);
+
+    final pool = ParticleWorkerPool(workers: 1);
+    final system = _fountain();
+    final particles = pool.attach(system);
+    final first = particles.step(deltas.sublist(0, 10));
+    change(system);
+    final changed = await particles.step(deltas.sublist(10));
+    await first;
+    expect(changed!.count, greaterThan(0));
+    expect(changed.instances, out);
+
+    // A reset replays from time zero with the changed settings.
+    system.reset();
+    final restarted = await particles.step(deltas.sublist(0, 10));
+    final fresh = _fountain();
+    change(fresh);
+    for (final dt in deltas.sublist(0, 10)) {
+      fresh.step(dt);
+    }
+    final freshOut = Float32List(
+      fresh.storage.aliveCount * kParticleBillboardFloats,
+    );
+    packParticleBillboards(fresh.storage, freshOut);
+    expect(restarted!.count, greaterThan(0));
+    expect(restarted.instances, freshOut);
+    pool.dispose();
+  });
+}
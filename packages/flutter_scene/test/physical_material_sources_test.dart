@@ -199,7 +199,7 @@ void main() {
   // A sampler added to either stage moves a number here and fails loudly.
   //
   // The one pairing over the 16-unit minimum is a lit morphed skinned draw
-  // at 17, accepted deliberately because real GLES3 hardware reports 32 or
+  // (band or sparse deltas) at 17, accepted deliberately because real GLES3 hardware reports 32 or
   // more units; see TODO(morph-sampler-budget) in morphed_geometry.dart for
   // the escape (joints and morph deltas sharing one vertex texture).
   test('vertex sampler counts pin the combined pairing budget', () async {
@@ -211,12 +211,16 @@ void main() {
         'SkinnedVertex': 1,
         'MorphedUnskinnedVertex': 1,
         'MorphedSkinnedVertex': 2,
+        'MorphedSparseUnskinnedVertex': 1,
+        'MorphedSparseSkinnedVertex': 2,
       };
       const expectedCombined = {
         'UnskinnedVertex': 15,
         'SkinnedVertex': 16,
         'MorphedUnskinnedVertex': 16,
         'MorphedSkinnedVertex': 17,
+        'MorphedSparseUnskinnedVertex': 16,
+        'MorphedSparseSkinnedVertex': 17,
       };
       final manifest =
           jsonDecode(File('shaders/base.shaderbundle.json').readAsStringSync())
@@ -52,6 +52,42 @@ void main() {
     });
   });
 
+  group('SubmissionStampedSlots', () {
+    test('a slot is reused only after the work reading it completes', () {
+      final tracker = GpuSubmissionTracker();
+      final slots = SubmissionStampedSlots(2, tracker);
+
+      // Two scenes' renders before either submission completes.
+      final first = slots.claim();
+      final a = tracker.record();
+      final second = slots.claim();
+      final b = tracker.record();
+      expect(first, isNotNull);
+      expect(second, isNot(first));
+      expect(slots.claim(), isNull);
+
+      tracker.complete(a);
+      expect(slots.claim(), first);
+      // Rebinding keeps a slot in flight.
+      slots.touch(second!);
+      tracker.complete(b);
+      expect(slots.claim(), isNull);
+      tracker.complete(tracker.record());
+      expect(slots.claim(), second);
+    });
+
+    test('grow adds a claimed slot', () {
+      final tracker = GpuSubmissionTracker();
+      final slots = SubmissionStampedSlots(1, tracker);
+      expect(slots.claim(), 0);
+      tracker.record();
+      expect(slots.claim(), isNull);
+      expect(slots.grow(), 1);
+      expect(slots.length, 2);
+      expect(slots.claim(), isNull);
+    });
+  });
+
   group('TransientArena.planEmplacement', () {
     test('aligns within the block', () {
       final plan = TransientArena.planEmplacement(
@@ -89,6 +125,52 @@ void main() {
     });
   });
 
+  group('TransientBlockSizer', () {
+    const policy = TransientSizingPolicy(
+      windowFrames: 4,
+      minBlockLengthInBytes: 1024,
+      maxBlockLengthInBytes: 64 * 1024,
+    );
+
+    test('shrinks to the window peak only after a full window', () {
+      final sizer = TransientBlockSizer(policy);
+      final sizes = <int>[];
+      var current = 16 * 1024;
+      for (var frame = 0; frame < 5; frame++) {
+        sizer
+          ..addSubmission(1500)
+          ..addSubmission(3000);
+        current = sizer.endFrame(current);
+        sizes.add(current);
+      }
+      expect(sizes, [16384, 16384, 16384, 4096, 4096]);
+    });
+
+    test('grows the frame after a larger submission', () {
+      final sizer = TransientBlockSizer(policy);
+      sizer.addSubmission(20000);
+      expect(sizer.endFrame(4096), 32768);
+      // Past the bound, submissions roll over instead.
+      sizer.addSubmission(1 << 20);
+      expect(sizer.endFrame(32768), 65536);
+    });
+
+    test('a spike inside the window holds the size', () {
+      final sizer = TransientBlockSizer(policy);
+      var current = 8192;
+      sizer.addSubmission(8000);
+      current = sizer.endFrame(current);
+      for (var frame = 0; frame < 3; frame++) {
+        sizer.addSubmission(500);
+        current = sizer.endFrame(current);
+      }
+      expect(current, 8192);
+      // The spike leaves the window.
+      sizer.addSubmission(500);
+      expect(sizer.endFrame(current), 1024);
+    });
+  });
+
   if (!_gpuAvailable()) {
     test(
       'transient arena suite (skipped: no GPU device)',
@@ -314,6 +396,77 @@ void main() {
       expect(pool.bufferCount, lessThanOrEqualTo(1));
     });
 
+    test('reports per-frame stats', () {
+      final tracker = GpuSubmissionTracker();
+      final arena = TransientArena(
+        tracker,
+        alignment: 256,
+        blockLengthInBytes: 1024,
+      );
+
+      arena.emplace(_bytes(100));
+      arena.emplace(_bytes(100));
+      arena.emplace(_bytes(3000)); // oversize
+      final id = tracker.record();
+      arena.beginFrame();
+      var stats = arena.lastFrameStats;
+      expect(stats.emplacements, 3);
+      expect(stats.bytesEmplaced, 3200);
+      expect(stats.oversizeHits, 1);
+      expect(stats.blocksAcquired, 2);
+      expect(stats.blocksAllocated, 2);
+      expect(stats.wastedBytes, 1024 + 4096 - 3200);
+      expect(stats.inFlightBlocks, 2);
+      expect(stats.stalls, 0);
+
+      // The first frame's block is still in flight: a stall.
+      arena.emplace(_bytes(100));
+      tracker.record();
+      arena.beginFrame();
+      stats = arena.lastFrameStats;
+      expect(stats.stalls, 1);
+      expect(stats.peakLiveBlocks, 3);
+
+      tracker.complete(id);
+      arena.beginFrame();
+      expect(arena.lastFrameStats.emplacements, 0);
+    });
+
+    test('a sizing policy releases blocks only after quiet frames', () {
+      final tracker = GpuSubmissionTracker();
+      final arena = TransientArena(
+        tracker,
+        alignment: 256,
+        blockLengthInBytes: 1024,
+        sizing: const TransientSizingPolicy(
+          idleFrames: 3,
+          minBlockLengthInBytes: 1024,
+        ),
+      );
+
+      // Three blocks in flight at once, then one block a frame.
+      final ids = <int>[];
+      for (var pass = 0; pass < 3; pass++) {
+        arena.emplace(_bytes(512));
+        ids.add(tracker.record());
+      }
+      ids.forEach(tracker.complete);
+      arena.beginFrame();
+      expect(arena.blockCount, 3);
+      for (var frame = 0; frame < 3; frame++) {
+        arena.emplace(_bytes(512));
+        tracker.complete(tracker.record());
+        arena.beginFrame();
+        expect(arena.blockCount, 3);
+      }
+      // The two surplus blocks have now been idle for more than 3 frames.
+      arena.emplace(_bytes(512));
+      tracker.complete(tracker.record());
+      arena.beginFrame();
+      expect(arena.blockCount, 1);
+      expect(arena.lastFrameStats.releasedBlocks, 2);
+    });
+
     test('single flush per block: staged bytes upload on seal', () {
       final tracker = GpuSubmissionTracker();
       final arena = TransientArena(
@@ -0,0 +1,91 @@
+import 'dart:typed_data';
+
+import 'package:flutter_scene/scene.dart';
+import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/render/frame_transients.dart';
+import 'package:flutter_scene/src/render/retained_instance_buffer.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+bool _gpuAvailable() {
+  try {
+    Scene();
+    return true;
+  } catch (_) {
+    return false;
+  }
+}
+
+void main() {
+  TestWidgetsFlutterBinding.ensureInitialized();
+
+  if (!_gpuAvailable()) {
+    test(
+      'retained instance buffer suite (skipped: no GPU device)',
+      () {},
+      skip: 'Requires a GPU device.',
+    );
+    return;
+  }
+
+  test('a buffer still read in flight is never rewritten', () {
+    const recordFloats = 4;
+    final tracker = GpuSubmissionTracker();
+    final retained = RetainedInstanceBuffer(tracker);
+    final data = Float32List(8 * recordFloats);
+    final winding = Uint8List(8);
+    // The buffer each pending submission reads.
+    final inFlight = <int, gpu.DeviceBuffer>{};
+
+    void frame(int value) {
+      data[0] = value.toDouble();
+      retained.markDirty(0, 1);
+      retained.sync(data, winding, recordFloats);
+      for (final reading in inFlight.values) {
+        expect(identical(retained.buffer, reading), isFalse);
+      }
+      inFlight[tracker.record()] = retained.buffer;
+    }
+
+    // The GPU lags: nothing completes for five frames, so the ring grows
+    // past its three buffers rather than overwrite one.
+    for (var i = 0; i < 5; i++) {
+      frame(i);
+    }
+    expect(retained.ringLength, 5);
+
+    // Once the GPU catches up the ring is reused, not grown.
+    for (final id in inFlight.keys.toList()) {
+      tracker.complete(id);
+      inFlight.remove(id);
+    }
+    for (var i = 5; i < 10; i++) {
+      frame(i);
+      final oldest = inFlight.keys.first;
+      tracker.complete(oldest);
+      inFlight.remove(oldest);
+    }
+    expect(retained.ringLength, 5);
+  });
+
+  test('an unchanged buffer drawn again stays in flight', () {
+    const recordFloats = 4;
+    final tracker = GpuSubmissionTracker();
+    final retained = RetainedInstanceBuffer(tracker);
+    final data = Float32List(2 * recordFloats);
+    final winding = Uint8List(2);
+    retained.sync(data, winding, recordFloats);
+    final first = retained.buffer;
+    final a = tracker.record();
+    tracker.complete(a);
+
+    // Drawn unchanged in a frame the GPU has not finished.
+    expect(retained.sync(data, winding, recordFloats), 0);
+    tracker.record();
+    for (var i = 0; i < 4; i++) {
+      retained.markDirty(0, 1);
+      retained.sync(data, winding, recordFloats);
+      expect(identical(retained.buffer, first), isFalse);
+      tracker.record();
+    }
+  });
+}
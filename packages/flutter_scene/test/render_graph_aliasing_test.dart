@@ -0,0 +1,217 @@
+// Covers lifetime aliasing in the render graph: the schedule culls passes
+// nothing reads and bounds each pass's texture lifetime by its last reader,
+// and the allocator shares a texture between compatible descriptors whose
+// lifetimes do not overlap (textures are plain ids, so no GPU is needed).
+
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/render/frame_transients.dart';
+import 'package:flutter_scene/src/render/render_graph.dart';
+import 'package:flutter_scene/src/render/render_graph_capture.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+class _ThrowingWriter implements TransientWriter {
+  @override
+  gpu.BufferView emplace(ByteData bytes) =>
+      throw UnimplementedError('not used by these passes');
+}
+
+class _FakePass extends RenderGraphPass {
+  _FakePass(
+    this.name, {
+    this.inputs,
+    this.outputs,
+    this.hasSideEffects = false,
+    this.body,
+  });
+
+  @override
+  final String name;
+  @override
+  final Set<Object>? inputs;
+  @override
+  final Set<Object>? outputs;
+  @override
+  final bool hasSideEffects;
+  final void Function(RenderGraphContext context)? body;
+
+  @override
+  void execute(RenderGraphContext context) => body?.call(context);
+}
+
+TransientTextureDescriptor _color(String name, {int size = 64}) =>
+    TransientTextureDescriptor.color(
+      width: size,
+      height: size,
+      format: gpu.PixelFormat.r16g16b16a16Float,
+      debugName: name,
+    );
+
+TransientTextureAllocator<int> _allocator({bool aliasing = true}) {
+  var next = 0;
+  return TransientTextureAllocator<int>(
+    create: (_) => next++,
+    aliasing: aliasing,
+  )..beginFrame();
+}
+
+void main() {
+  test('culls passes whose outputs nothing reads', () {
+    final passes = [
+      _FakePass('depth', inputs: const {}, outputs: const {'depth'}),
+      _FakePass('unread', inputs: const {'depth'}, outputs: const {'x'}),
+      _FakePass('ao', inputs: const {'depth'}, outputs: const {'ao'}),
+      _FakePass(
+        'scene',
+        inputs: const {'ao'},
+        outputs: const {'color'},
+        hasSideEffects: true,
+      ),
+    ];
+    final schedule = RenderGraphSchedule(passes);
+    expect(schedule.culled, [false, true, false, false]);
+    // depth is last read by ao, ao by scene; scene's outputs have no
+    // reader.
+    expect(schedule.releaseAfter, [2, null, 3, 3]);
+  });
+
+  test('a pass reading anything keeps earlier passes alive', () {
+    final passes = [
+      _FakePass('a', inputs: const {}, outputs: const {'a'}),
+      _FakePass('custom'),
+      _FakePass('b', inputs: const {}, outputs: const {'b'}),
+    ];
+    final schedule = RenderGraphSchedule(passes);
+    expect(schedule.culled, [false, false, true]);
+    expect(schedule.releaseAfter, [1, null, null]);
+  });
+
+  test('execute skips culled passes and reports them', () {
+    final ran = <String>[];
+    final graph = RenderGraph()
+      ..addPass(
+        _FakePass(
+          'unread',
+          inputs: const {},
+          outputs: const {'x'},
+          body: (_) => ran.add('unread'),
+        ),
+      )
+      ..addPass(_FakePass('sink', body: (_) => ran.add('sink')));
+    // The sink is undeclared, so it may read 'x': nothing is culled.
+    final capturer = RenderGraphCapturer(
+      request: const RenderGraphCaptureRequest(captureImages: false),
+    );
+    graph.execute(
+      transientsBuffer: _ThrowingWriter(),
+      texturePool: TransientTexturePool(),
+      observer: capturer,
+    );
+    expect(ran, ['unread', 'sink']);
+    expect(capturer.finish(pixelWidth: 1, pixelHeight: 1).culledPasses, []);
+
+    ran.clear();
+    final culling = RenderGraph()
+      ..addPass(
+        _FakePass(
+          'unread',
+          inputs: const {},
+          outputs: const {'x'},
+          body: (_) => ran.add('unread'),
+        ),
+      )
+      ..addPass(
+        _FakePass(
+          'sink',
+          inputs: const {},
+          outputs: const {},
+          hasSideEffects: true,
+          body: (_) => ran.add('sink'),
+        ),
+      );
+    final second = RenderGraphCapturer(
+      request: const RenderGraphCaptureRequest(captureImages: false),
+    );
+    culling.execute(
+      transientsBuffer: _ThrowingWriter(),
+      texturePool: TransientTexturePool(),
+      observer: second,
+    );
+    expect(ran, ['sink']);
+    final result = second.finish(pixelWidth: 1, pixelHeight: 1);
+    expect(result.culledPasses, ['unread']);
+    expect(result.passes.map((p) => p.name), ['sink']);
+  });
+
+  test('disjoint lifetimes share a texture, overlapping ones do not', () {
+    final allocator = _allocator();
+    final first = allocator.reservePasses(3);
+    // Pass 0's output is read by pass 1 only.
+    allocator.beginPass(first, releaseAfter: first + 1);
+    final a = allocator.acquire(_color('a'));
+    allocator.endPass();
+    // Pass 1 reads a, so its own target must not reuse a's texture.
+    allocator.beginPass(first + 1, releaseAfter: first + 2);
+    final b = allocator.acquire(_color('b'));
+    allocator.endPass();
+    expect(b, isNot(a));
+    // Pass 2 runs after a's last reader.
+    allocator.beginPass(first + 2, releaseAfter: first + 2);
+    final c = allocator.acquire(_color('c'));
+    allocator.endPass();
+    expect(c, a);
+    expect(allocator.allocatedCount, 2);
+    final size = _color('a').sizeInBytes;
+    expect(allocator.unaliasedBytes, 3 * size);
+    expect(allocator.aliasedBytes, 2 * size);
+  });
+
+  test('only compatible descriptors alias', () {
+    final allocator = _allocator();
+    final first = allocator.reservePasses(2);
+    allocator.beginPass(first, releaseAfter: first);
+    final a = allocator.acquire(_color('a'));
+    allocator.endPass();
+    allocator.beginPass(first + 1, releaseAfter: first + 1);
+    final smaller = allocator.acquire(_color('b', size: 32));
+    allocator.endPass();
+    expect(smaller, isNot(a));
+  });
+
+  test('undeclared lifetimes and disabled aliasing keep textures apart', () {
+    for (final aliasing in [true, false]) {
+      final allocator = _allocator(aliasing: aliasing);
+      final first = allocator.reservePasses(2);
+      allocator.beginPass(first, releaseAfter: aliasing ? null : first);
+      final a = allocator.acquire(_color('a'));
+      allocator.endPass();
+      allocator.beginPass(first + 1, releaseAfter: first + 1);
+      expect(allocator.acquire(_color('b')), isNot(a));
+      allocator.endPass();
+    }
+  });
+
+  test('steady frames rebind the same textures per slot', () {
+    final allocator = _allocator();
+    List<int> frame() {
+      final first = allocator.reservePasses(2);
+      allocator.beginPass(first, releaseAfter: first + 1);
+      final a = allocator.acquire(_color('a'));
+      allocator.endPass();
+      allocator.beginPass(first + 1, releaseAfter: first + 1);
+      final b = allocator.acquire(_color('b'));
+      allocator.endPass();
+      allocator.beginFrame();
+      return [a, b];
+    }
+
+    final slot0 = frame();
+    final slot1 = frame();
+    // Frames in flight never share a texture.
+    expect(slot1.toSet().intersection(slot0.toSet()), isEmpty);
+    expect(frame(), slot0);
+    expect(frame(), slot1);
+    expect(allocator.allocatedCount, 4);
+  });
+}
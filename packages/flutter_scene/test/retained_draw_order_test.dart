@@ -0,0 +1,273 @@
+// Covers RetainedDrawOrder: while the scene's structure holds, a frame's
+// draws are placed from the last frame's order and settled, giving the same
+// order a full sort would; items entering view and swapped materials are
+// patched in, a structure change or a reversed view sorts from scratch,
+// views and shadow tiles sorting different sets each keep their own order,
+// and batch ends carry over while the order holds.
+// Uses the stub Geometry / Material pattern from bvh_test.dart.
+
+import 'dart:math' as math;
+
+import 'package:flutter_scene/scene.dart';
+import 'package:flutter_scene/src/gpu/gpu.dart' as gpu;
+import 'package:flutter_scene/src/render/render_scene.dart';
+import 'package:flutter_scene/src/render/retained_draw_order.dart';
+import 'package:flutter_scene/src/render/shadow_encoder.dart'
+    show ShadowCasterFilter;
+import 'package:flutter_test/flutter_test.dart';
+import 'package:vector_math/vector_math.dart';
+
+class _StubGeometry extends Geometry {
+  @override
+  void bind(
+    gpu.RenderPass pass,
+    TransientWriter transientsBuffer,
+    Matrix4 modelTransform,
+    Matrix4 cameraTransform,
+    Vector3 cameraPosition, {
+    gpu.Shader? shaderOverride,
+    double depthBias = 0.0,
+  }) {
+    throw UnsupportedError('Stub geometry is not renderable');
+  }
+}
+
+class _StubMaterial extends Material {
+  @override
+  void bind(
+    gpu.RenderPass pass,
+    TransientWriter transientsBuffer,
+    Lighting lighting,
+  ) {
+    throw UnsupportedError('Stub material is not renderable');
+  }
+}
+
+class _Draw {
+  _Draw(this.item, this.depth);
+
+  final RenderItem item;
+  final double depth;
+}
+
+// Material grouping, then front to back, as the encoders order draws.
+int _compare(_Draw a, _Draw b) {
+  final byMaterial = identityHashCode(
+    a.item.material,
+  ).compareTo(identityHashCode(b.item.material));
+  if (byMaterial != 0) return byMaterial;
+  return a.depth.compareTo(b.depth);
+}
+
+RenderItem _itemOf(_Draw draw) => draw.item;
+
+class _Frame {
+  _Frame(int count, {int materials = 8}) {
+    final palette = [for (var i = 0; i < materials; i++) _StubMaterial()];
+    final geometry = _StubGeometry();
+    for (var i = 0; i < count; i++) {
+      scene.add(
+        RenderItem(geometry: geometry, material: palette[i % materials]),
+      );
+      depths.add(_random.nextDouble() * 100);
+    }
+  }
+
+  final RenderScene scene = RenderScene();
+  final List<double> depths = [];
+  final math.Random _random = math.Random(1);
+  late final RetainedDrawOrder order = RetainedDrawOrder(scene);
+  int fullSorts = 0;
+
+  // Moves every depth a little, as a small camera step does.
+  void drift() {
+    for (var i = 0; i < depths.length; i++) {
+      depths[i] += _random.nextDouble() * 0.5;
+    }
+  }
+
+  // Submits [visible] items (every item by default) in a shuffled order,
+  // sorts them, checks the result against a full sort, and returns it.
+  List<_Draw> sort([Iterable<int>? visible, RetainedDrawOrder? into]) {
+    final items = scene.items;
+    final draws = [
+      for (final i in visible ?? Iterable<int>.generate(items.length))
+        _Draw(items[i], depths[i]),
+    ]..shuffle(_random);
+    final expected = List.of(draws)..sort(_compare);
+    (into ?? order).sort(draws, _compare, _itemOf, (records) {
+      fullSorts++;
+      records.sort(_compare);
+    });
+    expect(draws, expected);
+    return draws;
+  }
+}
+
+// Draws batch while they share a material, unless one was split off.
+final Set<RenderItem> _split = {};
+
+bool _joins(_Draw first, _Draw next) =>
+    identical(first.item.material, next.item.material) &&
+    !_split.contains(next.item);
+
+int _finds = 0;
+
+int _findEnd(List<_Draw> draws, int start) {
+  _finds++;
+  var end = start + 1;
+  while (end < draws.length && _joins(draws[start], draws[end])) {
+    end++;
+  }
+  return end;
+}
+
+// Walks [draws] batch by batch, as the encoders do, returning the ends.
+List<int> _batchEnds(List<_Draw> draws, RetainedDrawOrder order) {
+  final ends = <int>[];
+  var index = 0;
+  while (index < draws.length) {
+    index = order.batchEnd(draws, index, _findEnd, _joins);
+    ends.add(index);
+  }
+  return ends;
+}
+
+void main() {
+  test('reuses the last order while the structure holds', () {
+    final frame = _Frame(500);
+    frame.sort();
+    expect(frame.order.lastReused, isFalse);
+    expect(frame.fullSorts, 1);
+    for (var i = 0; i < 5; i++) {
+      frame
+        ..drift()
+        ..sort();
+      expect(frame.order.lastReused, isTrue);
+    }
+    expect(frame.fullSorts, 1);
+  });
+
+  test('merges items that came into view', () {
+    final frame = _Frame(400);
+    frame.sort([for (var i = 0; i < 300; i++) i]);
+    // Thirty items leave view and sixty enter.
+    frame.sort([for (var i = 30; i < 360; i++) i]);
+    expect(frame.order.lastReused, isTrue);
+    expect(frame.fullSorts, 1);
+  });
+
+  test('patches an item whose material changed', () {
+    final frame = _Frame(300);
+    frame.sort();
+    frame.scene.items[17].material = frame.scene.items[18].material;
+    frame.sort();
+    expect(frame.order.lastReused, isTrue);
+  });
+
+  test('sorts from scratch after a structure change', () {
+    final frame = _Frame(300);
+    frame.sort();
+    // The last item takes the removed one's slot.
+    frame.scene.remove(frame.scene.items[5]);
+    frame.depths[5] = frame.depths.removeLast();
+    frame.sort();
+    expect(frame.order.lastReused, isFalse);
+    expect(frame.fullSorts, 2);
+    frame.sort();
+    expect(frame.order.lastReused, isTrue);
+  });
+
+  test('shadow tiles keep their own orders', () {
+    final frame = _Frame(400);
+    final near = [for (var i = 0; i < 200; i++) i];
+    final far = [for (var i = 200; i < 400; i++) i];
+    final first = frame.scene.shadowDrawOrder(0, ShadowCasterFilter.all);
+    final second = frame.scene.shadowDrawOrder(1, ShadowCasterFilter.all);
+    expect(second, isNot(same(first)));
+    expect(
+      frame.scene.shadowDrawOrder(0, ShadowCasterFilter.dynamicOnly),
+      isNot(same(first)),
+    );
+    for (var i = 0; i < 4; i++) {
+      frame
+        ..drift()
+        ..sort(near, first)
+        ..sort(far, second);
+      if (i > 0) {
+        expect(first.lastReused, isTrue);
+        expect(second.lastReused, isTrue);
+      }
+    }
+    expect(frame.fullSorts, 2);
+
+    // One order shared by both tiles starts each from the other's ranks.
+    frame
+      ..sort(near)
+      ..sort(far);
+    expect(frame.order.lastReused, isFalse);
+  });
+
+  test('views keep their own orders', () {
+    final scene = RenderScene();
+    final main = scene.opaqueDrawOrder(DrawOrderView.screen, 0);
+    expect(scene.opaqueDrawOrder(DrawOrderView.screen, 0), same(main));
+    for (final other in [
+      scene.opaqueDrawOrder(DrawOrderView.screen, 1),
+      scene.opaqueDrawOrder(DrawOrderView.texture, 0),
+      scene.opaqueDrawOrder(DrawOrderView.planarCapture, 0),
+      scene.opaqueDrawOrder(DrawOrderView.cubeFace, 0),
+      scene.depthDrawOrder(DrawOrderView.screen, 0),
+    ]) {
+      expect(other, isNot(same(main)));
+    }
+    final faces = [
+      for (var face = 0; face < 6; face++)
+        scene.opaqueDrawOrder(DrawOrderView.cubeFace, face),
+    ];
+    expect(faces.toSet(), hasLength(6));
+  });
+
+  test('keeps batch ends while the order holds', () {
+    final frame = _Frame(300, materials: 4);
+    _split.clear();
+    _finds = 0;
+    final first = _batchEnds(frame.sort(), frame.order);
+    expect(first, hasLength(4));
+    expect(_finds, 4);
+
+    // The same order again reuses every batch.
+    _finds = 0;
+    expect(_batchEnds(frame.sort(), frame.order), first);
+    expect(_finds, 0);
+
+    // A batch split without moving any draw is found again.
+    final draws = frame.sort();
+    _split.add(draws[10].item);
+    _finds = 0;
+    final split = _batchEnds(draws, frame.order);
+    expect(split, [10, ...first]);
+    expect(_finds, 2);
+    _split.clear();
+
+    // A changed order finds every batch afresh.
+    frame.drift();
+    for (var i = 0; i < frame.depths.length; i++) {
+      frame.depths[i] = -frame.depths[i];
+    }
+    _finds = 0;
+    expect(_batchEnds(frame.sort(), frame.order), first);
+    expect(_finds, 4);
+  });
+
+  test('falls back to the full sort when the view reverses', () {
+    final frame = _Frame(300);
+    frame.sort();
+    for (var i = 0; i < frame.depths.length; i++) {
+      frame.depths[i] = -frame.depths[i];
+    }
+    frame.sort();
+    expect(frame.order.lastReused, isFalse);
+    expect(frame.fullSorts, 2);
+  });
+}
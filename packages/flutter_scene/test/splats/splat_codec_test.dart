@@ -8,6 +8,8 @@ import 'package:flutter_scene/src/splats/splat_codec.dart';
 import 'package:flutter_scene/src/splats/splat_data.dart';
 // ignore: implementation_imports
 import 'package:flutter_scene/src/splats/splat_sorter.dart';
+// ignore: implementation_imports
+import 'package:flutter_scene/src/splats/splat_stream.dart';
 
 /// Builds a binary little-endian Gaussian-splat PLY with [restPerChannel]
 /// f_rest coefficients per channel, from per-splat property maps in
@@ -59,6 +61,34 @@ Uint8List buildSplatPly(
 
 double logit(double p) => math.log(p / (1 - p));
 
+/// A seeded set of [count] splats in a 20-unit cube with unit-quaternion
+/// rotations, scales from 0.01 to 1, and rest SH within the compressed
+/// PLY's range.
+SplatData _randomSplats(int count, {int shDegree = 0}) {
+  final rng = math.Random(7);
+  final data = SplatData.zeroed(count, shDegree: shDegree);
+  for (var i = 0; i < count; i++) {
+    for (var a = 0; a < 3; a++) {
+      data.positions[i * 3 + a] = rng.nextDouble() * 20 - 10;
+      data.scales[i * 3 + a] = math.exp(rng.nextDouble() * 4.6 - 4.6);
+      data.colors[i * 3 + a] = rng.nextDouble();
+    }
+    final q = [for (var a = 0; a < 4; a++) rng.nextDouble() * 2 - 1];
+    final length = math.sqrt(q.fold(0.0, (s, v) => s + v * v));
+    for (var a = 0; a < 4; a++) {
+      data.rotations[i * 4 + a] = q[a] / length;
+    }
+    data.opacities[i] = rng.nextDouble();
+  }
+  final sh = data.sh;
+  if (sh != null) {
+    for (var k = 0; k < sh.length; k++) {
+      sh[k] = rng.nextDouble() * 2 - 1;
+    }
+  }
+  return data;
+}
+
 void main() {
   test('parses the training PLY layout with its space transforms', () {
     final bytes = buildSplatPly([
@@ -167,12 +197,9 @@ void main() {
     data.colors.setAll(0, [1, 0, 0, 0, 1, 0]);
 
     final packed = packSplats(data);
-    expect(
-      packed.paramsWidth * packed.paramsHeight * 4,
-      packed.paramsTexels.length,
-    );
+    final t = packed.paramsTexels as Float32List;
+    expect(packed.paramsWidth * packed.paramsHeight * 4, t.length);
 
-    final t = packed.paramsTexels;
     // Splat 0, texel 0, position and opacity.
     expect(t.sublist(0, 4), [1, 2, 3, 0.25]);
     // Texels 1-2, xx, xy, xz, yy | yz, zz.
@@ -203,7 +230,7 @@ void main() {
     }
     final packed = packSplats(data);
     expect(packed.shStride, 4);
-    final sh = packed.shTexels!;
+    final sh = packed.shTexels! as Float32List;
     // Splat 2, coefficient 1, value 2*100 + 10 + channel.
     final base = (2 * packed.shStride + 1) * 4;
     expect(sh.sublist(base, base + 3), [210.0, 211.0, 212.0]);
@@ -245,6 +272,192 @@ void main() {
     expect(order.toSet(), {0.0, 1.0});
   });
 
+  test('packs compact texels within quantization tolerance', () {
+    final data = _randomSplats(600, shDegree: 1);
+    final full = packSplats(data);
+    final compact = packSplats(data, packing: SplatPacking.compact);
+    expect(compact.packing, SplatPacking.compact);
+    expect(compact.paramsTexels, isA<Uint8List>());
+    expect(compact.chunkWidth * compact.chunkHeight, greaterThanOrEqualTo(24));
+    expect(compact.gpuBytes, lessThan(full.gpuBytes ~/ 3));
+
+    // Decoding the written records recovers every splat closely.
+    final decoded = parseCompressedSplatPly(encodeCompressedSplatPly(data));
+    expect(decoded.count, data.count);
+    for (var i = 0; i < data.count; i++) {
+      for (var a = 0; a < 3; a++) {
+        final o = i * 3 + a;
+        // 10 or 11 bits over a chunk spanning 20 units.
+        expect(decoded.positions[o], closeTo(data.positions[o], 0.03));
+        expect(decoded.colors[o], closeTo(data.colors[o], 1 / 255 + 1e-6));
+        expect(
+          decoded.scales[o] / data.scales[o],
+          closeTo(1.0, 0.02),
+          reason: 'log scale quantized over its chunk range',
+        );
+      }
+      expect(decoded.opacities[i], closeTo(data.opacities[i], 1 / 255));
+      // q and -q are the same rotation.
+      var dot = 0.0;
+      for (var a = 0; a < 4; a++) {
+        dot += decoded.rotations[i * 4 + a] * data.rotations[i * 4 + a];
+      }
+      expect(dot.abs(), closeTo(1.0, 2e-3));
+    }
+    for (var k = 0; k < data.sh!.length; k++) {
+      expect(decoded.sh![k], closeTo(data.sh![k], 8.0 / 255));
+    }
+  });
+
+  test('sniffs compressed PLY and loads it compact without requantizing', () {
+    final data = _randomSplats(300, shDegree: 2);
+    final bytes = encodeCompressedSplatPly(data);
+    expect(sniffSplatFormat(bytes), SplatFormat.compressedPly);
+    expect(sniffSplatFormat(buildSplatPly([{}])), SplatFormat.ply);
+
+    final packed = decodeSplats(
+      bytes,
+      SplatFormat.compressedPly,
+      options: const SplatDecodeOptions(packing: SplatPacking.compact),
+    );
+    final direct = packSplats(data, packing: SplatPacking.compact);
+    expect(packed.paramsTexels, direct.paramsTexels);
+    expect(packed.shStride, 8);
+    expect(packed.data.count, data.count);
+    // Same ranges, except SH: the file stores it over a fixed range where
+    // packing measures each chunk.
+    final chunks = packed.chunkTexels!;
+    for (var k = 0; k < chunks.length; k++) {
+      if (k % (kSplatChunkTexels * 4) case 3 || 7) {
+        expect(chunks[k].abs(), closeTo(3.984375, 1e-6));
+      } else {
+        expect(chunks[k], direct.chunkTexels![k]);
+      }
+    }
+
+    // Loading it full dequantizes into float texels.
+    final full = decodeSplats(bytes, SplatFormat.compressedPly);
+    expect(full.paramsTexels, isA<Float32List>());
+  });
+
+  test('writes the training PLY layout back losslessly', () {
+    final data = _randomSplats(200, shDegree: 2).orderedByImportance();
+    final importance = data.computeImportance();
+    for (var i = 1; i < data.count; i++) {
+      expect(importance[i], lessThanOrEqualTo(importance[i - 1]));
+    }
+
+    final decoded = parseSplatPly(
+      encodeSplatPly(data),
+      options: const SplatDecodeOptions(alphaCullThreshold: 0),
+    );
+    expect(decoded.count, data.count);
+    expect(decoded.shDegree, 2);
+    expect(decoded.positions, data.positions);
+    for (var k = 0; k < data.scales.length; k++) {
+      expect(decoded.scales[k], closeTo(data.scales[k], 1e-5));
+      expect(decoded.colors[k], closeTo(data.colors[k], 1e-5));
+    }
+    for (var i = 0; i < data.count; i++) {
+      expect(decoded.opacities[i], closeTo(data.opacities[i], 1e-4));
+    }
+    for (var k = 0; k < data.rotations.length; k++) {
+      expect(decoded.rotations[k], closeTo(data.rotations[k], 1e-6));
+    }
+    for (var k = 0; k < data.sh!.length; k++) {
+      expect(decoded.sh![k], closeTo(data.sh![k], 1e-6));
+    }
+  });
+
+  test('streams a PLY in chunk-aligned runs that decode like the file', () {
+    final bytes = encodeSplatPly(_randomSplats(1500, shDegree: 1));
+    const options = SplatDecodeOptions(alphaCullThreshold: 0);
+    final reader = SplatStreamReader(
+      options: options,
+      firstBatchSplats: 256,
+      maxBatchSplats: 512,
+    );
+    final runs = <Uint8List>[];
+    // Odd-sized chunks split the header and the records anywhere.
+    for (var offset = 0; offset < bytes.length; offset += 777) {
+      runs.addAll(
+        reader.add(bytes.sublist(offset, math.min(offset + 777, bytes.length))),
+      );
+    }
+    expect(reader.format, SplatFormat.ply);
+    // The final chunk completed the last run, so none is left for close.
+    expect(reader.close(), isNull);
+    expect(reader.buffered, isFalse);
+    expect(reader.emitted, 1500);
+
+    final layout = reader.layout!;
+    expect(
+      [for (final run in runs) run.length ~/ layout.stride],
+      [256, 512, 512, 220],
+    );
+    final whole = parseSplatPly(bytes, options: options);
+    var at = 0;
+    for (final run in runs) {
+      final part = decodeSplatRecords(layout, run, options: options);
+      expect(part.shDegree, 1);
+      expect(
+        part.positions,
+        whole.positions.sublist(at * 3, (at + part.count) * 3),
+      );
+      expect(part.sh, whole.sh!.sublist(at * 9, (at + part.count) * 9));
+      at += part.count;
+    }
+    expect(at, whole.count);
+  });
+
+  test('finds a header end split across byte-sized chunks', () {
+    final bytes = encodeSplatPly(_randomSplats(300));
+    final reader = SplatStreamReader(firstBatchSplats: 256);
+    final runs = <Uint8List>[];
+    // One byte at a time through the header, then the rest at once.
+    for (var offset = 0; offset < 2048; offset++) {
+      runs.addAll(reader.add(bytes.sublist(offset, offset + 1)));
+    }
+    runs.addAll(reader.add(bytes.sublist(2048)));
+    expect(reader.format, SplatFormat.ply);
+    expect(reader.layout!.count, 300);
+    expect(reader.close(), isNull);
+    expect(
+      [for (final run in runs) run.length ~/ reader.layout!.stride],
+      [256, 44],
+    );
+  });
+
+  test('buffers files that cannot stream and rejects truncated ones', () {
+    final data = _randomSplats(300);
+    final compressed = encodeCompressedSplatPly(data);
+    final buffering = SplatStreamReader();
+    expect(buffering.add(compressed), isEmpty);
+    expect(buffering.close(), compressed);
+    expect(buffering.buffered, isTrue);
+
+    // A .splat file streams only when its length is known.
+    final splat = Uint8List(32 * 300);
+    final unknown = SplatStreamReader(format: SplatFormat.splat);
+    expect(unknown.add(splat), isEmpty);
+    expect(unknown.close(), splat);
+    final known = SplatStreamReader(
+      format: SplatFormat.splat,
+      lengthInBytes: splat.length,
+      firstBatchSplats: 256,
+    );
+    expect(
+      [for (final run in known.add(splat)) run.length],
+      [32 * 256, 32 * 44],
+    );
+    expect(known.close(), isNull);
+
+    final ply = encodeSplatPly(data);
+    final truncated = SplatStreamReader();
+    truncated.add(ply.sublist(0, ply.length - 10));
+    expect(truncated.close, throwsFormatException);
+  });
+
   test('rejects oversized sets with a clear error', () {
     // A count whose params texels exceed 4096 rows of a 4096-wide texture.
     expect(
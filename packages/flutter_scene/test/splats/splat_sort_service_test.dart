@@ -1,8 +1,24 @@
+import 'dart:math' as math;
 import 'dart:typed_data';
 
 import 'package:flutter_test/flutter_test.dart';
 // ignore: implementation_imports
 import 'package:flutter_scene/src/splats/splat_sort_service.dart';
+// ignore: implementation_imports
+import 'package:flutter_scene/src/splats/splat_codec.dart';
+// ignore: implementation_imports
+import 'package:flutter_scene/src/splats/splat_data.dart';
+// ignore: implementation_imports
+import 'package:flutter_scene/src/splats/splat_sorter.dart';
+// ignore: implementation_imports
+import 'package:flutter_scene/src/splats/splat_stream.dart';
+
+Float32List _cloud(int count, {int seed = 7}) {
+  final random = math.Random(seed);
+  return Float32List.fromList([
+    for (var i = 0; i < count * 3; i++) (random.nextDouble() - 0.5) * 20,
+  ]);
+}
 
 void main() {
   test('sorts through the background worker and survives reuse', () async {
@@ -27,4 +43,189 @@ void main() {
     service.dispose();
     expect(await service.sort(0, 0, 1), isNull);
   });
+
+  test('merged partitions reproduce the single-pass order', () {
+    const count = 1000;
+    final positions = _cloud(count);
+    const bounds = [0, 137, 500, 501, 1000];
+    final partitions = [
+      for (var p = 0; p + 1 < bounds.length; p++)
+        SplatSortPartition(
+          Float32List.sublistView(positions, bounds[p] * 3, bounds[p + 1] * 3),
+          count: bounds[p + 1] - bounds[p],
+          start: bounds[p],
+        ),
+    ];
+    var minKey = double.infinity;
+    var maxKey = double.negativeInfinity;
+    for (final partition in partitions) {
+      final keys = partition.computeKeys(0.3, -0.2, 0.93);
+      minKey = math.min(minKey, keys.minKey);
+      maxKey = math.max(maxKey, keys.maxKey);
+    }
+    for (final partition in partitions) {
+      partition.bucket(minKey, maxKey);
+    }
+    final merged = mergeSplatPartitions(
+      [for (final partition in partitions) partition.histogram],
+      [for (final partition in partitions) partition.order],
+      Float32List(count),
+    );
+    expect(merged, sortSplatsBackToFront(positions, count, 0.3, -0.2, 0.93));
+  });
+
+  test('a worker pool matches the single-pass order across sorts', () async {
+    const count = 5000;
+    final positions = _cloud(count, seed: 11);
+    final service = SplatSortService(positions, count, workers: 3);
+    for (final dir in const [
+      [0.3, -0.2, 0.93],
+      [-1.0, 0.0, 0.0],
+      [0.0, 0.6, -0.8],
+    ]) {
+      expect(
+        await service.sort(dir[0], dir[1], dir[2]),
+        sortSplatsBackToFront(positions, count, dir[0], dir[1], dir[2]),
+      );
+    }
+    service.dispose();
+  });
+
+  test('a budget keeps the nearest and most important splats', () {
+    final positions = _cloud(1000);
+    final importance = Float32List(1000)..fillRange(0, 1000, 1);
+    // Zero importance never survives a cut.
+    importance.fillRange(0, 100, 0);
+    final order = sortSplatsBackToFront(positions, 1000, 0, 0, 1);
+    final filter = SplatBudgetFilter(positions, importance, count: 1000);
+    const budget = (count: 300, eyeX: 10.0, eyeY: 0.0, eyeZ: 0.0);
+
+    final kept = filter.select(order, budget);
+    expect(kept, 300);
+    final selected = filter.selected.sublist(0, kept);
+    // Still back to front.
+    final rank = {for (var k = 0; k < 1000; k++) order[k]: k};
+    for (var k = 1; k < kept; k++) {
+      expect(rank[selected[k]]!, greaterThan(rank[selected[k - 1]]!));
+    }
+    expect(selected.every((s) => s >= 100), isTrue);
+    // Bucketing is approximate, but kept splats sit nearer the eye on
+    // average than the dropped ones.
+    double distance(double s) {
+      final o = s.toInt() * 3;
+      final dx = positions[o] - 10, dy = positions[o + 1];
+      final dz = positions[o + 2];
+      return math.sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    final keptSet = selected.toSet();
+    final dropped = [
+      for (var s = 100.0; s < 1000; s++)
+        if (!keptSet.contains(s)) s,
+    ];
+    final keptMean = selected.map(distance).reduce((a, b) => a + b) / kept;
+    final droppedMean =
+        dropped.map(distance).reduce((a, b) => a + b) / dropped.length;
+    expect(keptMean, lessThan(droppedMean));
+
+    // A budget covering the set keeps the order as is.
+    expect(
+      filter.select(order, (count: 1000, eyeX: 0, eyeY: 0, eyeZ: 0)),
+      1000,
+    );
+    expect(filter.selected, order);
+  });
+
+  test('incremental re-sorts stay valid back-to-front permutations', () {
+    const count = 2000;
+    final positions = _cloud(count, seed: 3);
+    final sorter = IncrementalSplatSorter(positions, count: count);
+
+    void expectBackToFront(Float32List order, double x, double y, double z) {
+      double key(int i) =>
+          positions[i * 3] * x +
+          positions[i * 3 + 1] * y +
+          positions[i * 3 + 2] * z;
+      final indices = [for (final v in order) v.toInt()];
+      expect(indices.toSet().length, count);
+      expect(indices.every((i) => i >= 0 && i < count), isTrue);
+      final keys = [for (final i in indices) key(i)];
+      final range = keys.reduce(math.max) - keys.reduce(math.min);
+      // Splats sharing a depth bucket may come out in either order.
+      final tolerance = range / (kSplatSortBuckets - 1) * 1.01 + 1e-5;
+      for (var j = 1; j < count; j++) {
+        expect(keys[j], lessThanOrEqualTo(keys[j - 1] + tolerance));
+      }
+    }
+
+    // Orbit in tenth-of-a-degree steps: every step after the first is a
+    // repair.
+    for (var step = 0; step < 60; step++) {
+      final angle = step * math.pi / 1800;
+      final x = math.sin(angle);
+      final z = math.cos(angle);
+      expectBackToFront(sorter.sort(x, 0.1, z), x, 0.1, z);
+    }
+    expect(sorter.fullSorts, 1);
+    expect(sorter.repairs, 59);
+
+    // A large turn escalates to a full sort.
+    expectBackToFront(sorter.sort(0, -1, 0), 0, -1, 0);
+    expect(sorter.fullSorts, 2);
+
+    // So does a small turn once the repair budget is exhausted.
+    final strict = IncrementalSplatSorter(
+      positions,
+      count: count,
+      repairBudget: 0,
+    )..sort(0, 0, 1);
+    expectBackToFront(strict.sort(0.05, 0, 1), 0.05, 0, 1);
+    expect(strict.repairs, 0);
+    expect(strict.fullSorts, 2);
+  });
+
+  test('a streaming set rebuilds its sorter as it doubles', () {
+    const total = 16384;
+    final file = encodeSplatPly(SplatData.zeroed(total));
+    final reader = SplatStreamReader(
+      firstBatchSplats: 256,
+      maxBatchSplats: 1024,
+    );
+    final coverage = SplatSortCoverage();
+    var loaded = 0;
+    var runs = 0;
+    void arrive(Uint8List run, {bool loading = true}) {
+      loaded += run.length ~/ reader.layout!.stride;
+      runs++;
+      if (coverage.sortedCount == 0) {
+        coverage.built(loaded, budgeted: false);
+      } else if (coverage.stale(loaded, loading: loading, budgeted: false)) {
+        coverage.built(loaded, budgeted: false);
+      }
+      // The sorted splats are always at least half of those loaded.
+      expect(coverage.sortedCount * 2, greaterThan(loaded));
+    }
+
+    for (var at = 0; at < file.length; at += 4096) {
+      for (final run in reader.add(
+        Uint8List.sublistView(file, at, math.min(at + 4096, file.length)),
+      )) {
+        arrive(run);
+      }
+    }
+    final last = reader.close();
+    if (last != null) arrive(last);
+    expect(loaded, total);
+    expect(runs, greaterThan(15));
+    expect(coverage.rebuilds, lessThan(runs ~/ 2));
+
+    // Finishing the load covers the whole set.
+    if (coverage.stale(total, loading: false, budgeted: false)) {
+      coverage.built(total, budgeted: false);
+    }
+    expect(coverage.sortedCount, total);
+    expect(coverage.stale(total, loading: false, budgeted: false), isFalse);
+    // Turning a budget on needs the importance, so it rebuilds at once.
+    expect(coverage.stale(total, loading: false, budgeted: true), isTrue);
+  });
 }
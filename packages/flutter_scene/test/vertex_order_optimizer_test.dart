@@ -0,0 +1,169 @@
+// Covers the import-time vertex order passes: on a shuffled grid the
+// reorder keeps every triangle (corner order included), cuts the modeled
+// cache misses to near the grid's ideal, renumbers vertices in first-use
+// order, and packGltfPrimitive reports the before/after figures.
+
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:flutter_scene/src/importer/gltf.dart';
+import 'package:flutter_test/flutter_test.dart';
+
+const int _n = 40;
+
+// An n x n quad grid's positions, three floats per vertex.
+Float32List _gridPositions() {
+  final positions = Float32List((_n + 1) * (_n + 1) * 3);
+  for (var y = 0; y <= _n; y++) {
+    for (var x = 0; x <= _n; x++) {
+      final o = (y * (_n + 1) + x) * 3;
+      positions[o] = x.toDouble();
+      positions[o + 1] = y.toDouble();
+    }
+  }
+  return positions;
+}
+
+// The grid's triangles in a random order.
+Uint32List _shuffledGridIndices() {
+  final triangles = <List<int>>[];
+  for (var y = 0; y < _n; y++) {
+    for (var x = 0; x < _n; x++) {
+      final a = y * (_n + 1) + x;
+      final b = a + 1, c = a + _n + 2, d = a + _n + 1;
+      triangles
+        ..add([a, b, c])
+        ..add([a, c, d]);
+    }
+  }
+  triangles.shuffle(math.Random(3));
+  return Uint32List.fromList([for (final t in triangles) ...t]);
+}
+
+// Each triangle as a key that survives a rotation of its corners but not a
+// change of winding.
+List<String> _triangleKeys(Uint32List indices, [Int32List? vertexOrder]) {
+  final keys = <String>[];
+  for (var t = 0; t < indices.length; t += 3) {
+    final corners = [
+      for (var c = 0; c < 3; c++)
+        vertexOrder == null ? indices[t + c] : vertexOrder[indices[t + c]],
+    ];
+    final first = corners.indexOf(corners.reduce(math.min));
+    keys.add(
+      [for (var c = 0; c < 3; c++) corners[(first + c) % 3]].join(','),
+    );
+  }
+  return keys..sort();
+}
+
+void main() {
+  final vertexCount = (_n + 1) * (_n + 1);
+
+  test('the cache model counts a regular strip and no reuse', () {
+    final noReuse = Uint32List.fromList(List.generate(30, (i) => i));
+    expect(analyzeVertexCache(noReuse, 30).acmr, 3);
+    expect(analyzeVertexCache(noReuse, 30).atvr, 1);
+    // A strip of 10 triangles over 12 vertices, every vertex loaded once.
+    final strip = Uint32List.fromList([
+      for (var t = 0; t < 10; t++) ...[t, t + 1, t + 2],
+    ]);
+    expect(analyzeVertexCache(strip, 12).acmr, closeTo(1.2, 1e-9));
+    expect(analyzeVertexCache(strip, 12).atvr, 1);
+  });
+
+  test('reorders a shuffled grid for the vertex cache', () {
+    final indices = _shuffledGridIndices();
+    final result = reorderForVertexCache(
+      indices,
+      _gridPositions(),
+      vertexCount,
+    );
+    expect(
+      _triangleKeys(result.indices, result.vertexOrder),
+      _triangleKeys(indices),
+    );
+    expect(result.before.acmr, greaterThan(2.5));
+    expect(result.after.acmr, lessThan(0.8));
+    expect(result.after.atvr, lessThan(1.5));
+    expect(
+      result.after.acmr,
+      closeTo(analyzeVertexCache(result.indices, vertexCount).acmr, 1e-9),
+    );
+
+    // First-use order: each index is at most one past the largest so far.
+    var next = 0;
+    for (final index in result.indices) {
+      expect(index, lessThanOrEqualTo(next));
+      if (index == next) next++;
+    }
+    expect(result.vertexOrder.toSet().length, vertexCount);
+  });
+
+  test('packGltfPrimitive reports the cache figures', () {
+    final positions = _gridPositions();
+    final normals = Float32List(vertexCount * 3);
+    for (var v = 0; v < vertexCount; v++) {
+      normals[v * 3 + 2] = 1;
+    }
+    final indices = _shuffledGridIndices();
+    final buffer = BytesBuilder()
+      ..add(positions.buffer.asUint8List())
+      ..add(normals.buffer.asUint8List())
+      ..add(indices.buffer.asUint8List());
+    final bytes = buffer.toBytes();
+    PackedPrimitive pack(bool optimize) => packGltfPrimitive(
+      primitive: GltfMeshPrimitive(
+        attributes: {'POSITION': 0, 'NORMAL': 1},
+        indices: 2,
+      ),
+      accessors: [
+        GltfAccessor(
+          componentType: GltfComponentType.float,
+          count: vertexCount,
+          type: GltfAccessorType.vec3,
+          bufferView: 0,
+        ),
+        GltfAccessor(
+          componentType: GltfComponentType.float,
+          count: vertexCount,
+          type: GltfAccessorType.vec3,
+          bufferView: 1,
+        ),
+        GltfAccessor(
+          componentType: GltfComponentType.unsignedInt,
+          count: indices.length,
+          type: GltfAccessorType.scalar,
+          bufferView: 2,
+        ),
+      ],
+      bufferViews: [
+        GltfBufferView(
+          buffer: 0,
+          byteLength: positions.lengthInBytes,
+          byteOffset: 0,
+        ),
+        GltfBufferView(
+          buffer: 0,
+          byteLength: normals.lengthInBytes,
+          byteOffset: positions.lengthInBytes,
+        ),
+        GltfBufferView(
+          buffer: 0,
+          byteLength: indices.lengthInBytes,
+          byteOffset: positions.lengthInBytes * 2,
+        ),
+      ],
+      bufferData: bytes,
+      coordinatePolicy: GltfCoordinatePolicy.runtimeBoundary,
+      optimizeVertexOrder: optimize,
+    );
+
+    expect(pack(false).vertexCache, isNull);
+    final packed = pack(true);
+    final stats = packed.vertexCache!;
+    expect(stats.after.acmr, lessThan(stats.before.acmr / 3));
+    expect(packed.vertexCount, vertexCount);
+    expect(packed.indexCount, indices.length);
+  });
+}
@@ -433,7 +433,9 @@ class GeometryResource extends ResourceSpec {
 /// aligned with the geometry's vertex order: every target's position deltas
 /// (`targetCount * vertexCount * 3` floats), then the same shape of normal
 /// deltas when [hasNormalDeltas], then tangent deltas (xyz) when
-/// [hasTangentDeltas].
+/// [hasTangentDeltas]. A chunk whose payload `format` is `morph-runs`
+/// instead stores, per target, runs of the vertices it moves and only
+/// those vertices' deltas (the runtime's `SparseMorphDeltas` layout).
 /// {@category Documents}
 class MorphTargetsSpec {
   /// Creates a morph targets description over the [deltas] payload.